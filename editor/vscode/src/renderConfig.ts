@@ -248,6 +248,10 @@ function html(): string {
           (v) => send({ debug: { light_icons: v } }));
         addBool(body, 'Frustum Culling', cfg.debug.frustum_culling,
           (v) => send({ debug: { frustum_culling: v } }));
+        addBool(body, 'GPU Pass Timing', cfg.debug.gpu_pass_timing,
+          (v) => send({ debug: { gpu_pass_timing: v } }));
+        addBool(body, 'Pipeline Statistics', cfg.debug.pipeline_statistics,
+          (v) => send({ debug: { pipeline_statistics: v } }));
       });
 
       renderSection('Render Scale', (body) => {
@@ -1,11 +1,16 @@
 #pragma once
 
-#include <vulkan_render/utils/vulkan_image.h>
+#include <vulkan_render/frame_readback.h>
 
 #include <glm/glm.hpp>
 
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace kryga::engine
@@ -16,17 +21,66 @@ struct screenshot_region
     uint32_t x = 0, y = 0, w = 0, h = 0;
 };
 
+enum class screenshot_format : uint8_t
+{
+    png,
+    qoi,
+    raw,  // tightly packed RGBA8
+};
+
+const char*
+to_string(screenshot_format f);
+
+bool
+parse_screenshot_format(const std::string& s, screenshot_format& out);
+
 struct screenshot_result
 {
-    std::string image_base64;
+    std::string image_base64;  // data URI, empty on failure
     screenshot_region region;
 };
 
+// One encoded frame of a stream
+struct screenshot_frame
+{
+    std::vector<uint8_t> bytes;
+    screenshot_region region;
+    screenshot_format format = screenshot_format::qoi;
+    uint64_t sequence = 0;  // gaps are frames dropped while the ring was full
+};
+
+// Viewport capture for tools and the H-key selection. Pixels come from
+// render::frame_readback (a copy recorded into a later frame, collected off its
+// fence), are encoded on a worker thread, and reach the caller through a
+// callback there, so neither the render thread nor the frame waits on a capture.
 class screenshot_capture
 {
 public:
-    screenshot_result
-    capture(const screenshot_region& region);
+    using result_callback = std::function<void(screenshot_result&&)>;
+    // Return false to end the stream
+    using frame_sink = std::function<bool(screenshot_frame&&)>;
+
+    screenshot_capture() = default;
+    ~screenshot_capture();
+
+    screenshot_capture(const screenshot_capture&) = delete;
+    screenshot_capture&
+    operator=(const screenshot_capture&) = delete;
+
+    // Any thread. `done` runs on the encoder thread with the next drawn frame.
+    void
+    capture(const screenshot_region& region, screenshot_format format, result_callback done);
+
+    // Any thread. Encodes `count` consecutive drawn frames (0 = until stopped)
+    // into `sink`, on the encoder thread. Returns the stream id.
+    uint64_t
+    start_stream(const screenshot_region& region,
+                 screenshot_format format,
+                 uint32_t count,
+                 frame_sink sink);
+
+    void
+    stop_stream(uint64_t id);
 
     const screenshot_result&
     get_last() const
@@ -46,10 +100,9 @@ public:
     void
     draw_overlay();
 
-    // Free the cached GPU staging image. Must be called during engine shutdown
-    // BEFORE the render device destroys its VMA allocator — otherwise the
-    // lazily-created staging allocation outlives the allocator and trips VMA's
-    // "allocations not freed" assertion (only after a screenshot was captured).
+    // Stop the encoder and cancel outstanding requests. Must be called during
+    // engine shutdown BEFORE the renderer deinits its readback ring: queued
+    // frames still hold ring slots until the encoder drops them.
     void
     release();
 
@@ -60,28 +113,25 @@ public:
     }
 
 private:
-    struct readback_result
+    struct encode_job
     {
-        const uint8_t* data = nullptr;
-        uint32_t w = 0, h = 0;
-        int stride = 0;
+        render::readback_frame frame;
+        screenshot_format format = screenshot_format::png;
+        std::function<void(screenshot_frame&&)> done;
     };
 
-    readback_result
-    readback_and_crop(const screenshot_region& region);
-
-    std::string
-    encode_png(const readback_result& rb);
-
     void
-    ensure_staging(uint32_t w, uint32_t h);
+    enqueue(encode_job&& job);
 
-    render::vk_utils::vulkan_image m_staging;
-    uint32_t m_staging_w = 0;
-    uint32_t m_staging_h = 0;
-
-    std::vector<uint8_t> m_pixels;
-    std::vector<uint8_t> m_cropped;
+    void
+    encoder_loop();
+
+    std::thread m_encoder;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<encode_job> m_jobs;
+    bool m_stopping = false;
+    std::vector<uint64_t> m_streams;  // readback request ids, for release()
 
     bool m_selecting = false;
     bool m_dragging = false;
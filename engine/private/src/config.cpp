@@ -49,6 +49,8 @@ apply_fields(serialization::container& container, config& c)
     extract_field(container, KRG_stringify(window_h), c.window_h);
     extract_field(container, KRG_stringify(window_w), c.window_w);
     extract_field(container, KRG_stringify(object_pool_size), c.object_pool_size);
+    extract_field(container, KRG_stringify(pipeline_depth), c.pipeline_depth);
+    extract_field(container, KRG_stringify(pipeline_adaptive), c.pipeline_adaptive);
 }
 }  // namespace
 
@@ -126,6 +128,14 @@ config::save() const
     {
         root[KRG_stringify(object_pool_size)] = object_pool_size;
     }
+    if (pipeline_depth != base_cfg.pipeline_depth)
+    {
+        root[KRG_stringify(pipeline_depth)] = pipeline_depth;
+    }
+    if (pipeline_adaptive != base_cfg.pipeline_adaptive)
+    {
+        root[KRG_stringify(pipeline_adaptive)] = pipeline_adaptive;
+    }
 
     return serialization::write_container(m_cache_rid, root);
 }
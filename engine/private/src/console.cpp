@@ -204,6 +204,10 @@ const config_var config_vars_arr[] = {
     make_var<&rcfg::outline, &rcfg::outline_cfg::enabled>("outline.enabled"),
     make_var<&rcfg::outline, &rcfg::outline_cfg::depth_threshold>("outline.depth_threshold"),
     make_var<&rcfg::outline, &rcfg::outline_cfg::normal_threshold>("outline.normal_threshold"),
+
+    make_var<&rcfg::lod, &rcfg::lod_cfg::enabled>("lod.enabled"),
+    make_var<&rcfg::lod, &rcfg::lod_cfg::error_pixels>("lod.error_pixels"),
+    make_var<&rcfg::lod, &rcfg::lod_cfg::shadow_bias>("lod.shadow_bias"),
 };
 // clang-format on
 
@@ -55,9 +55,11 @@
 
 #include <json/json.h>
 
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <filesystem>
+#include <fstream>
 #include <string>
 
 namespace kryga::engine_private
@@ -1522,6 +1524,8 @@ rpc_render_config_get(const Json::Value& /*params*/, Json::Value& result, std::s
             db["light_wireframe"] = cfg.debug.light_wireframe;
             db["light_icons"] = cfg.debug.light_icons;
             db["frustum_culling"] = cfg.debug.frustum_culling;
+            db["gpu_pass_timing"] = cfg.debug.gpu_pass_timing;
+            db["pipeline_statistics"] = cfg.debug.pipeline_statistics;
             r["debug"] = db;
 
             // Render scale
@@ -1733,6 +1737,14 @@ rpc_render_config_set(const Json::Value& params, Json::Value& result, std::strin
                 {
                     cfg.debug.frustum_culling = d["frustum_culling"].asBool();
                 }
+                if (d.isMember("gpu_pass_timing"))
+                {
+                    cfg.debug.gpu_pass_timing = d["gpu_pass_timing"].asBool();
+                }
+                if (d.isMember("pipeline_statistics"))
+                {
+                    cfg.debug.pipeline_statistics = d["pipeline_statistics"].asBool();
+                }
             }
 
             // Render scale
@@ -1987,6 +1999,175 @@ rpc_render_state_stats(const Json::Value& /*params*/, Json::Value& result, std::
     result = r;
 }
 
+// Per render-graph pass GPU time over the profiler's rolling window (ms), in
+// execution order, plus pipeline statistics of the last resolved frame when
+// enabled. Timings lag the current frame by one frames-in-flight cycle.
+void
+rpc_render_state_passes(const Json::Value& /*params*/, Json::Value& result, std::string& err)
+{
+    Json::Value r(Json::objectValue);
+    bool done = glob::glob_state().getr_render().renderer.wait_render_action(
+        [&]()
+        {
+            const auto& prof = glob::glob_state().getr_render().renderer.get_gpu_profiler();
+
+            auto timing_json = [](const render::gpu_timing_window::summary& t)
+            {
+                Json::Value j(Json::objectValue);
+                j["last_ms"] = t.last_ms;
+                j["min_ms"] = t.min_ms;
+                j["avg_ms"] = t.avg_ms;
+                j["p99_ms"] = t.p99_ms;
+                j["samples"] = t.samples;
+                return j;
+            };
+
+            r["supported"] = prof.supported();
+            r["pipeline_statistics"] = prof.pipeline_statistics_active();
+            r["resolved_frames"] = static_cast<Json::UInt64>(prof.resolved_frames());
+            r["frame"] = timing_json(prof.frame_summary());
+
+            Json::Value passes(Json::arrayValue);
+            for (const auto& p : prof.report())
+            {
+                Json::Value pj = timing_json(p.timing);
+                pj["name"] = p.name.str();
+                if (prof.pipeline_statistics_active())
+                {
+                    Json::Value st(Json::objectValue);
+                    st["ia_primitives"] = static_cast<Json::UInt64>(p.counters.ia_primitives);
+                    st["vs_invocations"] = static_cast<Json::UInt64>(p.counters.vs_invocations);
+                    st["clipping_primitives"] =
+                        static_cast<Json::UInt64>(p.counters.clipping_primitives);
+                    st["fs_invocations"] = static_cast<Json::UInt64>(p.counters.fs_invocations);
+                    st["cs_invocations"] = static_cast<Json::UInt64>(p.counters.cs_invocations);
+                    pj["statistics"] = st;
+                }
+                passes.append(pj);
+            }
+            r["passes"] = passes;
+        });
+    if (!done)
+    {
+        err = "render_state.passes timed out";
+        return;
+    }
+    result = r;
+}
+
+// Frame pacing: percentiles of frame interval / latency / build / render time
+// (ms) and per-gate stall attribution since start or the last reset. Passing
+// `since` (a frame cursor, 0 for everything retained) also streams the raw
+// per-frame records; poll again with the returned `next`. The telemetry is
+// readable from any thread, so this doesn't queue onto the render thread.
+void
+rpc_render_telemetry(const Json::Value& params, Json::Value& result, std::string& /*err*/)
+{
+    const auto& tel = glob::glob_state().getr_render().renderer.get_frame_telemetry();
+    constexpr double k_ms = 0.001;
+
+    Json::Value r(Json::objectValue);
+    r["frames"] = static_cast<Json::UInt64>(tel.committed());
+
+    Json::Value metrics(Json::objectValue);
+    for (uint32_t i = 0; i < render::k_frame_metric_count; ++i)
+    {
+        const auto m = static_cast<render::frame_metric>(i);
+        const auto& h = tel.histogram(m);
+
+        Json::Value mj(Json::objectValue);
+        mj["count"] = static_cast<Json::UInt64>(h.count());
+        mj["mean_ms"] = h.mean() * k_ms;
+        mj["p50_ms"] = h.percentile(0.50) * k_ms;
+        mj["p95_ms"] = h.percentile(0.95) * k_ms;
+        mj["p99_ms"] = h.percentile(0.99) * k_ms;
+        mj["max_ms"] = h.max() * k_ms;
+        metrics[render::to_string(m)] = mj;
+    }
+    r["metrics"] = metrics;
+
+    Json::Value stalls(Json::objectValue);
+    for (uint32_t i = 0; i < render::k_frame_gate_count; ++i)
+    {
+        const auto g = static_cast<render::frame_gate>(i);
+        const auto s = tel.gate(g);
+
+        Json::Value gj(Json::objectValue);
+        gj["total_ms"] = s.total_us * k_ms;
+        gj["max_ms"] = s.max_us * k_ms;
+        gj["dominant_frames"] = static_cast<Json::UInt64>(s.dominant_frames);
+        stalls[render::to_string(g)] = gj;
+    }
+    r["stalls"] = stalls;
+
+    if (params.isObject() && params.isMember("since"))
+    {
+        const auto records = tel.read(params["since"].asUInt64(),
+                                      params.get("max", render::frame_telemetry::k_ring).asUInt());
+
+        Json::Value frames(Json::arrayValue);
+        for (const auto& rec : records)
+        {
+            Json::Value fj(Json::objectValue);
+            fj["frame"] = static_cast<Json::UInt64>(rec.frame);
+            for (uint32_t i = 0; i < render::k_frame_stamp_count; ++i)
+            {
+                fj[render::to_string(static_cast<render::frame_stamp>(i))] =
+                    static_cast<Json::UInt64>(rec.stamp_us[i]);
+            }
+            Json::Value wj(Json::objectValue);
+            for (uint32_t i = 0; i < render::k_frame_gate_count; ++i)
+            {
+                wj[render::to_string(static_cast<render::frame_gate>(i))] = rec.wait_us[i];
+            }
+            fj["wait_us"] = wj;
+            fj["interval_us"] = rec.interval_us;
+            frames.append(fj);
+        }
+        r["records"] = frames;
+        r["next"] = static_cast<Json::UInt64>(
+            records.empty() ? tel.committed() : records.back().frame + 1);
+    }
+    result = r;
+}
+
+// Retained per-frame records as CSV (microseconds). Written to `path` when
+// given, otherwise returned inline.
+void
+rpc_render_telemetry_csv(const Json::Value& params, Json::Value& result, std::string& err)
+{
+    const auto& tel = glob::glob_state().getr_render().renderer.get_frame_telemetry();
+    const auto records = tel.read(params.isObject() ? params.get("since", 0).asUInt64() : 0);
+    std::string csv = render::frame_telemetry::to_csv(records);
+
+    Json::Value r(Json::objectValue);
+    r["rows"] = static_cast<Json::UInt>(records.size());
+
+    const std::string path = params.isObject() ? params.get("path", "").asString() : "";
+    if (path.empty())
+    {
+        r["csv"] = std::move(csv);
+    }
+    else
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out || !out.write(csv.data(), static_cast<std::streamsize>(csv.size())))
+        {
+            err = "render.telemetry.csv: cannot write " + path;
+            return;
+        }
+        r["path"] = path;
+    }
+    result = r;
+}
+
+void
+rpc_render_telemetry_reset(const Json::Value& /*params*/, Json::Value& result, std::string& /*err*/)
+{
+    glob::glob_state().getr_render().renderer.get_frame_telemetry().request_reset();
+    result = Json::Value(Json::objectValue);
+}
+
 void
 rpc_render_state_objects(const Json::Value& params, Json::Value& result, std::string& err)
 {
@@ -2163,26 +2344,40 @@ rpc_render_screenshot(const Json::Value& params, Json::Value& result, std::strin
     }
     else
     {
-        // capture() reads render-owned state (render passes, presented image,
-        // immediate_submit), so it runs ON THE RENDER THREAD — the I/O thread
-        // blocks on it, like every other render.* read RPC.
         engine::screenshot_region region{};
+        auto format = engine::screenshot_format::png;
         if (params.isObject())
         {
             region.x = params.get("x", 0).asUInt();
             region.y = params.get("y", 0).asUInt();
             region.w = params.get("width", 0).asUInt();
             region.h = params.get("height", 0).asUInt();
+            if (!engine::parse_screenshot_format(params.get("format", "png").asString(), format) ||
+                format == engine::screenshot_format::raw)
+            {
+                err = "unsupported 'format' (png or qoi)";
+                return;
+            }
         }
-        done = glob::glob_state().getr_render().renderer.wait_render_action(
-            [&]()
+
+        // The copy rides along with the next drawn frame and is encoded off the
+        // render thread; only this I/O thread waits for it.
+        auto promise = std::make_shared<std::promise<engine::screenshot_result>>();
+        auto fut = promise->get_future();
+        glob::glob_state().getr_editor_system().screenshot.capture(
+            region,
+            format,
+            [promise](engine::screenshot_result&& r) { promise->set_value(std::move(r)); });
+
+        done = fut.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+        if (done)
+        {
+            sr = fut.get();
+            if (sr.image_base64.empty())
             {
-                sr = glob::glob_state().getr_editor_system().screenshot.capture(region);
-                if (sr.image_base64.empty())
-                {
-                    local_err = "screenshot capture failed";
-                }
-            });
+                local_err = "screenshot capture failed";
+            }
+        }
     }
 
     if (!done)
@@ -2233,6 +2428,73 @@ rpc_editor_camera_set(const Json::Value& params, Json::Value& result, std::strin
     result["ok"] = true;
 }
 
+void
+rpc_render_screenshot_stream(const Json::Value& params, Json::Value& result, std::string& err)
+{
+    auto& server = glob::glob_state().getr_engine().get_rpc_server();
+
+    engine::screenshot_region region{};
+    auto format = engine::screenshot_format::qoi;
+    uint32_t count = 0;
+    if (params.isObject())
+    {
+        region.x = params.get("x", 0).asUInt();
+        region.y = params.get("y", 0).asUInt();
+        region.w = params.get("width", 0).asUInt();
+        region.h = params.get("height", 0).asUInt();
+        count = params.get("count", 0).asUInt();
+        if (!engine::parse_screenshot_format(params.get("format", "qoi").asString(), format))
+        {
+            err = "unsupported 'format' (png, qoi or raw)";
+            return;
+        }
+    }
+
+    // Frames go back as binary notifications to this client only; a send that
+    // fails (client gone) ends the stream.
+    const uint32_t client = server.current_client();
+    auto stream = std::make_shared<std::atomic<uint64_t>>(0);
+    const uint64_t id = glob::glob_state().getr_editor_system().screenshot.start_stream(
+        region,
+        format,
+        count,
+        [&server, client, stream](engine::screenshot_frame&& f)
+        {
+            Json::Value p(Json::objectValue);
+            p["stream"] = Json::UInt64(stream->load());
+            p["sequence"] = Json::UInt64(f.sequence);
+            p["x"] = f.region.x;
+            p["y"] = f.region.y;
+            p["width"] = f.region.w;
+            p["height"] = f.region.h;
+            p["format"] = engine::to_string(f.format);
+            return server.send_binary(
+                client, "render.screenshot.frame", p, std::move(f.bytes));
+        });
+    stream->store(id);
+
+    result = Json::Value(Json::objectValue);
+    result["stream"] = Json::UInt64(id);
+}
+
+void
+rpc_render_screenshot_stream_stop(const Json::Value& params,
+                                  Json::Value& result,
+                                  std::string& err)
+{
+    if (!params.isObject() || !params.isMember("stream"))
+    {
+        err = "missing 'stream' parameter";
+        return;
+    }
+    glob::glob_state().getr_editor_system().screenshot.stop_stream(params["stream"].asUInt64());
+
+    result = Json::Value(Json::objectValue);
+    result["stopped"] = true;
+    result["dropped"] = Json::UInt64(
+        glob::glob_state().getr_render().renderer.get_frame_readback().dropped());
+}
+
 void
 rpc_material_preview(const Json::Value& params, Json::Value& result, std::string& err)
 {
@@ -2860,8 +3122,14 @@ register_rpc_handlers(vulkan_engine& eng, rpc::rpc_server& server)
     server.on_request("render.object.data", rpc_render_state_object);
     server.on_request("render.object.list", rpc_render_state_objects);
     server.on_request("render.stats", rpc_render_state_stats);
+    server.on_request("render.passes", rpc_render_state_passes);
+    server.on_request("render.telemetry", rpc_render_telemetry);
+    server.on_request("render.telemetry.csv", rpc_render_telemetry_csv);
+    server.on_request("render.telemetry.reset", rpc_render_telemetry_reset);
     server.on_request("render.lights.data", rpc_render_state_lights);
     server.on_request("render.screenshot", rpc_render_screenshot);
+    server.on_request("render.screenshot.stream", rpc_render_screenshot_stream);
+    server.on_request("render.screenshot.stream.stop", rpc_render_screenshot_stream_stop);
 
     // Tools
     server.on_request("tools.actions.getStatus", rpc_actions_get_status);
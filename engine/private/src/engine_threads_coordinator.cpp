@@ -17,6 +17,7 @@
 
 #include <utils/check.h>
 
+#include <algorithm>
 #include <chrono>
 
 namespace kryga
@@ -97,21 +98,40 @@ engine_threads_coordinator::set_physics_paused(bool paused)
     m_physics_processor->set_paused(paused);
 }
 
+void
+engine_threads_coordinator::set_pipeline_depth(uint32_t depth)
+{
+    m_depth = std::clamp(depth, 1u, utils::k_max_pipeline_depth);
+}
+
 uint32_t
-engine_threads_coordinator::begin_frame()
+engine_threads_coordinator::begin_frame(bool input_active)
 {
+    auto& telemetry = glob::glob_state().getr_render().renderer.get_frame_telemetry();
+    m_telemetry_frame = telemetry.open_frame();
+    const uint64_t gate_start = render::frame_telemetry::now_us();
+
+    // Adaptive: latency wins while someone is steering. Shrinking just gates the
+    // next frames until the surplus in flight drains; no slot is remapped.
+    m_quiet_frames = input_active ? 0 : std::min(m_quiet_frames + 1, k_adaptive_quiet_frames);
+    m_effective_depth = m_adaptive && m_quiet_frames < k_adaptive_quiet_frames ? 1u : m_depth;
+
     uint32_t frame_slot;
     {
         std::unique_lock lock(m_mutex);
-        // Depth-1 gate: don't reuse a frame slot the render thread hasn't freed.
+        // Depth-N gate: don't reuse a frame slot the render thread hasn't freed.
         // The main thread is the sole writer of m_submitted, so the frame slot
         // computed here stays valid until submit_frame bumps it.
-        m_main_cv.wait(lock, [this] { return m_submitted - m_completed <= 1; });
-        frame_slot = static_cast<uint32_t>(m_submitted & 1ull);
+        const uint64_t depth = m_effective_depth;
+        m_main_cv.wait(lock, [this, depth] { return m_submitted - m_completed <= depth; });
+        frame_slot = utils::frame_slot_of(m_submitted);
     }
+    telemetry.add_wait(m_telemetry_frame,
+                       render::frame_gate::pipeline,
+                       render::frame_telemetry::now_us() - gate_start);
 
     // Route the build (producer) frame slot outside the lock — both subsystems name
-    // the same parity, set together so they can't drift: the renderer (camera + UI
+    // the same slot, set together so they can't drift: the renderer (camera + UI
     // snapshot double buffers) and the command queue/arena. The render thread reads
     // the matching frame slot when it draws this frame.
     glob::glob_state().getr_render().renderer.set_build_frame_slot(frame_slot);
@@ -127,6 +147,8 @@ engine_threads_coordinator::begin_frame()
 void
 engine_threads_coordinator::submit_frame()
 {
+    glob::glob_state().getr_render().renderer.get_frame_telemetry().stamp(
+        m_telemetry_frame, render::frame_stamp::submit_frame);
     {
         std::lock_guard lock(m_mutex);
         ++m_submitted;
@@ -174,15 +196,19 @@ engine_threads_coordinator::render_loop()
     // grow_for / reset at command drain).
     renderer.bind_render_pools_to_current_thread();
 
+    auto& telemetry = renderer.get_frame_telemetry();
+
     for (;;)
     {
         // Wait for a submitted-but-undrawn frame or shutdown.
         bool shutting_down = false;
+        const uint64_t idle_start = render::frame_telemetry::now_us();
         {
             std::unique_lock lock(m_mutex);
             m_render_cv.wait(lock, [this] { return m_submitted > m_completed || m_shutdown; });
             shutting_down = m_shutdown && m_submitted == m_completed;
         }
+        const uint64_t idle_end = render::frame_telemetry::now_us();
 
         // Render-thread tasks (RPC introspection, editor resource builds) run at
         // the top of each turn — the mirror of drain_main_actions() at the top of
@@ -198,19 +224,28 @@ engine_threads_coordinator::render_loop()
             break;
         }
 
-        // This frame used frame slot (completed & 1). Execute its build/destroy/
+        // Frames reach the render thread in submission order, so this is the frame
+        // begin_frame() opened. The idle wait is charged to it: the render thread
+        // was starved until the main thread submitted it.
+        const uint64_t tframe = telemetry.begin_render_frame();
+        telemetry.add_wait(tframe, render::frame_gate::render_idle, idle_end - idle_start);
+        telemetry.stamp(tframe, render::frame_stamp::drain_begin);
+
+        // This frame used frame slot frame_slot_of(completed). Execute its build/destroy/
         // transform commands, then draw — the frame slot drives the camera/UI
         // snapshot reads inside draw_main, keeping them in lock-step with the frame
         // the main thread produced.
-        const auto frame_slot = static_cast<uint32_t>(m_completed & 1ull);
+        const auto frame_slot = utils::frame_slot_of(m_completed);
         m_render_processor->process(0.0f, frame_slot);
+        telemetry.stamp(tframe, render::frame_stamp::drain_end);
         renderer.set_draw_frame_slot(frame_slot);
         renderer.draw_main();
+        telemetry.commit(tframe);
 
         // Frame drawn — its queue is drained empty and every command destructed, so
-        // rewind the arena for reuse. Safe: the main thread is building into the
-        // other frame slot, and the pipeline gate won't let it touch this one until
-        // the completion below is published.
+        // rewind the arena for reuse. Safe: the main thread is building into a
+        // later frame slot, and the pipeline gate won't let it wrap around to this
+        // one until the completion below is published.
         queues.reset_frame_slot(frame_slot);
 
         {
@@ -19,6 +19,8 @@
 #include <backends/imgui_impl_vulkan.h>
 #endif
 
+#include <algorithm>
+
 namespace kryga
 {
 void
@@ -385,6 +387,10 @@ input_manager::load_actions(const vfs::rid& rid)
 void
 input_manager::fire_input_event()
 {
+    // Any edge this frame, or anything still held: someone is steering right now
+    m_had_input = !m_queue.empty() ||
+                  std::any_of(m_is_down.begin(), m_is_down.end(), [](auto& e) { return e.second; });
+
     // Continuous held keys: synthesize a per-frame scaled tick for every held trigger
     // that has scaled handlers (e.g. WASD movement). Appended AFTER this frame's real
     // events — movement continuity needs no ordering against discrete edges.
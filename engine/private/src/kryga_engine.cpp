@@ -96,6 +96,8 @@
 
 #include <audio/audio_system.h>
 
+#include <jobs/job_system.h>
+
 #include <physics/physics_system.h>
 
 #include <packages/root/model/components/destructible_mesh_component.h>
@@ -255,6 +257,8 @@ vulkan_engine::init(const startup_options& options)
 
     gs.run_create();
 
+    // First in, last out: every other system may submit jobs until it is torn down
+    state_mutator__job_system::set(gs);
     state_mutator__config::set(gs);
     state_mutator__render::set(gs);
     state_mutator__subsystem_queues::set(gs);
@@ -537,9 +541,8 @@ vulkan_engine::cleanup()
 
 #if KRG_HAS_EDITOR
     glob::glob_state().getr_editor_system().ui.get_material_previewer().destroy();
-    // Free the screenshot staging image before device.destruct() tears down the
-    // VMA allocator (otherwise its lazily-created allocation outlives the
-    // allocator -> VMA assertion, but only once a screenshot has been taken).
+    // Stop the screenshot encoder before the renderer deinits its readback ring:
+    // queued frames hold ring slots (mapped staging buffers) until dropped.
     glob::glob_state().getr_editor_system().screenshot.release();
 #elif KRG_HAS_IMGUI
     if (ImGui::GetCurrentContext())
@@ -615,6 +618,8 @@ vulkan_engine::run()
     // main and draw_frame on itself) and the audio thread (from here audio_system is
     // owned by it; main only produces messages onto the audio channel). The audio /
     // physics loops drive the engine-owned processors handed in here.
+    m_threads.set_pipeline_depth(glob::glob_state().get_config()->pipeline_depth);
+    m_threads.set_adaptive_depth(glob::glob_state().get_config()->pipeline_adaptive);
     m_threads.start(*m_audio_processor, *m_physics_processor, *m_render_processor);
 
     // main loop
@@ -651,13 +656,13 @@ vulkan_engine::run()
             glob::glob_state().get_input_manager()->fire_input_event();
         }
 
-        // Pipeline gate + slot routing: block until the render thread has freed
-        // the slot this frame will reuse (depth-1 — main builds frame N while
-        // render draws N-1, never racing N-2's still-in-use slot), then route
-        // this frame's camera/UI/command state into that parity slot. The vsync
-        // / present-pacing stall the render thread takes each frame is exactly
-        // the window this lets the main thread fill (the point of the decouple).
-        m_threads.begin_frame();
+        // Pipeline gate + slot routing: block until no more than the pipeline
+        // depth of frames is still undrawn (main builds frame N while render
+        // works through N-depth..N-1), then route this frame's camera/UI/command
+        // state into its frame slot. The vsync / present-pacing stall the render
+        // thread takes each frame is exactly the window this lets the main thread
+        // fill (the point of the decouple). This frame's input drives adaptive depth.
+        m_threads.begin_frame(glob::glob_state().get_input_manager()->had_input());
 
 #if KRG_HAS_EDITOR
         {
@@ -733,7 +738,7 @@ vulkan_engine::run()
 
         // Publish the frame: its commands are all in the slot's queue; the render
         // thread drains that slot and draws. (No terminal command — one queue per
-        // frame parity means draining to empty is the frame boundary.)
+        // frame slot means draining to empty is the frame boundary.)
         m_threads.submit_frame();
 
         auto frame_msk = std::chrono::microseconds(utils::get_current_time_mks() - start_ts);
@@ -762,6 +767,11 @@ vulkan_engine::run()
 void
 vulkan_engine::tick_headless()
 {
+    // Frame telemetry sees the threaded pipeline's stages collapsed onto this
+    // thread, so headless CI gets the same pacing numbers.
+    auto& telemetry = glob::glob_state().getr_render().renderer.get_frame_telemetry();
+    telemetry.open_frame();
+
     // No physics thread in headless — drive the engine-owned processor inline here.
     // Pump first so commands the previous frame's builder emitted get applied + stepped,
     // then drain the results into the snapshot before this frame's builder reads it. A
@@ -774,10 +784,16 @@ vulkan_engine::tick_headless()
     consume_updated_render();
     consume_updated_transforms();
 
-    // Headless is single-threaded and never switches parity, so everything is
+    // Headless is single-threaded and never switches frame slot, so everything is
     // enqueued into and drained from slot 0.
+    const uint64_t tframe = telemetry.begin_render_frame();
+    telemetry.stamp(tframe, render::frame_stamp::submit_frame);
+    telemetry.stamp(tframe, render::frame_stamp::drain_begin);
+
     m_render_processor->process(0.0f, 0);
+    telemetry.stamp(tframe, render::frame_stamp::drain_end);
     glob::glob_state().getr_render().renderer.draw_headless();
+    telemetry.commit(tframe);
     glob::glob_state().getr_subsystem_queues().render.reset_arena();
 
     // No audio thread in headless — drain the audio channel synchronously here.
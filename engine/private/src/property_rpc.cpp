@@ -251,6 +251,7 @@ write_property(root::smart_object& owner,
         return "field is not editable: " + field_name;
     }
 
+    owner.before_write();
     reflection::property_context__json_set set_ctx{.p = prop, .obj = &owner, .jc = &value};
     if (prop->json_set(set_ctx) != result_code::ok)
     {
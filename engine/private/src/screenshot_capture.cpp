@@ -4,18 +4,18 @@
 
 #include <global_state/global_state.h>
 #include <vulkan_render/kryga_render.h>
-#include <vulkan_render/vulkan_render_device.h>
 #include <vulkan_render/render_system.h>
-#include <vulkan_render/utils/vulkan_initializers.h>
 
 #include <utils/base64.h>
-#include <vfs/vfs.h>
+#include <utils/qoi.h>
 
 #include <stb_unofficial/stb.h>
 #include <imgui.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <memory>
 
 namespace kryga::engine
 {
@@ -31,211 +31,265 @@ png_write_cb(void* ctx, void* data, int size)
     buf->insert(buf->end(), bytes, bytes + size);
 }
 
-}  // namespace
-
-void
-screenshot_capture::ensure_staging(uint32_t w, uint32_t h)
+// Tightly packed RGBA8 copy of the readback, swizzled from swapchain order
+std::vector<uint8_t>
+to_rgba(const render::readback_frame& f)
 {
-    if (m_staging_w == w && m_staging_h == h && m_staging.image() != VK_NULL_HANDLE)
+    std::vector<uint8_t> out(size_t(f.width) * f.height * 4);
+    for (uint32_t y = 0; y < f.height; ++y)
     {
-        return;
+        const uint8_t* src = f.data() + size_t(y) * f.row_pitch;
+        uint8_t* dst = out.data() + size_t(y) * f.width * 4;
+        std::memcpy(dst, src, size_t(f.width) * 4);
+        if (f.bgra)
+        {
+            for (uint32_t x = 0; x < f.width; ++x)
+            {
+                std::swap(dst[x * 4 + 0], dst[x * 4 + 2]);
+            }
+        }
     }
-
-    auto& device = glob::glob_state().getr_render().device;
-
-    auto extent = VkExtent3D{w, h, 1};
-    auto ci = render::vk_utils::make_image_create_info(VK_FORMAT_R8G8B8A8_UNORM, 0, extent);
-    ci.imageType = VK_IMAGE_TYPE_2D;
-    ci.arrayLayers = 1;
-    ci.mipLevels = 1;
-    ci.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    ci.samples = VK_SAMPLE_COUNT_1_BIT;
-    ci.tiling = VK_IMAGE_TILING_LINEAR;
-    ci.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-
-    VmaAllocationCreateInfo vma_ai = {};
-    vma_ai.usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
-    vma_ai.requiredFlags =
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-
-    m_staging =
-        render::vk_utils::vulkan_image::create(device.get_vma_allocator_provider(), ci, vma_ai);
-    m_staging_w = w;
-    m_staging_h = h;
-    m_pixels.resize(w * h * 4);
+    return out;
 }
 
-screenshot_capture::readback_result
-screenshot_capture::readback_and_crop(const screenshot_region& region)
+std::vector<uint8_t>
+encode(const render::readback_frame& f, screenshot_format format)
 {
-    auto& renderer = glob::glob_state().getr_render().renderer;
-    auto& device = glob::glob_state().getr_render().device;
-
-    auto pass_id = renderer.get_host_pass_id();
-    auto* pass = renderer.get_render_pass(pass_id);
-    if (!pass)
+    switch (format)
     {
-        return {};
-    }
-
-    uint32_t w = renderer.get_width();
-    uint32_t h = renderer.get_height();
+    case screenshot_format::qoi:
+        return qoi_encode(f.data(), f.width, f.height, f.row_pitch, f.bgra);
+    case screenshot_format::raw:
+        return to_rgba(f);
+    case screenshot_format::png:
+    default:
+    {
+        std::vector<uint8_t> rgba;
+        const uint8_t* src = f.data();
+        int stride = int(f.row_pitch);
+        if (f.bgra)
+        {
+            rgba = to_rgba(f);
+            src = rgba.data();
+            stride = int(f.width * 4);
+        }
 
-    ensure_staging(w, h);
+        std::vector<uint8_t> png;
+        stbi_write_png_to_func(png_write_cb, &png, int(f.width), int(f.height), 4, src, stride);
+        return png;
+    }
+    }
+}
 
-    auto color_images = pass->get_color_images();
-    // Sample the image that was actually presented (acquired index), not
-    // frame_slot % count — those diverge under MAILBOX, which would read a
-    // stale/unrendered image.
-    auto img_idx = device.last_presented_image_index() % color_images.size();
-    auto src_image = color_images[img_idx]->image();
-    VkImage dst_vk = m_staging.image();
+const char*
+mime_type(screenshot_format f)
+{
+    switch (f)
+    {
+    case screenshot_format::qoi:
+        return "image/qoi";
+    case screenshot_format::raw:
+        return "application/octet-stream";
+    case screenshot_format::png:
+    default:
+        return "image/png";
+    }
+}
 
-    auto extent = VkExtent3D{w, h, 1};
+render::readback_region
+to_readback_region(const screenshot_region& r)
+{
+    return {.x = r.x, .y = r.y, .w = r.w, .h = r.h};
+}
 
-    device.immediate_submit(
-        [&, dst_vk](VkCommandBuffer cmd)
-        {
-            render::vk_utils::make_insert_image_memory_barrier(
-                cmd,
-                src_image,
-                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-                VK_ACCESS_TRANSFER_READ_BIT,
-                VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                VK_PIPELINE_STAGE_TRANSFER_BIT,
-                VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
-
-            render::vk_utils::make_insert_image_memory_barrier(
-                cmd,
-                dst_vk,
-                0,
-                VK_ACCESS_TRANSFER_WRITE_BIT,
-                VK_IMAGE_LAYOUT_UNDEFINED,
-                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                VK_PIPELINE_STAGE_TRANSFER_BIT,
-                VK_PIPELINE_STAGE_TRANSFER_BIT,
-                VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
-
-            VkImageCopy copy{};
-            copy.srcSubresource = {.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                                   .mipLevel = 0,
-                                   .baseArrayLayer = 0,
-                                   .layerCount = 1};
-            copy.dstSubresource = {.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                                   .mipLevel = 0,
-                                   .baseArrayLayer = 0,
-                                   .layerCount = 1};
-            copy.extent = extent;
-
-            vkCmdCopyImage(cmd,
-                           src_image,
-                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                           dst_vk,
-                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                           1,
-                           &copy);
-
-            render::vk_utils::make_insert_image_memory_barrier(
-                cmd,
-                dst_vk,
-                VK_ACCESS_TRANSFER_WRITE_BIT,
-                VK_ACCESS_MEMORY_READ_BIT,
-                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                VK_IMAGE_LAYOUT_GENERAL,
-                VK_PIPELINE_STAGE_TRANSFER_BIT,
-                VK_PIPELINE_STAGE_TRANSFER_BIT,
-                VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
-
-            render::vk_utils::make_insert_image_memory_barrier(
-                cmd,
-                src_image,
-                VK_ACCESS_TRANSFER_READ_BIT,
-                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-                VK_PIPELINE_STAGE_TRANSFER_BIT,
-                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
-        });
+}  // namespace
 
-    uint8_t* mapped = m_staging.map();
-    std::memcpy(m_pixels.data(), mapped, m_pixels.size());
-    m_staging.unmap();
+const char*
+to_string(screenshot_format f)
+{
+    switch (f)
+    {
+    case screenshot_format::qoi:
+        return "qoi";
+    case screenshot_format::raw:
+        return "raw";
+    case screenshot_format::png:
+    default:
+        return "png";
+    }
+}
 
-    auto fmt = pass->get_color_format();
-    if (fmt == VK_FORMAT_B8G8R8A8_UNORM || fmt == VK_FORMAT_B8G8R8A8_SRGB)
+bool
+parse_screenshot_format(const std::string& s, screenshot_format& out)
+{
+    for (auto f : {screenshot_format::png, screenshot_format::qoi, screenshot_format::raw})
     {
-        for (uint32_t i = 0; i < w * h; ++i)
+        if (s == to_string(f))
         {
-            std::swap(m_pixels[i * 4 + 0], m_pixels[i * 4 + 2]);
+            out = f;
+            return true;
         }
     }
+    return false;
+}
 
-    uint32_t out_x = region.x, out_y = region.y;
-    uint32_t out_w = (region.w > 0) ? region.w : w;
-    uint32_t out_h = (region.h > 0) ? region.h : h;
-    out_w = std::min(out_w, w - std::min(out_x, w));
-    out_h = std::min(out_h, h - std::min(out_y, h));
+screenshot_capture::~screenshot_capture()
+{
+    release();
+}
 
-    const uint8_t* src_ptr = m_pixels.data();
-    int stride = int(w * 4);
+void
+screenshot_capture::capture(const screenshot_region& region,
+                            screenshot_format format,
+                            result_callback done)
+{
+    auto& readback = glob::glob_state().getr_render().renderer.get_frame_readback();
+    readback.request(
+        to_readback_region(region),
+        1,
+        [this, format, done = std::move(done)](render::readback_frame&& frame)
+        {
+            enqueue({.frame = std::move(frame),
+                     .format = format,
+                     .done =
+                         [format, done](screenshot_frame&& f)
+                     {
+                         screenshot_result sr;
+                         if (!f.bytes.empty())
+                         {
+                             sr.image_base64 = std::string("data:") + mime_type(format) +
+                                               ";base64," + base64_encode(f.bytes);
+                             sr.region = f.region;
+                         }
+                         done(std::move(sr));
+                     }});
+            return true;
+        });
+}
 
-    if (out_x != 0 || out_y != 0 || out_w != w || out_h != h)
-    {
-        m_cropped.resize(out_w * out_h * 4);
-        for (uint32_t row = 0; row < out_h; ++row)
+uint64_t
+screenshot_capture::start_stream(const screenshot_region& region,
+                                 screenshot_format format,
+                                 uint32_t count,
+                                 frame_sink sink)
+{
+    auto& readback = glob::glob_state().getr_render().renderer.get_frame_readback();
+
+    // The id is only known once request() returns, and the first frame can't
+    // land before a later frame's fence, so publishing it afterwards is safe
+    auto id = std::make_shared<std::atomic<uint64_t>>(0);
+    auto shared_sink = std::make_shared<frame_sink>(std::move(sink));
+
+    const uint64_t rid = readback.request(
+        to_readback_region(region),
+        count,
+        [this, format, id, shared_sink](render::readback_frame&& frame)
         {
-            std::memcpy(m_cropped.data() + row * out_w * 4,
-                        m_pixels.data() + (out_y + row) * w * 4 + out_x * 4,
-                        out_w * 4);
-        }
-        src_ptr = m_cropped.data();
-        stride = int(out_w * 4);
-    }
+            enqueue({.frame = std::move(frame),
+                     .format = format,
+                     .done =
+                         [this, id, shared_sink](screenshot_frame&& f)
+                     {
+                         if (!(*shared_sink)(std::move(f)))
+                         {
+                             stop_stream(id->load());
+                         }
+                     }});
+            return true;
+        });
+    id->store(rid);
 
-    return {.data = src_ptr, .w = out_w, .h = out_h, .stride = stride};
+    std::lock_guard lock(m_mutex);
+    m_streams.push_back(rid);
+    return rid;
 }
 
-std::string
-screenshot_capture::encode_png(const readback_result& rb)
+void
+screenshot_capture::stop_stream(uint64_t id)
 {
-    std::vector<uint8_t> png_buf;
-    stbi_write_png_to_func(png_write_cb, &png_buf, int(rb.w), int(rb.h), 4, rb.data, rb.stride);
-    if (png_buf.empty())
+    glob::glob_state().getr_render().renderer.get_frame_readback().cancel(id);
+
+    std::lock_guard lock(m_mutex);
+    std::erase(m_streams, id);
+}
+
+void
+screenshot_capture::enqueue(encode_job&& job)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_stopping)
+    {
+        return;  // dropping the job hands its ring slot back
+    }
+    if (!m_encoder.joinable())
     {
-        return {};
+        m_encoder = std::thread(&screenshot_capture::encoder_loop, this);
     }
-    return "data:image/png;base64," + base64_encode(png_buf.data(), png_buf.size());
+    m_jobs.push_back(std::move(job));
+    m_cv.notify_one();
 }
 
-screenshot_result
-screenshot_capture::capture(const screenshot_region& region)
+void
+screenshot_capture::encoder_loop()
 {
-    auto rb = readback_and_crop(region);
-    if (!rb.data)
+    for (;;)
     {
-        return {};
-    }
+        encode_job job;
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping)
+            {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
 
-    screenshot_result sr;
-    sr.image_base64 = encode_png(rb);
-    sr.region = {.x = region.x, .y = region.y, .w = rb.w, .h = rb.h};
-    return sr;
+        screenshot_frame out;
+        out.format = job.format;
+        out.sequence = job.frame.sequence;
+        out.region = {.x = job.frame.region_x,
+                      .y = job.frame.region_y,
+                      .w = job.frame.width,
+                      .h = job.frame.height};
+        out.bytes = encode(job.frame, job.format);
+
+        // Hand the staging slot back before the (possibly slow) consumer runs
+        job.frame = {};
+        job.done(std::move(out));
+    }
 }
 
 void
 screenshot_capture::release()
 {
-    // Move-assigning a default image clears the old one (vmaDestroyImage via
-    // its stored allocator). Safe to call when nothing was ever captured —
-    // m_staging is then already empty.
-    m_staging = render::vk_utils::vulkan_image{};
-    m_staging_w = 0;
-    m_staging_h = 0;
-    m_pixels.clear();
-    m_cropped.clear();
+    std::vector<uint64_t> streams;
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+        streams.swap(m_streams);
+    }
+    m_cv.notify_all();
+    if (m_encoder.joinable())
+    {
+        m_encoder.join();
+    }
+
+    // Queued frames hold readback slots; drop them before the ring goes away
+    {
+        std::lock_guard lock(m_mutex);
+        m_jobs.clear();
+    }
+
+    if (glob::glob_state().get_render())
+    {
+        auto& readback = glob::glob_state().getr_render().renderer.get_frame_readback();
+        for (auto id : streams)
+        {
+            readback.cancel(id);
+        }
+    }
 }
 
 void
@@ -284,18 +338,16 @@ screenshot_capture::draw_overlay()
                                  .w = uint32_t(glm::max(1.0f, x1 - x0)),
                                  .h = uint32_t(glm::max(1.0f, y1 - y0))};
 
-        // draw_overlay runs during UI build on the MAIN thread, but the capture
-        // reads render-owned state (render passes, the presented image, an
-        // immediate_submit). Defer the readback to the render thread, then post
-        // the result back so m_last stays main-only (read by get_last via RPC).
-        auto& renderer = glob::glob_state().getr_render().renderer;
-        renderer.post_render_action(
-            [this, region]
-            {
-                auto result = capture(region);
-                glob::glob_state().getr_engine().queue_main_action(
-                    [this, result = std::move(result)]() mutable { m_last = std::move(result); });
-            });
+        // The result arrives on the encoder thread; post it back so m_last
+        // stays main-only (read by get_last via RPC).
+        capture(region,
+                screenshot_format::png,
+                [this](screenshot_result&& result)
+                {
+                    glob::glob_state().getr_engine().queue_main_action(
+                        [this, result = std::move(result)]() mutable
+                        { m_last = std::move(result); });
+                });
     }
 
     auto* dl = ImGui::GetForegroundDrawList();
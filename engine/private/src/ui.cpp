@@ -830,6 +830,22 @@ render_config_window::handle()
                 "Per-object mode: CPU-side sphere-frustum test.\n"
                 "Instanced mode: always active (GPU compute).");
         }
+
+        ImGui::Checkbox("GPU Pass Timing", &cfg.debug.gpu_pass_timing);
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip("Timestamp every render graph pass (render.passes RPC, Tracy).");
+        }
+
+        ImGui::SameLine();
+
+        ImGui::Checkbox("Pipeline Stats", &cfg.debug.pipeline_statistics);
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip(
+                "Collect vertex/fragment/compute invocation counts per pass.\n"
+                "Ignored when the GPU lacks pipelineStatisticsQuery.");
+        }
     }
 
     // =========================================================================
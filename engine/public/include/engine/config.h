@@ -46,6 +46,11 @@ public:
     // + render_cache storage). A floor, not a cap — usage grows past it. Sizes the
     // object SSBO and cull dispatch, so keep it near the real scene budget.
     uint32_t object_pool_size = 4096;
+    // Frames the main thread may build ahead of the render thread (1-3). Deeper
+    // trades a frame of input latency each for slack against long model frames.
+    uint32_t pipeline_depth = 1;
+    // Drop to depth 1 while input is live, back to pipeline_depth once it's quiet
+    bool pipeline_adaptive = false;
 };
 }  // namespace editor
 }  // namespace kryga
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <utils/frame_pipeline.h>
+
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -18,7 +20,7 @@ class render_command_processor;
 // authority for thread lifecycle and (load-bearing) shutdown ordering. It runs two
 // INDEPENDENT threads that share nothing:
 //
-//   1. Render thread — the depth-1 streaming pipeline between the main (producer)
+//   1. Render thread — the depth-N streaming pipeline between the main (producer)
 //      thread and the render (consumer) thread. Owns the two condition variables,
 //      the submitted/completed frame counters, and the per-frame "frame slot"
 //      routing those counters imply.
@@ -34,18 +36,26 @@ class render_command_processor;
 //
 // --- Render pipeline (thread 1) ---
 //
-// A frame slot (frame_id & 1) is the frame-parity index into the depth-1 double
-// buffers; it's one logical value the pipeline is the authority for. The renderer
+// A frame slot (utils::frame_slot_of(frame_id)) is the index into the
+// k_frame_slot_count-entry rings the producers fill; it's one logical value the
+// pipeline is the authority for. The renderer
 // and command queue each cache their own copy because the frame slot is ambient
 // context deep in their call trees. begin_frame() routes the producer copies (the
 // build frame slot); the render loop stamps the consumer copy (the draw frame
 // slot) and drives the frame. Subsystems are reached through glob_state, the
 // codebase-wide access pattern.
 //
-// Invariant: submitted - completed <= 1. The main thread builds frame N into
-// frame slot N&1 while the render thread draws frame N-1 from frame slot (N-1)&1.
-// The vsync / present-pacing stall the render thread takes each frame is exactly
-// the window this lets the main thread fill — the point of the decouple.
+// Invariant: submitted - completed <= depth at begin_frame, depth in
+// [1, k_max_pipeline_depth]. The main thread builds frame N while the render
+// thread works through N-depth..N-1; the ring has one slot more than the deepest
+// setting, so frame N's slot is always already drawn. The vsync / present-pacing
+// stall the render thread takes each frame is exactly the window this lets the
+// main thread fill — the point of the decouple. Depth 1 keeps input-to-photon
+// latency lowest; deeper pipelines absorb long model frames at a frame of latency
+// each. The ring is fixed, so the depth may change between any two frames.
+//
+// Adaptive mode runs at depth 1 while the player is giving input and returns to
+// the configured depth once input has been quiet for k_adaptive_quiet_frames.
 //
 // Per-frame stages:
 //   main:   begin_frame()  -> gate until the frame slot is free, route producers
@@ -90,13 +100,42 @@ public:
     void
     set_physics_paused(bool paused);
 
+    // --- Pipeline depth (main thread; applies from the next begin_frame) ---
+
+    static constexpr uint32_t k_adaptive_quiet_frames = 30;
+
+    // Frames the main thread may build ahead of the render thread, clamped to
+    // [1, utils::k_max_pipeline_depth].
+    void
+    set_pipeline_depth(uint32_t depth);
+
+    uint32_t
+    get_pipeline_depth() const
+    {
+        return m_depth;
+    }
+
+    void
+    set_adaptive_depth(bool adaptive)
+    {
+        m_adaptive = adaptive;
+    }
+
+    // Depth the last begin_frame gated on
+    uint32_t
+    get_effective_depth() const
+    {
+        return m_effective_depth;
+    }
+
     // --- Main-thread per-frame stages (render pipeline) ---
 
-    // Block until the next frame slot is free (depth-1 gate), route the producers
+    // Block until the next frame slot is free (depth-N gate), route the producers
     // (renderer build frame slot + command queue/arena) to it, and return the frame
-    // slot. The engine then builds the frame before submit_frame().
+    // slot. The engine then builds the frame before submit_frame(). `input_active`
+    // feeds adaptive mode: this frame carries player input.
     uint32_t
-    begin_frame();
+    begin_frame(bool input_active = false);
 
     // Publish the built frame to the render thread and wake it.
     void
@@ -134,6 +173,13 @@ private:
     uint64_t m_submitted = 0;
     uint64_t m_completed = 0;
     bool m_shutdown = false;
+    // Frame telemetry id of the frame the main thread is building (main thread only)
+    uint64_t m_telemetry_frame = 0;
+    // Depth settings, main thread only
+    uint32_t m_depth = 1;
+    uint32_t m_effective_depth = 1;
+    uint32_t m_quiet_frames = k_adaptive_quiet_frames;
+    bool m_adaptive = false;
     // Borrowed from the engine (set in start()); the render loop drives it to consume
     // each frame slot's command queue before drawing.
     render_command_processor* m_render_processor = nullptr;
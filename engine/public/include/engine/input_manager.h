@@ -87,6 +87,14 @@ public:
         return m_mouse_axis_state;
     }
 
+    // True when the last fire_input_event() saw an edge or a held trigger. The frame
+    // pipeline's adaptive depth keys off it.
+    bool
+    had_input() const
+    {
+        return m_had_input;
+    }
+
 protected:
     bool
     do_register_scaled(const utils::id& id, scaled_handler handler, void* owner) override;
@@ -155,6 +163,7 @@ private:
     core::io_delta m_delta;
 
     float m_dur_seconds = 0.f;
+    bool m_had_input = false;
 };
 
 }  // namespace engine
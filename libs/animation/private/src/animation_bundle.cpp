@@ -0,0 +1,434 @@
+#include <animation/animation_bundle.h>
+
+#include <utils/buffer.h>
+#include <utils/file_utils.h>
+#include <utils/kryga_log.h>
+
+#include <ozz/base/io/archive.h>
+#include <ozz/base/io/stream.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <unordered_map>
+
+namespace kryga
+{
+namespace animation
+{
+
+namespace
+{
+
+// "KANB"
+constexpr uint32_t k_bundle_magic = 0x424e414b;
+constexpr uint32_t k_bundle_version = 1;
+
+// Sections start 16-byte aligned so mapped views can be read in place
+constexpr uint64_t k_section_align = 16;
+
+struct bundle_section
+{
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+struct bundle_header
+{
+    uint32_t magic = k_bundle_magic;
+    uint32_t version = k_bundle_version;
+    uint32_t clip_count = 0;
+    uint32_t reserved = 0;
+
+    float centroid[3] = {};
+    float bounding_radius = 0.f;
+
+    bundle_section skeleton;
+    bundle_section clips;  // bundle_clip[clip_count]
+    bundle_section vertices;
+    bundle_section indices;
+    bundle_section inverse_binds;
+    bundle_section joint_remaps;
+};
+
+struct bundle_clip
+{
+    bundle_section name;
+    bundle_section data;
+};
+
+// Read-only ozz stream over a byte view, so archives deserialize straight out of
+// the mapping
+class span_stream : public ozz::io::Stream
+{
+public:
+    explicit span_stream(std::span<const uint8_t> bytes)
+        : m_bytes(bytes)
+    {
+    }
+
+    bool
+    opened() const override
+    {
+        return true;
+    }
+
+    size_t
+    Read(void* buffer, size_t size) override
+    {
+        size = std::min(size, m_bytes.size() - m_pos);
+        std::memcpy(buffer, m_bytes.data() + m_pos, size);
+        m_pos += size;
+        return size;
+    }
+
+    size_t
+    Write(const void*, size_t) override
+    {
+        return 0;
+    }
+
+    int
+    Seek(int offset, Origin origin) override
+    {
+        int64_t pos = offset;
+        if (origin == kCurrent)
+        {
+            pos += int64_t(m_pos);
+        }
+        else if (origin == kEnd)
+        {
+            pos += int64_t(m_bytes.size());
+        }
+        if (pos < 0 || pos > int64_t(m_bytes.size()))
+        {
+            return -1;
+        }
+        m_pos = size_t(pos);
+        return 0;
+    }
+
+    int
+    Tell() const override
+    {
+        return int(m_pos);
+    }
+
+    size_t
+    Size() const override
+    {
+        return m_bytes.size();
+    }
+
+private:
+    std::span<const uint8_t> m_bytes;
+    size_t m_pos = 0;
+};
+
+template <typename T>
+bool
+read_archive(std::span<const uint8_t> bytes, T& out)
+{
+    span_stream stream(bytes);
+    ozz::io::IArchive archive(&stream);
+    if (!archive.TestTag<T>())
+    {
+        return false;
+    }
+    archive >> out;
+    return true;
+}
+
+bundle_section
+append_section(std::vector<uint8_t>& blob, const void* data, size_t size)
+{
+    blob.resize((blob.size() + k_section_align - 1) & ~(k_section_align - 1));
+
+    bundle_section s{.offset = blob.size(), .size = size};
+    blob.resize(blob.size() + size);
+    if (size)
+    {
+        std::memcpy(blob.data() + s.offset, data, size);
+    }
+    return s;
+}
+
+template <typename T>
+bool
+section_view(std::span<const uint8_t> bytes, const bundle_section& s, std::span<const T>& out)
+{
+    if (s.offset > bytes.size() || s.size > bytes.size() - s.offset || s.size % sizeof(T) ||
+        s.offset % alignof(T))
+    {
+        return false;
+    }
+    out = {reinterpret_cast<const T*>(bytes.data() + s.offset), size_t(s.size / sizeof(T))};
+    return true;
+}
+
+}  // namespace
+
+bool
+animation_bundle::build(const utils::path& gltf,
+                        const utils::path& ozz_dir,
+                        animation_bundle_source& out)
+{
+    std::string stem, ext;
+    gltf.parse_file_name_and_ext(stem, ext);
+
+    auto skel_path = ozz_dir / (stem + "_skeleton.ozz");
+    if (!utils::file_utils::load_file(skel_path, out.skeleton))
+    {
+        ALOG_ERROR("animation_bundle: cannot read '{}'", skel_path.str());
+        return false;
+    }
+
+    ozz::animation::Skeleton skeleton;
+    if (!read_archive(out.skeleton, skeleton))
+    {
+        ALOG_ERROR("animation_bundle: '{}' does not contain a valid skeleton", skel_path.str());
+        return false;
+    }
+
+    const std::string prefix = stem + "_";
+    const std::string skel_file = stem + "_skeleton.ozz";
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(ozz_dir.fs(), ec))
+    {
+        if (!entry.is_regular_file())
+        {
+            continue;
+        }
+
+        auto fname = entry.path().filename().generic_string();
+        if (fname == skel_file || !fname.starts_with(prefix) || !fname.ends_with(".ozz") ||
+            fname.size() <= prefix.size() + 4)
+        {
+            continue;
+        }
+
+        auto& clip = out.clips.emplace_back();
+        clip.first = fname.substr(prefix.size(), fname.size() - prefix.size() - 4);
+        if (!utils::file_utils::load_file(utils::path(entry.path()), clip.second))
+        {
+            ALOG_WARN("animation_bundle: cannot read clip '{}'", fname);
+            out.clips.pop_back();
+        }
+    }
+
+    // Directory order is unspecified; keep the output reproducible
+    std::sort(out.clips.begin(),
+              out.clips.end(),
+              [](const auto& l, const auto& r) { return l.first < r.first; });
+
+    utils::buffer gltf_buf;
+    if (!utils::buffer::load(gltf, gltf_buf))
+    {
+        ALOG_ERROR("animation_bundle: cannot read '{}'", gltf.str());
+        return false;
+    }
+
+    gltf_load_result gltf_result;
+    if (!gltf_animation_loader::load(gltf_buf, gltf_result))
+    {
+        return false;
+    }
+
+    std::unordered_map<std::string_view, int32_t> ozz_joints;
+    auto ozz_names = skeleton.joint_names();
+    for (int j = 0; j < skeleton.num_joints(); ++j)
+    {
+        ozz_joints.emplace(ozz_names[j], j);
+    }
+
+    out.joint_remaps.assign(gltf_result.joint_names.size(), -1);
+    for (size_t mesh_bone = 0; mesh_bone < gltf_result.joint_names.size(); ++mesh_bone)
+    {
+        const auto& name = gltf_result.joint_names[mesh_bone];
+        if (auto itr = ozz_joints.find(name); itr != ozz_joints.end())
+        {
+            out.joint_remaps[mesh_bone] = itr->second;
+        }
+        else
+        {
+            ALOG_WARN("Joint '{}' in glTF mesh not found in ozz skeleton", name);
+        }
+    }
+
+    out.inverse_bind_matrices = std::move(gltf_result.inverse_bind_matrices);
+
+    if (!gltf_result.meshes.empty())
+    {
+        out.mesh = std::move(gltf_result.meshes[0]);
+
+        glm::vec3 vmin{std::numeric_limits<float>::max()};
+        glm::vec3 vmax{std::numeric_limits<float>::lowest()};
+        for (const auto& v : out.mesh.vertices)
+        {
+            vmin = glm::min(vmin, v.position);
+            vmax = glm::max(vmax, v.position);
+        }
+        out.centroid = (vmin + vmax) * 0.5f;
+
+        float max_dc_sq = 0.0f;
+        for (const auto& v : out.mesh.vertices)
+        {
+            glm::vec3 d = v.position - out.centroid;
+            max_dc_sq = std::max(max_dc_sq, glm::dot(d, d));
+        }
+        out.bounding_radius = std::sqrt(max_dc_sq);
+    }
+
+    return true;
+}
+
+std::vector<uint8_t>
+animation_bundle::serialize(const animation_bundle_source& src)
+{
+    bundle_header header;
+    header.clip_count = static_cast<uint32_t>(src.clips.size());
+    header.centroid[0] = src.centroid.x;
+    header.centroid[1] = src.centroid.y;
+    header.centroid[2] = src.centroid.z;
+    header.bounding_radius = src.bounding_radius;
+
+    std::vector<uint8_t> blob(sizeof(bundle_header));
+
+    header.skeleton = append_section(blob, src.skeleton.data(), src.skeleton.size());
+
+    std::vector<bundle_clip> clips(src.clips.size());
+    header.clips = append_section(blob, clips.data(), clips.size() * sizeof(bundle_clip));
+    for (size_t i = 0; i < src.clips.size(); ++i)
+    {
+        auto& [name, data] = src.clips[i];
+        clips[i].name = append_section(blob, name.data(), name.size());
+        clips[i].data = append_section(blob, data.data(), data.size());
+    }
+    if (!clips.empty())
+    {
+        std::memcpy(blob.data() + header.clips.offset, clips.data(), header.clips.size);
+    }
+
+    header.vertices =
+        append_section(blob,
+                       src.mesh.vertices.data(),
+                       src.mesh.vertices.size() * sizeof(gpu::skinned_vertex_data));
+    header.indices = append_section(
+        blob, src.mesh.indices.data(), src.mesh.indices.size() * sizeof(uint32_t));
+    header.inverse_binds = append_section(blob,
+                                          src.inverse_bind_matrices.data(),
+                                          src.inverse_bind_matrices.size() * sizeof(glm::mat4));
+    header.joint_remaps = append_section(
+        blob, src.joint_remaps.data(), src.joint_remaps.size() * sizeof(int32_t));
+
+    std::memcpy(blob.data(), &header, sizeof(header));
+    return blob;
+}
+
+bool
+animation_bundle::open(const utils::path& p)
+{
+    m_owned.clear();
+    if (!m_mapping.open(p))
+    {
+        ALOG_ERROR("animation_bundle: cannot map '{}'", p.str());
+        return false;
+    }
+
+    if (!parse(m_mapping.data()))
+    {
+        ALOG_ERROR("animation_bundle: '{}' is not a valid bundle", p.str());
+        m_mapping.close();
+        return false;
+    }
+    return true;
+}
+
+bool
+animation_bundle::open(std::vector<uint8_t> bytes)
+{
+    m_mapping.close();
+    m_owned = std::move(bytes);
+
+    if (!parse(m_owned))
+    {
+        ALOG_ERROR("animation_bundle: not a valid bundle");
+        m_owned.clear();
+        return false;
+    }
+    return true;
+}
+
+bool
+animation_bundle::parse(std::span<const uint8_t> bytes)
+{
+    m_clips.clear();
+
+    bundle_header header;
+    if (bytes.size() < sizeof(header))
+    {
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    if (header.magic != k_bundle_magic || header.version != k_bundle_version)
+    {
+        return false;
+    }
+
+    std::span<const bundle_clip> clips;
+    if (!section_view(bytes, header.skeleton, m_skeleton) ||
+        !section_view(bytes, header.clips, clips) || clips.size() != header.clip_count ||
+        !section_view(bytes, header.vertices, m_vertices) ||
+        !section_view(bytes, header.indices, m_indices) ||
+        !section_view(bytes, header.inverse_binds, m_inverse_binds) ||
+        !section_view(bytes, header.joint_remaps, m_joint_remaps))
+    {
+        return false;
+    }
+
+    m_clips.reserve(clips.size());
+    for (auto& c : clips)
+    {
+        std::span<const char> name;
+        std::span<const uint8_t> data;
+        if (!section_view(bytes, c.name, name) || !section_view(bytes, c.data, data))
+        {
+            return false;
+        }
+        m_clips.push_back({.name = {name.data(), name.size()}, .data = data});
+    }
+
+    m_centroid = glm::vec3(header.centroid[0], header.centroid[1], header.centroid[2]);
+    m_bounding_radius = header.bounding_radius;
+
+    return true;
+}
+
+bool
+animation_bundle::load_skeleton(ozz::animation::Skeleton& out) const
+{
+    if (!read_archive(m_skeleton, out))
+    {
+        ALOG_ERROR("animation_bundle: skeleton section is not a valid ozz skeleton");
+        return false;
+    }
+    return true;
+}
+
+bool
+animation_bundle::load_clip(uint32_t idx, ozz::animation::Animation& out) const
+{
+    if (!read_archive(m_clips[idx].data, out))
+    {
+        ALOG_ERROR("animation_bundle: clip '{}' is not a valid ozz animation", m_clips[idx].name);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace animation
+}  // namespace kryga
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <animation/gltf_animation_loader.h>
+
+#include <utils/mapped_file.h>
+#include <utils/path.h>
+
+#include <ozz/animation/runtime/skeleton.h>
+#include <ozz/animation/runtime/animation.h>
+
+#include <gpu_types/gpu_vertex_types.h>
+#include <glm_unofficial/glm.h>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace kryga
+{
+namespace animation
+{
+
+// Everything a skeleton needs when its first instance spawns, gathered from
+// `<stem>_skeleton.ozz`, the `<stem>_*.ozz` clips next to it and the skinned mesh
+// of `<stem>.glb`. The cooker writes it as `<stem>.aanim` beside the glTF.
+struct animation_bundle_source
+{
+    std::vector<uint8_t> skeleton;  // ozz archive bytes
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> clips;
+
+    gltf_mesh_result mesh;
+    std::vector<glm::mat4> inverse_bind_matrices;
+    std::vector<int32_t> joint_remaps;  // glTF joint -> ozz joint, -1 when unmatched
+
+    glm::vec3 centroid{0.f};
+    float bounding_radius = 0.f;
+};
+
+// Read side of a cooked bundle. Sections are views into one mapped (or, for VFS
+// backends without a real path, one read) buffer; only the ozz archives are
+// deserialized, straight out of it.
+class animation_bundle
+{
+public:
+    static constexpr const char* k_extension = ".aanim";
+
+    // Cook side: parse the glTF, read the ozz archives in `ozz_dir` and resolve the
+    // joint remap table by name
+    static bool
+    build(const utils::path& gltf, const utils::path& ozz_dir, animation_bundle_source& out);
+
+    static std::vector<uint8_t>
+    serialize(const animation_bundle_source& src);
+
+    bool
+    open(const utils::path& p);
+
+    bool
+    open(std::vector<uint8_t> bytes);
+
+    bool
+    load_skeleton(ozz::animation::Skeleton& out) const;
+
+    uint32_t
+    clip_count() const
+    {
+        return static_cast<uint32_t>(m_clips.size());
+    }
+
+    std::string_view
+    clip_name(uint32_t idx) const
+    {
+        return m_clips[idx].name;
+    }
+
+    bool
+    load_clip(uint32_t idx, ozz::animation::Animation& out) const;
+
+    std::span<const gpu::skinned_vertex_data>
+    vertices() const
+    {
+        return m_vertices;
+    }
+
+    std::span<const uint32_t>
+    indices() const
+    {
+        return m_indices;
+    }
+
+    std::span<const glm::mat4>
+    inverse_bind_matrices() const
+    {
+        return m_inverse_binds;
+    }
+
+    std::span<const int32_t>
+    joint_remaps() const
+    {
+        return m_joint_remaps;
+    }
+
+    const glm::vec3&
+    centroid() const
+    {
+        return m_centroid;
+    }
+
+    float
+    bounding_radius() const
+    {
+        return m_bounding_radius;
+    }
+
+private:
+    struct clip_view
+    {
+        std::string_view name;
+        std::span<const uint8_t> data;
+    };
+
+    bool
+    parse(std::span<const uint8_t> bytes);
+
+    utils::mapped_file m_mapping;
+    std::vector<uint8_t> m_owned;
+
+    std::span<const uint8_t> m_skeleton;
+    std::vector<clip_view> m_clips;
+    std::span<const gpu::skinned_vertex_data> m_vertices;
+    std::span<const uint32_t> m_indices;
+    std::span<const glm::mat4> m_inverse_binds;
+    std::span<const int32_t> m_joint_remaps;
+    glm::vec3 m_centroid{0.f};
+    float m_bounding_radius = 0.f;
+};
+
+}  // namespace animation
+}  // namespace kryga
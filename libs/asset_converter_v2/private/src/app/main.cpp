@@ -82,6 +82,9 @@ main(int argc, char** argv)
     std::vector<std::string> deps_input;
     bool no_dedup_textures = false;
     bool no_dedup_materials = false;
+    bool no_optimize_meshes = false;
+    bool shadow_indices = false;
+    bool no_lods = false;
 
     app.add_option("-i,--input", input_path, "Input asset file (.glb/.gltf/.obj)")
         ->required()
@@ -104,6 +107,10 @@ main(int argc, char** argv)
     app.add_option("-d,--dep", deps_input, "Package id to declare as dependency (repeatable)");
     app.add_flag("--no-dedup-textures", no_dedup_textures, "Disable texture deduplication");
     app.add_flag("--no-dedup-materials", no_dedup_materials, "Disable material deduplication");
+    app.add_flag("--no-optimize-meshes", no_optimize_meshes, "Keep parsed mesh order as is");
+    app.add_flag(
+        "--shadow-indices", shadow_indices, "Write position-only index lists for depth passes");
+    app.add_flag("--no-lods", no_lods, "Do not generate simplified LOD chains for meshes");
 
     CLI11_PARSE(app, argc, argv);
 
@@ -122,6 +129,9 @@ main(int argc, char** argv)
     opts.prefix = prefix;
     opts.deduplicate_textures = !no_dedup_textures;
     opts.deduplicate_materials = !no_dedup_materials;
+    opts.optimize_meshes = !no_optimize_meshes;
+    opts.shadow_indices = shadow_indices;
+    opts.generate_lods = !no_lods;
 
     for (const auto& d : deps_input)
     {
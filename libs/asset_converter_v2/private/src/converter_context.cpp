@@ -1,4 +1,5 @@
 #include <asset_converter/converter_context.h>
+#include <asset_converter/mesh_optimizer.h>
 
 #include <core/architype.h>
 #include <core/caches/cache_set.h>
@@ -339,6 +340,12 @@ converter_context::save_package(core::package& pkg, const vfs::rid& output_path)
             m->get_vertices_buffer().set_file(bin_dir / (obj.get_id().str() + "_vertices.abin"));
             m->get_indices_buffer().set_file(bin_dir / (obj.get_id().str() + "_indices.abin"));
             m->get_external_buffer().set_file(bin_dir / (obj.get_id().str() + "_external.abin"));
+            m->get_shadow_indices_buffer().set_file(bin_dir /
+                                                    (obj.get_id().str() + "_shadow_indices.abin"));
+            m->get_lod_indices_buffer().set_file(bin_dir /
+                                                 (obj.get_id().str() + "_lod_indices.abin"));
+            m->get_lod_ranges_buffer().set_file(bin_dir /
+                                                (obj.get_id().str() + "_lod_ranges.abin"));
         }
         else if (auto* t = obj.as<root::texture>())
         {
@@ -503,6 +510,26 @@ converter_context::create_mesh(core::package& pkg, const utils::id& id, const pa
     params.vertices.write(data.vertices.data(), data.vertices.size());
     params.indices.write(reinterpret_cast<const uint8_t*>(data.indices.data()),
                          data.indices.size() * sizeof(uint32_t));
+    if (!data.shadow_indices.empty())
+    {
+        params.shadow_indices.write(reinterpret_cast<const uint8_t*>(data.shadow_indices.data()),
+                                    data.shadow_indices.size() * sizeof(uint32_t));
+    }
+    if (!data.lods.empty())
+    {
+        std::vector<uint32_t> lod_indices;
+        std::vector<root::mesh_lod_range> lod_ranges;
+        for (const auto& lod : data.lods)
+        {
+            lod_ranges.push_back(
+                {uint32_t(lod_indices.size()), uint32_t(lod.indices.size()), lod.error});
+            lod_indices.insert(lod_indices.end(), lod.indices.begin(), lod.indices.end());
+        }
+        params.lod_indices.write(reinterpret_cast<const uint8_t*>(lod_indices.data()),
+                                 lod_indices.size() * sizeof(uint32_t));
+        params.lod_ranges.write(reinterpret_cast<const uint8_t*>(lod_ranges.data()),
+                                lod_ranges.size() * sizeof(root::mesh_lod_range));
+    }
 
     // Package assets are class objects, not instances (is_proto = true).
     core::object_constructor ctor(&olc, core::object_load_type::class_obj);
@@ -769,17 +796,28 @@ converter_context::create_package_assets(core::package& pkg,
         }
     }
 
-    for (const auto& mesh_data : scene.meshes)
+    for (const auto& parsed : scene.meshes)
     {
-        std::string mesh_id = make_id(opts, mesh_data.name);
+        std::string mesh_id = make_id(opts, parsed.name);
+
+        parsed_mesh optimized;
+        if (opts.optimize_meshes)
+        {
+            optimized = parsed;
+            optimize_mesh(optimized,
+                          {.shadow_indices = opts.shadow_indices, .lods = opts.generate_lods});
+        }
+        const auto& mesh_data = opts.optimize_meshes ? optimized : parsed;
+
         auto* mesh = create_mesh(pkg, AID(mesh_id), mesh_data);
         if (mesh)
         {
-            ALOG_INFO("[converter]   mesh ok: name=[{}] id=[{}] vbytes={} indices={}",
+            ALOG_INFO("[converter]   mesh ok: name=[{}] id=[{}] vbytes={} indices={} lods={}",
                       mesh_data.name,
                       mesh_id,
                       mesh_data.vertices.size(),
-                      mesh_data.indices.size());
+                      mesh_data.indices.size(),
+                      mesh_data.lods.size());
             ++mesh_created;
         }
         else
@@ -0,0 +1,558 @@
+#include <asset_converter/mesh_optimizer.h>
+
+#include <utils/fnv_hash.h>
+#include <utils/kryga_log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
+namespace kryga::converter
+{
+
+namespace
+{
+
+constexpr size_t k_vertex_stride = sizeof(gpu::vertex_data);
+constexpr uint32_t k_max_cache_size = 64;
+
+// FIFO post-transform cache simulation. A vertex is resident while fewer than
+// `size` misses happened since it entered.
+class fifo_cache
+{
+public:
+    fifo_cache(size_t vertex_count, uint32_t size)
+        : m_stamps(vertex_count, 0)
+        , m_time(size + 1)
+        , m_size(size)
+    {
+    }
+
+    uint32_t
+    triangle(const uint32_t* tri)
+    {
+        return touch(tri[0]) + touch(tri[1]) + touch(tri[2]);
+    }
+
+    void
+    reset()
+    {
+        m_time += m_size + 1;
+    }
+
+private:
+    uint32_t
+    touch(uint32_t v)
+    {
+        if (m_time - m_stamps[v] <= m_size)
+        {
+            return 0;
+        }
+        m_stamps[v] = m_time++;
+        return 1;
+    }
+
+    std::vector<uint32_t> m_stamps;
+    uint32_t m_time;
+    uint32_t m_size;
+};
+
+// Forsyth, "Linear-speed vertex cache optimisation": recently used vertices score
+// by LRU position, and vertices with few triangles left get a boost so they are
+// finished off before they leave the cache
+float
+forsyth_vertex_score(int32_t cache_pos, uint32_t live_tris, uint32_t cache_size)
+{
+    if (live_tris == 0)
+    {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cache_pos >= 0)
+    {
+        score = cache_pos < 3 ? 0.75f
+                              : std::pow(1.0f - float(cache_pos - 3) / float(cache_size - 3), 1.5f);
+    }
+    return score + 2.0f / std::sqrt(float(live_tris));
+}
+
+template <typename Key>
+struct vertex_key_hash
+{
+    std::span<const gpu::vertex_data> vertices;
+
+    size_t
+    operator()(uint32_t v) const
+    {
+        return fnv_hash(Key::data(vertices[v]), Key::size);
+    }
+};
+
+template <typename Key>
+struct vertex_key_equal
+{
+    std::span<const gpu::vertex_data> vertices;
+
+    bool
+    operator()(uint32_t a, uint32_t b) const
+    {
+        return std::memcmp(Key::data(vertices[a]), Key::data(vertices[b]), Key::size) == 0;
+    }
+};
+
+struct whole_vertex
+{
+    static constexpr size_t size = sizeof(gpu::vertex_data);
+
+    static const void*
+    data(const gpu::vertex_data& v)
+    {
+        return &v;
+    }
+};
+
+struct position_only
+{
+    static constexpr size_t size = sizeof(gpu::vertex_data::position);
+
+    static const void*
+    data(const gpu::vertex_data& v)
+    {
+        return &v.position;
+    }
+};
+
+// Maps each vertex to the first one with the same key bytes
+template <typename Key>
+using first_vertex_map =
+    std::unordered_map<uint32_t, uint32_t, vertex_key_hash<Key>, vertex_key_equal<Key>>;
+
+template <typename Key>
+first_vertex_map<Key>
+make_first_vertex_map(std::span<const gpu::vertex_data> vertices)
+{
+    return first_vertex_map<Key>(
+        vertices.size(), vertex_key_hash<Key>{vertices}, vertex_key_equal<Key>{vertices});
+}
+
+}  // namespace
+
+void
+deduplicate_vertices(parsed_mesh& mesh)
+{
+    auto src = vertex_view(mesh);
+    if (mesh.indices.empty())
+    {
+        mesh.indices.resize(src.size());
+        std::iota(mesh.indices.begin(), mesh.indices.end(), 0u);
+    }
+
+    auto unique = make_first_vertex_map<whole_vertex>(src);
+    std::vector<uint32_t> remap(src.size());
+    std::vector<uint8_t> out;
+    out.reserve(mesh.vertices.size());
+
+    for (uint32_t v = 0; v < src.size(); ++v)
+    {
+        auto [itr, inserted] = unique.try_emplace(v, uint32_t(out.size() / k_vertex_stride));
+        if (inserted)
+        {
+            auto* bytes = reinterpret_cast<const uint8_t*>(&src[v]);
+            out.insert(out.end(), bytes, bytes + k_vertex_stride);
+        }
+        remap[v] = itr->second;
+    }
+
+    for (auto& i : mesh.indices)
+    {
+        i = remap[i];
+    }
+    mesh.vertices = std::move(out);
+}
+
+void
+optimize_vertex_cache(std::span<uint32_t> indices, size_t vertex_count, uint32_t cache_size)
+{
+    const size_t tri_count = indices.size() / 3;
+    if (tri_count == 0 || vertex_count == 0)
+    {
+        return;
+    }
+    cache_size = std::clamp(cache_size, 4u, k_max_cache_size);
+
+    // Triangles per vertex; the ones not emitted yet are kept at the front of
+    // each vertex's range, `live` long
+    std::vector<uint32_t> live(vertex_count, 0);
+    for (size_t i = 0; i < tri_count * 3; ++i)
+    {
+        ++live[indices[i]];
+    }
+
+    std::vector<uint32_t> first(vertex_count + 1, 0);
+    for (size_t v = 0; v < vertex_count; ++v)
+    {
+        first[v + 1] = first[v] + live[v];
+    }
+
+    std::vector<uint32_t> adjacency(tri_count * 3);
+    {
+        std::vector<uint32_t> fill(first.begin(), first.end() - 1);
+        for (uint32_t t = 0; t < tri_count; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                adjacency[fill[indices[t * 3 + k]]++] = t;
+            }
+        }
+    }
+
+    std::vector<int32_t> cache_pos(vertex_count, -1);
+    std::vector<float> vertex_score(vertex_count);
+    for (size_t v = 0; v < vertex_count; ++v)
+    {
+        vertex_score[v] = forsyth_vertex_score(-1, live[v], cache_size);
+    }
+
+    std::vector<float> tri_score(tri_count);
+    int64_t best = 0;
+    for (size_t t = 0; t < tri_count; ++t)
+    {
+        tri_score[t] = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] +
+                       vertex_score[indices[t * 3 + 2]];
+        if (tri_score[t] > tri_score[best])
+        {
+            best = int64_t(t);
+        }
+    }
+
+    std::vector<uint8_t> emitted(tri_count, 0);
+    std::vector<uint32_t> out(tri_count * 3);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> next_cache;
+    cache.reserve(cache_size + 3);
+    next_cache.reserve(cache_size + 3);
+    size_t scan = 0;
+
+    for (size_t out_tri = 0; out_tri < tri_count; ++out_tri)
+    {
+        if (best < 0)
+        {
+            // Nothing left around the cache: carry on from the input order
+            while (emitted[scan])
+            {
+                ++scan;
+            }
+            best = int64_t(scan);
+        }
+
+        const uint32_t* tri = &indices[best * 3];
+        std::copy(tri, tri + 3, &out[out_tri * 3]);
+        emitted[best] = 1;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            auto v = tri[k];
+            auto* adj = &adjacency[first[v]];
+            auto* end = adj + live[v];
+            auto* pos = std::find(adj, end, uint32_t(best));
+            if (pos != end)
+            {
+                std::swap(*pos, *(end - 1));
+                --live[v];
+            }
+        }
+
+        // LRU order: this triangle's vertices, then the rest of the old cache
+        next_cache.clear();
+        for (int k = 0; k < 3; ++k)
+        {
+            if (std::find(next_cache.begin(), next_cache.end(), tri[k]) == next_cache.end())
+            {
+                next_cache.push_back(tri[k]);
+            }
+        }
+        for (auto v : cache)
+        {
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+            {
+                next_cache.push_back(v);
+            }
+        }
+
+        // Rescore everything that moved, including the vertices falling out
+        for (size_t i = 0; i < next_cache.size(); ++i)
+        {
+            auto v = next_cache[i];
+            cache_pos[v] = i < cache_size ? int32_t(i) : -1;
+
+            float score = forsyth_vertex_score(cache_pos[v], live[v], cache_size);
+            float diff = score - vertex_score[v];
+            vertex_score[v] = score;
+            for (uint32_t j = 0; j < live[v]; ++j)
+            {
+                tri_score[adjacency[first[v] + j]] += diff;
+            }
+        }
+        if (next_cache.size() > cache_size)
+        {
+            next_cache.resize(cache_size);
+        }
+        std::swap(cache, next_cache);
+
+        best = -1;
+        float best_score = -1.0f;
+        for (auto v : cache)
+        {
+            for (uint32_t j = 0; j < live[v]; ++j)
+            {
+                auto t = adjacency[first[v] + j];
+                if (tri_score[t] > best_score)
+                {
+                    best = int64_t(t);
+                    best_score = tri_score[t];
+                }
+            }
+        }
+    }
+
+    std::copy(out.begin(), out.end(), indices.begin());
+}
+
+void
+optimize_overdraw(std::span<uint32_t> indices,
+                  std::span<const gpu::vertex_data> vertices,
+                  float threshold,
+                  uint32_t cache_size)
+{
+    const auto tri_count = uint32_t(indices.size() / 3);
+    if (tri_count < 2)
+    {
+        return;
+    }
+
+    // Hard boundaries: triangles that miss on every vertex, where the cache order
+    // starts over anyway
+    fifo_cache cache(vertices.size(), cache_size);
+    std::vector<uint32_t> hard;
+    for (uint32_t t = 0; t < tri_count; ++t)
+    {
+        if (cache.triangle(&indices[t * 3]) == 3 || t == 0)
+        {
+            hard.push_back(t);
+        }
+    }
+    hard.push_back(tri_count);
+
+    // Soft boundaries: split a hard cluster once the part so far, drawn from a cold
+    // cache, is within `threshold` of the whole cluster's miss ratio
+    std::vector<uint32_t> bounds;
+    for (size_t h = 0; h + 1 < hard.size(); ++h)
+    {
+        const uint32_t begin = hard[h], end = hard[h + 1];
+
+        cache.reset();
+        uint32_t misses = 0;
+        for (uint32_t t = begin; t < end; ++t)
+        {
+            misses += cache.triangle(&indices[t * 3]);
+        }
+        const float target = float(misses) / float(end - begin) * threshold;
+
+        cache.reset();
+        misses = 0;
+        uint32_t start = begin;
+        bounds.push_back(begin);
+        for (uint32_t t = begin; t + 1 < end; ++t)
+        {
+            misses += cache.triangle(&indices[t * 3]);
+            if (float(misses) / float(t + 1 - start) <= target)
+            {
+                start = t + 1;
+                bounds.push_back(start);
+                cache.reset();
+                misses = 0;
+            }
+        }
+    }
+    bounds.push_back(tri_count);
+
+    struct cluster
+    {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        glm::vec3 centroid{0.0f};  // area weighted
+        glm::vec3 normal{0.0f};    // sum of area-scaled face normals
+        float area = 0.0f;
+        float key = 0.0f;
+    };
+
+    std::vector<cluster> clusters(bounds.size() - 1);
+    glm::vec3 mesh_centroid{0.0f};
+    float mesh_area = 0.0f;
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        auto& cl = clusters[c];
+        cl.begin = bounds[c];
+        cl.end = bounds[c + 1];
+        for (uint32_t t = cl.begin; t < cl.end; ++t)
+        {
+            const auto& p0 = vertices[indices[t * 3]].position;
+            const auto& p1 = vertices[indices[t * 3 + 1]].position;
+            const auto& p2 = vertices[indices[t * 3 + 2]].position;
+
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            float a = glm::length(n);
+            cl.centroid += (p0 + p1 + p2) * (a / 3.0f);
+            cl.normal += n;
+            cl.area += a;
+        }
+        mesh_centroid += cl.centroid;
+        mesh_area += cl.area;
+        if (cl.area > 0.0f)
+        {
+            cl.centroid /= cl.area;
+        }
+    }
+    if (mesh_area <= 0.0f)
+    {
+        return;
+    }
+    mesh_centroid /= mesh_area;
+
+    // Clusters facing away from the middle of the mesh occlude the rest from most
+    // view directions, so they go first
+    for (auto& cl : clusters)
+    {
+        float len = glm::length(cl.normal);
+        cl.key = len > 0.0f ? glm::dot(cl.centroid - mesh_centroid, cl.normal / len) : 0.0f;
+    }
+    std::stable_sort(clusters.begin(),
+                     clusters.end(),
+                     [](const cluster& l, const cluster& r) { return l.key > r.key; });
+
+    std::vector<uint32_t> out;
+    out.reserve(indices.size());
+    for (const auto& cl : clusters)
+    {
+        out.insert(out.end(), &indices[cl.begin * 3], &indices[0] + cl.end * 3);
+    }
+    std::copy(out.begin(), out.end(), indices.begin());
+}
+
+void
+optimize_vertex_fetch(parsed_mesh& mesh)
+{
+    constexpr uint32_t k_unused = ~0u;
+
+    auto src = vertex_view(mesh);
+    std::vector<uint32_t> remap(src.size(), k_unused);
+    std::vector<uint8_t> out;
+    out.reserve(mesh.vertices.size());
+
+    uint32_t next = 0;
+    for (auto& i : mesh.indices)
+    {
+        if (remap[i] == k_unused)
+        {
+            remap[i] = next++;
+            auto* bytes = reinterpret_cast<const uint8_t*>(&src[i]);
+            out.insert(out.end(), bytes, bytes + k_vertex_stride);
+        }
+        i = remap[i];
+    }
+
+    // Built from the main list, so every vertex they use is already placed
+    for (auto& i : mesh.shadow_indices)
+    {
+        i = remap[i];
+    }
+    for (auto& lod : mesh.lods)
+    {
+        for (auto& i : lod.indices)
+        {
+            i = remap[i];
+        }
+    }
+    mesh.vertices = std::move(out);
+}
+
+std::vector<uint32_t>
+build_shadow_indices(std::span<const uint32_t> indices,
+                     std::span<const gpu::vertex_data> vertices,
+                     uint32_t cache_size)
+{
+    auto first = make_first_vertex_map<position_only>(vertices);
+
+    std::vector<uint32_t> out(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        out[i] = first.try_emplace(indices[i], indices[i]).first->second;
+    }
+
+    optimize_vertex_cache(out, vertices.size(), cache_size);
+    return out;
+}
+
+float
+analyze_vertex_cache(std::span<const uint32_t> indices, size_t vertex_count, uint32_t cache_size)
+{
+    const size_t tri_count = indices.size() / 3;
+    if (tri_count == 0)
+    {
+        return 0.0f;
+    }
+
+    fifo_cache cache(vertex_count, cache_size);
+    uint32_t misses = 0;
+    for (size_t t = 0; t < tri_count; ++t)
+    {
+        misses += cache.triangle(&indices[t * 3]);
+    }
+    return float(misses) / float(tri_count);
+}
+
+void
+optimize_mesh(parsed_mesh& mesh, const mesh_optimize_options& opts)
+{
+    const auto vertex_count = vertex_view(mesh).size();
+    if (vertex_count == 0)
+    {
+        return;
+    }
+
+    if (mesh.indices.size() % 3 ||
+        std::any_of(mesh.indices.begin(),
+                    mesh.indices.end(),
+                    [vertex_count](uint32_t i) { return i >= vertex_count; }))
+    {
+        ALOG_WARN("[converter] mesh [{}] has a malformed index list, left unoptimised", mesh.name);
+        return;
+    }
+
+    mesh.shadow_indices.clear();
+    mesh.lods.clear();
+
+    deduplicate_vertices(mesh);
+    optimize_vertex_cache(mesh.indices, vertex_view(mesh).size(), opts.cache_size);
+    optimize_overdraw(mesh.indices, vertex_view(mesh), opts.overdraw_threshold, opts.cache_size);
+
+    if (opts.lods)
+    {
+        build_lod_chain(mesh, opts.lod);
+        for (auto& lod : mesh.lods)
+        {
+            optimize_vertex_cache(lod.indices, vertex_view(mesh).size(), opts.cache_size);
+        }
+    }
+    optimize_vertex_fetch(mesh);
+
+    if (opts.shadow_indices)
+    {
+        mesh.shadow_indices = build_shadow_indices(mesh.indices, vertex_view(mesh), opts.cache_size);
+    }
+}
+
+}  // namespace kryga::converter
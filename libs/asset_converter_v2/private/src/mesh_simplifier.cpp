@@ -0,0 +1,402 @@
+#include <asset_converter/mesh_simplifier.h>
+
+#include <asset_converter/mesh_optimizer.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+
+namespace kryga::converter
+{
+
+namespace
+{
+
+// Collapses rejected when the new face normal leans further than this from the
+// old one (cosine)
+constexpr double k_max_normal_change = 0.25;
+
+// Symmetric plane quadric, area weighted: error(p) = p^T A p + 2 b^T p + c
+struct quadric
+{
+    double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+    double b0 = 0, b1 = 0, b2 = 0;
+    double c = 0;
+    double w = 0;
+
+    void
+    add_plane(double nx, double ny, double nz, double d, double weight)
+    {
+        a00 += weight * nx * nx;
+        a01 += weight * nx * ny;
+        a02 += weight * nx * nz;
+        a11 += weight * ny * ny;
+        a12 += weight * ny * nz;
+        a22 += weight * nz * nz;
+        b0 += weight * nx * d;
+        b1 += weight * ny * d;
+        b2 += weight * nz * d;
+        c += weight * d * d;
+        w += weight;
+    }
+
+    quadric&
+    operator+=(const quadric& o)
+    {
+        a00 += o.a00, a01 += o.a01, a02 += o.a02, a11 += o.a11, a12 += o.a12, a22 += o.a22;
+        b0 += o.b0, b1 += o.b1, b2 += o.b2;
+        c += o.c;
+        w += o.w;
+        return *this;
+    }
+
+    // Mean squared distance to the accumulated planes
+    double
+    error(const glm::vec3& p) const
+    {
+        const double x = p.x, y = p.y, z = p.z;
+        double e = a00 * x * x + a11 * y * y + a22 * z * z +
+                   2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                   2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        return w > 0.0 ? std::abs(e) / w : 0.0;
+    }
+};
+
+struct collapse
+{
+    double cost = 0.0;
+    uint32_t from = 0;    // position group that goes away
+    uint32_t to = 0;      // position group it lands on
+    uint32_t vertex = 0;  // vertex of `to` taking over `from`'s corners
+};
+
+glm::vec3
+face_normal(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2)
+{
+    return glm::cross(p1 - p0, p2 - p0);
+}
+
+uint64_t
+edge_key(uint32_t a, uint32_t b)
+{
+    return a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+}
+
+}  // namespace
+
+float
+simplify(std::span<const uint32_t> indices,
+         std::span<const gpu::vertex_data> vertices,
+         size_t target_index_count,
+         float target_error,
+         std::vector<uint32_t>& out)
+{
+    out.assign(indices.begin(), indices.end());
+    if (indices.size() < 3 || out.size() <= target_index_count)
+    {
+        return 0.0f;
+    }
+
+    // Position groups: vertices split only by attributes share one, and the
+    // topology is walked in group space so seams do not look like borders
+    std::vector<uint32_t> order(vertices.size());
+    std::iota(order.begin(), order.end(), 0u);
+    auto position_less = [&](uint32_t l, uint32_t r)
+    {
+        const auto& a = vertices[l].position;
+        const auto& b = vertices[r].position;
+        if (a.x != b.x)
+        {
+            return a.x < b.x;
+        }
+        if (a.y != b.y)
+        {
+            return a.y < b.y;
+        }
+        if (a.z != b.z)
+        {
+            return a.z < b.z;
+        }
+        return l < r;
+    };
+    std::sort(order.begin(), order.end(), position_less);
+
+    std::vector<uint32_t> group(vertices.size());
+    uint32_t group_count = 0;
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        if (i > 0)
+        {
+            const auto& a = vertices[order[i - 1]].position;
+            const auto& b = vertices[order[i]].position;
+            group_count += (a.x != b.x || a.y != b.y || a.z != b.z) ? 1 : 0;
+        }
+        group[order[i]] = group_count;
+    }
+    ++group_count;
+
+    // Locked groups never move: seams (more than one vertex in use) and open or
+    // non-manifold edges
+    constexpr uint32_t k_none = ~0u;
+    std::vector<uint32_t> group_vertex(group_count, k_none);
+    std::vector<uint8_t> locked(group_count, 0);
+    std::vector<quadric> quadrics(group_count);
+    std::unordered_map<uint64_t, uint32_t> edge_use;
+    edge_use.reserve(indices.size());
+
+    for (size_t t = 0; t + 2 < indices.size(); t += 3)
+    {
+        const auto& p0 = vertices[indices[t]].position;
+        const auto& p1 = vertices[indices[t + 1]].position;
+        const auto& p2 = vertices[indices[t + 2]].position;
+
+        glm::vec3 n = face_normal(p0, p1, p2);
+        double len = glm::length(n);
+        if (len > 0.0)
+        {
+            double nx = n.x / len, ny = n.y / len, nz = n.z / len;
+            double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+            for (int k = 0; k < 3; ++k)
+            {
+                quadrics[group[indices[t + k]]].add_plane(nx, ny, nz, d, len * 0.5);
+            }
+        }
+
+        for (int k = 0; k < 3; ++k)
+        {
+            auto v = indices[t + k];
+            auto g = group[v];
+            if (group_vertex[g] == k_none)
+            {
+                group_vertex[g] = v;
+            }
+            else if (group_vertex[g] != v)
+            {
+                locked[g] = 1;
+            }
+            ++edge_use[edge_key(g, group[indices[t + (k + 1) % 3]])];
+        }
+    }
+    for (const auto& [key, count] : edge_use)
+    {
+        if (count != 2)
+        {
+            locked[uint32_t(key >> 32)] = 1;
+            locked[uint32_t(key)] = 1;
+        }
+    }
+
+    const double max_cost = double(target_error) * double(target_error);
+    double reached = 0.0;
+
+    std::vector<uint8_t> removed(group_count, 0);
+    std::vector<uint8_t> frozen(group_count, 0);
+    std::vector<uint32_t> remap(vertices.size());
+    std::vector<uint32_t> first(group_count + 1);
+    std::vector<uint32_t> adjacency;
+    std::vector<collapse> candidates;
+
+    // Each pass collapses the cheapest independent edges, then rebuilds
+    while (out.size() > target_index_count)
+    {
+        const size_t tri_count = out.size() / 3;
+
+        std::fill(first.begin(), first.end(), 0u);
+        for (auto v : out)
+        {
+            ++first[group[v] + 1];
+        }
+        std::partial_sum(first.begin(), first.end(), first.begin());
+        adjacency.resize(out.size());
+        {
+            std::vector<uint32_t> fill(first.begin(), first.end() - 1);
+            for (uint32_t t = 0; t < tri_count; ++t)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    adjacency[fill[group[out[t * 3 + k]]]++] = t;
+                }
+            }
+        }
+
+        candidates.clear();
+        for (size_t t = 0; t < tri_count; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                auto a = out[t * 3 + k], b = out[t * 3 + (k + 1) % 3];
+                for (auto [from, to] : {std::pair{a, b}, std::pair{b, a}})
+                {
+                    auto gf = group[from], gt = group[to];
+                    if (locked[gf])
+                    {
+                        continue;
+                    }
+                    quadric q = quadrics[gf];
+                    q += quadrics[gt];
+                    double cost = q.error(vertices[to].position);
+                    if (cost <= max_cost)
+                    {
+                        candidates.push_back({cost, gf, gt, to});
+                    }
+                }
+            }
+        }
+        std::sort(candidates.begin(),
+                  candidates.end(),
+                  [](const collapse& l, const collapse& r)
+                  {
+                      return std::tie(l.cost, l.from, l.to) < std::tie(r.cost, r.from, r.to);
+                  });
+
+        std::fill(frozen.begin(), frozen.end(), 0);
+        std::iota(remap.begin(), remap.end(), 0u);
+
+        // Every collapse of an interior vertex removes two triangles
+        const size_t wanted = (out.size() - target_index_count + 5) / 6;
+        size_t collapsed = 0;
+
+        for (const auto& c : candidates)
+        {
+            if (collapsed >= wanted)
+            {
+                break;
+            }
+            if (removed[c.from] || removed[c.to] || frozen[c.from] || frozen[c.to])
+            {
+                continue;
+            }
+
+            // Surviving triangles around `from` must not fold over
+            const auto& target = vertices[c.vertex].position;
+            bool flips = false;
+            for (uint32_t j = first[c.from]; j < first[c.from + 1] && !flips; ++j)
+            {
+                const uint32_t* tri = &out[adjacency[j] * 3];
+                if (group[tri[0]] == c.to || group[tri[1]] == c.to || group[tri[2]] == c.to)
+                {
+                    continue;
+                }
+
+                std::array<glm::vec3, 3> p;
+                for (int k = 0; k < 3; ++k)
+                {
+                    p[k] = vertices[tri[k]].position;
+                }
+                glm::vec3 before = face_normal(p[0], p[1], p[2]);
+                for (int k = 0; k < 3; ++k)
+                {
+                    if (group[tri[k]] == c.from)
+                    {
+                        p[k] = target;
+                    }
+                }
+                glm::vec3 after = face_normal(p[0], p[1], p[2]);
+
+                double d = glm::dot(before, after);
+                flips = d <= k_max_normal_change * glm::length(before) * glm::length(after);
+            }
+            if (flips)
+            {
+                continue;
+            }
+
+            // `from` is not a seam, so a single vertex stands for it
+            for (uint32_t j = first[c.from]; j < first[c.from + 1]; ++j)
+            {
+                const uint32_t* tri = &out[adjacency[j] * 3];
+                for (int k = 0; k < 3; ++k)
+                {
+                    frozen[group[tri[k]]] = 1;
+                    if (group[tri[k]] == c.from)
+                    {
+                        remap[tri[k]] = c.vertex;
+                    }
+                }
+            }
+            removed[c.from] = 1;
+            quadrics[c.to] += quadrics[c.from];
+            reached = std::max(reached, c.cost);
+            ++collapsed;
+        }
+
+        if (collapsed == 0)
+        {
+            break;
+        }
+
+        size_t write = 0;
+        for (size_t t = 0; t < tri_count; ++t)
+        {
+            uint32_t a = remap[out[t * 3]], b = remap[out[t * 3 + 1]], c = remap[out[t * 3 + 2]];
+            if (group[a] == group[b] || group[b] == group[c] || group[a] == group[c])
+            {
+                continue;
+            }
+            out[write++] = a;
+            out[write++] = b;
+            out[write++] = c;
+        }
+        out.resize(write);
+    }
+
+    return float(std::sqrt(reached));
+}
+
+void
+build_lod_chain(parsed_mesh& mesh, const lod_chain_options& opts)
+{
+    mesh.lods.clear();
+
+    auto vertices = vertex_view(mesh);
+    if (mesh.indices.size() / 3 < opts.min_triangles || vertices.empty())
+    {
+        return;
+    }
+
+    glm::vec3 lo = vertices[0].position, hi = vertices[0].position;
+    for (const auto& v : vertices)
+    {
+        lo = {std::min(lo.x, v.position.x), std::min(lo.y, v.position.y),
+              std::min(lo.z, v.position.z)};
+        hi = {std::max(hi.x, v.position.x), std::max(hi.y, v.position.y),
+              std::max(hi.z, v.position.z)};
+    }
+    const glm::vec3 center = (lo + hi) * 0.5f;
+    float radius = 0.0f;
+    for (const auto& v : vertices)
+    {
+        radius = std::max(radius, glm::length(v.position - center));
+    }
+    if (radius <= 0.0f)
+    {
+        return;
+    }
+
+    // Every level starts from the full mesh so errors do not stack up
+    size_t previous = mesh.indices.size();
+    float error = 0.0f;
+    for (uint32_t level = 0; level < opts.max_levels; ++level)
+    {
+        const size_t target = size_t(float(previous) * opts.reduction) / 3 * 3;
+
+        parsed_lod lod;
+        float reached =
+            simplify(mesh.indices, vertices, target, opts.max_error * radius, lod.indices);
+        if (lod.indices.empty() ||
+            float(lod.indices.size()) > float(previous) * opts.min_reduction)
+        {
+            break;
+        }
+
+        error = std::max(error, reached / radius);
+        lod.error = error;
+        previous = lod.indices.size();
+        mesh.lods.push_back(std::move(lod));
+    }
+}
+
+}  // namespace kryga::converter
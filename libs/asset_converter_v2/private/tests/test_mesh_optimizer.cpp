@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+
+#include <asset_converter/mesh_optimizer.h>
+
+#include <gpu_types/gpu_vertex_types.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace kryga;
+using namespace kryga::converter;
+
+namespace
+{
+
+parsed_mesh
+make_mesh(const std::vector<gpu::vertex_data>& vertices, std::vector<uint32_t> indices = {})
+{
+    parsed_mesh m;
+    m.name = "test";
+    m.vertices.resize(vertices.size() * sizeof(gpu::vertex_data));
+    std::memcpy(m.vertices.data(), vertices.data(), m.vertices.size());
+    m.indices = std::move(indices);
+    return m;
+}
+
+gpu::vertex_data
+vertex(glm::vec3 p, glm::vec3 n = {0.f, 1.f, 0.f}, glm::vec2 uv = {0.f, 0.f})
+{
+    gpu::vertex_data v{};
+    v.position = p;
+    v.normal = n;
+    v.uv = uv;
+    return v;
+}
+
+// Triangles as sorted position triples: order-independent, so every optimisation
+// pass must leave this unchanged
+std::vector<std::array<float, 9>>
+triangle_set(std::span<const uint32_t> indices, std::span<const gpu::vertex_data> vertices)
+{
+    std::vector<std::array<float, 9>> out;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3)
+    {
+        // Rotate so the smallest vertex leads, which keeps the winding
+        std::array<std::array<float, 3>, 3> c;
+        for (int k = 0; k < 3; ++k)
+        {
+            const auto& p = vertices[indices[t + k]].position;
+            c[k] = {p.x, p.y, p.z};
+        }
+        std::rotate(c.begin(), std::min_element(c.begin(), c.end()), c.end());
+
+        std::array<float, 9> tri;
+        for (int k = 0; k < 3; ++k)
+        {
+            std::copy(c[k].begin(), c[k].end(), tri.begin() + k * 3);
+        }
+        out.push_back(tri);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// Regular grid with its triangles in a scrambled but fixed order
+parsed_mesh
+make_scrambled_grid(uint32_t n)
+{
+    std::vector<gpu::vertex_data> vertices;
+    for (uint32_t y = 0; y <= n; ++y)
+    {
+        for (uint32_t x = 0; x <= n; ++x)
+        {
+            vertices.push_back(vertex({float(x), 0.f, float(y)}));
+        }
+    }
+
+    std::vector<std::array<uint32_t, 3>> tris;
+    for (uint32_t y = 0; y < n; ++y)
+    {
+        for (uint32_t x = 0; x < n; ++x)
+        {
+            uint32_t i = y * (n + 1) + x;
+            tris.push_back({i, i + n + 1, i + 1});
+            tris.push_back({i + 1, i + n + 1, i + n + 2});
+        }
+    }
+
+    // 7919 is prime and coprime with the triangle count, so this is a permutation
+    std::vector<uint32_t> indices;
+    for (size_t t = 0; t < tris.size(); ++t)
+    {
+        const auto& tri = tris[(t * 7919) % tris.size()];
+        indices.insert(indices.end(), tri.begin(), tri.end());
+    }
+    return make_mesh(vertices, indices);
+}
+
+// Unit sphere, one vertex per face corner so every edge is a seam
+parsed_mesh
+make_faceted_sphere(uint32_t rings, uint32_t segments)
+{
+    auto point = [&](uint32_t r, uint32_t s)
+    {
+        if (r == 0 || r == rings)
+        {
+            return glm::vec3(0.f, r == 0 ? 1.f : -1.f, 0.f);
+        }
+        s %= segments;
+        float theta = float(r) / float(rings) * 3.14159265f;
+        float phi = float(s) / float(segments) * 6.28318531f;
+        return glm::vec3(
+            std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+    };
+
+    std::vector<gpu::vertex_data> vertices;
+    for (uint32_t r = 0; r < rings; ++r)
+    {
+        for (uint32_t s = 0; s < segments; ++s)
+        {
+            auto a = point(r, s), b = point(r + 1, s), c = point(r + 1, s + 1),
+                 d = point(r, s + 1);
+            auto n = glm::normalize(a + b + c + d);
+            for (const auto& p : {a, c, b, a, d, c})
+            {
+                vertices.push_back(vertex(p, n));
+            }
+        }
+    }
+    return make_mesh(vertices);
+}
+
+}  // namespace
+
+TEST(MeshOptimizer, DeduplicatesIdenticalVertices)
+{
+    auto a = vertex({0.f, 0.f, 0.f}), b = vertex({1.f, 0.f, 0.f}), c = vertex({1.f, 0.f, 1.f}),
+         d = vertex({0.f, 0.f, 1.f});
+    auto mesh = make_mesh({a, c, b, a, d, c});
+
+    auto before = triangle_set(std::vector<uint32_t>{0, 1, 2, 3, 4, 5}, vertex_view(mesh));
+    deduplicate_vertices(mesh);
+
+    EXPECT_EQ(vertex_view(mesh).size(), 4u);
+    ASSERT_EQ(mesh.indices.size(), 6u);
+    EXPECT_EQ(triangle_set(mesh.indices, vertex_view(mesh)), before);
+}
+
+TEST(MeshOptimizer, DeduplicationKeepsSeams)
+{
+    auto mesh = make_mesh({vertex({0.f, 0.f, 0.f}, {0.f, 1.f, 0.f}),
+                           vertex({0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}),
+                           vertex({0.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.5f, 0.f})},
+                          {0, 1, 2});
+    deduplicate_vertices(mesh);
+
+    EXPECT_EQ(vertex_view(mesh).size(), 3u);
+}
+
+TEST(MeshOptimizer, VertexCacheLowersMissRatio)
+{
+    auto mesh = make_scrambled_grid(32);
+    const auto vertex_count = vertex_view(mesh).size();
+    auto before = triangle_set(mesh.indices, vertex_view(mesh));
+    float acmr_before = analyze_vertex_cache(mesh.indices, vertex_count, 16);
+
+    optimize_vertex_cache(mesh.indices, vertex_count, 16);
+    float acmr_after = analyze_vertex_cache(mesh.indices, vertex_count, 16);
+
+    EXPECT_EQ(triangle_set(mesh.indices, vertex_view(mesh)), before);
+    EXPECT_GT(acmr_before, 2.0f);
+    EXPECT_LT(acmr_after, 0.8f);
+}
+
+TEST(MeshOptimizer, OverdrawOrderKeepsTrianglesAndCacheEfficiency)
+{
+    auto mesh = make_faceted_sphere(16, 32);
+    deduplicate_vertices(mesh);
+    const auto vertex_count = vertex_view(mesh).size();
+    auto before = triangle_set(mesh.indices, vertex_view(mesh));
+
+    optimize_vertex_cache(mesh.indices, vertex_count, 16);
+    float acmr_cache = analyze_vertex_cache(mesh.indices, vertex_count, 16);
+
+    optimize_overdraw(mesh.indices, vertex_view(mesh), 1.05f, 16);
+    float acmr_overdraw = analyze_vertex_cache(mesh.indices, vertex_count, 16);
+
+    EXPECT_EQ(triangle_set(mesh.indices, vertex_view(mesh)), before);
+    EXPECT_LT(acmr_overdraw, acmr_cache * 1.25f);
+}
+
+TEST(MeshOptimizer, FetchOrderFollowsFirstUse)
+{
+    auto mesh = make_mesh({vertex({9.f, 0.f, 0.f}),  // never referenced
+                           vertex({0.f, 0.f, 0.f}),
+                           vertex({1.f, 0.f, 0.f}),
+                           vertex({1.f, 0.f, 1.f}),
+                           vertex({0.f, 0.f, 1.f})},
+                          {3, 2, 1, 1, 4, 3});
+    auto before = triangle_set(mesh.indices, vertex_view(mesh));
+
+    optimize_vertex_fetch(mesh);
+
+    EXPECT_EQ(vertex_view(mesh).size(), 4u);
+    EXPECT_EQ(mesh.indices, (std::vector<uint32_t>{0, 1, 2, 2, 3, 0}));
+    EXPECT_EQ(triangle_set(mesh.indices, vertex_view(mesh)), before);
+}
+
+TEST(MeshOptimizer, ShadowIndicesWeldSeams)
+{
+    auto mesh = make_faceted_sphere(8, 16);
+    optimize_mesh(mesh, {.shadow_indices = true});
+
+    auto vertices = vertex_view(mesh);
+    ASSERT_EQ(mesh.shadow_indices.size(), mesh.indices.size());
+    EXPECT_EQ(triangle_set(mesh.shadow_indices, vertices), triangle_set(mesh.indices, vertices));
+
+    std::vector<uint32_t> used(mesh.shadow_indices);
+    std::sort(used.begin(), used.end());
+    used.erase(std::unique(used.begin(), used.end()), used.end());
+
+    // Two poles plus one ring of segments per inner latitude
+    EXPECT_EQ(used.size(), 2u + 7u * 16u);
+    EXPECT_LT(used.size(), vertices.size());
+}
+
+TEST(MeshOptimizer, OptimizationIsDeterministic)
+{
+    auto first = make_faceted_sphere(12, 24);
+    auto second = first;
+
+    optimize_mesh(first, {.shadow_indices = true});
+    optimize_mesh(second, {.shadow_indices = true});
+
+    EXPECT_EQ(first.vertices, second.vertices);
+    EXPECT_EQ(first.indices, second.indices);
+    EXPECT_EQ(first.shadow_indices, second.shadow_indices);
+}
+
+TEST(MeshOptimizer, MalformedIndicesAreLeftAlone)
+{
+    auto mesh = make_mesh({vertex({0.f, 0.f, 0.f}), vertex({1.f, 0.f, 0.f})}, {0, 1, 7});
+    auto copy = mesh;
+
+    optimize_mesh(mesh);
+
+    EXPECT_EQ(mesh.vertices, copy.vertices);
+    EXPECT_EQ(mesh.indices, copy.indices);
+}
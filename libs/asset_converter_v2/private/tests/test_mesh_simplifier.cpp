@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include <asset_converter/mesh_optimizer.h>
+#include <asset_converter/mesh_simplifier.h>
+
+#include <gpu_types/gpu_vertex_types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <set>
+#include <vector>
+
+using namespace kryga;
+using namespace kryga::converter;
+
+namespace
+{
+
+parsed_mesh
+make_mesh(const std::vector<gpu::vertex_data>& vertices, std::vector<uint32_t> indices)
+{
+    parsed_mesh m;
+    m.name = "test";
+    m.vertices.resize(vertices.size() * sizeof(gpu::vertex_data));
+    std::memcpy(m.vertices.data(), vertices.data(), m.vertices.size());
+    m.indices = std::move(indices);
+    return m;
+}
+
+gpu::vertex_data
+vertex(glm::vec3 p, glm::vec3 n = {0.f, 1.f, 0.f}, glm::vec2 uv = {0.f, 0.f})
+{
+    gpu::vertex_data v{};
+    v.position = p;
+    v.normal = n;
+    v.uv = uv;
+    return v;
+}
+
+// Flat n x n grid in the xz plane. With `seam`, the middle column is split: the
+// right half uses copies with a different uv.
+parsed_mesh
+make_grid(uint32_t n, bool seam = false)
+{
+    std::vector<gpu::vertex_data> vertices;
+    for (uint32_t y = 0; y <= n; ++y)
+    {
+        for (uint32_t x = 0; x <= n; ++x)
+        {
+            vertices.push_back(vertex({float(x), 0.f, float(y)}));
+        }
+    }
+
+    const uint32_t mid = n / 2;
+    std::vector<uint32_t> copy(vertices.size());
+    for (uint32_t y = 0; y <= n; ++y)
+    {
+        uint32_t i = y * (n + 1) + mid;
+        copy[i] = i;
+        if (seam)
+        {
+            copy[i] = uint32_t(vertices.size());
+            vertices.push_back(vertex({float(mid), 0.f, float(y)}, {0.f, 1.f, 0.f}, {1.f, 0.f}));
+        }
+    }
+
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y < n; ++y)
+    {
+        for (uint32_t x = 0; x < n; ++x)
+        {
+            uint32_t i = y * (n + 1) + x;
+            uint32_t q[4] = {i, i + 1, i + n + 1, i + n + 2};
+            if (x == mid)
+            {
+                q[0] = copy[q[0]];
+                q[2] = copy[q[2]];
+            }
+            indices.insert(indices.end(), {q[0], q[2], q[1], q[1], q[2], q[3]});
+        }
+    }
+    return make_mesh(vertices, indices);
+}
+
+// Unit sphere with shared vertices, closed and without seams
+parsed_mesh
+make_smooth_sphere(uint32_t rings, uint32_t segments)
+{
+    std::vector<gpu::vertex_data> vertices;
+    vertices.push_back(vertex({0.f, 1.f, 0.f}, {0.f, 1.f, 0.f}));
+    for (uint32_t r = 1; r < rings; ++r)
+    {
+        for (uint32_t s = 0; s < segments; ++s)
+        {
+            float theta = float(r) / float(rings) * 3.14159265f;
+            float phi = float(s) / float(segments) * 6.28318531f;
+            glm::vec3 p(
+                std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+            vertices.push_back(vertex(p, p));
+        }
+    }
+    vertices.push_back(vertex({0.f, -1.f, 0.f}, {0.f, -1.f, 0.f}));
+    const auto bottom = uint32_t(vertices.size() - 1);
+
+    auto at = [&](uint32_t r, uint32_t s) { return 1 + (r - 1) * segments + s % segments; };
+
+    std::vector<uint32_t> indices;
+    for (uint32_t s = 0; s < segments; ++s)
+    {
+        indices.insert(indices.end(), {0u, at(1, s + 1), at(1, s)});
+        indices.insert(indices.end(), {bottom, at(rings - 1, s), at(rings - 1, s + 1)});
+    }
+    for (uint32_t r = 1; r + 1 < rings; ++r)
+    {
+        for (uint32_t s = 0; s < segments; ++s)
+        {
+            indices.insert(indices.end(), {at(r, s), at(r, s + 1), at(r + 1, s)});
+            indices.insert(indices.end(), {at(r, s + 1), at(r + 1, s + 1), at(r + 1, s)});
+        }
+    }
+    return make_mesh(vertices, indices);
+}
+
+float
+area(std::span<const uint32_t> indices, std::span<const gpu::vertex_data> vertices)
+{
+    float sum = 0.0f;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3)
+    {
+        const auto& p0 = vertices[indices[t]].position;
+        sum += 0.5f * glm::length(glm::cross(vertices[indices[t + 1]].position - p0,
+                                             vertices[indices[t + 2]].position - p0));
+    }
+    return sum;
+}
+
+}  // namespace
+
+TEST(MeshSimplifier, FlatGridCollapsesToItsBorder)
+{
+    auto mesh = make_grid(16);
+    auto vertices = vertex_view(mesh);
+
+    std::vector<uint32_t> out;
+    float error = simplify(mesh.indices, vertices, 0, 1e-3f, out);
+
+    EXPECT_LT(out.size(), mesh.indices.size() / 4);
+    EXPECT_LT(error, 1e-4f);
+    EXPECT_NEAR(area(out, vertices), area(mesh.indices, vertices), 1e-3f);
+
+    // Open borders are locked
+    std::set<uint32_t> used(out.begin(), out.end());
+    for (uint32_t i = 0; i <= 16; ++i)
+    {
+        EXPECT_TRUE(used.count(i));
+        EXPECT_TRUE(used.count(16 * 17 + i));
+        EXPECT_TRUE(used.count(i * 17));
+        EXPECT_TRUE(used.count(i * 17 + 16));
+    }
+}
+
+TEST(MeshSimplifier, SeamVerticesStay)
+{
+    auto mesh = make_grid(16, true);
+    auto vertices = vertex_view(mesh);
+
+    std::vector<uint32_t> out;
+    simplify(mesh.indices, vertices, 0, 1e-3f, out);
+
+    EXPECT_LT(out.size(), mesh.indices.size() / 2);
+    EXPECT_NEAR(area(out, vertices), area(mesh.indices, vertices), 1e-3f);
+
+    // Both sides of the seam keep every one of their vertices
+    std::set<uint32_t> used(out.begin(), out.end());
+    for (uint32_t y = 0; y <= 16; ++y)
+    {
+        EXPECT_TRUE(used.count(y * 17 + 8));
+        EXPECT_TRUE(used.count(17 * 17 + y));
+    }
+}
+
+TEST(MeshSimplifier, ErrorBoundIsRespected)
+{
+    auto mesh = make_smooth_sphere(16, 32);
+    auto vertices = vertex_view(mesh);
+
+    std::vector<uint32_t> out;
+    EXPECT_EQ(simplify(mesh.indices, vertices, 0, 0.0f, out), 0.0f);
+    EXPECT_EQ(out, mesh.indices);
+
+    float error = simplify(mesh.indices, vertices, 0, 0.02f, out);
+    EXPECT_LT(out.size(), mesh.indices.size());
+    EXPECT_GT(error, 0.0f);
+    EXPECT_LE(error, 0.02f);
+}
+
+TEST(MeshSimplifier, LodChainShrinksAsErrorGrows)
+{
+    auto mesh = make_smooth_sphere(32, 64);
+    build_lod_chain(mesh, {.max_error = 0.1f});
+
+    ASSERT_GE(mesh.lods.size(), 2u);
+
+    const auto vertex_count = vertex_view(mesh).size();
+    size_t previous = mesh.indices.size();
+    float error = 0.0f;
+    for (const auto& lod : mesh.lods)
+    {
+        EXPECT_EQ(lod.indices.size() % 3, 0u);
+        EXPECT_LT(lod.indices.size(), previous);
+        EXPECT_GE(lod.error, error);
+        EXPECT_LE(lod.error, 0.1f);
+        EXPECT_TRUE(std::all_of(lod.indices.begin(),
+                                lod.indices.end(),
+                                [&](uint32_t i) { return i < vertex_count; }));
+        previous = lod.indices.size();
+        error = lod.error;
+    }
+}
+
+TEST(MeshSimplifier, SmallMeshesGetNoChain)
+{
+    auto mesh = make_smooth_sphere(4, 8);
+    build_lod_chain(mesh);
+
+    EXPECT_TRUE(mesh.lods.empty());
+}
+
+TEST(MeshSimplifier, OptimizedLodsFollowTheVertexRemap)
+{
+    auto mesh = make_smooth_sphere(24, 48);
+    optimize_mesh(mesh, {.lods = true});
+
+    ASSERT_FALSE(mesh.lods.empty());
+
+    // Fetch order drops nothing a level uses, and levels keep covering the surface
+    auto vertices = vertex_view(mesh);
+    const float full = area(mesh.indices, vertices);
+    for (const auto& lod : mesh.lods)
+    {
+        ASSERT_TRUE(std::all_of(lod.indices.begin(),
+                                lod.indices.end(),
+                                [&](uint32_t i) { return i < vertices.size(); }));
+        EXPECT_NEAR(area(lod.indices, vertices), full, full * 0.1f);
+    }
+}
@@ -51,11 +51,19 @@ namespace converter
 // Parsed data types (raw data from parsers, not engine objects)
 // ============================================================================
 
+struct parsed_lod
+{
+    std::vector<uint32_t> indices;  // over the mesh's vertices
+    float error = 0.0f;             // simplification error relative to the bounding radius
+};
+
 struct parsed_mesh
 {
     std::string name;
     std::vector<uint8_t> vertices;  // raw vertex_data bytes
     std::vector<uint32_t> indices;
+    std::vector<uint32_t> shadow_indices;  // optional position-only list for depth passes
+    std::vector<parsed_lod> lods;          // optional coarser levels, finest first
 };
 
 struct parsed_texture
@@ -163,6 +171,11 @@ struct converter_options
     bool deduplicate_textures = true;
     bool deduplicate_materials = true;
 
+    // Mesh optimisation stage (see mesh_optimizer.h)
+    bool optimize_meshes = true;
+    bool shadow_indices = false;
+    bool generate_lods = true;
+
     // Naming
     std::string prefix;  // prefix for generated IDs
 
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <asset_converter/converter_context.h>
+#include <asset_converter/mesh_simplifier.h>
+
+#include <gpu_types/gpu_vertex_types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace kryga::converter
+{
+
+// ============================================================================
+// Mesh optimisation stage
+//
+// Runs on parsed meshes before they become mesh assets. Every pass is
+// deterministic and keeps the triangle set of LOD 0 intact; only vertex and
+// triangle order (and duplicate vertices) change.
+// ============================================================================
+
+struct mesh_optimize_options
+{
+    // Post-transform cache size the triangle order is tuned for
+    uint32_t cache_size = 16;
+
+    // How much the overdraw pass may raise the vertex cache miss ratio while
+    // reordering clusters front-to-back; 1 keeps only free reorders
+    float overdraw_threshold = 1.05f;
+
+    // Also build parsed_mesh::shadow_indices
+    bool shadow_indices = false;
+
+    // Also build parsed_mesh::lods (see mesh_simplifier.h)
+    bool lods = false;
+    lod_chain_options lod;
+};
+
+inline std::span<const gpu::vertex_data>
+vertex_view(const parsed_mesh& mesh)
+{
+    return {reinterpret_cast<const gpu::vertex_data*>(mesh.vertices.data()),
+            mesh.vertices.size() / sizeof(gpu::vertex_data)};
+}
+
+// Merge bit-identical vertices; unindexed meshes become indexed
+void
+deduplicate_vertices(parsed_mesh& mesh);
+
+// Reorder triangles for post-transform vertex cache reuse (Forsyth)
+void
+optimize_vertex_cache(std::span<uint32_t> indices, size_t vertex_count, uint32_t cache_size = 16);
+
+// Split cache-ordered triangles into clusters and draw the outward-facing ones
+// first (Sander et al., "Fast triangle reordering for vertex locality and
+// reduced overdraw"). Expects optimize_vertex_cache output.
+void
+optimize_overdraw(std::span<uint32_t> indices,
+                  std::span<const gpu::vertex_data> vertices,
+                  float threshold,
+                  uint32_t cache_size = 16);
+
+// Renumber vertices in first-use order and drop unreferenced ones
+void
+optimize_vertex_fetch(parsed_mesh& mesh);
+
+// Index list over the same vertex buffer where vertices sharing a position share
+// an index, so depth-only passes reuse them across normal / uv seams
+std::vector<uint32_t>
+build_shadow_indices(std::span<const uint32_t> indices,
+                     std::span<const gpu::vertex_data> vertices,
+                     uint32_t cache_size = 16);
+
+// Average cache miss ratio (transformed vertices per triangle) of a FIFO cache
+float
+analyze_vertex_cache(std::span<const uint32_t> indices, size_t vertex_count, uint32_t cache_size);
+
+// The full stage: dedup, cache, overdraw, the optional LOD chain, fetch, then the
+// optional shadow list
+void
+optimize_mesh(parsed_mesh& mesh, const mesh_optimize_options& opts = {});
+
+}  // namespace kryga::converter
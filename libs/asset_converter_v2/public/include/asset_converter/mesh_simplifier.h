@@ -0,0 +1,56 @@
+#pragma once
+
+#include <asset_converter/converter_context.h>
+
+#include <gpu_types/gpu_vertex_types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace kryga::converter
+{
+
+// ============================================================================
+// LOD chain generation
+//
+// Quadric error edge collapse (Garland & Heckbert) onto existing vertices, so
+// every level indexes the source vertex buffer and keeps its attributes as they
+// are. Vertices on open borders and on attribute seams (one position, several
+// vertices) never move, which keeps uv / normal discontinuities and outlines
+// intact.
+// ============================================================================
+
+struct lod_chain_options
+{
+    // Coarser levels to try for, each aiming at `reduction` of the previous count
+    uint32_t max_levels = 4;
+    float reduction = 0.5f;
+
+    // Stop once a level cannot get below this fraction of the previous one
+    float min_reduction = 0.85f;
+
+    // Largest simplification error accepted, relative to the bounding radius
+    float max_error = 0.05f;
+
+    // Meshes with fewer triangles than this get no chain
+    uint32_t min_triangles = 64;
+};
+
+// Collapse edges of `indices` until it has at most `target_index_count` indices or
+// the next collapse would exceed `target_error` (object units). Returns the
+// error reached, in object units.
+float
+simplify(std::span<const uint32_t> indices,
+         std::span<const gpu::vertex_data> vertices,
+         size_t target_index_count,
+         float target_error,
+         std::vector<uint32_t>& out);
+
+// Fill mesh.lods from mesh.indices. Errors are relative to the bounding radius
+// and never decrease along the chain.
+void
+build_lod_chain(parsed_mesh& mesh, const lod_chain_options& opts = {});
+
+}  // namespace kryga::converter
@@ -1,14 +1,20 @@
 #include "cook/cooker.h"
 
+#include <animation/animation_bundle.h>
+#include <voronoi_fracture/fracture_cache.h>
+#include <voronoi_fracture/voronoi_fracture.h>
+#include <utils/file_utils.h>
 #include <utils/kryga_log.h>
 #include <utils/path.h>
 #include <utils/process.h>
 #include <serialization/serialization.h>
+#include <jobs/job_system.h>
 
 #include <yaml-cpp/yaml.h>
 
 #include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <filesystem>
 #include <format>
 #include <fstream>
@@ -438,6 +444,288 @@ emit_index_manifests(const fs::path& cooked_root, stats& s)
     }
 }
 
+// ---------------------------------------------------------------------------
+// Animation bundles
+
+constexpr std::string_view k_skeleton_suffix = "_skeleton.ozz";
+
+bool
+is_ozz_skeleton(const fs::path& p)
+{
+    return p.filename().string().ends_with(k_skeleton_suffix);
+}
+
+// `<stem>_skeleton.ozz` + `<stem>_*.ozz` clips + `<stem>.glb|.gltf` in one directory
+// -> `<stem>.aanim` at the same relative spot in the cooked tree
+void
+cook_animation_bundle(const fs::path& skeleton, const options& opts, stats& s)
+{
+    auto dir = skeleton.parent_path();
+    auto fname = skeleton.filename().string();
+    auto stem = fname.substr(0, fname.size() - k_skeleton_suffix.size());
+
+    fs::path gltf;
+    for (auto ext : {".glb", ".gltf"})
+    {
+        if (fs::exists(dir / (stem + ext)))
+        {
+            gltf = dir / (stem + ext);
+            break;
+        }
+    }
+    if (gltf.empty())
+    {
+        if (opts.verbose)
+        {
+            ALOG_INFO("cook:   no glTF for {}, no bundle", skeleton.generic_string());
+        }
+        return;
+    }
+
+    std::error_code ec;
+    auto rel = fs::relative(dir, opts.source_root, ec);
+    if (ec)
+    {
+        return;
+    }
+    auto dst = opts.output_root / rel / (stem + animation::animation_bundle::k_extension);
+
+    std::vector<fs::path> inputs = {gltf};
+    for (auto& entry : fs::directory_iterator(dir, ec))
+    {
+        auto name = entry.path().filename().string();
+        if (entry.is_regular_file() && name.starts_with(stem + "_") && name.ends_with(".ozz"))
+        {
+            inputs.push_back(entry.path());
+        }
+    }
+
+    if (!opts.force && !older_than_any(dst, inputs))
+    {
+        s.anim_bundles_up_to_date++;
+        return;
+    }
+
+    animation::animation_bundle_source src;
+    if (!animation::animation_bundle::build(utils::path(gltf), utils::path(dir), src))
+    {
+        ALOG_ERROR("cook: FAIL bundle {}", dst.generic_string());
+        s.errors++;
+        return;
+    }
+
+    ensure_dir(dst.parent_path());
+    if (!utils::file_utils::save_file(utils::path(dst),
+                                      animation::animation_bundle::serialize(src)))
+    {
+        ALOG_ERROR("cook: cannot write {}", dst.generic_string());
+        s.errors++;
+        return;
+    }
+
+    s.anim_bundles_written++;
+    if (opts.verbose)
+    {
+        ALOG_INFO("cook:   OK {} ({} clips)", dst.generic_string(), src.clips.size());
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Destructible pre-fracture
+
+struct mesh_aobj
+{
+    fs::path vertices;
+    fs::path indices;
+};
+
+struct destructible_aobj
+{
+    fs::path aobj;
+    fs::path package_root;
+    std::string source_mesh;
+    uint32_t cell_count = 8;
+    uint32_t fracture_seed = 0;
+};
+
+// `.apkg` / `.alvl` directory holding `p`; aobj file references are relative to it
+fs::path
+package_root_of(const fs::path& p)
+{
+    for (auto dir = p.parent_path(); !dir.empty() && dir != dir.parent_path();
+         dir = dir.parent_path())
+    {
+        auto ext = dir.extension();
+        if (ext == ".apkg" || ext == ".alvl")
+        {
+            return dir;
+        }
+    }
+    return {};
+}
+
+std::string
+proto_id_of(const YAML::Node& doc)
+{
+    auto t = doc["proto_id"];
+    return (t && t.IsScalar()) ? t.as<std::string>() : std::string{};
+}
+
+std::string
+mesh_key(const fs::path& package_root, const std::string& id)
+{
+    return package_root.generic_string() + "|" + id;
+}
+
+template <typename T>
+bool
+load_array(const fs::path& p, std::vector<T>& out)
+{
+    std::vector<uint8_t> blob;
+    if (!utils::file_utils::load_file(utils::path(p), blob) || blob.size() % sizeof(T))
+    {
+        return false;
+    }
+    out.resize(blob.size() / sizeof(T));
+    std::memcpy(out.data(), blob.data(), blob.size());
+    return true;
+}
+
+// Meshes by (package, id), and the destructibles that reference them. Missing
+// fracture fields take destructible_mesh_asset's defaults.
+void
+collect_fracture_inputs(const fs::path& aobj,
+                        const YAML::Node& doc,
+                        std::map<std::string, mesh_aobj>& meshes,
+                        std::vector<destructible_aobj>& destructibles)
+{
+    auto proto = proto_id_of(doc);
+    if (proto != "mesh" && proto != "destructible_mesh_asset")
+    {
+        return;
+    }
+
+    auto root = package_root_of(aobj);
+    auto id = doc["id"];
+    if (root.empty() || !id || !id.IsScalar())
+    {
+        return;
+    }
+
+    try
+    {
+        if (proto == "mesh")
+        {
+            auto v = doc["vertices"];
+            auto i = doc["indices"];
+            if (v && i && v.IsScalar() && i.IsScalar())
+            {
+                meshes[mesh_key(root, id.as<std::string>())] = {
+                    .vertices = root / v.as<std::string>(), .indices = root / i.as<std::string>()};
+            }
+            return;
+        }
+
+        auto src = doc["source_mesh"];
+        if (!src || !src.IsScalar())
+        {
+            return;
+        }
+
+        destructible_aobj d{
+            .aobj = aobj, .package_root = root, .source_mesh = src.as<std::string>()};
+        if (auto n = doc["cell_count"])
+        {
+            d.cell_count = n.as<uint32_t>();
+        }
+        if (auto n = doc["fracture_seed"])
+        {
+            d.fracture_seed = n.as<uint32_t>();
+        }
+        destructibles.push_back(std::move(d));
+    }
+    catch (const YAML::Exception&)
+    {
+        // Malformed fields: no fracture, the runtime builds it
+    }
+}
+
+// destructible_mesh_asset -> `<mesh stem>_<key>.afrac` beside the cooked vertex file,
+// the name the runtime looks up (see voronoi_fracture::cache_key). The key covers the
+// source bytes and parameters, so an existing file is always current.
+void
+cook_fracture(const destructible_aobj& d,
+              const std::map<std::string, mesh_aobj>& meshes,
+              const options& opts,
+              jobs::job_system& pool,
+              stats& s)
+{
+    auto itr = meshes.find(mesh_key(d.package_root, d.source_mesh));
+    if (itr == meshes.end())
+    {
+        if (opts.verbose)
+        {
+            ALOG_INFO("cook:   no mesh '{}' for {}, no fracture",
+                      d.source_mesh,
+                      d.aobj.generic_string());
+        }
+        return;
+    }
+
+    std::vector<gpu::vertex_data> vertices;
+    std::vector<gpu::uint> indices;
+    if (!load_array(itr->second.vertices, vertices) || !load_array(itr->second.indices, indices))
+    {
+        ALOG_ERROR("cook: cannot read mesh '{}' for {}", d.source_mesh, d.aobj.generic_string());
+        s.errors++;
+        return;
+    }
+
+    const auto params =
+        voronoi_fracture::destructible_fracture_params(d.fracture_seed, d.cell_count);
+    const uint64_t key = voronoi_fracture::cache_key(vertices.data(),
+                                                     uint32_t(vertices.size()),
+                                                     indices.data(),
+                                                     uint32_t(indices.size()),
+                                                     params);
+
+    std::error_code ec;
+    auto rel = fs::relative(itr->second.vertices.parent_path(), opts.source_root, ec);
+    if (ec)
+    {
+        return;
+    }
+    auto dst = opts.output_root / rel /
+               voronoi_fracture::cache_file_name(itr->second.vertices.stem().string(), key);
+
+    if (!opts.force && fs::exists(dst))
+    {
+        s.fractures_up_to_date++;
+        return;
+    }
+
+    auto result = voronoi_fracture::fracture_mesh(vertices.data(),
+                                                  uint32_t(vertices.size()),
+                                                  indices.data(),
+                                                  uint32_t(indices.size()),
+                                                  params,
+                                                  &pool);
+
+    ensure_dir(dst.parent_path());
+    if (!utils::file_utils::save_file(utils::path(dst), voronoi_fracture::serialize(result)))
+    {
+        ALOG_ERROR("cook: cannot write {}", dst.generic_string());
+        s.errors++;
+        return;
+    }
+
+    s.fractures_written++;
+    if (opts.verbose)
+    {
+        ALOG_INFO("cook:   OK {} ({} chunks)", dst.generic_string(), result.chunks.size());
+    }
+}
+
 bool
 copy_file(const fs::path& src, const fs::path& dst, bool force)
 {
@@ -543,59 +831,51 @@ cook(const options& opts)
 
         int jobs_n =
             opts.jobs > 0 ? opts.jobs : std::max(1u, std::thread::hardware_concurrency() - 1);
-        std::atomic<size_t> next_idx{0};
         std::atomic<int> compiled{0};
         std::atomic<int> failed{0};
         std::mutex log_mu;
 
-        auto worker = [&]()
-        {
-            while (true)
+        // The cooker runs without a global state: its own pool, this thread included
+        kryga::jobs::job_system pool;
+        pool.start(static_cast<uint32_t>(std::max(1, jobs_n - 1)));
+        pool.parallel_for(
+            static_cast<uint32_t>(work.size()),
+            1,
+            [&](uint32_t begin, uint32_t end)
             {
-                size_t idx = next_idx.fetch_add(1);
-                if (idx >= work.size())
-                {
-                    return;
-                }
-                auto& j = work[idx];
-                std::string err;
-                if (compile_shader(glslc, j, opts, includes, err))
+                for (uint32_t idx = begin; idx < end; ++idx)
                 {
-                    compiled.fetch_add(1);
-                    if (opts.verbose)
+                    auto& j = work[idx];
+                    std::string err;
+                    if (compile_shader(glslc, j, opts, includes, err))
                     {
+                        compiled.fetch_add(1);
+                        if (opts.verbose)
+                        {
+                            std::lock_guard g{log_mu};
+                            ALOG_INFO("cook:   OK {}",
+                                      fs::relative(j.source, opts.source_root).generic_string());
+                        }
+                    }
+                    else
+                    {
+                        failed.fetch_add(1);
                         std::lock_guard g{log_mu};
-                        ALOG_INFO("cook:   OK {}",
-                                  fs::relative(j.source, opts.source_root).generic_string());
+                        ALOG_ERROR("cook: FAIL {}: {}",
+                                   fs::relative(j.source, opts.source_root).generic_string(),
+                                   err);
                     }
                 }
-                else
-                {
-                    failed.fetch_add(1);
-                    std::lock_guard g{log_mu};
-                    ALOG_ERROR("cook: FAIL {}: {}",
-                               fs::relative(j.source, opts.source_root).generic_string(),
-                               err);
-                }
-            }
-        };
-
-        std::vector<std::thread> pool;
-        pool.reserve(jobs_n);
-        for (int i = 0; i < jobs_n; ++i)
-        {
-            pool.emplace_back(worker);
-        }
-        for (auto& t : pool)
-        {
-            t.join();
-        }
+            });
 
         s.shaders_compiled = compiled.load();
         s.errors += failed.load();
     }
 
     // --- 2. walk remainder: .aobj and everything else ------------------
+    std::vector<fs::path> skeletons;
+    std::map<std::string, mesh_aobj> meshes;
+    std::vector<destructible_aobj> destructibles;
     std::error_code ec;
     for (auto it = fs::recursive_directory_iterator(opts.source_root, ec);
          it != fs::recursive_directory_iterator();
@@ -644,6 +924,11 @@ cook(const options& opts)
                 // Corrupt/non-YAML .aobj — fall through to copy.
             }
 
+            if (doc)
+            {
+                collect_fracture_inputs(p, doc, meshes, destructibles);
+            }
+
             if (doc && is_shader_effect_aobj(doc))
             {
                 bool rewritten = false;
@@ -674,6 +959,11 @@ cook(const options& opts)
             continue;
         }
 
+        if (is_ozz_skeleton(p))
+        {
+            skeletons.push_back(p);
+        }
+
         if (copy_file(p, dst, opts.force))
         {
             s.files_copied++;
@@ -684,17 +974,41 @@ cook(const options& opts)
         }
     }
 
+    // --- 2b. one animation bundle per skeleton ------------------------
+    for (auto& skel : skeletons)
+    {
+        cook_animation_bundle(skel, opts, s);
+    }
+
+    // --- 2c. pre-fracture destructible meshes ---------------------------
+    if (!destructibles.empty())
+    {
+        int jobs_n =
+            opts.jobs > 0 ? opts.jobs : std::max(1u, std::thread::hardware_concurrency() - 1);
+        kryga::jobs::job_system pool;
+        pool.start(static_cast<uint32_t>(std::max(1, jobs_n - 1)));
+        for (auto& d : destructibles)
+        {
+            cook_fracture(d, meshes, opts, pool, s);
+        }
+    }
+
     // --- 3. emit kryga_index manifests for every *.apkg / *.alvl ------
     emit_index_manifests(opts.output_root, s);
 
     ALOG_INFO(
         "cook: {} shaders compiled, {} up-to-date, {} .aobj rewritten, {} copied, {} other files "
-        "copied, {} errors",
+        "copied, {} animation bundles written, {} up-to-date, {} fractures written, {} "
+        "up-to-date, {} errors",
         s.shaders_compiled,
         s.shaders_up_to_date,
         s.aobj_rewritten,
         s.aobj_copied,
         s.files_copied,
+        s.anim_bundles_written,
+        s.anim_bundles_up_to_date,
+        s.fractures_written,
+        s.fractures_up_to_date,
         s.errors);
 
     return s;
@@ -54,6 +54,10 @@ struct stats
     int aobj_rewritten = 0;
     int aobj_copied = 0;
     int files_copied = 0;
+    int anim_bundles_written = 0;
+    int anim_bundles_up_to_date = 0;
+    int fractures_written = 0;
+    int fractures_up_to_date = 0;
     int errors = 0;
 };
 
@@ -62,6 +66,12 @@ struct stats
 //     are compiled to `.spv` via glslc.
 //   - shader-effect `.aobj` descriptors (`type_id: shader_effect`) are rewritten so
 //     `vert:` / `frag:` point at the cooked SPV rids and `is_*_binary: true`.
+//   - every `<stem>_skeleton.ozz` with a `<stem>.glb|.gltf` beside it is baked,
+//     together with its `<stem>_*.ozz` clips, into `<stem>.aanim`
+//     (see animation::animation_bundle).
+//   - every destructible_mesh_asset `.aobj` is pre-fractured into
+//     `<mesh stem>_<key>.afrac` beside its source mesh's vertex file
+//     (see voronoi_fracture::cache_key).
 //   - every other file is copied as-is.
 // Incremental: skips work when the output is newer than all relevant inputs.
 //
@@ -25,20 +25,34 @@ diff_object_properties(const root::smart_object& left,
         return result_code::failed;
     }
 
-    auto& properties = left.get_reflection()->m_serialization_properties;
+    auto* rt = left.get_reflection();
+    auto& properties = rt->m_serialization_properties;
+
+    std::vector<uint8_t> differs(properties.size(), 0);
+    rt->compare_pod(left, right, differs);
 
     reflection::property_context__compare compare_ctx{
         .p = nullptr, .src_obj = &left, .dst_obj = &right};
 
-    for (auto& p : properties)
+    // Walk in declaration order so callers (save_obj) see a stable diff order
+    for (uint32_t i = 0; i < properties.size(); ++i)
     {
-        compare_ctx.p = p.get();
+        auto* p = properties[i].get();
 
-        auto same = p->compare_handler(compare_ctx) == result_code::ok;
+        bool same = true;
+        if (p->pod_size)
+        {
+            same = !differs[i];
+        }
+        else
+        {
+            compare_ctx.p = p;
+            same = p->compare_handler(compare_ctx) == result_code::ok;
+        }
 
         if (!same)
         {
-            diff.push_back(p.get());
+            diff.push_back(p);
         }
     }
 
@@ -11,6 +11,7 @@
 #include <core/construction_utils.h>
 #include <core/reflection/reflection_type.h>
 #include <global_state/global_state.h>
+#include <utils/kryga_log.h>
 
 namespace kryga
 {
@@ -18,6 +19,23 @@ namespace kryga
 namespace core
 {
 
+namespace
+{
+
+void
+tick_game_object(root::smart_object& obj, float dt)
+{
+    static_cast<root::game_object&>(obj).on_tick(dt);
+}
+
+void
+tick_component(root::smart_object& obj, float dt)
+{
+    static_cast<root::component&>(obj).on_tick(dt);
+}
+
+}  // namespace
+
 level::level(const utils::id& id)
     : container(id)
 {
@@ -272,13 +290,13 @@ level::destroy_game_object(root::game_object& go)
     m_occ->remove_obj(go);
     to_drop.insert(&go);
 
-    // Destroying a SURVIVOR during play (snapshot active): hold its shared_ptrs in
+    // Destroying a SURVIVOR during play (session active): hold its shared_ptrs in
     // m_pending_destroy — destruction is deferred to the session outcome so rollback
     // can revive the intact graph with all ids/structure preserved. Otherwise (edit
     // mode, or a play-spawned object) free via deferred_release, which keeps the
     // shared_ptrs alive for the queued destroy_render raw pointers until the next
     // render drain clears it.
-    bool pending_destroy = m_snapshot_all_ids.contains(go.get_id());
+    bool pending_destroy = in_play_session() && !go.m_play_spawned;
     auto& deferred = glob::glob_state().getr_model().dirty().deferred_release;
     for (size_t i = m_objects.size(); i-- > 0;)
     {
@@ -293,32 +311,55 @@ level::destroy_game_object(root::game_object& go)
 void
 level::snapshot()
 {
-    // Capture pre-play property values for every per-play (non-readonly) object —
-    // game_objects AND their components, since both are entries in m_objects. The
-    // holder is a bare instance of the same type, allocated directly (never added
-    // to a cache/occ) so it can't collide with the live object's id.
-    m_snapshot.clear();
-    m_snapshot_all_ids.clear();
+    // Opens the session only: pre-play values are captured lazily, per object, on
+    // first write (capture_pre_image). A fresh epoch invalidates every object's
+    // "already captured" mark from earlier sessions in one step.
+    static uint32_t s_next_epoch = 0;
+    if (++s_next_epoch == 0)
+    {
+        ++s_next_epoch;
+    }
+    m_play_epoch = s_next_epoch;
+
+    m_pre_images.clear();
     m_pending_destroy.clear();
+}
 
-    for (auto& obj : m_objects)
+void
+level::capture_pre_image(root::smart_object& obj)
+{
+    if (m_play_epoch == 0 || obj.m_play_epoch == m_play_epoch)
     {
-        m_snapshot_all_ids.insert(obj->get_id());
+        return;  // no session, already captured, or spawned this session
+    }
+    obj.m_play_epoch = m_play_epoch;
 
-        // Class-default/shared objects are not per-play state, and restoring into
-        // a readonly object would assert. Skip them (but they ARE in all_ids, so
-        // rollback won't mistake them for spawned-during-play).
-        if (obj->get_flags().readonly)
-        {
-            continue;
-        }
+    // Class-default/shared objects are not per-play state, and restoring into a
+    // readonly object would assert
+    if (obj.get_flags().readonly)
+    {
+        return;
+    }
+
+    // The holder is a bare instance of the same type, allocated directly (never
+    // added to a cache/occ) so it can't collide with the live object's id
+    auto id = obj.get_id();
+    reflection::type_context__alloc alloc_ctx{&id};
+    auto holder = obj.get_reflection()->alloc(alloc_ctx);
+
+    snapshot_object_properties(obj, *holder);
 
-        auto id = obj->get_id();
-        reflection::type_context__alloc alloc_ctx{&id};
-        auto holder = obj->get_reflection()->alloc(alloc_ctx);
+    std::lock_guard lock(m_pre_images_mutex);
+    m_pre_images.push_back({.live = &obj, .holder = std::move(holder)});
+}
 
-        snapshot_object_properties(*obj, *holder);
-        m_snapshot[id] = std::move(holder);
+void
+level::track_created(root::smart_object& obj)
+{
+    if (m_play_epoch != 0)
+    {
+        obj.m_play_epoch = m_play_epoch;  // nothing to restore: rollback frees it
+        obj.m_play_spawned = true;
     }
 }
 
@@ -333,8 +374,8 @@ level::rollback()
     // tick set, and queue a render rebuild (their GPU was freed on destroy and the
     // state is 'constructed', so mark_render_dirty would no-op — queue explicitly).
     // From here they are ordinary survivors: phase 1 cleans any pre-destroy graft,
-    // phase 2 resets their values. m_snapshot holders still reference these same
-    // (never-freed) component objects, so the restore stays pointer-valid.
+    // phase 2 resets their values if play wrote to them. Pre-images point at these
+    // same (never-freed) objects, so the restore stays pointer-valid.
     std::vector<root::game_object*> revived;
     for (auto& obj : m_pending_destroy)
     {
@@ -351,15 +392,14 @@ level::rollback()
         q.dirty_render.emplace_back(go->get_root_component());
     }
 
-    // Spawned-during-play = present in m_objects now but absent at snapshot. Keyed
-    // by id, not index: a survivor destroyed mid-play reorders m_objects (destroy
-    // uses swap_and_remove), so the old count-based [snapshot_count, end) range is
-    // invalid. Readonly objects present at snapshot are in m_snapshot_all_ids and
-    // so are NOT treated as spawned (must not be freed — survivors reference them).
+    // Spawned-during-play = tagged by track_created. Tagged per object, not by
+    // index: a survivor destroyed mid-play reorders m_objects (destroy uses
+    // swap_and_remove). Readonly objects present at snapshot were created before
+    // the session and so are NOT treated as spawned (survivors reference them).
     std::unordered_set<root::smart_object*> rolledback;
     for (auto& obj : m_objects)
     {
-        if (!m_snapshot_all_ids.contains(obj->get_id()))
+        if (obj->m_play_spawned)
         {
             rolledback.insert(obj.get());
         }
@@ -448,18 +488,27 @@ level::rollback()
         }
     }
 
-    // Phase 2 — restore surviving objects to their pre-play property values.
-    // Phase 1 has removed spawned objects and structurally un-grafted any runtime
-    // subtrees, so each survivor now matches its snapshot's structure; copy the
-    // captured values back in place (object identity preserved — no realloc).
-    for (auto& obj : m_objects)
+    // Phase 2 — restore the survivors play wrote to. Phase 1 has removed spawned
+    // objects and structurally un-grafted any runtime subtrees, so each survivor
+    // now matches its pre-image's structure; copy the captured values back in
+    // place (object identity preserved — no realloc). Untouched survivors already
+    // hold their pre-play values.
+    std::unordered_set<root::game_object*> resync;
+    for (auto& pi : m_pre_images)
     {
-        auto it = m_snapshot.find(obj->get_id());
-        if (it == m_snapshot.end())
+        snapshot_object_properties(*pi.holder, *pi.live);  // holder -> live
+
+        if (auto* go = pi.live->as<root::game_object>())
+        {
+            resync.insert(go);
+        }
+        else if (auto* comp = pi.live->as<root::component>())
         {
-            continue;  // readonly/CDO: never snapshotted, nothing to restore
+            if (auto* owner = comp->get_owner())
+            {
+                resync.insert(owner);
+            }
         }
-        snapshot_object_properties(*it->second, *obj);  // holder -> live
     }
 
     // Re-sync the GPU for restored survivors. update_position recomputes each
@@ -472,41 +521,41 @@ level::rollback()
     // teardown — so the toggle-latency win (no destroy/rebuild of survivors) is
     // kept. mark_render_dirty queues because a survivor is render_ready (not
     // constructed); the dirty_render drain then rebuilds it.
-    for (auto& obj : m_objects)
+    for (auto* go : resync)
     {
-        if (!m_snapshot.contains(obj->get_id()))
+        go->update_position();
+        for (auto* goc : go->get_renderable_components())
         {
-            continue;
-        }
-        if (auto* go = obj->as<root::game_object>())
-        {
-            go->update_position();
-            for (auto* goc : go->get_renderable_components())
-            {
-                goc->mark_render_dirty();
-            }
+            goc->mark_render_dirty();
         }
     }
 
+    ALOG_INFO("Level rollback: restored {} objects, removed {} spawned",
+              m_pre_images.size(),
+              rolledback.size());
+
     // Survivors destroyed during play were already revived at the top of rollback
     // (re-registered intact and reset by phases 1-2), so there is no separate
     // recreate step.
 
-    m_snapshot.clear();
-    m_snapshot_all_ids.clear();
+    m_pre_images.clear();
+    m_play_epoch = 0;
 }
 
 void
 level::tick(float dt)
 {
+    // Rebatched every frame: spawn/destroy only touch m_tickable_objects
+    m_tick_scheduler.clear();
     for (auto o : m_tickable_objects)
     {
-        o->on_tick(dt);
+        m_tick_scheduler.add(*o->get_reflection(), *o, &tick_game_object);
         for (auto c : o->get_renderable_components())
         {
-            c->on_tick(dt);
+            m_tick_scheduler.add(*c->get_reflection(), *c, &tick_component);
         }
     }
+    m_tick_scheduler.run(dt);
 }
 
 void
@@ -522,8 +571,13 @@ level::unload()
     container::unload(/*is_package=*/false);
 
     m_tickable_objects.clear();
+    m_tick_scheduler.clear();
     m_package_ids.clear();
 
+    // Objects still referenced elsewhere (deferred render release) keep their
+    // pool; the rest of the pages go now
+    m_arena.release();
+
     m_state = level_state::unloaded;
 }
 
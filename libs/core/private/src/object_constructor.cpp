@@ -268,6 +268,10 @@ object_constructor::create_default_class_obj_impl(reflection::reflection_type* r
     empty->get_flags() = ks_class_default;
 
     empty->set_package(m_olc->get_package());
+    if (auto* lvl = m_olc->get_level())
+    {
+        lvl->track_created(*empty);  // loaded mid-play: released with the session
+    }
     m_olc->add_obj(empty);
 
     {
@@ -413,12 +417,18 @@ object_constructor::alloc_empty_object(const utils::id& type_id,
         return std::unexpected(result_code::id_not_found);
     }
 
-    reflection::type_context__alloc alloc_ctx{&id};
+    auto* lvl = m_olc->get_level();
+    reflection::type_context__alloc alloc_ctx{.id = &id,
+                                              .arena = lvl ? &lvl->get_arena() : nullptr};
     auto empty = rt->alloc(alloc_ctx);
     empty->set_package(m_olc->get_package());
-    empty->set_level(m_olc->get_level());
+    empty->set_level(lvl);
     empty->META_set_class_obj(parent_object);
     empty->get_flags() = flags;
+    if (lvl)
+    {
+        lvl->track_created(*empty);
+    }
 
     auto ptr = empty.get();
     m_olc->add_obj(std::move(empty));
@@ -430,7 +440,11 @@ object_constructor::alloc_empty_object(const utils::id& type_id,
 result_code
 object_constructor::clone_object_properties(root::smart_object& from, root::smart_object& to)
 {
-    auto& properties = from.get_reflection()->m_serialization_properties;
+    // POD fields as a few block copies; only the rest goes through handlers
+    auto* rt = from.get_reflection();
+    rt->copy_pod(from, to);
+
+    auto& properties = rt->m_serialization_handled_properties;
 
     reflection::property_context__instantiate ictx{.src_property = nullptr,
                                                    .dst_property = nullptr,
@@ -514,7 +528,11 @@ object_constructor::clone_object_properties(root::smart_object& from, root::smar
 result_code
 object_constructor::instantiate_object_properties(root::smart_object& from, root::smart_object& to)
 {
-    auto& properties = from.get_reflection()->m_serialization_properties;
+    // POD fields as a few block copies; only the rest goes through handlers
+    auto* rt = from.get_reflection();
+    rt->copy_pod(from, to);
+
+    auto& properties = rt->m_serialization_handled_properties;
 
     reflection::property_context__instantiate ictx{.src_property = nullptr,
                                                    .dst_property = nullptr,
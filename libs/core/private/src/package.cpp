@@ -288,6 +288,7 @@ package::finalize_reflection()
             }
             rt->m_editor_properties[p->category].push_back(p);
         }
+        rt->build_pod_ranges();
     }
 }
 
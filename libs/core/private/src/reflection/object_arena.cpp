@@ -0,0 +1,38 @@
+#include "core/reflection/object_arena.h"
+
+#include "core/reflection/reflection_type.h"
+
+namespace kryga
+{
+namespace reflection
+{
+
+std::shared_ptr<utils::slab_pool>
+object_arena::pool_for(const reflection_type& rt)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto& pool = m_pools[rt.type_id];
+    if (!pool)
+    {
+        pool = std::make_shared<utils::slab_pool>();
+    }
+    return pool;
+}
+
+void
+object_arena::release()
+{
+    std::lock_guard lock(m_mutex);
+    m_pools.clear();
+}
+
+size_t
+object_arena::pool_count() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_pools.size();
+}
+
+}  // namespace reflection
+}  // namespace kryga
@@ -3,7 +3,14 @@
 #include "core/model_system.h"
 #include "core/reflection/reflection_type_utils.h"
 #include "global_state/global_state.h"
+
+#include <packages/root/model/smart_object.h>
+
+#include <utils/check.h>
 #include <utils/kryga_log.h>
+
+#include <algorithm>
+#include <cstring>
 #include <stack>
 
 namespace kryga::reflection
@@ -153,4 +160,96 @@ reflection_type::find_function(const std::string& name) const
     return nullptr;
 }
 
+void
+reflection_type::build_pod_ranges()
+{
+    m_serialization_pod_ranges.clear();
+    m_serialization_pod_index.clear();
+    m_serialization_handled_properties.clear();
+
+    for (uint32_t i = 0; i < m_serialization_properties.size(); ++i)
+    {
+        auto& p = m_serialization_properties[i];
+        if (p->pod_size)
+        {
+            m_serialization_pod_index.push_back(i);
+        }
+        else
+        {
+            m_serialization_handled_properties.push_back(p);
+        }
+    }
+
+    std::sort(m_serialization_pod_index.begin(),
+              m_serialization_pod_index.end(),
+              [this](uint32_t l, uint32_t r)
+              {
+                  return m_serialization_properties[l]->offset <
+                         m_serialization_properties[r]->offset;
+              });
+
+    // Merge only exact neighbours: a gap is padding or a non-POD field, and
+    // neither may be copied or compared as part of a range
+    for (uint32_t i = 0; i < m_serialization_pod_index.size(); ++i)
+    {
+        auto& p = *m_serialization_properties[m_serialization_pod_index[i]];
+        const auto offset = static_cast<uint32_t>(p.offset);
+
+        if (!m_serialization_pod_ranges.empty())
+        {
+            auto& last = m_serialization_pod_ranges.back();
+            if (last.offset + last.size == offset)
+            {
+                last.size += p.pod_size;
+                ++last.count;
+                continue;
+            }
+        }
+        m_serialization_pod_ranges.push_back(
+            {.offset = offset, .size = p.pod_size, .first = i, .count = 1});
+    }
+}
+
+void
+reflection_type::copy_pod(const root::smart_object& from, root::smart_object& to) const
+{
+#ifdef KRG_ENFORCE_READONLY
+    KRG_check(m_serialization_pod_ranges.empty() || !to.get_flags().readonly,
+              "writing to readonly object");
+#endif
+
+    const auto src = from.as_blob();
+    const auto dst = to.as_blob();
+    for (const auto& r : m_serialization_pod_ranges)
+    {
+        std::memcpy(dst + r.offset, src + r.offset, r.size);
+    }
+}
+
+void
+reflection_type::compare_pod(const root::smart_object& left,
+                             const root::smart_object& right,
+                             std::vector<uint8_t>& differs) const
+{
+    const auto l = left.as_blob();
+    const auto r = right.as_blob();
+
+    property_context__compare ctx{.p = nullptr, .src_obj = &left, .dst_obj = &right};
+    for (const auto& range : m_serialization_pod_ranges)
+    {
+        if (std::memcmp(l + range.offset, r + range.offset, range.size) == 0)
+        {
+            continue;
+        }
+
+        // Narrow down with the real compare (e.g. -0.f == 0.f)
+        for (uint32_t i = range.first; i < range.first + range.count; ++i)
+        {
+            const auto idx = m_serialization_pod_index[i];
+            ctx.p = m_serialization_properties[idx].get();
+            differs[idx] = ctx.p->compare_handler(ctx) != result_code::ok;
+        }
+    }
+}
+
 }  // namespace kryga::reflection
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "core/tick_scheduler.h"
+
+#include "core/reflection/reflection_type.h"
+
+#include <packages/root/model/smart_object.h>
+
+#include <global_state/global_state.h>
+#include <jobs/job_system.h>
+#include <utils/kryga_log.h>
+
+namespace kryga
+{
+namespace core
+{
+
+namespace
+{
+
+// Batch the current thread is ticking, for validation
+thread_local const void* t_batch = nullptr;
+
+}  // namespace
+
+tick_scheduler::tick_scheduler() = default;
+
+tick_scheduler::~tick_scheduler() = default;
+
+void
+tick_scheduler::clear()
+{
+    for (auto& b : m_batches)
+    {
+        b->objects.clear();
+    }
+}
+
+void
+tick_scheduler::add(const reflection::reflection_type& rt, root::smart_object& obj, tick_fn fn)
+{
+    auto& slot = m_batch_by_type[&rt];
+    if (!slot)
+    {
+        auto b = std::make_unique<batch>();
+        b->rt = &rt;
+        b->fn = fn;
+        slot = b.get();
+        m_batches.push_back(std::move(b));
+    }
+    slot->objects.push_back(&obj);
+}
+
+void
+tick_scheduler::run_batch(batch& b, float dt)
+{
+    t_batch = &b;
+    for (auto* o : b.objects)
+    {
+        b.fn(*o, dt);
+    }
+    t_batch = nullptr;
+}
+
+void
+tick_scheduler::run_wave(const std::vector<batch*>& wave, float dt)
+{
+    if (wave.size() == 1)
+    {
+        run_batch(*wave.front(), dt);
+        return;
+    }
+
+    if (m_validate)
+    {
+        m_writers.clear();
+        m_recording.store(true);
+    }
+
+    auto* js = m_jobs ? m_jobs : glob::glob_state().get_job_system();
+    if (!js || js->worker_count() == 0)
+    {
+        for (auto* b : wave)
+        {
+            run_batch(*b, dt);
+        }
+    }
+    else
+    {
+        // One batch per chunk, high priority: the frame waits on it
+        js->parallel_for(
+            static_cast<uint32_t>(wave.size()),
+            1,
+            [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    run_batch(*wave[i], dt);
+                }
+            },
+            jobs::job_priority::high);
+    }
+
+    m_recording.store(false);
+    ++m_stats.parallel_waves;
+}
+
+void
+tick_scheduler::run(float dt)
+{
+    m_stats.batches = 0;
+    m_stats.waves = 0;
+    m_stats.parallel_waves = 0;
+
+    for (int p = 0; p < tick_phase_count; ++p)
+    {
+        const auto phase = static_cast<tick_phase>(p);
+
+        m_exclusive.clear();
+        for (auto& w : m_waves)
+        {
+            w.clear();
+        }
+        m_wave_access.clear();
+
+        // Greedy packing, in first-seen order so the schedule is stable frame to frame
+        size_t wave_count = 0;
+        for (auto& b : m_batches)
+        {
+            if (b->objects.empty())
+            {
+                continue;
+            }
+            const auto& desc = b->rt->tick;
+            if (desc.phase != phase)
+            {
+                continue;
+            }
+            ++m_stats.batches;
+
+            if (!desc.declared)
+            {
+                m_exclusive.push_back(b.get());
+                continue;
+            }
+
+            size_t w = 0;
+            while (w < wave_count && desc.conflicts(m_wave_access[w]))
+            {
+                ++w;
+            }
+            if (w == wave_count)
+            {
+                if (m_waves.size() == wave_count)
+                {
+                    m_waves.emplace_back();
+                }
+                m_wave_access.push_back({.declared = true});
+                ++wave_count;
+            }
+            m_waves[w].push_back(b.get());
+            m_wave_access[w].reads |= desc.reads;
+            m_wave_access[w].writes |= desc.writes;
+        }
+
+        for (size_t w = 0; w < wave_count; ++w)
+        {
+            run_wave(m_waves[w], dt);
+        }
+        for (auto* b : m_exclusive)
+        {
+            run_batch(*b, dt);
+        }
+        m_stats.waves += static_cast<uint32_t>(wave_count + m_exclusive.size());
+    }
+}
+
+void
+tick_scheduler::record_write(const root::smart_object& obj)
+{
+    const auto* writer = static_cast<const batch*>(t_batch);
+    if (!writer)
+    {
+        return;
+    }
+
+    std::lock_guard lock(m_writes_mutex);
+    auto [it, inserted] = m_writers.emplace(&obj, writer);
+    if (!inserted && it->second != writer)
+    {
+        ++m_stats.conflicts;
+        ALOG_ERROR("tick conflict: '{}' written by both {} and {} in phase {}",
+                   obj.get_id().str(),
+                   it->second->rt->type_name.str(),
+                   writer->rt->type_name.str(),
+                   writer->rt->tick.phase);
+    }
+}
+
+}  // namespace core
+}  // namespace kryga
@@ -0,0 +1,60 @@
+#include <core/subsystem_queues.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace kryga;
+
+namespace
+{
+
+struct cmd
+{
+    explicit cmd(uint64_t f)
+        : frame(f)
+    {
+    }
+
+    uint64_t frame = 0;
+};
+
+std::vector<uint64_t>
+drain(command_queue<cmd>& q, uint32_t slot)
+{
+    std::vector<uint64_t> frames;
+    q.queue(slot).drain([&](cmd*&& c) { frames.push_back(c->frame); });
+    return frames;
+}
+
+}  // namespace
+
+// The deepest pipeline: every slot but one holds an undrawn frame while the next
+// is built, and none of them bleed into each other
+TEST(command_queue, slot_ring_holds_max_depth_frames)
+{
+    command_queue<cmd> q(64, 4096);
+
+    for (uint64_t frame = 0; frame < 16; ++frame)
+    {
+        const uint32_t slot = utils::frame_slot_of(frame);
+        q.set_build_frame_slot(slot);
+        q.enqueue(q.alloc_cmd<cmd>(frame));
+        q.enqueue(q.alloc_cmd<cmd>(frame));
+
+        // Render thread trails by k_max_pipeline_depth frames
+        if (frame >= utils::k_max_pipeline_depth)
+        {
+            const uint64_t drawn = frame - utils::k_max_pipeline_depth;
+            const uint32_t drawn_slot = utils::frame_slot_of(drawn);
+            ASSERT_NE(drawn_slot, slot);
+            EXPECT_EQ(drain(q, drawn_slot), (std::vector<uint64_t>{drawn, drawn}));
+            q.reset_frame_slot(drawn_slot);
+        }
+    }
+
+    for (uint64_t drawn = 16 - utils::k_max_pipeline_depth; drawn < 16; ++drawn)
+    {
+        EXPECT_EQ(drain(q, utils::frame_slot_of(drawn)), (std::vector<uint64_t>{drawn, drawn}));
+    }
+}
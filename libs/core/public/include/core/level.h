@@ -6,6 +6,8 @@
 #include "core/model_minimal.h"
 #include "core/container.h"
 #include "core/lightmap_manifest.h"
+#include "core/reflection/object_arena.h"
+#include "core/tick_scheduler.h"
 
 namespace kryga::vfs
 {
@@ -20,6 +22,7 @@ class backend;
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <optional>
@@ -95,6 +98,21 @@ public:
     void
     rollback();
 
+    // Copy-on-write hooks for the play session opened by snapshot(); no-ops
+    // outside one. capture_pre_image runs from smart_object::before_write,
+    // track_created from object_constructor for every object made in this level.
+    void
+    capture_pre_image(root::smart_object& obj);
+
+    void
+    track_created(root::smart_object& obj);
+
+    bool
+    in_play_session() const
+    {
+        return m_play_epoch != 0;
+    }
+
     void
     tick(float dt);
 
@@ -147,6 +165,19 @@ public:
     void
     unload();
 
+    // Per-type pools backing every object constructed in this level
+    reflection::object_arena&
+    get_arena()
+    {
+        return m_arena;
+    }
+
+    tick_scheduler&
+    get_tick_scheduler()
+    {
+        return m_tick_scheduler;
+    }
+
     level_state
     get_state() const
     {
@@ -171,15 +202,25 @@ private:
     vfs::backend* m_backend = nullptr;
 
     line_cache<root::game_object*> m_tickable_objects;
-
-    // Pre-play property snapshot, keyed by object id (NOT pointer: a survivor can
-    // be destroyed mid-play and its address reused by a later spawn — id is stable
-    // and ABA-safe). m_snapshot holds a bare, unregistered holder per non-readonly
-    // object with its pre-play property values; m_snapshot_all_ids is every object
-    // present at snapshot (incl. readonly) so rollback can tell spawned-during-play
-    // (free) from present-at-snapshot (keep). See docs/plans/play-mode-state-snapshot.md.
-    std::unordered_map<utils::id, std::shared_ptr<root::smart_object>> m_snapshot;
-    std::unordered_set<utils::id> m_snapshot_all_ids;
+    tick_scheduler m_tick_scheduler;
+
+    reflection::object_arena m_arena;
+
+    // Play-mode snapshot, copy-on-write. snapshot() only opens a session
+    // (m_play_epoch); an object's pre-play property values are captured on its
+    // first write of the session, and objects created during it are tagged as
+    // spawned. rollback() frees the spawned set, revives m_pending_destroy and
+    // restores only m_pre_images, so both ends scale with what play touched rather
+    // than with level size. Pointers are safe here: a survivor is never freed
+    // mid-session (a destroyed one is parked in m_pending_destroy).
+    struct pre_image
+    {
+        root::smart_object* live = nullptr;
+        std::shared_ptr<root::smart_object> holder;  // bare, unregistered instance
+    };
+    std::vector<pre_image> m_pre_images;
+    std::mutex m_pre_images_mutex;  // first writes may come from parallel tick batches
+    uint32_t m_play_epoch = 0;  // 0 = no play session
 
     // Editor play-mode only. A survivor destroyed during play is held here with
     // its destruction PENDING the session outcome — the whole object graph is kept
@@ -193,7 +234,7 @@ private:
     utils::id m_selected_directional_light_id;
 
     // The active camera in this level, by id (not pointer: address reuse makes raw
-    // pointers unsafe — see the snapshot note above). Runtime state written through
+    // pointers unsafe across spawn/destroy). Runtime state written through
     // camera_component::set_active_camera; resolved O(1) via find_component. Empty
     // until first set/registration. Replaces a per-frame whole-scene scan.
     utils::id m_active_camera_id;
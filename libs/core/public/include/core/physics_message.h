@@ -11,6 +11,7 @@ namespace physics
 {
 struct chunk_shape;
 struct static_world_mesh;
+struct static_height_field;
 }
 
 namespace core
@@ -69,12 +70,14 @@ struct physics_message
     float impact_damage = 0.0f;
 
     // register_static_collider only: borrowed pointer into the owning component's
-    // persistent collider mesh (e.g. terrain_component::collider_mesh). Same
+    // persistent collider shape, either a triangle mesh or a height field (e.g.
+    // terrain_component::collider_height_field); exactly one is set. Same
     // borrow-window contract as `chunks` above — the component owns it for its
-    // lifetime and the processor copies it through create_static_mesh on register,
-    // so the model thread must not overwrite it before that drain (terrain
-    // registers exactly once per handle, so it doesn't).
+    // lifetime and the processor copies it through create_static_mesh /
+    // create_static_height_field on register, so the model thread must not overwrite
+    // it before that drain (terrain registers exactly once per handle, so it doesn't).
     const physics::static_world_mesh* collider_mesh = nullptr;
+    const physics::static_height_field* collider_height_field = nullptr;
 };
 
 }  // namespace core
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <utils/slab_pool.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace kryga
+{
+namespace reflection
+{
+
+struct reflection_type;
+
+// Object pools owned by one container (a level), one per concrete type, so that
+// container's instances of a type are packed together instead of sharing the
+// type-wide pool with every other level. release() drops the pools; each pool's
+// pages go in one step once its last object is freed.
+class object_arena
+{
+public:
+    std::shared_ptr<utils::slab_pool>
+    pool_for(const reflection_type& rt);
+
+    void
+    release();
+
+    size_t
+    pool_count() const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<int, std::shared_ptr<utils::slab_pool>> m_pools;
+};
+
+}  // namespace reflection
+}  // namespace kryga
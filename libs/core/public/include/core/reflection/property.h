@@ -171,6 +171,10 @@ public:
     bool render_subobject                                           = false;
     instantiate_mode inst_mode                                      = instantiate_mode::instantiate;
 
+    // Non-zero: trivially copyable with default handlers, so the bulk paths may
+    // copy/compare it as raw bytes (see reflection_type::m_serialization_pod_ranges)
+    uint32_t pod_size                                               = 0;
+
     reflection_type* rtype = nullptr;
 
     std::string gpu_data;
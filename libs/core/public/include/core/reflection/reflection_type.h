@@ -3,10 +3,12 @@
 #include "core/reflection/property.h"
 #include "core/reflection/function.h"
 #include "core/architype.h"
+#include "core/tick_desc.h"
 
 #include <serialization/serialization_fwds.h>
 
 #include <utils/id.h>
+#include <utils/slab_pool.h>
 
 #include <vector>
 
@@ -80,9 +82,12 @@ struct type_context__physics_cmd_build
     bool flag = false;
 };
 
+class object_arena;
+
 struct type_context__alloc
 {
     const utils::id* id = nullptr;
+    object_arena* arena = nullptr;  // null: the type's own pool
 };
 
 // JSON-native variants used by the editor RPC. Engine YAML save/load is the
@@ -132,6 +137,16 @@ using type_handler__json_load = result_code (*)(type_context__json_load&);
 using property_list = std::vector<std::shared_ptr<property>>;
 using function_list = std::vector<std::shared_ptr<function>>;
 
+// Adjacent POD properties (property::pod_size) copied/compared as one block.
+// [first, first + count) indexes reflection_type::m_serialization_pod_index.
+struct pod_range
+{
+    uint32_t offset = 0;
+    uint32_t size = 0;
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
 struct reflection_type
 {
     enum class reflection_type_class
@@ -154,12 +169,29 @@ struct reflection_type
     function*
     find_function(const std::string& name) const;
 
+    // Splits m_serialization_properties into POD ranges and handled properties.
+    // Call once the list is final.
+    void
+    build_pod_ranges();
+
+    // Copies every POD range from -> to
+    void
+    copy_pod(const root::smart_object& from, root::smart_object& to) const;
+
+    // Sets differs[i] for each POD m_serialization_properties[i] that differs.
+    // Ranges are memcmp'd; per-property compare runs only inside mismatches.
+    void
+    compare_pod(const root::smart_object& left,
+                const root::smart_object& right,
+                std::vector<uint8_t>& differs) const;
+
     int type_id = -1;
     kryga::utils::id module_id;
     kryga::utils::id type_name;
     uint32_t size = 0;
 
     core::architype arch = core::architype::unknown;
+    core::tick_desc tick;
     reflection_type_class type_class = reflection_type_class::kryga_unknown;
 
     reflection_type* parent = nullptr;
@@ -169,6 +201,12 @@ struct reflection_type
     function_list m_functions;
     property_list m_serialization_properties;
 
+    // Fast path for clone/instantiate/diff: POD serialization properties as
+    // coalesced byte ranges, everything else through its handlers
+    std::vector<pod_range> m_serialization_pod_ranges;
+    std::vector<uint32_t> m_serialization_pod_index;  // into m_serialization_properties
+    property_list m_serialization_handled_properties;
+
     // clang-format off
     type_handler__alloc                         alloc = nullptr;
     type_handler__cparams_alloc                 cparams_alloc = nullptr;
@@ -203,6 +241,10 @@ struct reflection_type
 
     // clang-format on
 
+    // Storage for instances allocated without an arena (packages, editor
+    // holders); keeps a type's objects packed in shared pages
+    std::shared_ptr<utils::slab_pool> pool = std::make_shared<utils::slab_pool>();
+
     std::string mcp_schema;
     std::string mcp_hint;
     std::string source_file;
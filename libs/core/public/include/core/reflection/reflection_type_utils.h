@@ -1,11 +1,15 @@
 #pragma once
 
 #include <core/reflection/reflection_type.h>
+#include <core/reflection/object_arena.h>
 
 #include <serialization/serialization.h>
 
 #include <kryga_port/format.h>
 
+#include <concepts>
+#include <type_traits>
+
 namespace kryga
 {
 namespace reflection
@@ -80,6 +84,38 @@ cpp_default__compare(type_context__compare& ctx)
                                                                    : result_code::failed;
 }
 
+// property::pod_size for a T property of type `rt`: sizeof(T) when T is
+// trivially copyable and `rt` copies/compares it with the cpp_default handlers
+// above, so a memcpy/memcmp is equivalent. 0 otherwise.
+template <typename T>
+uint32_t
+pod_size(const reflection_type* rt)
+{
+    if constexpr (!std::is_trivially_copyable_v<T> || std::is_pointer_v<T> ||
+                  std::is_array_v<T> || !std::equality_comparable<T>)
+    {
+        return 0;
+    }
+    else
+    {
+        const type_handler__copy copy = cpp_default__copy<T>;
+        const type_handler__compare compare = cpp_default__compare<T>;
+
+        const bool defaults = rt && rt->copy == copy && rt->compare == compare && !rt->instantiate;
+        return defaults ? static_cast<uint32_t>(sizeof(T)) : 0;
+    }
+}
+
+// Storage for a new T instance of type `rt`: from `arena` when given, else from
+// the type's own pool. Backs the generated AR_TYPE_create_empty_obj.
+template <typename T>
+std::shared_ptr<T>
+alloc_pooled(const reflection_type& rt, object_arena* arena)
+{
+    auto pool = arena ? arena->pool_for(rt) : rt.pool;
+    return std::allocate_shared<T>(::kryga::utils::pool_allocator<T>(std::move(pool)));
+}
+
 }  // namespace utils
 }  // namespace reflection
 }  // namespace kryga
@@ -4,11 +4,13 @@
 #include <core/physics_message.h>
 #include <core/physics_result.h>
 
+#include <utils/frame_pipeline.h>
 #include <utils/memory_arena.h>
 #include <utils/spsc_queue.h>
 
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace kryga
 {
@@ -18,7 +20,7 @@ namespace render_cmd
 struct render_command_base;
 }
 
-// Generic, double-buffered command channel (NOT render-specific — hence no vulkan
+// Generic, frame-slot-ringed command channel (NOT render-specific — hence no vulkan
 // dependency). TCmd is the command base type whose pointers flow through the queue.
 // Capacities are ctor params (default to the render channel's sizing).
 //
@@ -26,26 +28,29 @@ struct render_command_base;
 // constexpr k_kind` — the central-dispatch discriminator). Single-type channels whose
 // element has no k_kind simply get allocated, no stamp.
 //
-// Per-frame-parity queues + arenas. The main thread produces frame F into slot (F&1);
-// the render thread consumes the same slot. The engine's depth-1 pipeline gate keeps
-// main at most one frame ahead, so producer and consumer never touch the same slot at
-// once — each queue carries exactly one frame's commands, and the render thread drains
-// its slot to empty (no in-band frame-boundary marker) then draws. Arena reuse is a
-// free bump-pointer rewind (reset_frame_slot).
+// Per-frame-slot queues + arenas. The main thread produces frame F into slot
+// frame_slot_of(F); the render thread consumes the same slot. The pipeline gate keeps
+// main at most k_max_pipeline_depth frames ahead, fewer than the k_frame_slot_count
+// slots, so producer and consumer never touch the same slot at once — each queue
+// carries exactly one frame's commands, and the render thread drains its slot to
+// empty (no in-band frame-boundary marker) then draws. Arena reuse is a free
+// bump-pointer rewind (reset_frame_slot).
 //
 // The frame-slot lifecycle (set_build_frame_slot / reset_frame_slot / reset_arena) is
 // driven by the frame owner (engine_threads_coordinator in the streaming loop, the headless tick
-// otherwise). A "frame slot" is the frame-parity index (frame & 1) selecting one of the
-// two depth-1 double buffers.
+// otherwise). A "frame slot" is utils::frame_slot_of(frame), one entry of the ring.
 template <typename TCmd>
 class command_queue
 {
 public:
     explicit command_queue(size_t queue_capacity = 16384, size_t arena_capacity = 4 * 1024 * 1024)
-        : m_arenas{utils::memory_arena(arena_capacity), utils::memory_arena(arena_capacity)}
-        , m_command_queues{std::make_unique<utils::spsc_queue<TCmd*>>(queue_capacity),
-                           std::make_unique<utils::spsc_queue<TCmd*>>(queue_capacity)}
     {
+        m_arenas.reserve(utils::k_frame_slot_count);
+        for (uint32_t i = 0; i < utils::k_frame_slot_count; ++i)
+        {
+            m_arenas.emplace_back(arena_capacity);
+            m_command_queues[i] = std::make_unique<utils::spsc_queue<TCmd*>>(queue_capacity);
+        }
     }
 
     template <typename T, typename... Args>
@@ -77,7 +82,7 @@ public:
     utils::spsc_queue<TCmd*>&
     queue(uint32_t frame_slot)
     {
-        return *m_command_queues[frame_slot & 1u];
+        return *m_command_queues[frame_slot % utils::k_frame_slot_count];
     }
 
     // Select the build (producer) frame slot for the frame about to be built:
@@ -87,16 +92,16 @@ public:
     void
     set_build_frame_slot(uint32_t frame_slot)
     {
-        m_build_frame_slot = frame_slot & 1u;
+        m_build_frame_slot = frame_slot % utils::k_frame_slot_count;
     }
 
     // Rewind a frame slot's arena after the render thread has drawn that frame (by
     // then its queue is drained empty and every command destructed). Safe against
-    // the main thread, which is building into the *other* frame slot.
+    // the main thread, which is building into a different frame slot.
     void
     reset_frame_slot(uint32_t frame_slot)
     {
-        m_arenas[frame_slot & 1u].reset();
+        m_arenas[frame_slot % utils::k_frame_slot_count].reset();
     }
 
     // Single-threaded / headless: rewind the build arena after a synchronous
@@ -108,11 +113,12 @@ public:
     }
 
 private:
-    utils::memory_arena m_arenas[2];
+    // Sized once in the ctor; a vector only because the arena has no cheap default
+    std::vector<utils::memory_arena> m_arenas;
 
     // unique_ptr because spsc_queue is non-movable (atomics) and has an
     // explicit capacity ctor, so it can't be a plain value array element.
-    std::unique_ptr<utils::spsc_queue<TCmd*>> m_command_queues[2];
+    std::unique_ptr<utils::spsc_queue<TCmd*>> m_command_queues[utils::k_frame_slot_count];
     uint32_t m_build_frame_slot = 0;
 };
 
@@ -120,12 +126,12 @@ private:
 // write to INSTEAD of reaching into a subsystem's system object. Lives as its own
 // global_state box (not on any system) so no subsystem "owns" the queue. The two
 // channels use different mechanisms because their consumers differ:
-//   - render: double-buffered command_queue — main builds slot (F&1), the render thread
-//             drains the other; pointers into a per-parity arena; sized for a full frame
-//             of draw commands.
+//   - render: frame-slot-ringed command_queue — main builds slot frame_slot_of(F), the
+//             render thread drains older ones; pointers into a per-slot arena; sized for
+//             a full frame of draw commands.
 //   - audio:  lock-free value SPSC ring — audio is fire-and-forget on a dedicated
 //             consumer thread (the audio worker in engine_threads_coordinator), so there's no frame
-//             parity and no arena:
+//             slot and no arena:
 //             POD messages are copied straight into the ring. Main is the SOLE producer
 //             (emitter intents, listener pose, orphan stops); the audio thread is the
 //             SOLE consumer. Sized for a handful of intents per frame.
@@ -139,7 +145,7 @@ private:
 //             channel. The pair is grouped so direction is explicit: queues.physics.in
 //             (model->physics commands) and queues.physics.out (physics->model
 //             results, drained by physics_translator::drain_results). See physics_io below.
-//             No frame parity, no arena — the physics worker is self-clocked like audio.
+//             No frame slot, no arena — the physics worker is self-clocked like audio.
 //
 // No teardown drop_pending: the render channel self-cleans via its arena rewind on the
 // render thread, and the audio channel has exactly one consumer (the audio thread) — a
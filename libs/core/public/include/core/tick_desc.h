@@ -0,0 +1,58 @@
+#pragma once
+
+#include <utils/kryga_enum.h>
+
+#include <cstdint>
+#include <string_view>
+
+namespace kryga
+{
+namespace core
+{
+
+// Order of the per-frame level tick. Every batch of a phase finishes before the
+// next phase starts.
+// clang-format off
+#define KRG_TICK_PHASE_LIST(X)                 \
+    X(pre_physics,   0,    "pre_physics")      \
+    X(animation,     1,    "animation")        \
+    X(post_physics,  2,    "post_physics")     \
+    X(late,          3,    "late")
+// clang-format on
+
+KRG_declare_enum_simple(tick_phase, uint8_t, KRG_TICK_PHASE_LIST)
+
+// Shared state a tick touches besides the ticking object itself. Two batches may
+// run side by side only if neither writes what the other reads or writes.
+namespace tick_access
+{
+inline constexpr uint32_t none = 0;
+inline constexpr uint32_t transform = 1u << 0;  // object transforms + transform dirty queue
+inline constexpr uint32_t render = 1u << 1;     // render dirty queue
+inline constexpr uint32_t camera = 1u << 2;     // camera view / projection
+inline constexpr uint32_t input = 1u << 3;      // input providers
+inline constexpr uint32_t audio = 1u << 4;      // audio translator
+inline constexpr uint32_t physics = 1u << 5;    // physics translator
+}  // namespace tick_access
+
+// Per-type tick declaration; any of KRG_ar_class tick_phase / tick_reads /
+// tick_writes declares the type. Undeclared types inherit only the phase and
+// tick alone on the model thread: anything that spawns, destroys or touches
+// state not listed above must stay undeclared.
+struct tick_desc
+{
+    tick_phase phase = tick_phase::pre_physics;
+    uint32_t reads = tick_access::none;
+    uint32_t writes = tick_access::none;
+    bool declared = false;
+
+    bool
+    conflicts(const tick_desc& o) const
+    {
+        return !declared || !o.declared || (writes & (o.reads | o.writes)) ||
+               (o.writes & reads);
+    }
+};
+
+}  // namespace core
+}  // namespace kryga
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "core/tick_desc.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace kryga
+{
+
+namespace root
+{
+class smart_object;
+}
+
+namespace reflection
+{
+struct reflection_type;
+}
+
+namespace jobs
+{
+class job_system;
+}
+
+namespace core
+{
+
+// Per-frame tick, batched by type. Objects of one reflection type tick back to
+// back as one batch; within a phase, declared batches (tick_desc) are packed
+// into waves of mutually independent batches and each wave is spread over the
+// job system. Undeclared batches run after the waves, alone, on the caller.
+//
+// Validation mode records every before_write() made during a wave and reports an
+// object written by two batches of the same wave, i.e. a tick_desc that lies.
+class tick_scheduler
+{
+public:
+    using tick_fn = void (*)(root::smart_object&, float);
+
+    struct stats
+    {
+        uint32_t batches = 0;
+        uint32_t waves = 0;
+        uint32_t parallel_waves = 0;  // waves of more than one batch
+        uint32_t conflicts = 0;  // total since creation
+    };
+
+    tick_scheduler();
+    ~tick_scheduler();
+
+    tick_scheduler(const tick_scheduler&) = delete;
+    tick_scheduler&
+    operator=(const tick_scheduler&) = delete;
+
+    // Null (default) uses glob_state's; without one every batch runs on the caller
+    void
+    set_job_system(jobs::job_system* js)
+    {
+        m_jobs = js;
+    }
+
+    void
+    set_validate(bool v)
+    {
+        m_validate = v;
+    }
+
+    bool
+    get_validate() const
+    {
+        return m_validate;
+    }
+
+    // Drops last frame's objects; batch storage is kept
+    void
+    clear();
+
+    // Batches by `rt`, ticked with `fn` under rt.tick
+    void
+    add(const reflection::reflection_type& rt, root::smart_object& obj, tick_fn fn);
+
+    void
+    run(float dt);
+
+    // Called from smart_object::before_write
+    void
+    note_write(const root::smart_object& obj)
+    {
+        if (m_recording.load(std::memory_order_relaxed))
+        {
+            record_write(obj);
+        }
+    }
+
+    const stats&
+    get_stats() const
+    {
+        return m_stats;
+    }
+
+private:
+    struct batch
+    {
+        const reflection::reflection_type* rt = nullptr;
+        tick_fn fn = nullptr;
+        std::vector<root::smart_object*> objects;
+    };
+
+    void
+    run_batch(batch& b, float dt);
+
+    void
+    run_wave(const std::vector<batch*>& wave, float dt);
+
+    void
+    record_write(const root::smart_object& obj);
+
+    std::vector<std::unique_ptr<batch>> m_batches;
+    std::unordered_map<const reflection::reflection_type*, batch*> m_batch_by_type;
+
+    // Scratch, reused every frame
+    std::vector<batch*> m_exclusive;
+    std::vector<std::vector<batch*>> m_waves;
+    std::vector<tick_desc> m_wave_access;
+
+    jobs::job_system* m_jobs = nullptr;
+
+    bool m_validate = false;
+    std::atomic<bool> m_recording = false;
+    std::mutex m_writes_mutex;
+    std::unordered_map<const root::smart_object*, const batch*> m_writers;
+
+    stats m_stats;
+};
+
+}  // namespace core
+}  // namespace kryga
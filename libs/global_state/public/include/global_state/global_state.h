@@ -60,6 +60,10 @@ namespace vfs
 {
 class virtual_file_system;
 }
+namespace jobs
+{
+class job_system;
+}
 
 // Services
 namespace engine
@@ -99,6 +103,7 @@ struct state_mutator__audio_system;
 struct state_mutator__editor_system;
 struct state_mutator__game_session;
 struct state_mutator__vfs;
+struct state_mutator__job_system;
 
 // Services
 struct state_mutator__input_manager;
@@ -157,6 +162,7 @@ class state
     friend class ::kryga::state_mutator__editor_system;
     friend class ::kryga::state_mutator__game_session;
     friend class ::kryga::state_mutator__vfs;
+    friend class ::kryga::state_mutator__job_system;
 
     // Services
     friend class ::kryga::state_mutator__input_manager;
@@ -214,6 +220,7 @@ public:
     KRG_gen_getter(editor_system, engine::editor_system);
     KRG_gen_getter(game_session, game::game_session);
     KRG_gen_getter(vfs, vfs::virtual_file_system);
+    KRG_gen_getter(job_system, jobs::job_system);
 
     // Services
     KRG_gen_getter(input_manager, engine::input_manager);
@@ -279,6 +286,7 @@ private:
     engine::editor_system*          m_editor_system = nullptr;
     game::game_session*             m_game_session = nullptr;
     vfs::virtual_file_system*       m_vfs = nullptr;
+    jobs::job_system*               m_job_system = nullptr;
 
     // Services
     engine::input_manager*          m_input_manager = nullptr;
@@ -335,6 +343,12 @@ struct state_mutator__game_session
     set(gs::state& s);
 };
 
+struct state_mutator__job_system
+{
+    static void
+    set(gs::state& s);
+};
+
 // Services
 
 struct state_mutator__input_manager
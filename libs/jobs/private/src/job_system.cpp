@@ -0,0 +1,337 @@
+#include "jobs/job_system.h"
+
+#include <global_state/global_state.h>
+
+#include <utils/check.h>
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <string>
+
+namespace kryga
+{
+
+void
+state_mutator__job_system::set(gs::state& s)
+{
+    auto p = s.create_box<jobs::job_system>("job_system");
+    s.m_job_system = p;
+    s.register_system(p);
+}
+
+namespace jobs
+{
+
+namespace
+{
+
+// Worker identity of the current thread; owner is null off the pool
+thread_local const job_system* t_owner = nullptr;
+thread_local uint32_t t_index = 0;
+
+}  // namespace
+
+job_system::~job_system()
+{
+    stop();
+}
+
+void
+job_system::on_init(gs::state&)
+{
+    start();
+}
+
+void
+job_system::start(uint32_t worker_count)
+{
+    KRG_check(m_workers.empty(), "job_system::start called twice");
+
+    if (worker_count == 0)
+    {
+        const uint32_t hw = std::thread::hardware_concurrency();
+        worker_count = hw > k_reserved_threads ? hw - k_reserved_threads : 1;
+    }
+
+    m_stop = false;
+    m_steals.store(0);
+    for (uint32_t i = 0; i < worker_count; ++i)
+    {
+        m_queues.push_back(std::make_unique<queue>());
+    }
+    for (uint32_t i = 0; i < worker_count; ++i)
+    {
+        m_workers.emplace_back(&job_system::worker_loop, this, i);
+    }
+    m_running.store(worker_count, std::memory_order_release);
+}
+
+void
+job_system::stop()
+{
+    if (m_workers.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_sleep_mutex);
+        m_stop = true;
+    }
+    m_sleep_cv.notify_all();
+
+    for (auto& t : m_workers)
+    {
+        t.join();
+    }
+    m_running.store(0, std::memory_order_release);
+    m_workers.clear();
+    m_queues.clear();
+}
+
+void
+job_system::run(std::function<void()> fn, job_counter* counter, job_priority priority)
+{
+    if (counter)
+    {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    push({.fn = std::move(fn), .counter = counter}, priority);
+}
+
+void
+job_system::run_after(job_counter& dep,
+                      std::function<void()> fn,
+                      job_counter* counter,
+                      job_priority priority)
+{
+    // Counted from now, so waiting on `counter` covers the continuation too
+    if (counter)
+    {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard lock(dep.m_mutex);
+        if (!dep.done())
+        {
+            dep.m_continuations.push_back(
+                {.fn = std::move(fn), .counter = counter, .priority = priority});
+            return;
+        }
+    }
+    push({.fn = std::move(fn), .counter = counter}, priority);
+}
+
+void
+job_system::wait(job_counter& counter)
+{
+    while (!counter.done())
+    {
+        if (!run_one())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // finish() may still hold the lock it dropped the count under
+    std::lock_guard lock(counter.m_mutex);
+}
+
+void
+job_system::parallel_for(uint32_t count,
+                         uint32_t grain,
+                         const std::function<void(uint32_t, uint32_t)>& fn,
+                         job_priority priority)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    ZoneScopedN("Jobs::ParallelFor");
+
+    const uint32_t threads = worker_count() + 1;
+    if (grain == 0)
+    {
+        grain = std::max(1u, count / (threads * 4));
+    }
+    const uint32_t chunks = (count + grain - 1) / grain;
+
+    std::atomic<uint32_t> next = 0;
+    auto take = [&]
+    {
+        for (uint32_t c = next.fetch_add(1); c < chunks; c = next.fetch_add(1))
+        {
+            const uint32_t begin = c * grain;
+            fn(begin, std::min(count, begin + grain));
+        }
+    };
+
+    // One helper per chunk beyond the caller's, at most one per worker; each
+    // pulls chunks until none are left
+    job_counter helpers;
+    const uint32_t helper_count = std::min(chunks - 1, worker_count());
+    for (uint32_t i = 0; i < helper_count; ++i)
+    {
+        run(take, &helpers, priority);
+    }
+    take();
+    wait(helpers);
+}
+
+void
+job_system::push(job j, job_priority priority)
+{
+    if (worker_count() == 0)
+    {
+        execute(j);
+        return;
+    }
+
+    auto& q = t_owner == this ? *m_queues[t_index] : m_injection;
+    {
+        std::lock_guard lock(q.mutex);
+        q.jobs[static_cast<uint32_t>(priority)].push_back(std::move(j));
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // Empty lock: a worker between its predicate check and wait() can't miss this
+    {
+        std::lock_guard lock(m_sleep_mutex);
+    }
+    m_sleep_cv.notify_one();
+}
+
+bool
+job_system::try_pop(job& out)
+{
+    if (m_queued.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    const bool is_worker = t_owner == this;
+    const uint32_t n = static_cast<uint32_t>(m_queues.size());
+
+    auto pop = [&](queue& q, uint32_t p, bool back)
+    {
+        std::lock_guard lock(q.mutex);
+        auto& d = q.jobs[p];
+        if (d.empty())
+        {
+            return false;
+        }
+        if (back)
+        {
+            out = std::move(d.back());
+            d.pop_back();
+        }
+        else
+        {
+            out = std::move(d.front());
+            d.pop_front();
+        }
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    };
+
+    for (uint32_t p = 0; p < job_priority_count; ++p)
+    {
+        // Own work newest first (still hot in cache), everyone else's oldest first
+        if (is_worker && pop(*m_queues[t_index], p, true))
+        {
+            return true;
+        }
+        if (pop(m_injection, p, false))
+        {
+            return true;
+        }
+        const uint32_t start = is_worker ? t_index + 1 : 0;
+        for (uint32_t k = 0; k < n; ++k)
+        {
+            const uint32_t victim = (start + k) % n;
+            if ((!is_worker || victim != t_index) && pop(*m_queues[victim], p, false))
+            {
+                m_steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool
+job_system::run_one()
+{
+    job j;
+    if (!try_pop(j))
+    {
+        return false;
+    }
+    execute(j);
+    return true;
+}
+
+void
+job_system::execute(job& j)
+{
+    {
+        ZoneScopedN("Job");
+        j.fn();
+    }
+    if (j.counter)
+    {
+        finish(*j.counter);
+    }
+}
+
+void
+job_system::finish(job_counter& counter)
+{
+    std::vector<job_counter::continuation> ready;
+    {
+        std::lock_guard lock(counter.m_mutex);
+        if (counter.m_pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+        ready.swap(counter.m_continuations);
+    }
+
+    for (auto& c : ready)
+    {
+        push({.fn = std::move(c.fn), .counter = c.counter}, c.priority);
+    }
+}
+
+void
+job_system::worker_loop(uint32_t index)
+{
+    t_owner = this;
+    t_index = index;
+
+    const std::string thread_name = "Job worker " + std::to_string(index);
+    tracy::SetThreadName(thread_name.c_str());
+
+    for (;;)
+    {
+        if (run_one())
+        {
+            continue;
+        }
+
+        std::unique_lock lock(m_sleep_mutex);
+        m_sleep_cv.wait(
+            lock, [this] { return m_stop || m_queued.load(std::memory_order_acquire) > 0; });
+        if (m_stop && m_queued.load(std::memory_order_acquire) == 0)
+        {
+            break;
+        }
+    }
+
+    t_owner = nullptr;
+}
+
+}  // namespace jobs
+}  // namespace kryga
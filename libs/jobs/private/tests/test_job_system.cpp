@@ -0,0 +1,134 @@
+#include "jobs/job_system.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace kryga::jobs;
+
+TEST(job_system, runs_inline_without_workers)
+{
+    job_system js;
+
+    job_counter c;
+    int value = 0;
+    js.run([&] { value = 1; }, &c);
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(c.done());
+
+    js.run_after(c, [&] { value = 2; });
+    EXPECT_EQ(value, 2);
+}
+
+TEST(job_system, parallel_for_covers_every_index_once)
+{
+    job_system js;
+    js.start(3);
+
+    std::vector<std::atomic<int>> hits(10007);
+    for (uint32_t grain : {0u, 1u, 64u, 20000u})
+    {
+        for (auto& h : hits)
+        {
+            h = 0;
+        }
+        js.parallel_for(static_cast<uint32_t>(hits.size()),
+                        grain,
+                        [&](uint32_t begin, uint32_t end)
+                        {
+                            for (uint32_t i = begin; i < end; ++i)
+                            {
+                                hits[i].fetch_add(1);
+                            }
+                        });
+        for (size_t i = 0; i < hits.size(); ++i)
+        {
+            ASSERT_EQ(hits[i].load(), 1) << "grain " << grain << " index " << i;
+        }
+    }
+}
+
+TEST(job_system, nested_waits_and_continuations)
+{
+    job_system js;
+    js.start(2);
+
+    // Every outer job fans out and waits: waiting must run jobs, not park a worker
+    std::atomic<int> leaves = 0;
+    job_counter outer;
+    for (int i = 0; i < 16; ++i)
+    {
+        js.run(
+            [&]
+            {
+                job_counter inner;
+                for (int j = 0; j < 16; ++j)
+                {
+                    js.run([&] { leaves.fetch_add(1); }, &inner);
+                }
+                js.wait(inner);
+            },
+            &outer);
+    }
+
+    std::atomic<int> seen_at_continuation = -1;
+    job_counter tail;
+    js.run_after(outer, [&] { seen_at_continuation = leaves.load(); }, &tail);
+    EXPECT_FALSE(tail.done());
+
+    js.wait(tail);
+    EXPECT_EQ(leaves.load(), 256);
+    EXPECT_EQ(seen_at_continuation.load(), 256);
+}
+
+TEST(job_system, higher_priority_runs_first)
+{
+    job_system js;
+    js.start(1);
+
+    // Park the only worker so everything below queues up behind it
+    std::atomic<bool> release = false;
+    job_counter all;
+    js.run(
+        [&]
+        {
+            while (!release.load())
+            {
+                std::this_thread::yield();
+            }
+        },
+        &all);
+
+    std::mutex m;
+    std::vector<int> order;
+    auto record = [&](int v)
+    {
+        return [&, v]
+        {
+            std::lock_guard lock(m);
+            order.push_back(v);
+        };
+    };
+    js.run(record(3), &all, job_priority::low);
+    js.run(record(2), &all, job_priority::normal);
+    js.run(record(1), &all, job_priority::high);
+
+    // Whether or not the worker took the blocker first, it runs before `2` (same
+    // priority, queued earlier) and holds the worker until released
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release = true;
+
+    // Not js.wait(): this thread would take jobs itself and race the worker.
+    // stop() joins, so `all` is no longer touched once it returns.
+    while (!all.done())
+    {
+        std::this_thread::yield();
+    }
+    js.stop();
+
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <global_state/system.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace kryga
+{
+namespace jobs
+{
+
+enum class job_priority : uint8_t
+{
+    high = 0,
+    normal,
+    low,
+};
+
+inline constexpr uint32_t job_priority_count = 3;
+
+class job_system;
+
+// Outstanding-job count. Jobs submitted with a counter bump it and drop it when
+// they finish; job_system::wait() runs other jobs until it reaches zero, and
+// job_system::run_after() queues a continuation for that moment. Reusable once
+// done, never movable. Destroy it only after wait() returned: done() alone can
+// be true while the last job is still releasing it.
+class job_counter
+{
+public:
+    job_counter() = default;
+    job_counter(const job_counter&) = delete;
+    job_counter&
+    operator=(const job_counter&) = delete;
+
+    bool
+    done() const
+    {
+        return m_pending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class job_system;
+
+    struct continuation
+    {
+        std::function<void()> fn;
+        job_counter* counter = nullptr;
+        job_priority priority = job_priority::normal;
+    };
+
+    std::atomic<uint32_t> m_pending = 0;
+    std::mutex m_mutex;
+    std::vector<continuation> m_continuations;
+};
+
+// Engine-wide work-stealing pool. Each worker owns a deque per priority: it
+// pushes and pops its own work at the back and steals from the front of the
+// others; jobs from non-worker threads go through a shared injection queue.
+// Waiting threads run jobs instead of blocking, so nested waits don't need extra
+// threads. With no workers started every job runs inline in run().
+//
+// Reached via glob_state().get_job_system(); tools without a global state own a
+// local instance.
+class job_system : public gs::system
+{
+public:
+    // Cores the engine already keeps busy: main, render, audio, physics
+    static constexpr uint32_t k_reserved_threads = 4;
+
+    job_system() = default;
+    ~job_system() override;
+
+    job_system(const job_system&) = delete;
+    job_system&
+    operator=(const job_system&) = delete;
+
+    std::string_view
+    name() const override
+    {
+        return "job_system";
+    }
+
+    std::span<const std::string_view>
+    deps() const override
+    {
+        return {};
+    }
+
+    // Starts the default worker count
+    void
+    on_init(gs::state&) override;
+
+    // 0: hardware threads minus k_reserved_threads, at least one
+    void
+    start(uint32_t worker_count = 0);
+
+    // Finishes queued work, then joins the workers. Submitters must be done.
+    void
+    stop();
+
+    uint32_t
+    worker_count() const
+    {
+        return m_running.load(std::memory_order_acquire);
+    }
+
+    void
+    run(std::function<void()> fn,
+        job_counter* counter = nullptr,
+        job_priority priority = job_priority::normal);
+
+    // Queues fn once `dep` drains; runs it now if it already has
+    void
+    run_after(job_counter& dep,
+              std::function<void()> fn,
+              job_counter* counter = nullptr,
+              job_priority priority = job_priority::normal);
+
+    void
+    wait(job_counter& counter);
+
+    // fn(begin, end) over [0, count) in chunks of `grain` (0: a few chunks per
+    // thread). The caller takes chunks too and returns when all are done.
+    void
+    parallel_for(uint32_t count,
+                 uint32_t grain,
+                 const std::function<void(uint32_t, uint32_t)>& fn,
+                 job_priority priority = job_priority::normal);
+
+    // Jobs taken from another worker's deque, since start()
+    uint64_t
+    steal_count() const
+    {
+        return m_steals.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct job
+    {
+        std::function<void()> fn;
+        job_counter* counter = nullptr;
+    };
+
+    struct queue
+    {
+        std::mutex mutex;
+        std::deque<job> jobs[job_priority_count];
+    };
+
+    void
+    push(job j, job_priority priority);
+
+    bool
+    try_pop(job& out);
+
+    bool
+    run_one();
+
+    void
+    execute(job& j);
+
+    void
+    finish(job_counter& counter);
+
+    void
+    worker_loop(uint32_t index);
+
+    std::vector<std::thread> m_workers;
+    std::atomic<uint32_t> m_running = 0;  // published once every worker is spawned
+    std::vector<std::unique_ptr<queue>> m_queues;  // one per worker
+    queue m_injection;
+
+    std::atomic<uint32_t> m_queued = 0;
+    std::atomic<uint64_t> m_steals = 0;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_cv;
+    bool m_stop = false;
+};
+
+}  // namespace jobs
+}  // namespace kryga
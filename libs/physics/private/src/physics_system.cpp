@@ -15,11 +15,14 @@
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 #include <Jolt/Physics/Body/BodyInterface.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/HeightFieldShape.h>
 #include <Jolt/Physics/Collision/Shape/MeshShape.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/RegisterTypes.h>
 
+#include <algorithm>
+
 namespace kryga
 {
 
@@ -266,6 +269,68 @@ physics_system::create_static_mesh(static_body_handle h, const static_world_mesh
     ALOG_INFO("create_static_mesh: collider {} added ({} tris)", h.value, mesh.indices.size() / 3);
 }
 
+void
+physics_system::create_static_height_field(static_body_handle h, const static_height_field& field)
+{
+    if (!m_impl->world || !h.valid())
+    {
+        return;
+    }
+
+    const utils::handle<k_static_collider_kind> ph{h.value};
+    m_impl->static_storage.grow_for(ph);
+    m_impl->static_storage.set_generation(ph, ph.generation());
+
+    const uint32_t n = field.sample_count;
+    if (n < 2 || !field.samples || field.samples->size() < size_t(n) * n)
+    {
+        ALOG_WARN("create_static_height_field: degenerate field ({} samples) — no collider", n);
+        return;
+    }
+
+    // Jolt wants whole blocks per side; the padding past the grid has no collision
+    JPH::HeightFieldShapeSettings settings;
+    settings.mOffset = JPH::Vec3(field.offset.x, field.offset.y, field.offset.z);
+    settings.mScale = JPH::Vec3(field.scale.x, field.scale.y, field.scale.z);
+    const uint32_t block = settings.mBlockSize;
+    const uint32_t padded = (n + block - 1) / block * block;
+    settings.mSampleCount = padded;
+    settings.mHeightSamples.resize(size_t(padded) * padded,
+                                   JPH::HeightFieldShapeConstants::cNoCollisionValue);
+
+    const float* src = field.samples->data();
+    for (uint32_t z = 0; z < n; ++z)
+    {
+        std::copy_n(src + size_t(z) * n, n, settings.mHeightSamples.data() + size_t(z) * padded);
+    }
+
+    auto shape_result = settings.Create();
+    if (shape_result.HasError())
+    {
+        ALOG_WARN("create_static_height_field: {}", shape_result.GetError().c_str());
+        return;
+    }
+
+    const auto& q = field.rotation;
+    JPH::BodyCreationSettings bcs(shape_result.Get(),
+                                  JPH::RVec3(field.position.x, field.position.y, field.position.z),
+                                  JPH::Quat(q.x, q.y, q.z, q.w).Normalized(),
+                                  JPH::EMotionType::Static,
+                                  jolt_layers::NON_MOVING);
+
+    auto& bi = m_impl->world->GetBodyInterface();
+    JPH::BodyID body = bi.CreateAndAddBody(bcs, JPH::EActivation::DontActivate);
+    if (body.IsInvalid())
+    {
+        return;
+    }
+
+    m_impl->world->OptimizeBroadPhase();
+
+    *m_impl->static_storage.at(ph) = body;
+    ALOG_INFO("create_static_height_field: collider {} added ({}x{} samples)", h.value, n, n);
+}
+
 void
 physics_system::unregister_static_mesh(static_body_handle h)
 {
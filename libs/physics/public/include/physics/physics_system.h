@@ -73,6 +73,10 @@ public:
     void
     create_static_mesh(static_body_handle h, const static_world_mesh& mesh);
 
+    // Same as create_static_mesh, for a height field (Jolt HeightFieldShape)
+    void
+    create_static_height_field(static_body_handle h, const static_height_field& field);
+
     // Destroy the body behind a collider handle and free its slot. Driven by the
     // unregister command on the physics thread. No-op on a stale/empty handle.
     void
@@ -3,6 +3,7 @@
 #include <glm_unofficial/glm.h>
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace kryga
@@ -66,5 +67,19 @@ struct static_world_mesh
     std::vector<uint32_t> indices;
 };
 
+// Square grid of heights, built into a native height-field shape rather than a
+// triangle mesh. Sample (x, z) = samples[z * sample_count + x] sits at
+// position + rotation * (offset + scale * (x, sample, z)). The samples are shared,
+// not copied, with the producer's height cache.
+struct static_height_field
+{
+    std::shared_ptr<const std::vector<float>> samples;
+    uint32_t sample_count = 0;
+    glm::vec3 offset{0.0f};
+    glm::vec3 scale{1.0f};
+    glm::vec3 position{0.0f};
+    glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+};
+
 }  // namespace physics
 }  // namespace kryga
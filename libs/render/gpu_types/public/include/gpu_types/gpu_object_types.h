@@ -23,6 +23,8 @@ struct object_data
     uint lightmap_texture_index;  // Bindless texture index for lightmap (0xFFFFFFFF = none)
     vec3 bounding_sphere_center;  // World-space sphere center for frustum cull (geometry centroid,
                                   // not obj_pos)
+    vec3 position_scale;          // Compact mesh position dequantisation (1 / 0 otherwise)
+    vec3 position_offset;
 };
 
 GPU_END_NAMESPACE
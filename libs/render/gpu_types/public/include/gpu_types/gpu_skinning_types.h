@@ -0,0 +1,27 @@
+// GPU Skinning Types - Shared between C++ and GLSL
+
+#ifndef GPU_SKINNING_TYPES_H
+#define GPU_SKINNING_TYPES_H
+
+#include <gpu_types/gpu_port.h>
+
+GPU_BEGIN_NAMESPACE
+
+// One skinned instance for the pre-skin compute pass. Jobs are sorted by
+// first_vertex (a running sum of vertex_count), so a thread finds its job by
+// binary search over the flat vertex range.
+struct skinning_job
+{
+    bda_addr src_vertices;  // skinned_vertex_data[] of the source mesh
+    uint first_vertex;      // first vertex_data written into the skinned pool
+    uint vertex_count;
+    uint bone_offset;  // into the bone matrices buffer
+    uint bone_count;   // 0 = copy through unskinned
+    uint compact;      // 1 = src_vertices are compact_skinned_vertex_data[]
+    vec3 position_scale;
+    vec3 position_offset;
+};
+
+GPU_END_NAMESPACE
+
+#endif  // GPU_SKINNING_TYPES_H
@@ -0,0 +1,42 @@
+// GPU UI Types - Shared between C++ and GLSL
+// Retained UI batch: panels and glyphs as instanced screen-space quads
+
+#ifndef GPU_UI_TYPES_H
+#define GPU_UI_TYPES_H
+
+#include <gpu_types/gpu_port.h>
+
+GPU_BEGIN_NAMESPACE
+
+// Flat-colored quad (panel) — the fragment stage skips the atlas fetch
+#define KGPU_UI_NO_TEXTURE 0xFFFFFFFFu
+
+// Quad anchors: rect_px is relative to this viewport corner, so a resize moves
+// right/bottom anchored widgets without re-laying them out on the CPU.
+#define KGPU_UI_ANCHOR_TOP_LEFT 0u
+#define KGPU_UI_ANCHOR_TOP_RIGHT 1u
+#define KGPU_UI_ANCHOR_BOTTOM_LEFT 2u
+#define KGPU_UI_ANCHOR_BOTTOM_RIGHT 3u
+
+// One instance of the batched UI draw (scalar layout, 64 bytes)
+struct ui_quad
+{
+    vec4 rect_px;        // x0, y0, x1, y1 in pixels (top-left origin), anchor-relative
+    vec4 uv_rect;        // uv0.xy, uv1.xy in the atlas
+    vec4 color;          // rgba
+    uint tex_index;      // bindless atlas index or KGPU_UI_NO_TEXTURE
+    uint sampler_index;  // static sampler index
+    uint anchor;         // KGPU_UI_ANCHOR_*
+    uint _pad0;
+};
+
+// Push constants for the batched UI pipeline
+struct push_constants_ui
+{
+    bda_addr bdag_quads;
+    vec2 viewport_size;
+};
+
+GPU_END_NAMESPACE
+
+#endif  // GPU_UI_TYPES_H
@@ -26,6 +26,29 @@ struct skinned_vertex_data
     vec4 bone_weights;
 };
 
+// Compact storage of vertex_data, packed into words so it reads the same from C++,
+// vertex input and buffer references. The vertex input feeds each word through a
+// normalized or float format (see render::k_compact_vertex_layout)
+struct compact_vertex_data
+{
+    uvec2 position;  // unorm16 x3 across the mesh bounds, 16 bits unused
+    uint normal;     // octahedral, snorm16 x2
+    uint color;      // unorm8 x4
+    uint uv;         // half x2
+    uint uv2;        // unorm16 x2
+};
+
+// Compact storage of skinned_vertex_data, only read by the pre-skin pass
+struct compact_skinned_vertex_data
+{
+    uvec2 position;     // unorm16 x3 across the mesh bounds, 16 bits unused
+    uint normal;        // octahedral, snorm16 x2
+    uint color;         // unorm8 x4
+    uint uv;            // half x2
+    uint bone_indices;  // uint8 x4
+    uint bone_weights;  // unorm8 x4
+};
+
 GPU_END_NAMESPACE
 
 #endif  // GPU_VERTEX_TYPES_H
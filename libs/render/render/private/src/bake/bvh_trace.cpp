@@ -0,0 +1,206 @@
+#include "vulkan_render/bake/bvh_trace.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace kryga
+{
+namespace render
+{
+namespace bake
+{
+
+namespace
+{
+
+// Deeper than the GPU traversal (32): CPU stack is cheap and SAH trees over
+// large scenes can exceed 32 levels on degenerate splits.
+constexpr uint32_t BVH_STACK_SIZE = 64;
+
+bool
+ray_aabb(const glm::vec3& origin,
+         const glm::vec3& inv_dir,
+         const glm::vec3& aabb_min,
+         const glm::vec3& aabb_max,
+         float t_max)
+{
+    glm::vec3 t0 = (aabb_min - origin) * inv_dir;
+    glm::vec3 t1 = (aabb_max - origin) * inv_dir;
+
+    glm::vec3 tmin = glm::min(t0, t1);
+    glm::vec3 tmax = glm::max(t0, t1);
+
+    float enter = std::max(std::max(tmin.x, tmin.y), tmin.z);
+    float exit = std::min(std::min(tmax.x, tmax.y), tmax.z);
+
+    return enter <= exit && exit >= 0.0f && enter < t_max;
+}
+
+// Moller-Trumbore. Returns false on miss, otherwise t/u/v.
+bool
+ray_triangle(const glm::vec3& origin,
+             const glm::vec3& dir,
+             const gpu::bake_triangle& tri,
+             float& t,
+             float& u,
+             float& v)
+{
+    glm::vec3 e1 = tri.v1 - tri.v0;
+    glm::vec3 e2 = tri.v2 - tri.v0;
+    glm::vec3 h = glm::cross(dir, e2);
+    float a = glm::dot(e1, h);
+
+    if (std::abs(a) < 1e-7f)
+    {
+        return false;
+    }
+
+    float f = 1.0f / a;
+    glm::vec3 s = origin - tri.v0;
+    u = f * glm::dot(s, h);
+
+    if (u < 0.0f || u > 1.0f)
+    {
+        return false;
+    }
+
+    glm::vec3 q = glm::cross(s, e1);
+    v = f * glm::dot(dir, q);
+
+    if (v < 0.0f || u + v > 1.0f)
+    {
+        return false;
+    }
+
+    t = f * glm::dot(e2, q);
+
+    return t >= 1e-5f;
+}
+
+bool
+box_overlap(const glm::vec3& a_min,
+            const glm::vec3& a_max,
+            const glm::vec3& b_min,
+            const glm::vec3& b_max)
+{
+    return a_min.x <= b_max.x && a_max.x >= b_min.x && a_min.y <= b_max.y &&
+           a_max.y >= b_min.y && a_min.z <= b_max.z && a_max.z >= b_min.z;
+}
+
+}  // namespace
+
+bvh_hit
+trace_ray(const bvh_build_result& bvh,
+          const glm::vec3& origin,
+          const glm::vec3& direction,
+          float t_max)
+{
+    bvh_hit res;
+    res.t = t_max;
+
+    if (bvh.nodes.empty())
+    {
+        return res;
+    }
+
+    glm::vec3 inv_dir = 1.0f / direction;
+
+    uint32_t stack[BVH_STACK_SIZE];
+    uint32_t stack_ptr = 1;
+    stack[0] = 0u;
+
+    while (stack_ptr > 0)
+    {
+        const auto& node = bvh.nodes[stack[--stack_ptr]];
+
+        if (!ray_aabb(origin, inv_dir, node.aabb_min, node.aabb_max, res.t))
+        {
+            continue;
+        }
+
+        if (KGPU_BVH_IS_LEAF(node))
+        {
+            uint32_t tri_start = node.left_or_tri_idx;
+            uint32_t tri_count = KGPU_BVH_TRI_COUNT(node);
+
+            for (uint32_t i = 0; i < tri_count; ++i)
+            {
+                float t = 0.0f, u = 0.0f, v = 0.0f;
+                if (ray_triangle(origin, direction, bvh.triangles[tri_start + i], t, u, v) &&
+                    t < res.t)
+                {
+                    res.t = t;
+                    res.tri_idx = tri_start + i;
+                    res.u = u;
+                    res.v = v;
+                }
+            }
+        }
+        else if (stack_ptr + 2 <= BVH_STACK_SIZE)
+        {
+            stack[stack_ptr++] = node.right_or_count;
+            stack[stack_ptr++] = node.left_or_tri_idx;
+        }
+    }
+
+    if (res.is_hit())
+    {
+        const auto& tri = bvh.triangles[res.tri_idx];
+        float w = 1.0f - res.u - res.v;
+        glm::vec3 n = w * tri.n0 + res.u * tri.n1 + res.v * tri.n2;
+        res.back_face = glm::dot(n, direction) > 0.0f;
+    }
+
+    return res;
+}
+
+bool
+overlaps_box(const bvh_build_result& bvh, const glm::vec3& box_min, const glm::vec3& box_max)
+{
+    if (bvh.nodes.empty())
+    {
+        return false;
+    }
+
+    uint32_t stack[BVH_STACK_SIZE];
+    uint32_t stack_ptr = 1;
+    stack[0] = 0u;
+
+    while (stack_ptr > 0)
+    {
+        const auto& node = bvh.nodes[stack[--stack_ptr]];
+
+        if (!box_overlap(node.aabb_min, node.aabb_max, box_min, box_max))
+        {
+            continue;
+        }
+
+        if (KGPU_BVH_IS_LEAF(node))
+        {
+            uint32_t tri_start = node.left_or_tri_idx;
+            uint32_t tri_count = KGPU_BVH_TRI_COUNT(node);
+
+            for (uint32_t i = 0; i < tri_count; ++i)
+            {
+                const auto& tri = bvh.triangles[tri_start + i];
+                glm::vec3 mn = glm::min(glm::min(tri.v0, tri.v1), tri.v2);
+                glm::vec3 mx = glm::max(glm::max(tri.v0, tri.v1), tri.v2);
+                if (box_overlap(mn, mx, box_min, box_max))
+                {
+                    return true;
+                }
+            }
+        }
+        else if (stack_ptr + 2 <= BVH_STACK_SIZE)
+        {
+            stack[stack_ptr++] = node.right_or_count;
+            stack[stack_ptr++] = node.left_or_tri_idx;
+        }
+    }
+
+    return false;
+}
+
+}  // namespace bake
+}  // namespace render
+}  // namespace kryga
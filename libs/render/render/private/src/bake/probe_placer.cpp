@@ -1,5 +1,7 @@
 #include "vulkan_render/bake/probe_placer.h"
 
+#include "vulkan_render/bake/bvh_trace.h"
+
 #include <utils/kryga_log.h>
 
 #include <algorithm>
@@ -12,6 +14,215 @@ namespace render
 namespace bake
 {
 
+namespace
+{
+
+constexpr float k_trace_distance = 10000.0f;
+
+struct scene_bounds
+{
+    glm::vec3 mn{std::numeric_limits<float>::max()};
+    glm::vec3 mx{std::numeric_limits<float>::lowest()};
+};
+
+scene_bounds
+compute_bounds(const gpu::vertex_data* vertices, uint32_t vertex_count, float margin)
+{
+    scene_bounds b;
+    for (uint32_t i = 0; i < vertex_count; ++i)
+    {
+        b.mn = glm::min(b.mn, vertices[i].position);
+        b.mx = glm::max(b.mx, vertices[i].position);
+    }
+
+    b.mn -= glm::vec3(margin);
+    b.mx += glm::vec3(margin);
+    return b;
+}
+
+glm::uvec3
+grid_dims(const scene_bounds& b, float spacing)
+{
+    auto axis = [spacing](float extent)
+    { return std::max(1u, static_cast<uint32_t>(std::ceil(extent / spacing))); };
+
+    glm::vec3 extent = b.mx - b.mn;
+    return {axis(extent.x), axis(extent.y), axis(extent.z)};
+}
+
+// Spherical Fibonacci directions — even coverage with no clustering at poles
+std::vector<glm::vec3>
+make_validation_dirs(uint32_t count)
+{
+    count = std::max(count, 4u);
+
+    std::vector<glm::vec3> dirs(count);
+    const float golden_angle = 2.39996323f;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float z = 1.0f - (2.0f * static_cast<float>(i) + 1.0f) / static_cast<float>(count);
+        float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+        float phi = golden_angle * static_cast<float>(i);
+        dirs[i] = glm::vec3(r * std::cos(phi), r * std::sin(phi), z);
+    }
+    return dirs;
+}
+
+struct probe_visibility
+{
+    float back_ratio = 0.0f;
+    float closest_t = k_trace_distance;
+    glm::vec3 closest_dir{0.0f};
+    float closest_back_t = k_trace_distance;
+    glm::vec3 closest_back_dir{0.0f};
+};
+
+probe_visibility
+sample_visibility(const bvh_build_result& bvh,
+                  const std::vector<glm::vec3>& dirs,
+                  const glm::vec3& pos)
+{
+    probe_visibility vis;
+    uint32_t back_hits = 0;
+
+    for (const auto& dir : dirs)
+    {
+        auto hit = trace_ray(bvh, pos, dir, k_trace_distance);
+        if (!hit.is_hit())
+        {
+            continue;
+        }
+
+        if (hit.t < vis.closest_t)
+        {
+            vis.closest_t = hit.t;
+            vis.closest_dir = dir;
+        }
+
+        if (hit.back_face)
+        {
+            ++back_hits;
+            if (hit.t < vis.closest_back_t)
+            {
+                vis.closest_back_t = hit.t;
+                vis.closest_back_dir = dir;
+            }
+        }
+    }
+
+    vis.back_ratio = static_cast<float>(back_hits) / static_cast<float>(dirs.size());
+    return vis;
+}
+
+// Classify a probe and move it to valid space if possible. Relocation never
+// leaves max_relocation * cell_size so grid probes stay inside their cell.
+uint8_t
+validate_probe(const bvh_build_result& bvh,
+               const std::vector<glm::vec3>& dirs,
+               const probe_placement_params& params,
+               float cell_size,
+               float empty_distance,
+               glm::vec3& pos)
+{
+    const glm::vec3 origin = pos;
+    const float max_disp = params.max_relocation * cell_size;
+
+    uint8_t flags = probe_flag_none;
+
+    for (uint32_t iter = 0; iter <= params.relocation_iterations; ++iter)
+    {
+        auto vis = sample_visibility(bvh, dirs, pos);
+
+        if (vis.back_ratio > params.backface_threshold)
+        {
+            // Step through the nearest back face into the open side
+            pos += vis.closest_back_dir * (vis.closest_back_t + params.surface_offset);
+            flags |= probe_flag_relocated;
+
+            if (glm::length(pos - origin) > max_disp)
+            {
+                break;
+            }
+            continue;
+        }
+
+        if (vis.closest_t < params.surface_offset)
+        {
+            pos -= vis.closest_dir * (params.surface_offset - vis.closest_t);
+            flags |= probe_flag_relocated;
+        }
+
+        if (glm::length(pos - origin) > max_disp)
+        {
+            break;
+        }
+
+        if (vis.closest_t > empty_distance)
+        {
+            flags |= probe_flag_empty;
+        }
+
+        return flags;
+    }
+
+    pos = origin;
+    return probe_flag_invalid;
+}
+
+void
+push_probe(probe_placement_result& result, const glm::vec3& pos, float radius, uint8_t flags)
+{
+    result.positions.push_back(pos);
+    result.radii.push_back((flags & probe_flag_invalid) ? 0.0f : radius);
+    result.flags.push_back(flags);
+
+    result.relocated_count += (flags & probe_flag_relocated) ? 1 : 0;
+    result.invalid_count += (flags & probe_flag_invalid) ? 1 : 0;
+    result.empty_count += (flags & probe_flag_empty) ? 1 : 0;
+}
+
+struct octree_ctx
+{
+    const bvh_build_result& bvh;
+    const std::vector<glm::vec3>& dirs;
+    const probe_placement_params& params;
+    float empty_distance;
+    probe_placement_result& result;
+    uint32_t dropped = 0;
+};
+
+void
+subdivide_cell(octree_ctx& ctx, const glm::vec3& cell_min, float size, uint32_t level)
+{
+    // Pad by half a cell so cells next to (not only containing) geometry refine
+    glm::vec3 pad(size * 0.5f);
+    glm::vec3 cell_max = cell_min + glm::vec3(size);
+
+    if (level < ctx.params.adaptive_levels && overlaps_box(ctx.bvh, cell_min - pad, cell_max + pad))
+    {
+        float half = size * 0.5f;
+        for (uint32_t c = 0; c < 8; ++c)
+        {
+            glm::vec3 offset((c & 1) ? half : 0.0f, (c & 2) ? half : 0.0f, (c & 4) ? half : 0.0f);
+            subdivide_cell(ctx, cell_min + offset, half, level + 1);
+        }
+        return;
+    }
+
+    glm::vec3 pos = cell_min + glm::vec3(size * 0.5f);
+    uint8_t flags = validate_probe(ctx.bvh, ctx.dirs, ctx.params, size, ctx.empty_distance, pos);
+
+    if (flags & (probe_flag_invalid | probe_flag_empty))
+    {
+        ++ctx.dropped;
+        return;
+    }
+
+    push_probe(ctx.result, pos, size, flags);
+}
+
+}  // namespace
+
 probe_placement_result
 place_probes_grid(const gpu::vertex_data* vertices,
                   uint32_t vertex_count,
@@ -26,63 +237,173 @@ place_probes_grid(const gpu::vertex_data* vertices,
         return result;
     }
 
-    // Compute scene AABB
-    glm::vec3 scene_min(std::numeric_limits<float>::max());
-    glm::vec3 scene_max(std::numeric_limits<float>::lowest());
-
-    for (uint32_t i = 0; i < vertex_count; ++i)
-    {
-        scene_min = glm::min(scene_min, vertices[i].position);
-        scene_max = glm::max(scene_max, vertices[i].position);
-    }
-
-    // Expand by margin
-    scene_min -= glm::vec3(params.margin);
-    scene_max += glm::vec3(params.margin);
+    auto bounds = compute_bounds(vertices, vertex_count, params.margin);
 
     float spacing = params.spacing;
+    glm::uvec3 n = grid_dims(bounds, spacing) + glm::uvec3(1);
 
-    uint32_t nx =
-        std::max(1u, static_cast<uint32_t>(std::ceil((scene_max.x - scene_min.x) / spacing))) + 1;
-    uint32_t ny =
-        std::max(1u, static_cast<uint32_t>(std::ceil((scene_max.y - scene_min.y) / spacing))) + 1;
-    uint32_t nz =
-        std::max(1u, static_cast<uint32_t>(std::ceil((scene_max.z - scene_min.z) / spacing))) + 1;
-
-    result.positions.reserve(nx * ny * nz);
+    result.positions.reserve(n.x * n.y * n.z);
+    result.radii.reserve(n.x * n.y * n.z);
+    result.flags.reserve(n.x * n.y * n.z);
 
-    for (uint32_t z = 0; z < nz; ++z)
+    for (uint32_t z = 0; z < n.z; ++z)
     {
-        for (uint32_t y = 0; y < ny; ++y)
+        for (uint32_t y = 0; y < n.y; ++y)
         {
-            for (uint32_t x = 0; x < nx; ++x)
+            for (uint32_t x = 0; x < n.x; ++x)
             {
-                glm::vec3 pos = scene_min + glm::vec3(x, y, z) * spacing;
-                result.positions.push_back(pos);
+                glm::vec3 pos = bounds.mn + glm::vec3(x, y, z) * spacing;
+                push_probe(result, pos, spacing, probe_flag_none);
             }
         }
     }
 
     // Fill grid config
     auto& gc = result.grid_config;
-    gc.grid_min = scene_min;
-    gc.grid_max = scene_max;
+    gc.grid_min = bounds.mn;
+    gc.grid_max = bounds.mx;
     gc.spacing = spacing;
     gc.probe_count = static_cast<uint32_t>(result.positions.size());
-    gc.grid_size_x = nx;
-    gc.grid_size_y = ny;
-    gc.grid_size_z = nz;
+    gc.grid_size_x = n.x;
+    gc.grid_size_y = n.y;
+    gc.grid_size_z = n.z;
 
     ALOG_INFO("probe_placer: placed {} probes ({}x{}x{}) with spacing {:.1f}",
               result.positions.size(),
-              nx,
-              ny,
-              nz,
+              n.x,
+              n.y,
+              n.z,
               spacing);
 
     return result;
 }
 
+probe_placement_result
+place_probes_validated(const gpu::vertex_data* vertices,
+                       uint32_t vertex_count,
+                       const uint32_t* indices,
+                       uint32_t index_count,
+                       const bvh_build_result& bvh,
+                       const probe_placement_params& params)
+{
+    auto result = place_probes_grid(vertices, vertex_count, indices, index_count, params);
+
+    if (result.positions.empty() || bvh.nodes.empty())
+    {
+        return result;
+    }
+
+    auto dirs = make_validation_dirs(params.validation_rays);
+    float empty_distance = params.empty_distance > 0.0f ? params.empty_distance : params.spacing * 2.0f;
+
+    result.relocated_count = 0;
+    result.invalid_count = 0;
+    result.empty_count = 0;
+
+    for (size_t i = 0; i < result.positions.size(); ++i)
+    {
+        uint8_t flags =
+            validate_probe(bvh, dirs, params, params.spacing, empty_distance, result.positions[i]);
+
+        result.flags[i] = flags;
+        result.radii[i] = (flags & probe_flag_invalid) ? 0.0f : params.spacing;
+
+        result.relocated_count += (flags & probe_flag_relocated) ? 1 : 0;
+        result.invalid_count += (flags & probe_flag_invalid) ? 1 : 0;
+        result.empty_count += (flags & probe_flag_empty) ? 1 : 0;
+    }
+
+    ALOG_INFO("probe_placer: validated {} probes — {} relocated, {} invalid, {} empty",
+              result.positions.size(),
+              result.relocated_count,
+              result.invalid_count,
+              result.empty_count);
+
+    return result;
+}
+
+probe_placement_result
+place_probes_adaptive(const gpu::vertex_data* vertices,
+                      uint32_t vertex_count,
+                      const uint32_t* indices,
+                      uint32_t index_count,
+                      const bvh_build_result& bvh,
+                      const probe_placement_params& params)
+{
+    probe_placement_result result;
+
+    if (vertex_count == 0 || bvh.nodes.empty())
+    {
+        return result;
+    }
+
+    auto bounds = compute_bounds(vertices, vertex_count, params.margin);
+    auto dirs = make_validation_dirs(params.validation_rays);
+    float empty_distance = params.empty_distance > 0.0f ? params.empty_distance : params.spacing * 2.0f;
+
+    float spacing = params.spacing;
+    glm::uvec3 n = grid_dims(bounds, spacing);
+
+    octree_ctx ctx{bvh, dirs, params, empty_distance, result};
+
+    for (uint32_t z = 0; z < n.z; ++z)
+    {
+        for (uint32_t y = 0; y < n.y; ++y)
+        {
+            for (uint32_t x = 0; x < n.x; ++x)
+            {
+                subdivide_cell(ctx, bounds.mn + glm::vec3(x, y, z) * spacing, spacing, 0);
+            }
+        }
+    }
+
+    // Flat list: no grid indexing, consumers use gpu::object_data::probe_index
+    auto& gc = result.grid_config;
+    gc.grid_min = bounds.mn;
+    gc.grid_max = bounds.mx;
+    gc.spacing = spacing / static_cast<float>(1u << params.adaptive_levels);
+    gc.probe_count = static_cast<uint32_t>(result.positions.size());
+    gc.grid_size_x = 0;
+    gc.grid_size_y = 0;
+    gc.grid_size_z = 0;
+
+    ALOG_INFO("probe_placer: adaptive placed {} probes ({} dropped, {} relocated), "
+              "coarse grid {}x{}x{}",
+              result.positions.size(),
+              ctx.dropped,
+              result.relocated_count,
+              n.x,
+              n.y,
+              n.z);
+
+    return result;
+}
+
+uint32_t
+find_probe_index(const probe_placement_result& placement, const glm::vec3& position)
+{
+    uint32_t best = 0xFFFFFFFFu;
+    float best_d2 = 0.0f;
+
+    for (size_t i = 0; i < placement.positions.size(); ++i)
+    {
+        if (i < placement.radii.size() && placement.radii[i] <= 0.0f)
+        {
+            continue;
+        }
+
+        glm::vec3 d = placement.positions[i] - position;
+        float d2 = glm::dot(d, d);
+        if (best == 0xFFFFFFFFu || d2 < best_d2)
+        {
+            best = static_cast<uint32_t>(i);
+            best_d2 = d2;
+        }
+    }
+
+    return best;
+}
+
 }  // namespace bake
 }  // namespace render
 }  // namespace kryga
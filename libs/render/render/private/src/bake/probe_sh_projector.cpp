@@ -0,0 +1,250 @@
+#include "vulkan_render/bake/probe_sh_projector.h"
+
+#include "vulkan_render/bake/bvh_trace.h"
+
+#include <utils/kryga_log.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace kryga
+{
+namespace render
+{
+namespace bake
+{
+
+namespace
+{
+
+// Same hash / sampler as probe_baker.comp so CPU and GPU bakes agree
+uint32_t
+hash(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x45d9f3bu;
+    x ^= x >> 16;
+    x *= 0x45d9f3bu;
+    x ^= x >> 16;
+    return x;
+}
+
+float
+rand_float(uint32_t& seed)
+{
+    seed = hash(seed);
+    return static_cast<float>(seed) / static_cast<float>(0xFFFFFFFFu);
+}
+
+glm::vec3
+uniform_sample_sphere(uint32_t& seed)
+{
+    float u1 = rand_float(seed);
+    float u2 = rand_float(seed);
+
+    float z = 1.0f - 2.0f * u1;
+    float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+    float phi = 2.0f * 3.14159265f * u2;
+
+    return glm::vec3(r * std::cos(phi), r * std::sin(phi), z);
+}
+
+void
+sh_eval(const glm::vec3& d, float basis[9])
+{
+    basis[0] = 0.282095f;
+    basis[1] = 0.488603f * d.y;
+    basis[2] = 0.488603f * d.z;
+    basis[3] = 0.488603f * d.x;
+    basis[4] = 1.092548f * d.x * d.y;
+    basis[5] = 1.092548f * d.y * d.z;
+    basis[6] = 0.315392f * (3.0f * d.z * d.z - 1.0f);
+    basis[7] = 1.092548f * d.x * d.z;
+    basis[8] = 0.546274f * (d.x * d.x - d.y * d.y);
+}
+
+float
+half_to_float(uint16_t h)
+{
+    uint32_t sign = (h >> 15) & 1;
+    uint32_t exp = (h >> 10) & 0x1F;
+    uint32_t mant = h & 0x3FF;
+    if (exp == 0)
+    {
+        return sign ? -0.0f : 0.0f;
+    }
+    if (exp == 31)
+    {
+        return sign ? -INFINITY : INFINITY;
+    }
+    float f = std::ldexp(static_cast<float>(mant | 0x400), static_cast<int>(exp) - 25);
+    return sign ? -f : f;
+}
+
+struct projection_source
+{
+    const bvh_build_result& bvh;
+    const uint16_t* lightmap;
+    uint32_t width;
+    uint32_t height;
+    const probe_projection_params& params;
+};
+
+glm::vec3
+sample_radiance(const projection_source& src, const bvh_hit& hit)
+{
+    if (!hit.is_hit())
+    {
+        return src.params.miss_radiance;
+    }
+
+    if (!src.lightmap)
+    {
+        return glm::vec3(0.0f);
+    }
+
+    const auto& tri = src.bvh.triangles[hit.tri_idx];
+    float w = 1.0f - hit.u - hit.v;
+    glm::vec2 uv = w * tri.lm_uv0 + hit.u * tri.lm_uv1 + hit.v * tri.lm_uv2;
+
+    auto tx = std::clamp(static_cast<int32_t>(uv.x * static_cast<float>(src.width)),
+                         0,
+                         static_cast<int32_t>(src.width) - 1);
+    auto ty = std::clamp(static_cast<int32_t>(uv.y * static_cast<float>(src.height)),
+                         0,
+                         static_cast<int32_t>(src.height) - 1);
+
+    const uint16_t* texel = src.lightmap + (static_cast<size_t>(ty) * src.width + tx) * 4;
+    return glm::vec3(half_to_float(texel[0]), half_to_float(texel[1]), half_to_float(texel[2]));
+}
+
+gpu::sh_probe
+project_probe(const projection_source& src, uint32_t probe_idx, const glm::vec3& pos, float radius)
+{
+    gpu::sh_probe probe{};
+    probe.position = pos;
+    probe.radius = radius;
+
+    if (radius <= 0.0f)
+    {
+        return probe;
+    }
+
+    float sh_r[9] = {}, sh_g[9] = {}, sh_b[9] = {};
+
+    uint32_t seed = hash(probe_idx * 12347u + 91813u);
+    uint32_t num_samples = std::max(src.params.sample_count, 1u);
+
+    for (uint32_t s = 0; s < num_samples; ++s)
+    {
+        glm::vec3 dir = uniform_sample_sphere(seed);
+        auto hit = trace_ray(src.bvh, pos, dir, src.params.max_distance);
+        glm::vec3 radiance = sample_radiance(src, hit);
+
+        float basis[9];
+        sh_eval(dir, basis);
+
+        for (int i = 0; i < 9; ++i)
+        {
+            sh_r[i] += radiance.r * basis[i];
+            sh_g[i] += radiance.g * basis[i];
+            sh_b[i] += radiance.b * basis[i];
+        }
+    }
+
+    float weight = 4.0f * 3.14159265f / static_cast<float>(num_samples);
+
+    // R[0..8], G[0..8], B[0..8] -> 27 floats -> 7 vec4s
+    float coeffs[28] = {};
+    for (int i = 0; i < 9; ++i)
+    {
+        coeffs[i] = sh_r[i] * weight;
+        coeffs[9 + i] = sh_g[i] * weight;
+        coeffs[18 + i] = sh_b[i] * weight;
+    }
+
+    for (int i = 0; i < 7; ++i)
+    {
+        probe.coefficients[i] = glm::vec4(
+            coeffs[i * 4 + 0], coeffs[i * 4 + 1], coeffs[i * 4 + 2], coeffs[i * 4 + 3]);
+    }
+
+    return probe;
+}
+
+}  // namespace
+
+std::vector<gpu::sh_probe>
+project_probes_sh(const bvh_build_result& bvh,
+                  const uint16_t* lightmap_rgba16f,
+                  uint32_t atlas_width,
+                  uint32_t atlas_height,
+                  const probe_placement_result& placement,
+                  const probe_projection_params& params)
+{
+    const size_t count = placement.positions.size();
+    std::vector<gpu::sh_probe> probes(count);
+
+    if (count == 0)
+    {
+        return probes;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    projection_source src{bvh, lightmap_rgba16f, atlas_width, atlas_height, params};
+
+    uint32_t jobs_n = params.thread_count > 0
+                          ? params.thread_count
+                          : std::max(1u, std::thread::hardware_concurrency() - 1);
+    jobs_n = std::min<uint32_t>(jobs_n, static_cast<uint32_t>(count));
+
+    // Probes are independent; hand them out one at a time so uneven ray costs
+    // (probes near dense geometry) balance across workers.
+    std::atomic<size_t> next_idx{0};
+
+    auto worker = [&]()
+    {
+        while (true)
+        {
+            size_t idx = next_idx.fetch_add(1);
+            if (idx >= count)
+            {
+                return;
+            }
+            float radius = idx < placement.radii.size() ? placement.radii[idx] : 1.0f;
+            probes[idx] = project_probe(
+                src, static_cast<uint32_t>(idx), placement.positions[idx], radius);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(jobs_n);
+    for (uint32_t i = 0; i < jobs_n; ++i)
+    {
+        pool.emplace_back(worker);
+    }
+    for (auto& t : pool)
+    {
+        t.join();
+    }
+
+    auto elapsed = std::chrono::duration<float, std::milli>(
+                       std::chrono::high_resolution_clock::now() - start)
+                       .count();
+
+    ALOG_INFO("probe_sh_projector: projected {} probes x {} samples on {} threads in {:.1f} ms",
+              count,
+              params.sample_count,
+              jobs_n,
+              elapsed);
+
+    return probes;
+}
+
+}  // namespace bake
+}  // namespace render
+}  // namespace kryga
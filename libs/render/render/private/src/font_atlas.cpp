@@ -0,0 +1,393 @@
+#include "vulkan_render/font_atlas.h"
+
+#include <utils/kryga_log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace kryga::render
+{
+
+namespace
+{
+
+const glyph_metrics k_empty_glyph{};
+
+}  // namespace
+
+uint32_t
+decode_utf8(const std::string_view& s, size_t& pos)
+{
+    constexpr uint32_t k_replacement = 0xFFFD;
+
+    const auto lead = static_cast<uint8_t>(s[pos++]);
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+
+    uint32_t cp = 0;
+    uint32_t extra = 0;
+    if ((lead & 0xE0) == 0xC0)
+    {
+        cp = lead & 0x1F;
+        extra = 1;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        cp = lead & 0x0F;
+        extra = 2;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        cp = lead & 0x07;
+        extra = 3;
+    }
+    else
+    {
+        return k_replacement;
+    }
+
+    for (uint32_t i = 0; i < extra; ++i)
+    {
+        if (pos >= s.size() || (static_cast<uint8_t>(s[pos]) & 0xC0) != 0x80)
+        {
+            return k_replacement;
+        }
+        cp = (cp << 6) | (static_cast<uint8_t>(s[pos++]) & 0x3F);
+    }
+
+    // Overlong forms, surrogates and out-of-range values are not characters
+    constexpr uint32_t k_min_for_len[4] = {0, 0x80, 0x800, 0x10000};
+    if (cp < k_min_for_len[extra] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+    {
+        return k_replacement;
+    }
+    return cp;
+}
+
+font_atlas::font_atlas(std::unique_ptr<glyph_source> source,
+                       float bake_height,
+                       float ascent,
+                       float line_height,
+                       bool async)
+    : m_source(std::move(source))
+    , m_bake_height(bake_height)
+    , m_ascent(ascent)
+    , m_line_height(line_height)
+    , m_async(async)
+{
+    if (m_async)
+    {
+        m_worker = std::thread([this]() { worker_loop(); });
+    }
+}
+
+font_atlas::~font_atlas()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+}
+
+font_atlas::entry*
+font_atlas::find_or_create(uint32_t codepoint)
+{
+    auto itr = m_entries.find(codepoint);
+    if (itr != m_entries.end())
+    {
+        return &itr->second;
+    }
+
+    entry e;
+    if (!m_source->metrics(codepoint, e.metrics))
+    {
+        if (codepoint == k_fallback_codepoint || !find_or_create(k_fallback_codepoint))
+        {
+            return nullptr;
+        }
+        e.metrics = {};
+        e.alias = k_fallback_codepoint;
+    }
+
+    // unordered_map nodes are stable, so the pointer survives later inserts
+    return &m_entries.emplace(codepoint, e).first->second;
+}
+
+const glyph_metrics&
+font_atlas::acquire(uint32_t codepoint)
+{
+    uint32_t key = codepoint;
+    entry* e = find_or_create(key);
+    if (e && e->alias != k_invalid)
+    {
+        key = e->alias;
+        e = find_or_create(key);
+    }
+    if (!e)
+    {
+        return k_empty_glyph;
+    }
+
+    ++e->pins;
+    e->last_used = m_clock;
+
+    const bool has_ink = e->metrics.size.x > 0.f && e->metrics.size.y > 0.f;
+    if (has_ink && !e->no_ink && e->cell == k_invalid && !e->requested)
+    {
+        e->requested = true;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_requests.push_back(key);
+        }
+        m_cv.notify_one();
+    }
+
+    return e->metrics;
+}
+
+void
+font_atlas::release(uint32_t codepoint)
+{
+    auto itr = m_entries.find(codepoint);
+    if (itr == m_entries.end())
+    {
+        return;
+    }
+
+    entry* e = &itr->second;
+    if (e->alias != k_invalid)
+    {
+        auto fallback = m_entries.find(e->alias);
+        if (fallback == m_entries.end())
+        {
+            return;
+        }
+        e = &fallback->second;
+    }
+
+    if (e->pins > 0 && --e->pins == 0 && e->cell != k_invalid)
+    {
+        m_unpinned = true;
+    }
+    e->last_used = m_clock;
+}
+
+const glyph_metrics&
+font_atlas::peek(uint32_t codepoint) const
+{
+    auto itr = m_entries.find(codepoint);
+    if (itr != m_entries.end() && itr->second.alias != k_invalid)
+    {
+        itr = m_entries.find(itr->second.alias);
+    }
+    return itr != m_entries.end() ? itr->second.metrics : k_empty_glyph;
+}
+
+void
+font_atlas::worker_loop()
+{
+    while (true)
+    {
+        uint32_t codepoint = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || !m_requests.empty(); });
+            if (m_stop)
+            {
+                return;
+            }
+            codepoint = m_requests.front();
+            m_requests.pop_front();
+        }
+
+        glyph_bitmap bmp;
+        if (!m_source->rasterize(codepoint, bmp))
+        {
+            bmp = {};
+        }
+        bmp.codepoint = codepoint;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done.push_back(std::move(bmp));
+    }
+}
+
+bool
+font_atlas::pump()
+{
+    ++m_clock;
+
+    std::vector<glyph_bitmap> done;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_async)
+        {
+            for (uint32_t codepoint : m_requests)
+            {
+                glyph_bitmap bmp;
+                if (!m_source->rasterize(codepoint, bmp))
+                {
+                    bmp = {};
+                }
+                bmp.codepoint = codepoint;
+                m_done.push_back(std::move(bmp));
+            }
+            m_requests.clear();
+        }
+        done.swap(m_done);
+    }
+
+    // Parked glyphs only get another go once a cell can be evicted again
+    const size_t fresh = done.size();
+    if (m_unpinned)
+    {
+        m_unpinned = false;
+        std::move(m_parked.begin(), m_parked.end(), std::back_inserter(done));
+        m_parked.clear();
+    }
+
+    bool changed = false;
+
+    for (size_t i = 0; i < done.size(); ++i)
+    {
+        auto& bmp = done[i];
+        auto itr = m_entries.find(bmp.codepoint);
+        if (itr == m_entries.end())
+        {
+            continue;
+        }
+
+        entry& e = itr->second;
+        if (bmp.pixels.empty())
+        {
+            e.requested = false;
+            e.no_ink = true;
+            continue;
+        }
+        if (e.cell != k_invalid)
+        {
+            e.requested = false;
+            continue;
+        }
+
+        uint32_t cell = alloc_cell();
+        if (cell == k_invalid)
+        {
+            if (i < fresh)
+            {
+                ALOG_WARN("font_atlas: all {} cells pinned, glyph U+{:04X} waits for one",
+                          k_max_pages * k_cells_per_page,
+                          bmp.codepoint);
+            }
+            m_parked.push_back(std::move(bmp));
+            continue;
+        }
+
+        e.requested = false;
+        place(e, cell, bmp);
+        m_cell_owner[cell] = bmp.codepoint;
+        ++m_resident;
+        changed = true;
+    }
+
+    if (changed)
+    {
+        ++m_revision;
+    }
+    return changed;
+}
+
+uint32_t
+font_atlas::alloc_cell()
+{
+    if (m_free_cells.empty() && m_pages.size() < k_max_pages)
+    {
+        const auto page_idx = static_cast<uint32_t>(m_pages.size());
+        page& p = m_pages.emplace_back();
+        p.pixels.assign(static_cast<size_t>(k_page_size) * k_page_size, 0);
+        p.dirty = true;
+
+        m_cell_owner.resize(m_cell_owner.size() + k_cells_per_page, k_invalid);
+        for (uint32_t i = k_cells_per_page; i-- > 0;)
+        {
+            m_free_cells.push_back(page_idx * k_cells_per_page + i);
+        }
+    }
+
+    if (!m_free_cells.empty())
+    {
+        uint32_t cell = m_free_cells.back();
+        m_free_cells.pop_back();
+        return cell;
+    }
+
+    // Pages full: evict the least recently used glyph no live layout references
+    entry* victim = nullptr;
+    uint32_t victim_cell = k_invalid;
+    for (uint32_t cell = 0; cell < m_cell_owner.size(); ++cell)
+    {
+        auto itr = m_entries.find(m_cell_owner[cell]);
+        if (itr == m_entries.end() || itr->second.pins != 0)
+        {
+            continue;
+        }
+        if (!victim || itr->second.last_used < victim->last_used)
+        {
+            victim = &itr->second;
+            victim_cell = cell;
+        }
+    }
+
+    if (!victim)
+    {
+        return k_invalid;
+    }
+
+    victim->cell = k_invalid;
+    victim->metrics.page = glyph_metrics::k_no_page;
+    m_cell_owner[victim_cell] = k_invalid;
+    --m_resident;
+    return victim_cell;
+}
+
+void
+font_atlas::place(entry& e, uint32_t cell, const glyph_bitmap& bmp)
+{
+    const uint32_t page_idx = cell / k_cells_per_page;
+    const uint32_t local = cell % k_cells_per_page;
+    const uint32_t cx = (local % k_cells_per_row) * k_cell_size;
+    const uint32_t cy = (local / k_cells_per_row) * k_cell_size;
+
+    // Oversized glyphs are clipped to the cell; the quad shrinks to match
+    const uint32_t w = std::min(bmp.width, k_cell_size);
+    const uint32_t h = std::min(bmp.height, k_cell_size);
+
+    page& p = m_pages[page_idx];
+    for (uint32_t y = 0; y < k_cell_size; ++y)
+    {
+        uint8_t* dst = p.pixels.data() + static_cast<size_t>(cy + y) * k_page_size + cx;
+        std::memset(dst, 0, k_cell_size);
+        if (y < h)
+        {
+            std::memcpy(dst, bmp.pixels.data() + static_cast<size_t>(y) * bmp.width, w);
+        }
+    }
+    p.dirty = true;
+
+    const float inv = 1.f / static_cast<float>(k_page_size);
+    e.cell = cell;
+    e.metrics.page = page_idx;
+    e.metrics.size = glm::vec2(static_cast<float>(w), static_cast<float>(h));
+    e.metrics.uv0 = glm::vec2(static_cast<float>(cx), static_cast<float>(cy)) * inv;
+    e.metrics.uv1 = glm::vec2(static_cast<float>(cx + w), static_cast<float>(cy + h)) * inv;
+}
+
+}  // namespace kryga::render
@@ -0,0 +1,389 @@
+#include "vulkan_render/frame_readback.h"
+
+#include "vulkan_render/vulkan_render_device.h"
+#include "vulkan_render/utils/vulkan_image.h"
+#include "vulkan_render/utils/vulkan_initializers.h"
+
+#include <utils/check.h>
+#include <utils/kryga_log.h>
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace kryga::render
+{
+
+namespace
+{
+
+bool
+is_bgra8(VkFormat f)
+{
+    return f == VK_FORMAT_B8G8R8A8_UNORM || f == VK_FORMAT_B8G8R8A8_SRGB;
+}
+
+bool
+is_rgba8(VkFormat f)
+{
+    return f == VK_FORMAT_R8G8B8A8_UNORM || f == VK_FORMAT_R8G8B8A8_SRGB;
+}
+
+}  // namespace
+
+// --- readback_frame ---
+
+readback_frame::~readback_frame()
+{
+    release();
+}
+
+readback_frame::readback_frame(readback_frame&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+readback_frame&
+readback_frame::operator=(readback_frame&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        width = other.width;
+        height = other.height;
+        row_pitch = other.row_pitch;
+        region_x = other.region_x;
+        region_y = other.region_y;
+        bgra = other.bgra;
+        sequence = other.sequence;
+        m_owner = std::exchange(other.m_owner, nullptr);
+        m_slot = other.m_slot;
+        m_data = std::exchange(other.m_data, nullptr);
+    }
+    return *this;
+}
+
+void
+readback_frame::release()
+{
+    if (m_owner)
+    {
+        m_owner->release_slot(m_slot);
+        m_owner = nullptr;
+        m_data = nullptr;
+    }
+}
+
+// --- frame_readback ---
+
+frame_readback::~frame_readback()
+{
+    deinit();
+}
+
+void
+frame_readback::init(render_device& device, uint32_t slots)
+{
+    m_device = &device;
+    m_slot_count = std::clamp(slots, 1u, k_max_slots);
+}
+
+void
+frame_readback::deinit()
+{
+    if (!m_device)
+    {
+        return;
+    }
+
+    for (auto& s : m_slots)
+    {
+        KRG_check(s.state.load() != slot_state::held,
+                  "frame_readback::deinit with a readback_frame still alive");
+        if (s.mapped)
+        {
+            vmaUnmapMemory(m_device->allocator(), s.buffer.allocation());
+            s.mapped = nullptr;
+        }
+        s.buffer = vk_utils::vulkan_buffer{};
+        s.state.store(slot_state::free);
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_requests.clear();
+    m_active.store(0);
+    m_device = nullptr;
+}
+
+uint64_t
+frame_readback::request(const readback_region& region, uint32_t count, readback_callback cb)
+{
+    std::lock_guard lock(m_mutex);
+
+    request_state r;
+    r.id = m_next_id++;
+    r.region = region;
+    r.to_record = count;
+    r.unbounded = count == 0;
+    r.cb = std::move(cb);
+    m_requests.push_back(std::move(r));
+
+    m_active.store(static_cast<uint32_t>(m_requests.size()), std::memory_order_relaxed);
+    return m_requests.back().id;
+}
+
+void
+frame_readback::cancel(uint64_t id)
+{
+    std::lock_guard lock(m_mutex);
+    if (auto* r = find(id))
+    {
+        r->cancelled = true;
+        prune();
+    }
+}
+
+frame_readback::request_state*
+frame_readback::find(uint64_t id)
+{
+    auto it = std::find_if(
+        m_requests.begin(), m_requests.end(), [id](const auto& r) { return r.id == id; });
+    return it == m_requests.end() ? nullptr : &*it;
+}
+
+void
+frame_readback::prune()
+{
+    std::erase_if(m_requests,
+                  [](const request_state& r)
+                  {
+                      const bool exhausted = r.cancelled || (!r.unbounded && r.to_record == 0);
+                      return exhausted && (r.cancelled || r.in_flight == 0);
+                  });
+    m_active.store(static_cast<uint32_t>(m_requests.size()), std::memory_order_relaxed);
+}
+
+frame_readback::slot*
+frame_readback::acquire_slot(VkDeviceSize size)
+{
+    for (uint32_t i = 0; i < m_slot_count; ++i)
+    {
+        auto& s = m_slots[i];
+        if (s.state.load(std::memory_order_acquire) != slot_state::free)
+        {
+            continue;
+        }
+
+        if (s.buffer.get_alloc_size() < size)
+        {
+            if (s.mapped)
+            {
+                vmaUnmapMemory(m_device->allocator(), s.buffer.allocation());
+                s.mapped = nullptr;
+            }
+            // Freeing is safe: a free slot has no copy in flight
+            s.buffer = m_device->create_buffer(size,
+                                               VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                               VMA_MEMORY_USAGE_GPU_TO_CPU,
+                                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                                               "frame_readback");
+            void* mapped = nullptr;
+            VK_CHECK(vmaMapMemory(m_device->allocator(), s.buffer.allocation(), &mapped));
+            s.mapped = static_cast<uint8_t*>(mapped);
+        }
+        return &s;
+    }
+    return nullptr;
+}
+
+void
+frame_readback::release_slot(uint32_t index)
+{
+    m_slots[index].state.store(slot_state::free, std::memory_order_release);
+}
+
+void
+frame_readback::record(VkCommandBuffer cmd,
+                       VkImage src,
+                       VkImageLayout src_layout,
+                       VkFormat format,
+                       uint32_t width,
+                       uint32_t height,
+                       VkFence frame_fence)
+{
+    if (!has_requests() || !m_device)
+    {
+        return;
+    }
+    ZoneScopedN("Render::FrameReadback");
+
+    if (!is_bgra8(format) && !is_rgba8(format))
+    {
+        ALOG_WARN("frame_readback: unsupported source format {}", (int)format);
+        return;
+    }
+
+    std::lock_guard lock(m_mutex);
+
+    const VkImageSubresourceRange range{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    bool transitioned = false;
+
+    for (auto& r : m_requests)
+    {
+        if (r.cancelled || (!r.unbounded && r.to_record == 0))
+        {
+            continue;
+        }
+
+        // At least one pixel, inside the image
+        const uint32_t x = std::min(r.region.x, width - 1);
+        const uint32_t y = std::min(r.region.y, height - 1);
+        const uint32_t w = std::max(1u, std::min(r.region.w ? r.region.w : width, width - x));
+        const uint32_t h = std::max(1u, std::min(r.region.h ? r.region.h : height, height - y));
+
+        slot* s = acquire_slot(VkDeviceSize(w) * h * 4);
+        if (!s)
+        {
+            // Skipped, not queued: a stream sees a sequence gap, a single
+            // capture just lands a frame later
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (!transitioned)
+        {
+            vk_utils::make_insert_image_memory_barrier(
+                cmd,
+                src,
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                VK_ACCESS_TRANSFER_READ_BIT,
+                src_layout,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                range);
+            transitioned = true;
+        }
+
+        VkBufferImageCopy copy{};
+        copy.bufferOffset = 0;
+        copy.bufferRowLength = 0;  // tightly packed
+        copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        copy.imageOffset = {int32_t(x), int32_t(y), 0};
+        copy.imageExtent = {w, h, 1};
+        vkCmdCopyImageToBuffer(
+            cmd, src, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, s->buffer.buffer(), 1, &copy);
+
+        s->fence = frame_fence;
+        s->request = r.id;
+        s->x = x;
+        s->y = y;
+        s->w = w;
+        s->h = h;
+        s->bgra = is_bgra8(format);
+        s->state.store(slot_state::in_flight, std::memory_order_relaxed);
+
+        ++r.in_flight;
+        if (!r.unbounded)
+        {
+            --r.to_record;
+        }
+    }
+
+    if (!transitioned)
+    {
+        return;
+    }
+
+    // Copies visible to the host once the frame fence signals
+    VkMemoryBarrier host{};
+    host.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    host.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    host.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(cmd,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_HOST_BIT,
+                         0,
+                         1,
+                         &host,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    const bool present = src_layout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    vk_utils::make_insert_image_memory_barrier(
+        cmd,
+        src,
+        VK_ACCESS_TRANSFER_READ_BIT,
+        present ? 0 : VK_ACCESS_TRANSFER_READ_BIT,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        src_layout,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        present ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_TRANSFER_BIT,
+        range);
+}
+
+void
+frame_readback::poll()
+{
+    if (!m_device)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < m_slot_count; ++i)
+    {
+        auto& s = m_slots[i];
+        if (s.state.load(std::memory_order_relaxed) != slot_state::in_flight ||
+            vkGetFenceStatus(m_device->vk_device(), s.fence) != VK_SUCCESS)
+        {
+            continue;
+        }
+
+        readback_callback cb;
+        readback_frame frame;
+        const uint64_t id = s.request;
+        {
+            std::lock_guard lock(m_mutex);
+            auto* r = find(s.request);
+            if (r)
+            {
+                --r->in_flight;
+            }
+            if (!r || r->cancelled)
+            {
+                s.state.store(slot_state::free, std::memory_order_relaxed);
+                prune();
+                continue;
+            }
+
+            vmaInvalidateAllocation(
+                m_device->allocator(), s.buffer.allocation(), 0, VK_WHOLE_SIZE);
+            s.state.store(slot_state::held, std::memory_order_relaxed);
+
+            frame.width = s.w;
+            frame.height = s.h;
+            frame.row_pitch = s.w * 4;
+            frame.region_x = s.x;
+            frame.region_y = s.y;
+            frame.bgra = s.bgra;
+            frame.sequence = r->delivered++;
+            frame.m_owner = this;
+            frame.m_slot = i;
+            frame.m_data = s.mapped;
+
+            cb = r->cb;
+            prune();
+        }
+
+        // Outside the lock: the callback may cancel or issue new requests
+        if (!cb(std::move(frame)))
+        {
+            cancel(id);
+        }
+    }
+}
+
+}  // namespace kryga::render
@@ -0,0 +1,421 @@
+#include "vulkan_render/frame_telemetry.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <format>
+
+namespace kryga::render
+{
+
+uint32_t
+frame_histogram::bucket_of(uint64_t us)
+{
+    us = std::min(us, k_max_value);
+    if (us < k_sub_buckets)
+    {
+        return static_cast<uint32_t>(us);
+    }
+
+    // Keep the top k_sub_bits - 1 bits below the leading one
+    const uint32_t shift = static_cast<uint32_t>(std::bit_width(us)) - k_sub_bits;
+    return k_sub_buckets + (shift - 1) * k_half + static_cast<uint32_t>((us >> shift) - k_half);
+}
+
+uint64_t
+frame_histogram::bucket_upper(uint32_t index)
+{
+    if (index < k_sub_buckets)
+    {
+        return index;
+    }
+
+    const uint32_t j = index - k_sub_buckets;
+    const uint32_t shift = j / k_half + 1;
+    const uint64_t mantissa = j % k_half + k_half;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void
+frame_histogram::record(uint64_t us)
+{
+    m_buckets[bucket_of(us)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(us, std::memory_order_relaxed);
+    if (us > m_max.load(std::memory_order_relaxed))
+    {
+        m_max.store(us, std::memory_order_relaxed);
+    }
+    m_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+frame_histogram::reset()
+{
+    for (auto& b : m_buckets)
+    {
+        b.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+double
+frame_histogram::mean() const
+{
+    const uint64_t n = count();
+    return n ? static_cast<double>(m_sum.load(std::memory_order_relaxed)) / n : 0.0;
+}
+
+uint64_t
+frame_histogram::percentile(double q) const
+{
+    // Walk the buckets rather than trust m_count, which a concurrent record may
+    // have bumped before or after its bucket
+    uint64_t total = 0;
+    for (const auto& b : m_buckets)
+    {
+        total += b.load(std::memory_order_relaxed);
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * total)));
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < k_bucket_count; ++i)
+    {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return std::min(bucket_upper(i), max());
+        }
+    }
+    return max();
+}
+
+const char*
+to_string(frame_stamp s)
+{
+    switch (s)
+    {
+    case frame_stamp::begin_frame:
+        return "begin_frame";
+    case frame_stamp::submit_frame:
+        return "submit_frame";
+    case frame_stamp::drain_begin:
+        return "drain_begin";
+    case frame_stamp::drain_end:
+        return "drain_end";
+    case frame_stamp::acquire:
+        return "acquire";
+    case frame_stamp::gpu_submit:
+        return "gpu_submit";
+    case frame_stamp::present:
+        return "present";
+    default:
+        return "unknown";
+    }
+}
+
+const char*
+to_string(frame_gate g)
+{
+    switch (g)
+    {
+    case frame_gate::pipeline:
+        return "pipeline";
+    case frame_gate::render_idle:
+        return "render_idle";
+    case frame_gate::present_pacing:
+        return "present_pacing";
+    case frame_gate::frame_fence:
+        return "frame_fence";
+    case frame_gate::acquire:
+        return "acquire";
+    case frame_gate::image_fence:
+        return "image_fence";
+    default:
+        return "unknown";
+    }
+}
+
+const char*
+to_string(frame_metric m)
+{
+    switch (m)
+    {
+    case frame_metric::interval:
+        return "interval";
+    case frame_metric::latency:
+        return "latency";
+    case frame_metric::build:
+        return "build";
+    case frame_metric::render:
+        return "render";
+    default:
+        return "unknown";
+    }
+}
+
+uint64_t
+frame_record::end_us() const
+{
+    for (uint32_t i = k_frame_stamp_count; i-- > static_cast<uint32_t>(frame_stamp::drain_begin);)
+    {
+        if (stamp_us[i])
+        {
+            return stamp_us[i];
+        }
+    }
+    return 0;
+}
+
+frame_telemetry::frame_telemetry()
+    : m_epoch_us(now_us())
+    , m_slots(k_ring)
+{
+}
+
+uint64_t
+frame_telemetry::now_us()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+uint64_t
+frame_telemetry::open_frame()
+{
+    const uint64_t frame = m_opened++;
+    auto& s = slot_of(frame);
+
+    // Seqlock write side: invalidate, then rewrite. Readers that copied the old
+    // frame see seq change and drop it.
+    s.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (auto& t : s.stamp_us)
+    {
+        t.store(0, std::memory_order_relaxed);
+    }
+    for (auto& w : s.wait_us)
+    {
+        w.store(0, std::memory_order_relaxed);
+    }
+    s.interval_us.store(0, std::memory_order_relaxed);
+
+    stamp(frame, frame_stamp::begin_frame);
+    return frame;
+}
+
+uint64_t
+frame_telemetry::begin_render_frame()
+{
+    m_render_frame = m_render_next++;
+    return m_render_frame;
+}
+
+void
+frame_telemetry::stamp(uint64_t frame, frame_stamp s)
+{
+    stamp(frame, s, now_us());
+}
+
+void
+frame_telemetry::stamp(uint64_t frame, frame_stamp s, uint64_t at_us)
+{
+    // +1 keeps a stamp taken in the epoch's own microsecond distinct from "not reached"
+    const uint64_t rel = at_us > m_epoch_us ? at_us - m_epoch_us + 1 : 1;
+    slot_of(frame).stamp_us[static_cast<uint32_t>(s)].store(rel, std::memory_order_relaxed);
+}
+
+void
+frame_telemetry::add_wait(uint64_t frame, frame_gate g, uint64_t us)
+{
+    auto& w = slot_of(frame).wait_us[static_cast<uint32_t>(g)];
+    const uint64_t sum = w.load(std::memory_order_relaxed) + us;
+    w.store(static_cast<uint32_t>(std::min<uint64_t>(sum, UINT32_MAX)), std::memory_order_relaxed);
+}
+
+void
+frame_telemetry::commit(uint64_t frame)
+{
+    if (m_reset_requested.exchange(false, std::memory_order_relaxed))
+    {
+        reset_statistics();
+    }
+
+    auto& s = slot_of(frame);
+
+    frame_record r;
+    for (uint32_t i = 0; i < k_frame_stamp_count; ++i)
+    {
+        r.stamp_us[i] = s.stamp_us[i].load(std::memory_order_relaxed);
+    }
+    for (uint32_t i = 0; i < k_frame_gate_count; ++i)
+    {
+        r.wait_us[i] = s.wait_us[i].load(std::memory_order_relaxed);
+    }
+
+    const auto at = [&](frame_stamp st) { return r.stamp_us[static_cast<uint32_t>(st)]; };
+    const auto span = [](uint64_t from, uint64_t to) { return to > from ? to - from : 0; };
+
+    const uint64_t end = r.end_us();
+    if (m_last_end_us && end)
+    {
+        r.interval_us = static_cast<uint32_t>(span(m_last_end_us, end));
+        m_histograms[static_cast<uint32_t>(frame_metric::interval)].record(r.interval_us);
+    }
+    m_last_end_us = end ? end : m_last_end_us;
+
+    if (at(frame_stamp::begin_frame) && end)
+    {
+        m_histograms[static_cast<uint32_t>(frame_metric::latency)].record(
+            span(at(frame_stamp::begin_frame), end));
+    }
+    if (at(frame_stamp::begin_frame) && at(frame_stamp::submit_frame))
+    {
+        const uint64_t build =
+            span(at(frame_stamp::begin_frame), at(frame_stamp::submit_frame));
+        const uint64_t gated = r.wait_us[static_cast<uint32_t>(frame_gate::pipeline)];
+        m_histograms[static_cast<uint32_t>(frame_metric::build)].record(span(gated, build));
+    }
+    if (at(frame_stamp::drain_begin) && end)
+    {
+        m_histograms[static_cast<uint32_t>(frame_metric::render)].record(
+            span(at(frame_stamp::drain_begin), end));
+    }
+
+    // Stall attribution: the longest wait, if long enough to matter
+    uint32_t worst = k_frame_gate_count;
+    uint32_t worst_us = k_stall_us - 1;
+    for (uint32_t i = 0; i < k_frame_gate_count; ++i)
+    {
+        auto& g = m_gates[i];
+        const uint32_t w = r.wait_us[i];
+        g.total_us.store(g.total_us.load(std::memory_order_relaxed) + w,
+                         std::memory_order_relaxed);
+        if (w > g.max_us.load(std::memory_order_relaxed))
+        {
+            g.max_us.store(w, std::memory_order_relaxed);
+        }
+        if (w > worst_us)
+        {
+            worst = i;
+            worst_us = w;
+        }
+    }
+    if (worst != k_frame_gate_count)
+    {
+        auto& d = m_gates[worst].dominant_frames;
+        d.store(d.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    s.interval_us.store(r.interval_us, std::memory_order_relaxed);
+    s.seq.store(frame + 1, std::memory_order_release);
+    m_committed.store(frame + 1, std::memory_order_release);
+}
+
+void
+frame_telemetry::reset_statistics()
+{
+    for (auto& h : m_histograms)
+    {
+        h.reset();
+    }
+    for (auto& g : m_gates)
+    {
+        g.total_us.store(0, std::memory_order_relaxed);
+        g.max_us.store(0, std::memory_order_relaxed);
+        g.dominant_frames.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::vector<frame_record>
+frame_telemetry::read(uint64_t since, uint32_t max) const
+{
+    const uint64_t last = committed();
+    const uint64_t first = std::max(since, last > k_ring ? last - k_ring : 0);
+
+    std::vector<frame_record> out;
+    for (uint64_t f = first; f < last && out.size() < max; ++f)
+    {
+        const auto& s = m_slots[f % k_ring];
+
+        const uint64_t seq = s.seq.load(std::memory_order_acquire);
+        if (seq != f + 1)
+        {
+            continue;
+        }
+
+        frame_record r;
+        r.frame = f;
+        for (uint32_t i = 0; i < k_frame_stamp_count; ++i)
+        {
+            r.stamp_us[i] = s.stamp_us[i].load(std::memory_order_relaxed);
+        }
+        for (uint32_t i = 0; i < k_frame_gate_count; ++i)
+        {
+            r.wait_us[i] = s.wait_us[i].load(std::memory_order_relaxed);
+        }
+        r.interval_us = s.interval_us.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.seq.load(std::memory_order_relaxed) != seq)
+        {
+            continue;
+        }
+        out.push_back(r);
+    }
+    return out;
+}
+
+frame_gate_stats
+frame_telemetry::gate(frame_gate g) const
+{
+    const auto& c = m_gates[static_cast<uint32_t>(g)];
+    frame_gate_stats s;
+    s.total_us = c.total_us.load(std::memory_order_relaxed);
+    s.max_us = c.max_us.load(std::memory_order_relaxed);
+    s.dominant_frames = c.dominant_frames.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::string
+frame_telemetry::to_csv(const std::vector<frame_record>& records)
+{
+    std::string out = "frame";
+    for (uint32_t i = 0; i < k_frame_stamp_count; ++i)
+    {
+        out += std::format(",{}_us", to_string(static_cast<frame_stamp>(i)));
+    }
+    for (uint32_t i = 0; i < k_frame_gate_count; ++i)
+    {
+        out += std::format(",wait_{}_us", to_string(static_cast<frame_gate>(i)));
+    }
+    out += ",interval_us\n";
+
+    for (const auto& r : records)
+    {
+        out += std::to_string(r.frame);
+        for (auto t : r.stamp_us)
+        {
+            out += ',';
+            out += std::to_string(t);
+        }
+        for (auto w : r.wait_us)
+        {
+            out += ',';
+            out += std::to_string(w);
+        }
+        out += std::format(",{}\n", r.interval_us);
+    }
+    return out;
+}
+
+}  // namespace kryga::render
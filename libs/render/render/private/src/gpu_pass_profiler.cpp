@@ -0,0 +1,451 @@
+#include "vulkan_render/gpu_pass_profiler.h"
+
+#include "vulkan_render/vulkan_render_device.h"
+#include "vulkan_render/utils/vulkan_initializers.h"
+
+#include <utils/check.h>
+#include <utils/kryga_log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef TRACY_ENABLE
+#include <tracy/TracyVulkan.hpp>
+#endif
+
+namespace kryga::render
+{
+
+static_assert(gpu_pass_profiler::k_max_slots >= FRAMES_IN_FLIGHT_MAX);
+
+namespace
+{
+
+// Result order follows bit order: IA prims, VS, clipping prims, FS, CS
+constexpr VkQueryPipelineStatisticFlags k_statistic_flags =
+    VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+constexpr uint32_t k_statistic_count = 5;
+
+constexpr VkQueryResultFlags k_result_flags =
+    VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+
+VkQueryPool
+create_pool(VkDevice device, VkQueryType type, uint32_t count, VkQueryPipelineStatisticFlags stats)
+{
+    VkQueryPoolCreateInfo ci{};
+    ci.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    ci.queryType = type;
+    ci.queryCount = count;
+    ci.pipelineStatistics = stats;
+
+    VkQueryPool pool = VK_NULL_HANDLE;
+    if (vkCreateQueryPool(device, &ci, nullptr, &pool) != VK_SUCCESS)
+    {
+        return VK_NULL_HANDLE;
+    }
+    return pool;
+}
+
+}  // namespace
+
+// ============================================================================
+// gpu_timing_window
+// ============================================================================
+
+void
+gpu_timing_window::add(float ms)
+{
+    m_samples[m_head] = ms;
+    m_head = (m_head + 1) % k_size;
+    m_count = std::min(m_count + 1, k_size);
+}
+
+gpu_timing_window::summary
+gpu_timing_window::summarize() const
+{
+    summary s;
+    if (m_count == 0)
+    {
+        return s;
+    }
+
+    std::array<float, k_size> sorted{};
+    // Oldest sample sits at m_head once the window has wrapped
+    const uint32_t first = m_count < k_size ? 0 : m_head;
+    float sum = 0.f;
+    for (uint32_t i = 0; i < m_count; ++i)
+    {
+        sorted[i] = m_samples[(first + i) % k_size];
+        sum += sorted[i];
+    }
+
+    s.last_ms = m_samples[(m_head + k_size - 1) % k_size];
+    s.avg_ms = sum / static_cast<float>(m_count);
+    s.samples = m_count;
+
+    std::sort(sorted.begin(), sorted.begin() + m_count);
+    s.min_ms = sorted[0];
+
+    // Nearest-rank percentile
+    const auto rank = static_cast<uint32_t>(std::ceil(0.99f * static_cast<float>(m_count)));
+    s.p99_ms = sorted[std::max(rank, 1u) - 1];
+    return s;
+}
+
+void
+gpu_timing_window::clear()
+{
+    m_head = 0;
+    m_count = 0;
+}
+
+// ============================================================================
+// gpu_pass_profiler
+// ============================================================================
+
+gpu_pass_profiler::gpu_pass_profiler() = default;
+
+// Out of line: m_tracy_zone's type is only complete here
+gpu_pass_profiler::~gpu_pass_profiler() = default;
+
+bool
+gpu_pass_profiler::init(render_device& device)
+{
+    m_device = device.vk_device();
+
+    const uint32_t bits = device.timestamp_valid_bits();
+    if (bits == 0)
+    {
+        ALOG_WARN("gpu_pass_profiler: graphics queue has no timestamp support, disabled");
+        m_timestamp_mask = 0;
+        return false;
+    }
+    m_timestamp_mask = bits >= 64 ? ~0ull : ((1ull << bits) - 1);
+    m_ns_per_tick = device.gpu_properties().limits.timestampPeriod;
+    m_stats_supported = device.pipeline_statistics_supported();
+
+    for (auto& slot : m_slots)
+    {
+        slot.timestamps =
+            create_pool(m_device, VK_QUERY_TYPE_TIMESTAMP, k_max_passes * 2, 0);
+        if (m_stats_supported)
+        {
+            slot.statistics = create_pool(
+                m_device, VK_QUERY_TYPE_PIPELINE_STATISTICS, k_max_passes, k_statistic_flags);
+        }
+
+        if (slot.timestamps == VK_NULL_HANDLE ||
+            (m_stats_supported && slot.statistics == VK_NULL_HANDLE))
+        {
+            ALOG_ERROR("gpu_pass_profiler: vkCreateQueryPool failed");
+            deinit();
+            return false;
+        }
+    }
+
+#ifdef TRACY_ENABLE
+    // Tracy calibrates its context with a one-off submit on this buffer
+    auto pool_ci = vk_utils::make_command_pool_create_info(
+        device.graphics_queue_family(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    if (vkCreateCommandPool(m_device, &pool_ci, nullptr, &m_tracy_pool) == VK_SUCCESS)
+    {
+        VkCommandBuffer tracy_cmd = VK_NULL_HANDLE;
+        auto alloc_ci = vk_utils::make_command_buffer_allocate_info(m_tracy_pool, 1);
+        if (vkAllocateCommandBuffers(m_device, &alloc_ci, &tracy_cmd) == VK_SUCCESS)
+        {
+            m_tracy_ctx = tracy::CreateVkContext(device.chosen_GPU(),
+                                                 m_device,
+                                                 device.vk_graphics_queue(),
+                                                 tracy_cmd,
+                                                 nullptr,
+                                                 nullptr);
+            m_tracy_ctx->Name("graphics", 8);
+        }
+    }
+#endif
+
+    ALOG_INFO("gpu_pass_profiler: {} ns/tick, {} valid bits, pipeline statistics {}",
+              m_ns_per_tick,
+              bits,
+              m_stats_supported ? "available" : "unavailable");
+    return true;
+}
+
+void
+gpu_pass_profiler::deinit()
+{
+    if (m_device == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+#ifdef TRACY_ENABLE
+    m_tracy_zone.reset();
+    if (m_tracy_ctx)
+    {
+        tracy::DestroyVkContext(m_tracy_ctx);
+        m_tracy_ctx = nullptr;
+    }
+    if (m_tracy_pool != VK_NULL_HANDLE)
+    {
+        vkDestroyCommandPool(m_device, m_tracy_pool, nullptr);
+        m_tracy_pool = VK_NULL_HANDLE;
+    }
+#endif
+
+    for (auto& slot : m_slots)
+    {
+        if (slot.timestamps != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(m_device, slot.timestamps, nullptr);
+        }
+        if (slot.statistics != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(m_device, slot.statistics, nullptr);
+        }
+        slot = slot_state{};
+    }
+
+    m_recording = nullptr;
+    m_in_pass = false;
+    m_pass_statistics = false;
+    m_history.clear();
+    m_last_order.clear();
+    m_frame_window.clear();
+    m_timestamp_mask = 0;
+    m_device = VK_NULL_HANDLE;
+}
+
+void
+gpu_pass_profiler::set_enabled(bool timing, bool pipeline_statistics)
+{
+    m_timing_enabled = timing;
+    m_stats_enabled = pipeline_statistics;
+}
+
+void
+gpu_pass_profiler::begin_frame(VkCommandBuffer cmd, uint32_t slot_idx)
+{
+    m_recording = nullptr;
+    if (!supported() || slot_idx >= k_max_slots)
+    {
+        return;
+    }
+
+#ifdef TRACY_ENABLE
+    if (m_tracy_ctx)
+    {
+        m_tracy_ctx->Collect(cmd);
+    }
+#endif
+
+    auto& slot = m_slots[slot_idx];
+
+    // The caller waited on this slot's fence, so its last frame is complete
+    if (slot.pending)
+    {
+        resolve(slot);
+    }
+    slot.passes.clear();
+
+    if (!m_timing_enabled)
+    {
+        return;
+    }
+
+    vkCmdResetQueryPool(cmd, slot.timestamps, 0, k_max_passes * 2);
+    slot.with_statistics = pipeline_statistics_active();
+    if (slot.with_statistics)
+    {
+        vkCmdResetQueryPool(cmd, slot.statistics, 0, k_max_passes);
+    }
+    m_recording = &slot;
+}
+
+void
+gpu_pass_profiler::end_frame(VkCommandBuffer /*cmd*/)
+{
+    KRG_check(!m_in_pass, "gpu_pass_profiler: end_frame inside a pass");
+    if (m_recording)
+    {
+        m_recording->pending = !m_recording->passes.empty();
+        m_recording = nullptr;
+    }
+}
+
+void
+gpu_pass_profiler::begin_pass(VkCommandBuffer cmd, const utils::id& name, bool statistics)
+{
+    KRG_check(!m_in_pass, "gpu_pass_profiler: passes do not nest");
+
+#ifdef TRACY_ENABLE
+    if (m_tracy_ctx)
+    {
+        const char* zone_name = name.cstr();
+        m_tracy_zone = std::make_unique<tracy::VkCtxScope>(m_tracy_ctx,
+                                                           __LINE__,
+                                                           __FILE__,
+                                                           sizeof(__FILE__) - 1,
+                                                           __func__,
+                                                           sizeof(__func__) - 1,
+                                                           zone_name,
+                                                           std::strlen(zone_name),
+                                                           cmd,
+                                                           true);
+    }
+#endif
+
+    if (!m_recording || m_recording->passes.size() >= k_max_passes)
+    {
+        return;
+    }
+
+    const auto q = static_cast<uint32_t>(m_recording->passes.size());
+    m_recording->passes.push_back(name);
+    m_in_pass = true;
+
+    // Barriers recorded after this belong to the pass that needed them
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_recording->timestamps, q * 2);
+    // A query left unbegun stays unavailable and resolves to zero counters
+    m_pass_statistics = m_recording->with_statistics && statistics;
+    if (m_pass_statistics)
+    {
+        vkCmdBeginQuery(cmd, m_recording->statistics, q, 0);
+    }
+}
+
+void
+gpu_pass_profiler::end_pass(VkCommandBuffer cmd)
+{
+#ifdef TRACY_ENABLE
+    m_tracy_zone.reset();
+#endif
+
+    if (!m_in_pass)
+    {
+        return;
+    }
+    m_in_pass = false;
+
+    const auto q = static_cast<uint32_t>(m_recording->passes.size() - 1);
+    if (m_pass_statistics)
+    {
+        vkCmdEndQuery(cmd, m_recording->statistics, q);
+    }
+    vkCmdWriteTimestamp(
+        cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_recording->timestamps, q * 2 + 1);
+}
+
+void
+gpu_pass_profiler::resolve(slot_state& slot)
+{
+    slot.pending = false;
+
+    const auto n = static_cast<uint32_t>(slot.passes.size());
+    if (n == 0)
+    {
+        return;
+    }
+
+    // {value, availability} per query
+    std::array<uint64_t, k_max_passes * 2 * 2> ts{};
+    VkResult r = vkGetQueryPoolResults(m_device,
+                                       slot.timestamps,
+                                       0,
+                                       n * 2,
+                                       sizeof(uint64_t) * n * 4,
+                                       ts.data(),
+                                       sizeof(uint64_t) * 2,
+                                       k_result_flags);
+    if (r != VK_SUCCESS && r != VK_NOT_READY)
+    {
+        return;
+    }
+
+    constexpr uint32_t k_stride = k_statistic_count + 1;
+    std::array<uint64_t, k_max_passes * k_stride> stats{};
+    bool have_stats = false;
+    if (slot.with_statistics)
+    {
+        r = vkGetQueryPoolResults(m_device,
+                                  slot.statistics,
+                                  0,
+                                  n,
+                                  sizeof(uint64_t) * n * k_stride,
+                                  stats.data(),
+                                  sizeof(uint64_t) * k_stride,
+                                  k_result_flags);
+        have_stats = (r == VK_SUCCESS || r == VK_NOT_READY);
+    }
+
+    auto ticks_to_ms = [this](uint64_t ticks)
+    { return static_cast<float>(static_cast<double>(ticks) * m_ns_per_tick * 1e-6); };
+
+    uint64_t frame_begin = UINT64_MAX;
+    uint64_t frame_end = 0;
+    bool complete = true;
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        const uint64_t* b = &ts[i * 4];
+        const uint64_t* e = &ts[i * 4 + 2];
+        if (b[1] == 0 || e[1] == 0)
+        {
+            complete = false;
+            continue;
+        }
+
+        const uint64_t begin = b[0] & m_timestamp_mask;
+        const uint64_t end = e[0] & m_timestamp_mask;
+        const uint64_t ticks = (end - begin) & m_timestamp_mask;
+
+        auto& h = m_history[slot.passes[i]];
+        h.window.add(ticks_to_ms(ticks));
+
+        const uint64_t* s = &stats[i * k_stride];
+        if (have_stats && s[k_statistic_count] != 0)
+        {
+            h.counters = {s[0], s[1], s[2], s[3], s[4]};
+        }
+        else
+        {
+            h.counters = {};
+        }
+
+        frame_begin = std::min(frame_begin, begin);
+        frame_end = std::max(frame_end, end);
+    }
+
+    // A frame whose counter wrapped mid-way is just dropped from the total
+    if (complete && frame_end > frame_begin)
+    {
+        m_frame_window.add(ticks_to_ms(frame_end - frame_begin));
+    }
+
+    m_last_order = slot.passes;
+    ++m_resolved_frames;
+}
+
+std::vector<gpu_pass_report>
+gpu_pass_profiler::report() const
+{
+    std::vector<gpu_pass_report> out;
+    out.reserve(m_last_order.size());
+    for (const auto& name : m_last_order)
+    {
+        auto itr = m_history.find(name);
+        if (itr == m_history.end())
+        {
+            continue;
+        }
+        out.push_back({name, itr->second.window.summarize(), itr->second.counters});
+    }
+    return out;
+}
+
+}  // namespace kryga::render
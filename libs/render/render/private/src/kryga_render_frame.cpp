@@ -25,6 +25,7 @@
 
 #include <kryga_port/imgui.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace kryga
@@ -76,10 +77,15 @@ vulkan_render::draw_main()
         return;
     }
 
+    auto& telemetry = m_frame_telemetry;
+    const uint64_t tframe = telemetry.render_frame();
+    uint64_t t0 = frame_telemetry::now_us();
+
     // Present-wait pacing: bound the CPU's lead over the display before we touch
     // any per-frame resource, collapsing the FIFO render-ahead queue (the
     // dominant present latency). No-op when disabled / present_wait unsupported.
     device.wait_present_pacing(m_render_config.present_pace_frames);
+    telemetry.add_wait(tframe, frame_gate::present_pacing, frame_telemetry::now_us() - t0);
 
     device.switch_frame_indeces();
     m_culled_draws = 0;
@@ -93,18 +99,26 @@ vulkan_render::draw_main()
 
     {
         ZoneScopedN("Render::WaitForFence");
+        t0 = frame_telemetry::now_us();
         VK_CHECK(vkWaitForFences(
             device.vk_device(), 1, &current_frame.frame->m_render_fence, true, 1000000000));
+        telemetry.add_wait(tframe, frame_gate::frame_fence, frame_telemetry::now_us() - t0);
     }
 
+    // Hand over readbacks whose frames have retired, before this slot's fence
+    // is reset below
+    m_frame_readback.poll();
+
     device.delete_scheduled_actions();
 
     current_frame.frame->m_dynamic_descriptor_allocator->reset_pools();
     VK_CHECK(vkResetCommandBuffer(current_frame.frame->m_main_command_buffer, 0));
+    device.reset_frame_commands(*current_frame.frame);
 
     // Tolerate VK_SUBOPTIMAL_KHR — see vkQueuePresentKHR below.
     uint32_t swapchain_image_index = 0U;
     {
+        t0 = frame_telemetry::now_us();
         VkResult ar = vkAcquireNextImageKHR(device.vk_device(),
                                             device.swapchain(),
                                             1000000000,
@@ -116,6 +130,9 @@ vulkan_render::draw_main()
             ALOG_ERROR("vkAcquireNextImageKHR failed: {}", (int)ar);
             KRG_never("vkAcquireNextImageKHR failed");
         }
+        const uint64_t t1 = frame_telemetry::now_us();
+        telemetry.add_wait(tframe, frame_gate::acquire, t1 - t0);
+        telemetry.stamp(tframe, frame_stamp::acquire, t1);
     }
 
     // The acquired image may still be owned by a different frame slot's in-flight
@@ -127,7 +144,9 @@ vulkan_render::draw_main()
         VkFence& img_fence = device.image_in_flight_fence(swapchain_image_index);
         if (img_fence != VK_NULL_HANDLE)
         {
+            t0 = frame_telemetry::now_us();
             VK_CHECK(vkWaitForFences(device.vk_device(), 1, &img_fence, true, 1000000000));
+            telemetry.add_wait(tframe, frame_gate::image_fence, frame_telemetry::now_us() - t0);
         }
         img_fence = current_frame.frame->m_render_fence;
     }
@@ -151,24 +170,12 @@ vulkan_render::draw_main()
     // (screenshot capture) sample the on-screen image rather than frame_slot.
     device.set_last_presented_image_index(swapchain_image_index);
 
-    VK_CHECK(vkEndCommandBuffer(cmd));
-
     // Submit. Signal the per-IMAGE render semaphore (keyed by acquired image,
     // not frame slot) so the present wait below is correct even when the
     // presentation engine returns an image index != frame slot.
     VkSemaphore render_sem = device.image_render_semaphore(swapchain_image_index);
-
-    auto submit = render::vk_utils::make_submit_info(&cmd);
-    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-
-    submit.pWaitDstStageMask = &wait_stage;
-    submit.waitSemaphoreCount = 1;
-    submit.pWaitSemaphores = &current_frame.frame->m_present_semaphore;
-    submit.signalSemaphoreCount = 1;
-    submit.pSignalSemaphores = &render_sem;
-
-    VK_CHECK(
-        vkQueueSubmit(device.vk_graphics_queue(), 1, &submit, current_frame.frame->m_render_fence));
+    submit_frame(current_frame, current_frame.frame->m_present_semaphore, render_sem);
+    telemetry.stamp(tframe, frame_stamp::gpu_submit);
 
     // Present
     auto present_info = render::vk_utils::make_present_info();
@@ -198,6 +205,7 @@ vulkan_render::draw_main()
         ALOG_ERROR("vkQueuePresentKHR failed: {}", (int)pr);
         KRG_never("vkQueuePresentKHR failed");
     }
+    telemetry.stamp(tframe, frame_stamp::present);
 
     // Non-blocking: harvest any presents that have hit the screen since last frame.
     device.poll_present_timing();
@@ -228,14 +236,20 @@ vulkan_render::draw_headless()
 
     auto& current_frame = m_frames[device.get_current_frame_index()];
 
+    auto& telemetry = m_frame_telemetry;
+    const uint64_t tframe = telemetry.render_frame();
+    uint64_t t0 = frame_telemetry::now_us();
+
     VK_CHECK(vkWaitForFences(
         device.vk_device(), 1, &current_frame.frame->m_render_fence, true, 1000000000));
+    telemetry.add_wait(tframe, frame_gate::frame_fence, frame_telemetry::now_us() - t0);
     VK_CHECK(vkResetFences(device.vk_device(), 1, &current_frame.frame->m_render_fence));
 
     device.delete_scheduled_actions();
 
     current_frame.frame->m_dynamic_descriptor_allocator->reset_pools();
     VK_CHECK(vkResetCommandBuffer(current_frame.frame->m_main_command_buffer, 0));
+    device.reset_frame_commands(*current_frame.frame);
 
     auto cmd = current_frame.frame->m_main_command_buffer;
     auto cmd_begin_info =
@@ -247,15 +261,19 @@ vulkan_render::draw_headless()
     // both index by it, and a mismatch transitions the wrong triple-buffered image.
     render_frame(cmd, current_frame, device.get_current_frame_index(), m_width, m_height);
 
-    VK_CHECK(vkEndCommandBuffer(cmd));
-
-    // Submit without present semaphores and wait synchronously
-    auto submit = render::vk_utils::make_submit_info(&cmd);
-    VK_CHECK(
-        vkQueueSubmit(device.vk_graphics_queue(), 1, &submit, current_frame.frame->m_render_fence));
+    // Submit without present semaphores and wait synchronously. GPU completion
+    // stands in for present in the frame telemetry.
+    submit_frame(current_frame, VK_NULL_HANDLE, VK_NULL_HANDLE);
+    t0 = frame_telemetry::now_us();
+    telemetry.stamp(tframe, frame_stamp::gpu_submit, t0);
 
     VK_CHECK(vkWaitForFences(
         device.vk_device(), 1, &current_frame.frame->m_render_fence, true, 1000000000));
+    const uint64_t t1 = frame_telemetry::now_us();
+    telemetry.add_wait(tframe, frame_gate::frame_fence, t1 - t0);
+    telemetry.stamp(tframe, frame_stamp::present, t1);
+
+    m_frame_readback.poll();
 }
 
 void
@@ -303,6 +321,17 @@ vulkan_render::render_frame(VkCommandBuffer cmd,
     m_frustum_cull_descriptor_set = m_frustum_cull_pass->get_descriptor_set(
         0, *current_frame.frame->m_dynamic_descriptor_allocator);
 
+    // Build descriptor set for pre-skinning
+    KRG_check(m_pre_skin_pass, "Pre-skin pass required");
+
+    m_pre_skin_pass->begin_frame();
+    m_pre_skin_pass->bind(AID("dyn_bone_matrices"), current_frame.buffers.bone_matrices);
+    m_pre_skin_pass->bind(AID("dyn_skinning_jobs"), current_frame.buffers.skinning_jobs);
+    m_pre_skin_pass->bind(AID("dyn_skinned_vertices"), current_frame.buffers.skinned_vertices);
+
+    m_pre_skin_descriptor_set = m_pre_skin_pass->get_descriptor_set(
+        0, *current_frame.frame->m_dynamic_descriptor_allocator);
+
     m_render_graph.begin_frame();
 
     // Bind per-frame buffer resources
@@ -328,6 +357,10 @@ vulkan_render::render_frame(VkCommandBuffer cmd,
     m_render_graph.bind_buffer(AID("dyn_visible_indices"), current_frame.buffers.visible_indices);
     m_render_graph.bind_buffer(AID("dyn_cull_output"), current_frame.buffers.cull_output);
 
+    m_render_graph.bind_buffer(AID("dyn_skinning_jobs"), current_frame.buffers.skinning_jobs);
+    m_render_graph.bind_buffer(AID("dyn_skinned_vertices"),
+                               current_frame.buffers.skinned_vertices);
+
     // Bind per-frame image resources
     // All render targets are cleared each frame, so UNDEFINED initial layout is safe.
     const bool render_scale = m_render_config.render_scale.enabled;
@@ -367,8 +400,38 @@ vulkan_render::render_frame(VkCommandBuffer cmd,
     // image==slot, so using the acquired index keeps the rendered framebuffer
     // and the presented image in lockstep. draw_headless passes its frame slot
     // here (no acquired-image domain), which is correct for headless.
+    // Frame slot, not image index: query pools are recycled behind the slot fence
+    m_gpu_profiler.begin_frame(cmd, static_cast<uint32_t>(device.get_current_frame_index()));
+    // Split passes record on the job system, from this frame's secondary lanes
+    m_render_graph.set_secondary_recording(
+        glob::glob_state().get_job_system(),
+        frame_data::k_secondary_lanes,
+        [&device, frame = current_frame.frame](uint32_t lane)
+        { return device.acquire_secondary(*frame, lane); });
     m_render_graph.execute(cmd, swapchain_image_index, width, height);
 
+    // With async compute the graph ends in a buffer of its own
+    cmd = m_render_graph.get_graphics_tail();
+    m_gpu_profiler.end_frame(cmd);
+
+    // Screenshot / stream copies ride this frame's command buffer; the ring
+    // polls the frame fence later instead of stalling here
+    if (m_frame_readback.has_requests())
+    {
+        if (auto* host = get_render_pass(get_host_pass_id()))
+        {
+            auto images = host->get_color_images();
+            m_frame_readback.record(cmd,
+                                    images[swapchain_image_index % images.size()]->image(),
+                                    device.is_headless() ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+                                                         : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                                    host->get_color_format(),
+                                    get_width(),
+                                    get_height(),
+                                    current_frame.frame->m_render_fence);
+        }
+    }
+
     // Verify per-draw BDA addresses were set this frame (if any objects were actually drawn)
     // m_all_draws includes culled objects; only check if at least one object passed culling
     if (m_all_draws > m_culled_draws)
@@ -379,6 +442,110 @@ vulkan_render::render_frame(VkCommandBuffer cmd,
     }
 }
 
+void
+vulkan_render::submit_frame(frame_state& current_frame, VkSemaphore wait, VkSemaphore signal)
+{
+    auto& device = glob::glob_state().getr_render().device;
+    const auto& submissions = m_render_graph.get_submissions();
+
+    size_t first_graphics = submissions.size();
+    size_t last_graphics = 0;
+    for (size_t i = 0; i < submissions.size(); ++i)
+    {
+        if (submissions[i].cmd)
+        {
+            VK_CHECK(vkEndCommandBuffer(submissions[i].cmd));
+        }
+        if (submissions[i].queue == rg_queue::graphics)
+        {
+            first_graphics = std::min(first_graphics, i);
+            last_graphics = i;
+        }
+    }
+
+    // Sized up front: the submit infos point into the batches
+    m_submit_batches.assign(submissions.size(), {});
+    for (auto& infos : m_submit_infos)
+    {
+        infos.clear();
+    }
+
+    for (size_t i = 0; i < submissions.size(); ++i)
+    {
+        const auto& s = submissions[i];
+        auto& b = m_submit_batches[i];
+        const rg_queue other =
+            s.queue == rg_queue::graphics ? rg_queue::async_compute : rg_queue::graphics;
+
+        // Binary semaphores take no value; the timeline info ignores theirs
+        auto add_wait = [&b](VkSemaphore sem, VkPipelineStageFlags stage, uint64_t value)
+        {
+            b.wait[b.wait_count] = sem;
+            b.wait_stage[b.wait_count] = stage;
+            b.wait_value[b.wait_count++] = value;
+        };
+        auto add_signal = [&b](VkSemaphore sem, uint64_t value)
+        {
+            b.signal[b.signal_count] = sem;
+            b.signal_value[b.signal_count++] = value;
+        };
+
+        if (i == first_graphics && wait)
+        {
+            add_wait(wait, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0);
+        }
+        if (s.wait_value != 0)
+        {
+            add_wait(device.queue_timeline(other), s.wait_stage, s.wait_value);
+        }
+        if (s.signal_value != 0)
+        {
+            add_signal(device.queue_timeline(s.queue), s.signal_value);
+        }
+        if (i == last_graphics && signal)
+        {
+            add_signal(signal, 0);
+        }
+
+        b.cmd = s.cmd;
+        auto info = vk_utils::make_submit_info(&b.cmd);
+        info.commandBufferCount = s.cmd ? 1 : 0;
+        info.waitSemaphoreCount = b.wait_count;
+        info.pWaitSemaphores = b.wait;
+        info.pWaitDstStageMask = b.wait_stage;
+        info.signalSemaphoreCount = b.signal_count;
+        info.pSignalSemaphores = b.signal;
+
+        if (s.wait_value != 0 || s.signal_value != 0)
+        {
+            b.timeline.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            b.timeline.waitSemaphoreValueCount = b.wait_count;
+            b.timeline.pWaitSemaphoreValues = b.wait_value;
+            b.timeline.signalSemaphoreValueCount = b.signal_count;
+            b.timeline.pSignalSemaphoreValues = b.signal_value;
+            info.pNext = &b.timeline;
+        }
+
+        m_submit_infos[static_cast<uint32_t>(s.queue)].push_back(info);
+    }
+
+    // Timeline waits may precede their signals, so the queue order is free
+    const auto& graphics = m_submit_infos[static_cast<uint32_t>(rg_queue::graphics)];
+    VK_CHECK(vkQueueSubmit(device.vk_graphics_queue(),
+                           static_cast<uint32_t>(graphics.size()),
+                           graphics.data(),
+                           current_frame.frame->m_render_fence));
+
+    const auto& compute = m_submit_infos[static_cast<uint32_t>(rg_queue::async_compute)];
+    if (!compute.empty())
+    {
+        VK_CHECK(vkQueueSubmit(device.vk_compute_queue(),
+                               static_cast<uint32_t>(compute.size()),
+                               compute.data(),
+                               VK_NULL_HANDLE));
+    }
+}
+
 void
 vulkan_render::prepare_draw_resources(render::frame_state& current_frame)
 {
@@ -414,6 +581,10 @@ vulkan_render::prepare_draw_resources(render::frame_state& current_frame)
     // Upload light probes if a stage_set_probes is pending for this frame.
     upload_probe_data(current_frame);
 
+    // Retained UI: copies the batch only when a widget changed since this slot's
+    // last upload.
+    prepare_ui_batch(current_frame);
+
     if (current_frame.uploads.has_objects())
     {
         ZoneScopedN("Render::UploadObjects");
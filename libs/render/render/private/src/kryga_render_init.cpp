@@ -159,6 +159,21 @@ vulkan_render::create_frame_buffers(size_t i)
                              0,
                              KRG_VK_FMT_NAME("frame_{}.bone_matrices", i));
 
+    // Pre-skinning jobs and skinned vertex pool (initial 64KB each, regrown on demand)
+    m_frames[i].buffers.skinning_jobs =
+        device.create_buffer(64 * 1024,
+                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                             VMA_MEMORY_USAGE_CPU_TO_GPU,
+                             0,
+                             KRG_VK_FMT_NAME("frame_{}.skinning_jobs", i));
+
+    m_frames[i].buffers.skinned_vertices =
+        device.create_buffer(64 * 1024,
+                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                             VMA_MEMORY_USAGE_GPU_ONLY,
+                             0,
+                             KRG_VK_FMT_NAME("frame_{}.skinned_vertices", i));
+
     // GPU frustum culling buffers
     m_frames[i].buffers.frustum_data =
         device.create_buffer(sizeof(gpu::frustum_data),
@@ -348,6 +363,7 @@ vulkan_render::init(uint32_t w, uint32_t h, const render_config& config, bool on
     // Initialize GPU compute shaders
     init_cluster_cull_compute();
     init_frustum_cull_compute();
+    init_pre_skin_compute();
 
     // Snapshot initial config for runtime change detection
     m_applied_clusters = m_render_config.clusters;
@@ -360,6 +376,16 @@ vulkan_render::init(uint32_t w, uint32_t h, const render_config& config, bool on
     // binding table resources + BDA push constant fields (bda_X → dyn_X).
     setup_render_graph();
 
+    if (m_gpu_profiler.init(device))
+    {
+        m_gpu_profiler.set_enabled(m_render_config.debug.gpu_pass_timing,
+                                   m_render_config.debug.pipeline_statistics);
+        m_render_graph.set_profiler(&m_gpu_profiler);
+    }
+
+    // A copy per frame in flight plus two the encoder may still be holding
+    m_frame_readback.init(device, device.frames_in_flight() + 2);
+
     device.log_memory_stats();
 }
 
@@ -415,6 +441,10 @@ vulkan_render::apply_config_changes()
         m_render_graph.reset();
         setup_render_graph();
     }
+
+    // Takes effect when the next frame slot resets its queries
+    m_gpu_profiler.set_enabled(m_render_config.debug.gpu_pass_timing,
+                               m_render_config.debug.pipeline_statistics);
 }
 
 bool
@@ -986,6 +1016,7 @@ vulkan_render::reconfigure_swapchain(uint32_t count, present_mode mode)
             m_frames[i].buffers = frame_buffers{};
             m_frames[i].uploads.clear_all();
             m_frames[i].ui = ui_frame_state{};
+            m_frames[i].ui_batch = ui_batch_frame_state{};
         }
     }
     m_allocated_frame_slots = new_count;
@@ -1047,9 +1078,14 @@ vulkan_render::deinit()
     m_cluster_cull_pass.reset();
     m_frustum_cull_shader = nullptr;
     m_frustum_cull_pass.reset();
+    m_pre_skin_shader = nullptr;
+    m_pre_skin_pass.reset();
 
     // Reset render graph so it can be recompiled on next init
+    m_render_graph.set_profiler(nullptr);
     m_render_graph.reset();
+    m_gpu_profiler.deinit();
+    m_frame_readback.deinit();
 
     // Cleanup bindless textures
     deinit_bindless_textures();
@@ -1366,19 +1402,19 @@ vulkan_render::prepare_system_resources()
             AID("debug_cone_mesh"), vb.make_view<gpu::vertex_data>(), ib.make_view<gpu::uint>());
     }
 
-    init_ui_panel_pipeline();
+    init_ui_batch_pipeline();
 }
 
 void
-vulkan_render::init_ui_panel_pipeline()
+vulkan_render::init_ui_batch_pipeline()
 {
     vfs::rid se_base("data://packages/base.apkg/class/shader_effects");
 
-    auto v_r = render::shader_loader::load(se_base / "ui/se_ui_panel.vert.spv");
-    auto f_r = render::shader_loader::load(se_base / "ui/se_ui_panel.frag.spv");
+    auto v_r = render::shader_loader::load(se_base / "ui/se_ui_batch.vert.spv");
+    auto f_r = render::shader_loader::load(se_base / "ui/se_ui_batch.frag.spv");
     if (!v_r || !f_r)
     {
-        ALOG_ERROR("UI panel shader files missing");
+        ALOG_ERROR("UI batch shader files missing");
         return;
     }
     kryga::utils::buffer vert = std::move(*v_r);
@@ -1391,55 +1427,19 @@ vulkan_render::init_ui_panel_pipeline()
     se_ci.frag_buffer = &frag;
     se_ci.is_wire = false;
     se_ci.enable_dynamic_state = false;
-    se_ci.alpha = alpha_mode::world;
+    se_ci.alpha = alpha_mode::world;  // alpha-blend panels + glyph coverage
     se_ci.depth_compare_op = VK_COMPARE_OP_ALWAYS;
     se_ci.ds_mode = depth_stencil_mode::none;
     se_ci.cull_mode = VK_CULL_MODE_NONE;
     se_ci.height = m_height;
     se_ci.width = m_width;
 
-    m_ui_panel_se = nullptr;
-    auto rc = main_pass->create_shader_effect(AID("se_ui_panel"), se_ci, m_ui_panel_se);
-    KRG_check(rc == result_code::ok && m_ui_panel_se, "UI panel shader effect creation failed!");
-
-    // UI text pipeline. The font atlases themselves are baked by the engine
+    // The font atlases themselves are baked by the engine
     // (vulkan_engine::init_default_resources) — which fonts ship is engine policy,
     // not a renderer concern; the loader just owns the registry.
-    init_ui_text_pipeline();
-}
-
-void
-vulkan_render::init_ui_text_pipeline()
-{
-    vfs::rid se_base("data://packages/base.apkg/class/shader_effects");
-
-    auto v_r = render::shader_loader::load(se_base / "ui/se_ui_text.vert.spv");
-    auto f_r = render::shader_loader::load(se_base / "ui/se_ui_text.frag.spv");
-    if (!v_r || !f_r)
-    {
-        ALOG_ERROR("UI text shader files missing");
-        return;
-    }
-    kryga::utils::buffer vert = std::move(*v_r);
-    kryga::utils::buffer frag = std::move(*f_r);
-
-    auto main_pass = glob::glob_state().getr_render().loader.get_render_pass(AID("main"));
-
-    shader_effect_create_info se_ci = {};
-    se_ci.vert_buffer = &vert;
-    se_ci.frag_buffer = &frag;
-    se_ci.is_wire = false;
-    se_ci.enable_dynamic_state = false;
-    se_ci.alpha = alpha_mode::world;  // alpha-blend glyph coverage
-    se_ci.depth_compare_op = VK_COMPARE_OP_ALWAYS;
-    se_ci.ds_mode = depth_stencil_mode::none;
-    se_ci.cull_mode = VK_CULL_MODE_NONE;
-    se_ci.height = m_height;
-    se_ci.width = m_width;
-
-    m_ui_text_se = nullptr;
-    auto rc = main_pass->create_shader_effect(AID("se_ui_text"), se_ci, m_ui_text_se);
-    KRG_check(rc == result_code::ok && m_ui_text_se, "UI text shader effect creation failed!");
+    m_ui_batch_se = nullptr;
+    auto rc = main_pass->create_shader_effect(AID("se_ui_batch"), se_ci, m_ui_batch_se);
+    KRG_check(rc == result_code::ok && m_ui_batch_se, "UI batch shader effect creation failed!");
 }
 
 void
@@ -14,6 +14,7 @@
 #include "vulkan_render/types/vulkan_render_data.h"
 
 #include <gpu_types/gpu_generic_constants.h>
+#include <gpu_types/gpu_ui_types.h>
 
 #include <utils/kryga_log.h>
 
@@ -22,6 +23,7 @@
 #include <global_state/global_state.h>
 
 #include <algorithm>
+#include <cstring>
 
 namespace kryga
 {
@@ -95,9 +97,15 @@ vulkan_render::draw_objects_instanced(render::frame_state& current_frame)
     for (const auto& batch : m_draw_batches)
     {
         // Rebind material/pipeline if changed
-        if (cur_material != batch.material || cur_outlined != batch.outlined)
+        const bool compact = batch.mesh->draws_compact();
+        if (cur_material != batch.material || cur_outlined != batch.outlined ||
+            pctx.compact != compact)
         {
-            bind_material(cmd, batch.material, current_frame, pctx, batch.outlined);
+            cur_material = nullptr;
+            if (!bind_material(cmd, batch.material, current_frame, pctx, batch.outlined, compact))
+            {
+                continue;
+            }
             cur_material = batch.material;
             cur_outlined = batch.outlined;
         }
@@ -113,7 +121,13 @@ vulkan_render::draw_objects_instanced(render::frame_state& current_frame)
 
         batch.material->get_shader_effect()->push_constants(cmd, &m_obj_config);
 
-        draw_mesh(cmd, batch.mesh, batch.instance_count);
+        draw_mesh(cmd,
+                  batch.mesh,
+                  batch.instance_count,
+                  0,
+                  batch.vertex_offset,
+                  batch.first_index,
+                  batch.index_count);
     }
 
     // TRANSPARENT - needs per-object sorting, add slots after opaque batches
@@ -137,9 +151,15 @@ vulkan_render::draw_objects_instanced(render::frame_state& current_frame)
 
         for (auto& obj : m_transparent_render_object_queue)
         {
-            if (pctx.cur_material_type_idx != obj->material->gpu_type_idx())
+            const bool compact = obj->mesh->draws_compact();
+            if (pctx.cur_material_type_idx != obj->material->gpu_type_idx() ||
+                pctx.compact != compact)
             {
-                bind_material(cmd, obj->material, current_frame, pctx);
+                if (!bind_material(cmd, obj->material, current_frame, pctx, false, compact))
+                {
+                    ++transparent_idx;
+                    continue;
+                }
             }
             else if (pctx.cur_material_idx != obj->material->gpu_idx())
             {
@@ -164,7 +184,9 @@ vulkan_render::draw_objects_instanced(render::frame_state& current_frame)
 
             obj->material->get_shader_effect()->push_constants(cmd, &m_obj_config);
 
-            draw_mesh(cmd, obj->mesh);
+            const auto range = draw_range_of(*obj);
+            draw_mesh(
+                cmd, obj->mesh, 1, 0, range.vertex_offset, range.first_index, range.index_count);
 
             ++transparent_idx;
         }
@@ -178,11 +200,11 @@ vulkan_render::draw_objects_instanced(render::frame_state& current_frame)
         draw_debug_overlay(cmd, current_frame);
         draw_outline_post(cmd, current_frame);
 
-        // Layer order: player-facing UI panels, then text on top of them, then the
-        // ImGui editor chrome composited above all. Panels/text are not ImGui-gated
-        // (they ship in game builds); ImGui is editor-only and always sits above.
-        draw_ui_panels(cmd);
-        draw_ui_text(cmd);
+        // Layer order: player-facing UI (panels, then text on top, within the one
+        // batched draw), then the ImGui editor chrome composited above all. The UI
+        // batch is not ImGui-gated (it ships in game builds); ImGui is editor-only
+        // and always sits above.
+        draw_ui_batch(cmd, current_frame);
 #if KRG_HAS_IMGUI
         draw_ui_overlay(cmd, current_frame);
 #endif
@@ -191,58 +213,104 @@ vulkan_render::draw_objects_instanced(render::frame_state& current_frame)
     {
         // Render-scale on: the full-res overlays + ImGui run later in draw_composite,
         // which executes after this lowres pass — so ImGui already lands on top of
-        // the panels there. Panels/text must still be drawn here in the main pass:
-        // their pipelines are built for main_pass and would be invalid in composite.
-        draw_ui_panels(cmd);
-        draw_ui_text(cmd);
+        // the panels there. The UI batch must still be drawn here in the main pass:
+        // its pipeline is built for main_pass and would be invalid in composite.
+        draw_ui_batch(cmd, current_frame);
     }
 }
 
 // ============================================================================
-// UI Panels (packages/ui retained-mode widgets)
+// UI batch (packages/ui retained-mode panels + text)
 // ============================================================================
 
 void
 vulkan_render::ui_panel_create_or_update(const utils::id& id, const ui_panel_entry& e)
 {
-    m_ui_panels[id] = e;
+    m_ui_batcher.set_panel(id, e.rect_px, e.color_opacity);
 }
 
 void
 vulkan_render::ui_panel_destroy(const utils::id& id)
 {
-    m_ui_panels.erase(id);
+    m_ui_batcher.remove_panel(id);
+}
+
+void
+vulkan_render::ui_font_removed(const font_atlas* font)
+{
+    m_ui_batcher.forget_font(font);
 }
 
 void
-vulkan_render::draw_ui_panels(VkCommandBuffer cmd)
+vulkan_render::prepare_ui_batch(render::frame_state& frame)
 {
-    if (!m_ui_panel_se || m_ui_panels.empty())
+    KRG_check_render_thread();
+
+    // Glyphs finished by the font workers land in their atlas pages first, so
+    // lines that were waiting on them can be laid out in the same frame. Both
+    // steps are no-ops when nothing is outstanding.
+    m_loader->update_fonts();
+    m_ui_batcher.refresh([this](const utils::id& id) { return m_loader->get_font(id); });
+
+    auto& slot = frame.ui_batch;
+    if (slot.generation == m_ui_batcher.generation())
     {
         return;
     }
 
-    struct ui_panel_push_constants
+    ZoneScopedN("Render::UploadUIBatch");
+
+    const auto& quads = m_ui_batcher.quads();
+    const size_t payload = std::max<size_t>(quads.size(), 1) * sizeof(gpu::ui_quad);
+
+    if (payload > slot.quads.get_alloc_size())
     {
-        glm::vec4 rect_ndc;
-        glm::vec4 color_opacity;
-    };
+        auto& device = glob::glob_state().getr_render().device;
+        slot.quads = device.create_buffer(payload * 2,
+                                          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                          VMA_MEMORY_USAGE_CPU_TO_GPU);
+    }
 
-    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_ui_panel_se->m_pipeline);
+    slot.quads.begin();
+    if (!quads.empty())
+    {
+        const size_t bytes = quads.size() * sizeof(gpu::ui_quad);
+        auto* dst = slot.quads.allocate_data(static_cast<uint32_t>(bytes));
+        memcpy(dst, quads.data(), bytes);
+    }
+    slot.quads.end();
 
-    auto pipeline_layout = m_ui_panel_se->m_pipeline_layout;
+    slot.quad_count = static_cast<uint32_t>(quads.size());
+    slot.generation = m_ui_batcher.generation();
+}
 
-    for (auto& [id, entry] : m_ui_panels)
+void
+vulkan_render::draw_ui_batch(VkCommandBuffer cmd, render::frame_state& frame)
+{
+    const auto& slot = frame.ui_batch;
+    if (!m_ui_batch_se || slot.quad_count == 0)
     {
-        ui_panel_push_constants pc{entry.rect_ndc, entry.color_opacity};
-        vkCmdPushConstants(cmd,
-                           pipeline_layout,
-                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                           0,
-                           sizeof(pc),
-                           &pc);
-        vkCmdDraw(cmd, 6, 1, 0, 0);
+        return;
     }
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_ui_batch_se->m_pipeline);
+    vkCmdBindDescriptorSets(cmd,
+                            VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            m_ui_batch_se->m_pipeline_layout,
+                            KGPU_textures_descriptor_sets,
+                            1,
+                            &m_bindless_set,
+                            0,
+                            nullptr);
+
+    gpu::push_constants_ui pc{};
+    pc.bdag_quads = gpu::make_bda_addr(slot.quads.device_address());
+    pc.viewport_size = glm::vec2(static_cast<float>(get_width() == 0 ? 1u : get_width()),
+                                 static_cast<float>(get_height() == 0 ? 1u : get_height()));
+    m_ui_batch_se->push_constants(cmd, &pc);
+
+    // 6 corners per quad from gl_VertexIndex, one instance per panel / glyph
+    vkCmdDraw(cmd, 6, slot.quad_count, 0, 0);
 }
 
 // ============================================================================
@@ -306,9 +374,14 @@ vulkan_render::draw_debug_overlay(VkCommandBuffer cmd, render::frame_state& curr
 
         for (const auto& batch : m_debug_draw_batches)
         {
-            if (cur_material != batch.material)
+            const bool compact = batch.mesh->draws_compact();
+            if (cur_material != batch.material || pctx.compact != compact)
             {
-                bind_material(cmd, batch.material, current_frame, pctx, false);
+                cur_material = nullptr;
+                if (!bind_material(cmd, batch.material, current_frame, pctx, false, compact))
+                {
+                    continue;
+                }
                 cur_material = batch.material;
             }
 
@@ -322,7 +395,13 @@ vulkan_render::draw_debug_overlay(VkCommandBuffer cmd, render::frame_state& curr
 
             batch.material->get_shader_effect()->push_constants(cmd, &m_obj_config);
 
-            draw_mesh(cmd, batch.mesh, batch.instance_count);
+            draw_mesh(cmd,
+                      batch.mesh,
+                      batch.instance_count,
+                      0,
+                      batch.vertex_offset,
+                      batch.first_index,
+                      batch.index_count);
         }
 
         m_obj_config.enable_directional_light = saved_dir;
@@ -356,9 +435,14 @@ vulkan_render::draw_selection_mask(VkCommandBuffer cmd, render::frame_state& cur
             continue;
         }
 
-        if (cur_material != batch.material)
+        const bool compact = batch.mesh->draws_compact();
+        if (cur_material != batch.material || pctx.compact != compact)
         {
-            bind_material(cmd, batch.material, current_frame, pctx, false);
+            cur_material = nullptr;
+            if (!bind_material(cmd, batch.material, current_frame, pctx, false, compact))
+            {
+                continue;
+            }
             cur_material = batch.material;
         }
 
@@ -372,7 +456,13 @@ vulkan_render::draw_selection_mask(VkCommandBuffer cmd, render::frame_state& cur
 
         batch.material->get_shader_effect()->push_constants(cmd, &m_obj_config);
 
-        draw_mesh(cmd, batch.mesh, batch.instance_count);
+        draw_mesh(cmd,
+                  batch.mesh,
+                  batch.instance_count,
+                  0,
+                  batch.vertex_offset,
+                  batch.first_index,
+                  batch.index_count);
     }
 }
 
@@ -477,6 +477,51 @@ vulkan_render::init_frustum_cull_compute()
     ALOG_INFO("GPU frustum culling compute shader initialized");
 }
 
+void
+vulkan_render::init_pre_skin_compute()
+{
+    ZoneScopedN("Render::InitPreSkinCompute");
+
+    auto shader_buffer_r =
+        render::shader_loader::load(vfs::rid("data://shaders_includes/pre_skin.comp.spv"));
+    KRG_check(shader_buffer_r, "Failed to load pre_skin.comp - skinned meshes cannot be drawn");
+    auto& shader_buffer = *shader_buffer_r;
+
+    m_pre_skin_pass = std::make_shared<render_pass>(AID("pre_skin"), rg_pass_type::compute);
+
+    // set=0, binding=0: BoneMatrices (storage, readonly)
+    // set=0, binding=1: SkinningJobs (storage, readonly)
+    // set=0, binding=2: SkinnedVertices (storage, writeonly)
+    // Source vertices are read by device address from each job
+    m_pre_skin_pass->bindings()
+        .add(AID("dyn_bone_matrices"),
+             0,
+             0,
+             VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+             VK_SHADER_STAGE_COMPUTE_BIT)
+        .add(AID("dyn_skinning_jobs"),
+             0,
+             1,
+             VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+             VK_SHADER_STAGE_COMPUTE_BIT)
+        .add(AID("dyn_skinned_vertices"),
+             0,
+             2,
+             VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+             VK_SHADER_STAGE_COMPUTE_BIT);
+
+    m_pre_skin_pass->finalize_bindings(
+        *glob::glob_state().getr_render().device.descriptor_layout_cache());
+
+    compute_shader_create_info info;
+    info.shader_buffer = &shader_buffer;
+
+    auto rc = m_pre_skin_pass->create_compute_shader(AID("pre_skin"), info, m_pre_skin_shader);
+    KRG_check(rc == result_code::ok, "Failed to create pre-skin compute shader");
+
+    ALOG_INFO("GPU pre-skinning compute shader initialized");
+}
+
 // ============================================================================
 // Render Graph Setup
 // ============================================================================
@@ -521,6 +566,12 @@ vulkan_render::setup_instanced_render_graph()
     m_render_graph.register_buffer(AID("dyn_visible_indices"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
     m_render_graph.register_buffer(AID("dyn_cull_output"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
 
+    // Pre-skinning buffers. The pool is a vertex buffer to every pass that reads it.
+    m_render_graph.register_buffer(AID("dyn_skinning_jobs"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    m_render_graph.register_buffer(AID("dyn_skinned_vertices"),
+                                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                       VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+
     const bool render_scale = m_render_config.render_scale.enabled;
 
     m_render_graph.import_resource(AID("swapchain"), rg_resource_type::image);
@@ -531,30 +582,45 @@ vulkan_render::setup_instanced_render_graph()
         m_render_graph.import_resource(AID("scene_lowres_target"), rg_resource_type::image);
     }
 
+    // Compute pass: skin every animated instance once into the skinned vertex pool.
+    // Stays on the graphics queue: it reads the meshes' own (exclusive) vertex buffers.
+    m_render_graph.add_compute_pass(AID("pre_skin"),
+                                    {m_render_graph.read(AID("dyn_bone_matrices")),
+                                     m_render_graph.read(AID("dyn_skinning_jobs")),
+                                     m_render_graph.write(AID("dyn_skinned_vertices"))},
+                                    [this](VkCommandBuffer cmd) { dispatch_pre_skin_impl(cmd); });
+
     // Shadow atlas — single depth-only pass for all CSM cascades + local light shadows
     m_render_graph.import_resource(AID("shadow_atlas"), rg_resource_type::image);
     m_render_graph.add_graphics_pass(AID("shadow_atlas"),
                                      {m_render_graph.write(AID("shadow_atlas")),
                                       m_render_graph.read(AID("dyn_object_buffer")),
-                                      m_render_graph.read(AID("dyn_instance_slots"))},
+                                      m_render_graph.read(AID("dyn_instance_slots")),
+                                      m_render_graph.read(AID("dyn_skinned_vertices"))},
                                      m_shadow_atlas_pass.get(),
                                      VkClearColorValue{},
                                      [this](VkCommandBuffer cmd)
                                      { draw_shadow_atlas(cmd); });
+    // Tiles are independent: record them in parallel secondaries
+    m_shadow_atlas_pass->set_split_execute(
+        [this] { return shadow_atlas_item_count(); },
+        [this](VkCommandBuffer cmd, uint32_t begin, uint32_t end)
+        { draw_shadow_atlas_range(cmd, begin, end); });
 
     // Compute pass: GPU frustum culling (runs before cluster culling)
     // Frustum culling is required for instanced mode - dispatch_frustum_cull_impl asserts if not
     // ready
-    m_render_graph.add_compute_pass(AID("frustum_cull"),
+    auto frustum_cull = m_render_graph.add_compute_pass(AID("frustum_cull"),
                                     {m_render_graph.read(AID("dyn_frustum_data")),
                                      m_render_graph.read(AID("dyn_object_buffer")),
                                      m_render_graph.write(AID("dyn_visible_indices")),
                                      m_render_graph.write(AID("dyn_cull_output"))},
                                     [this](VkCommandBuffer cmd)
                                     { dispatch_frustum_cull_impl(cmd); });
+    frustum_cull->set_async_compute(true);
 
     // Compute pass: GPU cluster culling
-    m_render_graph.add_compute_pass(AID("cluster_cull"),
+    auto cluster_cull = m_render_graph.add_compute_pass(AID("cluster_cull"),
                                     {m_render_graph.write(AID("dyn_cluster_light_counts")),
                                      m_render_graph.write(AID("dyn_cluster_light_indices")),
                                      m_render_graph.read(AID("dyn_gpu_universal_light_data"))},
@@ -565,6 +631,7 @@ vulkan_render::setup_instanced_render_graph()
                                             dispatch_cluster_cull_impl(cmd);
                                         }
                                     });
+    cluster_cull->set_async_compute(true);
 
     // Selection mask pass — render outlined objects as flat white to R8 mask
     m_render_graph.add_graphics_pass(AID("selection_mask"),
@@ -572,7 +639,8 @@ vulkan_render::setup_instanced_render_graph()
                                       m_render_graph.read(AID("dyn_camera_data")),
                                       m_render_graph.read(AID("dyn_object_buffer")),
                                       m_render_graph.read(AID("dyn_instance_slots")),
-                                      m_render_graph.read(AID("dyn_bone_matrices"))},
+                                      m_render_graph.read(AID("dyn_bone_matrices")),
+                                      m_render_graph.read(AID("dyn_skinned_vertices"))},
                                      get_render_pass(AID("selection_mask")),
                                      VkClearColorValue{0, 0, 0, 0},
                                      [this](VkCommandBuffer cmd)
@@ -609,6 +677,7 @@ vulkan_render::setup_instanced_render_graph()
             m_render_graph.read(AID("dyn_cluster_config")),
             m_render_graph.read(AID("dyn_instance_slots")),
             m_render_graph.read(AID("dyn_bone_matrices")),
+            m_render_graph.read(AID("dyn_skinned_vertices")),
             m_render_graph.read(AID("dyn_material_buffer")),
             m_render_graph.read(AID("dyn_shadow_data")),
             m_render_graph.read(AID("dyn_probe_data")),
@@ -655,6 +724,21 @@ vulkan_render::setup_instanced_render_graph()
                                         ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
                                         : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
 
+    auto& device = glob::glob_state().getr_render().device;
+    m_render_graph.set_transient_allocator(device.get_vma_allocator_provider());
+
+    // Culling overlaps shadows and UI on the compute queue when the device has one
+    if (m_render_config.async_compute && device.has_async_compute())
+    {
+        m_render_graph.set_async_compute(device.graphics_queue_family(),
+                                         device.compute_queue_family(),
+                                         [this, &device](rg_queue q)
+                                         {
+                                             return device.acquire_segment(
+                                                 *m_current_frame->frame, q);
+                                         });
+    }
+
     bool result = m_render_graph.compile();
     KRG_check(result, "Instanced render graph compilation failed");
 }
@@ -65,6 +65,48 @@ vulkan_render::upload_instance_slots(render::frame_state& frame)
     frame.buffers.instance_slots.end();
 }
 
+void
+vulkan_render::upload_skinning_jobs(render::frame_state& frame)
+{
+    KRG_check_render_thread();
+    if (m_skinning_jobs_staging.empty())
+    {
+        return;
+    }
+
+    auto& device = glob::glob_state().getr_render().device;
+
+    const size_t jobs_size = m_skinning_jobs_staging.size() * sizeof(gpu::skinning_job);
+    if (jobs_size >= frame.buffers.skinning_jobs.get_alloc_size())
+    {
+        auto old_buffer = std::move(frame.buffers.skinning_jobs);
+        frame.buffers.skinning_jobs = device.create_buffer(
+            jobs_size * 2, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+        ALOG_INFO("Reallocating skinning_jobs buffer {} => {}",
+                  old_buffer.get_alloc_size(),
+                  frame.buffers.skinning_jobs.get_alloc_size());
+    }
+
+    // The pool is written and read on the GPU only
+    const size_t vertices_size = size_t(m_skinned_vertex_count) * sizeof(gpu::vertex_data);
+    if (vertices_size >= frame.buffers.skinned_vertices.get_alloc_size())
+    {
+        auto old_buffer = std::move(frame.buffers.skinned_vertices);
+        frame.buffers.skinned_vertices = device.create_buffer(
+            vertices_size * 2,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY);
+        ALOG_INFO("Reallocating skinned_vertices buffer {} => {}",
+                  old_buffer.get_alloc_size(),
+                  frame.buffers.skinned_vertices.get_alloc_size());
+    }
+
+    frame.buffers.skinning_jobs.begin();
+    auto* dst = (gpu::skinning_job*)frame.buffers.skinning_jobs.allocate_data((uint32_t)jobs_size);
+    memcpy(dst, m_skinning_jobs_staging.data(), jobs_size);
+    frame.buffers.skinning_jobs.end();
+}
+
 namespace
 {
 // Per-pass shadow cull volume. One value type covers all three pass kinds
@@ -133,7 +175,8 @@ void
 build_culled_shadow_batches(render_line_container& r,
                             std::vector<uint32_t>& staging,
                             std::vector<draw_batch>& out_batches,
-                            const shadow_cull_volume& cull)
+                            const shadow_cull_volume& cull,
+                            uint32_t lod_bias)
 {
     if (r.empty())
     {
@@ -141,6 +184,7 @@ build_culled_shadow_batches(render_line_container& r,
     }
 
     mesh_data* cur_mesh = nullptr;
+    object_draw_range cur_range;
     auto batch_start = (uint32_t)staging.size();
 
     auto flush = [&]()
@@ -153,7 +197,10 @@ build_culled_shadow_batches(render_line_container& r,
                                    .instance_count = instance_count,
                                    .first_instance_offset = batch_start,
                                    .outlined = false,
-                                   .cast_shadows = true});
+                                   .cast_shadows = true,
+                                   .vertex_offset = cur_range.vertex_offset,
+                                   .first_index = cur_range.first_index,
+                                   .index_count = cur_range.index_count});
         }
         batch_start = (uint32_t)staging.size();
     };
@@ -169,11 +216,16 @@ build_culled_shadow_batches(render_line_container& r,
             continue;
         }
 
-        if (cur_mesh && cur_mesh != obj->mesh)
+        // Skinned instances and mesh chunks each have their own draw range; LOD
+        // levels of one mesh batch per level
+        auto range = shadow_draw_range_of(*obj, lod_bias);
+        if (cur_mesh &&
+            (cur_mesh != obj->mesh || cur_mesh->draws_per_object() || range != cur_range))
         {
             flush();
         }
         cur_mesh = obj->mesh;
+        cur_range = range;
         staging.push_back(obj->slot());
     }
     flush();
@@ -187,16 +239,17 @@ build_shadow_pass_batches(std::unordered_map<std::string, render_line_container>
                           std::unordered_map<std::string, render_line_container>& outline_queue,
                           std::vector<uint32_t>& staging,
                           std::vector<draw_batch>& out,
-                          const shadow_cull_volume& cull)
+                          const shadow_cull_volume& cull,
+                          uint32_t lod_bias)
 {
     out.clear();
     for (auto& [queue_id, container] : default_queue)
     {
-        build_culled_shadow_batches(container, staging, out, cull);
+        build_culled_shadow_batches(container, staging, out, cull, lod_bias);
     }
     for (auto& [queue_id, container] : outline_queue)
     {
-        build_culled_shadow_batches(container, staging, out, cull);
+        build_culled_shadow_batches(container, staging, out, cull, lod_bias);
     }
 }
 }  // namespace
@@ -220,6 +273,7 @@ vulkan_render::build_batches_for_queue_into(render_line_container& r,
 
     mesh_data* cur_mesh = nullptr;
     bool cur_cast_shadows = true;
+    object_draw_range cur_range;
     auto batch_start = (uint32_t)m_instance_slots_staging.size();
 
     for (auto& obj : r)
@@ -240,8 +294,12 @@ vulkan_render::build_batches_for_queue_into(render_line_container& r,
             }
         }
 
-        // Mesh change = finalize previous batch
-        if (cur_mesh && cur_mesh != obj->mesh)
+        // Mesh change = finalize previous batch. Skinned instances and mesh chunks
+        // each have their own draw range, so they always end one; so does a change
+        // of LOD level.
+        auto range = draw_range_of(*obj);
+        if (cur_mesh &&
+            (cur_mesh != obj->mesh || cur_mesh->draws_per_object() || range != cur_range))
         {
             uint32_t instance_count = (uint32_t)m_instance_slots_staging.size() - batch_start;
             if (instance_count > 0)
@@ -251,13 +309,17 @@ vulkan_render::build_batches_for_queue_into(render_line_container& r,
                                        .instance_count = instance_count,
                                        .first_instance_offset = batch_start,
                                        .outlined = outlined,
-                                       .cast_shadows = cur_cast_shadows});
+                                       .cast_shadows = cur_cast_shadows,
+                                       .vertex_offset = cur_range.vertex_offset,
+                                       .first_index = cur_range.first_index,
+                                       .index_count = cur_range.index_count});
             }
             batch_start = (uint32_t)m_instance_slots_staging.size();
         }
 
         cur_mesh = obj->mesh;
         cur_cast_shadows = (obj->layer_flags & render::LAYER_CAST_SHADOWS) != 0;
+        cur_range = range;
         m_instance_slots_staging.push_back(obj->slot());
     }
 
@@ -272,7 +334,10 @@ vulkan_render::build_batches_for_queue_into(render_line_container& r,
                                    .instance_count = instance_count,
                                    .first_instance_offset = batch_start,
                                    .outlined = outlined,
-                                   .cast_shadows = cur_cast_shadows});
+                                   .cast_shadows = cur_cast_shadows,
+                                   .vertex_offset = cur_range.vertex_offset,
+                                   .first_index = cur_range.first_index,
+                                   .index_count = cur_range.index_count});
         }
     }
 }
@@ -286,6 +351,50 @@ vulkan_render::prepare_instance_data(render::frame_state& frame)
     m_draw_batches.clear();
     m_debug_draw_batches.clear();
 
+    // Pre-skinning: every skinned instance gets its own range of the skinned
+    // vertex pool, skinned once by the pre_skin pass and then drawn as static
+    // vertices by the main, shadow and selection-mask passes alike
+    m_skinning_jobs_staging.clear();
+    m_skinned_vertex_count = 0;
+
+    auto add_skinning_jobs = [this](render_line_container& r)
+    {
+        for (auto& obj : r)
+        {
+            auto* mesh = obj->mesh;
+            if (!mesh || !mesh->m_is_skinned || mesh->vertices_size() == 0)
+            {
+                continue;
+            }
+
+            obj->skinned_first_vertex = (int32_t)m_skinned_vertex_count;
+            m_skinning_jobs_staging.push_back(
+                {.src_vertices = gpu::make_bda_addr(mesh->m_vertex_buffer.device_address()),
+                 .first_vertex = m_skinned_vertex_count,
+                 .vertex_count = mesh->vertices_size(),
+                 .bone_offset = obj->gpu_data.bone_offset,
+                 .bone_count = obj->gpu_data.bone_count,
+                 .compact = mesh->m_vertex_format == vertex_format::compact ? 1u : 0u,
+                 .position_scale = mesh->m_dequant.scale,
+                 .position_offset = mesh->m_dequant.offset});
+            m_skinned_vertex_count += mesh->vertices_size();
+        }
+    };
+    for (auto* queue : {&m_default_render_object_queue,
+                        &m_outline_render_object_queue,
+                        &m_debug_render_object_queue})
+    {
+        for (auto& [queue_id, container] : *queue)
+        {
+            add_skinning_jobs(container);
+        }
+    }
+    add_skinning_jobs(m_transparent_render_object_queue);
+
+    // Levels are picked once per frame against the camera; shadow passes reuse them
+    // (discrete chains with the configured bias) so every pass draws the same surface
+    select_lods();
+
     // Build batches for default queue
     for (auto& [queue_id, container] : m_default_render_object_queue)
     {
@@ -312,6 +421,9 @@ vulkan_render::prepare_instance_data(render::frame_state& frame)
     // (called before prepare_instance_data in prepare_draw_resources).
     if (m_render_config.shadows.enabled)
     {
+        const uint32_t lod_bias =
+            m_render_config.lod.enabled ? m_render_config.lod.shadow_bias : 0;
+
         // CSM cascades: cull against each cascade's ortho frustum.
         for (uint32_t c = 0; c < m_render_config.shadows.cascade_count; ++c)
         {
@@ -320,7 +432,8 @@ vulkan_render::prepare_instance_data(render::frame_state& frame)
                                       m_instance_slots_staging,
                                       m_cascade_shadow_batches[c],
                                       shadow_cull_volume::from_frustum(
-                                          m_shadow_config.directional.cascades[c].view_proj));
+                                          m_shadow_config.directional.cascades[c].view_proj),
+                                      lod_bias);
         }
 
         // Local lights: spots cull against their perspective frustum; points use a
@@ -336,13 +449,15 @@ vulkan_render::prepare_instance_data(render::frame_state& frame)
                     m_outline_render_object_queue,
                     m_instance_slots_staging,
                     m_local_shadow_batches[i * 2],
-                    shadow_cull_volume::point(cull.position, cull.front_dir, cull.radius, false));
+                    shadow_cull_volume::point(cull.position, cull.front_dir, cull.radius, false),
+                    lod_bias);
                 build_shadow_pass_batches(
                     m_default_render_object_queue,
                     m_outline_render_object_queue,
                     m_instance_slots_staging,
                     m_local_shadow_batches[i * 2 + 1],
-                    shadow_cull_volume::point(cull.position, cull.front_dir, cull.radius, true));
+                    shadow_cull_volume::point(cull.position, cull.front_dir, cull.radius, true),
+                    lod_bias);
             }
             else
             {
@@ -351,13 +466,134 @@ vulkan_render::prepare_instance_data(render::frame_state& frame)
                     m_outline_render_object_queue,
                     m_instance_slots_staging,
                     m_local_shadow_batches[i * 2],
-                    shadow_cull_volume::from_frustum(m_shadow_config.local_shadows[i].view_proj));
+                    shadow_cull_volume::from_frustum(m_shadow_config.local_shadows[i].view_proj),
+                    lod_bias);
             }
         }
     }
 
     // Upload all instance slots
     upload_instance_slots(frame);
+    upload_skinning_jobs(frame);
+}
+
+object_draw_range
+draw_range_of(const vulkan_render_data& obj)
+{
+    auto* mesh = obj.mesh;
+    if (!mesh)
+    {
+        return {};
+    }
+
+    if (mesh->m_is_skinned)
+    {
+        return {.vertex_offset = obj.skinned_first_vertex};
+    }
+
+    if (mesh->is_chunked())
+    {
+        const auto& lod = mesh->m_lods[obj.mesh_lod];
+        return {.vertex_offset = int32_t(obj.mesh_chunk * mesh->m_chunk_vertex_count),
+                .first_index = lod.first_index,
+                .index_count = lod.index_count};
+    }
+
+    // Level 0 is the whole main list, drawn as before
+    if (mesh->has_discrete_lods() && obj.mesh_lod > 0)
+    {
+        const auto& lod = mesh->m_lods[std::min<size_t>(obj.mesh_lod, mesh->m_lods.size() - 1)];
+        return {.first_index = lod.first_index, .index_count = lod.index_count};
+    }
+
+    return {};
+}
+
+object_draw_range
+shadow_draw_range_of(const vulkan_render_data& obj, uint32_t lod_bias)
+{
+    auto* mesh = obj.mesh;
+    if (!mesh || mesh->draws_per_object())
+    {
+        return draw_range_of(obj);
+    }
+
+    if (mesh->has_discrete_lods())
+    {
+        const auto level = std::min<size_t>(obj.mesh_lod + lod_bias, mesh->m_lods.size() - 1);
+        if (level > 0)
+        {
+            const auto& lod = mesh->m_lods[level];
+            return {.first_index = lod.first_index, .index_count = lod.index_count};
+        }
+    }
+
+    if (mesh->m_shadow_index_count)
+    {
+        return {.first_index = mesh->m_shadow_first_index,
+                .index_count = mesh->m_shadow_index_count};
+    }
+    return {};
+}
+
+void
+vulkan_render::select_lods()
+{
+    // CDLOD selection: a chunk takes the finest level whose range reaches its nearest
+    // point. Levels' ranges double, and the vertex shader morphs each level into the
+    // next over the far end of its range, so neighbours never differ by more than one
+    // level and switching never pops.
+    //
+    // Discrete chains: an object takes the coarsest level whose error, scaled by its
+    // world bounding radius and projected at the sphere's nearest point, stays within
+    // lod.error_pixels of the scene target.
+    const auto& lod_cfg = m_render_config.lod;
+    const float pixels_per_unit =
+        0.5f * float(m_scene_lowres_height) * std::abs(m_camera_data.projection[1][1]);
+
+    auto select = [&](render_line_container& r)
+    {
+        for (auto& obj : r)
+        {
+            auto* mesh = obj->mesh;
+            if (!mesh || mesh->m_lods.empty())
+            {
+                continue;
+            }
+
+            float dist =
+                glm::length(obj->gpu_data.bounding_sphere_center - m_camera_data.position) -
+                obj->gpu_data.bounding_radius;
+
+            uint32_t lod = 0;
+            const auto last = (uint32_t)mesh->m_lods.size() - 1;
+            if (mesh->is_chunked())
+            {
+                lod = select_chunk_lod(mesh->m_lods, dist);
+            }
+            else if (lod_cfg.enabled && dist > 0.0f && obj->gpu_data.bounding_radius > 0.0f)
+            {
+                const float max_error =
+                    lod_cfg.error_pixels * dist / (obj->gpu_data.bounding_radius * pixels_per_unit);
+                while (lod < last && mesh->m_lods[lod + 1].error <= max_error)
+                {
+                    ++lod;
+                }
+            }
+            obj->mesh_lod = lod;
+        }
+    };
+
+    for (auto* queue : {&m_default_render_object_queue,
+                        &m_outline_render_object_queue,
+                        &m_debug_render_object_queue})
+    {
+        for (auto& [queue_id, container] : *queue)
+        {
+            select(container);
+        }
+    }
+    select(m_transparent_render_object_queue);
 }
 
 void
@@ -367,7 +603,15 @@ vulkan_render::bind_mesh(VkCommandBuffer cmd, mesh_data* cur_mesh)
     KRG_check(cur_mesh->m_vertex_buffer.buffer(), "Vertex buffer is VK_NULL_HANDLE");
 
     VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(cmd, 0, 1, &cur_mesh->m_vertex_buffer.buffer(), &offset);
+    if (cur_mesh->m_is_skinned)
+    {
+        vkCmdBindVertexBuffers(
+            cmd, 0, 1, &m_current_frame->buffers.skinned_vertices.buffer(), &offset);
+    }
+    else
+    {
+        vkCmdBindVertexBuffers(cmd, 0, 1, &cur_mesh->m_vertex_buffer.buffer(), &offset);
+    }
 
     if (cur_mesh->has_indices())
     {
@@ -380,15 +624,23 @@ void
 vulkan_render::draw_mesh(VkCommandBuffer cmd,
                          mesh_data* m,
                          uint32_t instance_count,
-                         uint32_t first_instance)
+                         uint32_t first_instance,
+                         int32_t vertex_offset,
+                         uint32_t first_index,
+                         uint32_t index_count)
 {
     if (m->has_indices())
     {
-        vkCmdDrawIndexed(cmd, m->indices_size(), instance_count, 0, 0, first_instance);
+        vkCmdDrawIndexed(cmd,
+                         index_count ? index_count : m->indices_size(),
+                         instance_count,
+                         first_index,
+                         vertex_offset,
+                         first_instance);
     }
     else
     {
-        vkCmdDraw(cmd, m->vertices_size(), instance_count, 0, first_instance);
+        vkCmdDraw(cmd, m->vertices_size(), instance_count, (uint32_t)vertex_offset, first_instance);
     }
 }
 
@@ -433,18 +685,32 @@ vulkan_render::bind_global_descriptors(VkCommandBuffer cmd, render::frame_state&
     (void)current_frame;
 }
 
-void
+bool
 vulkan_render::bind_material(VkCommandBuffer cmd,
                              material_data* cur_material,
                              render::frame_state& current_frame,
                              pipeline_ctx& ctx,
-                             bool outline)
+                             bool outline,
+                             bool compact)
 {
-    auto pipeline = outline ? cur_material->get_shader_effect()->m_with_stencil_pipeline
-                            : cur_material->get_shader_effect()->m_pipeline;
-    ctx.pipeline_layout = cur_material->get_shader_effect()->m_pipeline_layout;
+    auto* se = cur_material->get_shader_effect();
+    auto pipeline = se->get_pipeline(compact, outline);
+    if (pipeline == VK_NULL_HANDLE)
+    {
+        if (!se->m_reported_no_compact)
+        {
+            ALOG_WARN("'{}' does not decode compact vertices; its compact meshes are skipped",
+                      se->get_id().cstr());
+            se->m_reported_no_compact = true;
+        }
+        ctx = {};
+        return false;
+    }
+
+    ctx.pipeline_layout = se->m_pipeline_layout;
     ctx.cur_material_idx = cur_material->gpu_idx();
     ctx.cur_material_type_idx = cur_material->gpu_type_idx();
+    ctx.compact = compact;
 
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 
@@ -467,6 +733,7 @@ vulkan_render::bind_material(VkCommandBuffer cmd,
                             &m_bindless_set,
                             0,
                             nullptr);
+    return true;
 }
 
 void
@@ -803,7 +1070,7 @@ vulkan_render::capture_ui_snapshot()
 
     ImDrawData* dd = ImGui::GetDrawData();
 
-    // Write into the main thread's current input slot (frame parity); the render
+    // Write into the main thread's current input slot (frame slot); the render
     // thread reads the matching slot via m_draw_frame_slot. The pipeline gate
     // keeps the render thread off this slot, so no publish/atomic is needed.
     ui_draw_snapshot& s = m_ui_snapshots[m_build_frame_slot];
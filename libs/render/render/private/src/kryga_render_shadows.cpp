@@ -64,82 +64,80 @@ vulkan_render::compute_shadow_atlas_layout()
 // Shadow Atlas Drawing
 // ============================================================================
 
+namespace
+{
+
 void
-vulkan_render::draw_shadow_atlas(VkCommandBuffer cmd)
+set_tile_viewport(VkCommandBuffer cmd, uint32_t x, uint32_t y, uint32_t size)
+{
+    VkViewport vp{};
+    vp.x = static_cast<float>(x);
+    vp.y = static_cast<float>(y);
+    vp.width = static_cast<float>(size);
+    vp.height = static_cast<float>(size);
+    vp.minDepth = 0.0f;
+    vp.maxDepth = 1.0f;
+    vkCmdSetViewport(cmd, 0, 1, &vp);
+
+    VkRect2D sc{};
+    sc.offset = {.x = static_cast<int32_t>(x), .y = static_cast<int32_t>(y)};
+    sc.extent = {.width = size, .height = size};
+    vkCmdSetScissor(cmd, 0, 1, &sc);
+}
+
+}  // namespace
+
+uint32_t
+vulkan_render::shadow_atlas_item_count() const
 {
     if (!m_render_config.shadows.enabled)
     {
-        return;
+        return 0;
     }
-    KRG_check(m_shadow_se, "shadow shader effect must exist when shadows are enabled");
+    return m_render_config.shadows.cascade_count + m_shadow_config.shadowed_local_count * 2;
+}
 
-    // CSM cascades
-    for (uint32_t c = 0; c < m_render_config.shadows.cascade_count; ++c)
+void
+vulkan_render::draw_shadow_atlas(VkCommandBuffer cmd)
+{
+    draw_shadow_atlas_range(cmd, 0, shadow_atlas_item_count());
+}
+
+void
+vulkan_render::draw_shadow_atlas_range(VkCommandBuffer cmd, uint32_t begin, uint32_t end)
+{
+    if (!m_render_config.shadows.enabled)
     {
-        auto& tile = m_csm_tiles[c];
-
-        VkViewport vp{};
-        vp.x = static_cast<float>(tile.x);
-        vp.y = static_cast<float>(tile.y);
-        vp.width = static_cast<float>(tile.size);
-        vp.height = static_cast<float>(tile.size);
-        vp.minDepth = 0.0f;
-        vp.maxDepth = 1.0f;
-        vkCmdSetViewport(cmd, 0, 1, &vp);
-
-        VkRect2D sc{};
-        sc.offset = {.x = static_cast<int32_t>(tile.x), .y = static_cast<int32_t>(tile.y)};
-        sc.extent = {.width = tile.size, .height = tile.size};
-        vkCmdSetScissor(cmd, 0, 1, &sc);
-
-        draw_shadow_pass(cmd, c);
+        return;
     }
+    KRG_check(m_shadow_se, "shadow shader effect must exist when shadows are enabled");
 
-    // Local light shadows
-    for (uint32_t i = 0; i < m_shadow_config.shadowed_local_count; ++i)
+    // Items are atlas tiles: CSM cascades first, then two hemispheres per local light.
+    // Every item sets its own viewport, so any range records on its own command buffer.
+    const uint32_t cascades = m_render_config.shadows.cascade_count;
+    for (uint32_t item = begin; item < end; ++item)
     {
-        bool is_point = m_shadow_config.local_shadows[i].shadow_info.z == KGPU_light_type_point;
-
-        // Front hemisphere
+        if (item < cascades)
         {
-            auto& tile = m_local_tiles[i * 2];
-            VkViewport vp{};
-            vp.x = static_cast<float>(tile.x);
-            vp.y = static_cast<float>(tile.y);
-            vp.width = static_cast<float>(tile.size);
-            vp.height = static_cast<float>(tile.size);
-            vp.minDepth = 0.0f;
-            vp.maxDepth = 1.0f;
-            vkCmdSetViewport(cmd, 0, 1, &vp);
-
-            VkRect2D sc{};
-            sc.offset = {.x = static_cast<int32_t>(tile.x), .y = static_cast<int32_t>(tile.y)};
-            sc.extent = {.width = tile.size, .height = tile.size};
-            vkCmdSetScissor(cmd, 0, 1, &sc);
-
-            draw_shadow_local_pass(cmd, i, false);
+            auto& tile = m_csm_tiles[item];
+            set_tile_viewport(cmd, tile.x, tile.y, tile.size);
+            draw_shadow_pass(cmd, item);
+            continue;
         }
 
+        const uint32_t i = (item - cascades) / 2;
+        const bool back_face = (item - cascades) % 2 != 0;
+
         // Back hemisphere (point lights only)
-        if (is_point)
+        if (back_face &&
+            m_shadow_config.local_shadows[i].shadow_info.z != KGPU_light_type_point)
         {
-            auto& tile = m_local_tiles[i * 2 + 1];
-            VkViewport vp{};
-            vp.x = static_cast<float>(tile.x);
-            vp.y = static_cast<float>(tile.y);
-            vp.width = static_cast<float>(tile.size);
-            vp.height = static_cast<float>(tile.size);
-            vp.minDepth = 0.0f;
-            vp.maxDepth = 1.0f;
-            vkCmdSetViewport(cmd, 0, 1, &vp);
-
-            VkRect2D sc{};
-            sc.offset = {.x = static_cast<int32_t>(tile.x), .y = static_cast<int32_t>(tile.y)};
-            sc.extent = {.width = tile.size, .height = tile.size};
-            vkCmdSetScissor(cmd, 0, 1, &sc);
-
-            draw_shadow_local_pass(cmd, i, true);
+            continue;
         }
+
+        auto& tile = m_local_tiles[i * 2 + (back_face ? 1 : 0)];
+        set_tile_viewport(cmd, tile.x, tile.y, tile.size);
+        draw_shadow_local_pass(cmd, i, back_face);
     }
 }
 
@@ -310,7 +308,8 @@ vulkan_render::draw_shadow_pass(VkCommandBuffer cmd, uint32_t cascade_idx)
     auto* se = m_shadow_se;
     KRG_check(!se->m_failed_load, "shadow shader effect failed to load");
 
-    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, se->m_pipeline);
+    // Bound per batch: compact meshes draw through the compact variant
+    VkPipeline bound_pipeline = VK_NULL_HANDLE;
 
     // Shadow push constants with cascade index
     gpu::push_constants_shadow pc = m_shadow_pc;
@@ -326,8 +325,21 @@ vulkan_render::draw_shadow_pass(VkCommandBuffer cmd, uint32_t cascade_idx)
             continue;
         }
 
-        // Safe mesh binding — copy handle to local to avoid null-handle Vulkan errors
-        VkBuffer vb = batch.mesh->m_vertex_buffer.buffer();
+        auto pipeline = se->get_pipeline(batch.mesh->draws_compact(), false);
+        if (pipeline == VK_NULL_HANDLE)
+        {
+            continue;
+        }
+        if (pipeline != bound_pipeline)
+        {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            bound_pipeline = pipeline;
+        }
+
+        // Safe mesh binding — copy handle to local to avoid null-handle Vulkan errors.
+        // Skinned meshes draw their pre-skinned vertices from the frame's pool.
+        VkBuffer vb = batch.mesh->m_is_skinned ? m_current_frame->buffers.skinned_vertices.buffer()
+                                               : batch.mesh->m_vertex_buffer.buffer();
         if (!vb)
         {
             continue;
@@ -357,11 +369,20 @@ vulkan_render::draw_shadow_pass(VkCommandBuffer cmd, uint32_t cascade_idx)
 
         if (indexed)
         {
-            vkCmdDrawIndexed(cmd, batch.mesh->indices_size(), batch.instance_count, 0, 0, 0);
+            vkCmdDrawIndexed(cmd,
+                             batch.index_count ? batch.index_count : batch.mesh->indices_size(),
+                             batch.instance_count,
+                             batch.first_index,
+                             batch.vertex_offset,
+                             0);
         }
         else
         {
-            vkCmdDraw(cmd, batch.mesh->vertices_size(), batch.instance_count, 0, 0);
+            vkCmdDraw(cmd,
+                      batch.mesh->vertices_size(),
+                      batch.instance_count,
+                      (uint32_t)batch.vertex_offset,
+                      0);
         }
     }
 }
@@ -408,7 +429,7 @@ vulkan_render::draw_shadow_local_pass(VkCommandBuffer cmd, uint32_t shadow_idx,
         return;
     }
 
-    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, se->m_pipeline);
+    VkPipeline bound_pipeline = VK_NULL_HANDLE;
 
     // Shadow push constants
     gpu::push_constants_shadow pc = m_shadow_pc;
@@ -432,7 +453,19 @@ vulkan_render::draw_shadow_local_pass(VkCommandBuffer cmd, uint32_t shadow_idx,
             continue;
         }
 
-        VkBuffer vb = batch.mesh->m_vertex_buffer.buffer();
+        auto pipeline = se->get_pipeline(batch.mesh->draws_compact(), false);
+        if (pipeline == VK_NULL_HANDLE)
+        {
+            continue;
+        }
+        if (pipeline != bound_pipeline)
+        {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            bound_pipeline = pipeline;
+        }
+
+        VkBuffer vb = batch.mesh->m_is_skinned ? m_current_frame->buffers.skinned_vertices.buffer()
+                                               : batch.mesh->m_vertex_buffer.buffer();
         if (!vb)
         {
             continue;
@@ -462,11 +495,20 @@ vulkan_render::draw_shadow_local_pass(VkCommandBuffer cmd, uint32_t shadow_idx,
 
         if (indexed)
         {
-            vkCmdDrawIndexed(cmd, batch.mesh->indices_size(), batch.instance_count, 0, 0, 0);
+            vkCmdDrawIndexed(cmd,
+                             batch.index_count ? batch.index_count : batch.mesh->indices_size(),
+                             batch.instance_count,
+                             batch.first_index,
+                             batch.vertex_offset,
+                             0);
         }
         else
         {
-            vkCmdDraw(cmd, batch.mesh->vertices_size(), batch.instance_count, 0, 0);
+            vkCmdDraw(cmd,
+                      batch.mesh->vertices_size(),
+                      batch.instance_count,
+                      (uint32_t)batch.vertex_offset,
+                      0);
         }
     }
 }
@@ -602,5 +602,45 @@ vulkan_render::dispatch_frustum_cull_impl(VkCommandBuffer cmd)
     // Note: Barrier to graphics is handled by render graph
 }
 
+void
+vulkan_render::dispatch_pre_skin_impl(VkCommandBuffer cmd)
+{
+    ZoneScopedN("Render::DispatchPreSkinImpl");
+
+    if (m_skinned_vertex_count == 0)
+    {
+        return;
+    }
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pre_skin_shader->m_pipeline);
+
+    vkCmdBindDescriptorSets(cmd,
+                            VK_PIPELINE_BIND_POINT_COMPUTE,
+                            m_pre_skin_shader->m_pipeline_layout,
+                            0,
+                            1,
+                            &m_pre_skin_descriptor_set,
+                            0,
+                            nullptr);
+
+    struct PreSkinPushConstants
+    {
+        uint32_t job_count;
+        uint32_t vertex_count;
+    } pc{};
+
+    pc.job_count = static_cast<uint32_t>(m_skinning_jobs_staging.size());
+    pc.vertex_count = m_skinned_vertex_count;
+
+    vkCmdPushConstants(
+        cmd, m_pre_skin_shader->m_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pc), &pc);
+
+    // One thread per output vertex over all jobs
+    uint32_t workgroup_size = 64;  // Must match local_size_x in shader
+    vkCmdDispatch(cmd, (pc.vertex_count + workgroup_size - 1) / workgroup_size, 1, 1);
+
+    // Note: Barrier to the vertex input of the draw passes is handled by render graph
+}
+
 }  // namespace render
 }  // namespace kryga
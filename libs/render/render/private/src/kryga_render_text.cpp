@@ -2,13 +2,10 @@
 #include "vulkan_render/font_atlas.h"
 #include "vulkan_render/vulkan_render_loader.h"
 #include "vulkan_render/render_system.h"
-#include "vulkan_render/types/vulkan_shader_effect_data.h"
 
 #include <global_state/global_state.h>
 #include <vfs/vfs.h>
 
-#include <gpu_types/gpu_generic_constants.h>
-
 #include <utils/id.h>
 
 #include <utils/buffer.h>
@@ -22,247 +19,281 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
+#include <string>
 #include <vector>
 
 namespace kryga::render
 {
 
-// Bake a TTF into a printable-ASCII atlas under `id`: rasterize the glyphs into an
-// R8 coverage atlas, capture per-glyph metrics, then upload an RGBA8 (white,
-// coverage in alpha) texture and record its bindless index for the text shader.
-// The TTF is read through the VFS. Independent of ImGui, so it works in game
-// builds. Owned by the loader like any other render resource; the bindless upload
-// goes through the renderer.
-font_atlas*
-vulkan_render_loader::load_font(const kryga::utils::id& id,
-                                std::string_view ttf_path,
-                                float bake_height)
+namespace
 {
-    std::vector<uint8_t> ttf;
-    if (!glob::glob_state().getr_vfs().read_bytes(vfs::rid(std::string(ttf_path)), ttf))
-    {
-        ALOG_ERROR("UI font '{}': failed to read {}", id.str(), std::string(ttf_path));
-        return nullptr;
-    }
 
-    constexpr int k_atlas_w = 512;
-    constexpr int k_atlas_h = 512;
-    const float k_bake_height = bake_height;  // bake large; the draw scales down
+// SDF spread in px at the bake size; also the glyph padding in the atlas cell.
+constexpr int k_sdf_padding = 6;
 
-    std::vector<uint8_t> coverage(static_cast<size_t>(k_atlas_w) * k_atlas_h, 0);
-    std::array<stbtt_packedchar, font_atlas::k_char_count> packed{};
-
-    stbtt_pack_context pc;
-    if (!stbtt_PackBegin(&pc, coverage.data(), k_atlas_w, k_atlas_h, 0, 1, nullptr))
-    {
-        ALOG_ERROR("UI font '{}': stbtt_PackBegin failed", id.str());
-        return nullptr;
-    }
-    // No oversampling: keep glyph atlas rects in 1x px so size (x1-x0) stays
-    // consistent with xadvance/xoff (both 1x). The 48px bake downscaled to the
-    // render size via the linear sampler is plenty smooth. (Oversampling would
-    // need stbtt_GetPackedQuad-style /oversample handling on the rects.)
-    stbtt_PackSetOversampling(&pc, 1, 1);
-    stbtt_PackFontRange(&pc,
-                        ttf.data(),
-                        0,
-                        k_bake_height,
-                        font_atlas::k_first_char,
-                        font_atlas::k_char_count,
-                        packed.data());
-    stbtt_PackEnd(&pc);
-
-    // Vertical metrics for line height.
-    stbtt_fontinfo info;
-    stbtt_InitFont(&info, ttf.data(), stbtt_GetFontOffsetForIndex(ttf.data(), 0));
-    int ascent = 0, descent = 0, line_gap = 0;
-    stbtt_GetFontVMetrics(&info, &ascent, &descent, &line_gap);
-    const float vscale = stbtt_ScaleForPixelHeight(&info, k_bake_height);
-
-    font_atlas atlas;
-    atlas.m_bake_height = k_bake_height;
-    atlas.m_ascent = ascent * vscale;
-    atlas.m_line_height = (ascent - descent + line_gap) * vscale;
-
-    // Tabular digits: bake every digit to the widest digit's advance and center
-    // the glyph in that cell, so a changing counter does not jitter.
-    float max_digit_adv = 0.f;
-    for (char d = '0'; d <= '9'; ++d)
+// stb_truetype-backed glyph_source. The font data and stbtt_fontinfo are only
+// read after init, so metrics() (render thread) and rasterize() (atlas worker)
+// can run concurrently. Digits are reported at the widest digit's advance and
+// centered in that cell (tabular), so a changing counter does not jitter.
+class stb_glyph_source final : public glyph_source
+{
+public:
+    stb_glyph_source(std::vector<uint8_t> ttf, float bake_height)
+        : m_ttf(std::move(ttf))
+        , m_bake_height(bake_height)
     {
-        max_digit_adv = std::max(max_digit_adv, packed[d - font_atlas::k_first_char].xadvance);
     }
 
-    for (int i = 0; i < font_atlas::k_char_count; ++i)
+    bool
+    init()
     {
-        const stbtt_packedchar& s = packed[i];
-        glyph_metrics& g = atlas.m_glyphs[i];
-        g.uv0 = {s.x0 / static_cast<float>(k_atlas_w), s.y0 / static_cast<float>(k_atlas_h)};
-        g.uv1 = {s.x1 / static_cast<float>(k_atlas_w), s.y1 / static_cast<float>(k_atlas_h)};
-        g.size = {static_cast<float>(s.x1 - s.x0), static_cast<float>(s.y1 - s.y0)};
-        g.bearing = {s.xoff, s.yoff};
-        g.advance = s.xadvance;
-
-        const char c = static_cast<char>(font_atlas::k_first_char + i);
-        if (c >= '0' && c <= '9')
+        if (!stbtt_InitFont(&m_info, m_ttf.data(), stbtt_GetFontOffsetForIndex(m_ttf.data(), 0)))
         {
-            g.bearing.x += (max_digit_adv - g.advance) * 0.5f;
-            g.advance = max_digit_adv;
+            return false;
         }
-    }
+        m_scale = stbtt_ScaleForPixelHeight(&m_info, m_bake_height);
 
-    // Expand R8 coverage -> RGBA8 (white, coverage in alpha) for create_texture.
-    kryga::utils::buffer rgba;
-    rgba.resize(static_cast<size_t>(k_atlas_w) * k_atlas_h * 4);
-    auto* dst = reinterpret_cast<uint8_t*>(rgba.data());
-    for (int i = 0; i < k_atlas_w * k_atlas_h; ++i)
-    {
-        dst[i * 4 + 0] = 255;
-        dst[i * 4 + 1] = 255;
-        dst[i * 4 + 2] = 255;
-        dst[i * 4 + 3] = coverage[i];
+        int ascent = 0, descent = 0, line_gap = 0;
+        stbtt_GetFontVMetrics(&m_info, &ascent, &descent, &line_gap);
+        m_ascent = ascent * m_scale;
+        m_line_height = (ascent - descent + line_gap) * m_scale;
+
+        for (int d = '0'; d <= '9'; ++d)
+        {
+            int adv = 0, lsb = 0;
+            stbtt_GetCodepointHMetrics(&m_info, d, &adv, &lsb);
+            m_max_digit_adv = std::max(m_max_digit_adv, adv * m_scale);
+        }
+        return true;
     }
 
-    // Per-font texture debug name (ids are debug-only now) so atlases are
-    // distinguishable in logs/captures.
-    texture_data* td = glob::glob_state().getr_render().renderer.create_texture(
-        AID(("ui_font_atlas:" + id.str()).c_str()), rgba, k_atlas_w, k_atlas_h);
-    if (!td)
+    float
+    ascent() const
     {
-        ALOG_ERROR("UI font '{}': create_texture failed", id.str());
-        return nullptr;
+        return m_ascent;
     }
-    atlas.m_bindless_index = td->get_bindless_index();
-
-    font_atlas& stored = (m_fonts[id] = atlas);
-    ALOG_INFO("UI font '{}' baked: {}x{} bindless={}",
-              id.str(),
-              k_atlas_w,
-              k_atlas_h,
-              stored.m_bindless_index);
-    return &stored;
-}
-
-// Lay out and draw every text entry: one glyph quad per character, sized from the
-// baked metrics and placed against the live viewport per the entry's anchor. Pen
-// math is in pixels (top-left origin), converted to NDC per glyph. Right/bottom
-// anchors align the text block to that edge so a counter's right edge stays put.
-void
-vulkan_render::draw_ui_text(VkCommandBuffer cmd)
-{
-    auto& storage = m_loader->ui_texts_storage();
-    if (!m_ui_text_se || storage.active() == 0)
+    float
+    line_height() const
     {
-        return;
+        return m_line_height;
     }
 
-    const float vw = static_cast<float>(get_width() == 0 ? 1u : get_width());
-    const float vh = static_cast<float>(get_height() == 0 ? 1u : get_height());
-
-    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_ui_text_se->m_pipeline);
-    vkCmdBindDescriptorSets(cmd,
-                            VK_PIPELINE_BIND_POINT_GRAPHICS,
-                            m_ui_text_se->m_pipeline_layout,
-                            KGPU_textures_descriptor_sets,
-                            1,
-                            &m_bindless_set,
-                            0,
-                            nullptr);
-
-    struct ui_text_pc
-    {
-        glm::vec4 rect_ndc;
-        glm::vec4 uv_rect;
-        glm::vec4 color;
-        uint32_t tex_index;
-        uint32_t sampler_index;
-    };
-
-    const VkPipelineLayout pipeline_layout = m_ui_text_se->m_pipeline_layout;
-
-    // Single-lane storage (render_translator's content allocator owns lane 0).
-    // Iterate the live slots; the handle generations don't matter for the draw —
-    // an occupied slot holds a populated entry.
-    auto& lane = storage.lane(0);
-    const uint32_t slot_count = static_cast<uint32_t>(lane.size());
-
-    for (uint32_t slot = 0; slot < slot_count; ++slot)
+    bool
+    metrics(uint32_t codepoint, glyph_metrics& out) const override
     {
-        if (!lane.occupied(slot))
+        const int glyph = stbtt_FindGlyphIndex(&m_info, static_cast<int>(codepoint));
+        if (glyph == 0 && codepoint != ' ')
         {
-            continue;
+            return false;
         }
-        const ui_text_entry& e = *lane.at(slot);
 
-        if (e.text.empty())
+        int adv = 0, lsb = 0;
+        stbtt_GetGlyphHMetrics(&m_info, glyph, &adv, &lsb);
+        out.advance = adv * m_scale;
+
+        // Same box stbtt_GetGlyphSDF produces, so the quad matches the bitmap
+        int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+        stbtt_GetGlyphBitmapBox(&m_info, glyph, m_scale, m_scale, &x0, &y0, &x1, &y1);
+        if (x0 == x1 || y0 == y1)
         {
-            continue;
+            out.size = glm::vec2(0.f);
+            out.bearing = glm::vec2(0.f);
         }
-
-        // Resolve this entry's font (empty/unknown id -> loader default). Skip if
-        // even the default has not been baked.
-        font_atlas* fa = m_loader->get_font(e.font);
-        if (!fa || !fa->ready())
+        else
         {
-            continue;
+            out.size = glm::vec2(static_cast<float>(x1 - x0 + 2 * k_sdf_padding),
+                                 static_cast<float>(y1 - y0 + 2 * k_sdf_padding));
+            out.bearing = glm::vec2(static_cast<float>(x0 - k_sdf_padding),
+                                    static_cast<float>(y0 - k_sdf_padding));
         }
-        const font_atlas& font = *fa;
-        const uint32_t tex_index = font.bindless_index();
 
-        const float scale = e.font_size / font.bake_height();
+        if (codepoint >= '0' && codepoint <= '9')
+        {
+            out.bearing.x += (m_max_digit_adv - out.advance) * 0.5f;
+            out.advance = m_max_digit_adv;
+        }
+        return true;
+    }
 
-        float text_w = 0.f;
-        for (char ch : e.text)
+    bool
+    rasterize(uint32_t codepoint, glyph_bitmap& out) const override
+    {
+        const int glyph = stbtt_FindGlyphIndex(&m_info, static_cast<int>(codepoint));
+
+        int w = 0, h = 0, xoff = 0, yoff = 0;
+        unsigned char* sdf = stbtt_GetGlyphSDF(&m_info,
+                                               m_scale,
+                                               glyph,
+                                               k_sdf_padding,
+                                               128,
+                                               128.0f / static_cast<float>(k_sdf_padding),
+                                               &w,
+                                               &h,
+                                               &xoff,
+                                               &yoff);
+        if (!sdf)
         {
-            text_w += font.glyph(ch).advance * scale;
+            return false;
         }
 
-        const bool right = (e.anchor == 1 || e.anchor == 3);
-        const bool bottom = (e.anchor == 2 || e.anchor == 3);
+        out.width = static_cast<uint32_t>(w);
+        out.height = static_cast<uint32_t>(h);
+        out.pixels.assign(sdf, sdf + static_cast<size_t>(w) * h);
+        stbtt_FreeSDF(sdf, nullptr);
+        return true;
+    }
 
-        const float anchor_x = right ? (vw - static_cast<float>(e.x)) : static_cast<float>(e.x);
-        const float anchor_y = bottom ? (vh - static_cast<float>(e.y)) : static_cast<float>(e.y);
+private:
+    std::vector<uint8_t> m_ttf;
+    stbtt_fontinfo m_info{};
+    float m_bake_height = 0.f;
+    float m_scale = 1.f;
+    float m_ascent = 0.f;
+    float m_line_height = 0.f;
+    float m_max_digit_adv = 0.f;
+};
+
+}  // namespace
+
+// Register a TTF under `id` as a dynamic SDF glyph cache. Nothing is rasterized
+// here: glyphs are baked on the atlas worker the first time layout asks for them
+// and uploaded by update_fonts(). Printable ASCII is requested up front so HUD
+// text is resident within a frame or two of startup. Independent of ImGui, so it
+// works in game builds.
+font_atlas*
+vulkan_render_loader::load_font(const kryga::utils::id& id,
+                                std::string_view ttf_path,
+                                float bake_height)
+{
+    std::vector<uint8_t> ttf;
+    if (!glob::glob_state().getr_vfs().read_bytes(vfs::rid(std::string(ttf_path)), ttf))
+    {
+        ALOG_ERROR("UI font '{}': failed to read {}", id.str(), std::string(ttf_path));
+        return nullptr;
+    }
+
+    // The padded SDF of the tallest glyph has to fit in one atlas cell
+    const float k_max_bake =
+        static_cast<float>(font_atlas::k_cell_size - 2 * k_sdf_padding - 4);
+    const float sdf_height = std::min(bake_height, k_max_bake);
 
-        float pen_x = right ? (anchor_x - text_w) : anchor_x;
-        const float top_y = bottom ? (anchor_y - font.line_height() * scale) : anchor_y;
-        const float baseline_y = top_y + font.ascent() * scale;
+    auto source = std::make_unique<stb_glyph_source>(std::move(ttf), sdf_height);
+    if (!source->init())
+    {
+        ALOG_ERROR("UI font '{}': stbtt_InitFont failed", id.str());
+        return nullptr;
+    }
+
+    const float ascent = source->ascent();
+    const float line_height = source->line_height();
+    auto atlas = std::make_unique<font_atlas>(std::move(source), sdf_height, ascent, line_height);
+
+    for (uint32_t c = 32; c < 127; ++c)
+    {
+        atlas->acquire(c);
+        atlas->release(c);
+    }
 
-        for (char ch : e.text)
+    auto& slot = m_fonts[id];
+    if (slot)
+    {
+        // Re-load: drop layouts that point at the old atlas, then its pages
+        auto& renderer = glob::glob_state().getr_render().renderer;
+        renderer.ui_font_removed(slot.get());
+        for (auto& p : slot->pages())
         {
-            const glyph_metrics& g = font.glyph(ch);
+            if (p.texture)
+            {
+                renderer.release_texture(p.texture);
+            }
+        }
+    }
+    slot = std::move(atlas);
 
-            const float qx0 = pen_x + g.bearing.x * scale;
-            const float qy0 = baseline_y + g.bearing.y * scale;
-            const float qx1 = qx0 + g.size.x * scale;
-            const float qy1 = qy0 + g.size.y * scale;
+    ALOG_INFO("UI font '{}' registered: SDF bake {:.0f}px", id.str(), sdf_height);
+    return slot.get();
+}
 
-            pen_x += g.advance * scale;
+// Integrate glyphs the atlas workers finished and upload the pages they touched.
+// A page texture is created with its first glyph; later changes re-fill it in
+// place (same bindless slot). [render thread, once per frame]
+void
+vulkan_render_loader::update_fonts()
+{
+    KRG_check_render_thread();
 
-            // Whitespace/empty glyphs (e.g. space) have a zero-area quad — advance
-            // the pen but emit no draw.
-            if (g.size.x <= 0.f || g.size.y <= 0.f)
+    auto& renderer = glob::glob_state().getr_render().renderer;
+
+    for (auto& [id, font] : m_fonts)
+    {
+        font->pump();
+
+        auto& pages = font->pages();
+        for (uint32_t i = 0; i < pages.size(); ++i)
+        {
+            auto& p = pages[i];
+            if (!p.dirty)
             {
                 continue;
             }
 
-            ui_text_pc pc;
-            pc.rect_ndc = glm::vec4(qx0 / vw * 2.f - 1.f,
-                                    qy0 / vh * 2.f - 1.f,
-                                    qx1 / vw * 2.f - 1.f,
-                                    qy1 / vh * 2.f - 1.f);
-            pc.uv_rect = glm::vec4(g.uv0.x, g.uv0.y, g.uv1.x, g.uv1.y);
-            pc.color = e.color;
-            pc.tex_index = tex_index;
-            pc.sampler_index = KGPU_SAMPLER_LINEAR_CLAMP;
-
-            vkCmdPushConstants(cmd,
-                               pipeline_layout,
-                               VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                               0,
-                               sizeof(ui_text_pc),
-                               &pc);
-            vkCmdDraw(cmd, 6, 1, 0, 0);
+            kryga::utils::buffer data;
+            data.resize(p.pixels.size());
+            std::memcpy(data.data(), p.pixels.data(), p.pixels.size());
+
+            if (!p.texture)
+            {
+                p.texture = renderer.create_texture(
+                    AID(("ui_font_atlas:" + id.str() + ":" + std::to_string(i)).c_str()),
+                    data,
+                    font_atlas::k_page_size,
+                    font_atlas::k_page_size,
+                    VK_FORMAT_R8_UNORM,
+                    texture_format::unknown);
+                p.bindless_index =
+                    p.texture ? p.texture->get_bindless_index() : font_atlas::k_invalid;
+            }
+            else
+            {
+                renderer.update_texture(p.texture,
+                                        data,
+                                        font_atlas::k_page_size,
+                                        font_atlas::k_page_size,
+                                        VK_FORMAT_R8_UNORM,
+                                        texture_format::unknown);
+            }
+            p.dirty = false;
         }
     }
 }
 
+// Sync one text slot into the UI batch. An occupied slot holds a populated entry
+// (the handle generation doesn't matter here); a reset slot drops its glyphs. The
+// font is resolved now — a font that is not baked yet parks the line in the
+// batcher until prepare_ui_batch finds it.
+void
+vulkan_render::ui_text_changed(render::types::ui_text_handle h)
+{
+    KRG_check_render_thread();
+
+    auto& lane = m_loader->ui_texts_storage().lane(0);
+    const uint32_t slot = utils::local_of(h.index());
+
+    if (slot >= lane.size() || !lane.occupied(slot))
+    {
+        m_ui_batcher.remove_text(slot);
+        return;
+    }
+
+    const ui_text_entry& e = *lane.at(slot);
+    if (e.text.empty())
+    {
+        m_ui_batcher.remove_text(slot);
+        return;
+    }
+
+    m_ui_batcher.set_text(slot, e, m_loader->get_font(e.font));
+}
+
 }  // namespace kryga::render
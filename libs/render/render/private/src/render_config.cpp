@@ -276,6 +276,11 @@ render_config::validate()
     clamp_warn(outline.depth_threshold, 0.0f, 10.0f, "outline.depth_threshold");
     clamp_warn(outline.normal_threshold, 0.0f, 1.0f, "outline.normal_threshold");
 
+    // LOD: a zero pixel budget would pin everything to level 0; past a few levels
+    // the shadow bias just means "coarsest".
+    clamp_warn(lod.error_pixels, 0.01f, 64.0f, "lod.error_pixels");
+    clamp_warn(lod.shadow_bias, 0u, 4u, "lod.shadow_bias");
+
     // frames_in_flight: coarse clamp (no swapchain known at config time); the
     // device clamps again to the surface's supported image count when applying.
     clamp_warn(frames_in_flight, 1u, 4u, "frames_in_flight");
@@ -364,6 +369,8 @@ render_config::load(const vfs::rid& rid)
         extract_field(debug_node, "light_wireframe", debug.light_wireframe);
         extract_field(debug_node, "light_icons", debug.light_icons);
         extract_field(debug_node, "frustum_culling", debug.frustum_culling);
+        extract_field(debug_node, "gpu_pass_timing", debug.gpu_pass_timing);
+        extract_field(debug_node, "pipeline_statistics", debug.pipeline_statistics);
     }
 
     if (auto rs_node = container["render_scale"]; rs_node && rs_node.IsMap())
@@ -379,9 +386,18 @@ render_config::load(const vfs::rid& rid)
         extract_field(ol_node, "normal_threshold", outline.normal_threshold);
     }
 
+    if (auto lod_node = container["lod"]; lod_node && lod_node.IsMap())
+    {
+        extract_field(lod_node, "enabled", lod.enabled);
+        extract_field(lod_node, "error_pixels", lod.error_pixels);
+        extract_field(lod_node, "shadow_bias", lod.shadow_bias);
+    }
+
     extract_field(container, "frames_in_flight", frames_in_flight);
     extract_field(container, "present_mode", present);
     extract_field(container, "present_pace_frames", present_pace_frames);
+    extract_field(container, "async_compute", async_compute);
+    extract_field(container, "compact_vertices", compact_vertices);
 
     validate();
 
@@ -439,6 +455,8 @@ render_config::save(const utils::path& path) const
     debug_node["light_wireframe"] = debug.light_wireframe;
     debug_node["light_icons"] = debug.light_icons;
     debug_node["frustum_culling"] = debug.frustum_culling;
+    debug_node["gpu_pass_timing"] = debug.gpu_pass_timing;
+    debug_node["pipeline_statistics"] = debug.pipeline_statistics;
     root["debug"] = debug_node;
 
     YAML::Node rs_node;
@@ -452,9 +470,17 @@ render_config::save(const utils::path& path) const
     ol_node["normal_threshold"] = outline.normal_threshold;
     root["outline"] = ol_node;
 
+    YAML::Node lod_node;
+    lod_node["enabled"] = lod.enabled;
+    lod_node["error_pixels"] = lod.error_pixels;
+    lod_node["shadow_bias"] = lod.shadow_bias;
+    root["lod"] = lod_node;
+
     root["frames_in_flight"] = frames_in_flight;
     root["present_mode"] = to_string(present);
     root["present_pace_frames"] = present_pace_frames;
+    root["async_compute"] = async_compute;
+    root["compact_vertices"] = compact_vertices;
 
     if (!serialization::write_container(path, root))
     {
@@ -570,6 +596,8 @@ render_config::save() const
     DELTA(debug_node, "light_wireframe", debug.light_wireframe);
     DELTA(debug_node, "light_icons", debug.light_icons);
     DELTA(debug_node, "frustum_culling", debug.frustum_culling);
+    DELTA(debug_node, "gpu_pass_timing", debug.gpu_pass_timing);
+    DELTA(debug_node, "pipeline_statistics", debug.pipeline_statistics);
     if (debug_node.size() > 0)
     {
         root["debug"] = debug_node;
@@ -592,12 +620,23 @@ render_config::save() const
         root["outline"] = ol_node;
     }
 
+    YAML::Node lod_node;
+    DELTA(lod_node, "enabled", lod.enabled);
+    DELTA(lod_node, "error_pixels", lod.error_pixels);
+    DELTA(lod_node, "shadow_bias", lod.shadow_bias);
+    if (lod_node.size() > 0)
+    {
+        root["lod"] = lod_node;
+    }
+
     DELTA(root, "frames_in_flight", frames_in_flight);
     if (present != base_cfg.present)
     {
         root["present_mode"] = to_string(present);
     }
     DELTA(root, "present_pace_frames", present_pace_frames);
+    DELTA(root, "async_compute", async_compute);
+    DELTA(root, "compact_vertices", compact_vertices);
 
 #undef DELTA
 
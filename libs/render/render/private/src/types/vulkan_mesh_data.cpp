@@ -4,11 +4,236 @@
 
 #include <utils/dynamic_object_builder.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
 namespace kryga
 {
 namespace render
 {
 
+const std::array<compact_attribute, 5> k_compact_vertex_layout = {{
+    {0,
+     vertex_encoding::bounds_unorm16,
+     offsetof(gpu::vertex_data, position),
+     offsetof(gpu::compact_vertex_data, position)},
+    {1,
+     vertex_encoding::octahedral_snorm16,
+     offsetof(gpu::vertex_data, normal),
+     offsetof(gpu::compact_vertex_data, normal)},
+    {2,
+     vertex_encoding::unorm8,
+     offsetof(gpu::vertex_data, color),
+     offsetof(gpu::compact_vertex_data, color)},
+    {3,
+     vertex_encoding::half,
+     offsetof(gpu::vertex_data, uv),
+     offsetof(gpu::compact_vertex_data, uv)},
+    {4,
+     vertex_encoding::unorm16,
+     offsetof(gpu::vertex_data, uv2),
+     offsetof(gpu::compact_vertex_data, uv2)},
+}};
+
+const std::array<compact_attribute, 6> k_compact_skinned_vertex_layout = {{
+    {0,
+     vertex_encoding::bounds_unorm16,
+     offsetof(gpu::skinned_vertex_data, position),
+     offsetof(gpu::compact_skinned_vertex_data, position)},
+    {1,
+     vertex_encoding::octahedral_snorm16,
+     offsetof(gpu::skinned_vertex_data, normal),
+     offsetof(gpu::compact_skinned_vertex_data, normal)},
+    {2,
+     vertex_encoding::unorm8,
+     offsetof(gpu::skinned_vertex_data, color),
+     offsetof(gpu::compact_skinned_vertex_data, color)},
+    {3,
+     vertex_encoding::half,
+     offsetof(gpu::skinned_vertex_data, uv),
+     offsetof(gpu::compact_skinned_vertex_data, uv)},
+    {4,
+     vertex_encoding::uint8,
+     offsetof(gpu::skinned_vertex_data, bone_indices),
+     offsetof(gpu::compact_skinned_vertex_data, bone_indices)},
+    {5,
+     vertex_encoding::weights_unorm8,
+     offsetof(gpu::skinned_vertex_data, bone_weights),
+     offsetof(gpu::compact_skinned_vertex_data, bone_weights)},
+}};
+
+namespace
+{
+
+bool
+is_float_input(gpu_type::id t)
+{
+    return t == gpu_type::g_float || t == gpu_type::g_vec2 || t == gpu_type::g_vec3 ||
+           t == gpu_type::g_vec4 || t == gpu_type::g_color;
+}
+
+// Octahedral mapping of a unit vector onto [-1, 1]^2; the decode lives in
+// vertex_decode.glsl
+glm::vec2
+oct_encode(glm::vec3 n)
+{
+    float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    if (l1 <= 0.0f)
+    {
+        return glm::vec2(0.0f);
+    }
+    n /= l1;
+
+    glm::vec2 p(n.x, n.y);
+    if (n.z < 0.0f)
+    {
+        p = (1.0f - glm::abs(glm::vec2(p.y, p.x))) *
+            glm::vec2(p.x >= 0.0f ? 1.0f : -1.0f, p.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    return p;
+}
+
+uint32_t
+encode_weights(const glm::vec4& w)
+{
+    float sum = w.x + w.y + w.z + w.w;
+    glm::vec4 n = sum > 0.0f ? glm::clamp(w / sum, 0.0f, 1.0f) : glm::vec4(1, 0, 0, 0);
+
+    int q[4];
+    int total = 0;
+    for (int c = 0; c < 4; ++c)
+    {
+        q[c] = int(std::lround(n[c] * 255.0f));
+        total += q[c];
+    }
+
+    // Rounding can leave the sum off by a few steps; the heaviest influence absorbs it
+    auto heaviest = int(std::max_element(q, q + 4) - q);
+    q[heaviest] = std::clamp(q[heaviest] + 255 - total, 0, 255);
+
+    return uint32_t(q[0]) | uint32_t(q[1]) << 8 | uint32_t(q[2]) << 16 | uint32_t(q[3]) << 24;
+}
+
+void
+encode_attribute(const compact_attribute& a,
+                 const uint8_t* src,
+                 uint8_t* dst,
+                 const vertex_dequant& dq)
+{
+    switch (a.encoding)
+    {
+    case vertex_encoding::bounds_unorm16:
+    {
+        glm::vec3 v;
+        std::memcpy(&v, src + a.src_offset, sizeof(v));
+        glm::vec3 f = (v - dq.offset) / dq.scale;
+        uint32_t words[2] = {glm::packUnorm2x16(glm::vec2(f.x, f.y)),
+                             glm::packUnorm2x16(glm::vec2(f.z, 0.0f))};
+        std::memcpy(dst + a.dst_offset, words, sizeof(words));
+        return;
+    }
+    case vertex_encoding::octahedral_snorm16:
+    {
+        glm::vec3 v;
+        std::memcpy(&v, src + a.src_offset, sizeof(v));
+        uint32_t word = glm::packSnorm2x16(oct_encode(v));
+        std::memcpy(dst + a.dst_offset, &word, sizeof(word));
+        return;
+    }
+    case vertex_encoding::unorm8:
+    {
+        glm::vec3 v;
+        std::memcpy(&v, src + a.src_offset, sizeof(v));
+        uint32_t word = glm::packUnorm4x8(glm::vec4(v, 1.0f));
+        std::memcpy(dst + a.dst_offset, &word, sizeof(word));
+        return;
+    }
+    case vertex_encoding::half:
+    {
+        glm::vec2 v;
+        std::memcpy(&v, src + a.src_offset, sizeof(v));
+        uint32_t word = glm::packHalf2x16(v);
+        std::memcpy(dst + a.dst_offset, &word, sizeof(word));
+        return;
+    }
+    case vertex_encoding::unorm16:
+    {
+        glm::vec2 v;
+        std::memcpy(&v, src + a.src_offset, sizeof(v));
+        uint32_t word = glm::packUnorm2x16(v);
+        std::memcpy(dst + a.dst_offset, &word, sizeof(word));
+        return;
+    }
+    case vertex_encoding::uint8:
+    {
+        glm::uvec4 v;
+        std::memcpy(&v, src + a.src_offset, sizeof(v));
+        v = glm::min(v, glm::uvec4(255u));
+        uint32_t word = v.x | v.y << 8 | v.z << 16 | v.w << 24;
+        std::memcpy(dst + a.dst_offset, &word, sizeof(word));
+        return;
+    }
+    case vertex_encoding::weights_unorm8:
+    {
+        glm::vec4 v;
+        std::memcpy(&v, src + a.src_offset, sizeof(v));
+        uint32_t word = encode_weights(v);
+        std::memcpy(dst + a.dst_offset, &word, sizeof(word));
+        return;
+    }
+    }
+}
+
+template <typename SrcT, typename DstT, size_t N>
+vertex_dequant
+encode_vertices(std::span<const SrcT> src,
+                std::vector<DstT>& dst,
+                const std::array<compact_attribute, N>& layout)
+{
+    vertex_dequant dq;
+    dst.assign(src.size(), DstT{});
+    if (src.empty())
+    {
+        return dq;
+    }
+
+    glm::vec3 vmin{std::numeric_limits<float>::max()};
+    glm::vec3 vmax{std::numeric_limits<float>::lowest()};
+    for (const auto& v : src)
+    {
+        vmin = glm::min(vmin, v.position);
+        vmax = glm::max(vmax, v.position);
+    }
+
+    // Flat axes keep a unit extent so decode never divides into them
+    dq.offset = vmin;
+    dq.scale = vmax - vmin;
+    for (int c = 0; c < 3; ++c)
+    {
+        if (dq.scale[c] <= 0.0f)
+        {
+            dq.scale[c] = 1.0f;
+        }
+    }
+
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        auto* s = reinterpret_cast<const uint8_t*>(&src[i]);
+        auto* d = reinterpret_cast<uint8_t*>(&dst[i]);
+        for (const auto& a : layout)
+        {
+            encode_attribute(a, s, d, dq);
+        }
+    }
+
+    return dq;
+}
+
+}  // namespace
+
 vertex_input_description
 convert_to_vertex_input_description(kryga::utils::dynobj_layout& dol)
 {
@@ -41,6 +266,94 @@ convert_to_vertex_input_description(kryga::utils::dynobj_layout& dol)
     return description;
 }
 
+VkFormat
+to_vk_format(vertex_encoding e)
+{
+    switch (e)
+    {
+    case vertex_encoding::bounds_unorm16:
+        return VK_FORMAT_R16G16B16A16_UNORM;
+    case vertex_encoding::octahedral_snorm16:
+        return VK_FORMAT_R16G16_SNORM;
+    case vertex_encoding::unorm8:
+    case vertex_encoding::weights_unorm8:
+        return VK_FORMAT_R8G8B8A8_UNORM;
+    case vertex_encoding::half:
+        return VK_FORMAT_R16G16_SFLOAT;
+    case vertex_encoding::unorm16:
+        return VK_FORMAT_R16G16_UNORM;
+    case vertex_encoding::uint8:
+        return VK_FORMAT_R8G8B8A8_UINT;
+    }
+    return VK_FORMAT_UNDEFINED;
+}
+
+bool
+convert_to_compact_vertex_input_description(kryga::utils::dynobj_layout& dol,
+                                            vertex_input_description& out)
+{
+    out = {};
+
+    VkVertexInputBindingDescription main_binding = {};
+    main_binding.binding = 0;
+    main_binding.stride = (uint32_t)sizeof(gpu::compact_vertex_data);
+    main_binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    out.bindings.push_back(main_binding);
+
+    const auto& fields = dol.get_fields()[0].sub_field_layout->get_fields();
+    if (fields.size() > k_compact_vertex_layout.size())
+    {
+        return false;
+    }
+
+    // Every compact attribute is normalized or float, so any float input takes it
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        if (!is_float_input((gpu_type::id)fields[i].type))
+        {
+            return false;
+        }
+
+        const auto& a = k_compact_vertex_layout[i];
+
+        VkVertexInputAttributeDescription att = {};
+        att.binding = 0;
+        att.location = a.location;
+        att.format = to_vk_format(a.encoding);
+        att.offset = a.dst_offset;
+        out.attributes.push_back(att);
+    }
+
+    return true;
+}
+
+vertex_dequant
+encode_compact_vertices(std::span<const gpu::vertex_data> src,
+                        std::vector<gpu::compact_vertex_data>& dst)
+{
+    return encode_vertices(src, dst, k_compact_vertex_layout);
+}
+
+vertex_dequant
+encode_compact_vertices(std::span<const gpu::skinned_vertex_data> src,
+                        std::vector<gpu::compact_skinned_vertex_data>& dst)
+{
+    return encode_vertices(src, dst, k_compact_skinned_vertex_layout);
+}
+
+uint32_t
+select_chunk_lod(std::span<const mesh_lod> lods, float distance)
+{
+    uint32_t lod = 0;
+    const auto last = lods.empty() ? 0u : (uint32_t)lods.size() - 1;
+    while (lod < last && distance >= lods[lod].max_distance)
+    {
+        ++lod;
+    }
+    return lod;
+}
+
 mesh_data::~mesh_data() = default;
 
 }  // namespace render
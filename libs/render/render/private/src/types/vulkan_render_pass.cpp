@@ -54,11 +54,37 @@ render_pass::~render_pass()
 // Execution
 // =============================================================================
 
+namespace
+{
+
+// All graphics pipelines use dynamic viewport/scissor so they can survive target
+// resizes without rebuild. Set them to match the pass's framebuffer.
+void
+set_full_viewport(VkCommandBuffer cmd, VkExtent2D extent)
+{
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = (float)extent.width;
+    viewport.height = (float)extent.height;
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.offset = {.x = 0, .y = 0};
+    scissor.extent = extent;
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+}
+
+}  // namespace
+
 bool
 render_pass::begin(VkCommandBuffer cmd,
                    uint64_t swapchain_image_index,
                    uint32_t width,
-                   uint32_t height)
+                   uint32_t height,
+                   VkSubpassContents contents)
 {
     if (m_vk_render_pass == VK_NULL_HANDLE || m_framebuffers.empty())
     {
@@ -86,7 +112,7 @@ render_pass::begin(VkCommandBuffer cmd,
     }
     rp_info.pClearValues = clear_values;
 
-    vkCmdBeginRenderPass(cmd, &rp_info, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(cmd, &rp_info, contents);
 
     return true;
 }
@@ -106,30 +132,18 @@ render_pass::execute(VkCommandBuffer cmd,
 {
     if (is_graphics())
     {
-        uint32_t pass_width = m_fixed_width > 0 ? m_fixed_width : width;
-        uint32_t pass_height = m_fixed_height > 0 ? m_fixed_height : height;
-        begin(cmd, swapchain_image_index, pass_width, pass_height);
-
-        // All graphics pipelines use dynamic viewport/scissor so they can survive
-        // target resizes without rebuild. Set them to match the pass's framebuffer.
-        VkViewport viewport{};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = (float)pass_width;
-        viewport.height = (float)pass_height;
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        vkCmdSetViewport(cmd, 0, 1, &viewport);
-
-        VkRect2D scissor{};
-        scissor.offset = {.x = 0, .y = 0};
-        scissor.extent = {.width = pass_width, .height = pass_height};
-        vkCmdSetScissor(cmd, 0, 1, &scissor);
+        const VkExtent2D ext = extent(width, height);
+        begin(cmd, swapchain_image_index, ext.width, ext.height);
+        set_full_viewport(cmd, ext);
 
         if (m_execute)
         {
             m_execute(cmd);
         }
+        else if (m_split_record)
+        {
+            m_split_record(cmd, 0, split_item_count());
+        }
 
         end(cmd);
     }
@@ -143,6 +157,68 @@ render_pass::execute(VkCommandBuffer cmd,
     }
 }
 
+void
+render_pass::set_split_execute(std::function<uint32_t()> count,
+                               std::function<void(VkCommandBuffer, uint32_t, uint32_t)> record)
+{
+    KRG_check(m_type == rg_pass_type::graphics,
+              "Only graphics passes record into secondary command buffers");
+    m_split_count = std::move(count);
+    m_split_record = std::move(record);
+}
+
+void
+render_pass::record_secondary(VkCommandBuffer secondary,
+                              uint64_t swapchain_image_index,
+                              uint32_t width,
+                              uint32_t height,
+                              uint32_t begin,
+                              uint32_t end)
+{
+    KRG_check(m_split_record, "record_secondary on a pass without split recording");
+
+    VkCommandBufferInheritanceInfo inheritance{};
+    inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.renderPass = m_vk_render_pass;
+    inheritance.subpass = 0;
+    inheritance.framebuffer = m_framebuffers[swapchain_image_index % m_framebuffers.size()];
+    // No queries are inherited: the graph keeps pipeline-statistics and occlusion
+    // queries off while these execute
+
+    auto begin_info = vk_utils::make_command_buffer_begin_info(
+        VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+        VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT);
+    begin_info.pInheritanceInfo = &inheritance;
+
+    VK_CHECK(vkBeginCommandBuffer(secondary, &begin_info));
+    // Dynamic state is not inherited from the primary
+    set_full_viewport(secondary, extent(width, height));
+    m_split_record(secondary, begin, end);
+    VK_CHECK(vkEndCommandBuffer(secondary));
+}
+
+void
+render_pass::execute_secondaries(VkCommandBuffer cmd,
+                                 uint64_t swapchain_image_index,
+                                 uint32_t width,
+                                 uint32_t height,
+                                 const VkCommandBuffer* secondaries,
+                                 uint32_t count)
+{
+    // An empty list still runs the render pass: its load ops clear the targets
+    const VkExtent2D ext = extent(width, height);
+    begin(cmd,
+          swapchain_image_index,
+          ext.width,
+          ext.height,
+          VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    if (count > 0)
+    {
+        vkCmdExecuteCommands(cmd, count, secondaries);
+    }
+    end(cmd);
+}
+
 // =============================================================================
 // Runtime target swap
 // =============================================================================
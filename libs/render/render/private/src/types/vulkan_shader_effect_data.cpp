@@ -50,7 +50,9 @@ shader_effect_data::reset()
              set_layout = m_set_layout,
              pl = m_pipeline_layout,
              pipe = m_pipeline,
-             stencil_pipe = m_with_stencil_pipeline](VkDevice vd, VmaAllocator)
+             stencil_pipe = m_with_stencil_pipeline,
+             compact_pipe = m_compact_pipeline,
+             compact_stencil_pipe = m_compact_with_stencil_pipeline](VkDevice vd, VmaAllocator)
             {
                 if (owns_layout)
                 {
@@ -63,6 +65,8 @@ shader_effect_data::reset()
 
                 vkDestroyPipeline(vd, pipe, nullptr);
                 vkDestroyPipeline(vd, stencil_pipe, nullptr);
+                vkDestroyPipeline(vd, compact_pipe, nullptr);
+                vkDestroyPipeline(vd, compact_stencil_pipe, nullptr);
             });
 
         for (size_t i = 0; i < DESCRIPTORS_SETS_COUNT; ++i)
@@ -72,6 +76,8 @@ shader_effect_data::reset()
 
         m_pipeline = VK_NULL_HANDLE;
         m_with_stencil_pipeline = VK_NULL_HANDLE;
+        m_compact_pipeline = VK_NULL_HANDLE;
+        m_compact_with_stencil_pipeline = VK_NULL_HANDLE;
         m_pipeline_layout = VK_NULL_HANDLE;
     }
 }
@@ -0,0 +1,317 @@
+#include "vulkan_render/ui_batcher.h"
+
+#include "vulkan_render/font_atlas.h"
+
+#include <gpu_types/gpu_generic_constants.h>
+
+#include <cstring>
+
+namespace kryga::render
+{
+
+namespace
+{
+
+bool
+same_quad(const gpu::ui_quad& a, const gpu::ui_quad& b)
+{
+    return std::memcmp(&a, &b, sizeof(gpu::ui_quad)) == 0;
+}
+
+}  // namespace
+
+// Pen math mirrors the old per-frame draw path, but in pixels relative to the
+// anchor corner instead of the live viewport: right/bottom anchors place the text
+// block at negative offsets from that edge and the vertex shader adds the corner.
+bool
+layout_ui_text(const ui_text_entry& e,
+               font_atlas& font,
+               std::vector<gpu::ui_quad>& out,
+               std::vector<uint32_t>& pinned)
+{
+    out.clear();
+
+    const float scale = e.font_size / font.bake_height();
+
+    // Decode + pin once; metrics are known even before the bitmap is resident
+    const size_t first_pin = pinned.size();
+    const std::string_view text(e.text);
+    for (size_t pos = 0; pos < text.size();)
+    {
+        pinned.push_back(decode_utf8(text, pos));
+    }
+
+    float text_w = 0.f;
+    for (size_t i = first_pin; i < pinned.size(); ++i)
+    {
+        text_w += font.acquire(pinned[i]).advance * scale;
+    }
+
+    const bool right =
+        (e.anchor == KGPU_UI_ANCHOR_TOP_RIGHT || e.anchor == KGPU_UI_ANCHOR_BOTTOM_RIGHT);
+    const bool bottom =
+        (e.anchor == KGPU_UI_ANCHOR_BOTTOM_LEFT || e.anchor == KGPU_UI_ANCHOR_BOTTOM_RIGHT);
+
+    const float x = static_cast<float>(e.x);
+    const float y = static_cast<float>(e.y);
+
+    float pen_x = right ? (-x - text_w) : x;
+    const float top_y = bottom ? (-y - font.line_height() * scale) : y;
+    const float baseline_y = top_y + font.ascent() * scale;
+
+    out.reserve(pinned.size() - first_pin);
+
+    bool complete = true;
+    for (size_t i = first_pin; i < pinned.size(); ++i)
+    {
+        // Already pinned above; this lookup does not add a second pin
+        const glyph_metrics& g = font.peek(pinned[i]);
+
+        const float qx0 = pen_x + g.bearing.x * scale;
+        const float qy0 = baseline_y + g.bearing.y * scale;
+
+        pen_x += g.advance * scale;
+
+        // Whitespace/empty glyphs (e.g. space) only advance the pen
+        if (g.size.x <= 0.f || g.size.y <= 0.f)
+        {
+            continue;
+        }
+
+        // Not rasterised yet, or its page texture is not created yet
+        const uint32_t tex_index =
+            g.resident() ? font.page_bindless_index(g.page) : font_atlas::k_invalid;
+        if (tex_index == font_atlas::k_invalid)
+        {
+            complete = false;
+            continue;
+        }
+
+        gpu::ui_quad q{};
+        q.rect_px = glm::vec4(qx0, qy0, qx0 + g.size.x * scale, qy0 + g.size.y * scale);
+        q.uv_rect = glm::vec4(g.uv0.x, g.uv0.y, g.uv1.x, g.uv1.y);
+        q.color = e.color;
+        q.tex_index = tex_index;
+        q.sampler_index = KGPU_SAMPLER_LINEAR_CLAMP;
+        q.anchor = e.anchor;
+        out.push_back(q);
+    }
+
+    return complete;
+}
+
+void
+ui_batcher::set_panel(const utils::id& id, const glm::vec4& rect_px, const glm::vec4& color)
+{
+    gpu::ui_quad q{};
+    q.rect_px = rect_px;
+    q.uv_rect = glm::vec4(0.f, 0.f, 1.f, 1.f);
+    q.color = color;
+    q.tex_index = KGPU_UI_NO_TEXTURE;
+    q.sampler_index = KGPU_SAMPLER_LINEAR_CLAMP;
+    q.anchor = KGPU_UI_ANCHOR_TOP_LEFT;
+
+    auto [itr, inserted] = m_panels.try_emplace(id, q);
+    if (!inserted)
+    {
+        if (same_quad(itr->second, q))
+        {
+            return;
+        }
+        itr->second = q;
+    }
+    mark_dirty();
+}
+
+void
+ui_batcher::remove_panel(const utils::id& id)
+{
+    if (m_panels.erase(id) != 0)
+    {
+        mark_dirty();
+    }
+}
+
+void
+ui_batcher::set_text(uint32_t key, const ui_text_entry& e, font_atlas* font)
+{
+    if (key >= m_texts.size())
+    {
+        m_texts.resize(key + 1);
+    }
+
+    text_slot& slot = m_texts[key];
+    const bool font_ready = font && font->ready();
+
+    if (slot.live && !slot.pending_font && font_ready && slot.font == font && slot.entry == e)
+    {
+        return;
+    }
+
+    unpin(slot);
+    m_pending_fonts -= slot.pending_font ? 1 : 0;
+
+    slot.live = true;
+    slot.entry = e;
+    slot.font = font_ready ? font : nullptr;
+    slot.pending_font = !font_ready;
+    m_pending_fonts += slot.pending_font ? 1 : 0;
+
+    if (font_ready)
+    {
+        layout_slot(slot);
+    }
+    else
+    {
+        slot.quads.clear();
+    }
+
+    mark_dirty();
+}
+
+void
+ui_batcher::remove_text(uint32_t key)
+{
+    if (key >= m_texts.size() || !m_texts[key].live)
+    {
+        return;
+    }
+
+    text_slot& slot = m_texts[key];
+    unpin(slot);
+    m_pending_fonts -= slot.pending_font ? 1 : 0;
+    slot = text_slot{};
+    mark_dirty();
+}
+
+void
+ui_batcher::refresh(const font_resolver& resolver)
+{
+    if (!has_outstanding())
+    {
+        return;
+    }
+
+    for (auto& slot : m_texts)
+    {
+        if (slot.pending_font)
+        {
+            font_atlas* font = resolver(slot.entry.font);
+            if (!font || !font->ready())
+            {
+                continue;
+            }
+            slot.font = font;
+            slot.pending_font = false;
+            --m_pending_fonts;
+        }
+        else if (!slot.incomplete || slot.font->revision() == slot.font_revision)
+        {
+            continue;
+        }
+
+        unpin(slot);
+        layout_slot(slot);
+        mark_dirty();
+    }
+}
+
+void
+ui_batcher::forget_font(const font_atlas* font)
+{
+    for (auto& slot : m_texts)
+    {
+        if (!slot.live || slot.font != font)
+        {
+            continue;
+        }
+
+        // The atlas is going away: drop its pins without calling into it
+        m_incomplete -= slot.incomplete ? 1 : 0;
+        slot.incomplete = false;
+        slot.pinned.clear();
+        slot.quads.clear();
+        slot.font = nullptr;
+        slot.pending_font = true;
+        ++m_pending_fonts;
+        mark_dirty();
+    }
+}
+
+// Expects an unpinned slot (see unpin)
+void
+ui_batcher::layout_slot(text_slot& slot)
+{
+    slot.font_revision = slot.font->revision();
+    if (!layout_ui_text(slot.entry, *slot.font, slot.quads, slot.pinned))
+    {
+        slot.incomplete = true;
+        ++m_incomplete;
+    }
+}
+
+void
+ui_batcher::unpin(text_slot& slot)
+{
+    if (slot.font)
+    {
+        for (uint32_t cp : slot.pinned)
+        {
+            slot.font->release(cp);
+        }
+    }
+    slot.pinned.clear();
+
+    if (slot.incomplete)
+    {
+        slot.incomplete = false;
+        --m_incomplete;
+    }
+}
+
+const std::vector<gpu::ui_quad>&
+ui_batcher::quads()
+{
+    if (!m_dirty)
+    {
+        return m_packed;
+    }
+
+    m_packed.clear();
+
+    // Panels under text: draw order within one instanced draw is instance order
+    for (auto& [id, q] : m_panels)
+    {
+        m_packed.push_back(q);
+    }
+    for (auto& slot : m_texts)
+    {
+        m_packed.insert(m_packed.end(), slot.quads.begin(), slot.quads.end());
+    }
+
+    m_dirty = false;
+    return m_packed;
+}
+
+void
+ui_batcher::clear()
+{
+    for (auto& slot : m_texts)
+    {
+        unpin(slot);
+    }
+    m_panels.clear();
+    m_texts.clear();
+    m_pending_fonts = 0;
+    m_incomplete = 0;
+    mark_dirty();
+}
+
+void
+ui_batcher::mark_dirty()
+{
+    m_dirty = true;
+    ++m_generation;
+}
+
+}  // namespace kryga::render
@@ -147,6 +147,12 @@ offscreen_renderer::render(render_device& device, const offscreen_draw_request&
     auto* mesh = request.mesh;
     uint32_t size = m_size;
 
+    auto pipeline = se->get_pipeline(mesh->draws_compact(), false);
+    if (pipeline == VK_NULL_HANDLE)
+    {
+        return {};
+    }
+
     m_camera_buf.begin();
     m_objects_buf.begin();
     m_slots_buf.begin();
@@ -155,7 +161,10 @@ offscreen_renderer::render(render_device& device, const offscreen_draw_request&
     m_dummy_buf.begin();
 
     std::memcpy(m_camera_buf.get_data(), &request.camera, sizeof(gpu::camera_data));
-    std::memcpy(m_objects_buf.get_data(), &request.object, sizeof(gpu::object_data));
+    auto object = request.object;
+    object.position_scale = mesh->m_dequant.scale;
+    object.position_offset = mesh->m_dequant.offset;
+    std::memcpy(m_objects_buf.get_data(), &object, sizeof(gpu::object_data));
 
     uint32_t slot = 0;
     std::memcpy(m_slots_buf.get_data(), &slot, sizeof(slot));
@@ -277,7 +286,7 @@ offscreen_renderer::render(render_device& device, const offscreen_draw_request&
             VkRect2D scissor{{0, 0}, {size, size}};
             vkCmdSetScissor(cmd, 0, 1, &scissor);
 
-            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, se->m_pipeline);
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 
             vkCmdBindDescriptorSets(cmd,
                                     VK_PIPELINE_BIND_POINT_GRAPHICS,
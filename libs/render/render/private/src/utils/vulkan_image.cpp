@@ -121,6 +121,39 @@ vulkan_image::clear()
     m_allocator = nullptr;
 }
 
+vulkan_image
+vulkan_image::create_unbound(const vma_allocator_provider& allocator,
+                             VkImageCreateInfo ici,
+                             std::string_view debug_name)
+{
+    vulkan_image new_image(allocator, 1);
+
+    auto vk_device = glob::glob_state().getr_render().device.vk_device();
+
+    new_image.m_format = ici.format;
+    VK_CHECK(vkCreateImage(vk_device, &ici, nullptr, &new_image.m_image));
+
+    KRG_VK_NAME(vk_device, new_image.m_image, debug_name);
+
+    return new_image;
+}
+
+VkMemoryRequirements
+vulkan_image::get_memory_requirements() const
+{
+    VkMemoryRequirements requirements{};
+    vkGetImageMemoryRequirements(
+        glob::glob_state().getr_render().device.vk_device(), m_image, &requirements);
+    return requirements;
+}
+
+void
+vulkan_image::bind_memory(VmaAllocation memory, VkDeviceSize offset)
+{
+    // m_allocation stays null: clear() destroys the image, not the memory
+    VK_CHECK(vmaBindImageMemory2(m_allocator(), memory, offset, m_image, nullptr));
+}
+
 std::uint8_t*
 vulkan_image::map()
 {
@@ -136,6 +169,56 @@ vulkan_image::unmap()
     vmaUnmapMemory(glob::glob_state().getr_render().device.allocator(), m_allocation);
 }
 
+vulkan_memory::vulkan_memory(vulkan_memory&& other) noexcept
+    : m_allocation(other.m_allocation)
+{
+    other.m_allocation = VK_NULL_HANDLE;
+}
+
+vulkan_memory&
+vulkan_memory::operator=(vulkan_memory&& other) noexcept
+{
+    if (this != &other)
+    {
+        clear();
+
+        m_allocation = other.m_allocation;
+        other.m_allocation = VK_NULL_HANDLE;
+    }
+
+    return *this;
+}
+
+vulkan_memory::~vulkan_memory()
+{
+    clear();
+}
+
+vulkan_memory
+vulkan_memory::create(const vma_allocator_provider& allocator,
+                      const VkMemoryRequirements& requirements,
+                      VmaAllocationCreateInfo aci)
+{
+    vulkan_memory memory;
+    VK_CHECK(vmaAllocateMemory(allocator(), &requirements, &aci, &memory.m_allocation, nullptr));
+    return memory;
+}
+
+void
+vulkan_memory::clear()
+{
+    if (m_allocation == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    // Deferred like the images placed in it, which are deleted first
+    glob::glob_state().getr_render().device.schedule_to_delete(
+        [alloc = m_allocation](VkDevice, VmaAllocator va) { vmaFreeMemory(va, alloc); });
+
+    m_allocation = VK_NULL_HANDLE;
+}
+
 vulkan_image_view::~vulkan_image_view()
 {
     clear();
@@ -370,11 +370,36 @@ vulkan_shader_loader::create_shader_effect(shader_effect_data& se_data,
     auto& device = glob::glob_state().getr_render().device;
     se_data.m_pipeline = pb.build(device.vk_device(), info.rp->vk());
 
-    pb.m_depth_stencil_ci = vk_utils::make_depth_stencil_create_info(
+    const auto depth_stencil_ci = pb.m_depth_stencil_ci;
+    const auto with_stencil_ci = vk_utils::make_depth_stencil_create_info(
         true, true, info.depth_compare_op, depth_stencil_mode::stencil);
 
+    pb.m_depth_stencil_ci = with_stencil_ci;
     se_data.m_with_stencil_pipeline = pb.build(device.vk_device(), info.rp->vk());
 
+    // Compact variants: the same stages fed compact vertices, for vertex shaders that
+    // decode them. Formats are normalized or float, so the shader inputs are unchanged
+    const auto* compact_sc = vert_module->get_reflection().find_spec_constant("COMPACT_VERTEX");
+    render::vertex_input_description compact_input;
+    if (compact_sc && render::convert_to_compact_vertex_input_description(
+                          *se_data.m_expected_vertex_input, compact_input))
+    {
+        pb.m_vertex_input_info_ci.pVertexAttributeDescriptions = compact_input.attributes.data();
+        pb.m_vertex_input_info_ci.vertexAttributeDescriptionCount =
+            (uint32_t)compact_input.attributes.size();
+        pb.m_vertex_input_info_ci.pVertexBindingDescriptions = compact_input.bindings.data();
+        pb.m_vertex_input_info_ci.vertexBindingDescriptionCount =
+            (uint32_t)compact_input.bindings.size();
+
+        pb.m_spec_constants.push_back({.constant_id = compact_sc->constant_id, .value = 1});
+
+        pb.m_depth_stencil_ci = depth_stencil_ci;
+        se_data.m_compact_pipeline = pb.build(device.vk_device(), info.rp->vk());
+
+        pb.m_depth_stencil_ci = with_stencil_ci;
+        se_data.m_compact_with_stencil_pipeline = pb.build(device.vk_device(), info.rp->vk());
+    }
+
     if (se_data.m_pipeline != VK_NULL_HANDLE)
     {
         KRG_VK_NAME_FMT(
@@ -387,6 +412,13 @@ vulkan_shader_loader::create_shader_effect(shader_effect_data& se_data,
                         "{}.pipeline_stencil",
                         se_data.get_id().cstr());
     }
+    if (se_data.m_compact_pipeline != VK_NULL_HANDLE)
+    {
+        KRG_VK_NAME_FMT(device.vk_device(),
+                        se_data.m_compact_pipeline,
+                        "{}.pipeline_compact",
+                        se_data.get_id().cstr());
+    }
 
     return se_data.m_pipeline != VK_NULL_HANDLE ? result_code::ok : result_code::failed;
 }
@@ -436,8 +468,12 @@ vulkan_shader_loader::update_shader_effect(shader_effect_data& se_data,
 
     old_se_data->m_pipeline = se_data.m_pipeline;
     old_se_data->m_with_stencil_pipeline = se_data.m_with_stencil_pipeline;
+    old_se_data->m_compact_pipeline = se_data.m_compact_pipeline;
+    old_se_data->m_compact_with_stencil_pipeline = se_data.m_compact_with_stencil_pipeline;
     se_data.m_pipeline = VK_NULL_HANDLE;
     se_data.m_with_stencil_pipeline = VK_NULL_HANDLE;
+    se_data.m_compact_pipeline = VK_NULL_HANDLE;
+    se_data.m_compact_with_stencil_pipeline = VK_NULL_HANDLE;
 
     old_se_data->m_pipeline_layout = se_data.m_pipeline_layout;
     se_data.m_pipeline_layout = VK_NULL_HANDLE;
@@ -311,6 +311,24 @@ render_device::init_vulkan(SDL_Window* window, bool headless)
                   m_present_wait_supported ? "enabled" : "disabled");
     }
 
+    // Optional: pipeline statistics queries for the per-pass GPU profiler. Same
+    // rule as above — must be enabled before the DeviceBuilder copies the chain.
+    {
+        VkPhysicalDeviceFeatures stats_features{};
+        stats_features.pipelineStatisticsQuery = VK_TRUE;
+        m_pipeline_statistics_supported =
+            physicalDevice.enable_features_if_present(stats_features);
+    }
+
+    // Optional: timeline semaphores order the render graph's two queues. Same rule.
+    bool timeline_supported = false;
+    {
+        VkPhysicalDeviceTimelineSemaphoreFeatures timeline_features{};
+        timeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+        timeline_features.timelineSemaphore = VK_TRUE;
+        timeline_supported = physicalDevice.enable_extension_features_if_present(timeline_features);
+    }
+
     vkb::DeviceBuilder deviceBuilder{physicalDevice};
 
     // Enable descriptor indexing features for bindless textures
@@ -364,6 +382,32 @@ render_device::init_vulkan(SDL_Window* window, bool headless)
 
     m_graphics_queue_family = vkbDevice.get_queue_index(vkb::QueueType::graphics).value();
 
+    // Async compute: a family with compute but no graphics, if the GPU has one
+    {
+        auto compute_queue = vkbDevice.get_queue(vkb::QueueType::compute);
+        auto compute_family = vkbDevice.get_queue_index(vkb::QueueType::compute);
+        if (timeline_supported && compute_queue.has_value() && compute_family.has_value() &&
+            compute_family.value() != m_graphics_queue_family)
+        {
+            m_async_compute = true;
+            m_compute_queue = compute_queue.value();
+            m_compute_queue_family = compute_family.value();
+            m_shared_families[0] = m_graphics_queue_family;
+            m_shared_families[1] = m_compute_queue_family;
+        }
+    }
+
+    // 0 valid bits = the graphics queue cannot write timestamps
+    {
+        uint32_t family_count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_vk_gpu, &family_count, nullptr);
+        std::vector<VkQueueFamilyProperties> families(family_count);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_vk_gpu, &family_count, families.data());
+        m_timestamp_valid_bits = m_graphics_queue_family < family_count
+                                     ? families[m_graphics_queue_family].timestampValidBits
+                                     : 0;
+    }
+
     // initialize the memory allocator
     VmaAllocatorCreateInfo allocatorInfo = {};
     allocatorInfo.physicalDevice = m_vk_gpu;
@@ -382,12 +426,20 @@ render_device::init_vulkan(SDL_Window* window, bool headless)
     vmaCreateAllocator(&allocatorInfo, &m_allocator);
 
     vkGetPhysicalDeviceProperties(m_vk_gpu, &m_gpu_properties);
-    ALOG_INFO("Selected GPU: '{}' (present_wait {})",
+    ALOG_INFO("Selected GPU: '{}' (present_wait {}, timestamp bits {}, pipeline stats {}, "
+              "async compute {})",
               m_gpu_properties.deviceName,
-              m_present_wait_supported ? "enabled" : "disabled");
+              m_present_wait_supported ? "enabled" : "disabled",
+              m_timestamp_valid_bits,
+              m_pipeline_statistics_supported ? "enabled" : "disabled",
+              m_async_compute ? "enabled" : "disabled");
 
     KRG_VK_NAME(m_vk_device, m_vk_device, "kryga.device");
     KRG_VK_NAME(m_vk_device, m_graphics_queue, "kryga.graphics_queue");
+    if (m_async_compute)
+    {
+        KRG_VK_NAME(m_vk_device, m_compute_queue, "kryga.compute_queue");
+    }
 
     return true;
 }
@@ -867,6 +919,27 @@ render_device::init_commands()
 
         KRG_VK_NAME_FMT(m_vk_device, frame.m_command_pool, "frame_{}.cmd_pool", i);
         KRG_VK_NAME_FMT(m_vk_device, frame.m_main_command_buffer, "frame_{}.main_cmd", i);
+
+        // Reset wholesale each frame, never per buffer
+        auto secondary_pool_ci = vk_utils::make_command_pool_create_info(
+            m_graphics_queue_family, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+        for (uint32_t l = 0; l < frame_data::k_secondary_lanes; ++l)
+        {
+            auto& lane = frame.m_secondary_lanes[l];
+            VK_CHECK(vkCreateCommandPool(m_vk_device, &secondary_pool_ci, nullptr, &lane.pool));
+            KRG_VK_NAME_FMT(m_vk_device, lane.pool, "frame_{}.secondary_pool_{}", i, l);
+        }
+
+        for (uint32_t q = 0; q < k_rg_queue_count; ++q)
+        {
+            auto segment_pool_ci = vk_utils::make_command_pool_create_info(
+                q == static_cast<uint32_t>(rg_queue::graphics) ? m_graphics_queue_family
+                                                               : compute_queue_family(),
+                VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+            auto& lane = frame.m_segment_lanes[q];
+            VK_CHECK(vkCreateCommandPool(m_vk_device, &segment_pool_ci, nullptr, &lane.pool));
+            KRG_VK_NAME_FMT(m_vk_device, lane.pool, "frame_{}.segment_pool_{}", i, q);
+        }
     }
 
     auto upload_command_pool_ci = vk_utils::make_command_pool_create_info(m_graphics_queue_family);
@@ -878,12 +951,72 @@ render_device::init_commands()
     return true;
 }
 
+VkCommandBuffer
+render_device::acquire_secondary(frame_data& frame, uint32_t lane_idx)
+{
+    KRG_check(lane_idx < frame_data::k_secondary_lanes, "secondary lane out of range");
+    auto& lane = frame.m_secondary_lanes[lane_idx];
+
+    if (lane.used == lane.buffers.size())
+    {
+        auto ai = vk_utils::make_command_buffer_allocate_info(
+            lane.pool, 1, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+        VK_CHECK(vkAllocateCommandBuffers(m_vk_device, &ai, &lane.buffers.emplace_back()));
+    }
+    return lane.buffers[lane.used++];
+}
+
+VkCommandBuffer
+render_device::acquire_segment(frame_data& frame, rg_queue queue)
+{
+    auto& lane = frame.m_segment_lanes[static_cast<uint32_t>(queue)];
+
+    if (lane.used == lane.buffers.size())
+    {
+        auto ai = vk_utils::make_command_buffer_allocate_info(lane.pool, 1);
+        VK_CHECK(vkAllocateCommandBuffers(m_vk_device, &ai, &lane.buffers.emplace_back()));
+    }
+    return lane.buffers[lane.used++];
+}
+
+void
+render_device::reset_frame_commands(frame_data& frame)
+{
+    auto reset = [this](frame_data::command_lane& lane)
+    {
+        if (lane.used > 0)
+        {
+            VK_CHECK(vkResetCommandPool(m_vk_device, lane.pool, 0));
+            lane.used = 0;
+        }
+    };
+
+    for (auto& lane : frame.m_secondary_lanes)
+    {
+        reset(lane);
+    }
+    for (auto& lane : frame.m_segment_lanes)
+    {
+        reset(lane);
+    }
+}
+
 bool
 render_device::deinit_commands()
 {
     for (auto& f : m_frames)
     {
         vkDestroyCommandPool(m_vk_device, f.m_command_pool, nullptr);
+        for (auto& lane : f.m_secondary_lanes)
+        {
+            vkDestroyCommandPool(m_vk_device, lane.pool, nullptr);
+            lane = {};
+        }
+        for (auto& lane : f.m_segment_lanes)
+        {
+            vkDestroyCommandPool(m_vk_device, lane.pool, nullptr);
+            lane = {};
+        }
     }
 
     vkDestroyCommandPool(m_vk_device, m_upload_context.m_command_pool, nullptr);
@@ -928,6 +1061,23 @@ render_device::init_sync_structures()
     }
     m_images_in_flight.assign(m_swapchain_images.size(), VK_NULL_HANDLE);
 
+    if (m_async_compute)
+    {
+        VkSemaphoreTypeCreateInfo timeline_ci{};
+        timeline_ci.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        timeline_ci.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timeline_ci.initialValue = 0;
+
+        VkSemaphoreCreateInfo timeline_sem_ci = vk_utils::make_semaphore_create_info();
+        timeline_sem_ci.pNext = &timeline_ci;
+        for (uint32_t q = 0; q < k_rg_queue_count; ++q)
+        {
+            VK_CHECK(vkCreateSemaphore(
+                m_vk_device, &timeline_sem_ci, nullptr, &m_queue_timelines[q]));
+            KRG_VK_NAME_FMT(m_vk_device, m_queue_timelines[q], "queue_{}.timeline", q);
+        }
+    }
+
     VkFenceCreateInfo uploadFenceCreateInfo = vk_utils::make_fence_create_info();
 
     VK_CHECK(vkCreateFence(
@@ -954,6 +1104,11 @@ render_device::deinit_sync_structures()
     }
     m_image_render_semaphores.clear();
     m_images_in_flight.clear();  // non-owning
+    for (auto& sem : m_queue_timelines)
+    {
+        vkDestroySemaphore(m_vk_device, sem, nullptr);
+        sem = VK_NULL_HANDLE;
+    }
     return true;
 }
 
@@ -1204,6 +1359,14 @@ render_device::create_buffer(size_t alloc_size,
 
     buffer_ci.usage = usage;
 
+    // Both queues may use any buffer: no ownership transfers for the render graph
+    if (m_async_compute)
+    {
+        buffer_ci.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        buffer_ci.queueFamilyIndexCount = 2;
+        buffer_ci.pQueueFamilyIndices = m_shared_families;
+    }
+
     // let the VMA library know that this data should be writable by CPU, but also readable by
     // GPU
     VmaAllocationCreateInfo vma_alloc_ci = {};
@@ -1,15 +1,47 @@
 #include "vulkan_render/vulkan_render_graph.h"
+#include "vulkan_render/gpu_pass_profiler.h"
 #include "vulkan_render/types/vulkan_render_pass.h"
+#include "vulkan_render/utils/vulkan_initializers.h"
+
+#include <jobs/job_system.h>
 
 #include <utils/check.h>
 #include <utils/kryga_log.h>
 
+#include <tracy/Tracy.hpp>
+
 #include <algorithm>
 #include <stdexcept>
 
 namespace kryga::render
 {
 
+static bool
+is_depth_format(VkFormat fmt)
+{
+    return fmt == VK_FORMAT_D32_SFLOAT || fmt == VK_FORMAT_D32_SFLOAT_S8_UINT ||
+           fmt == VK_FORMAT_D16_UNORM || fmt == VK_FORMAT_D24_UNORM_S8_UINT;
+}
+
+static VkImageSubresourceRange
+color_or_depth_range(VkFormat fmt)
+{
+    return {.aspectMask = is_depth_format(fmt) ? VkImageAspectFlags(VK_IMAGE_ASPECT_DEPTH_BIT)
+                                               : VkImageAspectFlags(VK_IMAGE_ASPECT_COLOR_BIT),
+            .baseMipLevel = 0,
+            .levelCount = 1,
+            .baseArrayLayer = 0,
+            .layerCount = 1};
+}
+
+static bool
+writes_access(VkAccessFlags access)
+{
+    return (access & (VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                      VK_ACCESS_TRANSFER_WRITE_BIT |
+                      VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT)) != 0;
+}
+
 void
 vulkan_render_graph::register_buffer(const utils::id& name, VkBufferUsageFlags usage)
 {
@@ -52,6 +84,39 @@ vulkan_render_graph::import_resource(const utils::id& name, rg_resource_type typ
     res.base.is_imported = true;
 }
 
+void
+vulkan_render_graph::register_transient_image(const utils::id& name,
+                                              uint32_t width,
+                                              uint32_t height,
+                                              VkFormat format,
+                                              VkImageUsageFlags usage)
+{
+    KRG_check(!m_compiled, "Cannot modify compiled graph");
+    KRG_check(m_resources.find(name) == m_resources.end(), "Resource already registered");
+
+    register_image(name, width, height, format, usage);
+    auto& res = m_resources[name];
+    res.base.is_transient = true;
+    res.image_format = format;
+
+    m_transients.push_back({.name = name,
+                            .info = vk_utils::make_image_create_info(
+                                format, usage, VkExtent3D{width, height, 1})});
+}
+
+vk_utils::vulkan_image*
+vulkan_render_graph::get_transient_image(const utils::id& name)
+{
+    for (auto& t : m_transients)
+    {
+        if (t.name == name)
+        {
+            return t.image.image() != VK_NULL_HANDLE ? &t.image : nullptr;
+        }
+    }
+    return nullptr;
+}
+
 void
 vulkan_render_graph::add_pass(render_pass_sptr pass)
 {
@@ -135,7 +200,10 @@ vulkan_render_graph::bind_image(const utils::id& name,
 
     it->second.binding = &img;
     it->second.image_format = img.format();
-    it->second.last_access.layout = initial_layout;
+    for (auto& access : it->second.last_access)
+    {
+        access.layout = initial_layout;
+    }
     m_bound_this_frame.insert(name);
 }
 
@@ -152,6 +220,636 @@ vulkan_render_graph::set_final_layout(const utils::id& name, VkImageLayout layou
     m_final_layouts[name] = layout;
 }
 
+void
+vulkan_render_graph::set_secondary_recording(jobs::job_system* jobs,
+                                             uint32_t lanes,
+                                             std::function<VkCommandBuffer(uint32_t lane)> acquire)
+{
+    m_jobs = jobs;
+    m_lanes = lanes;
+    m_acquire_secondary = std::move(acquire);
+}
+
+void
+vulkan_render_graph::plan_split_chunks(std::span<const std::pair<uint32_t, uint32_t>> passes,
+                                       uint32_t lanes,
+                                       std::vector<rg_split_chunk>& out)
+{
+    out.clear();
+
+    uint32_t passes_left = 0;
+    for (const auto& [pass, items] : passes)
+    {
+        passes_left += items > 0 ? 1 : 0;
+    }
+
+    uint32_t lane = 0;
+    for (const auto& [pass, items] : passes)
+    {
+        if (items == 0)
+        {
+            continue;
+        }
+        const uint32_t lanes_left = lanes - lane;
+        if (lanes_left == 0)
+        {
+            break;
+        }
+
+        const uint32_t share = std::max(1u, lanes_left / passes_left);
+        const uint32_t chunks = std::min(share, std::max(1u, items / k_min_items_per_chunk));
+        for (uint32_t c = 0; c < chunks; ++c)
+        {
+            // Even split; the remainder spreads over the chunks one item each
+            out.push_back({.pass = pass,
+                           .begin = static_cast<uint32_t>(uint64_t(items) * c / chunks),
+                           .end = static_cast<uint32_t>(uint64_t(items) * (c + 1) / chunks),
+                           .lane = lane++});
+        }
+        --passes_left;
+    }
+}
+
+void
+vulkan_render_graph::record_split_passes(uint32_t swapchain_image_index,
+                                         uint32_t width,
+                                         uint32_t height)
+{
+    m_chunks.clear();
+    m_secondaries.clear();
+    m_first_chunk.assign(m_passes.size(), -1);
+
+    if (!m_jobs || m_lanes == 0 || !m_acquire_secondary)
+    {
+        return;
+    }
+
+    m_split_passes.clear();
+    for (size_t idx : m_execution_order)
+    {
+        if (m_passes[idx]->is_split() && m_passes[idx]->is_graphics())
+        {
+            m_split_passes.emplace_back(static_cast<uint32_t>(idx),
+                                        m_passes[idx]->split_item_count());
+        }
+    }
+    plan_split_chunks(m_split_passes, m_lanes, m_chunks);
+    if (m_chunks.empty())
+    {
+        return;
+    }
+
+    ZoneScopedN("Render::RecordSecondaries");
+
+    for (size_t i = 0; i < m_chunks.size(); ++i)
+    {
+        auto& first = m_first_chunk[m_chunks[i].pass];
+        if (first < 0)
+        {
+            first = static_cast<int32_t>(i);
+        }
+    }
+
+    // Buffers come from the chunk's own lane, so acquiring inside the jobs is safe
+    m_secondaries.resize(m_chunks.size(), VK_NULL_HANDLE);
+    m_jobs->parallel_for(
+        static_cast<uint32_t>(m_chunks.size()),
+        1,
+        [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                const auto& chunk = m_chunks[i];
+                m_secondaries[i] = m_acquire_secondary(chunk.lane);
+                m_passes[chunk.pass]->record_secondary(m_secondaries[i],
+                                                       swapchain_image_index,
+                                                       width,
+                                                       height,
+                                                       chunk.begin,
+                                                       chunk.end);
+            }
+        },
+        jobs::job_priority::high);
+}
+
+void
+vulkan_render_graph::set_async_compute(uint32_t graphics_family,
+                                       uint32_t compute_family,
+                                       std::function<VkCommandBuffer(rg_queue)> acquire)
+{
+    KRG_check(!m_compiled, "Cannot modify compiled graph");
+
+    m_queue_family[static_cast<uint32_t>(rg_queue::graphics)] = graphics_family;
+    m_queue_family[static_cast<uint32_t>(rg_queue::async_compute)] = compute_family;
+    m_acquire_segment = std::move(acquire);
+}
+
+void
+vulkan_render_graph::plan_queues(const std::vector<std::vector<size_t>>& deps)
+{
+    constexpr auto k_graphics = static_cast<uint32_t>(rg_queue::graphics);
+    constexpr auto k_async = static_cast<uint32_t>(rg_queue::async_compute);
+
+    const bool async_queue =
+        m_acquire_segment && m_queue_family[k_graphics] != m_queue_family[k_async];
+
+    m_pass_queue.assign(m_passes.size(), rg_queue::graphics);
+    m_segments.assign(1, rg_segment{});
+    m_join_tail = false;
+
+    bool any_async = false;
+    for (size_t i = 0; async_queue && i < m_passes.size(); ++i)
+    {
+        if (!m_culled[i] && m_passes[i]->type() == rg_pass_type::compute &&
+            m_passes[i]->is_async_compute())
+        {
+            m_pass_queue[i] = rg_queue::async_compute;
+            any_async = true;
+        }
+    }
+
+    // Images are back on graphics by the end of the frame
+    if (any_async)
+    {
+        std::unordered_map<utils::id, size_t> last_user;
+        for (size_t idx : m_execution_order)
+        {
+            for (const auto& ref : m_passes[idx]->resources())
+            {
+                if (ref.resource && ref.resource->type == rg_resource_type::image)
+                {
+                    last_user[ref.resource->name] = idx;
+                }
+            }
+        }
+        for (const auto& [name, idx] : last_user)
+        {
+            if (m_pass_queue[idx] == rg_queue::async_compute)
+            {
+                ALOG_WARN("Pass {} is the last user of image {}, kept on the graphics queue",
+                          m_passes[idx]->name().str(),
+                          name.str());
+                m_pass_queue[idx] = rg_queue::graphics;
+            }
+        }
+        any_async = std::find(m_pass_queue.begin(), m_pass_queue.end(),
+                              rg_queue::async_compute) != m_pass_queue.end();
+    }
+
+    if (!any_async)
+    {
+        m_segments[0].passes = m_execution_order;
+        return;
+    }
+
+    // Reorder: async passes as early as their dependencies allow, then graphics
+    // passes needing none of their results, then the rest. Joins land late and the
+    // graphics work ahead of them overlaps the async queue.
+    {
+        const size_t n = m_passes.size();
+        std::vector<uint32_t> rank(n);
+        std::vector<bool> after_async(n, false);
+        for (size_t i = 0; i < n; ++i)
+        {
+            const size_t idx = m_execution_order[i];
+            rank[idx] = static_cast<uint32_t>(i);
+            for (size_t dep : deps[idx])
+            {
+                if (m_pass_queue[dep] == rg_queue::async_compute || after_async[dep])
+                {
+                    after_async[idx] = true;
+                }
+            }
+        }
+
+        auto priority = [&](size_t idx)
+        {
+            const uint32_t cls = m_pass_queue[idx] == rg_queue::async_compute ? 0
+                                 : !after_async[idx]                          ? 1
+                                                                              : 2;
+            return std::pair{cls, rank[idx]};
+        };
+
+        std::vector<size_t> pending(n);
+        std::vector<size_t> ready;
+        for (size_t i = 0; i < n; ++i)
+        {
+            pending[i] = deps[i].size();
+            if (pending[i] == 0 && !m_culled[i])
+            {
+                ready.push_back(i);
+            }
+        }
+
+        m_execution_order.clear();
+        while (!ready.empty())
+        {
+            auto best = std::min_element(ready.begin(),
+                                         ready.end(),
+                                         [&](size_t a, size_t b)
+                                         { return priority(a) < priority(b); });
+            const size_t curr = *best;
+            ready.erase(best);
+            m_execution_order.push_back(curr);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                for (size_t dep : deps[i])
+                {
+                    if (dep == curr && --pending[i] == 0 && !m_culled[i])
+                    {
+                        ready.push_back(i);
+                    }
+                }
+            }
+        }
+    }
+
+    // Per resource and queue: latest segment using it and latest writing it
+    struct use
+    {
+        int32_t any = -1;
+        int32_t write = -1;
+    };
+    std::unordered_map<utils::id, std::array<use, k_rg_queue_count>> uses;
+    std::unordered_map<utils::id, rg_queue> image_owner;
+
+    int32_t latest[k_rg_queue_count] = {0, -1};
+    int32_t waited[k_rg_queue_count] = {-1, -1};
+
+    // Segment 0 keeps only what the caller recorded, so async work starts after it
+    // and not after the first graphics passes
+    for (size_t idx : m_execution_order)
+    {
+        const rg_queue queue = m_pass_queue[idx];
+        const auto q = static_cast<uint32_t>(queue);
+        const uint32_t other = q ^ 1u;
+
+        // The first async segment waits for what the caller recorded, no more
+        int32_t wait = latest[q] < 0 ? 0 : -1;
+        for (const auto& ref : m_passes[idx]->resources())
+        {
+            if (!ref.resource)
+            {
+                continue;
+            }
+
+            if (ref.resource->type == rg_resource_type::image)
+            {
+                // Released on the owner's latest segment
+                auto it = image_owner.find(ref.resource->name);
+                const rg_queue owner = it != image_owner.end() ? it->second : rg_queue::graphics;
+                if (owner != queue)
+                {
+                    wait = std::max(wait, latest[other]);
+                }
+            }
+            else
+            {
+                const auto& u = uses[ref.resource->name][other];
+                wait = std::max(wait, ref.usage != rg_access_mode::read ? u.any : u.write);
+            }
+        }
+
+        // A wait opens a segment so the passes before it don't wait too. Queue
+        // order covers anything at or before the last wait.
+        const bool new_wait = wait > waited[q];
+        if (m_segments.size() == 1 || m_segments.back().queue != queue || new_wait)
+        {
+            m_segments.push_back({.queue = queue});
+        }
+
+        const auto s = static_cast<int32_t>(m_segments.size() - 1);
+        auto& segment = m_segments.back();
+        if (new_wait)
+        {
+            segment.wait_on = wait;
+            waited[q] = wait;
+        }
+        segment.passes.push_back(idx);
+        latest[q] = s;
+
+        for (const auto& ref : m_passes[idx]->resources())
+        {
+            if (!ref.resource)
+            {
+                continue;
+            }
+
+            auto& u = uses[ref.resource->name][q];
+            u.any = s;
+            if (ref.usage != rg_access_mode::read)
+            {
+                u.write = s;
+            }
+            if (ref.resource->type == rg_resource_type::image)
+            {
+                image_owner[ref.resource->name] = queue;
+            }
+        }
+    }
+
+    // The frame fence is on graphics: it must end after the last async segment
+    m_join_tail = waited[k_graphics] < latest[k_async];
+}
+
+void
+vulkan_render_graph::begin_segments(VkCommandBuffer cmd)
+{
+    const bool async = m_segments.size() > 1;
+
+    m_submissions.clear();
+    m_graphics_tail = cmd;
+
+    for (size_t s = 0; s < m_segments.size(); ++s)
+    {
+        const auto& segment = m_segments[s];
+        rg_submission submission{.queue = segment.queue, .cmd = cmd};
+
+        if (s > 0)
+        {
+            submission.cmd = m_acquire_segment(segment.queue);
+            auto begin_info = vk_utils::make_command_buffer_begin_info(
+                VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+            VK_CHECK(vkBeginCommandBuffer(submission.cmd, &begin_info));
+        }
+
+        if (async)
+        {
+            submission.signal_value = ++m_timeline[static_cast<uint32_t>(segment.queue)];
+            if (segment.wait_on >= 0)
+            {
+                submission.wait_value = m_submissions[segment.wait_on].signal_value;
+            }
+        }
+
+        if (segment.queue == rg_queue::graphics)
+        {
+            m_graphics_tail = submission.cmd;
+        }
+        m_submissions.push_back(submission);
+    }
+}
+
+void
+vulkan_render_graph::cull_passes(const std::vector<std::vector<size_t>>& deps)
+{
+    // Roots: passes writing the frame's outputs (imported resources, or ones
+    // given a final layout), or whose effect is unknown (no declared writes).
+    // Graph-owned buffers and images only matter if a live pass reads them.
+    m_culled.assign(m_passes.size(), true);
+    std::vector<size_t> live;
+    for (size_t i = 0; i < m_passes.size(); ++i)
+    {
+        bool writes = false;
+        bool root = false;
+        for (const auto& ref : m_passes[i]->resources())
+        {
+            if (ref.resource && ref.usage != rg_access_mode::read)
+            {
+                writes = true;
+                root = root || ref.resource->is_imported ||
+                       m_final_layouts.contains(ref.resource->name);
+            }
+        }
+        if (root || !writes)
+        {
+            m_culled[i] = false;
+            live.push_back(i);
+        }
+    }
+
+    // Then whatever a live pass reads from
+    while (!live.empty())
+    {
+        const size_t curr = live.back();
+        live.pop_back();
+        for (size_t dep : deps[curr])
+        {
+            if (m_culled[dep])
+            {
+                m_culled[dep] = false;
+                live.push_back(dep);
+            }
+        }
+    }
+
+    std::erase_if(m_execution_order, [this](size_t idx) { return m_culled[idx]; });
+    for (size_t i = 0; i < m_passes.size(); ++i)
+    {
+        if (m_culled[i])
+        {
+            ALOG_INFO("Render graph: pass {} culled, nothing reads its output",
+                      m_passes[i]->name().str());
+        }
+    }
+}
+
+void
+vulkan_render_graph::plan_aliasing(std::span<const rg_alias_request> requests,
+                                   std::vector<rg_alias_placement>& placements,
+                                   std::vector<rg_alias_heap>& heaps)
+{
+    placements.assign(requests.size(), {});
+    heaps.clear();
+
+    auto align_up = [](VkDeviceSize v, VkDeviceSize a)
+    { return a > 1 ? (v + a - 1) / a * a : v; };
+    auto alive_together = [&](size_t a, size_t b)
+    { return requests[a].first <= requests[b].last && requests[b].first <= requests[a].last; };
+
+    std::vector<size_t> order(requests.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&](size_t a, size_t b) { return requests[a].size > requests[b].size; });
+
+    std::vector<std::vector<size_t>> placed;  // per heap
+    std::vector<size_t> alive;
+    for (size_t i : order)
+    {
+        const auto& r = requests[i];
+
+        auto best = static_cast<uint32_t>(heaps.size());
+        VkDeviceSize best_offset = 0;
+        VkDeviceSize best_growth = 0;
+        for (uint32_t h = 0; h < heaps.size(); ++h)
+        {
+            if ((heaps[h].memory_type_bits & r.memory_type_bits) == 0)
+            {
+                continue;
+            }
+
+            alive.clear();
+            for (size_t j : placed[h])
+            {
+                if (alive_together(i, j))
+                {
+                    alive.push_back(j);
+                }
+            }
+            std::sort(alive.begin(),
+                      alive.end(),
+                      [&](size_t a, size_t b)
+                      { return placements[a].offset < placements[b].offset; });
+
+            // Lowest gap that fits
+            VkDeviceSize offset = 0;
+            for (size_t j : alive)
+            {
+                if (align_up(offset, r.alignment) + r.size <= placements[j].offset)
+                {
+                    break;
+                }
+                offset = std::max(offset, placements[j].offset + requests[j].size);
+            }
+            offset = align_up(offset, r.alignment);
+
+            const VkDeviceSize end = offset + r.size;
+            const VkDeviceSize growth = end > heaps[h].size ? end - heaps[h].size : 0;
+            if (best == heaps.size() || growth < best_growth)
+            {
+                best = h;
+                best_offset = offset;
+                best_growth = growth;
+            }
+        }
+
+        if (best == heaps.size())
+        {
+            heaps.push_back({.memory_type_bits = r.memory_type_bits});
+            placed.emplace_back();
+            best_offset = 0;
+        }
+
+        auto& heap = heaps[best];
+        heap.size = std::max(heap.size, best_offset + r.size);
+        heap.alignment = std::max(heap.alignment, r.alignment);
+        heap.memory_type_bits &= r.memory_type_bits;
+        placements[i] = {.heap = best, .offset = best_offset};
+        placed[best].push_back(i);
+    }
+}
+
+void
+vulkan_render_graph::place_transients()
+{
+    m_transient_stats = {};
+    if (m_transients.empty())
+    {
+        return;
+    }
+
+    std::unordered_map<utils::id, size_t> index;
+    for (size_t i = 0; i < m_transients.size(); ++i)
+    {
+        m_transients[i].first = UINT32_MAX;
+        m_transients[i].last = 0;
+        index[m_transients[i].name] = i;
+    }
+
+    // Lifetimes over the final order. Used on both queues: the whole frame.
+    const auto n = static_cast<uint32_t>(m_execution_order.size());
+    std::vector<bool> cross_queue(m_transients.size(), false);
+    for (uint32_t pos = 0; pos < n; ++pos)
+    {
+        const size_t idx = m_execution_order[pos];
+        for (const auto& ref : m_passes[idx]->resources())
+        {
+            if (!ref.resource || !ref.resource->is_transient)
+            {
+                continue;
+            }
+
+            const size_t t = index[ref.resource->name];
+            m_transients[t].first = std::min(m_transients[t].first, pos);
+            m_transients[t].last = std::max(m_transients[t].last, pos);
+            cross_queue[t] = cross_queue[t] || m_pass_queue[idx] == rg_queue::async_compute;
+        }
+    }
+
+    if (!m_transient_allocator)
+    {
+        return;
+    }
+
+    std::vector<rg_alias_request> requests;
+    std::vector<size_t> requested;
+    for (size_t i = 0; i < m_transients.size(); ++i)
+    {
+        auto& t = m_transients[i];
+        if (t.first > t.last)
+        {
+            continue;  // every user was culled
+        }
+        if (cross_queue[i])
+        {
+            t.first = 0;
+            t.last = n - 1;
+        }
+
+        t.image =
+            vk_utils::vulkan_image::create_unbound(m_transient_allocator, t.info, t.name.str());
+        const auto req = t.image.get_memory_requirements();
+        requests.push_back({.first = t.first,
+                            .last = t.last,
+                            .size = req.size,
+                            .alignment = req.alignment,
+                            .memory_type_bits = req.memoryTypeBits});
+        requested.push_back(i);
+    }
+
+    std::vector<rg_alias_placement> placements;
+    std::vector<rg_alias_heap> heaps;
+    plan_aliasing(requests, placements, heaps);
+
+    VmaAllocationCreateInfo aci = {};
+    aci.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+    for (const auto& heap : heaps)
+    {
+        const VkMemoryRequirements requirements{.size = heap.size,
+                                                .alignment = heap.alignment,
+                                                .memoryTypeBits = heap.memory_type_bits};
+        m_transient_heaps.push_back(
+            vk_utils::vulkan_memory::create(m_transient_allocator, requirements, aci));
+        m_transient_stats.allocated += heap.size;
+    }
+
+    for (size_t k = 0; k < requested.size(); ++k)
+    {
+        auto& t = m_transients[requested[k]];
+        auto& res = m_resources[t.name];
+        t.image.bind_memory(m_transient_heaps[placements[k].heap].allocation(),
+                            placements[k].offset);
+        res.binding = &t.image;
+        m_transient_stats.requested += requests[k].size;
+
+        // Earlier tenants of any of its bytes
+        res.aliases.clear();
+        for (size_t o = 0; o < requested.size(); ++o)
+        {
+            const auto& a = placements[k];
+            const auto& b = placements[o];
+            if (o != k && a.heap == b.heap && b.offset < a.offset + requests[k].size &&
+                a.offset < b.offset + requests[o].size && requests[o].last < requests[k].first)
+            {
+                res.aliases.push_back(&m_resources[m_transients[requested[o]].name]);
+            }
+        }
+    }
+
+    m_transient_stats.images = static_cast<uint32_t>(requested.size());
+    m_transient_stats.heaps = static_cast<uint32_t>(heaps.size());
+    ALOG_INFO("Render graph: {} transient images in {} heaps, {} KB ({} KB unaliased)",
+              m_transient_stats.images,
+              m_transient_stats.heaps,
+              m_transient_stats.allocated / 1024,
+              m_transient_stats.requested / 1024);
+}
+
 bool
 vulkan_render_graph::compile()
 {
@@ -265,14 +963,21 @@ vulkan_render_graph::compile()
         return false;
     }
 
+    cull_passes(deps);
+
+    // Queue per pass and the segments they submit in
+    plan_queues(deps);
+
     // Assign order
     for (size_t i = 0; i < m_execution_order.size(); ++i)
     {
         m_passes[m_execution_order[i]]->set_order(static_cast<uint32_t>(i));
     }
 
-    // Calculate barriers for each pass
-    calculate_barriers();
+    place_transients();
+
+    // Barriers are cached by the first execute()
+    m_barriers_valid = false;
 
     // Validate all passes: binding table resources + BDA push constant fields
     for (const auto& pass : m_passes)
@@ -293,6 +998,10 @@ vulkan_render_graph::execute(VkCommandBuffer cmd,
                              uint32_t width,
                              uint32_t height)
 {
+    // Until the segments begin, the frame is the caller's buffer alone
+    m_submissions.assign(1, {.queue = rg_queue::graphics, .cmd = cmd});
+    m_graphics_tail = cmd;
+
     if (!m_compiled)
     {
         if (!compile())
@@ -304,7 +1013,7 @@ vulkan_render_graph::execute(VkCommandBuffer cmd,
     // Validate all registered resources are bound this frame
     for (const auto& [name, res] : m_resources)
     {
-        if (m_bound_this_frame.find(name) == m_bound_this_frame.end())
+        if (!res.base.is_transient && m_bound_this_frame.find(name) == m_bound_this_frame.end())
         {
             ALOG_ERROR("Resource not bound this frame: '{}'", name.cstr());
             return false;
@@ -315,144 +1024,144 @@ vulkan_render_graph::execute(VkCommandBuffer cmd,
     // Images retain their layout from the previous frame (e.g. shadow maps stay in
     // SHADER_READ_ONLY_OPTIMAL after main pass). The graph will insert barriers to
     // transition them to the required layout for the first pass that uses them.
+    // Transients start undefined: their memory may have held another image.
     for (auto& [name, res] : m_resources)
     {
-        VkImageLayout prev_layout = res.last_access.layout;
-        res.last_access = rg_access_info{};
+        VkImageLayout prev_layout =
+            res.base.is_transient ? VK_IMAGE_LAYOUT_UNDEFINED : res.last_access[0].layout;
+        res.last_access = {};
+        res.owner = rg_queue::graphics;
         if (res.base.type == rg_resource_type::image)
         {
-            res.last_access.layout = prev_layout;
+            for (auto& access : res.last_access)
+            {
+                access.layout = prev_layout;
+            }
         }
     }
 
-    for (size_t idx : m_execution_order)
+    // Barriers depend on the topology and on the layouts images start the frame in
+    bool cache_hit = m_barriers_valid;
+    for (size_t i = 0; cache_hit && i < m_cached_images.size(); ++i)
+    {
+        cache_hit = m_cached_images[i]->last_access[0].layout == m_cached_start_layouts[i];
+    }
+    if (!cache_hit)
     {
-        auto& pass = m_passes[idx];
+        calculate_barriers();
+    }
 
-        // Calculate and insert barriers for this pass
-        rg_pass_barriers barriers;
-        for (const auto& ref : pass->resources())
+    record_split_passes(swapchain_image_index, width, height);
+    begin_segments(cmd);
+
+    for (size_t s = 0; s < m_segments.size(); ++s)
+    {
+        const auto& segment = m_segments[s];
+        VkCommandBuffer seg_cmd = m_submissions[s].cmd;
+        m_submissions[s].wait_stage |= m_cached_wait_stage[s];
+
+        // Timestamps and statistics queries are graphics-queue only
+        gpu_pass_profiler* profiler = segment.queue == rg_queue::graphics ? m_profiler : nullptr;
+
+        for (size_t idx : segment.passes)
         {
-            if (!ref.resource)
+            auto& pass = m_passes[idx];
+            const auto& cached = m_cached_passes[idx];
+
+            // Ownership releases close the previous owner's segment; the acquiring
+            // segment waits on it
+            for (uint32_t i = 0; i < cached.release_count; ++i)
             {
-                continue;
+                const auto& release = m_cached_releases[cached.first_release + i];
+                rg_pass_barriers barriers;
+                append_barrier(release, barriers);
+                barriers.src_stage = release.src_stage;
+                insert_barriers(m_submissions[release.submission].cmd, barriers);
             }
 
-            auto it = m_resources.find(ref.resource->name);
-            if (it == m_resources.end())
+            // Timed from before its barriers: a stall waiting on a producer is
+            // charged to the pass that needed the result. Passes replaying
+            // secondaries get no pipeline statistics, the secondaries don't
+            // inherit the query.
+            const bool replays = m_first_chunk[idx] >= 0;
+            if (profiler)
             {
-                continue;
+                profiler->begin_pass(seg_cmd, pass->name(), !replays);
             }
 
-            auto& res = it->second;
-            rg_access_info required = compute_access_for_usage(
-                ref.usage, pass->type(), ref.resource->type, res.image_format);
-
-            if (needs_barrier(res.last_access, required))
+            rg_pass_barriers barriers;
+            barriers.src_stage |= cached.src_stage;
+            barriers.dst_stage |= cached.dst_stage;
+            for (uint32_t i = 0; i < cached.count; ++i)
             {
-                barriers.src_stage |= res.last_access.stage;
-                barriers.dst_stage |= required.stage;
+                append_barrier(m_cached_barriers[cached.first + i], barriers);
+            }
+            insert_barriers(seg_cmd, barriers);
 
-                if (ref.resource->type == rg_resource_type::buffer)
+            // Execute pass: replay its recorded chunks, or record it here
+            if (replays)
+            {
+                const auto begin = static_cast<size_t>(m_first_chunk[idx]);
+                auto end = begin;
+                while (end < m_chunks.size() && m_chunks[end].pass == idx)
                 {
-                    if (auto** buf = std::get_if<vk_utils::vulkan_buffer*>(&res.binding))
-                    {
-                        VkBufferMemoryBarrier barrier = {};
-                        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-                        barrier.srcAccessMask = res.last_access.access;
-                        barrier.dstAccessMask = required.access;
-                        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                        barrier.buffer = (*buf)->buffer();
-                        barrier.offset = 0;
-                        barrier.size = (*buf)->get_alloc_size();
-                        barriers.buffer_barriers.push_back(barrier);
-                    }
-                }
-                else if (ref.resource->type == rg_resource_type::image)
-                {
-                    if (auto** img = std::get_if<vk_utils::vulkan_image*>(&res.binding))
-                    {
-                        bool is_depth = res.image_format == VK_FORMAT_D32_SFLOAT ||
-                                        res.image_format == VK_FORMAT_D32_SFLOAT_S8_UINT ||
-                                        res.image_format == VK_FORMAT_D16_UNORM ||
-                                        res.image_format == VK_FORMAT_D24_UNORM_S8_UINT;
-
-                        VkImageMemoryBarrier barrier = {};
-                        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-                        barrier.srcAccessMask = res.last_access.access;
-                        barrier.dstAccessMask = required.access;
-                        barrier.oldLayout = res.last_access.layout;
-                        barrier.newLayout = required.layout;
-                        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                        barrier.image = (*img)->image();
-                        barrier.subresourceRange.aspectMask =
-                            is_depth ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
-                        barrier.subresourceRange.baseMipLevel = 0;
-                        barrier.subresourceRange.levelCount = 1;
-                        barrier.subresourceRange.baseArrayLayer = 0;
-                        barrier.subresourceRange.layerCount = 1;
-                        barriers.image_barriers.push_back(barrier);
-                    }
+                    ++end;
                 }
+                pass->execute_secondaries(seg_cmd,
+                                          swapchain_image_index,
+                                          width,
+                                          height,
+                                          &m_secondaries[begin],
+                                          static_cast<uint32_t>(end - begin));
+            }
+            else
+            {
+                pass->execute(seg_cmd, swapchain_image_index, width, height);
             }
 
-            // Update resource state
-            res.last_access = required;
+            if (profiler)
+            {
+                profiler->end_pass(seg_cmd);
+            }
         }
-
-        // Insert barriers if needed
-        insert_barriers(cmd, barriers);
-
-        // Execute pass
-        pass->execute(cmd, swapchain_image_index, width, height);
     }
 
     // Final layout transitions (e.g. COLOR_ATTACHMENT_OPTIMAL → PRESENT_SRC_KHR)
-    for (const auto& [name, final_layout] : m_final_layouts)
+    for (const auto& final : m_cached_finals)
     {
-        auto it = m_resources.find(name);
-        if (it == m_resources.end())
+        rg_pass_barriers barriers;
+        append_barrier(final, barriers);
+        barriers.src_stage = final.src_stage;
+        insert_barriers(m_graphics_tail, barriers);
+    }
+
+    // Layouts the frame leaves images in, on both queues
+    for (size_t i = 0; i < m_cached_images.size(); ++i)
+    {
+        for (auto& access : m_cached_images[i]->last_access)
         {
-            continue;
+            access.layout = m_cached_end_layouts[i];
         }
+    }
 
-        auto& res = it->second;
-        if (res.last_access.layout == final_layout)
+    if (m_segments.size() > 1)
+    {
+        for (auto& submission : m_submissions)
         {
-            continue;
+            if (submission.wait_value != 0 && submission.wait_stage == 0)
+            {
+                submission.wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            }
         }
 
-        if (auto** img = std::get_if<vk_utils::vulkan_image*>(&res.binding))
+        // Wait-only batch: the frame fence then covers the async queue too
+        if (m_join_tail)
         {
-            VkImageMemoryBarrier barrier = {};
-            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-            barrier.srcAccessMask = res.last_access.access;
-            barrier.dstAccessMask = 0;
-            barrier.oldLayout = res.last_access.layout;
-            barrier.newLayout = final_layout;
-            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barrier.image = (*img)->image();
-            barrier.subresourceRange = {.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                                        .baseMipLevel = 0,
-                                        .levelCount = 1,
-                                        .baseArrayLayer = 0,
-                                        .layerCount = 1};
-
-            vkCmdPipelineBarrier(cmd,
-                                 res.last_access.stage,
-                                 VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-                                 0,
-                                 0,
-                                 nullptr,
-                                 0,
-                                 nullptr,
-                                 1,
-                                 &barrier);
-
-            res.last_access.layout = final_layout;
+            m_submissions.push_back(
+                {.queue = rg_queue::graphics,
+                 .wait_value = m_timeline[static_cast<uint32_t>(rg_queue::async_compute)],
+                 .wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                 .signal_value = ++m_timeline[static_cast<uint32_t>(rg_queue::graphics)]});
         }
     }
 
@@ -466,6 +1175,22 @@ vulkan_render_graph::reset()
     m_passes.clear();
     m_execution_order.clear();
     m_final_layouts.clear();
+    m_split_passes.clear();
+    m_chunks.clear();
+    m_secondaries.clear();
+    m_first_chunk.clear();
+    m_pass_queue.clear();
+    m_segments.clear();
+    m_submissions.clear();
+    // Timeline values carry on: the device's semaphores outlive the graph
+    m_acquire_segment = nullptr;
+    m_culled.clear();
+    // Images before the memory they are placed in
+    m_transients.clear();
+    m_transient_heaps.clear();
+    m_transient_stats = {};
+    m_barriers_valid = false;
+    m_cached_images.clear();
     m_compiled = false;
 }
 
@@ -482,23 +1207,22 @@ vulkan_render_graph::get_pass(const utils::id& name) const
     return nullptr;
 }
 
-static bool
-is_depth_format(VkFormat fmt)
-{
-    return fmt == VK_FORMAT_D32_SFLOAT || fmt == VK_FORMAT_D32_SFLOAT_S8_UINT ||
-           fmt == VK_FORMAT_D16_UNORM || fmt == VK_FORMAT_D24_UNORM_S8_UINT;
-}
-
 rg_access_info
 vulkan_render_graph::compute_access_for_usage(rg_access_mode usage,
                                               rg_pass_type pass_type,
                                               rg_resource_type res_type,
-                                              VkFormat image_format)
+                                              VkFormat image_format,
+                                              VkBufferUsageFlags buffer_usage)
 {
     rg_access_info info;
 
     bool depth = is_depth_format(image_format);
 
+    // Graphics reads of a vertex buffer are fetched by the input assembler
+    const bool vertex_input = pass_type == rg_pass_type::graphics &&
+                              res_type == rg_resource_type::buffer &&
+                              (buffer_usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) != 0;
+
     // Determine pipeline stage based on pass type
     switch (pass_type)
     {
@@ -535,6 +1259,10 @@ vulkan_render_graph::compute_access_for_usage(rg_access_mode usage,
         {
             info.stage =
                 VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            if (vertex_input)
+            {
+                info.stage |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+            }
         }
         break;
     }
@@ -554,6 +1282,10 @@ vulkan_render_graph::compute_access_for_usage(rg_access_mode usage,
         {
             info.access = VK_ACCESS_SHADER_READ_BIT;
             info.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            if (vertex_input)
+            {
+                info.access |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+            }
         }
         break;
     }
@@ -628,8 +1360,226 @@ vulkan_render_graph::needs_barrier(const rg_access_info& prev, const rg_access_i
 void
 vulkan_render_graph::calculate_barriers()
 {
-    // Pre-calculate barriers for static analysis (optional optimization)
-    // For now, barriers are calculated dynamically during execute()
+    ZoneScopedN("Render::CalculateBarriers");
+
+    constexpr auto k_graphics = static_cast<uint32_t>(rg_queue::graphics);
+    const bool async = m_segments.size() > 1;
+
+    m_cached_passes.assign(m_passes.size(), {});
+    m_cached_barriers.clear();
+    m_cached_releases.clear();
+    m_cached_finals.clear();
+    m_cached_wait_stage.assign(m_segments.size(), 0);
+
+    m_cached_images.clear();
+    m_cached_start_layouts.clear();
+    for (auto& [name, res] : m_resources)
+    {
+        if (res.base.type == rg_resource_type::image)
+        {
+            m_cached_images.push_back(&res);
+            m_cached_start_layouts.push_back(res.last_access[k_graphics].layout);
+        }
+    }
+
+    // Per queue: the segment it records into and its latest one with a semaphore
+    // wait. Waits only grow, so that one covers every cross-queue dependency of
+    // the segments after it.
+    uint32_t open[k_rg_queue_count] = {};
+    uint32_t waiting[k_rg_queue_count] = {};
+
+    for (size_t s = 0; s < m_segments.size(); ++s)
+    {
+        const auto& segment = m_segments[s];
+        const auto q = static_cast<uint32_t>(segment.queue);
+        open[q] = static_cast<uint32_t>(s);
+        if (segment.wait_on >= 0)
+        {
+            waiting[q] = static_cast<uint32_t>(s);
+        }
+        auto& wait_stage = m_cached_wait_stage[waiting[q]];
+
+        for (size_t idx : segment.passes)
+        {
+            const auto& pass = m_passes[idx];
+            auto& cached = m_cached_passes[idx];
+            cached.first = static_cast<uint32_t>(m_cached_barriers.size());
+            cached.first_release = static_cast<uint32_t>(m_cached_releases.size());
+
+            for (const auto& ref : pass->resources())
+            {
+                if (!ref.resource)
+                {
+                    continue;
+                }
+
+                auto it = m_resources.find(ref.resource->name);
+                if (it == m_resources.end())
+                {
+                    continue;
+                }
+
+                auto& res = it->second;
+                const bool image = ref.resource->type == rg_resource_type::image;
+                rg_access_info required = compute_access_for_usage(ref.usage,
+                                                                   pass->type(),
+                                                                   ref.resource->type,
+                                                                   res.image_format,
+                                                                   res.buffer_usage);
+
+                // Across queues the segment's semaphore wait is the dependency
+                if (async)
+                {
+                    const auto& other = res.last_access[q ^ 1u];
+                    if (other.access != 0 &&
+                        (writes_access(other.access) || writes_access(required.access)))
+                    {
+                        wait_stage |= required.stage;
+                    }
+                }
+
+                auto& last = res.last_access[q];
+                if (image && res.owner != segment.queue)
+                {
+                    // Ownership moves: release on the owner's open segment, acquire
+                    // here, chained to the semaphore wait by stage
+                    const auto from = static_cast<uint32_t>(res.owner);
+                    auto& owner_last = res.last_access[from];
+                    m_cached_releases.push_back({.res = &res,
+                                                 .src_stage = owner_last.stage,
+                                                 .src_access = owner_last.access,
+                                                 .old_layout = owner_last.layout,
+                                                 .new_layout = required.layout,
+                                                 .src_family = m_queue_family[from],
+                                                 .dst_family = m_queue_family[q],
+                                                 .submission = open[from]});
+                    m_cached_barriers.push_back({.res = &res,
+                                                 .dst_access = required.access,
+                                                 .old_layout = owner_last.layout,
+                                                 .new_layout = required.layout,
+                                                 .src_family = m_queue_family[from],
+                                                 .dst_family = m_queue_family[q]});
+                    cached.src_stage |= required.stage;
+                    cached.dst_stage |= required.stage;
+                    wait_stage |= required.stage;
+                    owner_last = {.layout = required.layout};
+                    res.owner = segment.queue;
+                }
+                else
+                {
+                    // A transient's first use also waits for the images that held
+                    // its memory earlier in the frame
+                    rg_access_info prev = last;
+                    bool aliased = false;
+                    if (res.base.is_transient && last.access == 0)
+                    {
+                        for (const vulkan_resource* alias : res.aliases)
+                        {
+                            prev.stage |= alias->last_access[q].stage;
+                            prev.access |= alias->last_access[q].access;
+                            aliased = true;
+                        }
+                    }
+
+                    if (aliased || needs_barrier(prev, required))
+                    {
+                        cached.src_stage |= prev.stage;
+                        cached.dst_stage |= required.stage;
+                        m_cached_barriers.push_back({.res = &res,
+                                                     .src_access = prev.access,
+                                                     .dst_access = required.access,
+                                                     .old_layout = prev.layout,
+                                                     .new_layout = required.layout});
+                    }
+                }
+
+                // Update resource state; a layout is the same on every queue
+                last = required;
+                if (image)
+                {
+                    res.last_access[q ^ 1u].layout = required.layout;
+                }
+            }
+
+            cached.count = static_cast<uint32_t>(m_cached_barriers.size()) - cached.first;
+            cached.release_count =
+                static_cast<uint32_t>(m_cached_releases.size()) - cached.first_release;
+        }
+    }
+
+    for (const auto& [name, final_layout] : m_final_layouts)
+    {
+        auto it = m_resources.find(name);
+        if (it == m_resources.end())
+        {
+            continue;
+        }
+
+        auto& last = it->second.last_access[k_graphics];
+        if (last.layout != final_layout)
+        {
+            m_cached_finals.push_back({.res = &it->second,
+                                       .src_stage = last.stage,
+                                       .src_access = last.access,
+                                       .old_layout = last.layout,
+                                       .new_layout = final_layout});
+            last.layout = final_layout;
+        }
+    }
+
+    m_cached_end_layouts.clear();
+    for (const vulkan_resource* res : m_cached_images)
+    {
+        m_cached_end_layouts.push_back(res->last_access[k_graphics].layout);
+    }
+
+    // Back to the frame start: execute() replays the cache from here
+    for (size_t i = 0; i < m_cached_images.size(); ++i)
+    {
+        m_cached_images[i]->owner = rg_queue::graphics;
+        m_cached_images[i]->last_access = {};
+        for (auto& access : m_cached_images[i]->last_access)
+        {
+            access.layout = m_cached_start_layouts[i];
+        }
+    }
+
+    m_barriers_valid = true;
+    ++m_barrier_cache_builds;
+}
+
+void
+vulkan_render_graph::append_barrier(const cached_barrier& b, rg_pass_barriers& barriers)
+{
+    auto* const* buf = std::get_if<vk_utils::vulkan_buffer*>(&b.res->binding);
+    auto* const* img = std::get_if<vk_utils::vulkan_image*>(&b.res->binding);
+    if (buf && *buf)
+    {
+        VkBufferMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = b.src_access;
+        barrier.dstAccessMask = b.dst_access;
+        barrier.srcQueueFamilyIndex = b.src_family;
+        barrier.dstQueueFamilyIndex = b.dst_family;
+        barrier.buffer = (*buf)->buffer();
+        barrier.offset = 0;
+        barrier.size = (*buf)->get_alloc_size();
+        barriers.buffer_barriers.push_back(barrier);
+    }
+    else if (img && *img)
+    {
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = b.src_access;
+        barrier.dstAccessMask = b.dst_access;
+        barrier.oldLayout = b.old_layout;
+        barrier.newLayout = b.new_layout;
+        barrier.srcQueueFamilyIndex = b.src_family;
+        barrier.dstQueueFamilyIndex = b.dst_family;
+        barrier.image = (*img)->image();
+        barrier.subresourceRange = color_or_depth_range(b.res->image_format);
+        barriers.image_barriers.push_back(barrier);
+    }
 }
 
 void
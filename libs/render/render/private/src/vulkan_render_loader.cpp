@@ -159,16 +159,46 @@ namespace
 // populate path and the system create path — only the destination pool differs.
 // Templated over the vertex type: static and skinned meshes build identically
 // (bounding sphere + staged upload); only the stride and m_is_skinned differ.
+// Compact meshes upload an encoded copy; bounds still come from the full vertices.
+// `shadow_indices`, then `lod_indices`, go after the main list in the same index
+// buffer; `lods` ranges are rebased onto it and out-of-range ones dropped.
 template <typename VertexT>
 mesh_data
 build_mesh_data(const kryga::utils::id& mesh_id,
                 kryga::utils::buffer_view<VertexT> vbv,
-                kryga::utils::buffer_view<gpu::uint> ibv)
+                kryga::utils::buffer_view<gpu::uint> ibv,
+                vertex_format format = vertex_format::full,
+                std::span<const gpu::uint> shadow_indices = {},
+                std::span<const gpu::uint> lod_indices = {},
+                std::span<const mesh_lod> lods = {})
 {
     auto& device = glob::glob_state().getr_render().device;
 
     mesh_data md(mesh_id);
     md.m_indices_size = (uint32_t)ibv.size();
+    md.m_shadow_first_index = (uint32_t)ibv.size();
+    md.m_shadow_index_count = (uint32_t)shadow_indices.size();
+
+    if (!lods.empty())
+    {
+        const auto lod_base = (uint32_t)(ibv.size() + shadow_indices.size());
+        md.m_lods.push_back({0U, (uint32_t)ibv.size()});
+        for (const auto& lod : lods)
+        {
+            if (lod.index_count == 0 ||
+                (size_t)lod.first_index + lod.index_count > lod_indices.size())
+            {
+                ALOG_WARN("Mesh [{}] has an out of range LOD, dropped", mesh_id.str());
+                continue;
+            }
+            auto& l = md.m_lods.emplace_back(lod);
+            l.first_index += lod_base;
+        }
+        if (md.m_lods.size() == 1)
+        {
+            md.m_lods.clear();
+        }
+    }
     md.m_vertices_size = (uint32_t)vbv.size();
     md.m_is_skinned = std::is_same_v<VertexT, gpu::skinned_vertex_data>;
 
@@ -197,8 +227,23 @@ build_mesh_data(const kryga::utils::id& mesh_id,
         md.m_bounding_radius = std::sqrt(max_dist_sq);
     }
 
-    const auto vertex_buffer_size = (uint32_t)vbv.size_bytes();
-    const auto index_buffer_size = (uint32_t)ibv.size_bytes();
+    using compact_t = std::conditional_t<std::is_same_v<VertexT, gpu::skinned_vertex_data>,
+                                         gpu::compact_skinned_vertex_data,
+                                         gpu::compact_vertex_data>;
+
+    std::vector<compact_t> compact;
+    uint8_t* vertex_src = vbv.data();
+    auto vertex_buffer_size = (uint32_t)vbv.size_bytes();
+    if (format == vertex_format::compact)
+    {
+        md.m_dequant = encode_compact_vertices(
+            std::span<const VertexT>(vbv.as(), (size_t)vbv.size()), compact);
+        md.m_vertex_format = format;
+        vertex_src = reinterpret_cast<uint8_t*>(compact.data());
+        vertex_buffer_size = (uint32_t)(compact.size() * sizeof(compact_t));
+    }
+    const auto index_buffer_size =
+        (uint32_t)(ibv.size_bytes() + shadow_indices.size_bytes() + lod_indices.size_bytes());
 
     const uint32_t buffer_size = vertex_buffer_size + index_buffer_size;
 
@@ -221,8 +266,18 @@ build_mesh_data(const kryga::utils::id& mesh_id,
 
     staging_buffer.begin();
 
-    staging_buffer.upload_data(vbv.data(), vertex_buffer_size, false);
-    staging_buffer.upload_data(ibv.data(), index_buffer_size, false);
+    staging_buffer.upload_data(vertex_src, vertex_buffer_size, false);
+    staging_buffer.upload_data(ibv.data(), (uint32_t)ibv.size_bytes(), false);
+    if (!shadow_indices.empty())
+    {
+        staging_buffer.upload_data(
+            (uint8_t*)shadow_indices.data(), (uint32_t)shadow_indices.size_bytes(), false);
+    }
+    if (!lod_indices.empty())
+    {
+        staging_buffer.upload_data(
+            (uint8_t*)lod_indices.data(), (uint32_t)lod_indices.size_bytes(), false);
+    }
 
     staging_buffer.end();
 
@@ -234,6 +289,12 @@ build_mesh_data(const kryga::utils::id& mesh_id,
     vertex_buffer_ci.size = vertex_buffer_size;
     // this buffer is going to be used as a Vertex Buffer
     vertex_buffer_ci.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    // Skinned vertices are only read by the pre-skin compute pass, by address
+    if (md.m_is_skinned)
+    {
+        vertex_buffer_ci.usage |=
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
 
     // let the VMA library know that this data should be gpu native
     vma_alloc_ci.usage = VMA_MEMORY_USAGE_GPU_ONLY;
@@ -297,10 +358,14 @@ void
 vulkan_render_loader::populate_mesh(render::types::mesh_handle h,
                                     const kryga::utils::id& mesh_id,
                                     kryga::utils::buffer_view<gpu::vertex_data> vbv,
-                                    kryga::utils::buffer_view<gpu::uint> ibv)
+                                    kryga::utils::buffer_view<gpu::uint> ibv,
+                                    vertex_format format,
+                                    std::span<const gpu::uint> shadow_indices,
+                                    std::span<const gpu::uint> lod_indices,
+                                    std::span<const mesh_lod> lods)
 {
     KRG_check_render_thread();
-    auto md = build_mesh_data(mesh_id, vbv, ibv);
+    auto md = build_mesh_data(mesh_id, vbv, ibv, format, shadow_indices, lod_indices, lods);
     md.set_render_handle(h);
     // Growth rides the command: grower == reader == render thread.
     m_meshes_storage.grow_for(h);
@@ -329,10 +394,11 @@ void
 vulkan_render_loader::populate_skinned_mesh(render::types::mesh_handle h,
                                             const kryga::utils::id& mesh_id,
                                             kryga::utils::buffer_view<gpu::skinned_vertex_data> vbv,
-                                            kryga::utils::buffer_view<gpu::uint> ibv)
+                                            kryga::utils::buffer_view<gpu::uint> ibv,
+                                            vertex_format format)
 {
     KRG_check_render_thread();
-    auto md = build_mesh_data(mesh_id, vbv, ibv);
+    auto md = build_mesh_data(mesh_id, vbv, ibv, format);
     md.set_render_handle(h);
     // Growth rides the command: grower == reader == render thread.
     m_meshes_storage.grow_for(h);
@@ -513,6 +579,10 @@ vulkan_render_loader::update_object(vulkan_render_data& obj_data,
     obj_data.gpu_data.lightmap_offset = glm::vec2(0.0f, 0.0f);
     obj_data.gpu_data.lightmap_texture_index = 0xFFFFFFFFu;
 
+    // Read only by the compact pipelines, which only draw compact meshes
+    obj_data.gpu_data.position_scale = mesh_data.m_dequant.scale;
+    obj_data.gpu_data.position_offset = mesh_data.m_dequant.offset;
+
     return true;
 }
 
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include "vulkan_render/font_atlas.h"
+
+#include <string_view>
+
+using namespace kryga::render;
+
+namespace
+{
+
+constexpr uint32_t k_missing = 0x2603;  // not in the test font
+constexpr uint32_t k_blank = 0x2800;    // has metrics, rasterises to nothing
+
+class test_glyph_source final : public glyph_source
+{
+public:
+    bool
+    metrics(uint32_t codepoint, glyph_metrics& out) const override
+    {
+        if (codepoint == k_missing)
+        {
+            return false;
+        }
+        out.advance = codepoint == '?' ? 7.f : 10.f;
+        out.size = {8.f, 10.f};
+        return true;
+    }
+
+    bool
+    rasterize(uint32_t codepoint, glyph_bitmap& out) const override
+    {
+        ++rasterized;
+        if (codepoint == k_blank)
+        {
+            return false;
+        }
+        out.width = 8;
+        out.height = 10;
+        out.pixels.assign(80, 200);
+        return true;
+    }
+
+    mutable uint32_t rasterized = 0;
+};
+
+font_atlas
+make_font(test_glyph_source** source = nullptr)
+{
+    auto src = std::make_unique<test_glyph_source>();
+    if (source)
+    {
+        *source = src.get();
+    }
+    return font_atlas(std::move(src), 20.f, 16.f, 24.f, false);
+}
+
+std::vector<uint32_t>
+decode_all(std::string_view s)
+{
+    std::vector<uint32_t> out;
+    for (size_t pos = 0; pos < s.size();)
+    {
+        out.push_back(decode_utf8(s, pos));
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(font_atlas, decode_utf8)
+{
+    EXPECT_EQ(decode_all("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"),
+              (std::vector<uint32_t>{'a', 0xE9, 0x20AC, 0x1F600}));
+
+    // Truncated, overlong, surrogate and stray continuation bytes
+    EXPECT_EQ(decode_all("\xC3"), (std::vector<uint32_t>{0xFFFD}));
+    EXPECT_EQ(decode_all("\xC0\xAF"), (std::vector<uint32_t>{0xFFFD}));
+    EXPECT_EQ(decode_all("\xED\xA0\x80"), (std::vector<uint32_t>{0xFFFD}));
+    EXPECT_EQ(decode_all("\x80z"), (std::vector<uint32_t>{0xFFFD, 'z'}));
+}
+
+TEST(font_atlas, missing_codepoint_uses_fallback)
+{
+    auto font = make_font();
+
+    EXPECT_FLOAT_EQ(font.acquire(k_missing).advance, 7.f);
+    font.pump();
+
+    EXPECT_TRUE(font.peek(k_missing).resident());
+    EXPECT_TRUE(font.peek('?').resident());
+    EXPECT_EQ(font.resident_count(), 1u);
+    EXPECT_EQ(font.revision(), 1u);
+}
+
+TEST(font_atlas, evicts_least_recently_used_unpinned_glyph)
+{
+    auto font = make_font();
+    constexpr uint32_t k_capacity = font_atlas::k_max_pages * font_atlas::k_cells_per_page;
+    constexpr uint32_t k_base = 0x100;
+
+    // Fill every cell; keep only the first glyph pinned
+    for (uint32_t i = 0; i < k_capacity; ++i)
+    {
+        font.acquire(k_base + i);
+        if (i != 0)
+        {
+            font.release(k_base + i);
+        }
+    }
+    font.pump();
+    ASSERT_EQ(font.resident_count(), k_capacity);
+    ASSERT_EQ(font.pages().size(), font_atlas::k_max_pages);
+
+    // Touch everything but k_base + 1, making it the oldest
+    for (uint32_t i = 2; i < k_capacity; ++i)
+    {
+        font.acquire(k_base + i);
+        font.release(k_base + i);
+    }
+
+    font.acquire(k_base + k_capacity);
+    font.pump();
+
+    EXPECT_EQ(font.resident_count(), k_capacity);
+    EXPECT_TRUE(font.peek(k_base + k_capacity).resident());
+    EXPECT_FALSE(font.peek(k_base + 1).resident());
+    EXPECT_TRUE(font.peek(k_base).resident());
+}
+
+TEST(font_atlas, glyph_without_ink_is_rasterised_once)
+{
+    test_glyph_source* source = nullptr;
+    auto font = make_font(&source);
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        font.acquire(k_blank);
+        font.release(k_blank);
+        font.pump();
+    }
+
+    EXPECT_EQ(source->rasterized, 1u);
+    EXPECT_FALSE(font.peek(k_blank).resident());
+    EXPECT_EQ(font.revision(), 0u);
+}
+
+TEST(font_atlas, glyph_waits_for_an_unpinned_cell)
+{
+    test_glyph_source* source = nullptr;
+    auto font = make_font(&source);
+    constexpr uint32_t k_capacity = font_atlas::k_max_pages * font_atlas::k_cells_per_page;
+    constexpr uint32_t k_base = 0x100;
+    constexpr uint32_t k_late = k_base + k_capacity;
+
+    // Every cell pinned
+    for (uint32_t i = 0; i < k_capacity; ++i)
+    {
+        font.acquire(k_base + i);
+    }
+    font.pump();
+    ASSERT_EQ(font.resident_count(), k_capacity);
+
+    // Re-acquired each frame, rasterised once and held back
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        font.acquire(k_late);
+        font.release(k_late);
+        font.pump();
+    }
+    EXPECT_EQ(source->rasterized, k_capacity + 1);
+    EXPECT_FALSE(font.peek(k_late).resident());
+
+    font.release(k_base);
+    font.pump();
+    EXPECT_EQ(source->rasterized, k_capacity + 1);
+    EXPECT_TRUE(font.peek(k_late).resident());
+    EXPECT_FALSE(font.peek(k_base).resident());
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "vulkan_render/frame_telemetry.h"
+
+#include <algorithm>
+
+using namespace kryga::render;
+
+namespace
+{
+
+// One frame through both threads' stages with explicit timestamps (us after `base`)
+void
+run_frame(frame_telemetry& t, uint64_t base, uint64_t begin, uint64_t submit, uint64_t present)
+{
+    const uint64_t f = t.open_frame();
+    t.stamp(f, frame_stamp::begin_frame, base + begin);
+    t.stamp(f, frame_stamp::submit_frame, base + submit);
+
+    ASSERT_EQ(t.begin_render_frame(), f);
+    t.stamp(f, frame_stamp::drain_begin, base + submit);
+    t.stamp(f, frame_stamp::drain_end, base + submit + 100);
+    t.stamp(f, frame_stamp::present, base + present);
+    t.commit(f);
+}
+
+}  // namespace
+
+TEST(frame_histogram, buckets_are_exact_then_log_linear)
+{
+    for (uint64_t v : {0ull, 1ull, 255ull, 256ull, 257ull, 16667ull, 1000000ull})
+    {
+        const uint64_t upper = frame_histogram::bucket_upper(frame_histogram::bucket_of(v));
+        EXPECT_GE(upper, v);
+        EXPECT_LE(upper - v, v / 128) << v;
+    }
+    EXPECT_EQ(frame_histogram::bucket_of(255), 255u);
+    EXPECT_EQ(frame_histogram::bucket_of(frame_histogram::k_max_value),
+              frame_histogram::k_bucket_count - 1);
+    EXPECT_EQ(frame_histogram::bucket_of(~0ull), frame_histogram::k_bucket_count - 1);
+}
+
+TEST(frame_histogram, percentiles)
+{
+    frame_histogram h;
+    EXPECT_EQ(h.percentile(0.99), 0u);
+
+    for (uint64_t i = 1; i <= 100; ++i)
+    {
+        h.record(i);
+    }
+    h.record(50000);
+
+    EXPECT_EQ(h.count(), 101u);
+    EXPECT_EQ(h.max(), 50000u);
+    EXPECT_EQ(h.percentile(0.5), 51u);
+    EXPECT_EQ(h.percentile(0.99), 100u);
+    EXPECT_EQ(h.percentile(1.0), 50000u);
+
+    h.reset();
+    EXPECT_EQ(h.count(), 0u);
+    EXPECT_EQ(h.percentile(0.5), 0u);
+}
+
+TEST(frame_telemetry, metrics_and_stall_attribution)
+{
+    frame_telemetry t;
+    uint64_t base = frame_telemetry::now_us();
+
+    // 16 ms cadence; the second frame waited 5 ms at the pipeline gate
+    run_frame(t, base, 0, 4000, 10000);
+    run_frame(t, base, 12000, 20000, 26000);
+    EXPECT_EQ(t.committed(), 2u);
+
+    const auto& interval = t.histogram(frame_metric::interval);
+    EXPECT_EQ(interval.count(), 1u);
+    EXPECT_EQ(interval.max(), 16000u);
+    EXPECT_EQ(t.histogram(frame_metric::latency).max(), 14000u);
+
+    frame_telemetry s;
+    base = frame_telemetry::now_us();
+    const uint64_t f = s.open_frame();
+    s.stamp(f, frame_stamp::begin_frame, base);
+    s.add_wait(f, frame_gate::pipeline, 5000);
+    s.add_wait(f, frame_gate::frame_fence, 2000);
+    s.stamp(f, frame_stamp::submit_frame, base + 8000);
+    s.begin_render_frame();
+    s.add_wait(f, frame_gate::acquire, 500);
+    s.stamp(f, frame_stamp::present, base + 9000);
+    s.commit(f);
+
+    EXPECT_EQ(s.histogram(frame_metric::build).max(), 3000u);
+    EXPECT_EQ(s.gate(frame_gate::pipeline).dominant_frames, 1u);
+    EXPECT_EQ(s.gate(frame_gate::frame_fence).dominant_frames, 0u);
+    EXPECT_EQ(s.gate(frame_gate::frame_fence).total_us, 2000u);
+    EXPECT_EQ(s.gate(frame_gate::acquire).max_us, 500u);
+
+    s.request_reset();
+    run_frame(s, base, 10000, 12000, 14000);
+    EXPECT_EQ(s.gate(frame_gate::pipeline).total_us, 0u);
+    EXPECT_EQ(s.histogram(frame_metric::latency).count(), 1u);
+}
+
+TEST(frame_telemetry, ring_keeps_the_latest_frames)
+{
+    frame_telemetry t;
+    const uint64_t base = frame_telemetry::now_us();
+    const uint64_t total = frame_telemetry::k_ring + 10;
+
+    for (uint64_t i = 0; i < total; ++i)
+    {
+        run_frame(t, base, i * 1000, i * 1000 + 200, i * 1000 + 900);
+    }
+
+    // Overwritten frames are skipped, the cursor reads on from the oldest retained
+    auto all = t.read(0);
+    ASSERT_EQ(all.size(), frame_telemetry::k_ring);
+    EXPECT_EQ(all.front().frame, 10u);
+    EXPECT_EQ(all.back().frame, total - 1);
+    EXPECT_EQ(all.back().interval_us, 1000u);
+
+    auto tail = t.read(total - 2, 1);
+    ASSERT_EQ(tail.size(), 1u);
+    EXPECT_EQ(tail[0].frame, total - 2);
+    EXPECT_TRUE(t.read(total).empty());
+
+    const auto csv = frame_telemetry::to_csv(tail);
+    EXPECT_EQ(csv.rfind("frame,begin_frame_us,", 0), 0u);
+    EXPECT_EQ(std::count(csv.begin(), csv.end(), '\n'), 2);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "vulkan_render/gpu_pass_profiler.h"
+
+using namespace kryga::render;
+
+TEST(gpu_timing_window, empty_window_reports_zero)
+{
+    gpu_timing_window w;
+    auto s = w.summarize();
+
+    EXPECT_EQ(s.samples, 0u);
+    EXPECT_FLOAT_EQ(s.avg_ms, 0.f);
+    EXPECT_FLOAT_EQ(s.p99_ms, 0.f);
+}
+
+TEST(gpu_timing_window, min_avg_p99_over_partial_window)
+{
+    gpu_timing_window w;
+    for (int i = 1; i <= 100; ++i)
+    {
+        w.add(static_cast<float>(i));
+    }
+
+    auto s = w.summarize();
+    EXPECT_EQ(s.samples, 100u);
+    EXPECT_FLOAT_EQ(s.last_ms, 100.f);
+    EXPECT_FLOAT_EQ(s.min_ms, 1.f);
+    EXPECT_FLOAT_EQ(s.avg_ms, 50.5f);
+    EXPECT_FLOAT_EQ(s.p99_ms, 99.f);  // nearest rank
+}
+
+TEST(gpu_timing_window, old_samples_fall_out)
+{
+    gpu_timing_window w;
+
+    // One early spike, then a full window of steady frames pushes it out
+    w.add(50.f);
+    for (uint32_t i = 0; i < gpu_timing_window::k_size; ++i)
+    {
+        w.add(2.f);
+    }
+
+    auto s = w.summarize();
+    EXPECT_EQ(s.samples, gpu_timing_window::k_size);
+    EXPECT_FLOAT_EQ(s.p99_ms, 2.f);
+    EXPECT_FLOAT_EQ(s.avg_ms, 2.f);
+
+    // Spikes reach p99 once they are more than 1% of the window
+    w.add(30.f);
+    w.add(30.f);
+    w.add(30.f);
+    s = w.summarize();
+    EXPECT_FLOAT_EQ(s.last_ms, 30.f);
+    EXPECT_FLOAT_EQ(s.p99_ms, 30.f);
+    EXPECT_FLOAT_EQ(s.min_ms, 2.f);
+}
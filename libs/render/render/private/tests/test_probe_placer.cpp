@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include "vulkan_render/bake/bvh_builder.h"
+#include "vulkan_render/bake/bvh_trace.h"
+#include "vulkan_render/bake/probe_placer.h"
+#include "vulkan_render/bake/probe_sh_projector.h"
+
+#include <cstring>
+
+using namespace kryga;
+using namespace kryga::render::bake;
+
+namespace
+{
+
+// Axis-aligned box. inward = true gives a room (normals point inside),
+// false a solid block (normals point outside).
+void
+append_box(std::vector<gpu::vertex_data>& verts,
+           std::vector<uint32_t>& indices,
+           const glm::vec3& mn,
+           const glm::vec3& mx,
+           bool inward)
+{
+    const glm::vec3 corners[8] = {
+        {mn.x, mn.y, mn.z}, {mx.x, mn.y, mn.z}, {mx.x, mx.y, mn.z}, {mn.x, mx.y, mn.z},
+        {mn.x, mn.y, mx.z}, {mx.x, mn.y, mx.z}, {mx.x, mx.y, mx.z}, {mn.x, mx.y, mx.z},
+    };
+
+    struct face
+    {
+        uint32_t q[4];
+        glm::vec3 n;
+    };
+    const face faces[6] = {
+        {{0, 3, 2, 1}, {0, 0, -1}},
+        {{4, 5, 6, 7}, {0, 0, 1}},
+        {{0, 4, 7, 3}, {-1, 0, 0}},
+        {{1, 2, 6, 5}, {1, 0, 0}},
+        {{0, 1, 5, 4}, {0, -1, 0}},
+        {{3, 7, 6, 2}, {0, 1, 0}},
+    };
+
+    for (const auto& f : faces)
+    {
+        auto base = static_cast<uint32_t>(verts.size());
+        for (uint32_t c : f.q)
+        {
+            gpu::vertex_data v{};
+            v.position = corners[c];
+            v.normal = inward ? -f.n : f.n;
+            v.uv2 = glm::vec2(0.5f);
+            verts.push_back(v);
+        }
+        for (uint32_t i : {0u, 1u, 2u, 0u, 2u, 3u})
+        {
+            indices.push_back(base + i);
+        }
+    }
+}
+
+struct test_scene
+{
+    std::vector<gpu::vertex_data> verts;
+    std::vector<uint32_t> indices;
+    bvh_build_result bvh;
+
+    void
+    build()
+    {
+        bvh = build_bvh(verts.data(),
+                        static_cast<uint32_t>(verts.size()),
+                        indices.data(),
+                        static_cast<uint32_t>(indices.size()));
+    }
+};
+
+}  // namespace
+
+TEST(probe_placer, trace_reports_back_faces)
+{
+    test_scene scene;
+    append_box(scene.verts, scene.indices, glm::vec3(-1), glm::vec3(1), false);
+    scene.build();
+
+    auto outside = trace_ray(scene.bvh, {0, 0, 5}, {0, 0, -1}, 100.0f);
+    ASSERT_TRUE(outside.is_hit());
+    EXPECT_NEAR(outside.t, 4.0f, 1e-4f);
+    EXPECT_FALSE(outside.back_face);
+
+    auto inside = trace_ray(scene.bvh, {0, 0, 0}, {0, 0, -1}, 100.0f);
+    ASSERT_TRUE(inside.is_hit());
+    EXPECT_TRUE(inside.back_face);
+
+    auto miss = trace_ray(scene.bvh, {0, 5, 5}, {0, 0, -1}, 100.0f);
+    EXPECT_FALSE(miss.is_hit());
+
+    EXPECT_TRUE(overlaps_box(scene.bvh, glm::vec3(0.5f), glm::vec3(2.0f)));
+    EXPECT_FALSE(overlaps_box(scene.bvh, glm::vec3(2.0f), glm::vec3(3.0f)));
+}
+
+TEST(probe_placer, validated_grid_rejects_or_relocates_probes_in_walls)
+{
+    test_scene scene;
+    append_box(scene.verts, scene.indices, glm::vec3(-5), glm::vec3(5), true);
+    // Block faces sit 0.2 past the probes at +-1: those can be pushed out, the
+    // centre probe cannot
+    append_box(scene.verts, scene.indices, glm::vec3(-1.2f), glm::vec3(1.2f), false);
+    scene.build();
+
+    probe_placement_params params;
+    params.spacing = 1.0f;
+    params.margin = 0.0f;
+
+    auto grid = place_probes_grid(scene.verts.data(),
+                                  static_cast<uint32_t>(scene.verts.size()),
+                                  scene.indices.data(),
+                                  static_cast<uint32_t>(scene.indices.size()),
+                                  params);
+
+    auto validated = place_probes_validated(scene.verts.data(),
+                                            static_cast<uint32_t>(scene.verts.size()),
+                                            scene.indices.data(),
+                                            static_cast<uint32_t>(scene.indices.size()),
+                                            scene.bvh,
+                                            params);
+
+    // Grid layout is preserved for interpolated lookup
+    ASSERT_EQ(validated.positions.size(), grid.positions.size());
+    EXPECT_EQ(validated.grid_config.grid_size_x, grid.grid_config.grid_size_x);
+
+    EXPECT_GT(validated.invalid_count, 0u);
+    EXPECT_GT(validated.relocated_count, 0u);
+
+    // Nothing valid may remain inside the solid block
+    for (size_t i = 0; i < validated.positions.size(); ++i)
+    {
+        if (validated.flags[i] & probe_flag_invalid)
+        {
+            EXPECT_EQ(validated.radii[i], 0.0f);
+            continue;
+        }
+        auto p = validated.positions[i];
+        bool in_block = glm::all(glm::greaterThan(p, glm::vec3(-1.2f))) &&
+                        glm::all(glm::lessThan(p, glm::vec3(1.2f)));
+        EXPECT_FALSE(in_block) << p.x << " " << p.y << " " << p.z;
+    }
+}
+
+TEST(probe_placer, adaptive_drops_empty_space_and_densifies_near_geometry)
+{
+    test_scene scene;
+    // Small prop in a big empty volume — most of the uniform grid is sky
+    append_box(scene.verts, scene.indices, glm::vec3(-0.5f), glm::vec3(0.5f), false);
+    gpu::vertex_data far_marker{};
+    far_marker.position = glm::vec3(32.0f);
+    scene.verts.push_back(far_marker);
+    scene.build();
+
+    probe_placement_params params;
+    params.spacing = 2.0f;
+    params.adaptive_levels = 2;
+
+    auto grid = place_probes_grid(scene.verts.data(),
+                                  static_cast<uint32_t>(scene.verts.size()),
+                                  scene.indices.data(),
+                                  static_cast<uint32_t>(scene.indices.size()),
+                                  params);
+
+    auto adaptive = place_probes_adaptive(scene.verts.data(),
+                                          static_cast<uint32_t>(scene.verts.size()),
+                                          scene.indices.data(),
+                                          static_cast<uint32_t>(scene.indices.size()),
+                                          scene.bvh,
+                                          params);
+
+    ASSERT_FALSE(adaptive.positions.empty());
+    EXPECT_LT(adaptive.positions.size(), grid.positions.size() / 4);
+    EXPECT_EQ(adaptive.grid_config.grid_size_x, 0u);
+    EXPECT_EQ(adaptive.grid_config.probe_count, adaptive.positions.size());
+
+    // Refined cells next to the prop carry the finest radius
+    float finest = params.spacing / 4.0f;
+    bool has_fine = false;
+    for (size_t i = 0; i < adaptive.positions.size(); ++i)
+    {
+        EXPECT_EQ(adaptive.flags[i] & (probe_flag_invalid | probe_flag_empty), 0);
+        has_fine |= adaptive.radii[i] == finest;
+    }
+    EXPECT_TRUE(has_fine);
+
+    // Objects next to the prop resolve to one of its probes
+    uint32_t near_prop = find_probe_index(adaptive, glm::vec3(0.0f, 1.0f, 0.0f));
+    ASSERT_LT(near_prop, adaptive.positions.size());
+    EXPECT_LT(glm::length(adaptive.positions[near_prop] - glm::vec3(0.0f, 1.0f, 0.0f)), 1.0f);
+}
+
+TEST(probe_placer, probe_index_picks_nearest_valid_probe)
+{
+    probe_placement_result placement;
+    placement.positions = {{0, 0, 0}, {1, 0, 0}, {4, 0, 0}};
+    placement.radii = {1.0f, 0.0f, 1.0f};
+
+    EXPECT_EQ(find_probe_index(placement, {0.2f, 0, 0}), 0u);
+    // The invalid probe is closer but skipped
+    EXPECT_EQ(find_probe_index(placement, {1.1f, 0, 0}), 0u);
+    EXPECT_EQ(find_probe_index(placement, {3.0f, 0, 0}), 2u);
+
+    placement.radii = {0.0f, 0.0f, 0.0f};
+    EXPECT_EQ(find_probe_index(placement, {0, 0, 0}), 0xFFFFFFFFu);
+}
+
+TEST(probe_placer, cpu_projection_of_uniform_radiance)
+{
+    test_scene scene;
+    append_box(scene.verts, scene.indices, glm::vec3(-5), glm::vec3(5), true);
+    scene.build();
+
+    // 1x1 RGBA16F lightmap, white (half 1.0 = 0x3C00)
+    uint16_t lightmap[4] = {0x3C00, 0x3C00, 0x3C00, 0x3C00};
+
+    probe_placement_result placement;
+    placement.positions = {{0, 0, 0}, {2, 1, -3}, {0, 0, 0}};
+    placement.radii = {1.0f, 1.0f, 0.0f};
+
+    probe_projection_params params;
+    params.sample_count = 512;
+    params.thread_count = 2;
+    // Rays slipping through a shared edge still see the same radiance
+    params.miss_radiance = glm::vec3(1.0f);
+
+    auto probes = project_probes_sh(scene.bvh, lightmap, 1, 1, placement, params);
+    ASSERT_EQ(probes.size(), 3u);
+
+    // Constant radiance projects only onto L0: 4*pi * Y00 for every channel
+    constexpr float k_expected_l0 = 4.0f * 3.14159265f * 0.282095f;
+    for (int p = 0; p < 2; ++p)
+    {
+        float coeffs[28];
+        std::memcpy(coeffs, probes[p].coefficients, sizeof(coeffs));
+        EXPECT_NEAR(coeffs[0], k_expected_l0, 1e-3f);
+        EXPECT_NEAR(coeffs[9], k_expected_l0, 1e-3f);
+        EXPECT_NEAR(coeffs[18], k_expected_l0, 1e-3f);
+        EXPECT_EQ(probes[p].radius, 1.0f);
+    }
+
+    // Invalid probe is left untouched
+    EXPECT_EQ(probes[2].coefficients[0].x, 0.0f);
+    EXPECT_EQ(probes[2].radius, 0.0f);
+}
@@ -7,6 +7,8 @@
 #include "vulkan_render/types/binding_table.h"
 #include "vulkan_render/vk_descriptors.h"
 
+#include <algorithm>
+
 using namespace kryga::render;
 
 // Test descriptor layout cache that returns dummy handles without a VkDevice
@@ -209,7 +211,7 @@ TEST(RenderGraph, compile_empty_graph)
 TEST(RenderGraph, compile_single_pass)
 {
     vulkan_render_graph graph;
-    graph.register_buffer(AID("output"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.import_resource(AID("output"), rg_resource_type::buffer);
     graph.add_compute_pass(AID("pass"), {graph.write(AID("output"))}, [](VkCommandBuffer) {});
 
     EXPECT_TRUE(graph.compile());
@@ -221,7 +223,7 @@ TEST(RenderGraph, compile_multiple_passes)
 {
     vulkan_render_graph graph;
     graph.register_buffer(AID("a"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
-    graph.register_buffer(AID("b"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.import_resource(AID("b"), rg_resource_type::buffer);
 
     graph.add_compute_pass(AID("pass1"), {graph.write(AID("a"))}, [](VkCommandBuffer) {});
     graph.add_compute_pass(
@@ -241,7 +243,7 @@ TEST(RenderGraph, linear_dependency_chain)
 
     graph.register_buffer(AID("A"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
     graph.register_buffer(AID("B"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
-    graph.register_buffer(AID("C"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.import_resource(AID("C"), rg_resource_type::buffer);
 
     // Pass order in code: 1, 2, 3
     // Dependency chain: pass1 writes A -> pass2 reads A, writes B -> pass3 reads B
@@ -269,8 +271,8 @@ TEST(RenderGraph, independent_passes_both_compile)
 {
     vulkan_render_graph graph;
 
-    graph.register_buffer(AID("A"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
-    graph.register_buffer(AID("B"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.import_resource(AID("A"), rg_resource_type::buffer);
+    graph.import_resource(AID("B"), rg_resource_type::buffer);
 
     // Two independent passes writing to different resources
     graph.add_compute_pass(AID("pass_a"), {graph.write(AID("A"))}, [](VkCommandBuffer) {});
@@ -293,7 +295,7 @@ TEST(RenderGraph, diamond_dependency)
     graph.register_buffer(AID("A"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
     graph.register_buffer(AID("B"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
     graph.register_buffer(AID("C"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
-    graph.register_buffer(AID("D"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.import_resource(AID("D"), rg_resource_type::buffer);
 
     graph.add_compute_pass(AID("pass1"), {graph.write(AID("A"))}, [](VkCommandBuffer) {});
     graph.add_compute_pass(
@@ -495,6 +497,285 @@ TEST(RenderGraph, bda_validation_passes_without_shader_effects)
     EXPECT_TRUE(graph.compile());
 }
 
+// ============================================================================
+// Split pass chunk planning
+// ============================================================================
+
+TEST(RenderGraph, split_chunks_cover_items_within_lane_share)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> passes = {{3, 21}, {5, 0}, {7, 5}};
+    std::vector<rg_split_chunk> chunks;
+    vulkan_render_graph::plan_split_chunks(passes, 8, chunks);
+
+    // 21 items get half the lanes, 5 items can't fill the other half
+    ASSERT_EQ(chunks.size(), 6u);
+
+    uint32_t next[8] = {};
+    uint32_t per_pass[8] = {};
+    for (uint32_t i = 0; i < chunks.size(); ++i)
+    {
+        const auto& c = chunks[i];
+        EXPECT_EQ(c.lane, i);
+        EXPECT_EQ(c.begin, next[c.pass]);
+        EXPECT_GT(c.end, c.begin);
+        next[c.pass] = c.end;
+        ++per_pass[c.pass];
+    }
+    EXPECT_EQ(next[3], 21u);
+    EXPECT_EQ(next[7], 5u);
+    EXPECT_EQ(per_pass[3], 4u);
+    EXPECT_EQ(per_pass[5], 0u);
+    EXPECT_EQ(per_pass[7], 2u);
+}
+
+TEST(RenderGraph, split_chunks_stop_when_lanes_run_out)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> passes = {{0, 100}, {1, 100}, {2, 100}};
+    std::vector<rg_split_chunk> chunks;
+    vulkan_render_graph::plan_split_chunks(passes, 2, chunks);
+
+    ASSERT_EQ(chunks.size(), 2u);
+    EXPECT_EQ(chunks[0].pass, 0u);
+    EXPECT_EQ(chunks[1].pass, 1u);
+    EXPECT_EQ(chunks[1].end, 100u);
+
+    // The last pass gets no chunk and records inline
+    vulkan_render_graph::plan_split_chunks({}, 4, chunks);
+    EXPECT_TRUE(chunks.empty());
+}
+
+// ============================================================================
+// Dead-pass culling
+// ============================================================================
+
+TEST(RenderGraph, passes_not_reaching_an_output_are_culled)
+{
+    vulkan_render_graph graph;
+    graph.register_transient_image(AID("blurred"),
+                                   256,
+                                   256,
+                                   VK_FORMAT_R8G8B8A8_UNORM,
+                                   VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
+    graph.register_transient_image(
+        AID("debug_view"), 256, 256, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_STORAGE_BIT);
+    graph.import_resource(AID("out"), rg_resource_type::buffer);
+
+    // 0 -> 2 reach an imported write; 1 feeds nothing, 3 only feeds 1
+    graph.add_compute_pass(AID("blur"), {graph.write(AID("blurred"))}, [](VkCommandBuffer) {});
+    graph.add_compute_pass(AID("debug"),
+                           {graph.read(AID("blurred")), graph.write(AID("debug_view"))},
+                           [](VkCommandBuffer) {});
+    graph.add_compute_pass(AID("resolve"),
+                           {graph.read(AID("blurred")), graph.write(AID("out"))},
+                           [](VkCommandBuffer) {});
+    graph.add_compute_pass(
+        AID("debug_prep"), {graph.read_write(AID("debug_view"))}, [](VkCommandBuffer) {});
+
+    ASSERT_TRUE(graph.compile());
+    EXPECT_FALSE(graph.is_pass_culled(0));
+    EXPECT_TRUE(graph.is_pass_culled(1));
+    EXPECT_FALSE(graph.is_pass_culled(2));
+    EXPECT_TRUE(graph.is_pass_culled(3));
+    EXPECT_EQ(graph.get_culled_count(), 2u);
+    EXPECT_EQ(graph.get_execution_order(), (std::vector<size_t>{0, 2}));
+}
+
+TEST(RenderGraph, unread_graph_owned_writes_are_culled)
+{
+    vulkan_render_graph graph;
+    graph.register_buffer(AID("stats"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.register_buffer(AID("visible"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.register_image(
+        AID("scene"), 64, 64, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_STORAGE_BIT);
+    graph.import_resource(AID("ui"), rg_resource_type::image);
+    graph.set_final_layout(AID("scene"), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+    // Registered, not transient, and read by nobody: still dead
+    graph.add_compute_pass(AID("stats"), {graph.write(AID("stats"))}, [](VkCommandBuffer) {});
+    // Only feeds a culled pass
+    graph.add_compute_pass(AID("cull"), {graph.write(AID("visible"))}, [](VkCommandBuffer) {});
+    graph.add_compute_pass(AID("count"),
+                           {graph.read(AID("visible")), graph.read_write(AID("stats"))},
+                           [](VkCommandBuffer) {});
+    // Outputs: an image with a final layout, an imported one
+    graph.add_compute_pass(AID("scene"), {graph.write(AID("scene"))}, [](VkCommandBuffer) {});
+    graph.add_compute_pass(AID("ui"), {graph.write(AID("ui"))}, [](VkCommandBuffer) {});
+
+    ASSERT_TRUE(graph.compile());
+    EXPECT_TRUE(graph.is_pass_culled(0));
+    EXPECT_TRUE(graph.is_pass_culled(1));
+    EXPECT_TRUE(graph.is_pass_culled(2));
+    EXPECT_FALSE(graph.is_pass_culled(3));
+    EXPECT_FALSE(graph.is_pass_culled(4));
+    EXPECT_EQ(graph.get_culled_count(), 3u);
+    EXPECT_EQ(graph.get_execution_order().size(), 2u);
+}
+
+TEST(RenderGraph, passes_without_declared_writes_are_kept)
+{
+    vulkan_render_graph graph;
+    graph.register_buffer(AID("in"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.add_compute_pass(AID("readback"), {graph.read(AID("in"))}, [](VkCommandBuffer) {});
+
+    ASSERT_TRUE(graph.compile());
+    EXPECT_EQ(graph.get_culled_count(), 0u);
+    EXPECT_EQ(graph.get_execution_order().size(), 1u);
+}
+
+// ============================================================================
+// Transient aliasing
+// ============================================================================
+
+TEST(RenderGraph, aliasing_reuses_memory_of_finished_transients)
+{
+    // a and b never live together; c overlaps both
+    std::vector<rg_alias_request> requests = {
+        {.first = 0, .last = 1, .size = 1000, .alignment = 256},
+        {.first = 2, .last = 3, .size = 1000, .alignment = 256},
+        {.first = 1, .last = 2, .size = 500, .alignment = 256},
+    };
+    std::vector<rg_alias_placement> placements;
+    std::vector<rg_alias_heap> heaps;
+    vulkan_render_graph::plan_aliasing(requests, placements, heaps);
+
+    ASSERT_EQ(heaps.size(), 1u);
+    EXPECT_EQ(placements[0].offset, 0u);
+    EXPECT_EQ(placements[1].offset, 0u);
+    EXPECT_EQ(placements[2].offset, 1024u);  // aligned past a and b
+    EXPECT_EQ(heaps[0].size, 1524u);
+    EXPECT_EQ(heaps[0].alignment, 256u);
+}
+
+TEST(RenderGraph, aliasing_fills_gaps_and_splits_by_memory_type)
+{
+    std::vector<rg_alias_request> requests = {
+        {.first = 0, .last = 4, .size = 400, .memory_type_bits = 0b011},
+        {.first = 0, .last = 1, .size = 300, .memory_type_bits = 0b010},
+        {.first = 2, .last = 4, .size = 200, .memory_type_bits = 0b110},
+        {.first = 3, .last = 3, .size = 100, .memory_type_bits = 0b100},
+    };
+    std::vector<rg_alias_placement> placements;
+    std::vector<rg_alias_heap> heaps;
+    vulkan_render_graph::plan_aliasing(requests, placements, heaps);
+
+    // The 300 and 200 share the bytes after the 400; the last allows no type of
+    // that heap and gets one of its own
+    ASSERT_EQ(heaps.size(), 2u);
+    EXPECT_EQ(placements[0].heap, 0u);
+    EXPECT_EQ(placements[1].offset, 400u);
+    EXPECT_EQ(placements[2].heap, 0u);
+    EXPECT_EQ(placements[2].offset, 400u);
+    EXPECT_EQ(heaps[0].size, 700u);
+    EXPECT_EQ(heaps[0].memory_type_bits, 0b010u);
+    EXPECT_EQ(placements[3].heap, 1u);
+    EXPECT_EQ(heaps[1].size, 100u);
+}
+
+// ============================================================================
+// Async compute scheduling
+// ============================================================================
+
+// Segment holding pass `idx`, or -1
+static int32_t
+segment_of(const vulkan_render_graph& graph, size_t idx)
+{
+    const auto& segments = graph.get_segments();
+    for (size_t s = 0; s < segments.size(); ++s)
+    {
+        const auto& passes = segments[s].passes;
+        if (std::find(passes.begin(), passes.end(), idx) != passes.end())
+        {
+            return static_cast<int32_t>(s);
+        }
+    }
+    return -1;
+}
+
+TEST(RenderGraph, async_passes_overlap_independent_graphics_work)
+{
+    vulkan_render_graph graph;
+    graph.set_async_compute(0, 1, [](rg_queue) { return VkCommandBuffer{}; });
+
+    graph.register_buffer(AID("lights"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.register_buffer(AID("clusters"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.register_buffer(AID("shadow"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.import_resource(AID("frame"), rg_resource_type::buffer);
+
+    // 0: async, 1: independent of it, 2: consumes both
+    graph
+        .add_compute_pass(AID("cull"),
+                          {graph.read(AID("lights")), graph.write(AID("clusters"))},
+                          [](VkCommandBuffer) {})
+        ->set_async_compute(true);
+    graph.add_compute_pass(AID("shadow"), {graph.write(AID("shadow"))}, [](VkCommandBuffer) {});
+    graph.add_compute_pass(
+        AID("main"),
+        {graph.read(AID("clusters")), graph.read(AID("shadow")), graph.write(AID("frame"))},
+        [](VkCommandBuffer) {});
+
+    ASSERT_TRUE(graph.compile());
+    EXPECT_EQ(graph.get_pass_queue(0), rg_queue::async_compute);
+    EXPECT_EQ(graph.get_pass_queue(1), rg_queue::graphics);
+
+    const auto& segments = graph.get_segments();
+    ASSERT_EQ(segments.size(), 4u);
+
+    // Segment 0 is the caller's command buffer and holds no pass
+    EXPECT_EQ(segments[0].queue, rg_queue::graphics);
+    EXPECT_TRUE(segments[0].passes.empty());
+
+    const int32_t cull = segment_of(graph, 0);
+    const int32_t shadow = segment_of(graph, 1);
+    const int32_t join = segment_of(graph, 2);
+    EXPECT_EQ(segments[cull].queue, rg_queue::async_compute);
+    EXPECT_EQ(segments[cull].wait_on, 0);
+
+    // Shadow runs while the compute queue works; main joins it
+    EXPECT_LT(shadow, join);
+    EXPECT_EQ(segments[shadow].wait_on, -1);
+    EXPECT_EQ(segments[join].queue, rg_queue::graphics);
+    EXPECT_EQ(segments[join].wait_on, cull);
+}
+
+TEST(RenderGraph, async_passes_stay_on_graphics_without_compute_family)
+{
+    vulkan_render_graph graph;
+    graph.set_async_compute(0, 0, [](rg_queue) { return VkCommandBuffer{}; });
+
+    graph.register_buffer(AID("a"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.import_resource(AID("b"), rg_resource_type::buffer);
+    graph.add_compute_pass(AID("p1"), {graph.write(AID("a"))}, [](VkCommandBuffer) {})
+        ->set_async_compute(true);
+    graph.add_compute_pass(
+        AID("p2"), {graph.read(AID("a")), graph.write(AID("b"))}, [](VkCommandBuffer) {});
+
+    ASSERT_TRUE(graph.compile());
+    ASSERT_EQ(graph.get_segments().size(), 1u);
+    EXPECT_EQ(graph.get_segments()[0].passes, graph.get_execution_order());
+    EXPECT_EQ(graph.get_pass_queue(0), rg_queue::graphics);
+}
+
+TEST(RenderGraph, async_last_user_of_image_moves_to_graphics)
+{
+    vulkan_render_graph graph;
+    graph.set_async_compute(0, 1, [](rg_queue) { return VkCommandBuffer{}; });
+
+    graph.register_buffer(AID("in"), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    graph.register_image(
+        AID("out"), 64, 64, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_STORAGE_BIT);
+    graph.set_final_layout(AID("out"), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    graph
+        .add_compute_pass(AID("bake"),
+                          {graph.read(AID("in")), graph.write(AID("out"))},
+                          [](VkCommandBuffer) {})
+        ->set_async_compute(true);
+
+    // Images are on graphics between frames, so nothing is left to run async
+    ASSERT_TRUE(graph.compile());
+    EXPECT_EQ(graph.get_pass_queue(0), rg_queue::graphics);
+    EXPECT_EQ(graph.get_segments().size(), 1u);
+}
+
 // ============================================================================
 // Binding table validation tests
 // ============================================================================
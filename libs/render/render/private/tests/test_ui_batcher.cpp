@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include "vulkan_render/font_atlas.h"
+#include "vulkan_render/ui_batcher.h"
+
+using namespace kryga;
+using namespace kryga::render;
+
+namespace
+{
+
+// Monospace 10px-advance source baked at 20px: every glyph is an 8x10 quad,
+// space is empty.
+class test_glyph_source final : public glyph_source
+{
+public:
+    bool
+    metrics(uint32_t codepoint, glyph_metrics& out) const override
+    {
+        out.advance = 10.f;
+        if (codepoint != ' ')
+        {
+            out.size = {8.f, 10.f};
+            out.bearing = {1.f, -12.f};
+        }
+        return true;
+    }
+
+    bool
+    rasterize(uint32_t codepoint, glyph_bitmap& out) const override
+    {
+        out.width = 8;
+        out.height = 10;
+        out.pixels.assign(80, 200);
+        return true;
+    }
+};
+
+std::unique_ptr<font_atlas>
+make_test_font()
+{
+    return std::make_unique<font_atlas>(
+        std::make_unique<test_glyph_source>(), 20.f, 16.f, 24.f, false);
+}
+
+// Integrate requested glyphs and stand in for the loader's page upload
+void
+make_resident(font_atlas& font, uint32_t bindless_index)
+{
+    font.pump();
+    for (auto& p : font.pages())
+    {
+        p.bindless_index = bindless_index;
+        p.dirty = false;
+    }
+}
+
+ui_text_entry
+make_text(const char* text, uint32_t anchor)
+{
+    ui_text_entry e;
+    e.text = text;
+    e.x = 5;
+    e.y = 7;
+    e.anchor = anchor;
+    e.font_size = 20.f;
+    return e;
+}
+
+}  // namespace
+
+TEST(ui_batcher, text_layout_is_anchor_relative)
+{
+    auto font = make_test_font();
+    std::vector<uint32_t> pins;
+
+    std::vector<gpu::ui_quad> tl;
+    // First touch only requests the glyphs
+    EXPECT_FALSE(layout_ui_text(make_text("a b", KGPU_UI_ANCHOR_TOP_LEFT), *font, tl, pins));
+    EXPECT_TRUE(tl.empty());
+    make_resident(*font, 3);
+
+    EXPECT_TRUE(layout_ui_text(make_text("a b", KGPU_UI_ANCHOR_TOP_LEFT), *font, tl, pins));
+
+    // Space advances the pen but emits nothing
+    ASSERT_EQ(tl.size(), 2u);
+    EXPECT_FLOAT_EQ(tl[0].rect_px.x, 6.f);        // x + bearing
+    EXPECT_FLOAT_EQ(tl[0].rect_px.y, 7.f + 4.f);  // y + ascent + bearing.y
+    EXPECT_FLOAT_EQ(tl[1].rect_px.x, 6.f + 20.f);
+    EXPECT_EQ(tl[0].tex_index, 3u);
+    EXPECT_EQ(tl[0].anchor, KGPU_UI_ANCHOR_TOP_LEFT);
+
+    // Bottom-right: the block's right edge sits x px left of the viewport edge,
+    // its line box y px above the bottom
+    std::vector<gpu::ui_quad> br;
+    layout_ui_text(make_text("ab", KGPU_UI_ANCHOR_BOTTOM_RIGHT), *font, br, pins);
+
+    ASSERT_EQ(br.size(), 2u);
+    EXPECT_FLOAT_EQ(br[0].rect_px.x, -5.f - 20.f + 1.f);
+    EXPECT_FLOAT_EQ(br[0].rect_px.y, -7.f - 24.f + 16.f - 12.f);
+    EXPECT_EQ(br[0].anchor, KGPU_UI_ANCHOR_BOTTOM_RIGHT);
+
+    // Half the bake size scales the quad, the SDF serves both
+    std::vector<gpu::ui_quad> small;
+    auto half = make_text("a", KGPU_UI_ANCHOR_TOP_LEFT);
+    half.font_size = 10.f;
+    layout_ui_text(half, *font, small, pins);
+    ASSERT_EQ(small.size(), 1u);
+    EXPECT_FLOAT_EQ(small[0].rect_px.z - small[0].rect_px.x, 4.f);
+}
+
+TEST(ui_batcher, packs_panels_under_text_and_skips_noop_upserts)
+{
+    auto font = make_test_font();
+    ui_batcher batcher;
+
+    batcher.set_panel(AID("bg"), glm::vec4(0, 0, 100, 50), glm::vec4(0.f, 0.f, 0.f, 0.5f));
+    batcher.set_text(0, make_text("hi", KGPU_UI_ANCHOR_TOP_LEFT), font.get());
+    EXPECT_TRUE(batcher.has_outstanding());
+
+    make_resident(*font, 1);
+    batcher.refresh([&](const utils::id&) { return font.get(); });
+    EXPECT_FALSE(batcher.has_outstanding());
+
+    const auto& quads = batcher.quads();
+    ASSERT_EQ(quads.size(), 3u);
+    EXPECT_EQ(quads[0].tex_index, KGPU_UI_NO_TEXTURE);
+    EXPECT_EQ(quads[1].tex_index, 1u);
+
+    // Re-sending identical widgets does not touch the batch
+    const uint64_t gen = batcher.generation();
+    batcher.set_panel(AID("bg"), glm::vec4(0, 0, 100, 50), glm::vec4(0.f, 0.f, 0.f, 0.5f));
+    batcher.set_text(0, make_text("hi", KGPU_UI_ANCHOR_TOP_LEFT), font.get());
+    batcher.remove_text(5);
+    batcher.refresh([&](const utils::id&) { return font.get(); });
+    EXPECT_EQ(batcher.generation(), gen);
+
+    batcher.set_text(0, make_text("hih", KGPU_UI_ANCHOR_TOP_LEFT), font.get());
+    EXPECT_GT(batcher.generation(), gen);
+    EXPECT_EQ(batcher.quads().size(), 4u);
+
+    batcher.remove_panel(AID("bg"));
+    batcher.remove_text(0);
+    EXPECT_TRUE(batcher.quads().empty());
+}
+
+TEST(ui_batcher, text_waits_for_its_font_and_glyphs)
+{
+    auto font = make_test_font();
+    ui_batcher batcher;
+
+    // Multi-byte UTF-8: two codepoints, two quads
+    auto e = make_text("\xC3\xA9\xE2\x82\xAC", KGPU_UI_ANCHOR_TOP_LEFT);
+    e.font = AID("late_font");
+    batcher.set_text(0, e, nullptr);
+
+    EXPECT_TRUE(batcher.has_outstanding());
+    EXPECT_TRUE(batcher.quads().empty());
+
+    batcher.refresh([](const utils::id&) -> font_atlas* { return nullptr; });
+    EXPECT_TRUE(batcher.has_outstanding());
+
+    // Font known, glyphs still rasterising
+    batcher.refresh([&](const utils::id& id) -> font_atlas*
+                    { return id == AID("late_font") ? font.get() : nullptr; });
+    EXPECT_TRUE(batcher.has_outstanding());
+    EXPECT_TRUE(batcher.quads().empty());
+
+    make_resident(*font, 2);
+    batcher.refresh([&](const utils::id&) { return font.get(); });
+    EXPECT_FALSE(batcher.has_outstanding());
+    EXPECT_EQ(batcher.quads().size(), 2u);
+
+    // Replacing the atlas parks the line again
+    batcher.forget_font(font.get());
+    EXPECT_TRUE(batcher.has_outstanding());
+    EXPECT_TRUE(batcher.quads().empty());
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "vulkan_render/types/vulkan_mesh_data.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace kryga;
+using namespace kryga::render;
+
+namespace
+{
+
+// CPU mirror of vertex_decode.glsl
+glm::vec3
+oct_decode(glm::vec2 e)
+{
+    glm::vec3 n(e, 1.0f - std::abs(e.x) - std::abs(e.y));
+    float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+
+glm::vec3
+decode_position(const glm::uvec2& p, const vertex_dequant& dq)
+{
+    glm::vec3 f(glm::unpackUnorm2x16(p.x), glm::unpackUnorm2x16(p.y).x);
+    return f * dq.scale + dq.offset;
+}
+
+}  // namespace
+
+TEST(vertex_compression, compact_layouts_halve_the_vertex)
+{
+    EXPECT_EQ(sizeof(gpu::compact_vertex_data), 24u);
+    EXPECT_EQ(sizeof(gpu::compact_skinned_vertex_data), 28u);
+    EXPECT_LE(sizeof(gpu::compact_vertex_data) * 2, sizeof(gpu::vertex_data));
+
+    for (size_t i = 0; i < k_compact_vertex_layout.size(); ++i)
+    {
+        EXPECT_EQ(k_compact_vertex_layout[i].location, i);
+        EXPECT_NE(to_vk_format(k_compact_vertex_layout[i].encoding), VK_FORMAT_UNDEFINED);
+    }
+}
+
+TEST(vertex_compression, static_vertices_round_trip)
+{
+    std::vector<gpu::vertex_data> src;
+    for (int i = 0; i < 64; ++i)
+    {
+        float a = float(i) * 0.37f;
+        gpu::vertex_data v{};
+        v.position = glm::vec3(std::sin(a) * 12.0f, float(i) * 0.25f - 3.0f, std::cos(a) * 5.0f);
+        v.normal = glm::normalize(glm::vec3(std::sin(a * 3.0f), std::cos(a * 2.0f), a - 10.0f));
+        v.color = glm::vec3(float(i) / 63.0f, 0.5f, 1.0f);
+        v.uv = glm::vec2(float(i) * 0.125f, -1.5f);
+        v.uv2 = glm::vec2(float(i) / 64.0f, 0.25f);
+        src.push_back(v);
+    }
+
+    std::vector<gpu::compact_vertex_data> dst;
+    auto dq = encode_compact_vertices(src, dst);
+    ASSERT_EQ(dst.size(), src.size());
+
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        const auto& s = src[i];
+        const auto& d = dst[i];
+
+        auto p = decode_position(d.position, dq);
+        EXPECT_LE(glm::length(p - s.position), glm::length(dq.scale) / 65535.0f);
+
+        auto n = oct_decode(glm::unpackSnorm2x16(d.normal));
+        EXPECT_GT(glm::dot(n, s.normal), 0.99999f);
+
+        auto c = glm::unpackUnorm4x8(d.color);
+        EXPECT_NEAR(c.r, s.color.r, 0.5f / 255.0f + 1e-6f);
+        EXPECT_NEAR(c.b, s.color.b, 1e-6f);
+
+        auto uv = glm::unpackHalf2x16(d.uv);
+        EXPECT_NEAR(uv.x, s.uv.x, std::abs(s.uv.x) * 1e-3f);
+        EXPECT_FLOAT_EQ(uv.y, s.uv.y);
+
+        auto uv2 = glm::unpackUnorm2x16(d.uv2);
+        EXPECT_NEAR(uv2.x, s.uv2.x, 0.5f / 65535.0f + 1e-7f);
+    }
+}
+
+TEST(vertex_compression, flat_meshes_keep_a_valid_dequant)
+{
+    std::vector<gpu::vertex_data> src(3);
+    src[0].position = {0.0f, 2.0f, 0.0f};
+    src[1].position = {1.0f, 2.0f, 0.0f};
+    src[2].position = {0.0f, 2.0f, 1.0f};
+
+    std::vector<gpu::compact_vertex_data> dst;
+    auto dq = encode_compact_vertices(src, dst);
+
+    EXPECT_EQ(dq.scale.y, 1.0f);
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        EXPECT_EQ(decode_position(dst[i].position, dq), src[i].position);
+    }
+}
+
+TEST(vertex_compression, skinned_weights_keep_their_sum)
+{
+    gpu::skinned_vertex_data v{};
+    v.normal = {0.0f, 0.0f, -1.0f};
+    v.bone_indices = {3u, 200u, 17u, 9u};
+    // Each rounds up to 64, one step over 255 in total
+    v.bone_weights = {0.25f, 0.25f, 0.25f, 0.25f};
+
+    std::vector<gpu::skinned_vertex_data> src(1, v);
+    std::vector<gpu::compact_skinned_vertex_data> dst;
+    encode_compact_vertices(src, dst);
+
+    const auto& d = dst[0];
+    EXPECT_EQ(d.bone_indices, 3u | 200u << 8 | 17u << 16 | 9u << 24);
+
+    uint32_t sum = 0;
+    for (int c = 0; c < 4; ++c)
+    {
+        sum += (d.bone_weights >> (c * 8)) & 0xFFu;
+    }
+    EXPECT_EQ(sum, 255u);
+
+    auto n = oct_decode(glm::unpackSnorm2x16(d.normal));
+    EXPECT_NEAR(n.z, -1.0f, 1e-6f);
+}
@@ -120,6 +120,7 @@ protected:
         auto ref_path = ref_dir + "/" + test_name + ".png";
         auto actual_path = out_dir + "/" + test_name + "_actual.png";
         auto diff_path = out_dir + "/" + test_name + "_diff.png";
+        auto heatmap_path = out_dir + "/" + test_name + "_heatmap.png";
 
         if (std::getenv("UPDATE_REFERENCES"))
         {
@@ -153,13 +154,19 @@ protected:
             {
                 save_png(diff_path, result.diff_image.data(), width, height);
             }
+            auto heatmap = render_heatmap(result, width, height);
+            if (!heatmap.empty())
+            {
+                save_png(heatmap_path, heatmap.data(), width, height);
+            }
         }
 
         EXPECT_TRUE(result.pixel_passed)
             << "Pixel diff: " << result.diff_pixel_count << "/" << result.total_pixels << " ("
             << result.diff_percentage << "%)"
             << "\n  Reference: " << ref_path << "\n  Actual:    " << actual_path
-            << "\n  Diff:      " << diff_path;
+            << "\n  Diff:      " << diff_path << "\n  Heatmap:   " << heatmap_path
+            << " (worst tile " << result.worst_tile_x << "," << result.worst_tile_y << ")";
 
         EXPECT_TRUE(result.ssim_passed)
             << "SSIM: " << result.ssim << " (threshold: " << params.ssim_threshold << ")";
@@ -3675,16 +3682,16 @@ TEST_F(visual_pipeline_test, toggle_grid_off)
 // Procedural 2-bone skinned cuboid. Bottom verts (y<0) ride bone 0 (identity);
 // top verts (y>0) ride bone 1, which rotates -45° around X so the upper half
 // bends forward. Verifies the skinned vertex format, bone-matrix SSBO upload,
-// and per-instance bone_offset/bone_count plumbing on object_data.
+// per-instance bone_offset/bone_count plumbing on object_data and the pre-skin
+// compute pass feeding the skinned vertex pool.
 TEST_F(visual_pipeline_test, mesh_skinned_basic)
 {
     auto& renderer = glob::glob_state().getr_render().renderer;
     auto& loader = glob::glob_state().getr_render().loader;
     auto& cache = renderer.get_cache();
 
-    // Skinned vert + standard solid-color lit frag (frag never reads
-    // in_lightmap_uv when ENABLE_LIGHTMAP=false, so the skinned vert leaving
-    // out_lightmap_uv unwritten is safe).
+    // Skinned vert (reads pre-skinned static vertices) + standard solid-color
+    // lit frag.
     kryga::utils::buffer vert_buf, frag_buf;
     auto path_rp = glob::glob_state().getr_vfs().real_path(
         vfs::rid("data://packages/root.apkg/class/shader_effects/lit"));
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "vulkan_render/bake/bvh_builder.h"
+
+#include <glm_unofficial/glm.h>
+
+#include <cstdint>
+
+namespace kryga
+{
+namespace render
+{
+namespace bake
+{
+
+constexpr uint32_t k_bvh_miss = 0xFFFFFFFFu;
+
+struct bvh_hit
+{
+    float t = 0.0f;
+    uint32_t tri_idx = k_bvh_miss;
+    float u = 0.0f;
+    float v = 0.0f;
+    // Interpolated vertex normal faces along the ray (ray hit the inside of a surface)
+    bool back_face = false;
+
+    bool
+    is_hit() const
+    {
+        return tri_idx != k_bvh_miss;
+    }
+};
+
+// CPU mirror of bake/bvh_traversal.glsl trace_ray(). Closest hit within t_max.
+bvh_hit
+trace_ray(const bvh_build_result& bvh,
+          const glm::vec3& origin,
+          const glm::vec3& direction,
+          float t_max);
+
+// True if any triangle bounding box overlaps [box_min, box_max].
+// Conservative: tests triangle AABBs, not the triangles themselves.
+bool
+overlaps_box(const bvh_build_result& bvh, const glm::vec3& box_min, const glm::vec3& box_max);
+
+}  // namespace bake
+}  // namespace render
+}  // namespace kryga
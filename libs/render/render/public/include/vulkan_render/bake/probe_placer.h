@@ -1,5 +1,7 @@
 #pragma once
 
+#include "vulkan_render/bake/bvh_builder.h"
+
 #include <gpu_types/gpu_probe_types.h>
 #include <gpu_types/gpu_vertex_types.h>
 
@@ -18,12 +20,38 @@ struct probe_placement_params
 {
     float spacing = 2.0f;  // distance between probes
     float margin = 0.5f;   // extra space around scene bounds
+
+    // Visibility validation (place_probes_validated / place_probes_adaptive)
+    uint32_t validation_rays = 32;        // rays cast per probe to classify it
+    float backface_threshold = 0.25f;     // back-face hit ratio above which a probe is inside
+    float surface_offset = 0.1f;          // min distance kept between a probe and a surface
+    float max_relocation = 0.45f;         // max displacement as a fraction of cell size
+    uint32_t relocation_iterations = 3;   // push-out attempts before a probe is rejected
+    float empty_distance = 0.0f;          // no geometry within this range = empty (0 = 2*spacing)
+
+    // Adaptive octree: cells touching geometry subdivide this many times
+    uint32_t adaptive_levels = 2;
+};
+
+enum probe_flags : uint8_t
+{
+    probe_flag_none = 0,
+    probe_flag_relocated = 1 << 0,  // moved out of geometry / away from a surface
+    probe_flag_invalid = 1 << 1,    // stuck inside geometry, contributes nothing
+    probe_flag_empty = 1 << 2,      // no geometry nearby (sky)
 };
 
 struct probe_placement_result
 {
     std::vector<glm::vec3> positions;
+    // Per-probe influence radius; 0 for invalid probes. Matches sh_probe::radius.
+    std::vector<float> radii;
+    std::vector<uint8_t> flags;
     gpu::probe_grid_config grid_config{};
+
+    uint32_t relocated_count = 0;
+    uint32_t invalid_count = 0;
+    uint32_t empty_count = 0;
 };
 
 // Place probes on a uniform grid covering the scene AABB.
@@ -35,6 +63,35 @@ place_probes_grid(const gpu::vertex_data* vertices,
                   uint32_t index_count,
                   const probe_placement_params& params = {});
 
+// Uniform grid, then every probe is classified against the bake BVH: probes
+// inside geometry are pushed out (within their cell) or flagged invalid with
+// radius 0 so the interpolated lookup skips them. The grid layout is kept so
+// evaluate_probe_lighting_interpolated still indexes it.
+probe_placement_result
+place_probes_validated(const gpu::vertex_data* vertices,
+                       uint32_t vertex_count,
+                       const uint32_t* indices,
+                       uint32_t index_count,
+                       const bvh_build_result& bvh,
+                       const probe_placement_params& params = {});
+
+// Sparse octree: coarse cells of `spacing` subdivide up to `adaptive_levels`
+// times where they touch geometry. Invalid and empty probes are dropped, so the
+// result is a flat list (grid_size_* = 0); objects pick theirs with
+// find_probe_index and shade through gpu::object_data::probe_index.
+probe_placement_result
+place_probes_adaptive(const gpu::vertex_data* vertices,
+                      uint32_t vertex_count,
+                      const uint32_t* indices,
+                      uint32_t index_count,
+                      const bvh_build_result& bvh,
+                      const probe_placement_params& params = {});
+
+// Nearest valid probe (radius > 0) to `position`, for gpu::object_data::probe_index.
+// Any placement works; 0xFFFFFFFF when there is none.
+uint32_t
+find_probe_index(const probe_placement_result& placement, const glm::vec3& position);
+
 }  // namespace bake
 }  // namespace render
 }  // namespace kryga
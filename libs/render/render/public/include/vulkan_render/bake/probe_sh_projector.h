@@ -0,0 +1,40 @@
+#pragma once
+
+#include "vulkan_render/bake/bvh_builder.h"
+#include "vulkan_render/bake/probe_placer.h"
+
+#include <gpu_types/gpu_probe_types.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace kryga
+{
+namespace render
+{
+namespace bake
+{
+
+struct probe_projection_params
+{
+    uint32_t sample_count = 256;  // rays per probe
+    uint32_t thread_count = 0;    // 0 = hardware_concurrency() - 1
+    float max_distance = 10000.0f;
+    glm::vec3 miss_radiance{0.0f};  // radiance for rays that escape the scene
+};
+
+// CPU alternative to bake/probe_baker.comp: traces sample_count rays per probe
+// through the bake BVH, samples the lightmap (RGBA16F, atlas_width * atlas_height
+// texels) at each hit and projects onto SH L2. Uses the shader's RNG so results
+// match the GPU pass. Probes with radius 0 (invalid) are skipped and stay zero.
+std::vector<gpu::sh_probe>
+project_probes_sh(const bvh_build_result& bvh,
+                  const uint16_t* lightmap_rgba16f,
+                  uint32_t atlas_width,
+                  uint32_t atlas_height,
+                  const probe_placement_result& placement,
+                  const probe_projection_params& params = {});
+
+}  // namespace bake
+}  // namespace render
+}  // namespace kryga
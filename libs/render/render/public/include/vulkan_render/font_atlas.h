@@ -2,44 +2,142 @@
 
 #include <glm/glm.hpp>
 
-#include <array>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace kryga::render
 {
 
-// Per-glyph atlas metrics, in pixels at the bake size. uv0/uv1 are the glyph's
-// rect in the atlas (0..1). Layout mirrors stb_truetype packedchar: `bearing` is
-// the offset from the pen's top-left (xoff,yoff), `advance` moves the pen in x.
+class texture_data;
+
+// Per-glyph metrics, in pixels at the SDF bake size. uv0/uv1 are the glyph's rect
+// in its atlas page (0..1) and are only meaningful while the glyph is resident.
+// Layout mirrors stb_truetype: `bearing` is the offset from the pen's top-left,
+// `advance` moves the pen in x. Size/bearing include the SDF padding.
 struct glyph_metrics
 {
+    static constexpr uint32_t k_no_page = 0xFFFFFFFFu;
+
     glm::vec2 uv0{0.f};
     glm::vec2 uv1{0.f};
     glm::vec2 size{0.f};     // glyph quad size in px (at bake height)
     glm::vec2 bearing{0.f};  // pen-top-left -> quad-top-left offset, px
     float advance = 0.f;     // pen advance, px
+    uint32_t page = k_no_page;
+
+    bool
+    resident() const
+    {
+        return page != k_no_page;
+    }
 };
 
-// Printable-ASCII font atlas baked from a TTF into one bindless texture.
-// Render-side, baked once at init; the draw path lays out glyph quads from the
-// metrics. Digits are baked at a uniform (tabular) advance so a changing counter
-// does not jitter. Populated by vulkan_render_loader::setup_ui_font().
+// Single-channel signed distance field for one glyph: 0.5 (128) on the outline,
+// ramping over the font's padding. Produced off the render thread.
+struct glyph_bitmap
+{
+    uint32_t codepoint = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+// Where glyphs come from (stb_truetype in the engine, a fake in tests). metrics()
+// runs on the render thread during layout; rasterize() runs on the atlas worker.
+// Both must be safe to call concurrently.
+class glyph_source
+{
+public:
+    virtual ~glyph_source() = default;
+
+    // Layout metrics at the bake size; false if the font has no such codepoint.
+    virtual bool
+    metrics(uint32_t codepoint, glyph_metrics& out) const = 0;
+
+    virtual bool
+    rasterize(uint32_t codepoint, glyph_bitmap& out) const = 0;
+};
+
+// Dynamic SDF glyph cache for one font. Glyphs are requested on first use by
+// layout, rasterised on a worker thread and packed into fixed-size cells of R8
+// atlas pages (created on demand, up to k_max_pages). Because the pages hold
+// distance fields, one bake serves every font_size.
+//
+// Text layouts pin the glyphs they reference (acquire/release). When the pages
+// are full, the least recently used unpinned glyph is evicted. revision() bumps
+// whenever glyphs become resident or are evicted, so retained layouts know to
+// re-run. Page pixels live here; the loader uploads dirty pages (see
+// vulkan_render_loader::update_fonts). Render-thread only, apart from the worker.
 class font_atlas
 {
 public:
-    static constexpr int k_first_char = 32;  // space
-    static constexpr int k_char_count = 95;  // 32..126 inclusive (printable ASCII)
+    static constexpr uint32_t k_page_size = 1024;
+    static constexpr uint32_t k_cell_size = 64;
+    static constexpr uint32_t k_cells_per_row = k_page_size / k_cell_size;
+    static constexpr uint32_t k_cells_per_page = k_cells_per_row * k_cells_per_row;
+    static constexpr uint32_t k_max_pages = 4;
     static constexpr uint32_t k_invalid = 0xFFFFFFFFu;
+    static constexpr uint32_t k_fallback_codepoint = '?';
+
+    struct page
+    {
+        std::vector<uint8_t> pixels;  // k_page_size^2, R8
+        uint32_t bindless_index = k_invalid;
+        texture_data* texture = nullptr;  // created/updated by the loader
+        bool dirty = false;
+    };
+
+    // async = false rasterises inside pump() (tests, tools).
+    font_atlas(std::unique_ptr<glyph_source> source,
+               float bake_height,
+               float ascent,
+               float line_height,
+               bool async = true);
+    ~font_atlas();
 
+    font_atlas(const font_atlas&) = delete;
+    font_atlas&
+    operator=(const font_atlas&) = delete;
+
+    // Pin a glyph for a layout and return its metrics (requests rasterisation on a
+    // miss; unknown codepoints map to k_fallback_codepoint). Pair with release().
+    const glyph_metrics&
+    acquire(uint32_t codepoint);
+    void
+    release(uint32_t codepoint);
+
+    // Metrics of an already-acquired glyph, without pinning it again.
     const glyph_metrics&
-    glyph(char c) const
+    peek(uint32_t codepoint) const;
+
+    // Integrate finished glyphs into pages, evicting as needed. Returns true if
+    // revision() moved. [render thread, once per frame]
+    bool
+    pump();
+
+    uint64_t
+    revision() const
+    {
+        return m_revision;
+    }
+
+    uint32_t
+    page_bindless_index(uint32_t page_idx) const
     {
-        int i = static_cast<int>(static_cast<unsigned char>(c)) - k_first_char;
-        if (i < 0 || i >= k_char_count)
-        {
-            i = 0;  // fall back to space for anything out of range
-        }
-        return m_glyphs[i];
+        return page_idx < m_pages.size() ? m_pages[page_idx].bindless_index : k_invalid;
+    }
+
+    std::vector<page>&
+    pages()
+    {
+        return m_pages;
     }
 
     float
@@ -57,24 +155,67 @@ public:
     {
         return m_line_height;
     }
-    uint32_t
-    bindless_index() const
-    {
-        return m_bindless_index;
-    }
     bool
     ready() const
     {
-        return m_bindless_index != k_invalid;
+        return m_source != nullptr;
     }
 
-    // Filled by vulkan_render_loader::setup_ui_font(); public so the baker writes them
-    // directly (this is a render-internal data holder, not an API surface).
-    std::array<glyph_metrics, k_char_count> m_glyphs{};
+    uint32_t
+    resident_count() const
+    {
+        return m_resident;
+    }
+
+private:
+    struct entry
+    {
+        glyph_metrics metrics;
+        uint32_t alias = k_invalid;  // missing codepoint -> fallback entry key
+        uint32_t cell = k_invalid;   // global cell index (page * k_cells_per_page + i)
+        uint32_t pins = 0;
+        uint64_t last_used = 0;
+        bool requested = false;  // until placed; parked glyphs stay requested
+        bool no_ink = false;     // rasterised to nothing, never requested again
+    };
+
+    entry*
+    find_or_create(uint32_t codepoint);
+    uint32_t
+    alloc_cell();
+    void
+    place(entry& e, uint32_t cell, const glyph_bitmap& bmp);
+    void
+    worker_loop();
+
+    std::unique_ptr<glyph_source> m_source;
     float m_bake_height = 0.f;
-    float m_ascent = 0.f;  // top-of-line -> baseline, px at bake height
+    float m_ascent = 0.f;
     float m_line_height = 0.f;
-    uint32_t m_bindless_index = k_invalid;
+
+    std::unordered_map<uint32_t, entry> m_entries;
+    std::vector<page> m_pages;
+    std::vector<uint32_t> m_cell_owner;  // codepoint per cell, k_invalid = free
+    std::vector<uint32_t> m_free_cells;
+    // Bitmaps that found every cell pinned, retried once a glyph is unpinned
+    std::vector<glyph_bitmap> m_parked;
+    bool m_unpinned = false;
+    uint32_t m_resident = 0;
+    uint64_t m_clock = 1;
+    uint64_t m_revision = 0;
+
+    // Worker handoff: render thread pushes requests, worker pushes bitmaps.
+    bool m_async = true;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<uint32_t> m_requests;
+    std::vector<glyph_bitmap> m_done;
+    bool m_stop = false;
+    std::thread m_worker;
 };
 
+// UTF-8 -> codepoint at `pos`, advancing it. Malformed sequences yield U+FFFD.
+uint32_t
+decode_utf8(const std::string_view& s, size_t& pos);
+
 }  // namespace kryga::render
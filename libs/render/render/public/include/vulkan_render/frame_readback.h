@@ -0,0 +1,195 @@
+#pragma once
+
+#include "vulkan_render/utils/vulkan_buffer.h"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace kryga::render
+{
+
+class render_device;
+class frame_readback;
+
+// Sub-rectangle of the presented image; zero width/height means "to the edge"
+struct readback_region
+{
+    uint32_t x = 0, y = 0, w = 0, h = 0;
+};
+
+// CPU view of one completed copy, straight out of the mapped staging buffer.
+// Move-only; destroying it hands the staging slot back to the ring, so holders
+// (the encoder) should drop it as soon as the pixels are consumed.
+class readback_frame
+{
+public:
+    readback_frame() = default;
+    ~readback_frame();
+
+    readback_frame(readback_frame&& other) noexcept;
+    readback_frame&
+    operator=(readback_frame&& other) noexcept;
+
+    readback_frame(const readback_frame&) = delete;
+    readback_frame&
+    operator=(const readback_frame&) = delete;
+
+    const uint8_t*
+    data() const
+    {
+        return m_data;
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t row_pitch = 0;  // bytes
+    uint32_t region_x = 0;
+    uint32_t region_y = 0;
+    bool bgra = false;      // swapchain-order channels
+    uint64_t sequence = 0;  // per request, counts delivered frames from 0
+
+private:
+    friend class frame_readback;
+
+    void
+    release();
+
+    frame_readback* m_owner = nullptr;
+    uint32_t m_slot = 0;
+    const uint8_t* m_data = nullptr;
+};
+
+// Called on the render thread when a copy lands. Must be cheap: hand the frame to
+// a worker. Returning false cancels the rest of the request (e.g. the streaming
+// client went away).
+using readback_callback = std::function<bool(readback_frame&&)>;
+
+// Ring of host-visible staging buffers for presented-frame readback. Requests
+// from any thread are served by a copy recorded into the normal frame command
+// buffer right after the graph; completion is polled through the frame's fence
+// at the start of later frames, so neither the render thread nor the GPU ever
+// waits on a readback. When every slot is busy (copies in flight or frames
+// still held by consumers) the frame is skipped and counted in dropped().
+class frame_readback
+{
+public:
+    static constexpr uint32_t k_max_slots = 8;
+
+    frame_readback() = default;
+    ~frame_readback();
+
+    frame_readback(const frame_readback&) = delete;
+    frame_readback&
+    operator=(const frame_readback&) = delete;
+
+    // Render thread
+    void
+    init(render_device& device, uint32_t slots);
+
+    // Render thread, device idle, no readback_frame alive
+    void
+    deinit();
+
+    // Any thread. Reads back the next `count` drawn frames (0 = until cancelled),
+    // one callback each. Returns an id for cancel().
+    uint64_t
+    request(const readback_region& region, uint32_t count, readback_callback cb);
+
+    // Any thread. Copies already in flight are discarded.
+    void
+    cancel(uint64_t id);
+
+    bool
+    has_requests() const
+    {
+        return m_active.load(std::memory_order_relaxed) != 0;
+    }
+
+    // Render thread, outside a render pass, after the frame's last write to
+    // `src`. `src_layout` is the image's layout on entry and on exit.
+    void
+    record(VkCommandBuffer cmd,
+           VkImage src,
+           VkImageLayout src_layout,
+           VkFormat format,
+           uint32_t width,
+           uint32_t height,
+           VkFence frame_fence);
+
+    // Render thread. Delivers every copy whose fence has signalled; never waits.
+    void
+    poll();
+
+    uint64_t
+    dropped() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class readback_frame;
+
+    enum class slot_state : uint8_t
+    {
+        free,
+        in_flight,
+        held,  // delivered, consumer still reading
+    };
+
+    struct request_state
+    {
+        uint64_t id = 0;
+        readback_region region;
+        uint32_t to_record = 0;  // frames still to copy, ignored when unbounded
+        bool unbounded = false;
+        uint32_t in_flight = 0;
+        uint64_t delivered = 0;
+        readback_callback cb;
+        bool cancelled = false;
+    };
+
+    struct slot
+    {
+        vk_utils::vulkan_buffer buffer;
+        uint8_t* mapped = nullptr;
+        std::atomic<slot_state> state{slot_state::free};
+
+        // Valid while in_flight
+        VkFence fence = VK_NULL_HANDLE;
+        uint64_t request = 0;
+        uint32_t x = 0, y = 0, w = 0, h = 0;
+        bool bgra = false;
+    };
+
+    slot*
+    acquire_slot(VkDeviceSize size);
+
+    request_state*
+    find(uint64_t id);
+
+    // Drops requests that will produce nothing more. Caller holds m_mutex.
+    void
+    prune();
+
+    void
+    release_slot(uint32_t index);
+
+    render_device* m_device = nullptr;
+    std::array<slot, k_max_slots> m_slots;
+    uint32_t m_slot_count = 0;
+
+    std::mutex m_mutex;  // guards m_requests
+    std::vector<request_state> m_requests;
+    uint64_t m_next_id = 1;
+    std::atomic<uint32_t> m_active{0};
+
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+}  // namespace kryga::render
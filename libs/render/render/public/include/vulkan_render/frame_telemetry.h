@@ -0,0 +1,254 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace kryga::render
+{
+
+// Log-linear histogram of microsecond values, HdrHistogram layout: exact below
+// k_sub_buckets, then k_sub_buckets / 2 buckets per power of two (<0.8% relative
+// error) up to 2^36 us. Percentiles report the bucket's highest value.
+//
+// One writer thread; readers on any thread. Counters are relaxed atomics, so a
+// concurrent read may be a sample behind but never sees a torn count.
+class frame_histogram
+{
+public:
+    static constexpr uint32_t k_sub_bits = 8;
+    static constexpr uint32_t k_sub_buckets = 1u << k_sub_bits;
+    static constexpr uint32_t k_half = k_sub_buckets / 2;
+    static constexpr uint32_t k_max_shift = 28;
+    static constexpr uint32_t k_bucket_count = k_sub_buckets + k_max_shift * k_half;
+    static constexpr uint64_t k_max_value = (1ull << (k_max_shift + k_sub_bits)) - 1;
+
+    static uint32_t
+    bucket_of(uint64_t us);
+
+    // Highest value that maps to `index`
+    static uint64_t
+    bucket_upper(uint32_t index);
+
+    void
+    record(uint64_t us);
+
+    // Writer thread only
+    void
+    reset();
+
+    uint64_t
+    count() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t
+    max() const
+    {
+        return m_max.load(std::memory_order_relaxed);
+    }
+
+    double
+    mean() const;
+
+    // Smallest bucket value at or below which at least `q` (0..1] of samples lie
+    uint64_t
+    percentile(double q) const;
+
+private:
+    std::array<std::atomic<uint32_t>, k_bucket_count> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+};
+
+// Per-frame timestamps, in pipeline order. Not every frame reaches every stage: a
+// minimized window skips acquire/present, headless has no acquire.
+enum class frame_stamp : uint8_t
+{
+    begin_frame,   // main: entered begin_frame, before the pipeline gate
+    submit_frame,  // main: frame published to the render thread
+    drain_begin,   // render: picked the frame up, command drain starts
+    drain_end,     // render: commands applied, draw starts
+    acquire,       // render: swapchain image acquired
+    gpu_submit,    // render: vkQueueSubmit returned
+    present,       // render: vkQueuePresentKHR returned (headless: GPU done)
+    count
+};
+
+// Blocking waits a frame took, for stall attribution
+enum class frame_gate : uint8_t
+{
+    pipeline,        // main waited for the render thread to free a frame slot
+    render_idle,     // render thread waited for the main thread to submit
+    present_pacing,  // present-wait pacing
+    frame_fence,     // GPU still busy with the slot's previous frame
+    acquire,         // vkAcquireNextImageKHR
+    image_fence,     // acquired image still in flight on another slot
+    count
+};
+
+enum class frame_metric : uint8_t
+{
+    interval,  // end of previous frame to end of this one
+    latency,   // begin_frame to end of frame
+    build,     // main-thread build time, gate wait excluded
+    render,    // render-thread time, drain to end of frame
+    count
+};
+
+constexpr uint32_t k_frame_stamp_count = static_cast<uint32_t>(frame_stamp::count);
+constexpr uint32_t k_frame_gate_count = static_cast<uint32_t>(frame_gate::count);
+constexpr uint32_t k_frame_metric_count = static_cast<uint32_t>(frame_metric::count);
+
+const char*
+to_string(frame_stamp s);
+const char*
+to_string(frame_gate g);
+const char*
+to_string(frame_metric m);
+
+struct frame_record
+{
+    uint64_t frame = 0;
+    std::array<uint64_t, k_frame_stamp_count> stamp_us{};  // since telemetry start, 0 = not reached
+    std::array<uint32_t, k_frame_gate_count> wait_us{};
+    uint32_t interval_us = 0;
+
+    // Last stage the frame reached
+    uint64_t
+    end_us() const;
+};
+
+struct frame_gate_stats
+{
+    uint64_t total_us = 0;
+    uint32_t max_us = 0;
+    uint64_t dominant_frames = 0;  // frames where this was the longest wait over k_stall_us
+};
+
+// Frame pacing telemetry shared by the main and render threads. Frame ids are
+// implicit: open_frame() numbers frames on the main thread, begin_render_frame()
+// on the render thread, and the pipeline hands frames over in order so both
+// sequences agree. Records live in a lock-free ring of k_ring slots guarded by a
+// per-slot sequence (seqlock); readers on any thread copy them out and drop any
+// slot that was reopened underneath them. commit() folds a finished frame into the
+// histograms and stall counters.
+class frame_telemetry
+{
+public:
+    static constexpr uint32_t k_ring = 1024;       // ~17 s at 60 Hz
+    static constexpr uint32_t k_stall_us = 1000;   // waits below this don't count as stalls
+
+    frame_telemetry();
+
+    frame_telemetry(const frame_telemetry&) = delete;
+    frame_telemetry&
+    operator=(const frame_telemetry&) = delete;
+
+    static uint64_t
+    now_us();
+
+    // Main thread: start the next frame, stamping begin_frame
+    uint64_t
+    open_frame();
+
+    // Render thread: take the next frame in submission order
+    uint64_t
+    begin_render_frame();
+
+    // Render thread: frame taken by the last begin_render_frame()
+    uint64_t
+    render_frame() const
+    {
+        return m_render_frame;
+    }
+
+    // Frame's owning thread
+    void
+    stamp(uint64_t frame, frame_stamp s);
+    void
+    stamp(uint64_t frame, frame_stamp s, uint64_t at_us);
+    void
+    add_wait(uint64_t frame, frame_gate g, uint64_t us);
+
+    // Render thread: publish the frame and fold it into the statistics
+    void
+    commit(uint64_t frame);
+
+    // Any thread. Applied by the render thread at the next commit.
+    void
+    request_reset()
+    {
+        m_reset_requested.store(true, std::memory_order_relaxed);
+    }
+
+    // --- Readers, any thread ---
+
+    // Frames committed so far; also the cursor for the next unread frame
+    uint64_t
+    committed() const
+    {
+        return m_committed.load(std::memory_order_acquire);
+    }
+
+    // Up to `max` committed frames with id >= since, oldest first. Frames that
+    // already left the ring are skipped.
+    std::vector<frame_record>
+    read(uint64_t since, uint32_t max = k_ring) const;
+
+    const frame_histogram&
+    histogram(frame_metric m) const
+    {
+        return m_histograms[static_cast<uint32_t>(m)];
+    }
+
+    frame_gate_stats
+    gate(frame_gate g) const;
+
+    static std::string
+    to_csv(const std::vector<frame_record>& records);
+
+private:
+    struct slot
+    {
+        std::atomic<uint64_t> seq{0};  // frame + 1 once committed, 0 while written
+        std::array<std::atomic<uint64_t>, k_frame_stamp_count> stamp_us{};
+        std::array<std::atomic<uint32_t>, k_frame_gate_count> wait_us{};
+        std::atomic<uint32_t> interval_us{0};
+    };
+
+    struct gate_counters
+    {
+        std::atomic<uint64_t> total_us{0};
+        std::atomic<uint32_t> max_us{0};
+        std::atomic<uint64_t> dominant_frames{0};
+    };
+
+    slot&
+    slot_of(uint64_t frame)
+    {
+        return m_slots[frame % k_ring];
+    }
+
+    void
+    reset_statistics();
+
+    uint64_t m_epoch_us = 0;
+    std::vector<slot> m_slots;
+
+    uint64_t m_opened = 0;        // main thread
+    uint64_t m_render_next = 0;   // render thread
+    uint64_t m_render_frame = 0;  // render thread
+    uint64_t m_last_end_us = 0;   // render thread
+    std::atomic<uint64_t> m_committed{0};
+    std::atomic<bool> m_reset_requested{false};
+
+    std::array<frame_histogram, k_frame_metric_count> m_histograms;
+    std::array<gate_counters, k_frame_gate_count> m_gates;
+};
+
+}  // namespace kryga::render
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <utils/id.h>
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#ifdef TRACY_ENABLE
+namespace tracy
+{
+class VkCtx;
+class VkCtxScope;
+}  // namespace tracy
+#endif
+
+namespace kryga::render
+{
+
+class render_device;
+
+// Rolling window over the last k_size samples (ms) of one GPU pass. Summaries
+// are computed on demand (RPC / overlay), not per frame.
+class gpu_timing_window
+{
+public:
+    static constexpr uint32_t k_size = 240;  // ~4 s at 60 Hz
+
+    struct summary
+    {
+        float last_ms = 0.f;
+        float min_ms = 0.f;
+        float avg_ms = 0.f;
+        float p99_ms = 0.f;
+        uint32_t samples = 0;
+    };
+
+    void
+    add(float ms);
+
+    summary
+    summarize() const;
+
+    void
+    clear();
+
+private:
+    std::array<float, k_size> m_samples{};
+    uint32_t m_head = 0;
+    uint32_t m_count = 0;
+};
+
+// Pipeline statistics of one pass, last resolved frame. Zero unless
+// render_config::debug::pipeline_statistics is on and the device supports it,
+// and for passes recorded into secondaries.
+struct gpu_pass_counters
+{
+    uint64_t ia_primitives = 0;
+    uint64_t vs_invocations = 0;
+    uint64_t clipping_primitives = 0;
+    uint64_t fs_invocations = 0;
+    uint64_t cs_invocations = 0;
+};
+
+struct gpu_pass_report
+{
+    utils::id name;
+    gpu_timing_window::summary timing;
+    gpu_pass_counters counters;
+};
+
+// Per-pass GPU timing for vulkan_render_graph::execute. Each pass is bracketed by
+// two timestamps (and optionally one pipeline-statistics query) in a query pool
+// owned by the frame slot. A slot's results are read back when the slot comes
+// around again, after its fence wait, so resolving never stalls the CPU; queries
+// that are somehow still unavailable are skipped, not waited on. With Tracy
+// enabled each pass also opens a Tracy GPU zone.
+//
+// Render-thread only.
+class gpu_pass_profiler
+{
+public:
+    static constexpr uint32_t k_max_passes = 64;
+    static constexpr uint32_t k_max_slots = 4;  // FRAMES_IN_FLIGHT_MAX
+
+    gpu_pass_profiler();
+    ~gpu_pass_profiler();
+
+    gpu_pass_profiler(const gpu_pass_profiler&) = delete;
+    gpu_pass_profiler&
+    operator=(const gpu_pass_profiler&) = delete;
+
+    bool
+    init(render_device& device);
+    void
+    deinit();
+
+    // What to record from the next frame on. Pipeline statistics are ignored if
+    // the device did not enable them.
+    void
+    set_enabled(bool timing, bool pipeline_statistics);
+
+    // Resolve `slot`'s previous frame and reset its queries. Call after the
+    // slot's fence wait, outside a render pass, before the graph executes.
+    void
+    begin_frame(VkCommandBuffer cmd, uint32_t slot);
+    void
+    end_frame(VkCommandBuffer cmd);
+
+    // `statistics` false times the pass only. Passes replaying secondaries need
+    // it: a pipeline-statistics query may not be active across
+    // vkCmdExecuteCommands unless the secondaries inherit it.
+    void
+    begin_pass(VkCommandBuffer cmd, const utils::id& name, bool statistics = true);
+    void
+    end_pass(VkCommandBuffer cmd);
+
+    // Passes of the most recently resolved frame, in execution order.
+    std::vector<gpu_pass_report>
+    report() const;
+
+    // First pass start to last pass end.
+    gpu_timing_window::summary
+    frame_summary() const
+    {
+        return m_frame_window.summarize();
+    }
+
+    bool
+    supported() const
+    {
+        return m_timestamp_mask != 0;
+    }
+
+    bool
+    pipeline_statistics_active() const
+    {
+        return m_stats_supported && m_stats_enabled;
+    }
+
+    uint64_t
+    resolved_frames() const
+    {
+        return m_resolved_frames;
+    }
+
+private:
+    struct slot_state
+    {
+        VkQueryPool timestamps = VK_NULL_HANDLE;
+        VkQueryPool statistics = VK_NULL_HANDLE;
+        std::vector<utils::id> passes;  // recorded into the slot's last frame
+        bool with_statistics = false;
+        bool pending = false;  // recorded, not resolved yet
+    };
+
+    struct pass_history
+    {
+        gpu_timing_window window;
+        gpu_pass_counters counters;
+    };
+
+    void
+    resolve(slot_state& slot);
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    float m_ns_per_tick = 1.f;
+    uint64_t m_timestamp_mask = 0;
+    bool m_stats_supported = false;
+
+    bool m_timing_enabled = true;
+    bool m_stats_enabled = false;
+
+    std::array<slot_state, k_max_slots> m_slots{};
+    slot_state* m_recording = nullptr;  // slot of the frame being recorded
+    bool m_in_pass = false;
+    bool m_pass_statistics = false;  // the open pass began a statistics query
+
+    std::unordered_map<utils::id, pass_history> m_history;
+    std::vector<utils::id> m_last_order;
+    gpu_timing_window m_frame_window;
+    uint64_t m_resolved_frames = 0;
+
+#ifdef TRACY_ENABLE
+    VkCommandPool m_tracy_pool = VK_NULL_HANDLE;
+    tracy::VkCtx* m_tracy_ctx = nullptr;
+    std::unique_ptr<tracy::VkCtxScope> m_tracy_zone;
+#endif
+};
+
+}  // namespace kryga::render
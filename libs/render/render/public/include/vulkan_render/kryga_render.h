@@ -11,19 +11,25 @@
 #include "vulkan_render/utils/segments.h"
 #include "vulkan_render/types/vulkan_render_pass.h"
 #include "vulkan_render/vulkan_render_graph.h"
+#include "vulkan_render/gpu_pass_profiler.h"
+#include "vulkan_render/frame_telemetry.h"
+#include "vulkan_render/frame_readback.h"
 #include "vulkan_render/vulkan_render_device.h"
 #include "vulkan_render/render_enums.h"
 #include "vulkan_render/render_config.h"
+#include "vulkan_render/ui_batcher.h"
 #include "render/utils/frustum.h"
 #include "render/utils/cluster_grid.h"
 #include "spatial/object_bvh.h"
 #include "gpu_types/gpu_cluster_types.h"
 #include "gpu_types/gpu_shadow_types.h"
 #include "gpu_types/gpu_probe_types.h"
+#include "gpu_types/gpu_skinning_types.h"
 
 #include <utils/buffer.h>
 #include <utils/check.h>
 #include <utils/dynamic_object.h>
+#include <utils/frame_pipeline.h>
 #include <utils/id.h>
 #include <utils/line_container.h>
 #include <utils/id_allocator.h>
@@ -64,6 +70,7 @@ struct pipeline_ctx
     uint32_t cur_material_type_idx = INVALID_GPU_INDEX;
     uint32_t cur_material_idx = INVALID_GPU_INDEX;
     VkPipelineLayout pipeline_layout = VK_NULL_HANDLE;
+    bool compact = false;  // bound pipeline reads compact vertices
 };
 
 struct frame_buffers
@@ -88,6 +95,11 @@ struct frame_buffers
     // Bone matrices SSBO for skeletal animation
     vk_utils::vulkan_buffer bone_matrices;
 
+    // Pre-skinning: one job per skinned instance, and the pool the compute pass
+    // skins them into (vertex_data layout, bound as a vertex buffer)
+    vk_utils::vulkan_buffer skinning_jobs;
+    vk_utils::vulkan_buffer skinned_vertices;
+
     // GPU frustum culling buffers
     vk_utils::vulkan_buffer frustum_data;     // Frustum planes (uniform)
     vk_utils::vulkan_buffer visible_indices;  // Output visible object indices
@@ -195,11 +207,22 @@ struct ui_draw_snapshot
     std::vector<ui_draw_cmd> cmds{};
 };
 
+// Per-slot copy of the retained UI batch (ui_batcher). Re-uploaded only when the
+// batcher's generation moved past what this slot last saw, so an unchanged HUD
+// costs no CPU work and no transfer.
+struct ui_batch_frame_state
+{
+    vk_utils::vulkan_buffer quads;
+    uint64_t generation = 0;
+    uint32_t quad_count = 0;
+};
+
 struct frame_state
 {
     frame_buffers buffers;
     frame_upload_state uploads;
     ui_frame_state ui;
+    ui_batch_frame_state ui_batch;
 
     frame_data* frame = nullptr;
 };
@@ -212,8 +235,34 @@ struct draw_batch
     uint32_t first_instance_offset;  // offset into instance_slots buffer
     bool outlined;
     bool cast_shadows;
+    // Skinned meshes draw one instance from the frame's skinned vertex pool
+    int32_t vertex_offset = 0;
+    // Chunked meshes draw one chunk's level range; index_count 0 = every index
+    uint32_t first_index = 0;
+    uint32_t index_count = 0;
+};
+
+// Where one object's geometry sits in its mesh's buffers: skinned instances in their
+// range of the skinned vertex pool, chunked-mesh objects in their chunk at its level,
+// meshes with a discrete chain at their level's index list
+struct object_draw_range
+{
+    int32_t vertex_offset = 0;
+    uint32_t first_index = 0;
+    uint32_t index_count = 0;
+
+    bool
+    operator==(const object_draw_range&) const = default;
 };
 
+object_draw_range
+draw_range_of(const vulkan_render_data& obj);
+
+// Same for depth-only passes: discrete chains are drawn `lod_bias` levels coarser,
+// and at level 0 static meshes draw their shadow index list when they have one
+object_draw_range
+shadow_draw_range_of(const vulkan_render_data& obj, uint32_t lod_bias = 0);
+
 class vulkan_render
 {
 public:
@@ -264,25 +313,25 @@ public:
         return m_camera_pending[m_build_frame_slot];
     }
 
-    // Main thread: select the per-frame double-buffer frame slot (frame parity)
-    // that subsequent set_camera() / capture_ui_snapshot() calls write into. Set
-    // once per frame (via the pipeline's begin_frame). Pairs with
-    // set_draw_frame_slot, the render thread's read-side selector. With the
-    // depth-1 pipeline gate the two never name the same frame slot at once.
+    // Main thread: select the frame slot (utils::frame_slot_of) that subsequent
+    // set_camera() / capture_ui_snapshot() calls write into. Set once per frame
+    // (via the pipeline's begin_frame). Pairs with set_draw_frame_slot, the render
+    // thread's read-side selector. The pipeline gate keeps fewer frames in flight
+    // than there are slots, so the two never name the same frame slot at once.
     void
     set_build_frame_slot(uint32_t frame_slot)
     {
-        m_build_frame_slot = frame_slot & 1u;
+        m_build_frame_slot = frame_slot % utils::k_frame_slot_count;
     }
 
     // Render thread: select the frame slot draw_main()/apply_pending_camera()/
     // update_ui()/draw_ui() read this frame. The render loop stamps it (= the
-    // frame's parity) before draw_main. Left at 0 for synchronous
+    // frame's slot) before draw_main. Left at 0 for synchronous
     // (test/headless) draws that don't go through the streaming loop.
     void
     set_draw_frame_slot(uint32_t frame_slot)
     {
-        m_draw_frame_slot = frame_slot & 1u;
+        m_draw_frame_slot = frame_slot % utils::k_frame_slot_count;
     }
 
     // Snapshot the current ImGui frame's draw data into the main thread's
@@ -448,12 +497,12 @@ public:
         return m_height;
     }
 
-    // UI panel cache — parallel render path used by packages/ui. Widgets push a
-    // {rect_ndc, color_opacity} entry and a single draw call is issued per panel
-    // at the tail of the main pass. No mesh, material, object_data or instancing.
+    // UI panels — retained path used by packages/ui. Widgets push a pixel rect
+    // (top-left origin) + color; the entry becomes one instance of the batched UI
+    // draw at the tail of the main pass. No mesh, material or object_data.
     struct ui_panel_entry
     {
-        glm::vec4 rect_ndc{-1.f, -1.f, 1.f, 1.f};
+        glm::vec4 rect_px{0.f};  // x0, y0, x1, y1
         glm::vec4 color_opacity{1.f};
     };
     void
@@ -461,6 +510,16 @@ public:
     void
     ui_panel_destroy(const utils::id& id);
 
+    // The loader's ui_text slot for `h` was populated or reset: re-lay out that
+    // line into the batch (or drop it). Untouched lines are not revisited.
+    void
+    ui_text_changed(render::types::ui_text_handle h);
+
+    // A font atlas is being replaced/destroyed: lines using it re-resolve their
+    // font by id on the next frame.
+    void
+    ui_font_removed(const font_atlas* font);
+
     // Active config — what the renderer is currently using. UI/tools should
     // mutate via get_pending_render_config() instead, so the change picks up
     // the apply_pending_render_config() gate that handles topology rebuilds
@@ -556,6 +615,28 @@ public:
         return m_all_draws;
     }
 
+    // Per-pass GPU timings, resolved a frame-in-flight cycle late. Render thread.
+    const gpu_pass_profiler&
+    get_gpu_profiler() const
+    {
+        return m_gpu_profiler;
+    }
+
+    // Frame pacing stamps and histograms. The main thread and render loop write
+    // their own stages; readers may sample from any thread.
+    frame_telemetry&
+    get_frame_telemetry()
+    {
+        return m_frame_telemetry;
+    }
+
+    // Asynchronous readback of presented frames. Requests from any thread.
+    frame_readback&
+    get_frame_readback()
+    {
+        return m_frame_readback;
+    }
+
     VkDescriptorSetLayout
     get_bindless_layout() const
     {
@@ -643,6 +724,11 @@ private:
                  uint32_t width,
                  uint32_t height);
 
+    // Ends and submits the graph's command buffers. `wait` gates the first graphics
+    // batch, `signal` fires with the last; either may be null.
+    void
+    submit_frame(frame_state& current_frame, VkSemaphore wait, VkSemaphore signal);
+
     void
     draw_objects_instanced(render::frame_state& frame);
 
@@ -718,6 +804,7 @@ private:
     void upload_directional_light_data(render::frame_state& frame);
     void upload_material_data(render::frame_state& frame);
     void upload_bone_matrices(render::frame_state& frame);
+    void upload_skinning_jobs(render::frame_state& frame);
     void upload_probe_data(render::frame_state& frame);
     // clang-format on
 
@@ -751,9 +838,18 @@ private:
     void
     dispatch_frustum_cull_impl(VkCommandBuffer cmd);
 
+    // GPU compute pre-skinning
+    void
+    init_pre_skin_compute();
+
+    void
+    dispatch_pre_skin_impl(VkCommandBuffer cmd);
+
     void
     upload_frustum_data(render::frame_state& frame);
 
+    // Skinned meshes bind the current frame's skinned vertex pool instead of
+    // their own vertex buffer; pass the instance's draw range to draw_mesh
     void
     bind_mesh(VkCommandBuffer cmd, mesh_data* cur_mesh);
 
@@ -761,7 +857,15 @@ private:
     draw_mesh(VkCommandBuffer cmd,
               mesh_data* m,
               uint32_t instance_count = 1,
-              uint32_t first_instance = 0);
+              uint32_t first_instance = 0,
+              int32_t vertex_offset = 0,
+              uint32_t first_index = 0,
+              uint32_t index_count = 0);
+
+    // Per-frame level of every chunked-mesh object, from its distance to the camera,
+    // and of every object with a discrete chain, from its projected error
+    void
+    select_lods();
 
     void
     bind_bindless(VkCommandBuffer cmd, VkPipelineLayout layout);
@@ -772,12 +876,14 @@ private:
     void
     bind_global_descriptors(VkCommandBuffer cmd, render::frame_state& current_frame);
 
-    void
+    // False when the effect has no pipeline for the mesh storage; skip the draw
+    bool
     bind_material(VkCommandBuffer cmd,
                   material_data* cur_material,
                   render::frame_state& current_frame,
                   pipeline_ctx& ctx,
-                  bool outline = false);
+                  bool outline = false,
+                  bool compact = false);
 
     void
     push_config(VkCommandBuffer cmd, VkPipelineLayout pipeline_layout, uint32_t mat_id);
@@ -870,6 +976,11 @@ private:
     compute_shadow_matrices();
     void
     draw_shadow_atlas(VkCommandBuffer cmd);
+    // Atlas tiles, in draw order; a range of them records independently
+    uint32_t
+    shadow_atlas_item_count() const;
+    void
+    draw_shadow_atlas_range(VkCommandBuffer cmd, uint32_t begin, uint32_t end);
     void
     draw_shadow_pass(VkCommandBuffer cmd, uint32_t cascade_idx);
     void
@@ -902,12 +1013,12 @@ private:
 
     // Camera written by set_camera() (main thread, into m_camera_pending[
     // m_build_frame_slot]) and latched into m_camera_data by apply_pending_camera()
-    // (render thread, from m_camera_pending[m_draw_frame_slot]). Double-buffered
-    // by frame parity so the main thread building frame F+1 writes a different
-    // slot than the render thread reads for frame F.
-    gpu::camera_data m_camera_pending[2]{};
+    // (render thread, from m_camera_pending[m_draw_frame_slot]). One per frame
+    // slot so the main thread building frame F+d writes a different slot than the
+    // render thread reads for frame F.
+    gpu::camera_data m_camera_pending[utils::k_frame_slot_count]{};
 
-    // Frame-parity slot selectors for the camera/UI double buffers. m_build_frame_slot
+    // Frame-slot selectors for the camera/UI rings. m_build_frame_slot
     // is written only by the main thread (begin_frame_inputs); m_draw_frame_slot
     // only by the render thread (set_draw_frame_slot, stamped by the render loop).
     // The pipeline gate guarantees they never name the same slot concurrently, so
@@ -931,11 +1042,11 @@ private:
 
     std::vector<frame_state> m_frames;
 
-    // Double-buffered ImGui draw-data snapshots, indexed by frame parity. Main
-    // thread fills m_ui_snapshots[m_build_frame_slot] in capture_ui_snapshot();
-    // the render thread reads m_ui_snapshots[m_draw_frame_slot]. Two buffers
-    // are enough because the main thread runs at most one frame ahead.
-    ui_draw_snapshot m_ui_snapshots[2];
+    // ImGui draw-data snapshots, one per frame slot. Main thread fills
+    // m_ui_snapshots[m_build_frame_slot] in capture_ui_snapshot(); the render
+    // thread reads m_ui_snapshots[m_draw_frame_slot]. The main thread runs at most
+    // k_max_pipeline_depth frames ahead, one fewer than the slots.
+    ui_draw_snapshot m_ui_snapshots[utils::k_frame_slot_count];
 
     // Number of frame slots whose GPU buffers are currently allocated. m_frames
     // is sized to the (max) device frame count; only [0, m_allocated_frame_slots)
@@ -968,26 +1079,20 @@ private:
     shader_effect_data* m_grid_se = nullptr;
     material_data* m_grid_mat = nullptr;
 
-    // UI panels (packages/ui retained-mode widgets).
-    // Owned pipeline + unordered cache of entries. Drawn as the last step of the
-    // main pass via draw_ui_panels(). One draw call per panel, no mesh/material.
-    shader_effect_data* m_ui_panel_se = nullptr;
-    std::unordered_map<utils::id, ui_panel_entry> m_ui_panels;
-    void
-    init_ui_panel_pipeline();
+    // Retained UI (packages/ui panels + text). Upserts re-lay out only the widget
+    // that changed into m_ui_batcher; prepare_ui_batch copies the packed quads to
+    // the frame slot when the batch generation moved, and draw_ui_batch issues a
+    // single instanced draw for every panel and glyph (atlases are bindless, so
+    // fonts do not split the batch). Text entries and font atlases stay owned by
+    // the render loader.
+    shader_effect_data* m_ui_batch_se = nullptr;
+    ui_batcher m_ui_batcher;
     void
-    draw_ui_panels(VkCommandBuffer cmd);
-
-    // UI text — parallel path to panels. The model sends a string + pixel anchor;
-    // glyph layout (one quad per char from the atlas metrics) and pixel->NDC happen
-    // here, render-side, in draw_ui_text. The entry cache AND the font atlas are
-    // owned by the render loader (vulkan_render_loader::ui_texts/ui_font); both are
-    // read via m_loader.
-    shader_effect_data* m_ui_text_se = nullptr;
+    init_ui_batch_pipeline();
     void
-    init_ui_text_pipeline();
+    prepare_ui_batch(frame_state& frame);
     void
-    draw_ui_text(VkCommandBuffer cmd);
+    draw_ui_batch(VkCommandBuffer cmd, frame_state& frame);
 
     // Selection mask + outline post-process
     shader_effect_data* m_selection_mask_se = nullptr;
@@ -1072,6 +1177,11 @@ private:
     VkDescriptorSet m_frustum_cull_descriptor_set = VK_NULL_HANDLE;
     bool m_gpu_frustum_culling_enabled = true;
 
+    // GPU compute pre-skinning
+    render_pass_sptr m_pre_skin_pass;
+    compute_shader_data* m_pre_skin_shader = nullptr;  // owned by m_pre_skin_pass
+    VkDescriptorSet m_pre_skin_descriptor_set = VK_NULL_HANDLE;
+
     // Frustum for view culling
     frustum m_frustum{};
 
@@ -1155,6 +1265,10 @@ private:
     // Bone matrix staging for skeletal animation
     std::vector<glm::mat4> m_bone_matrices_staging;
 
+    // Pre-skinning jobs for this frame, sorted by first_vertex
+    std::vector<gpu::skinning_job> m_skinning_jobs_staging;
+    uint32_t m_skinned_vertex_count = 0;
+
     // Light probes — bulk replacement (no per-element queue). stage_set_probes
     // updates the cache and seeds m_probes_pending_uploads with FRAMES_IN_FLIGHT
     // so each frame's SSBO picks up the new payload at its next prepare pass.
@@ -1165,6 +1279,31 @@ private:
     // Render graph
     vulkan_render_graph m_render_graph;
 
+    // submit_frame scratch: one batch per graph submission
+    struct submit_batch
+    {
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        VkSemaphore wait[2]{};
+        VkPipelineStageFlags wait_stage[2]{};
+        uint64_t wait_value[2]{};
+        VkSemaphore signal[2]{};
+        uint64_t signal_value[2]{};
+        uint32_t wait_count = 0;
+        uint32_t signal_count = 0;
+        VkTimelineSemaphoreSubmitInfo timeline{};
+    };
+    std::vector<submit_batch> m_submit_batches;
+    std::array<std::vector<VkSubmitInfo>, k_rg_queue_count> m_submit_infos;
+
+    // Per-pass GPU timings; the graph brackets each pass, render_frame opens and
+    // closes the frame slot's queries.
+    gpu_pass_profiler m_gpu_profiler;
+
+    frame_telemetry m_frame_telemetry;
+
+    // Staging ring the frame's copy lands in; polled against frame fences
+    frame_readback m_frame_readback;
+
     // Current frame state pointer (used by render graph callbacks)
     frame_state* m_current_frame = nullptr;
 
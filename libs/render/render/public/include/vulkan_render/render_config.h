@@ -74,6 +74,11 @@ struct render_config
         bool light_wireframe = true;
         bool light_icons = false;
         bool frustum_culling = true;
+        // Per-render-graph-pass GPU timestamps (render.passes RPC, Tracy GPU
+        // zones). Pipeline statistics add one query per pass and need the
+        // device's pipelineStatisticsQuery feature.
+        bool gpu_pass_timing = true;
+        bool pipeline_statistics = false;
     } debug;
 
     // Render-scale: draw the scene into a reduced-resolution target, then
@@ -96,6 +101,16 @@ struct render_config
         float normal_threshold = 0.35f;
     } outline;
 
+    // Discrete mesh LODs (converter generated chains). Each object draws the coarsest
+    // level whose simplification error projects to at most error_pixels on the scene
+    // target; shadow passes draw shadow_bias levels coarser than the camera.
+    struct lod_cfg
+    {
+        bool enabled = true;
+        float error_pixels = 1.0f;
+        uint32_t shadow_bias = 1;
+    } lod;
+
     // How many frames the CPU runs ahead of the GPU. The renderer recreates the
     // swapchain to hold this many images (keeping frames_in_flight == image
     // count), clamped to the surface's supported range. Lower = less GPU memory
@@ -129,6 +144,16 @@ struct render_config
     // can hold is a no-op, so the buffer depth is the ceiling.
     uint32_t present_pace_frames = 2;
 
+    // Run the culling compute passes on a dedicated compute queue, overlapping the
+    // shadow and UI passes. Read when the render graph is built; a no-op on devices
+    // without a separate compute family or timeline semaphores.
+    bool async_compute = true;
+
+    // Store content meshes in the compact vertex layouts (quantised position, octahedral
+    // normal, 8-bit colour, half UVs) and draw them through the compact pipeline
+    // variants. Read when a mesh is uploaded; already resident meshes keep their format.
+    bool compact_vertices = false;
+
     // Clamp all fields to valid ranges
     void
     validate();
@@ -32,6 +32,15 @@ enum class rg_resource_type
     image
 };
 
+// Hardware queue a pass records for
+enum class rg_queue : uint8_t
+{
+    graphics = 0,
+    async_compute
+};
+
+inline constexpr uint32_t k_rg_queue_count = 2;
+
 // Resource descriptor
 struct resource_description
 {
@@ -42,6 +51,7 @@ struct resource_description
     uint32_t depth = 1;
     uint32_t format = 0;
     bool is_imported = false;
+    bool is_transient = false;  // graph-owned, lives within a frame, may alias
 };
 
 // Pass resource reference
@@ -59,6 +69,60 @@ struct rg_access_info
     VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
 };
 
+// One secondary-command-buffer recording job: an item range of a split pass
+struct rg_split_chunk
+{
+    uint32_t pass = 0;  // index into the graph's passes
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    uint32_t lane = 0;  // secondary pool it records from, unique within a frame
+};
+
+// Transient resource to place: lifetime as execution-order positions, inclusive
+struct rg_alias_request
+{
+    uint32_t first = 0;
+    uint32_t last = 0;
+    VkDeviceSize size = 0;
+    VkDeviceSize alignment = 1;
+    uint32_t memory_type_bits = ~0u;
+};
+
+struct rg_alias_placement
+{
+    uint32_t heap = 0;
+    VkDeviceSize offset = 0;
+};
+
+// Memory block shared by the transients placed in it
+struct rg_alias_heap
+{
+    VkDeviceSize size = 0;
+    VkDeviceSize alignment = 1;
+    uint32_t memory_type_bits = ~0u;
+};
+
+// Compile-time run of consecutive passes (execution order) on one queue. A queue
+// runs its segments in order; across queues a segment waits on the other queue's
+// latest segment it has a hazard with.
+struct rg_segment
+{
+    rg_queue queue = rg_queue::graphics;
+    std::vector<size_t> passes{};
+    int32_t wait_on = -1;  // segment index on the other queue, -1 = none
+};
+
+// One batch of a frame, in segment order. Values are on the per-queue timeline
+// semaphores; 0 = no wait / no signal (single-queue frames use neither).
+struct rg_submission
+{
+    rg_queue queue = rg_queue::graphics;
+    VkCommandBuffer cmd = VK_NULL_HANDLE;  // null: a wait-only join
+    uint64_t wait_value = 0;  // on the other queue's timeline
+    VkPipelineStageFlags wait_stage = 0;
+    uint64_t signal_value = 0;  // on this queue's timeline
+};
+
 // Pre-computed barriers for a pass
 struct rg_pass_barriers
 {
@@ -9,6 +9,10 @@
 
 #include <glm/vec3.hpp>
 
+#include <array>
+#include <span>
+#include <vector>
+
 namespace kryga
 {
 namespace render
@@ -24,6 +28,79 @@ struct vertex_input_description
 vertex_input_description
 convert_to_vertex_input_description(kryga::utils::dynobj_layout& dol);
 
+// Storage of a mesh's vertex buffer
+enum class vertex_format : uint8_t
+{
+    full,     // gpu::vertex_data / gpu::skinned_vertex_data
+    compact,  // gpu::compact_vertex_data / gpu::compact_skinned_vertex_data
+};
+
+// How one attribute of the full vertex is stored in the compact one
+enum class vertex_encoding : uint8_t
+{
+    bounds_unorm16,      // vec3 as a fraction of the mesh bounds, 4 x unorm16
+    octahedral_snorm16,  // unit vec3, 2 x snorm16
+    unorm8,              // vec3 in [0, 1], 4 x unorm8
+    half,                // vec2, 2 x float16
+    unorm16,             // vec2 in [0, 1], 2 x unorm16
+    uint8,               // uvec4 below 256, 4 x uint8
+    weights_unorm8,      // vec4 summing to 1, 4 x unorm8 still summing to 255
+};
+
+struct compact_attribute
+{
+    uint32_t location;  // vertex input location
+    vertex_encoding encoding;
+    uint32_t src_offset;  // into the full vertex
+    uint32_t dst_offset;  // into the compact vertex
+};
+
+// The compact layouts, in location order. The static one builds both the vertex input
+// of the compact pipelines and the encoded vertices, so the two cannot drift apart;
+// the skinned one is only read by the pre-skin pass, by address
+extern const std::array<compact_attribute, 5> k_compact_vertex_layout;
+extern const std::array<compact_attribute, 6> k_compact_skinned_vertex_layout;
+
+VkFormat
+to_vk_format(vertex_encoding e);
+
+// Vertex input of the compact pipeline variant for a shader reading `dol`. False when
+// the shader reads an input the compact layout cannot feed as floats
+bool
+convert_to_compact_vertex_input_description(kryga::utils::dynobj_layout& dol,
+                                            vertex_input_description& out);
+
+// Position dequantisation of a compact mesh: local = stored * scale + offset
+struct vertex_dequant
+{
+    glm::vec3 scale{1.0f};
+    glm::vec3 offset{0.0f};
+};
+
+vertex_dequant
+encode_compact_vertices(std::span<const gpu::vertex_data> src,
+                        std::vector<gpu::compact_vertex_data>& dst);
+
+vertex_dequant
+encode_compact_vertices(std::span<const gpu::skinned_vertex_data> src,
+                        std::vector<gpu::compact_skinned_vertex_data>& dst);
+
+// One level of detail: a range of the mesh's index buffer. Chunked meshes switch on
+// max_distance; discrete chains (converter generated) on error, the simplification
+// error relative to the bounding radius, projected to pixels.
+struct mesh_lod
+{
+    uint32_t first_index = 0U;
+    uint32_t index_count = 0U;
+    float max_distance = 0.0f;
+    float error = 0.0f;
+};
+
+// Chunked meshes: the finest level whose max_distance lies beyond `distance` (to
+// the chunk's nearest point), else the coarsest
+uint32_t
+select_chunk_lod(std::span<const mesh_lod> lods, float distance);
+
 class mesh_data
 {
 public:
@@ -59,6 +136,33 @@ public:
         return m_indices_size;
     }
 
+    bool
+    is_chunked() const
+    {
+        return m_chunk_vertex_count != 0;
+    }
+
+    // Each object has its own draw range, so objects of this mesh never share a batch
+    bool
+    draws_per_object() const
+    {
+        return m_is_skinned || is_chunked();
+    }
+
+    // Simplified index lists over the full vertex buffer, picked per object and view
+    bool
+    has_discrete_lods() const
+    {
+        return !is_chunked() && m_lods.size() > 1;
+    }
+
+    // Format of the vertices bound for drawing
+    bool
+    draws_compact() const
+    {
+        return m_vertex_format == vertex_format::compact && !m_is_skinned;
+    }
+
     const ::kryga::utils::id&
     get_id()
     {
@@ -88,6 +192,24 @@ public:
     float m_bounding_radius = 0.0f;
     bool m_is_skinned = false;
 
+    // Compact meshes draw through the compact pipeline variants; skinned ones are
+    // expanded by the pre-skin pass and always draw full vertices
+    vertex_format m_vertex_format = vertex_format::full;
+    vertex_dequant m_dequant;
+
+    // Chunked continuous-LOD grid (terrain): the vertex buffer holds equally sized
+    // chunks of m_chunk_vertex_count vertices and the index buffer one index list per
+    // level, shared by every chunk. Each render object draws one chunk.
+    // Otherwise, when set, a discrete chain: level 0 is the main list and the coarser
+    // levels sit after it (and after the shadow list) in the same index buffer.
+    std::vector<mesh_lod> m_lods;
+    uint32_t m_chunk_vertex_count = 0U;
+
+    // Optional position-only index list stored after the main one: vertices that
+    // differ only in normal / uv share an index, so depth passes transform fewer
+    uint32_t m_shadow_first_index = 0U;
+    uint32_t m_shadow_index_count = 0U;
+
     vk_utils::vulkan_buffer m_vertex_buffer;
     vk_utils::vulkan_buffer m_index_buffer;
 
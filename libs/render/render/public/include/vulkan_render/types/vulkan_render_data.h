@@ -49,6 +49,12 @@ public:
     // Skeletal animation state
     uint32_t bone_offset = 0;  // offset into global bone matrices SSBO
     uint32_t bone_count = 0;   // number of bones (0 = not animated)
+    // First vertex in this frame's skinned vertex pool (skinned meshes only)
+    int32_t skinned_first_vertex = 0;
+
+    // Chunked meshes: the chunk this object draws and its level for this frame
+    uint32_t mesh_chunk = 0;
+    uint32_t mesh_lod = 0;
 
     std::string queue_id;
 };
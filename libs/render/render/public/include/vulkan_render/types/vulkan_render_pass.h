@@ -9,6 +9,7 @@
 
 #include <error_handling/error_handling.h>
 
+#include <utils/check.h>
 #include <utils/id.h>
 
 #include <functional>
@@ -47,7 +48,11 @@ public:
     // =========================================================================
 
     bool
-    begin(VkCommandBuffer cmd, uint64_t swapchain_image_index, uint32_t width, uint32_t height);
+    begin(VkCommandBuffer cmd,
+          uint64_t swapchain_image_index,
+          uint32_t width,
+          uint32_t height,
+          VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 
     bool
     end(VkCommandBuffer cmd);
@@ -55,6 +60,59 @@ public:
     void
     execute(VkCommandBuffer cmd, uint64_t swapchain_image_index, uint32_t width, uint32_t height);
 
+    // Split recording (graphics passes): the pass's work as count() independent
+    // items, any contiguous range of which `record` can put into a command buffer
+    // of its own. A range sets every piece of state it draws with, so ranges may be
+    // recorded concurrently and replayed in order. The execute callback stays the
+    // inline path.
+    void
+    set_split_execute(std::function<uint32_t()> count,
+                      std::function<void(VkCommandBuffer, uint32_t, uint32_t)> record);
+
+    bool
+    is_split() const
+    {
+        return m_split_count != nullptr;
+    }
+
+    uint32_t
+    split_item_count() const
+    {
+        return m_split_count ? m_split_count() : 0;
+    }
+
+    // Records items [begin, end) into `secondary`, continuing this pass's render pass
+    void
+    record_secondary(VkCommandBuffer secondary,
+                     uint64_t swapchain_image_index,
+                     uint32_t width,
+                     uint32_t height,
+                     uint32_t begin,
+                     uint32_t end);
+
+    // execute() for a split pass whose ranges record_secondary() already recorded
+    void
+    execute_secondaries(VkCommandBuffer cmd,
+                        uint64_t swapchain_image_index,
+                        uint32_t width,
+                        uint32_t height,
+                        const VkCommandBuffer* secondaries,
+                        uint32_t count);
+
+    // Compute passes: may run on the async compute queue when the graph has one
+    void
+    set_async_compute(bool async)
+    {
+        KRG_check(m_type == rg_pass_type::compute, "Only compute passes run async");
+        m_async_compute = async;
+    }
+
+    bool
+    is_async_compute() const
+    {
+        return m_async_compute;
+    }
+
     // =========================================================================
     // Shader effect management (graphics passes)
     // =========================================================================
@@ -212,6 +270,13 @@ public:
                           const std::string& debug_name);
 
 private:
+    VkExtent2D
+    extent(uint32_t width, uint32_t height) const
+    {
+        return {.width = m_fixed_width > 0 ? m_fixed_width : width,
+                .height = m_fixed_height > 0 ? m_fixed_height : height};
+    }
+
     // Pass identity and type
     utils::id m_name;
     rg_pass_type m_type = rg_pass_type::graphics;
@@ -220,8 +285,11 @@ private:
     std::vector<rg_resource_ref> m_resources{};
     VkClearColorValue m_clear_color = {0, 0, 0, 0};
     std::function<void(VkCommandBuffer)> m_execute;
+    std::function<uint32_t()> m_split_count;
+    std::function<void(VkCommandBuffer, uint32_t, uint32_t)> m_split_record;
     rg_pass_barriers m_barriers;
     uint32_t m_order = 0;
+    bool m_async_compute = false;
 
     // Attachment formats
     VkFormat m_color_format = VK_FORMAT_UNDEFINED;
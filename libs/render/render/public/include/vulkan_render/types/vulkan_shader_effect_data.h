@@ -65,8 +65,23 @@ public:
         m_expected_vertex_input = v;
     }
 
+    // Pipeline drawing meshes of the given vertex storage. Null for compact meshes when
+    // the vertex shader does not decode them (no COMPACT_VERTEX spec constant)
+    VkPipeline
+    get_pipeline(bool compact, bool stencil) const
+    {
+        if (compact)
+        {
+            return stencil ? m_compact_with_stencil_pipeline : m_compact_pipeline;
+        }
+        return stencil ? m_with_stencil_pipeline : m_pipeline;
+    }
+
     VkPipeline m_pipeline = VK_NULL_HANDLE;
     VkPipeline m_with_stencil_pipeline = VK_NULL_HANDLE;
+    // Same stages fed gpu::compact_vertex_data, with COMPACT_VERTEX on
+    VkPipeline m_compact_pipeline = VK_NULL_HANDLE;
+    VkPipeline m_compact_with_stencil_pipeline = VK_NULL_HANDLE;
     VkPipelineLayout m_pipeline_layout = VK_NULL_HANDLE;
 
     std::array<VkDescriptorSetLayout, DESCRIPTORS_SETS_COUNT> m_set_layout{};
@@ -100,6 +115,7 @@ public:
     bool m_system = false;
     bool m_failed_load = false;
     bool m_owns_pipeline_layout = true;  // false when using shared_pipeline_layout
+    bool m_reported_no_compact = false;  // compact mesh met an effect without the variant
 
     render_pass*
     get_owner_render_pass() const
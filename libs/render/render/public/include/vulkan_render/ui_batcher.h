@@ -0,0 +1,136 @@
+#pragma once
+
+#include <gpu_types/gpu_ui_types.h>
+
+#include <utils/id.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace kryga::render
+{
+
+class font_atlas;
+
+// One line of UI text, the payload of the loader's ui_text laned_storage. The
+// model widget (ui::ui_text) holds the handle; ui_text_upsert populates the slot
+// and hands it to the batcher, which lays it out once (anchor: 0=TL,1=TR,2=BL,
+// 3=BR). Default-constructs to an empty slot for the pool's grow/reset.
+struct ui_text_entry
+{
+    std::string text;
+    int32_t x = 0;
+    int32_t y = 0;
+    uint32_t anchor = 0;
+    float font_size = 24.0f;
+    glm::vec4 color{1.0f};
+    kryga::utils::id font;  // which baked font to use; empty -> loader's default
+
+    bool
+    operator==(const ui_text_entry&) const = default;
+};
+
+// Retained UI batch: the CPU side of the single-draw UI path. Panels and text
+// lines are laid out into gpu::ui_quad instances once, when their upsert changes
+// them, and cached per widget. quads() flattens the cache (panels first, then
+// text in slot order) only when something changed; generation() bumps with every
+// change so the renderer re-uploads a frame slot's instance buffer only when it
+// is stale. Unchanged frames do no layout and no upload.
+//
+// Text is UTF-8. A line pins its glyphs in the font's cache; glyphs that are not
+// resident yet are skipped (the pen still advances) and the line is re-laid out
+// by refresh() once the font's revision moves.
+//
+// Rects are stored anchor-relative (see KGPU_UI_ANCHOR_*), so a viewport resize
+// does not invalidate the batch — se_ui_batch.vert resolves the anchor.
+//
+// Render-thread only; no Vulkan, so it is unit-testable on its own.
+class ui_batcher
+{
+public:
+    using font_resolver = std::function<font_atlas*(const utils::id&)>;
+
+    // Panel rect in pixels, top-left anchored (x, y, x + w, y + h).
+    void
+    set_panel(const utils::id& id, const glm::vec4& rect_px, const glm::vec4& color);
+    void
+    remove_panel(const utils::id& id);
+
+    // Lay out one text line under `key` (the ui_text handle's slot index). A null
+    // font parks the entry until refresh() resolves it.
+    void
+    set_text(uint32_t key, const ui_text_entry& e, font_atlas* font);
+    void
+    remove_text(uint32_t key);
+
+    // Resolve parked fonts and re-lay out lines that were missing glyphs when the
+    // font has produced new ones since. Free when nothing is outstanding.
+    void
+    refresh(const font_resolver& resolver);
+
+    bool
+    has_outstanding() const
+    {
+        return m_pending_fonts != 0 || m_incomplete != 0;
+    }
+
+    // `font` is about to be destroyed: park every line that uses it.
+    void
+    forget_font(const font_atlas* font);
+
+    // Flattened instance list; repacked lazily when dirty.
+    const std::vector<gpu::ui_quad>&
+    quads();
+
+    uint64_t
+    generation() const
+    {
+        return m_generation;
+    }
+
+    void
+    clear();
+
+private:
+    struct text_slot
+    {
+        bool live = false;
+        bool pending_font = false;
+        bool incomplete = false;
+        font_atlas* font = nullptr;
+        uint64_t font_revision = 0;
+        ui_text_entry entry;  // last laid-out input, to drop no-op upserts
+        std::vector<gpu::ui_quad> quads;
+        std::vector<uint32_t> pinned;  // codepoints acquired from `font`
+    };
+
+    void
+    layout_slot(text_slot& slot);
+    void
+    unpin(text_slot& slot);
+    void
+    mark_dirty();
+
+    std::unordered_map<utils::id, gpu::ui_quad> m_panels;
+    std::vector<text_slot> m_texts;
+    uint32_t m_pending_fonts = 0;
+    uint32_t m_incomplete = 0;
+
+    std::vector<gpu::ui_quad> m_packed;
+    bool m_dirty = false;
+    uint64_t m_generation = 0;
+};
+
+// Glyph quads for one text line, anchor-relative. Acquires every codepoint from
+// `font` and appends it to `pinned` (the caller releases them). Returns false if
+// some glyph is not resident yet. Exposed for the batcher tests.
+bool
+layout_ui_text(const ui_text_entry& e,
+               font_atlas& font,
+               std::vector<gpu::ui_quad>& out,
+               std::vector<uint32_t>& pinned);
+
+}  // namespace kryga::render
@@ -30,6 +30,13 @@ public:
     static vulkan_image
     create(VkImage, VkFormat format = VK_FORMAT_UNDEFINED);
 
+    // Image with no memory of its own, for placing into a vulkan_memory with
+    // bind_memory (aliasing). The memory must outlive the image.
+    static vulkan_image
+    create_unbound(const vma_allocator_provider& allocator,
+                   VkImageCreateInfo ici,
+                   std::string_view debug_name = {});
+
     KRG_gen_class_non_copyable(vulkan_image);
 
     vulkan_image(vulkan_image&& other) noexcept;
@@ -63,6 +70,12 @@ public:
         return mipLevels;
     }
 
+    VkMemoryRequirements
+    get_memory_requirements() const;
+
+    void
+    bind_memory(VmaAllocation memory, VkDeviceSize offset);
+
 private:
     vulkan_image(vma_allocator_provider a, int mips_level);
 
@@ -76,6 +89,37 @@ private:
 
 using vulkan_image_sptr = std::shared_ptr<vulkan_image>;
 
+// Device memory block that resources are placed into rather than allocated with
+class vulkan_memory
+{
+public:
+    vulkan_memory() = default;
+    ~vulkan_memory();
+
+    KRG_gen_class_non_copyable(vulkan_memory);
+
+    vulkan_memory(vulkan_memory&& other) noexcept;
+    vulkan_memory&
+    operator=(vulkan_memory&& other) noexcept;
+
+    static vulkan_memory
+    create(const vma_allocator_provider& allocator,
+           const VkMemoryRequirements& requirements,
+           VmaAllocationCreateInfo aci);
+
+    void
+    clear();
+
+    VmaAllocation
+    allocation() const
+    {
+        return m_allocation;
+    }
+
+private:
+    VmaAllocation m_allocation = VK_NULL_HANDLE;
+};
+
 class vulkan_image_view;
 using vulkan_image_view_sptr = std::shared_ptr<vulkan_image_view>;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "vulkan_render/render_enums.h"
+#include "vulkan_render/render_graph_types.h"
 #include "vulkan_render/types/vulkan_generic.h"
 #include "vulkan_render/types/vulkan_render_types_fwds.h"
 #include "vulkan_render/utils/vulkan_buffer.h"
@@ -9,6 +10,7 @@
 #include <utils/check.h>
 #include <utils/id.h>
 
+#include <array>
 #include <functional>
 #include <vector>
 #include <memory>
@@ -51,6 +53,23 @@ struct frame_data
     VkCommandPool m_command_pool{};
     VkCommandBuffer m_main_command_buffer{};
 
+    // Transient command buffers, recycled with the frame: a pool and the buffers
+    // handed out from it so far
+    struct command_lane
+    {
+        VkCommandPool pool{};
+        std::vector<VkCommandBuffer> buffers;
+        uint32_t used = 0;
+    };
+
+    // Secondary command buffers for parallel pass recording, a pool per lane.
+    // A lane belongs to one recording job at a time.
+    static constexpr uint32_t k_secondary_lanes = 16;
+    std::array<command_lane, k_secondary_lanes> m_secondary_lanes{};
+
+    // Primaries for the render graph's segments after the first, per queue
+    std::array<command_lane, k_rg_queue_count> m_segment_lanes{};
+
     std::unique_ptr<vk_utils::descriptor_allocator> m_dynamic_descriptor_allocator{};
 };
 
@@ -135,6 +154,34 @@ public:
         return m_graphics_queue_family;
     }
 
+    // A compute-only queue family plus timeline semaphores: the render graph's
+    // async compute passes run there. Otherwise the compute accessors alias
+    // graphics. Buffers from create_buffer() are shared by both families.
+    bool
+    has_async_compute() const
+    {
+        return m_async_compute;
+    }
+
+    VkQueue
+    vk_compute_queue() const
+    {
+        return m_async_compute ? m_compute_queue : m_graphics_queue;
+    }
+
+    uint32_t
+    compute_queue_family() const
+    {
+        return m_async_compute ? m_compute_queue_family : m_graphics_queue_family;
+    }
+
+    // Per-queue timeline the render graph's segments signal; null without async
+    VkSemaphore
+    queue_timeline(rg_queue queue) const
+    {
+        return m_queue_timelines[static_cast<uint32_t>(queue)];
+    }
+
     void
     destruct();
 
@@ -169,6 +216,19 @@ public:
         return m_frames[idx];
     }
 
+    // Next secondary command buffer of `lane` this frame; from the thread that
+    // owns the lane. Allocated on first use, recycled by reset_frame_commands().
+    VkCommandBuffer
+    acquire_secondary(frame_data& frame, uint32_t lane);
+
+    // Next primary for a render graph segment on `queue` this frame
+    VkCommandBuffer
+    acquire_segment(frame_data& frame, rg_queue queue);
+
+    // Secondaries and segment buffers; once the frame's fence has signalled
+    void
+    reset_frame_commands(frame_data& frame);
+
     size_t
     frame_size() const
     {
@@ -208,6 +268,22 @@ public:
     bool
     is_present_mode_supported(present_mode mode) const;
 
+    // --- GPU profiling capabilities ----------------------------------------
+    // Valid bits of graphics-queue timestamps (0 = timestamps unsupported) and
+    // whether pipelineStatisticsQuery was enabled. See gpu_pass_profiler.
+
+    uint32_t
+    timestamp_valid_bits() const
+    {
+        return m_timestamp_valid_bits;
+    }
+
+    bool
+    pipeline_statistics_supported() const
+    {
+        return m_pipeline_statistics_supported;
+    }
+
     // --- Render→display latency (VK_KHR_present_wait) -----------------------
     // Measures submit→displayed time per present. Only active when the device
     // enabled VK_KHR_present_wait + present_id at creation (windowed + driver
@@ -454,6 +530,12 @@ public:
     VmaAllocator m_allocator = VK_NULL_HANDLE;
     VkQueue m_graphics_queue{};
     uint32_t m_graphics_queue_family{};
+
+    bool m_async_compute = false;
+    VkQueue m_compute_queue{};
+    uint32_t m_compute_queue_family{};
+    uint32_t m_shared_families[2] = {};
+    VkSemaphore m_queue_timelines[k_rg_queue_count] = {};
     upload_context m_upload_context{};
 
     VkSwapchainKHR m_swapchain = VK_NULL_HANDLE;
@@ -483,6 +565,8 @@ public:
     // vkWaitForPresentKHR isn't exported by the loader .lib (newer extension), so
     // it's resolved via vkGetDeviceProcAddr when the extension is enabled.
     bool m_present_wait_supported = false;
+    bool m_pipeline_statistics_supported = false;
+    uint32_t m_timestamp_valid_bits = 0;
     PFN_vkWaitForPresentKHR m_vk_wait_for_present = nullptr;
     uint64_t m_present_id = 0;          // per-swapchain, strictly increasing
     uint64_t m_current_present_id = 0;  // storage chained into VkPresentIdKHR
@@ -9,19 +9,28 @@
 
 #include <vulkan/vulkan.h>
 
+#include <algorithm>
+#include <array>
 #include <functional>
 #include <memory>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 #include <variant>
 #include <vector>
 
+namespace kryga::jobs
+{
+class job_system;
+}
+
 namespace kryga::render
 {
 
 // Forward declarations
 class render_pass;
 using render_pass_sptr = std::shared_ptr<render_pass>;
+class gpu_pass_profiler;
 
 // ============================================================================
 // Vulkan-specific resource types
@@ -34,8 +43,12 @@ struct vulkan_resource
     VkBufferUsageFlags buffer_usage = 0;
     VkImageUsageFlags image_usage = 0;
     VkFormat image_format = VK_FORMAT_UNDEFINED;
-    rg_access_info last_access;
+    // Per queue; image layouts are kept in step on both
+    std::array<rg_access_info, k_rg_queue_count> last_access{};
+    rg_queue owner = rg_queue::graphics;  // images: queue family that owns it
     std::variant<vk_utils::vulkan_buffer*, vk_utils::vulkan_image*> binding;
+    // Transients: those that held its memory earlier in the frame
+    std::vector<const vulkan_resource*> aliases;
 };
 
 // Per-frame render context
@@ -66,6 +79,27 @@ public:
     void
     import_resource(const utils::id& name, rg_resource_type type = rg_resource_type::image);
 
+    // Graph-owned image, live from its first to its last use in a frame. Its memory
+    // is shared with transients whose lifetimes don't overlap, so nothing survives
+    // the frame. Placed at compile() when a transient allocator is set, and bound
+    // by the graph.
+    void
+    register_transient_image(const utils::id& name,
+                             uint32_t width,
+                             uint32_t height,
+                             VkFormat format,
+                             VkImageUsageFlags usage);
+
+    // Without one compile() leaves transients unallocated
+    void
+    set_transient_allocator(vk_utils::vma_allocator_provider allocator)
+    {
+        m_transient_allocator = std::move(allocator);
+    }
+
+    vk_utils::vulkan_image*
+    get_transient_image(const utils::id& name);
+
     // Helper to create resource refs (looks up resource by name)
     rg_resource_ref
     read(const utils::id& name)
@@ -130,6 +164,108 @@ public:
     void
     set_final_layout(const utils::id& name, VkImageLayout layout);
 
+    // Optional: bracket every executed pass (barriers included) with GPU
+    // timestamp queries. Not owned; null disables.
+    void
+    set_profiler(gpu_pass_profiler* profiler)
+    {
+        m_profiler = profiler;
+    }
+
+    // Parallel recording. Before the primary walk, split passes
+    // (render_pass::set_split_execute) are cut into chunks, one per lane at most,
+    // and recorded into secondaries from `acquire(lane)` on the job system; the
+    // walk then replays them in graph order between the usual barriers. A lane is
+    // given to one chunk per frame. No job system or no lanes: every pass records
+    // inline into the primary.
+    void
+    set_secondary_recording(jobs::job_system* jobs,
+                            uint32_t lanes,
+                            std::function<VkCommandBuffer(uint32_t lane)> acquire);
+
+    // Fewest items worth a secondary of their own
+    static constexpr uint32_t k_min_items_per_chunk = 2;
+
+    // Spreads `lanes` over split passes given as (pass index, item count): at most
+    // an even share of what is left per pass, no chunk under k_min_items_per_chunk
+    // items unless the pass has fewer. Passes with no items get no chunk; passes
+    // left without a lane record inline.
+    static void
+    plan_split_chunks(std::span<const std::pair<uint32_t, uint32_t>> passes,
+                      uint32_t lanes,
+                      std::vector<rg_split_chunk>& out);
+
+    // Secondaries recorded by the last execute()
+    uint32_t
+    get_secondary_count() const
+    {
+        return static_cast<uint32_t>(m_chunks.size());
+    }
+
+    // Places transients: largest first, each at the lowest aligned offset clear of
+    // those already placed that are alive at the same time, into the compatible
+    // heap that grows least. A heap takes the memory types all its requests allow.
+    static void
+    plan_aliasing(std::span<const rg_alias_request> requests,
+                  std::vector<rg_alias_placement>& placements,
+                  std::vector<rg_alias_heap>& heaps);
+
+    struct transient_stats
+    {
+        uint32_t images = 0;
+        uint32_t heaps = 0;
+        VkDeviceSize requested = 0;  // sum of the images' sizes
+        VkDeviceSize allocated = 0;  // sum of the heaps' sizes
+    };
+
+    const transient_stats&
+    get_transient_stats() const
+    {
+        return m_transient_stats;
+    }
+
+    // Async compute. Compute passes marked render_pass::set_async_compute run on
+    // `compute_family` once this is set (before compile). compile() cuts the
+    // execution order into per-queue segments; a segment waits on the other
+    // queue's latest segment it has a hazard with: a write on either side for
+    // buffers, which must be shared by both families (concurrent), any use for
+    // images, which change owner with release/acquire barriers. Images are owned
+    // by graphics between frames, so an async pass that would be an image's last
+    // user stays on graphics. Segment 0 is always the caller's graphics command
+    // buffer, holding what it recorded before execute(); further segments record
+    // into buffers from `acquire(queue)`. Same family or unset: one queue.
+    void
+    set_async_compute(uint32_t graphics_family,
+                      uint32_t compute_family,
+                      std::function<VkCommandBuffer(rg_queue)> acquire);
+
+    // Batches of the last execute(), in order, for the caller to end and submit.
+    // Single entry holding the caller's buffer when nothing runs async.
+    const std::vector<rg_submission>&
+    get_submissions() const
+    {
+        return m_submissions;
+    }
+
+    // Graphics buffer the frame continues in after execute()
+    VkCommandBuffer
+    get_graphics_tail() const
+    {
+        return m_graphics_tail;
+    }
+
+    const std::vector<rg_segment>&
+    get_segments() const
+    {
+        return m_segments;
+    }
+
+    rg_queue
+    get_pass_queue(size_t pass_idx) const
+    {
+        return pass_idx < m_pass_queue.size() ? m_pass_queue[pass_idx] : rg_queue::graphics;
+    }
+
     // Compile and execute
     bool
     compile();
@@ -153,6 +289,29 @@ public:
         return m_execution_order;
     }
 
+    // compile() drops passes that nothing reaches from the frame's outputs: kept
+    // are passes writing an imported resource or one with a final layout, passes
+    // with no declared writes, and every pass a kept pass reads from
+    bool
+    is_pass_culled(size_t pass_idx) const
+    {
+        return pass_idx < m_culled.size() && m_culled[pass_idx];
+    }
+
+    uint32_t
+    get_culled_count() const
+    {
+        return static_cast<uint32_t>(std::count(m_culled.begin(), m_culled.end(), true));
+    }
+
+    // Barriers are worked out once per compiled graph and replayed each frame; a
+    // change in the layouts images start the frame in rebuilds them
+    uint32_t
+    get_barrier_cache_builds() const
+    {
+        return m_barrier_cache_builds;
+    }
+
     size_t
     get_pass_count() const
     {
@@ -173,17 +332,63 @@ private:
     compute_access_for_usage(rg_access_mode usage,
                              rg_pass_type pass_type,
                              rg_resource_type res_type,
-                             VkFormat image_format = VK_FORMAT_UNDEFINED);
+                             VkFormat image_format = VK_FORMAT_UNDEFINED,
+                             VkBufferUsageFlags buffer_usage = 0);
 
     static bool
     needs_barrier(const rg_access_info& prev, const rg_access_info& next);
 
+    // A barrier worked out by calculate_barriers(); handles are filled in at replay
+    struct cached_barrier
+    {
+        const vulkan_resource* res = nullptr;
+        VkPipelineStageFlags src_stage = 0;  // releases and final transitions only
+        VkAccessFlags src_access = 0;
+        VkAccessFlags dst_access = 0;
+        VkImageLayout old_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkImageLayout new_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        uint32_t src_family = VK_QUEUE_FAMILY_IGNORED;
+        uint32_t dst_family = VK_QUEUE_FAMILY_IGNORED;
+        uint32_t submission = 0;  // releases: the batch it records into
+    };
+
+    struct cached_pass
+    {
+        VkPipelineStageFlags src_stage = 0;
+        VkPipelineStageFlags dst_stage = 0;
+        uint32_t first = 0;  // into m_cached_barriers
+        uint32_t count = 0;
+        uint32_t first_release = 0;  // into m_cached_releases
+        uint32_t release_count = 0;
+    };
+
+    // Walks the frame from the current (frame-start) resource state and caches
+    // every barrier, ownership release and final transition it needs
     void
     calculate_barriers();
 
+    static void
+    append_barrier(const cached_barrier& b, rg_pass_barriers& barriers);
+
+    void
+    cull_passes(const std::vector<std::vector<size_t>>& deps);
+
+    void
+    place_transients();
+
     void
     insert_barriers(VkCommandBuffer cmd, const rg_pass_barriers& barriers);
 
+    void
+    record_split_passes(uint32_t swapchain_image_index, uint32_t width, uint32_t height);
+
+    // Reorders m_execution_order when passes run async
+    void
+    plan_queues(const std::vector<std::vector<size_t>>& deps);
+
+    void
+    begin_segments(VkCommandBuffer cmd);
+
     std::unordered_map<utils::id, vulkan_resource> m_resources{};
     std::vector<render_pass_sptr> m_passes{};
     std::vector<size_t> m_execution_order{};
@@ -191,6 +396,60 @@ private:
 
     std::unordered_set<utils::id> m_bound_this_frame{};
     std::unordered_map<utils::id, VkImageLayout> m_final_layouts{};
+
+    gpu_pass_profiler* m_profiler = nullptr;
+
+    // Parallel recording
+    jobs::job_system* m_jobs = nullptr;
+    uint32_t m_lanes = 0;
+    std::function<VkCommandBuffer(uint32_t)> m_acquire_secondary;
+
+    // Per frame: chunks and their secondaries, index-aligned and grouped by pass;
+    // m_first_chunk[pass] is the pass's first chunk, -1 if it records inline
+    std::vector<std::pair<uint32_t, uint32_t>> m_split_passes;
+    std::vector<rg_split_chunk> m_chunks;
+    std::vector<VkCommandBuffer> m_secondaries;
+    std::vector<int32_t> m_first_chunk;
+
+    // Async compute
+    uint32_t m_queue_family[k_rg_queue_count] = {};
+    std::function<VkCommandBuffer(rg_queue)> m_acquire_segment;
+    std::vector<rg_queue> m_pass_queue;
+    std::vector<rg_segment> m_segments;
+    bool m_join_tail = false;  // graphics ends before the last async segment
+
+    // Per frame; the timelines only ever grow, across resets too
+    uint64_t m_timeline[k_rg_queue_count] = {};
+    std::vector<rg_submission> m_submissions;
+    VkCommandBuffer m_graphics_tail = VK_NULL_HANDLE;
+
+    std::vector<bool> m_culled;
+
+    // Transients, index-stable once compiled: resources bind to their images
+    struct transient
+    {
+        utils::id name;
+        VkImageCreateInfo info{};
+        vk_utils::vulkan_image image;
+        uint32_t first = 0;  // execution-order positions of its first and last use
+        uint32_t last = 0;
+    };
+    std::vector<transient> m_transients;
+    std::vector<vk_utils::vulkan_memory> m_transient_heaps;
+    vk_utils::vma_allocator_provider m_transient_allocator;
+    transient_stats m_transient_stats;
+
+    // Barrier cache, keyed by the layouts m_cached_images start the frame in
+    bool m_barriers_valid = false;
+    uint32_t m_barrier_cache_builds = 0;
+    std::vector<cached_pass> m_cached_passes;
+    std::vector<cached_barrier> m_cached_barriers;
+    std::vector<cached_barrier> m_cached_releases;
+    std::vector<cached_barrier> m_cached_finals;
+    std::vector<VkPipelineStageFlags> m_cached_wait_stage;  // per segment
+    std::vector<vulkan_resource*> m_cached_images;
+    std::vector<VkImageLayout> m_cached_start_layouts;
+    std::vector<VkImageLayout> m_cached_end_layouts;
 };
 
 }  // namespace kryga::render
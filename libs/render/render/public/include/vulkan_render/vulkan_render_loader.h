@@ -9,6 +9,7 @@
 #include "vulkan_render/types/vulkan_texture_data.h"
 #include "vulkan_render/types/vulkan_render_pass.h"
 #include "vulkan_render/font_atlas.h"
+#include "vulkan_render/ui_batcher.h"
 #include "vulkan_render/utils/vulkan_image.h"
 #include "vulkan_render/vulkan_render_loader_create_infos.h"
 #include "vulkan_render/render_thread.h"  // KRG_check_model_thread / _render_thread
@@ -59,21 +60,6 @@ struct lightmap_binding
     std::unordered_map<kryga::utils::id, lightmap_uv> entries{};  // object/component id → UV
 };
 
-// One line of UI text, the payload of the loader's ui_text laned_storage. The
-// model widget (ui::ui_text) holds the handle; ui_text_upsert populates the slot,
-// draw_ui_text reads it. Glyph layout happens at draw time (anchor: 0=TL,1=TR,
-// 2=BL,3=BR). Default-constructs to an empty slot for the pool's grow/reset.
-struct ui_text_entry
-{
-    std::string text;
-    int32_t x = 0;
-    int32_t y = 0;
-    uint32_t anchor = 0;
-    float font_size = 24.0f;
-    glm::vec4 color{1.0f};
-    kryga::utils::id font;  // which baked font to use; empty -> loader's default
-};
-
 // The storage instantiations the loader owns are the laned_storage aliases
 // from render_types/render_handle.h (one lane per allocator; handles
 // self-route by the lane bits in their index). Lane convention is defined
@@ -472,17 +458,24 @@ public:
     }
 
     // [render thread] Fill a pre-reserved CONTENT mesh slot and mark it resident.
+    // `format` picks the GPU storage; the vertices passed in are always full.
+    // `lods` are ranges of `lod_indices`, coarser levels after the main list.
     void
     populate_mesh(render::types::mesh_handle h,
                   const kryga::utils::id& mesh_id,
                   kryga::utils::buffer_view<gpu::vertex_data> vertices,
-                  kryga::utils::buffer_view<gpu::uint> indices);
+                  kryga::utils::buffer_view<gpu::uint> indices,
+                  vertex_format format = vertex_format::full,
+                  std::span<const gpu::uint> shadow_indices = {},
+                  std::span<const gpu::uint> lod_indices = {},
+                  std::span<const mesh_lod> lods = {});
 
     void
     populate_skinned_mesh(render::types::mesh_handle h,
                           const kryga::utils::id& mesh_id,
                           kryga::utils::buffer_view<gpu::skinned_vertex_data> vertices,
-                          kryga::utils::buffer_view<gpu::uint> indices);
+                          kryga::utils::buffer_view<gpu::uint> indices,
+                          vertex_format format = vertex_format::full);
 
     // [render thread] Release a content mesh slot's GPU data + invalidate it.
     void
@@ -583,8 +576,9 @@ public:
     // UI text registry (render-thread owned), handle-indexed laned_storage. The
     // model widget (ui::ui_text) holds the handle; render_translator's ui_text
     // allocator mints it (k_content style, single lane 0). The builder reserves,
-    // populate writes the slot, reset clears it (hide/destroy), draw_ui_text
-    // iterates the live slots. Storage handed to that allocator via bind().
+    // populate writes the slot, reset clears it (hide/destroy); the processor then
+    // forwards the slot to vulkan_render::ui_text_changed so the batch re-lays out
+    // only that line. Storage handed to that allocator via bind().
     ui_text_storage&
     ui_texts_storage()
     {
@@ -613,29 +607,35 @@ public:
     // Runtime UI fonts — id-keyed registry (same shape as the render-pass /
     // lightmap registries above, NOT the handle/allocator pools: fonts are loaded
     // once and referenced by a stable id, not minted per-instance by the model).
-    // Each font bakes a TTF into one bindless atlas via the renderer's
-    // create_texture (see kryga_render_text.cpp). Owned here, not on the renderer.
-    // Independent of ImGui -> works in game builds.
+    // Each font is a dynamic SDF glyph cache (font_atlas) whose pages become
+    // bindless textures via the renderer's create_texture (see
+    // kryga_render_text.cpp). Owned here, not on the renderer. Independent of
+    // ImGui -> works in game builds.
     //
     // This is MECHANISM only: which fonts ship and which id is the default are
     // engine policy (see vulkan_engine::init_default_resources). The loader neither
     // bakes built-ins nor knows a "default" — it stores and resolves by id.
 
-    // Bake a TTF (read from ttf_path via the VFS) into a new atlas under `id`.
-    // bake_height is the rasterization size in px (the draw scales from it).
-    // Re-loading the same id replaces the atlas. Returns the baked font, or null
-    // on failure (missing file / pack error).
+    // Register a TTF (read from ttf_path via the VFS) as a glyph cache under `id`.
+    // bake_height is the SDF rasterization size in px (clamped to fit an atlas
+    // cell; every draw size scales from it). Re-loading the same id replaces the
+    // atlas. Returns the font, or null on failure (missing file / bad TTF).
     font_atlas*
     load_font(const kryga::utils::id& id, std::string_view ttf_path, float bake_height);
 
+    // Pump every font's glyph cache and upload the atlas pages that changed.
+    // [render thread, once per frame, before the UI batch refresh]
+    void
+    update_fonts();
+
     // Resolve a font by id, or null if no font is registered under it. The caller
-    // (draw_ui_text) skips entries whose font is missing. [render thread]
+    // (ui_batcher) parks entries whose font is missing. [render thread]
     font_atlas*
     get_font(const kryga::utils::id& id)
     {
         KRG_check_render_thread_dbg();
         auto itr = m_fonts.find(id);
-        return itr != m_fonts.end() ? &itr->second : nullptr;
+        return itr != m_fonts.end() ? itr->second.get() : nullptr;
     }
 
     /*************************/
@@ -762,7 +762,9 @@ private:
 
     std::unordered_map<kryga::utils::id, lightmap_binding> m_lightmaps{};
     ui_text_storage m_ui_texts{1};  // single lane (render_translator's content alloc)
-    std::unordered_map<kryga::utils::id, font_atlas> m_fonts{};  // id -> baked atlas
+    // id -> glyph cache (heap: the atlas owns a worker thread and is pointed at
+    // by retained UI layouts)
+    std::unordered_map<kryga::utils::id, std::unique_ptr<font_atlas>> m_fonts{};
 };
 
 }  // namespace render
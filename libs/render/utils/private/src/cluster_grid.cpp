@@ -1,13 +1,87 @@
 #include "render/utils/cluster_grid.h"
 
+#include <jobs/job_system.h>
+
 #include <algorithm>
+#include <bit>
 #include <limits>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define KRG_CLUSTER_GRID_SSE2 1
+#endif
+
 namespace kryga
 {
 namespace render
 {
 
+namespace
+{
+
+constexpr cluster_zbin k_empty_zbin{.min_light = std::numeric_limits<uint32_t>::max(),
+                                    .max_light = 0};
+
+// Sorted lights per rasterisation job
+constexpr uint32_t k_bits_per_word = 32;
+
+template <typename F>
+void
+visit_bits(uint32_t word_index, uint32_t bits, F& fn)
+{
+    for (; bits; bits &= bits - 1)
+    {
+        fn(word_index * k_bits_per_word + std::countr_zero(bits));
+    }
+}
+
+// Calls fn(bit) for every set bit of `words` in [first, last]. The edge words are
+// masked; the ones between are scanned four at a time and skipped when empty,
+// which most of them are.
+template <typename F>
+void
+for_each_set_bit(const uint32_t* words, uint32_t first, uint32_t last, F&& fn)
+{
+    const uint32_t first_word = first / k_bits_per_word;
+    const uint32_t last_word = last / k_bits_per_word;
+    const uint32_t first_mask = ~0u << (first % k_bits_per_word);
+    const uint32_t last_mask = ~0u >> (k_bits_per_word - 1 - last % k_bits_per_word);
+
+    if (first_word == last_word)
+    {
+        visit_bits(first_word, words[first_word] & first_mask & last_mask, fn);
+        return;
+    }
+
+    visit_bits(first_word, words[first_word] & first_mask, fn);
+
+    uint32_t w = first_word + 1;
+#if defined(KRG_CLUSTER_GRID_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; w + 4 <= last_word; w += 4)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + w));
+        const int empty = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, zero)));
+        if (empty == 0xF)
+        {
+            continue;
+        }
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            visit_bits(w + lane, words[w + lane], fn);
+        }
+    }
+#endif
+    for (; w < last_word; ++w)
+    {
+        visit_bits(w, words[w], fn);
+    }
+
+    visit_bits(last_word, words[last_word] & last_mask, fn);
+}
+
+}  // namespace
+
 void
 cluster_grid::init(uint32_t screen_width,
                    uint32_t screen_height,
@@ -29,6 +103,8 @@ cluster_grid::init(uint32_t screen_width,
     m_cluster_light_counts.resize(m_config.total_clusters, 0);
     m_cluster_light_indices.resize(m_config.total_clusters * m_config.max_lights_per_cluster, 0);
     m_cluster_aabbs.resize(m_config.total_clusters);
+    m_zbins.assign(m_config.depth_slices, k_empty_zbin);
+    m_slice_stats.resize(m_config.depth_slices);
 
     m_aabbs_dirty = true;
     m_initialized = true;
@@ -66,8 +142,14 @@ void
 cluster_grid::clear()
 {
     std::fill(m_cluster_light_counts.begin(), m_cluster_light_counts.end(), 0);
+    std::fill(m_zbins.begin(), m_zbins.end(), k_empty_zbin);
+    m_lights.clear();
+    m_sorted_slots.clear();
+    m_tile_masks.clear();
+    m_mask_words = 0;
     m_active_clusters = 0;
     m_total_light_assignments = 0;
+    m_truncated_clusters = 0;
 }
 
 float
@@ -184,19 +266,146 @@ cluster_grid::compute_cluster_aabb(uint32_t tile_x,
     return aabb;
 }
 
+void
+cluster_grid::parallel_for(uint32_t count, const std::function<void(uint32_t, uint32_t)>& fn) const
+{
+    if (m_jobs)
+    {
+        m_jobs->parallel_for(count, 1, fn, jobs::job_priority::high);
+        return;
+    }
+    fn(0, count);
+}
+
 bool
-cluster_grid::sphere_intersects_aabb(const glm::vec3& center,
-                                     float radius,
-                                     const cluster_aabb& aabb) const
+cluster_grid::compute_light_bounds(const cluster_light_info& light,
+                                   const glm::mat4& view,
+                                   const glm::mat4& projection,
+                                   light_bounds& out) const
+{
+    const glm::vec3 center = glm::vec3(view * glm::vec4(light.position, 1.0f));
+    const float depth = -center.z;  // Negate: OpenGL view space Z is negative forward
+
+    // Skip lights behind camera or beyond far plane
+    if (depth + light.radius < m_config.near_plane || depth - light.radius > m_config.far_plane)
+    {
+        return false;
+    }
+
+    const float near_depth = std::max(depth - light.radius, m_config.near_plane);
+    const float far_depth = depth + light.radius;
+
+    // Screen rectangle of the light's view-space box, cut at the near plane. Every
+    // corner is in front of the camera, so the projected corners bound the sphere.
+    glm::vec2 lo(std::numeric_limits<float>::max());
+    glm::vec2 hi(std::numeric_limits<float>::lowest());
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec4 p((corner & 1) ? center.x + light.radius : center.x - light.radius,
+                          (corner & 2) ? center.y + light.radius : center.y - light.radius,
+                          (corner & 4) ? -far_depth : -near_depth,
+                          1.0f);
+        const glm::vec4 clip = projection * p;
+        const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+        lo = glm::min(lo, ndc);
+        hi = glm::max(hi, ndc);
+    }
+
+    if (lo.x > 1.0f || lo.y > 1.0f || hi.x < -1.0f || hi.y < -1.0f)
+    {
+        return false;
+    }
+
+    // NDC to tiles, same mapping as screen_to_view
+    auto to_tile = [](float ndc, uint32_t screen, uint32_t tile_size, uint32_t tiles)
+    {
+        const float pixel = (std::clamp(ndc, -1.0f, 1.0f) + 1.0f) * 0.5f * float(screen);
+        return std::min(uint32_t(pixel) / tile_size, tiles - 1);
+    };
+
+    out.depth = depth;
+    out.slot = light.slot;
+    out.min_slice = depth_to_slice(near_depth);
+    out.max_slice = depth_to_slice(far_depth);
+    out.min_tile_x = to_tile(lo.x, m_config.screen_width, m_config.tile_size, m_config.tiles_x);
+    out.max_tile_x = to_tile(hi.x, m_config.screen_width, m_config.tile_size, m_config.tiles_x);
+    out.min_tile_y = to_tile(lo.y, m_config.screen_height, m_config.tile_size, m_config.tiles_y);
+    out.max_tile_y = to_tile(hi.y, m_config.screen_height, m_config.tile_size, m_config.tiles_y);
+    return true;
+}
+
+void
+cluster_grid::rasterize_word(uint32_t word)
+{
+    const uint32_t begin = word * k_bits_per_word;
+    const uint32_t end = std::min(begin + k_bits_per_word, uint32_t(m_lights.size()));
+
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        const auto& light = m_lights[i];
+        const uint32_t bit = 1u << (i - begin);
+
+        for (uint32_t tile_y = light.min_tile_y; tile_y <= light.max_tile_y; ++tile_y)
+        {
+            uint32_t* row = m_tile_masks.data() + tile_y * m_config.tiles_x * m_mask_words + word;
+            for (uint32_t tile_x = light.min_tile_x; tile_x <= light.max_tile_x; ++tile_x)
+            {
+                row[tile_x * m_mask_words] |= bit;
+            }
+        }
+    }
+}
+
+void
+cluster_grid::expand_slice(uint32_t slice)
 {
-    // Find closest point on AABB to sphere center
-    const glm::vec3 closest = glm::clamp(center, aabb.min_point, aabb.max_point);
+    auto& stats = m_slice_stats[slice];
+    stats = {};
+
+    const cluster_zbin bin = m_zbins[slice];
+    if (bin.min_light > bin.max_light)
+    {
+        return;
+    }
 
-    // Check if distance to closest point is within radius
-    const glm::vec3 diff = center - closest;
-    const float dist_sq = glm::dot(diff, diff);
+    const uint32_t tile_count = m_config.tiles_x * m_config.tiles_y;
+    const uint32_t cap = m_config.max_lights_per_cluster;
 
-    return dist_sq <= (radius * radius);
+    for (uint32_t tile = 0; tile < tile_count; ++tile)
+    {
+        const uint32_t cluster_idx = slice * tile_count + tile;
+        uint32_t* list = m_cluster_light_indices.data() + cluster_idx * cap;
+        uint32_t count = 0;
+
+        // The bin is a range of the depth order, so it may hold lights that skip
+        // this slice; their own slice range settles it
+        for_each_set_bit(m_tile_masks.data() + tile * m_mask_words,
+                         bin.min_light,
+                         bin.max_light,
+                         [&](uint32_t i)
+                         {
+                             const auto& light = m_lights[i];
+                             if (slice < light.min_slice || slice > light.max_slice)
+                             {
+                                 return;
+                             }
+                             if (count < cap)
+                             {
+                                 list[count] = light.slot;
+                             }
+                             ++count;
+                         });
+
+        if (count == 0)
+        {
+            continue;
+        }
+
+        m_cluster_light_counts[cluster_idx] = std::min(count, cap);
+        stats.active += 1;
+        stats.assignments += std::min(count, cap);
+        stats.truncated += count > cap ? 1 : 0;
+    }
 }
 
 void
@@ -228,66 +437,71 @@ cluster_grid::build_clusters(const glm::mat4& view,
         m_aabbs_dirty = false;
     }
 
-    // Assign each light to overlapping clusters
+    // Bounds of the visible lights, in view-depth order
+    m_lights.reserve(lights.size());
     for (const auto& light : lights)
     {
-        // Transform light position to view space
-        const glm::vec4 view_pos = view * glm::vec4(light.position, 1.0f);
-        const glm::vec3 light_view_pos = glm::vec3(view_pos);
-        const float light_depth =
-            -light_view_pos.z;  // Negate: OpenGL view space Z is negative forward
-
-        // Skip lights behind camera or beyond far plane
-        if (light_depth + light.radius < m_config.near_plane)
+        light_bounds bounds;
+        if (compute_light_bounds(light, view, projection, bounds))
         {
-            continue;
+            m_lights.push_back(bounds);
         }
+    }
 
-        if (light_depth - light.radius > m_config.far_plane)
-        {
-            continue;
-        }
+    if (m_lights.empty())
+    {
+        return;
+    }
 
-        // Find depth slice range this light can affect
-        const uint32_t min_slice =
-            depth_to_slice(std::max(light_depth - light.radius, m_config.near_plane));
-        const uint32_t max_slice =
-            std::min(depth_to_slice(light_depth + light.radius) + 1, m_config.depth_slices);
+    std::sort(m_lights.begin(),
+              m_lights.end(),
+              [](const light_bounds& a, const light_bounds& b) { return a.depth < b.depth; });
 
-        // Light position with corrected Z for AABB test (AABBs use positive Z forward)
-        const glm::vec3 light_view_pos_corrected(light_view_pos.x, light_view_pos.y, light_depth);
+    const auto light_count = static_cast<uint32_t>(m_lights.size());
+    m_sorted_slots.resize(light_count);
 
-        // For each potentially affected cluster, do precise intersection test
-        for (uint32_t slice = min_slice; slice < max_slice; ++slice)
+    // Z-bins: every slice a light covers widens that slice's range to include it
+    for (uint32_t i = 0; i < light_count; ++i)
+    {
+        const auto& light = m_lights[i];
+        m_sorted_slots[i] = light.slot;
+        for (uint32_t slice = light.min_slice; slice <= light.max_slice; ++slice)
         {
-            for (uint32_t tile_y = 0; tile_y < m_config.tiles_y; ++tile_y)
-            {
-                for (uint32_t tile_x = 0; tile_x < m_config.tiles_x; ++tile_x)
-                {
-                    const uint32_t cluster_idx = get_cluster_index(tile_x, tile_y, slice);
-                    const cluster_aabb& aabb = m_cluster_aabbs[cluster_idx];
-
-                    if (sphere_intersects_aabb(light_view_pos_corrected, light.radius, aabb))
-                    {
-                        uint32_t& count = m_cluster_light_counts[cluster_idx];
-                        if (count < m_config.max_lights_per_cluster)
-                        {
-                            const uint32_t light_list_idx =
-                                cluster_idx * m_config.max_lights_per_cluster + count;
-                            m_cluster_light_indices[light_list_idx] = light.slot;
-                            ++count;
-                            ++m_total_light_assignments;
-
-                            if (count == 1)
-                            {
-                                ++m_active_clusters;
-                            }
-                        }
-                    }
-                }
-            }
+            auto& bin = m_zbins[slice];
+            bin.min_light = std::min(bin.min_light, i);
+            bin.max_light = std::max(bin.max_light, i);
         }
     }
+
+    // Tile masks: each job owns one word of every tile, so the writes never overlap
+    m_mask_words = (light_count + k_bits_per_word - 1) / k_bits_per_word;
+    m_tile_masks.assign(size_t(m_config.tiles_x) * m_config.tiles_y * m_mask_words, 0);
+
+    parallel_for(m_mask_words,
+                 [this](uint32_t begin, uint32_t end)
+                 {
+                     for (uint32_t word = begin; word < end; ++word)
+                     {
+                         rasterize_word(word);
+                     }
+                 });
+
+    // Flat per-cluster lists, one slice per job
+    parallel_for(m_config.depth_slices,
+                 [this](uint32_t begin, uint32_t end)
+                 {
+                     for (uint32_t slice = begin; slice < end; ++slice)
+                     {
+                         expand_slice(slice);
+                     }
+                 });
+
+    for (const auto& stats : m_slice_stats)
+    {
+        m_active_clusters += stats.active;
+        m_total_light_assignments += stats.assignments;
+        m_truncated_clusters += stats.truncated;
+    }
 }
 
 }  // namespace render
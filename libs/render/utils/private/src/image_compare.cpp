@@ -3,8 +3,20 @@
 #include <stb_unofficial/stb.h>
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cmath>
 #include <cstring>
+#include <thread>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define KRG_IMAGE_COMPARE_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define KRG_IMAGE_COMPARE_SSE2 1
+#endif
 
 namespace kryga::render
 {
@@ -12,129 +24,461 @@ namespace kryga::render
 namespace
 {
 
+// SSIM constants for 8-bit images
+constexpr float C1 = (0.01f * 255.0f) * (0.01f * 255.0f);
+constexpr float C2 = (0.03f * 255.0f) * (0.03f * 255.0f);
+
+constexpr float k_luma_r = 0.299f;
+constexpr float k_luma_g = 0.587f;
+constexpr float k_luma_b = 0.114f;
+
+// Pixel rows per work unit when no heatmap tile dictates the band height
+constexpr uint32_t k_band_rows = 16;
+
+// SSIM work units span about this many pixel rows of windows
+constexpr uint32_t k_ssim_band_rows = 64;
+
+// Diff image colour of a matching pixel: {0, 128, 0, 255}
+constexpr uint32_t k_match_rgba = 0xFF008000u;
+
 float
 to_luminance(uint8_t r, uint8_t g, uint8_t b)
 {
-    return 0.299f * r + 0.587f * g + 0.114f * b;
+    return k_luma_r * r + k_luma_g * g + k_luma_b * b;
 }
 
-// SSIM constants for 8-bit images
-constexpr float C1 = (0.01f * 255.0f) * (0.01f * 255.0f);
-constexpr float C2 = (0.03f * 255.0f) * (0.03f * 255.0f);
+uint32_t
+resolve_threads(uint32_t requested, uint32_t units)
+{
+    const uint32_t n = requested ? requested : std::max(1u, std::thread::hardware_concurrency());
+    return std::max(1u, std::min(n, units));
+}
+
+// Runs fn(unit, worker) for every unit in [0, count), handed out one at a time
+template <typename F>
+void
+parallel_for(uint32_t count, uint32_t threads, F&& fn)
+{
+    if (threads <= 1)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            fn(i, 0u);
+        }
+        return;
+    }
 
-constexpr uint32_t SSIM_WINDOW = 8;
+    std::atomic<uint32_t> next{0};
+    auto worker = [&](uint32_t w)
+    {
+        for (uint32_t i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+        {
+            fn(i, w);
+        }
+    };
 
-}  // namespace
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (uint32_t w = 1; w < threads; ++w)
+    {
+        pool.emplace_back(worker, w);
+    }
+    worker(0);
+    for (auto& t : pool)
+    {
+        t.join();
+    }
+}
 
-float
-compute_ssim(const uint8_t* img_a, const uint8_t* img_b, uint32_t width, uint32_t height)
+// --- Per-pixel kernels ---
+
+void
+luminance_row(const uint8_t* rgba, float* out, uint32_t n)
 {
-    if (width < SSIM_WINDOW || height < SSIM_WINDOW)
+    uint32_t i = 0;
+#if defined(KRG_IMAGE_COMPARE_AVX2)
     {
-        return 1.0f;
+        const __m256i mask = _mm256_set1_epi32(0xFF);
+        const __m256 kr = _mm256_set1_ps(k_luma_r);
+        const __m256 kg = _mm256_set1_ps(k_luma_g);
+        const __m256 kb = _mm256_set1_ps(k_luma_b);
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rgba + i * 4));
+            const __m256 r = _mm256_cvtepi32_ps(_mm256_and_si256(v, mask));
+            const __m256 g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, 8), mask));
+            const __m256 b = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, 16), mask));
+            const __m256 l = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(kr, r), _mm256_mul_ps(kg, g)), _mm256_mul_ps(kb, b));
+            _mm256_storeu_ps(out + i, l);
+        }
     }
+#endif
+#if defined(KRG_IMAGE_COMPARE_SSE2)
+    {
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        const __m128 kr = _mm_set1_ps(k_luma_r);
+        const __m128 kg = _mm_set1_ps(k_luma_g);
+        const __m128 kb = _mm_set1_ps(k_luma_b);
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + i * 4));
+            const __m128 r = _mm_cvtepi32_ps(_mm_and_si128(v, mask));
+            const __m128 g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 8), mask));
+            const __m128 b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 16), mask));
+            const __m128 l =
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(kr, r), _mm_mul_ps(kg, g)), _mm_mul_ps(kb, b));
+            _mm_storeu_ps(out + i, l);
+        }
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        const uint8_t* p = rgba + i * 4;
+        out[i] = to_luminance(p[0], p[1], p[2]);
+    }
+}
 
-    uint32_t windows_x = width / SSIM_WINDOW;
-    uint32_t windows_y = height / SSIM_WINDOW;
-    double total_ssim = 0.0;
-    uint32_t window_count = 0;
+// Compares one pixel; writes its diff image colour when `diff` is set
+bool
+diff_pixel(const uint8_t* a, const uint8_t* b, uint8_t tolerance, uint8_t* diff)
+{
+    int sum = 0;
+    bool match = true;
+    for (int c = 0; c < 4; ++c)
+    {
+        const int d = std::abs(static_cast<int>(a[c]) - static_cast<int>(b[c]));
+        match = match && d <= tolerance;
+        sum += d;
+    }
 
-    for (uint32_t wy = 0; wy < windows_y; ++wy)
+    if (diff)
     {
-        for (uint32_t wx = 0; wx < windows_x; ++wx)
+        if (match)
+        {
+            std::memcpy(diff, &k_match_rgba, 4);
+        }
+        else
         {
-            float mean_a = 0.0f;
-            float mean_b = 0.0f;
+            const auto magnitude = static_cast<uint8_t>(std::min(255, sum * 4));
+            diff[0] = std::max(magnitude, uint8_t(128));
+            diff[1] = 0;
+            diff[2] = 0;
+            diff[3] = 255;
+        }
+    }
+    return match;
+}
 
-            for (uint32_t py = 0; py < SSIM_WINDOW; ++py)
+// Compares `n` pixels and returns how many exceed the tolerance. The vector paths
+// only classify; mismatches (rare on a passing image) take the scalar path for
+// their diff colour.
+uint32_t
+diff_row(const uint8_t* a, const uint8_t* b, uint32_t n, uint8_t tolerance, uint8_t* diff)
+{
+    uint32_t mismatches = 0;
+    uint32_t i = 0;
+#if defined(KRG_IMAGE_COMPARE_AVX2)
+    {
+        const __m256i tol = _mm256_set1_epi8(static_cast<char>(tolerance));
+        const __m256i green = _mm256_set1_epi32(static_cast<int>(k_match_rgba));
+        const __m256i zero = _mm256_setzero_si256();
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i * 4));
+            const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i * 4));
+            const __m256i ad = _mm256_or_si256(_mm256_subs_epu8(va, vb), _mm256_subs_epu8(vb, va));
+            const __m256i ok = _mm256_cmpeq_epi32(_mm256_subs_epu8(ad, tol), zero);
+            const uint32_t bits =
+                static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(ok)));
+            mismatches += 8 - std::popcount(bits);
+
+            if (diff)
             {
-                for (uint32_t px = 0; px < SSIM_WINDOW; ++px)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(diff + i * 4), green);
+                for (uint32_t m = ~bits & 0xFFu; m; m &= m - 1)
                 {
-                    uint32_t idx = ((wy * SSIM_WINDOW + py) * width + (wx * SSIM_WINDOW + px)) * 4;
-                    mean_a += to_luminance(img_a[idx], img_a[idx + 1], img_a[idx + 2]);
-                    mean_b += to_luminance(img_b[idx], img_b[idx + 1], img_b[idx + 2]);
+                    const uint32_t k = (i + std::countr_zero(m)) * 4;
+                    diff_pixel(a + k, b + k, tolerance, diff + k);
                 }
             }
-
-            constexpr float n = SSIM_WINDOW * SSIM_WINDOW;
-            mean_a /= n;
-            mean_b /= n;
-
-            float var_a = 0.0f;
-            float var_b = 0.0f;
-            float covar = 0.0f;
-
-            for (uint32_t py = 0; py < SSIM_WINDOW; ++py)
+        }
+    }
+#endif
+#if defined(KRG_IMAGE_COMPARE_SSE2)
+    {
+        const __m128i tol = _mm_set1_epi8(static_cast<char>(tolerance));
+        const __m128i green = _mm_set1_epi32(static_cast<int>(k_match_rgba));
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i * 4));
+            const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i * 4));
+            const __m128i ad = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+            const __m128i ok = _mm_cmpeq_epi32(_mm_subs_epu8(ad, tol), zero);
+            const uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(ok)));
+            mismatches += 4 - std::popcount(bits);
+
+            if (diff)
             {
-                for (uint32_t px = 0; px < SSIM_WINDOW; ++px)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(diff + i * 4), green);
+                for (uint32_t m = ~bits & 0xFu; m; m &= m - 1)
                 {
-                    uint32_t idx = ((wy * SSIM_WINDOW + py) * width + (wx * SSIM_WINDOW + px)) * 4;
-                    float la = to_luminance(img_a[idx], img_a[idx + 1], img_a[idx + 2]) - mean_a;
-                    float lb = to_luminance(img_b[idx], img_b[idx + 1], img_b[idx + 2]) - mean_b;
-                    var_a += la * la;
-                    var_b += lb * lb;
-                    covar += la * lb;
+                    const uint32_t k = (i + std::countr_zero(m)) * 4;
+                    diff_pixel(a + k, b + k, tolerance, diff + k);
                 }
             }
+        }
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        const uint32_t k = i * 4;
+        mismatches += diff_pixel(a + k, b + k, tolerance, diff ? diff + k : nullptr) ? 0 : 1;
+    }
+    return mismatches;
+}
 
-            var_a /= (n - 1.0f);
-            var_b /= (n - 1.0f);
-            covar /= (n - 1.0f);
+// --- SSIM ---
 
-            float numerator = (2.0f * mean_a * mean_b + C1) * (2.0f * covar + C2);
-            float denominator = (mean_a * mean_a + mean_b * mean_b + C1) * (var_a + var_b + C2);
+// Window sums of the luminance moments SSIM needs
+struct moments
+{
+    double a = 0.0, b = 0.0, aa = 0.0, bb = 0.0, ab = 0.0;
 
-            total_ssim += numerator / denominator;
-            ++window_count;
-        }
+    moments
+    operator+(const moments& o) const
+    {
+        return {a + o.a, b + o.b, aa + o.aa, bb + o.bb, ab + o.ab};
     }
 
-    return window_count > 0 ? static_cast<float>(total_ssim / window_count) : 1.0f;
+    moments
+    operator-(const moments& o) const
+    {
+        return {a - o.a, b - o.b, aa - o.aa, bb - o.bb, ab - o.ab};
+    }
+};
+
+double
+ssim_of(const moments& s)
+{
+    constexpr double n = k_ssim_window * k_ssim_window;
+    const double mean_a = s.a / n;
+    const double mean_b = s.b / n;
+    const double var_a = (s.aa - s.a * mean_a) / (n - 1.0);
+    const double var_b = (s.bb - s.b * mean_b) / (n - 1.0);
+    const double covar = (s.ab - s.a * mean_b) / (n - 1.0);
+
+    const double numerator = (2.0 * mean_a * mean_b + C1) * (2.0 * covar + C2);
+    const double denominator = (mean_a * mean_a + mean_b * mean_b + C1) * (var_a + var_b + C2);
+    return numerator / denominator;
+}
+
+}  // namespace
+
+float
+compute_ssim(const uint8_t* img_a,
+             const uint8_t* img_b,
+             uint32_t width,
+             uint32_t height,
+             uint32_t stride,
+             uint32_t thread_count)
+{
+    if (width < k_ssim_window || height < k_ssim_window)
+    {
+        return 1.0f;
+    }
+
+    stride = std::max(1u, stride);
+    const uint32_t windows_x = (width - k_ssim_window) / stride + 1;
+    const uint32_t windows_y = (height - k_ssim_window) / stride + 1;
+
+    // Luminance planes, one row per unit
+    std::vector<float> luma_a(size_t(width) * height);
+    std::vector<float> luma_b(size_t(width) * height);
+    const uint32_t row_threads = resolve_threads(thread_count, height / k_band_rows + 1);
+    parallel_for(height,
+                 row_threads,
+                 [&](uint32_t y, uint32_t)
+                 {
+                     const size_t off = size_t(y) * width;
+                     luminance_row(img_a + off * 4, luma_a.data() + off, width);
+                     luminance_row(img_b + off * 4, luma_b.data() + off, width);
+                 });
+
+    // Bands of window rows. Within a band, `col` holds each column's moments over
+    // the current window row's k_ssim_window pixel rows, slid down by adding the
+    // rows entering and subtracting those leaving; its prefix along x is that
+    // window row of the summed-area table, so every window costs O(1) however
+    // much the windows overlap.
+    const uint32_t band_windows = std::max(1u, k_ssim_band_rows / stride);
+    const uint32_t bands = (windows_y + band_windows - 1) / band_windows;
+    const uint32_t threads = resolve_threads(thread_count, bands);
+
+    struct band_scratch
+    {
+        std::vector<moments> col;
+        std::vector<moments> prefix;
+    };
+    std::vector<band_scratch> scratch(threads);
+    std::vector<double> band_sum(bands, 0.0);
+
+    auto accumulate_row = [&](std::vector<moments>& col, uint32_t y, double sign)
+    {
+        const float* la = luma_a.data() + size_t(y) * width;
+        const float* lb = luma_b.data() + size_t(y) * width;
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            const double a = la[x];
+            const double b = lb[x];
+            auto& c = col[x];
+            c.a += sign * a;
+            c.b += sign * b;
+            c.aa += sign * (a * a);
+            c.bb += sign * (b * b);
+            c.ab += sign * (a * b);
+        }
+    };
+
+    parallel_for(
+        bands,
+        threads,
+        [&](uint32_t band, uint32_t worker)
+        {
+            auto& [col, prefix] = scratch[worker];
+            prefix.resize(size_t(width) + 1);
+
+            const uint32_t wy0 = band * band_windows;
+            const uint32_t wy1 = std::min(windows_y, wy0 + band_windows);
+
+            double sum = 0.0;
+            for (uint32_t wy = wy0; wy < wy1; ++wy)
+            {
+                const uint32_t y = wy * stride;
+                if (wy == wy0 || stride >= k_ssim_window)
+                {
+                    col.assign(width, moments{});
+                    for (uint32_t r = y; r < y + k_ssim_window; ++r)
+                    {
+                        accumulate_row(col, r, 1.0);
+                    }
+                }
+                else
+                {
+                    for (uint32_t r = y - stride; r < y; ++r)
+                    {
+                        accumulate_row(col, r, -1.0);
+                        accumulate_row(col, r + k_ssim_window, 1.0);
+                    }
+                }
+
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    prefix[x + 1] = prefix[x] + col[x];
+                }
+                for (uint32_t wx = 0; wx < windows_x; ++wx)
+                {
+                    const uint32_t x0 = wx * stride;
+                    sum += ssim_of(prefix[x0 + k_ssim_window] - prefix[x0]);
+                }
+            }
+            band_sum[band] = sum;
+        });
+
+    double total = 0.0;
+    for (double s : band_sum)
+    {
+        total += s;
+    }
+    return static_cast<float>(total / (double(windows_x) * windows_y));
 }
 
 image_compare_result
 compare_images(const uint8_t* actual, const uint8_t* expected, const image_compare_params& params)
 {
     image_compare_result result;
-    result.total_pixels = params.width * params.height;
+    const uint32_t width = params.width;
+    const uint32_t height = params.height;
+    result.total_pixels = width * height;
 
     if (params.generate_diff_image)
     {
-        result.diff_image.resize(result.total_pixels * 4);
+        result.diff_image.resize(size_t(result.total_pixels) * 4);
     }
 
-    for (uint32_t i = 0; i < result.total_pixels; ++i)
-    {
-        uint32_t idx = i * 4;
-        int dr = std::abs(static_cast<int>(actual[idx]) - static_cast<int>(expected[idx]));
-        int dg = std::abs(static_cast<int>(actual[idx + 1]) - static_cast<int>(expected[idx + 1]));
-        int db = std::abs(static_cast<int>(actual[idx + 2]) - static_cast<int>(expected[idx + 2]));
-        int da = std::abs(static_cast<int>(actual[idx + 3]) - static_cast<int>(expected[idx + 3]));
+    // Bands are one heatmap tile tall, so each writes only its own tile row
+    const uint32_t tile = params.heatmap_tile;
+    const uint32_t band_rows = tile ? tile : k_band_rows;
+    const uint32_t bands = height ? (height + band_rows - 1) / band_rows : 0;
+    const uint32_t tiles_x = tile ? (width + tile - 1) / tile : 0;
 
-        bool match = dr <= params.pixel_tolerance && dg <= params.pixel_tolerance &&
-                     db <= params.pixel_tolerance && da <= params.pixel_tolerance;
+    std::vector<uint32_t> tile_counts(size_t(tiles_x) * bands, 0);
+    std::vector<uint32_t> band_counts(bands, 0);
 
-        if (!match)
+    parallel_for(
+        bands,
+        resolve_threads(params.thread_count, bands),
+        [&](uint32_t band, uint32_t)
         {
-            ++result.diff_pixel_count;
-        }
+            const uint32_t y0 = band * band_rows;
+            const uint32_t y1 = std::min(height, y0 + band_rows);
+            uint32_t* tiles = tile_counts.data() + size_t(band) * tiles_x;
 
-        if (params.generate_diff_image)
-        {
-            uint8_t magnitude = static_cast<uint8_t>(std::min(255, (dr + dg + db + da) * 4));
-            if (match)
+            uint32_t count = 0;
+            for (uint32_t y = y0; y < y1; ++y)
             {
-                result.diff_image[idx] = 0;
-                result.diff_image[idx + 1] = 128;
-                result.diff_image[idx + 2] = 0;
-                result.diff_image[idx + 3] = 255;
+                const size_t row = size_t(y) * width * 4;
+                uint8_t* diff = params.generate_diff_image ? result.diff_image.data() + row
+                                                           : nullptr;
+                if (!tile)
+                {
+                    count += diff_row(
+                        actual + row, expected + row, width, params.pixel_tolerance, diff);
+                    continue;
+                }
+
+                for (uint32_t tx = 0; tx < tiles_x; ++tx)
+                {
+                    const uint32_t x0 = tx * tile;
+                    const size_t off = row + size_t(x0) * 4;
+                    const uint32_t n = diff_row(actual + off,
+                                                expected + off,
+                                                std::min(tile, width - x0),
+                                                params.pixel_tolerance,
+                                                diff ? diff + size_t(x0) * 4 : nullptr);
+                    tiles[tx] += n;
+                    count += n;
+                }
             }
-            else
+            band_counts[band] = count;
+        });
+
+    for (uint32_t c : band_counts)
+    {
+        result.diff_pixel_count += c;
+    }
+
+    if (tile && bands)
+    {
+        result.heatmap_tiles_x = tiles_x;
+        result.heatmap_tiles_y = bands;
+        result.heatmap.resize(tile_counts.size());
+
+        uint32_t worst = 0;
+        for (uint32_t ty = 0; ty < bands; ++ty)
+        {
+            const uint32_t th = std::min(tile, height - ty * tile);
+            for (uint32_t tx = 0; tx < tiles_x; ++tx)
             {
-                result.diff_image[idx] = std::max(magnitude, uint8_t(128));
-                result.diff_image[idx + 1] = 0;
-                result.diff_image[idx + 2] = 0;
-                result.diff_image[idx + 3] = 255;
+                const size_t i = size_t(ty) * tiles_x + tx;
+                const uint32_t tw = std::min(tile, width - tx * tile);
+                result.heatmap[i] = static_cast<float>(tile_counts[i]) / float(tw * th);
+                if (tile_counts[i] > worst)
+                {
+                    worst = tile_counts[i];
+                    result.worst_tile_x = tx;
+                    result.worst_tile_y = ty;
+                }
             }
         }
     }
@@ -144,7 +488,8 @@ compare_images(const uint8_t* actual, const uint8_t* expected, const image_compa
             ? (static_cast<float>(result.diff_pixel_count) / result.total_pixels) * 100.0f
             : 0.0f;
 
-    result.ssim = compute_ssim(actual, expected, params.width, params.height);
+    result.ssim =
+        compute_ssim(actual, expected, width, height, k_ssim_window, params.thread_count);
 
     result.pixel_passed = (result.diff_pixel_count == 0);
     result.ssim_passed = (result.ssim >= params.ssim_threshold);
@@ -152,6 +497,38 @@ compare_images(const uint8_t* actual, const uint8_t* expected, const image_compa
     return result;
 }
 
+std::vector<uint8_t>
+render_heatmap(const image_compare_result& result, uint32_t width, uint32_t height)
+{
+    if (result.heatmap.empty() || width == 0 || height == 0)
+    {
+        return {};
+    }
+
+    const uint32_t tile_w = (width + result.heatmap_tiles_x - 1) / result.heatmap_tiles_x;
+    const uint32_t tile_h = (height + result.heatmap_tiles_y - 1) / result.heatmap_tiles_y;
+
+    std::vector<uint8_t> out(size_t(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        const uint32_t ty = std::min(y / tile_h, result.heatmap_tiles_y - 1);
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            const uint32_t tx = std::min(x / tile_w, result.heatmap_tiles_x - 1);
+            const float v = result.heatmap[size_t(ty) * result.heatmap_tiles_x + tx];
+
+            // sqrt lifts a stray pixel or two out of the black
+            const float t = v > 0.0f ? 0.25f + 0.75f * std::sqrt(std::min(v, 1.0f)) : 0.0f;
+            uint8_t* p = out.data() + (size_t(y) * width + x) * 4;
+            p[0] = static_cast<uint8_t>(255.0f * std::min(1.0f, 2.0f * t));
+            p[1] = static_cast<uint8_t>(255.0f * std::max(0.0f, 2.0f * t - 1.0f));
+            p[2] = 0;
+            p[3] = 255;
+        }
+    }
+    return out;
+}
+
 std::vector<uint8_t>
 load_png(const std::string& path, uint32_t& width, uint32_t& height)
 {
@@ -4,6 +4,9 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <gpu_types/gpu_generic_constants.h>
+#include <jobs/job_system.h>
+
+#include <algorithm>
 
 using namespace kryga::render;
 
@@ -1060,3 +1063,149 @@ TEST(ClusterGrid, far_aabb_extents)
                   << aabb.max_point.z << ")" << std::endl;
     }
 }
+
+// ============================================================================
+// Z-bin / tile bitmask tests
+// ============================================================================
+
+namespace
+{
+
+// Lights of a cluster as a shader reads the compact format: tile mask within the
+// slice's bin. May hold more than the flat list: the bin is a range of depth order.
+std::vector<uint32_t>
+decode_bitmask_lights(const cluster_grid& grid, uint32_t tile_x, uint32_t tile_y, uint32_t slice)
+{
+    const auto& config = grid.get_config();
+    const auto& bin = grid.get_zbins()[slice];
+    const uint32_t words = grid.get_tile_mask_words();
+    const uint32_t tile = tile_y * config.tiles_x + tile_x;
+    const uint32_t* mask = grid.get_tile_masks().data() + tile * words;
+
+    std::vector<uint32_t> slots;
+    for (uint32_t i = bin.min_light; i <= bin.max_light && i < words * 32; ++i)
+    {
+        if (mask[i / 32] & (1u << (i % 32)))
+        {
+            slots.push_back(grid.get_sorted_light_slots()[i]);
+        }
+    }
+    return slots;
+}
+
+std::vector<cluster_light_info>
+make_light_field(uint32_t count)
+{
+    std::vector<cluster_light_info> lights;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float x = float(int(i % 7) - 3) * 15.0f;
+        const float y = float(int(i % 5) - 2) * 10.0f;
+        const float z = -60.0f - float(i) * 9.0f;
+        lights.push_back({.slot = 1000 + i, .position = glm::vec3(x, y, z), .radius = 12.0f});
+    }
+    return lights;
+}
+
+}  // namespace
+
+TEST(ClusterGrid, bitmask_format_covers_cluster_lists)
+{
+    cluster_grid grid;
+    grid.init(800, 600, 0.1f, KGPU_zfar, 64, 24, 128);
+
+    const auto& config = grid.get_config();
+
+    glm::mat4 view = glm::lookAt(
+        glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 proj = make_vulkan_projection(60.0f, 800.0f / 600.0f, KGPU_znear, KGPU_zfar);
+
+    auto lights = make_light_field(70);
+    grid.build_clusters(view, proj, glm::inverse(proj), lights);
+
+    // Sorted by view depth; the field recedes with the slot
+    const auto& sorted = grid.get_sorted_light_slots();
+    ASSERT_EQ(sorted.size(), lights.size());
+    EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+    EXPECT_EQ(grid.get_tile_mask_words(), 3u);
+
+    const auto& counts = grid.get_cluster_light_counts();
+    const auto& indices = grid.get_cluster_light_indices();
+    for (uint32_t slice = 0; slice < config.depth_slices; ++slice)
+    {
+        for (uint32_t tile_y = 0; tile_y < config.tiles_y; ++tile_y)
+        {
+            for (uint32_t tile_x = 0; tile_x < config.tiles_x; ++tile_x)
+            {
+                const uint32_t idx = grid.get_cluster_index(tile_x, tile_y, slice);
+                const auto decoded = decode_bitmask_lights(grid, tile_x, tile_y, slice);
+                for (uint32_t i = 0; i < counts[idx]; ++i)
+                {
+                    const uint32_t slot = indices[idx * config.max_lights_per_cluster + i];
+                    EXPECT_NE(std::find(decoded.begin(), decoded.end(), slot), decoded.end())
+                        << "slot " << slot << " missing from cluster " << idx;
+                }
+            }
+        }
+    }
+    EXPECT_EQ(grid.get_truncated_clusters(), 0u);
+
+    grid.clear();
+    EXPECT_TRUE(grid.get_sorted_light_slots().empty());
+    EXPECT_EQ(grid.get_tile_mask_words(), 0u);
+}
+
+TEST(ClusterGrid, bitmask_format_has_no_light_cap)
+{
+    cluster_grid grid;
+    grid.init(800, 600, 0.1f, 1000.0f, 64, 24, 8);
+
+    const auto& config = grid.get_config();
+
+    glm::mat4 view = glm::lookAt(
+        glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 proj = make_vulkan_projection(60.0f, 800.0f / 600.0f, 0.1f, 1000.0f);
+
+    // Forty overlapping lights in front of the camera, five times the flat cap
+    std::vector<cluster_light_info> lights;
+    for (uint32_t i = 0; i < 40; ++i)
+    {
+        lights.push_back({.slot = i, .position = glm::vec3(0.0f, 0.0f, -30.0f), .radius = 4.0f});
+    }
+    grid.build_clusters(view, proj, glm::inverse(proj), lights);
+
+    const uint32_t slice = grid.get_depth_slice(30.0f);
+    const uint32_t tile_x = 400 / config.tile_size;
+    const uint32_t tile_y = 300 / config.tile_size;
+    const uint32_t idx = grid.get_cluster_index(tile_x, tile_y, slice);
+
+    EXPECT_EQ(grid.get_cluster_light_counts()[idx], 8u);
+    EXPECT_GT(grid.get_truncated_clusters(), 0u);
+    EXPECT_EQ(decode_bitmask_lights(grid, tile_x, tile_y, slice).size(), 40u);
+}
+
+TEST(ClusterGrid, job_system_build_matches_serial)
+{
+    glm::mat4 view = glm::lookAt(
+        glm::vec3(0.0f, 10.0f, 40.0f), glm::vec3(0.0f, 0.0f, -200.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 proj = make_vulkan_projection(60.0f, 800.0f / 600.0f, KGPU_znear, KGPU_zfar);
+    auto lights = make_light_field(200);
+
+    cluster_grid serial;
+    serial.init(800, 600, 0.1f, KGPU_zfar, 64, 24, 32);
+    serial.build_clusters(view, proj, glm::inverse(proj), lights);
+
+    kryga::jobs::job_system js;
+    js.start(3);
+
+    cluster_grid threaded;
+    threaded.init(800, 600, 0.1f, KGPU_zfar, 64, 24, 32);
+    threaded.set_job_system(&js);
+    threaded.build_clusters(view, proj, glm::inverse(proj), lights);
+
+    EXPECT_GT(serial.get_total_light_assignments(), 0u);
+    EXPECT_EQ(threaded.get_cluster_light_counts(), serial.get_cluster_light_counts());
+    EXPECT_EQ(threaded.get_cluster_light_indices(), serial.get_cluster_light_indices());
+    EXPECT_EQ(threaded.get_tile_masks(), serial.get_tile_masks());
+    EXPECT_EQ(threaded.get_active_clusters(), serial.get_active_clusters());
+}
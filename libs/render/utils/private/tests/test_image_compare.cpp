@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+
+#include <render/utils/image_compare.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+using namespace kryga::render;
+
+namespace
+{
+
+std::vector<uint8_t>
+make_image(uint32_t w, uint32_t h, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> img(size_t(w) * h * 4);
+    for (uint32_t y = 0; y < h; ++y)
+    {
+        for (uint32_t x = 0; x < w; ++x)
+        {
+            uint8_t* p = img.data() + (size_t(y) * w + x) * 4;
+            // Smooth gradient plus a little noise, so SSIM windows have structure
+            p[0] = uint8_t((x * 3 + rng() % 8) & 0xFF);
+            p[1] = uint8_t((y * 5 + rng() % 8) & 0xFF);
+            p[2] = uint8_t(((x + y) * 2) & 0xFF);
+            p[3] = 255;
+        }
+    }
+    return img;
+}
+
+void
+perturb(std::vector<uint8_t>& img, uint32_t seed, uint32_t every)
+{
+    std::mt19937 rng(seed);
+    for (size_t i = 0; i < img.size(); i += 4 * every)
+    {
+        img[i + rng() % 4] += uint8_t(1 + rng() % 40);
+    }
+}
+
+// Straightforward per-window SSIM over luminance, windows every `stride` pixels
+double
+reference_ssim(const std::vector<uint8_t>& a,
+               const std::vector<uint8_t>& b,
+               uint32_t w,
+               uint32_t h,
+               uint32_t stride)
+{
+    auto luma = [&](const std::vector<uint8_t>& img, uint32_t x, uint32_t y)
+    {
+        const uint8_t* p = img.data() + (size_t(y) * w + x) * 4;
+        return double(0.299f * p[0] + 0.587f * p[1] + 0.114f * p[2]);
+    };
+
+    constexpr double c1 = (0.01 * 255.0) * (0.01 * 255.0);
+    constexpr double c2 = (0.03 * 255.0) * (0.03 * 255.0);
+    constexpr double n = k_ssim_window * k_ssim_window;
+
+    double total = 0.0;
+    uint32_t count = 0;
+    for (uint32_t y0 = 0; y0 + k_ssim_window <= h; y0 += stride)
+    {
+        for (uint32_t x0 = 0; x0 + k_ssim_window <= w; x0 += stride)
+        {
+            double ma = 0.0, mb = 0.0;
+            for (uint32_t y = y0; y < y0 + k_ssim_window; ++y)
+            {
+                for (uint32_t x = x0; x < x0 + k_ssim_window; ++x)
+                {
+                    ma += luma(a, x, y);
+                    mb += luma(b, x, y);
+                }
+            }
+            ma /= n;
+            mb /= n;
+
+            double va = 0.0, vb = 0.0, cov = 0.0;
+            for (uint32_t y = y0; y < y0 + k_ssim_window; ++y)
+            {
+                for (uint32_t x = x0; x < x0 + k_ssim_window; ++x)
+                {
+                    const double da = luma(a, x, y) - ma;
+                    const double db = luma(b, x, y) - mb;
+                    va += da * da;
+                    vb += db * db;
+                    cov += da * db;
+                }
+            }
+            va /= n - 1.0;
+            vb /= n - 1.0;
+            cov /= n - 1.0;
+
+            total += ((2.0 * ma * mb + c1) * (2.0 * cov + c2)) /
+                     ((ma * ma + mb * mb + c1) * (va + vb + c2));
+            ++count;
+        }
+    }
+    return total / count;
+}
+
+}  // namespace
+
+TEST(ImageCompare, identical_images_pass)
+{
+    const uint32_t w = 64, h = 48;
+    auto img = make_image(w, h, 1);
+
+    image_compare_params params;
+    params.width = w;
+    params.height = h;
+
+    auto result = compare_images(img.data(), img.data(), params);
+    EXPECT_TRUE(result.pixel_passed);
+    EXPECT_TRUE(result.ssim_passed);
+    EXPECT_EQ(result.diff_pixel_count, 0u);
+    EXPECT_NEAR(result.ssim, 1.0f, 1e-5f);
+
+    ASSERT_EQ(result.diff_image.size(), img.size());
+    EXPECT_EQ(result.diff_image[1], 128);
+    EXPECT_EQ(result.heatmap_tiles_x, 4u);
+    EXPECT_EQ(result.heatmap_tiles_y, 3u);
+    for (float v : result.heatmap)
+    {
+        EXPECT_EQ(v, 0.0f);
+    }
+}
+
+TEST(ImageCompare, matches_scalar_reference_on_odd_sizes)
+{
+    // Odd sizes exercise the scalar tails after the vector loops
+    const uint32_t w = 67, h = 45;
+    auto a = make_image(w, h, 2);
+    auto b = a;
+    perturb(b, 3, 7);
+
+    image_compare_params params;
+    params.width = w;
+    params.height = h;
+    params.pixel_tolerance = 4;
+    params.thread_count = 1;
+    auto single = compare_images(a.data(), b.data(), params);
+
+    uint32_t expected_count = 0;
+    for (uint32_t i = 0; i < w * h; ++i)
+    {
+        bool match = true;
+        int sum = 0;
+        for (int c = 0; c < 4; ++c)
+        {
+            const int d = std::abs(int(a[i * 4 + c]) - int(b[i * 4 + c]));
+            match = match && d <= params.pixel_tolerance;
+            sum += d;
+        }
+        expected_count += match ? 0 : 1;
+
+        const uint8_t* px = single.diff_image.data() + i * 4;
+        if (match)
+        {
+            EXPECT_EQ(px[0], 0) << i;
+            EXPECT_EQ(px[1], 128) << i;
+        }
+        else
+        {
+            EXPECT_EQ(px[0], std::max(std::min(255, sum * 4), 128)) << i;
+            EXPECT_EQ(px[1], 0) << i;
+        }
+    }
+    EXPECT_GT(expected_count, 0u);
+    EXPECT_EQ(single.diff_pixel_count, expected_count);
+    EXPECT_NEAR(single.ssim, reference_ssim(a, b, w, h, k_ssim_window), 1e-5);
+
+    // Thread count changes the split, not the answer
+    params.thread_count = 5;
+    auto multi = compare_images(a.data(), b.data(), params);
+    EXPECT_EQ(multi.diff_pixel_count, single.diff_pixel_count);
+    EXPECT_EQ(multi.diff_image, single.diff_image);
+    EXPECT_EQ(multi.heatmap, single.heatmap);
+    EXPECT_FLOAT_EQ(multi.ssim, single.ssim);
+}
+
+TEST(ImageCompare, heatmap_localises_differences)
+{
+    const uint32_t w = 100, h = 70;
+    auto a = make_image(w, h, 4);
+    auto b = a;
+
+    // Every pixel of the 16x16 tile at (2, 1) differs
+    for (uint32_t y = 16; y < 32; ++y)
+    {
+        for (uint32_t x = 32; x < 48; ++x)
+        {
+            b[(size_t(y) * w + x) * 4] ^= 0x80;
+        }
+    }
+
+    image_compare_params params;
+    params.width = w;
+    params.height = h;
+    params.generate_diff_image = false;
+
+    auto result = compare_images(a.data(), b.data(), params);
+    EXPECT_TRUE(result.diff_image.empty());
+    EXPECT_EQ(result.diff_pixel_count, 256u);
+    ASSERT_EQ(result.heatmap_tiles_x, 7u);
+    ASSERT_EQ(result.heatmap_tiles_y, 5u);
+    EXPECT_EQ(result.worst_tile_x, 2u);
+    EXPECT_EQ(result.worst_tile_y, 1u);
+    EXPECT_FLOAT_EQ(result.heatmap[1 * 7 + 2], 1.0f);
+    EXPECT_FLOAT_EQ(result.heatmap[0], 0.0f);
+
+    auto heat = render_heatmap(result, w, h);
+    ASSERT_EQ(heat.size(), size_t(w) * h * 4);
+    EXPECT_EQ(heat[0], 0);                                // clean tile is black
+    EXPECT_EQ(heat[(size_t(20) * w + 40) * 4 + 1], 255);  // saturated tile is yellow
+
+    params.heatmap_tile = 0;
+    EXPECT_TRUE(compare_images(a.data(), b.data(), params).heatmap.empty());
+}
+
+TEST(ImageCompare, dense_ssim_matches_sliding_window)
+{
+    const uint32_t w = 41, h = 29;
+    auto a = make_image(w, h, 5);
+    auto b = a;
+    perturb(b, 6, 3);
+
+    for (uint32_t stride : {1u, 3u, k_ssim_window})
+    {
+        EXPECT_NEAR(compute_ssim(a.data(), b.data(), w, h, stride, 3),
+                    reference_ssim(a, b, w, h, stride),
+                    1e-5)
+            << "stride " << stride;
+    }
+    EXPECT_EQ(compute_ssim(a.data(), b.data(), 7, 7), 1.0f);
+}
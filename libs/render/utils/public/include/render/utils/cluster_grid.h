@@ -6,9 +6,15 @@
 #include <vector>
 #include <cstdint>
 #include <cmath>
+#include <functional>
 
 namespace kryga
 {
+namespace jobs
+{
+class job_system;
+}
+
 namespace render
 {
 
@@ -48,6 +54,14 @@ struct cluster_light_info
     float radius;        // Effective radius
 };
 
+// Range of a depth slice into the depth-sorted light list, inclusive. Empty when
+// min_light > max_light.
+struct cluster_zbin
+{
+    uint32_t min_light;
+    uint32_t max_light;
+};
+
 // Cluster bounds in view space
 struct cluster_aabb
 {
@@ -55,6 +69,11 @@ struct cluster_aabb
     glm::vec3 max_point;
 };
 
+// Lights are sorted by view depth and z-binned per depth slice; each tile keeps a
+// bitmask over the sorted lights whose screen bounds touch it. A cluster's lights
+// are its tile's mask within its slice's bin, so the cost follows light coverage
+// rather than clusters x lights and nothing is capped. The per-cluster lists are
+// expanded from that for callers of the flat layout.
 class cluster_grid
 {
 public:
@@ -82,6 +101,13 @@ public:
     void
     set_planes(float near_plane, float far_plane);
 
+    // Null (default) builds on the caller
+    void
+    set_job_system(jobs::job_system* js)
+    {
+        m_jobs = js;
+    }
+
     // Clear all cluster light assignments
     void
     clear();
@@ -120,6 +146,35 @@ public:
         return m_cluster_light_indices;
     }
 
+    // Compact upload format. Light slots in view-depth order; the bins and tile
+    // masks below index into this list.
+    const std::vector<uint32_t>&
+    get_sorted_light_slots() const
+    {
+        return m_sorted_slots;
+    }
+
+    // One per depth slice
+    const std::vector<cluster_zbin>&
+    get_zbins() const
+    {
+        return m_zbins;
+    }
+
+    // get_tile_mask_words() words per tile, tile_y * tiles_x + tile_x order;
+    // bit i of the tile's mask is sorted light i
+    const std::vector<uint32_t>&
+    get_tile_masks() const
+    {
+        return m_tile_masks;
+    }
+
+    uint32_t
+    get_tile_mask_words() const
+    {
+        return m_mask_words;
+    }
+
     const cluster_grid_config&
     get_config() const
     {
@@ -145,6 +200,13 @@ public:
         return m_total_light_assignments;
     }
 
+    // Clusters with more lights than the flat layout holds; the bitmasks keep them all
+    uint32_t
+    get_truncated_clusters() const
+    {
+        return m_truncated_clusters;
+    }
+
     // For debugging: get AABBs
     const std::vector<cluster_aabb>&
     get_cluster_aabbs() const
@@ -153,6 +215,37 @@ public:
     }
 
 private:
+    // A light's clusters: depth slices and screen tiles its bounds cover, inclusive
+    struct light_bounds
+    {
+        float depth = 0.0f;
+        uint32_t slot = 0;
+        uint32_t min_slice = 0;
+        uint32_t max_slice = 0;
+        uint32_t min_tile_x = 0;
+        uint32_t max_tile_x = 0;
+        uint32_t min_tile_y = 0;
+        uint32_t max_tile_y = 0;
+    };
+
+    // False for lights outside the depth range
+    bool
+    compute_light_bounds(const cluster_light_info& light,
+                         const glm::mat4& view,
+                         const glm::mat4& projection,
+                         light_bounds& out) const;
+
+    // Sets the bits of sorted lights [word * 32, word * 32 + 32) in the tile masks
+    void
+    rasterize_word(uint32_t word);
+
+    // Expands one slice's bin and tile masks into the flat per-cluster lists
+    void
+    expand_slice(uint32_t slice);
+
+    void
+    parallel_for(uint32_t count, const std::function<void(uint32_t, uint32_t)>& fn) const;
+
     // Compute AABB of a cluster in view space
     cluster_aabb
     compute_cluster_aabb(uint32_t tile_x,
@@ -160,10 +253,6 @@ private:
                          uint32_t slice,
                          const glm::mat4& inv_projection) const;
 
-    // Test sphere-AABB intersection
-    bool
-    sphere_intersects_aabb(const glm::vec3& center, float radius, const cluster_aabb& aabb) const;
-
     // Convert screen-space point to view-space at given depth
     glm::vec3
     screen_to_view(float screen_x,
@@ -187,6 +276,24 @@ private:
     // Layout: [cluster0_light0, cluster0_light1, ..., cluster1_light0, ...]
     std::vector<uint32_t> m_cluster_light_indices{};
 
+    // Lights in view-depth order and their binned form
+    std::vector<light_bounds> m_lights{};
+    std::vector<uint32_t> m_sorted_slots{};
+    std::vector<cluster_zbin> m_zbins{};
+    std::vector<uint32_t> m_tile_masks{};
+    uint32_t m_mask_words = 0;
+
+    // Per-slice statistics, summed after the expansion
+    struct slice_stats
+    {
+        uint32_t active = 0;
+        uint32_t assignments = 0;
+        uint32_t truncated = 0;
+    };
+    std::vector<slice_stats> m_slice_stats{};
+
+    jobs::job_system* m_jobs = nullptr;
+
     // Precomputed cluster AABBs in view space (recomputed on projection change)
     std::vector<cluster_aabb> m_cluster_aabbs{};
 
@@ -196,6 +303,7 @@ private:
     // Statistics
     uint32_t m_active_clusters = 0;
     uint32_t m_total_light_assignments = 0;
+    uint32_t m_truncated_clusters = 0;
 
     bool m_initialized = false;
     bool m_aabbs_dirty = true;
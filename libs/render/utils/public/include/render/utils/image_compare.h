@@ -19,6 +19,16 @@ struct image_compare_result
 
     // RGBA diff image: red = mismatch, green = match. Empty if not requested.
     std::vector<uint8_t> diff_image;
+
+    // Fraction of mismatching pixels per heatmap tile (0..1), row-major,
+    // heatmap_tiles_x * heatmap_tiles_y. Empty if not requested.
+    std::vector<float> heatmap;
+    uint32_t heatmap_tiles_x = 0;
+    uint32_t heatmap_tiles_y = 0;
+
+    // Tile with the most mismatches, for failure messages
+    uint32_t worst_tile_x = 0;
+    uint32_t worst_tile_y = 0;
 };
 
 struct image_compare_params
@@ -28,15 +38,36 @@ struct image_compare_params
     uint8_t pixel_tolerance = 1;
     float ssim_threshold = 0.99f;
     bool generate_diff_image = true;
+    uint32_t heatmap_tile = 16;  // edge in pixels, 0 = no heatmap
+    uint32_t thread_count = 0;   // 0 = hardware_concurrency()
 };
 
-// Compare two RGBA images (width * height * 4 bytes each).
+constexpr uint32_t k_ssim_window = 8;
+
+// Compare two RGBA images (width * height * 4 bytes each). Work is split into
+// bands of rows across threads; the per-pixel kernels use SSE2/AVX2 where the
+// build enables them.
 image_compare_result
 compare_images(const uint8_t* actual, const uint8_t* expected, const image_compare_params& params);
 
 // Compute SSIM between two RGBA images (converts to luminance internally).
+// Mean over k_ssim_window-square windows placed every `stride` pixels; the
+// default tiles the image, stride 1 is the dense sliding window. Window sums come
+// from a summed-area table built one window row at a time, so the cost doesn't
+// grow with window overlap.
 float
-compute_ssim(const uint8_t* img_a, const uint8_t* img_b, uint32_t width, uint32_t height);
+compute_ssim(const uint8_t* img_a,
+             const uint8_t* img_b,
+             uint32_t width,
+             uint32_t height,
+             uint32_t stride = k_ssim_window,
+             uint32_t thread_count = 0);
+
+// Upscale a result's heatmap to a width x height RGBA image (black = clean,
+// through red to yellow = every pixel in the tile differs). Empty if the result
+// has no heatmap.
+std::vector<uint8_t>
+render_heatmap(const image_compare_result& result, uint32_t width, uint32_t height);
 
 // Load RGBA PNG. Returns empty vector on failure.
 std::vector<uint8_t>
@@ -20,11 +20,13 @@
 #include <deque>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #if defined(_WIN32)
@@ -52,6 +54,21 @@ frame_message(const std::string& payload)
     return os.str();
 }
 
+std::string
+frame_binary_message(const std::string& json, const std::vector<uint8_t>& payload)
+{
+    std::ostringstream os;
+    os << "Content-Length: " << json.size() + payload.size() << "\r\n"
+       << "Content-Type: application/vnd.kryga.binary\r\n"
+       << "Json-Length: " << json.size() << "\r\n\r\n";
+
+    std::string framed = os.str();
+    framed.reserve(framed.size() + json.size() + payload.size());
+    framed += json;
+    framed.append(reinterpret_cast<const char*>(payload.data()), payload.size());
+    return framed;
+}
+
 bool
 try_consume_frame(std::vector<char>& buffer, std::string& payload_out)
 {
@@ -157,6 +174,11 @@ struct rpc_server::impl
 
     std::atomic<bool> running{false};
     uint32_t next_client_id = 1;
+    uint32_t current_client = 0;  // I/O thread, set while a handler runs
+
+    // Ids of connected clients, for send_binary() from non-I/O threads
+    std::mutex live_mutex;
+    std::unordered_set<uint32_t> live_clients;
 
     std::thread io_thread;
 
@@ -196,7 +218,12 @@ struct rpc_server::impl::session : public std::enable_shared_from_this<session>
     void
     send(const Json::Value& msg)
     {
-        std::string framed = frame_message(serialize(msg));
+        send_framed(frame_message(serialize(msg)));
+    }
+
+    void
+    send_framed(std::string framed)
+    {
         bool was_idle = m_write_queue.empty();
         m_write_queue.push_back(std::move(framed));
         if (was_idle)
@@ -314,6 +341,10 @@ rpc_server::impl::do_accept()
 
             auto s = std::make_shared<session>(std::move(socket), next_client_id++, *this);
             clients.push_back(s);
+            {
+                std::lock_guard lock(live_mutex);
+                live_clients.insert(s->session_id());
+            }
 
             if (clients.size() > 1)
             {
@@ -345,6 +376,7 @@ rpc_server::impl::handle_request(const Json::Value& msg, session& sender)
 
     Json::Value result(Json::nullValue);
     std::string err;
+    current_client = sender.session_id();
     try
     {
         it->second(params, result, err);
@@ -353,6 +385,7 @@ rpc_server::impl::handle_request(const Json::Value& msg, session& sender)
     {
         err = std::string("handler exception: ") + e.what();
     }
+    current_client = 0;
 
     if (!err.empty())
     {
@@ -372,6 +405,10 @@ rpc_server::impl::remove_client(session* s)
     if (it != clients.end())
     {
         ALOG_INFO("rpc: client #{} removed ({} remaining)", s->session_id(), clients.size() - 1);
+        {
+            std::lock_guard lock(live_mutex);
+            live_clients.erase(s->session_id());
+        }
         clients.erase(it);
     }
 }
@@ -484,6 +521,9 @@ rpc_server::stop()
                        c->close();
                    }
                    impl->clients.clear();
+
+                   std::lock_guard lock(impl->live_mutex);
+                   impl->live_clients.clear();
                });
 
     m_impl->work_guard.reset();
@@ -520,4 +560,45 @@ rpc_server::notify(const std::string& method, const Json::Value& params)
                { impl->broadcast(msg); });
 }
 
+uint32_t
+rpc_server::current_client() const
+{
+    return m_impl->current_client;
+}
+
+bool
+rpc_server::send_binary(uint32_t client,
+                        const std::string& method,
+                        const Json::Value& params,
+                        std::vector<uint8_t> payload)
+{
+    if (!m_impl->running.load())
+    {
+        return false;
+    }
+    {
+        std::lock_guard lock(m_impl->live_mutex);
+        if (!m_impl->live_clients.contains(client))
+        {
+            return false;
+        }
+    }
+
+    // Serialize + frame on the caller's thread; the I/O thread only queues it
+    auto framed = frame_binary_message(serialize(make_notification(method, params)), payload);
+    asio::post(m_impl->io_ctx,
+               [impl = m_impl.get(), client, framed = std::move(framed)]() mutable
+               {
+                   for (auto& c : impl->clients)
+                   {
+                       if (c->session_id() == client)
+                       {
+                           c->send_framed(std::move(framed));
+                           return;
+                       }
+                   }
+               });
+    return true;
+}
+
 }  // namespace kryga::rpc
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include <cstdint>
+#include <vector>
 
 namespace Json
 {
@@ -60,6 +61,25 @@ public:
     void
     notify(const std::string& method, const Json::Value& params);
 
+    // Id of the client whose request is being handled. Only meaningful inside a
+    // handler (0 elsewhere); lets it address later pushes to its caller alone.
+    uint32_t
+    current_client() const;
+
+    // Push a notification with a binary payload to one client. Framed as
+    //   Content-Length: <json + payload>\r\n
+    //   Content-Type: application/vnd.kryga.binary\r\n
+    //   Json-Length: <json>\r\n\r\n
+    //   <json><payload>
+    // so JSON-only clients never receive one unless they asked for it.
+    // Thread-safe. Returns false once the client is gone (the send itself is
+    // asynchronous; a disconnect during it is not reported).
+    bool
+    send_binary(uint32_t client,
+                const std::string& method,
+                const Json::Value& params,
+                std::vector<uint8_t> payload);
+
 private:
     struct impl;
     std::unique_ptr<impl> m_impl;
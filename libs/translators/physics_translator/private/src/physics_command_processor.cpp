@@ -66,9 +66,17 @@ physics_command_processor::apply(const core::physics_message& m)
     {
         // The bridge minted m.handle and grew physics_system's storage at reserve();
         // here, on the physics thread, build the Jolt body and populate the slot that
-        // handle indexes. The borrowed mesh pointer is dereferenced (copied) right
+        // handle indexes. The borrowed mesh / height field is dereferenced (copied) right
         // here, closing the borrow window.
-        m_ps.create_static_mesh(physics::static_body_handle{m.handle}, *m.collider_mesh);
+        const physics::static_body_handle sh{m.handle};
+        if (m.collider_height_field)
+        {
+            m_ps.create_static_height_field(sh, *m.collider_height_field);
+        }
+        else
+        {
+            m_ps.create_static_mesh(sh, *m.collider_mesh);
+        }
         break;
     }
     case core::physics_msg_kind::unregister_static_collider:
@@ -124,6 +124,23 @@ physics_translator::register_static_collider(const physics::static_world_mesh& m
     return h;
 }
 
+physics::static_body_handle
+physics_translator::register_static_collider(const physics::static_height_field& field)
+{
+    const auto ah = m_static_alloc.reserve();
+
+    physics::static_body_handle h;
+    h.value = ah.v;
+
+    core::physics_message msg;
+    msg.kind = core::physics_msg_kind::register_static_collider;
+    msg.handle = h.value;
+    msg.collider_height_field = &field;  // borrowed; the processor copies on register
+    emit(msg);
+
+    return h;
+}
+
 void
 physics_translator::unregister_static_collider(physics::static_body_handle h)
 {
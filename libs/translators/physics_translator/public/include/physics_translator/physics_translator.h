@@ -121,6 +121,10 @@ public:
     physics::static_body_handle
     register_static_collider(const physics::static_world_mesh& mesh);
 
+    // Same contract, for a height field (built as a native height-field shape)
+    physics::static_body_handle
+    register_static_collider(const physics::static_height_field& field);
+
     void
     unregister_static_collider(physics::static_body_handle h);
 
@@ -80,17 +80,42 @@ static void
 process(create_mesh_cmd& c, render_cmd::render_exec_context& ctx)
 {
     // Populate the slot the builder pre-reserved. Handle-only — no id index.
+    // Chunked meshes carry CDLOD morph data in the colour slot and stay full.
+    auto format = ctx.vr.get_render_config().compact_vertices && !c.chunk_vertex_count
+                      ? render::vertex_format::compact
+                      : render::vertex_format::full;
     if (c.skinned)
     {
         auto vbv = c.vertices->make_view<gpu::skinned_vertex_data>();
         auto ibv = c.indices->make_view<gpu::uint>();
-        ctx.loader.populate_skinned_mesh(c.handle, c.id, vbv, ibv);
+        ctx.loader.populate_skinned_mesh(c.handle, c.id, vbv, ibv, format);
     }
     else
     {
         auto vbv = c.vertices->make_view<gpu::vertex_data>();
         auto ibv = c.indices->make_view<gpu::uint>();
-        ctx.loader.populate_mesh(c.handle, c.id, vbv, ibv);
+        std::span<const gpu::uint> shadow;
+        if (c.shadow_indices)
+        {
+            auto sv = c.shadow_indices->make_view<gpu::uint>();
+            shadow = {sv.as(), (size_t)sv.size()};
+        }
+        std::span<const gpu::uint> lod_indices;
+        std::span<const render::mesh_lod> lods;
+        if (c.lod_indices && !c.chunk_vertex_count)
+        {
+            auto lv = c.lod_indices->make_view<gpu::uint>();
+            lod_indices = {lv.as(), (size_t)lv.size()};
+            lods = c.lods;
+        }
+        ctx.loader.populate_mesh(c.handle, c.id, vbv, ibv, format, shadow, lod_indices, lods);
+    }
+
+    if (c.chunk_vertex_count)
+    {
+        auto* mesh_data = ctx.loader.get_mesh_data(c.handle);
+        mesh_data->m_lods = std::move(c.lods);
+        mesh_data->m_chunk_vertex_count = c.chunk_vertex_count;
     }
 }
 
@@ -389,6 +414,7 @@ process(create_object_cmd& c, render_cmd::render_exec_context& ctx)
     object_data->gpu_data.lightmap_offset = lm.offset;
     object_data->gpu_data.lightmap_texture_index = lm.index;
     object_data->bone_count = c.bone_count;
+    object_data->mesh_chunk = c.mesh_chunk;
     object_data->queue_id = std::move(c.queue_id);
     object_data->layer_flags = c.layer_flags.bits;
 
@@ -421,6 +447,7 @@ process(update_object_cmd& c, render_cmd::render_exec_context& ctx)
     object_data->gpu_data.lightmap_scale = lm.scale;
     object_data->gpu_data.lightmap_offset = lm.offset;
     object_data->gpu_data.lightmap_texture_index = lm.index;
+    object_data->mesh_chunk = c.mesh_chunk;
 
     auto new_rqid = std::move(c.queue_id);
     if (new_rqid != object_data->queue_id || c.layer_flags.bits != object_data->layer_flags)
@@ -460,7 +487,13 @@ process(create_chunk_mesh_cmd& c, render_cmd::render_exec_context& ctx)
 {
     auto vbv = c.vertices->make_view<gpu::vertex_data>();
     auto ibv = c.indices->make_view<gpu::uint>();
-    ctx.loader.populate_mesh(c.handle, c.id, vbv, ibv);
+    ctx.loader.populate_mesh(c.handle,
+                             c.id,
+                             vbv,
+                             ibv,
+                             ctx.vr.get_render_config().compact_vertices
+                                 ? render::vertex_format::compact
+                                 : render::vertex_format::full);
 }
 
 // ============================================================================
@@ -642,27 +675,6 @@ process(apply_bones_cmd& c, render_cmd::render_exec_context& ctx)
 // UI panels (packages/ui retained-mode widgets)
 // ============================================================================
 
-namespace
-{
-
-// Pixel rect (top-left origin) -> NDC rect (min, max) using the current viewport
-// size. Y maps directly: pixel +y = down, and Vulkan NDC +y also points down.
-glm::vec4
-ui_pixels_to_ndc(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t vw, uint32_t vh)
-{
-    float fvw = static_cast<float>(vw == 0 ? 1u : vw);
-    float fvh = static_cast<float>(vh == 0 ? 1u : vh);
-
-    float x0 = (static_cast<float>(x) / fvw) * 2.f - 1.f;
-    float x1 = (static_cast<float>(x + w) / fvw) * 2.f - 1.f;
-    float y0 = (static_cast<float>(y) / fvh) * 2.f - 1.f;
-    float y1 = (static_cast<float>(y + h) / fvh) * 2.f - 1.f;
-
-    return glm::vec4(x0, y0, x1, y1);
-}
-
-}  // namespace
-
 static void
 process(ui_panel_upsert_cmd& c, render_cmd::render_exec_context& ctx)
 {
@@ -673,7 +685,12 @@ process(ui_panel_upsert_cmd& c, render_cmd::render_exec_context& ctx)
     }
 
     render::vulkan_render::ui_panel_entry entry;
-    entry.rect_ndc = ui_pixels_to_ndc(c.x, c.y, c.w, c.h, ctx.vr.get_width(), ctx.vr.get_height());
+    // Pixel rect (top-left origin); pixel->NDC happens in se_ui_batch.vert against
+    // the live viewport, so a resize needs no re-upsert.
+    entry.rect_px = glm::vec4(static_cast<float>(c.x),
+                              static_cast<float>(c.y),
+                              static_cast<float>(c.x + c.w),
+                              static_cast<float>(c.y + c.h));
     entry.color_opacity = glm::vec4(c.color, c.opacity);
 
     ctx.vr.ui_panel_create_or_update(c.id, entry);
@@ -690,14 +707,15 @@ process(ui_text_upsert_cmd& c, render_cmd::render_exec_context& ctx)
 {
     // Hidden / empty just clears the slot — the handle stays reserved (the widget
     // still exists); only the destroyer frees it.
-    if (!c.visible || c.text[0] == '\0')
+    if (!c.visible || !c.text || c.text->empty())
     {
         ctx.loader.reset_ui_text(c.handle);
+        ctx.vr.ui_text_changed(c.handle);
         return;
     }
 
     render::ui_text_entry entry;
-    entry.text = c.text;  // char[] -> std::string (null-terminated)
+    entry.text = std::move(*c.text);  // sole owner: the builder's copy
     entry.x = c.x;
     entry.y = c.y;
     entry.anchor = c.anchor;
@@ -706,12 +724,14 @@ process(ui_text_upsert_cmd& c, render_cmd::render_exec_context& ctx)
     entry.font = c.font;
 
     ctx.loader.populate_ui_text(c.handle, entry);
+    ctx.vr.ui_text_changed(c.handle);
 }
 
 static void
 process(ui_text_destroy_cmd& c, render_cmd::render_exec_context& ctx)
 {
     ctx.loader.reset_ui_text(c.handle);
+    ctx.vr.ui_text_changed(c.handle);
 }
 
 // ============================================================================
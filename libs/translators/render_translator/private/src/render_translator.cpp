@@ -6,6 +6,7 @@
 #include <vulkan_render/vulkan_render_device.h>  // frames_in_flight()
 #include <core/reflection/reflection_type.h>
 #include <core/subsystem_queues.h>
+#include <utils/frame_pipeline.h>
 
 #include <packages/root/model/smart_object.h>
 #include <packages/root/model/components/game_object_component.h>
@@ -82,14 +83,17 @@ render_translator::on_frame()
     // Re-sync the deferral window to the GPU horizon each frame. The render lib
     // owns frames_in_flight; we pull it here (model thread) rather than have the
     // render side push it, which would invert the bridge->render dependency.
+    // On top of it, up to k_max_pipeline_depth built frames may still be waiting for
+    // the render thread; the deepest setting, since the depth can drop mid-flight.
     const uint32_t fif = glob::glob_state().getr_render().device.frames_in_flight();
-    m_meshes_alloc.set_defer_ticks(static_cast<uint64_t>(fif) + 1);
-    m_materials_alloc.set_defer_ticks(static_cast<uint64_t>(fif) + 1);
-    m_textures_alloc.set_defer_ticks(static_cast<uint64_t>(fif) + 1);
-    m_objects_alloc.set_defer_ticks(static_cast<uint64_t>(fif) + 1);
-    m_dir_lights_alloc.set_defer_ticks(static_cast<uint64_t>(fif) + 1);
-    m_uni_lights_alloc.set_defer_ticks(static_cast<uint64_t>(fif) + 1);
-    m_ui_texts_alloc.set_defer_ticks(static_cast<uint64_t>(fif) + 1);
+    const uint64_t defer = static_cast<uint64_t>(fif) + utils::k_max_pipeline_depth;
+    m_meshes_alloc.set_defer_ticks(defer);
+    m_materials_alloc.set_defer_ticks(defer);
+    m_textures_alloc.set_defer_ticks(defer);
+    m_objects_alloc.set_defer_ticks(defer);
+    m_dir_lights_alloc.set_defer_ticks(defer);
+    m_uni_lights_alloc.set_defer_ticks(defer);
+    m_ui_texts_alloc.set_defer_ticks(defer);
 
     m_meshes_alloc.tick();
     m_materials_alloc.tick();
@@ -21,6 +21,7 @@
 #include <core/object_layer_flags.h>
 
 #include <vulkan_render/vulkan_render_loader.h>  // render::lightmap_uv
+#include <vulkan_render/types/vulkan_mesh_data.h>
 
 #include <glm/glm.hpp>
 
@@ -74,7 +75,13 @@ struct create_mesh_cmd : render_cmd::render_command_base
     render::types::mesh_handle handle;  // pre-reserved by the builder (handle model)
     std::shared_ptr<utils::buffer> vertices;
     std::shared_ptr<utils::buffer> indices;
+    std::shared_ptr<utils::buffer> shadow_indices;  // optional, static meshes only
+    std::shared_ptr<utils::buffer> lod_indices;     // optional, static meshes only
     bool skinned = false;
+    // Chunked LOD grid: `indices` holds one index list per level for a single chunk.
+    // Otherwise the coarser levels of a discrete chain, as ranges of `lod_indices`.
+    std::vector<render::mesh_lod> lods;
+    uint32_t chunk_vertex_count = 0;
 };
 
 struct destroy_mesh_cmd : render_cmd::render_command_base
@@ -178,6 +185,7 @@ struct create_object_cmd : render_cmd::render_command_base
     glm::vec3 bounding_sphere_center{0.0f};
     float bounding_radius = 0.0f;
     uint32_t bone_count = 0;
+    uint32_t mesh_chunk = 0;  // chunk drawn from a chunked mesh
     std::string queue_id;
     // Lightmap binding is resolved on the render thread at execute time from the
     // loader's per-level registry (populated by create_lightmap_cmd), not baked in
@@ -199,6 +207,7 @@ struct update_object_cmd : render_cmd::render_command_base
     glm::vec3 position{0.0f};
     glm::vec3 bounding_sphere_center{0.0f};
     float bounding_radius = 0.0f;
+    uint32_t mesh_chunk = 0;
     std::string queue_id;
     utils::id lightmap_level_id;
     core::object_layer_flags layer_flags;
@@ -332,8 +341,8 @@ struct apply_bones_cmd : render_cmd::render_command_base
 // UI panels (packages/ui retained-mode widgets)
 //
 // Raw pixel rect (top-left origin) + flat color. The pixel->NDC conversion and
-// viewport lookup are deferred to the render thread (process(), where the live
-// viewport size is known), so the model thread never reads render state.
+// viewport lookup are deferred to the GPU (se_ui_batch.vert, against the live
+// viewport size), so the model thread never reads render state.
 // ============================================================================
 
 struct ui_panel_upsert_cmd : render_cmd::render_command_base
@@ -361,8 +370,9 @@ struct ui_panel_destroy_cmd : render_cmd::render_command_base
 // UI text (packages/ui ui_text widget)
 //
 // Carries the raw string + pixel anchor; glyph layout (per-glyph quads from the
-// font atlas metrics) and the pixel->NDC conversion are deferred to the render
-// thread (draw_ui_text), where the live viewport + baked metrics are known.
+// font atlas metrics) happens once per upsert on the render thread (ui_batcher),
+// where the baked metrics are known; the pixel->NDC conversion happens in the
+// batched UI vertex shader against the live viewport.
 // anchor: 0=top-left, 1=top-right, 2=bottom-left, 3=bottom-right (matches
 // kryga::ui::ui_text_anchor; right/bottom anchors align the text to that edge).
 // ============================================================================
@@ -371,8 +381,6 @@ struct ui_text_upsert_cmd : render_cmd::render_command_base
 {
     static constexpr auto k_kind = render_cmd::render_cmd_kind::ui_text_upsert;
 
-    static constexpr int k_max_len = 64;
-
     render::types::ui_text_handle handle;  // pre-reserved by the builder (handle model)
     int32_t x = 0;
     int32_t y = 0;
@@ -381,7 +389,9 @@ struct ui_text_upsert_cmd : render_cmd::render_command_base
     glm::vec4 color{1.0f};
     utils::id font;  // baked font id; empty -> loader default
     bool visible = true;
-    char text[k_max_len] = {};  // null-terminated, truncated to k_max_len-1
+    // UTF-8, any length. Carried by reference like mesh/texture payloads; the
+    // processor moves the string into the loader's slot.
+    std::shared_ptr<std::string> text;
 };
 
 struct ui_text_destroy_cmd : render_cmd::render_command_base
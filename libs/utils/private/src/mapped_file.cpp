@@ -0,0 +1,184 @@
+#include "utils/mapped_file.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kryga
+{
+namespace utils
+{
+
+mapped_file::~mapped_file()
+{
+    close();
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+mapped_file&
+mapped_file::operator=(mapped_file&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_open = std::exchange(other.m_open, false);
+#if defined(_WIN32)
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+
+    return *this;
+}
+
+#if defined(_WIN32)
+
+bool
+mapped_file::open(const path& p)
+{
+    close();
+
+    auto file = CreateFileW(p.fs().c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_open = true;
+
+    // Zero-length files cannot be mapped
+    if (m_size == 0)
+    {
+        return true;
+    }
+
+    m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping)
+    {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data)
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void
+mapped_file::close()
+{
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping)
+    {
+        CloseHandle(m_mapping);
+    }
+    if (m_file)
+    {
+        CloseHandle(m_file);
+    }
+
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+#else
+
+bool
+mapped_file::open(const path& p)
+{
+    close();
+
+    int fd = ::open(p.fs().c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    m_size = static_cast<size_t>(st.st_size);
+    m_open = true;
+
+    if (m_size == 0)
+    {
+        ::close(fd);
+        return true;
+    }
+
+    // The mapping keeps its own reference to the file
+    void* addr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (addr == MAP_FAILED)
+    {
+        m_size = 0;
+        m_open = false;
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(addr);
+    return true;
+}
+
+void
+mapped_file::close()
+{
+    if (m_data)
+    {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+#endif
+
+}  // namespace utils
+}  // namespace kryga
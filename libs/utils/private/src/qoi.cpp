@@ -0,0 +1,236 @@
+#include <utils/qoi.h>
+
+#include <cstring>
+
+namespace kryga
+{
+
+namespace
+{
+
+constexpr uint8_t k_op_index = 0x00;
+constexpr uint8_t k_op_diff = 0x40;
+constexpr uint8_t k_op_luma = 0x80;
+constexpr uint8_t k_op_run = 0xc0;
+constexpr uint8_t k_op_rgb = 0xfe;
+constexpr uint8_t k_op_rgba = 0xff;
+constexpr uint8_t k_mask_2 = 0xc0;
+
+constexpr uint8_t k_padding[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+constexpr size_t k_header_size = 14;
+
+struct rgba
+{
+    uint8_t r = 0, g = 0, b = 0, a = 0;
+
+    bool
+    operator==(const rgba&) const = default;
+};
+
+uint32_t
+hash(const rgba& c)
+{
+    return (c.r * 3u + c.g * 5u + c.b * 7u + c.a * 11u) % 64u;
+}
+
+void
+write_u32(std::vector<uint8_t>& out, uint32_t v)
+{
+    out.push_back(uint8_t(v >> 24));
+    out.push_back(uint8_t(v >> 16));
+    out.push_back(uint8_t(v >> 8));
+    out.push_back(uint8_t(v));
+}
+
+uint32_t
+read_u32(const uint8_t* p)
+{
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+}  // namespace
+
+std::vector<uint8_t>
+qoi_encode(const uint8_t* pixels, uint32_t width, uint32_t height, size_t stride, bool bgra)
+{
+    std::vector<uint8_t> out;
+    // Worst case is one 5-byte RGBA op per pixel; typical frames are far smaller
+    out.reserve(k_header_size + size_t(width) * height + sizeof(k_padding));
+
+    out.insert(out.end(), {'q', 'o', 'i', 'f'});
+    write_u32(out, width);
+    write_u32(out, height);
+    out.push_back(4);  // channels
+    out.push_back(0);  // sRGB with linear alpha
+
+    rgba index[64] = {};
+    rgba prev{0, 0, 0, 255};
+    uint32_t run = 0;
+
+    const uint32_t ri = bgra ? 2 : 0;
+    const uint32_t bi = bgra ? 0 : 2;
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        const uint8_t* row = pixels + y * stride;
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            const uint8_t* p = row + x * 4;
+            const rgba px{p[ri], p[1], p[bi], p[3]};
+
+            if (px == prev)
+            {
+                if (++run == 62)
+                {
+                    out.push_back(k_op_run | (run - 1));
+                    run = 0;
+                }
+                continue;
+            }
+
+            if (run > 0)
+            {
+                out.push_back(k_op_run | (run - 1));
+                run = 0;
+            }
+
+            const uint32_t h = hash(px);
+            if (index[h] == px)
+            {
+                out.push_back(k_op_index | h);
+            }
+            else
+            {
+                index[h] = px;
+
+                if (px.a == prev.a)
+                {
+                    const int8_t vr = int8_t(px.r - prev.r);
+                    const int8_t vg = int8_t(px.g - prev.g);
+                    const int8_t vb = int8_t(px.b - prev.b);
+                    const int8_t vg_r = int8_t(vr - vg);
+                    const int8_t vg_b = int8_t(vb - vg);
+
+                    if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+                    {
+                        out.push_back(k_op_diff | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2));
+                    }
+                    else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8)
+                    {
+                        out.push_back(k_op_luma | (vg + 32));
+                        out.push_back(uint8_t(((vg_r + 8) << 4) | (vg_b + 8)));
+                    }
+                    else
+                    {
+                        out.insert(out.end(), {k_op_rgb, px.r, px.g, px.b});
+                    }
+                }
+                else
+                {
+                    out.insert(out.end(), {k_op_rgba, px.r, px.g, px.b, px.a});
+                }
+            }
+            prev = px;
+        }
+    }
+
+    if (run > 0)
+    {
+        out.push_back(k_op_run | (run - 1));
+    }
+    out.insert(out.end(), std::begin(k_padding), std::end(k_padding));
+    return out;
+}
+
+bool
+qoi_decode(
+    const uint8_t* data, size_t size, std::vector<uint8_t>& out, uint32_t& width, uint32_t& height)
+{
+    if (size < k_header_size + sizeof(k_padding) || std::memcmp(data, "qoif", 4) != 0)
+    {
+        return false;
+    }
+
+    width = read_u32(data + 4);
+    height = read_u32(data + 8);
+    const uint64_t count = uint64_t(width) * height;
+    // Every op yields at least one pixel, runs at most 62
+    if (width == 0 || height == 0 || count > uint64_t(size) * 62)
+    {
+        return false;
+    }
+
+    out.resize(count * 4);
+
+    rgba index[64] = {};
+    rgba px{0, 0, 0, 255};
+    uint32_t run = 0;
+
+    size_t p = k_header_size;
+    const size_t end = size - sizeof(k_padding);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        if (run > 0)
+        {
+            --run;
+        }
+        else
+        {
+            if (p >= end)
+            {
+                return false;
+            }
+
+            const uint8_t b1 = data[p++];
+            if (b1 == k_op_rgb || b1 == k_op_rgba)
+            {
+                const size_t n = b1 == k_op_rgb ? 3 : 4;
+                if (p + n > end)
+                {
+                    return false;
+                }
+                px.r = data[p++];
+                px.g = data[p++];
+                px.b = data[p++];
+                if (n == 4)
+                {
+                    px.a = data[p++];
+                }
+            }
+            else if ((b1 & k_mask_2) == k_op_index)
+            {
+                px = index[b1];
+            }
+            else if ((b1 & k_mask_2) == k_op_diff)
+            {
+                px.r += ((b1 >> 4) & 0x03) - 2;
+                px.g += ((b1 >> 2) & 0x03) - 2;
+                px.b += (b1 & 0x03) - 2;
+            }
+            else if ((b1 & k_mask_2) == k_op_luma)
+            {
+                if (p >= end)
+                {
+                    return false;
+                }
+                const uint8_t b2 = data[p++];
+                const int vg = (b1 & 0x3f) - 32;
+                px.r += vg - 8 + ((b2 >> 4) & 0x0f);
+                px.g += vg;
+                px.b += vg - 8 + (b2 & 0x0f);
+            }
+            else
+            {
+                run = b1 & 0x3f;
+            }
+
+            index[hash(px)] = px;
+        }
+
+        std::memcpy(out.data() + i * 4, &px, 4);
+    }
+    return true;
+}
+
+}  // namespace kryga
@@ -0,0 +1,108 @@
+#include "utils/slab_pool.h"
+
+#include "utils/check.h"
+
+#include <algorithm>
+
+namespace kryga
+{
+namespace utils
+{
+
+slab_pool::slab_pool(uint32_t blocks_per_page)
+    : m_blocks_per_page(std::max(blocks_per_page, 1u))
+{
+}
+
+slab_pool::~slab_pool()
+{
+    KRG_check(m_live == 0, "slab_pool destroyed with live blocks");
+
+    for (auto* page : m_pages)
+    {
+        ::operator delete(page, std::align_val_t{k_align});
+    }
+}
+
+void*
+slab_pool::allocate(size_t bytes)
+{
+    std::lock_guard lock(m_mutex);
+
+    if (m_block_size == 0)
+    {
+        m_block_size = (std::max(bytes, sizeof(free_block)) + k_align - 1) & ~(k_align - 1);
+    }
+
+    if (bytes > m_block_size)
+    {
+        return ::operator new(bytes, std::align_val_t{k_align});
+    }
+
+    if (!m_free)
+    {
+        add_page();
+    }
+
+    auto* block = m_free;
+    m_free = block->next;
+    ++m_live;
+    return block;
+}
+
+void
+slab_pool::deallocate(void* ptr, size_t bytes)
+{
+    std::lock_guard lock(m_mutex);
+
+    if (bytes > m_block_size)
+    {
+        ::operator delete(ptr, std::align_val_t{k_align});
+        return;
+    }
+
+    auto* block = static_cast<free_block*>(ptr);
+    block->next = m_free;
+    m_free = block;
+    --m_live;
+}
+
+void
+slab_pool::add_page()
+{
+    auto* page = static_cast<std::byte*>(
+        ::operator new(m_block_size * m_blocks_per_page, std::align_val_t{k_align}));
+    m_pages.push_back(page);
+
+    // Thread back to front so the page is handed out in address order
+    for (uint32_t i = m_blocks_per_page; i-- > 0;)
+    {
+        auto* block = reinterpret_cast<free_block*>(page + i * m_block_size);
+        block->next = m_free;
+        m_free = block;
+    }
+}
+
+size_t
+slab_pool::block_size() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_block_size;
+}
+
+size_t
+slab_pool::live() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_live;
+}
+
+size_t
+slab_pool::page_count() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_pages.size();
+}
+
+}  // namespace utils
+}  // namespace kryga
@@ -0,0 +1,44 @@
+#include "utils/mapped_file.h"
+#include "utils/file_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+
+using namespace kryga::utils;
+
+TEST(mapped_file, maps_whole_file_read_only)
+{
+    auto p = path(std::filesystem::temp_directory_path() / "kryga_mapped_file_test.bin");
+
+    std::vector<uint8_t> blob(10000);
+    for (size_t i = 0; i < blob.size(); ++i)
+    {
+        blob[i] = static_cast<uint8_t>(i * 31);
+    }
+    ASSERT_TRUE(file_utils::save_file(p, blob));
+
+    mapped_file mf;
+    ASSERT_TRUE(mf.open(p));
+    ASSERT_EQ(mf.size(), blob.size());
+    EXPECT_TRUE(std::equal(blob.begin(), blob.end(), mf.data().begin()));
+
+    // Moving hands the view over without remapping
+    auto* first = mf.data().data();
+    mapped_file moved = std::move(mf);
+    EXPECT_FALSE(mf.is_open());
+    EXPECT_TRUE(moved.is_open());
+    EXPECT_EQ(moved.data().data(), first);
+
+    moved.close();
+    EXPECT_TRUE(moved.data().empty());
+
+    ASSERT_TRUE(file_utils::save_file(p, {}));
+    ASSERT_TRUE(moved.open(p));
+    EXPECT_EQ(moved.size(), 0u);
+    moved.close();
+
+    std::filesystem::remove(p.fs());
+    EXPECT_FALSE(moved.open(p));
+}
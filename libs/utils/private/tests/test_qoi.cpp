@@ -0,0 +1,81 @@
+#include "utils/qoi.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+using namespace kryga;
+
+namespace
+{
+
+// Flat areas, gradients and noise exercise every op
+std::vector<uint8_t>
+make_image(uint32_t w, uint32_t h)
+{
+    std::vector<uint8_t> px(w * h * 4);
+    uint32_t seed = 12345;
+    for (uint32_t y = 0; y < h; ++y)
+    {
+        for (uint32_t x = 0; x < w; ++x)
+        {
+            uint8_t* p = px.data() + (y * w + x) * 4;
+            if (y < h / 3)
+            {
+                p[0] = 20, p[1] = 40, p[2] = 60, p[3] = 255;
+            }
+            else if (y < 2 * h / 3)
+            {
+                p[0] = uint8_t(x), p[1] = uint8_t(x + y), p[2] = uint8_t(y * 3), p[3] = 255;
+            }
+            else
+            {
+                seed = seed * 1664525u + 1013904223u;
+                std::memcpy(p, &seed, 4);
+            }
+        }
+    }
+    return px;
+}
+
+}  // namespace
+
+TEST(qoi, round_trip)
+{
+    const uint32_t w = 97, h = 61;
+    const auto src = make_image(w, h);
+
+    const auto encoded = qoi_encode(src.data(), w, h, w * 4);
+    EXPECT_LT(encoded.size(), src.size());
+
+    std::vector<uint8_t> decoded;
+    uint32_t dw = 0, dh = 0;
+    ASSERT_TRUE(qoi_decode(encoded.data(), encoded.size(), decoded, dw, dh));
+    EXPECT_EQ(dw, w);
+    EXPECT_EQ(dh, h);
+    EXPECT_EQ(decoded, src);
+}
+
+TEST(qoi, strided_bgra_source)
+{
+    const uint32_t w = 8, h = 4, stride = w * 4 + 12;
+    std::vector<uint8_t> bgra(stride * h, 0xcd);
+    std::vector<uint8_t> rgba(w * h * 4);
+    for (uint32_t i = 0; i < w * h; ++i)
+    {
+        const uint8_t c[4] = {uint8_t(i), uint8_t(i * 7), uint8_t(200 - i), uint8_t(128 + i)};
+        std::memcpy(rgba.data() + i * 4, c, 4);
+        uint8_t* d = bgra.data() + (i / w) * stride + (i % w) * 4;
+        d[0] = c[2], d[1] = c[1], d[2] = c[0], d[3] = c[3];
+    }
+
+    const auto encoded = qoi_encode(bgra.data(), w, h, stride, true);
+
+    std::vector<uint8_t> decoded;
+    uint32_t dw = 0, dh = 0;
+    ASSERT_TRUE(qoi_decode(encoded.data(), encoded.size(), decoded, dw, dh));
+    EXPECT_EQ(decoded, rgba);
+
+    // Truncated streams are rejected, not over-read
+    EXPECT_FALSE(qoi_decode(encoded.data(), encoded.size() / 2, decoded, dw, dh));
+}
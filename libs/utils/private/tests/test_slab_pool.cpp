@@ -0,0 +1,93 @@
+#include "utils/slab_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+using namespace kryga::utils;
+
+namespace
+{
+
+struct item
+{
+    explicit item(int v)
+        : value(v)
+    {
+        ++alive;
+    }
+    ~item()
+    {
+        --alive;
+    }
+
+    int value = 0;
+    std::array<float, 5> payload{};
+
+    static inline int alive = 0;
+};
+
+}  // namespace
+
+TEST(slab_pool, blocks_are_contiguous_and_recycled)
+{
+    slab_pool pool(4);
+
+    std::array<void*, 4> blocks{};
+    for (auto& b : blocks)
+    {
+        b = pool.allocate(24);
+    }
+    EXPECT_EQ(pool.block_size(), 32u);
+    EXPECT_EQ(pool.page_count(), 1u);
+    EXPECT_EQ(pool.live(), 4u);
+
+    // One page, handed out in address order
+    for (size_t i = 1; i < blocks.size(); ++i)
+    {
+        EXPECT_EQ(static_cast<std::byte*>(blocks[i]) - static_cast<std::byte*>(blocks[i - 1]),
+                  32);
+    }
+
+    pool.deallocate(blocks[2], 24);
+    EXPECT_EQ(pool.allocate(24), blocks[2]);
+
+    // Full page: the next block opens a second one
+    void* extra = pool.allocate(24);
+    EXPECT_EQ(pool.page_count(), 2u);
+
+    // Larger than the block size: heap, not a block
+    void* big = pool.allocate(100);
+    EXPECT_EQ(pool.live(), 5u);
+    pool.deallocate(big, 100);
+
+    pool.deallocate(extra, 24);
+    for (auto* b : blocks)
+    {
+        pool.deallocate(b, 24);
+    }
+    EXPECT_EQ(pool.live(), 0u);
+}
+
+TEST(slab_pool, allocate_shared_keeps_pool_alive)
+{
+    auto pool = std::make_shared<slab_pool>();
+    std::weak_ptr<slab_pool> weak = pool;
+
+    auto a = std::allocate_shared<item>(pool_allocator<item>(pool), 1);
+    auto b = std::allocate_shared<item>(pool_allocator<item>(pool), 2);
+    EXPECT_EQ(pool->live(), 2u);
+    EXPECT_EQ(item::alive, 2);
+
+    // Owner drops the pool first, as a level does on unload
+    pool.reset();
+    EXPECT_FALSE(weak.expired());
+
+    EXPECT_EQ(a->value + b->value, 3);
+    a.reset();
+    EXPECT_EQ(weak.lock()->live(), 1u);
+    b.reset();
+
+    EXPECT_EQ(item::alive, 0);
+    EXPECT_TRUE(weak.expired());
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace kryga
+{
+namespace utils
+{
+
+// Frames the main thread may build ahead of the render thread. The streaming
+// pipeline's gate picks a depth in [1, k_max_pipeline_depth] at runtime.
+inline constexpr uint32_t k_max_pipeline_depth = 3;
+
+// Producer/consumer ring behind the pipeline: every frame that may still be in
+// flight at the deepest setting, plus the one being built. Fixed, so the depth can
+// change between frames without remapping slots.
+inline constexpr uint32_t k_frame_slot_count = k_max_pipeline_depth + 1;
+
+// Ring index of a frame (or of any caller-side frame counter)
+constexpr uint32_t
+frame_slot_of(uint64_t frame)
+{
+    return static_cast<uint32_t>(frame % k_frame_slot_count);
+}
+
+}  // namespace utils
+}  // namespace kryga
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "utils/path.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace kryga
+{
+namespace utils
+{
+
+// Read-only memory mapping of a whole file. The view stays valid until the
+// mapping is closed or destroyed. Empty files map to an empty view.
+class mapped_file
+{
+public:
+    mapped_file() = default;
+
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+
+    mapped_file&
+    operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept;
+
+    mapped_file&
+    operator=(mapped_file&& other) noexcept;
+
+    bool
+    open(const path& p);
+
+    void
+    close();
+
+    bool
+    is_open() const
+    {
+        return m_open;
+    }
+
+    std::span<const uint8_t>
+    data() const
+    {
+        return {m_data, m_size};
+    }
+
+    size_t
+    size() const
+    {
+        return m_size;
+    }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_open = false;
+
+#if defined(_WIN32)
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+}  // namespace utils
+}  // namespace kryga
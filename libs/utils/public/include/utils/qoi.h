@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace kryga
+{
+
+// QOI ("Quite OK Image") RGBA encoder/decoder. An order of magnitude faster than
+// PNG at comparable size for rendered frames; used for frame streaming.
+//
+// `stride` is the source row pitch in bytes. `bgra` swizzles BGRA8 input while
+// encoding so swapchain-format readbacks need no separate pass.
+std::vector<uint8_t>
+qoi_encode(const uint8_t* pixels, uint32_t width, uint32_t height, size_t stride, bool bgra = false);
+
+// Decodes to tightly packed RGBA8. Returns false on a malformed stream.
+bool
+qoi_decode(const uint8_t* data,
+           size_t size,
+           std::vector<uint8_t>& rgba,
+           uint32_t& width,
+           uint32_t& height);
+
+}  // namespace kryga
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace kryga
+{
+namespace utils
+{
+
+// Fixed-size block pool for instances of one type. Blocks are carved from pages
+// of blocks_per_page, so consecutive allocations sit next to each other, and are
+// recycled through an intrusive free list; the pages themselves are released all
+// at once when the pool dies. The block size is fixed by the first allocation,
+// anything larger falls through to the global heap. Thread-safe.
+class slab_pool
+{
+public:
+    static constexpr size_t k_align = alignof(std::max_align_t);
+    static constexpr uint32_t k_default_blocks_per_page = 64;
+
+    explicit slab_pool(uint32_t blocks_per_page = k_default_blocks_per_page);
+    ~slab_pool();
+
+    slab_pool(const slab_pool&) = delete;
+    slab_pool&
+    operator=(const slab_pool&) = delete;
+
+    void*
+    allocate(size_t bytes);
+
+    // `bytes` must match the allocate() call
+    void
+    deallocate(void* ptr, size_t bytes);
+
+    size_t
+    block_size() const;
+
+    size_t
+    live() const;
+
+    size_t
+    page_count() const;
+
+private:
+    struct free_block
+    {
+        free_block* next;
+    };
+
+    void
+    add_page();
+
+    mutable std::mutex m_mutex;
+    uint32_t m_blocks_per_page = 0;
+    size_t m_block_size = 0;
+    std::vector<std::byte*> m_pages;
+    free_block* m_free = nullptr;
+    size_t m_live = 0;
+};
+
+// std allocator over a shared slab_pool, for std::allocate_shared. Each control
+// block keeps a copy, so the pool outlives every object carved from it.
+template <typename T>
+class pool_allocator
+{
+public:
+    using value_type = T;
+
+    explicit pool_allocator(std::shared_ptr<slab_pool> pool) noexcept
+        : m_pool(std::move(pool))
+    {
+    }
+
+    template <typename U>
+    pool_allocator(const pool_allocator<U>& other) noexcept
+        : m_pool(other.pool())
+    {
+    }
+
+    T*
+    allocate(size_t n)
+    {
+        if constexpr (alignof(T) > slab_pool::k_align)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+        }
+        else
+        {
+            return static_cast<T*>(m_pool->allocate(n * sizeof(T)));
+        }
+    }
+
+    void
+    deallocate(T* ptr, size_t n) noexcept
+    {
+        if constexpr (alignof(T) > slab_pool::k_align)
+        {
+            ::operator delete(ptr, std::align_val_t{alignof(T)});
+        }
+        else
+        {
+            m_pool->deallocate(ptr, n * sizeof(T));
+        }
+    }
+
+    const std::shared_ptr<slab_pool>&
+    pool() const
+    {
+        return m_pool;
+    }
+
+    template <typename U>
+    bool
+    operator==(const pool_allocator<U>& other) const
+    {
+        return m_pool == other.pool();
+    }
+
+private:
+    std::shared_ptr<slab_pool> m_pool;
+};
+
+}  // namespace utils
+}  // namespace kryga
@@ -0,0 +1,203 @@
+#include "voronoi_fracture/fracture_cache.h"
+
+#include <utils/fnv_hash.h>
+
+#include <cstring>
+#include <format>
+
+namespace kryga
+{
+namespace voronoi_fracture
+{
+
+namespace
+{
+
+// "KFRC"
+constexpr uint32_t k_cache_magic = 0x4352464b;
+constexpr uint32_t k_cache_version = 1;
+
+// Bump when fracture_mesh output changes for the same inputs
+constexpr uint32_t k_algorithm_version = 1;
+
+struct cache_header
+{
+    uint32_t magic = k_cache_magic;
+    uint32_t version = k_cache_version;
+    uint32_t chunk_count = 0;
+    uint32_t reserved = 0;
+    float aabb_min[3] = {};
+    float aabb_max[3] = {};
+};
+
+// Followed by vertex_count vertices, then index_count indices
+struct cache_chunk
+{
+    uint32_t vertex_count = 0;
+    uint32_t index_count = 0;
+    float aabb_min[3] = {};
+    float aabb_max[3] = {};
+    float seed_point[3] = {};
+};
+
+void
+append(std::vector<uint8_t>& blob, const void* data, size_t size)
+{
+    auto offset = blob.size();
+    blob.resize(offset + size);
+    if (size)
+    {
+        std::memcpy(blob.data() + offset, data, size);
+    }
+}
+
+bool
+take(std::span<const uint8_t>& bytes, void* out, size_t size)
+{
+    if (bytes.size() < size)
+    {
+        return false;
+    }
+    if (size)
+    {
+        std::memcpy(out, bytes.data(), size);
+    }
+    bytes = bytes.subspan(size);
+    return true;
+}
+
+void
+store(float (&dst)[3], const glm::vec3& v)
+{
+    dst[0] = v.x;
+    dst[1] = v.y;
+    dst[2] = v.z;
+}
+
+glm::vec3
+load(const float (&src)[3])
+{
+    return {src[0], src[1], src[2]};
+}
+
+}  // namespace
+
+fracture_params
+destructible_fracture_params(uint32_t seed, uint32_t cell_count)
+{
+    fracture_params params;
+    params.seed = seed;
+    params.cell_count = cell_count;
+    params.fill = fill_mode::convex;
+    params.roughness = 0.15f;
+    return params;
+}
+
+uint64_t
+cache_key(const gpu::vertex_data* vertices,
+          uint32_t vertex_count,
+          const gpu::uint* indices,
+          uint32_t index_count,
+          const fracture_params& params)
+{
+    fnv_hasher h;
+    auto feed = [&h](auto v) { h.feed(&v, sizeof(v)); };
+
+    feed(k_algorithm_version);
+    feed(vertex_count);
+    h.feed(vertices, size_t(vertex_count) * sizeof(gpu::vertex_data));
+    feed(index_count);
+    h.feed(indices, size_t(index_count) * sizeof(gpu::uint));
+
+    feed(params.seed);
+    feed(params.cell_count);
+    feed(params.fill);
+    feed(params.roughness);
+    feed(params.depth);
+    feed(params.detail);
+    return h.value();
+}
+
+std::string
+cache_file_name(std::string_view mesh_stem, uint64_t key)
+{
+    return std::format("{}_{:016x}{}", mesh_stem, key, k_cache_extension);
+}
+
+std::vector<uint8_t>
+serialize(const fracture_result& result)
+{
+    cache_header header;
+    header.chunk_count = static_cast<uint32_t>(result.chunks.size());
+    store(header.aabb_min, result.aabb_min);
+    store(header.aabb_max, result.aabb_max);
+
+    std::vector<uint8_t> blob;
+    append(blob, &header, sizeof(header));
+
+    for (const auto& ck : result.chunks)
+    {
+        cache_chunk c;
+        c.vertex_count = static_cast<uint32_t>(ck.vertices.size());
+        c.index_count = static_cast<uint32_t>(ck.indices.size());
+        store(c.aabb_min, ck.aabb_min);
+        store(c.aabb_max, ck.aabb_max);
+        store(c.seed_point, ck.seed_point);
+
+        append(blob, &c, sizeof(c));
+        append(blob, ck.vertices.data(), ck.vertices.size() * sizeof(gpu::vertex_data));
+        append(blob, ck.indices.data(), ck.indices.size() * sizeof(gpu::uint));
+    }
+    return blob;
+}
+
+bool
+deserialize(std::span<const uint8_t> bytes, fracture_result& out)
+{
+    cache_header header;
+    if (!take(bytes, &header, sizeof(header)) || header.magic != k_cache_magic ||
+        header.version != k_cache_version)
+    {
+        return false;
+    }
+
+    // Every chunk takes at least its record, so a larger count is corrupt
+    if (header.chunk_count > bytes.size() / sizeof(cache_chunk))
+    {
+        return false;
+    }
+
+    out.aabb_min = load(header.aabb_min);
+    out.aabb_max = load(header.aabb_max);
+    out.chunks.clear();
+    out.chunks.reserve(header.chunk_count);
+
+    for (uint32_t i = 0; i < header.chunk_count; ++i)
+    {
+        cache_chunk c;
+        if (!take(bytes, &c, sizeof(c)) ||
+            bytes.size() < size_t(c.vertex_count) * sizeof(gpu::vertex_data) +
+                               size_t(c.index_count) * sizeof(gpu::uint))
+        {
+            return false;
+        }
+
+        auto& ck = out.chunks.emplace_back();
+        ck.aabb_min = load(c.aabb_min);
+        ck.aabb_max = load(c.aabb_max);
+        ck.seed_point = load(c.seed_point);
+
+        ck.vertices.resize(c.vertex_count);
+        ck.indices.resize(c.index_count);
+        if (!take(bytes, ck.vertices.data(), ck.vertices.size() * sizeof(gpu::vertex_data)) ||
+            !take(bytes, ck.indices.data(), ck.indices.size() * sizeof(gpu::uint)))
+        {
+            return false;
+        }
+    }
+
+    return bytes.empty();
+}
+
+}  // namespace voronoi_fracture
+}  // namespace kryga
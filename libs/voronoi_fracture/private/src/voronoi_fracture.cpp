@@ -1,11 +1,14 @@
 #include "voronoi_fracture/voronoi_fracture.h"
 
+#include <jobs/job_system.h>
+
 #include <manifold/manifold.h>
 #include <voro++.hh>
 
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <functional>
 #include <limits>
 #include <random>
 #include <unordered_map>
@@ -82,6 +85,31 @@ nearest_seed(const glm::vec3& p, const std::vector<glm::vec3>& seeds)
     return best;
 }
 
+// fn(i) for every i in [0, count), spread over the job system's workers when it has
+// any. Each index writes only its own output slot, so results keep their order.
+void
+for_each_index(jobs::job_system* js, uint32_t count, const std::function<void(uint32_t)>& fn)
+{
+    if (!js || js->worker_count() == 0 || count < 2)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            fn(i);
+        }
+        return;
+    }
+
+    js->parallel_for(count,
+                     1,
+                     [&fn](uint32_t begin, uint32_t end)
+                     {
+                         for (uint32_t i = begin; i < end; ++i)
+                         {
+                             fn(i);
+                         }
+                     });
+}
+
 // ── Roughness helpers ───────────────────────────────────────────────────────
 
 uint32_t
@@ -247,8 +275,10 @@ build_input_manifold(const gpu::vertex_data* verts,
     return manifold::Manifold(mesh);
 }
 
-manifold::Manifold
-build_cell_manifold(voro::voronoicell_neighbor& cell, double px, double py, double pz)
+// Cell polyhedron as a triangle mesh. The Manifold is built from it later, off the
+// voro++ loop, which is not thread-safe.
+manifold::MeshGL
+build_cell_mesh(voro::voronoicell_neighbor& cell, double px, double py, double pz)
 {
     std::vector<double> raw_verts;
     cell.vertices(px, py, pz, raw_verts);
@@ -282,7 +312,7 @@ build_cell_manifold(voro::voronoicell_neighbor& cell, double px, double py, doub
         pos += count;
     }
 
-    return manifold::Manifold(mesh);
+    return mesh;
 }
 
 uint32_t
@@ -398,7 +428,8 @@ fracture_mesh(const gpu::vertex_data* vertices,
               uint32_t vertex_count,
               const gpu::uint* indices,
               uint32_t index_count,
-              const fracture_params& params)
+              const fracture_params& params,
+              jobs::job_system* js)
 {
     fracture_result result;
 
@@ -475,7 +506,7 @@ fracture_mesh(const gpu::vertex_data* vertices,
                 int(i), double(fine_seeds[i].x), double(fine_seeds[i].y), double(fine_seeds[i].z));
         }
 
-        std::unordered_map<int, manifold::Manifold> cell_mfs;
+        std::vector<manifold::MeshGL> cell_meshes(fine_count);
 
         voro::voronoicell_neighbor vcell;
         voro::c_loop_all loop(con);
@@ -493,111 +524,136 @@ fracture_mesh(const gpu::vertex_data* vertices,
                     continue;
                 }
 
-                auto mf = build_cell_manifold(vcell, cx, cy, cz);
-                if (mf.Status() == manifold::Manifold::Error::NoError)
-                {
-                    cell_mfs.emplace(id, std::move(mf));
-                }
+                cell_meshes[id] = build_cell_mesh(vcell, cx, cy, cz);
             } while (loop.inc());
         }
 
-        float leaf_roughness = (params.depth <= 1) ? params.roughness : 0.0f;
+        // Empty (default) manifolds mark cells voro++ or Manifold rejected
+        std::vector<manifold::Manifold> cell_mfs(fine_count);
+        for_each_index(js,
+                       fine_count,
+                       [&](uint32_t i)
+                       {
+                           if (cell_meshes[i].triVerts.empty())
+                           {
+                               return;
+                           }
+                           manifold::Manifold mf(cell_meshes[i]);
+                           if (mf.Status() == manifold::Manifold::Error::NoError)
+                           {
+                               cell_mfs[i] = std::move(mf);
+                           }
+                       });
+        cell_meshes.clear();
 
-        result.chunks.reserve(params.cell_count);
+        float leaf_roughness = (params.depth <= 1) ? params.roughness : 0.0f;
 
-        for (uint32_t g = 0; g < params.cell_count; ++g)
-        {
-            std::vector<manifold::Manifold> members;
-            for (uint32_t i = 0; i < fine_count; ++i)
+        // One chunk per group: union its cells, clip the source against them
+        std::vector<chunk> group_chunks(params.cell_count);
+        for_each_index(
+            js,
+            params.cell_count,
+            [&](uint32_t g)
             {
-                if (cell_group[i] != g)
+                std::vector<manifold::Manifold> members;
+                for (uint32_t i = 0; i < fine_count; ++i)
                 {
-                    continue;
+                    if (cell_group[i] == g && !cell_mfs[i].IsEmpty())
+                    {
+                        members.push_back(cell_mfs[i]);
+                    }
                 }
-                auto it = cell_mfs.find(int(i));
-                if (it != cell_mfs.end())
+
+                if (members.empty())
                 {
-                    members.push_back(it->second);
+                    return;
                 }
-            }
 
-            if (members.empty())
-            {
-                continue;
-            }
-
-            manifold::Manifold group_mf;
-            if (members.size() == 1)
-            {
-                group_mf = std::move(members[0]);
-            }
-            else
-            {
-                group_mf = manifold::Manifold::BatchBoolean(members, manifold::OpType::Add);
-            }
+                manifold::Manifold group_mf;
+                if (members.size() == 1)
+                {
+                    group_mf = std::move(members[0]);
+                }
+                else
+                {
+                    group_mf = manifold::Manifold::BatchBoolean(members, manifold::OpType::Add);
+                }
 
-            if (group_mf.IsEmpty())
-            {
-                continue;
-            }
+                if (group_mf.IsEmpty())
+                {
+                    return;
+                }
 
-            auto clipped = input_mf ^ group_mf;
-            if (clipped.IsEmpty())
-            {
-                continue;
-            }
+                auto clipped = input_mf ^ group_mf;
+                if (clipped.IsEmpty())
+                {
+                    return;
+                }
 
-            auto mesh = clipped.GetMeshGL();
+                auto mesh = clipped.GetMeshGL();
 
-            chunk ck;
-            ck.seed_point = group_centers[g];
-            aabb cbox;
+                chunk& ck = group_chunks[g];
+                ck.seed_point = group_centers[g];
+                aabb cbox;
 
-            manifold_to_chunk(
-                mesh, input_id, leaf_roughness, params.seed + g, group_centers[g], ck, cbox);
+                manifold_to_chunk(
+                    mesh, input_id, leaf_roughness, params.seed + g, group_centers[g], ck, cbox);
 
-            if (!ck.vertices.empty())
-            {
                 for (auto& v : ck.vertices)
                 {
                     v.position -= ck.seed_point;
                 }
                 ck.aabb_min = cbox.mn - ck.seed_point;
                 ck.aabb_max = cbox.mx - ck.seed_point;
+            });
+
+        result.chunks.reserve(params.cell_count);
+        for (auto& ck : group_chunks)
+        {
+            if (!ck.vertices.empty())
+            {
                 result.chunks.push_back(std::move(ck));
             }
         }
 
         if (params.depth > 1)
         {
-            std::vector<chunk> refined;
             uint32_t sub_cells = std::max(3u, params.cell_count / 2);
 
+            // Each parent refines on its own; the nested fracture spreads further
+            std::vector<fracture_result> subs(result.chunks.size());
+            for_each_index(js,
+                           uint32_t(result.chunks.size()),
+                           [&](uint32_t i)
+                           {
+                               const auto& parent = result.chunks[i];
+
+                               fracture_params sub;
+                               sub.seed = params.seed * 31 + i * 97 + params.depth * 7919;
+                               sub.cell_count = sub_cells;
+                               sub.fill = fill_mode::convex;
+                               sub.roughness = params.roughness;
+                               sub.depth = params.depth - 1;
+                               sub.detail = 1;
+
+                               subs[i] = fracture_mesh(parent.vertices.data(),
+                                                       uint32_t(parent.vertices.size()),
+                                                       parent.indices.data(),
+                                                       uint32_t(parent.indices.size()),
+                                                       sub,
+                                                       js);
+                           });
+
+            std::vector<chunk> refined;
             for (uint32_t i = 0; i < uint32_t(result.chunks.size()); ++i)
             {
-                auto& parent = result.chunks[i];
-
-                fracture_params sub;
-                sub.seed = params.seed * 31 + i * 97 + params.depth * 7919;
-                sub.cell_count = sub_cells;
-                sub.fill = fill_mode::convex;
-                sub.roughness = params.roughness;
-                sub.depth = params.depth - 1;
-                sub.detail = 1;
-
-                auto sub_result = fracture_mesh(parent.vertices.data(),
-                                                uint32_t(parent.vertices.size()),
-                                                parent.indices.data(),
-                                                uint32_t(parent.indices.size()),
-                                                sub);
-
-                if (sub_result.chunks.empty())
+                if (subs[i].chunks.empty())
                 {
-                    refined.push_back(std::move(parent));
+                    refined.push_back(std::move(result.chunks[i]));
                 }
                 else
                 {
-                    for (auto& sc : sub_result.chunks)
+                    for (auto& sc : subs[i].chunks)
                     {
                         refined.push_back(std::move(sc));
                     }
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include <voronoi_fracture/fracture_cache.h>
+#include <voronoi_fracture/voronoi_fracture.h>
+
+#include <jobs/job_system.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace kryga;
+using namespace kryga::voronoi_fracture;
+
+namespace
+{
+
+struct test_mesh
+{
+    std::vector<gpu::vertex_data> vertices;
+    std::vector<gpu::uint> indices;
+
+    fracture_result
+    fracture(const fracture_params& params, jobs::job_system* js = nullptr) const
+    {
+        return fracture_mesh(vertices.data(),
+                             static_cast<uint32_t>(vertices.size()),
+                             indices.data(),
+                             static_cast<uint32_t>(indices.size()),
+                             params,
+                             js);
+    }
+
+    uint64_t
+    key(const fracture_params& params) const
+    {
+        return cache_key(vertices.data(),
+                         static_cast<uint32_t>(vertices.size()),
+                         indices.data(),
+                         static_cast<uint32_t>(indices.size()),
+                         params);
+    }
+};
+
+// Closed unit sphere, enough triangles for every cell to get some
+test_mesh
+make_sphere(uint32_t rings, uint32_t segments)
+{
+    test_mesh m;
+    for (uint32_t r = 0; r <= rings; ++r)
+    {
+        for (uint32_t s = 0; s <= segments; ++s)
+        {
+            float theta = float(r) / float(rings) * 3.14159265f;
+            float phi = float(s) / float(segments) * 6.28318531f;
+            glm::vec3 p(
+                std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+
+            gpu::vertex_data v{};
+            v.position = p;
+            v.normal = p;
+            v.uv = {float(s) / float(segments), float(r) / float(rings)};
+            m.vertices.push_back(v);
+        }
+    }
+
+    for (uint32_t r = 0; r < rings; ++r)
+    {
+        for (uint32_t s = 0; s < segments; ++s)
+        {
+            gpu::uint i = r * (segments + 1) + s;
+            gpu::uint j = i + segments + 1;
+            m.indices.insert(m.indices.end(), {i, j, i + 1, i + 1, j, j + 1});
+        }
+    }
+    return m;
+}
+
+void
+expect_same(const fracture_result& a, const fracture_result& b)
+{
+    EXPECT_EQ(a.aabb_min, b.aabb_min);
+    EXPECT_EQ(a.aabb_max, b.aabb_max);
+    ASSERT_EQ(a.chunks.size(), b.chunks.size());
+
+    for (size_t i = 0; i < a.chunks.size(); ++i)
+    {
+        const auto& ca = a.chunks[i];
+        const auto& cb = b.chunks[i];
+        EXPECT_EQ(ca.aabb_min, cb.aabb_min) << "chunk " << i;
+        EXPECT_EQ(ca.aabb_max, cb.aabb_max) << "chunk " << i;
+        EXPECT_EQ(ca.seed_point, cb.seed_point) << "chunk " << i;
+        EXPECT_EQ(ca.indices, cb.indices) << "chunk " << i;
+        ASSERT_EQ(ca.vertices.size(), cb.vertices.size()) << "chunk " << i;
+        EXPECT_EQ(std::memcmp(ca.vertices.data(),
+                              cb.vertices.data(),
+                              ca.vertices.size() * sizeof(gpu::vertex_data)),
+                  0)
+            << "chunk " << i;
+    }
+}
+
+}  // namespace
+
+TEST(voronoi_fracture, cache_round_trip)
+{
+    auto mesh = make_sphere(12, 24);
+    auto result = mesh.fracture(destructible_fracture_params(7, 6));
+    ASSERT_FALSE(result.chunks.empty());
+
+    auto bytes = serialize(result);
+
+    fracture_result loaded;
+    ASSERT_TRUE(deserialize(bytes, loaded));
+    expect_same(result, loaded);
+
+    // No chunks is a valid result too
+    fracture_result empty;
+    ASSERT_TRUE(deserialize(serialize(empty), loaded));
+    EXPECT_TRUE(loaded.chunks.empty());
+}
+
+TEST(voronoi_fracture, cache_rejects_damaged_input)
+{
+    auto mesh = make_sphere(12, 24);
+    auto bytes = serialize(mesh.fracture(destructible_fracture_params(7, 6)));
+
+    fracture_result out;
+    EXPECT_FALSE(deserialize({}, out));
+
+    // Cut anywhere: inside the header, a chunk record or a chunk's arrays
+    for (size_t size : {size_t(4), size_t(20), bytes.size() / 2, bytes.size() - 1})
+    {
+        EXPECT_FALSE(deserialize(std::span(bytes).first(size), out)) << "size " << size;
+    }
+
+    // Trailing bytes
+    auto longer = bytes;
+    longer.push_back(0);
+    EXPECT_FALSE(deserialize(longer, out));
+
+    auto bad_magic = bytes;
+    bad_magic[0] ^= 0xff;
+    EXPECT_FALSE(deserialize(bad_magic, out));
+
+    // Header: magic, version, chunk_count. A count the data cannot hold fails
+    // before anything is reserved for it.
+    auto bad_count = bytes;
+    const uint32_t huge = 0xffffffffu;
+    std::memcpy(bad_count.data() + 8, &huge, sizeof(huge));
+    EXPECT_FALSE(deserialize(bad_count, out));
+}
+
+TEST(voronoi_fracture, cache_key_covers_geometry_and_every_parameter)
+{
+    auto mesh = make_sphere(6, 12);
+    const fracture_params base = destructible_fracture_params(7, 6);
+    const uint64_t key = mesh.key(base);
+
+    EXPECT_EQ(mesh.key(base), key);
+
+    auto changed = [&](auto&& edit)
+    {
+        fracture_params p = base;
+        edit(p);
+        return mesh.key(p) != key;
+    };
+    EXPECT_TRUE(changed([](fracture_params& p) { p.seed += 1; }));
+    EXPECT_TRUE(changed([](fracture_params& p) { p.cell_count += 1; }));
+    EXPECT_TRUE(changed([](fracture_params& p) { p.fill = fill_mode::surface; }));
+    EXPECT_TRUE(changed([](fracture_params& p) { p.roughness += 0.01f; }));
+    EXPECT_TRUE(changed([](fracture_params& p) { p.depth += 1; }));
+    EXPECT_TRUE(changed([](fracture_params& p) { p.detail += 1; }));
+
+    auto moved = mesh;
+    moved.vertices[3].position.x += 0.001f;
+    EXPECT_NE(moved.key(base), key);
+
+    auto rewound = mesh;
+    std::swap(rewound.indices[0], rewound.indices[1]);
+    EXPECT_NE(rewound.key(base), key);
+
+    EXPECT_NE(cache_file_name("rock", key), cache_file_name("rock", key + 1));
+}
+
+TEST(voronoi_fracture, job_system_gives_the_serial_result)
+{
+    auto mesh = make_sphere(16, 32);
+
+    jobs::job_system js;
+    js.start(3);
+
+    fracture_params convex = destructible_fracture_params(11, 8);
+    fracture_params refined = convex;
+    refined.depth = 2;
+    fracture_params surface;
+    surface.seed = 3;
+    surface.cell_count = 8;
+
+    for (const auto& params : {convex, refined, surface})
+    {
+        auto serial = mesh.fracture(params);
+        ASSERT_FALSE(serial.chunks.empty());
+        expect_same(serial, mesh.fracture(params, &js));
+    }
+
+    js.stop();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <voronoi_fracture/voronoi_fracture.h>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kryga
+{
+namespace voronoi_fracture
+{
+
+// Pre-fractured results on disk, named `<mesh stem>_<key>.afrac` beside the source
+// mesh's vertex file
+constexpr const char* k_cache_extension = ".afrac";
+
+// What destructible_mesh_asset fractures with. The cooker pre-fractures with the same
+// values, so its files match the runtime key.
+fracture_params
+destructible_fracture_params(uint32_t seed, uint32_t cell_count);
+
+// Identifies a fracture result: the source geometry bytes plus every parameter. Also
+// covers the algorithm version, so cooked files go stale when the fracture changes.
+uint64_t
+cache_key(const gpu::vertex_data* vertices,
+          uint32_t vertex_count,
+          const gpu::uint* indices,
+          uint32_t index_count,
+          const fracture_params& params);
+
+std::string
+cache_file_name(std::string_view mesh_stem, uint64_t key);
+
+std::vector<uint8_t>
+serialize(const fracture_result& result);
+
+bool
+deserialize(std::span<const uint8_t> bytes, fracture_result& out);
+
+}  // namespace voronoi_fracture
+}  // namespace kryga
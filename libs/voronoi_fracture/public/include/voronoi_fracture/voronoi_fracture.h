@@ -9,6 +9,11 @@
 
 namespace kryga
 {
+namespace jobs
+{
+class job_system;
+}
+
 namespace voronoi_fracture
 {
 
@@ -58,12 +63,16 @@ struct fracture_result
 // surface mode for degenerate chunks (< 4 non-coplanar vertices).
 //
 // Empty cells (no triangles assigned) are dropped from the result.
+//
+// With a job system, the convex path builds cell solids, clips chunks and refines
+// depth levels on its workers. The result is the same either way.
 fracture_result
 fracture_mesh(const gpu::vertex_data* vertices,
               uint32_t vertex_count,
               const gpu::uint* indices,
               uint32_t index_count,
-              const fracture_params& params);
+              const fracture_params& params,
+              jobs::job_system* js = nullptr);
 
 }  // namespace voronoi_fracture
 }  // namespace kryga
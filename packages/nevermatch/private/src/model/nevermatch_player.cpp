@@ -258,6 +258,7 @@ nevermatch_player::tick_snap_orbit(float dt)
 
     if (std::fabs(m_zoom_input) > 0.01f)
     {
+        before_write();
         m_orbit_radius += m_zoom_input * m_zoom_speed * dt;
         m_orbit_radius = glm::clamp(m_orbit_radius, m_min_radius, m_max_radius);
         m_zoom_input = 0.f;
@@ -356,6 +357,7 @@ nevermatch_player::tick_mouse_orbit(float dt)
 
     if (std::fabs(m_zoom_input) > 0.01f)
     {
+        before_write();
         m_orbit_radius += m_zoom_input * m_zoom_speed * dt;
         m_orbit_radius = glm::clamp(m_orbit_radius, m_min_radius, m_max_radius);
         m_zoom_input = 0.f;
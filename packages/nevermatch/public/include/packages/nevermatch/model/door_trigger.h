@@ -13,7 +13,8 @@ namespace kryga::nevermatch
 //
 // clang-format off
 KRG_ar_class(
-    mcp_hint = "Example doorway entity that names the level it leads to."
+    mcp_hint = "Example doorway entity that names the level it leads to.",
+    tick_phase = pre_physics
 );
 class door_trigger : public ::kryga::root::game_object
 // clang-format on
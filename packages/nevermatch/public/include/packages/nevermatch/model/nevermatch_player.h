@@ -21,7 +21,10 @@ enum class orbit_mode
 // mouse_orbit (mouse drags camera, WASD rotates the target cube).
 // clang-format off
 KRG_ar_class(
-    mcp_hint = "Player with orbit camera: snap_orbit - WASD rotates camera 90deg, mouse_orbit - mouse drags camera, WASD rotates target cube"
+    mcp_hint = "Player with orbit camera: snap_orbit - WASD rotates camera 90deg, mouse_orbit - mouse drags camera, WASD rotates target cube",
+    tick_phase = pre_physics,
+    tick_reads = input,
+    tick_writes = transform|camera
 );
 class nevermatch_player : public ::kryga::root::player
 // clang-format on
@@ -17,6 +17,9 @@ mesh::construct(this_class::construct_params& params)
 
     m_indices = params.indices;
     m_vertices = params.vertices;
+    m_shadow_indices = params.shadow_indices;
+    m_lod_indices = params.lod_indices;
+    m_lod_ranges = params.lod_ranges;
 
     return true;
 }
@@ -48,6 +48,7 @@ audio_emitter_component::play()
     msg.max_distance = m_max_distance;
     emit_audio_message(msg);
 
+    before_write();
     m_playing = true;
     // The play message already carries this position; record it so on_tick won't
     // re-send it next frame.
@@ -62,6 +63,7 @@ audio_emitter_component::stop()
     msg.voice_id = get_id();
     emit_audio_message(msg);
 
+    before_write();
     m_playing = false;
 }
 
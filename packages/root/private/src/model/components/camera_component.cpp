@@ -14,6 +14,7 @@ KRG_gen_class_cd_default(camera_component);
 void
 camera_component::set_active_camera(bool v)
 {
+    before_write();
     m_is_active_camera = v;
 
     // Register into THIS object's level (not glob current_level): this also runs at
@@ -36,6 +37,7 @@ camera_component::set_active_camera(bool v)
             {
                 if (auto* pcc = pc->as<camera_component>())
                 {
+                    pcc->before_write();
                     pcc->m_is_active_camera = false;
                 }
             }
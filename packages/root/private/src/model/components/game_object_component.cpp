@@ -56,6 +56,7 @@ game_object_component::get_right_vector() const
 void
 game_object_component::move(const vec3& delta)
 {
+    before_write();
     m_position += delta.as_glm();
 
     update_children_matrixes();
@@ -66,6 +67,7 @@ game_object_component::move(const vec3& delta)
 void
 game_object_component::rotate(const vec3& delta)
 {
+    before_write();
     m_rotation += delta.as_glm();
 
     update_children_matrixes();
@@ -1,5 +1,6 @@
 #include "packages/root/model/smart_object.h"
 
+#include <core/level.h>
 #include <core/reflection/reflection_type.h>
 
 #include <utils/defines_utils.h>
@@ -12,6 +13,16 @@ namespace root
 
 KRG_gen_class_cd_default(smart_object);
 
+void
+smart_object::before_write()
+{
+    if (m_level)
+    {
+        m_level->get_tick_scheduler().note_write(*this);
+        m_level->capture_pre_image(*this);
+    }
+}
+
 bool
 smart_object::post_construct()
 {
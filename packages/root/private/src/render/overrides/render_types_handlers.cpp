@@ -114,6 +114,24 @@ mesh__cmd_builder(reflection::type_context__render_cmd_build& ctx)
     cmd->handle = msh_model.render_handle();
     cmd->vertices = std::make_shared<utils::buffer>(msh_model.get_vertices_buffer());
     cmd->indices = std::make_shared<utils::buffer>(msh_model.get_indices_buffer());
+    if (msh_model.get_shadow_indices_buffer().size())
+    {
+        cmd->shadow_indices =
+            std::make_shared<utils::buffer>(msh_model.get_shadow_indices_buffer());
+    }
+    if (msh_model.get_lod_indices_buffer().size() && msh_model.get_lod_ranges_buffer().size())
+    {
+        cmd->lod_indices = std::make_shared<utils::buffer>(msh_model.get_lod_indices_buffer());
+
+        auto rv = msh_model.get_lod_ranges_buffer().make_view<root::mesh_lod_range>();
+        for (uint32_t i = 0; i < rv.size(); ++i)
+        {
+            const auto& r = rv.at(i);
+            cmd->lods.push_back({.first_index = r.first_index,
+                                 .index_count = r.index_count,
+                                 .error = r.error});
+        }
+    }
     cmd->skinned = false;
 
     msh_model.set_render_built(true);
@@ -16,6 +16,7 @@
 #include "packages/root/model/assets/solid_color_material.h"
 #include "packages/root/model/assets/simple_texture_material.h"
 #include "packages/root/render/overrides/render_types_handlers.h"
+#include "packages/root/render/terrain_builder.h"
 #include "glue/type_ids.ar.h"
 
 #include "packages/root/model/components/mesh_component.h"
@@ -26,6 +27,7 @@
 #include "packages/root/model/assets/terrain_splatmap_material.h"
 #include "packages/root/model/game_object.h"
 
+#include <voronoi_fracture/fracture_cache.h>
 #include <voronoi_fracture/voronoi_fracture.h>
 
 #include <physics/physics_types.h>
@@ -71,8 +73,7 @@
 #include <vulkan_render/render_system.h>
 #include <vulkan_render/kryga_render.h>
 
-#include <animation/gltf_animation_loader.h>
-#include <animation/ozz_loader.h>
+#include <animation/animation_bundle.h>
 #include <animation/animation_system.h>
 
 #include <ozz/animation/runtime/skeleton.h>
@@ -80,15 +81,21 @@
 
 #include <vfs/vfs.h>
 
+#include <jobs/job_system.h>
+
 #include <utils/buffer.h>
 #include <utils/path.h>
 #include <utils/kryga_log.h>
 #include <utils/string_utility.h>
 #include <utils/dynamic_object_builder.h>
 
+#include <algorithm>
+#include <bit>
 #include <filesystem>
+#include <functional>
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <vector>
 
 namespace kryga
@@ -546,148 +553,95 @@ animated_mesh_component__cmd_builder(reflection::type_context__render_cmd_build&
 
     if (!anim_sys.get_skeleton(skeleton_id))
     {
-        auto ozz_dir = dir_path;
-        auto skel_test = (dir_path / (stem + "_skeleton.ozz"));
-        if (!skel_test.exists())
+        // Cooked trees carry `<stem>.aanim` next to the glTF: one mapped read instead of
+        // parsing the glTF and scanning for clips. Uncooked sources build the same bundle
+        // in memory.
+        animation::animation_bundle bundle;
+        auto bundle_path = dir_path / (stem + animation::animation_bundle::k_extension);
+        if (bundle_path.exists())
         {
-            auto& vfs = glob::glob_state().getr_vfs();
-            auto pkg_root_rp = vfs.real_path(vfs::rid("data://packages"));
-            bool found = false;
-            for (const auto& entry :
-                 std::filesystem::recursive_directory_iterator(pkg_root_rp.value()))
-            {
-                if (!entry.is_regular_file())
-                {
-                    continue;
-                }
-                if (entry.path().filename().generic_string() == stem + "_skeleton.ozz")
-                {
-                    ozz_dir = utils::path(entry.path().parent_path());
-                    found = true;
-                    break;
-                }
-            }
-            if (!found)
+            if (!bundle.open(bundle_path))
             {
-                ALOG_ERROR("Cannot find {}_skeleton.ozz in packages", stem);
+                ALOG_LAZY_ERROR;
                 return result_code::failed;
             }
         }
-
-        auto skel_path = (ozz_dir / (stem + "_skeleton.ozz")).str();
-        ozz::animation::Skeleton ozz_skeleton;
-        if (!animation::ozz_loader::load_skeleton(skel_path, ozz_skeleton))
-        {
-            ALOG_LAZY_ERROR;
-            return result_code::failed;
-        }
-
-        auto dir_str = ozz_dir.str();
-        std::string skel_suffix = "_skeleton.ozz";
-
-        for (const auto& entry : std::filesystem::directory_iterator(dir_str))
+        else
         {
-            if (!entry.is_regular_file())
-            {
-                continue;
-            }
-
-            auto fname = entry.path().filename().generic_string();
-            if (fname.size() <= stem.size() + 1)
-            {
-                continue;
-            }
-
-            if (fname.substr(0, stem.size() + 1) != stem + "_")
-            {
-                continue;
-            }
-
-            if (fname.size() < 4 || fname.substr(fname.size() - 4) != ".ozz")
+            auto ozz_dir = dir_path;
+            if (!(dir_path / (stem + "_skeleton.ozz")).exists())
             {
-                continue;
-            }
-
-            if (fname.size() >= skel_suffix.size() &&
-                fname.substr(fname.size() - skel_suffix.size()) == skel_suffix)
-            {
-                continue;
+                auto& vfs = glob::glob_state().getr_vfs();
+                auto pkg_root_rp = vfs.real_path(vfs::rid("data://packages"));
+                bool found = false;
+                for (const auto& entry :
+                     std::filesystem::recursive_directory_iterator(pkg_root_rp.value()))
+                {
+                    if (!entry.is_regular_file())
+                    {
+                        continue;
+                    }
+                    if (entry.path().filename().generic_string() == stem + "_skeleton.ozz")
+                    {
+                        ozz_dir = utils::path(entry.path().parent_path());
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found)
+                {
+                    ALOG_ERROR("Cannot find {}_skeleton.ozz in packages", stem);
+                    return result_code::failed;
+                }
             }
 
-            auto clip_name = fname.substr(stem.size() + 1, fname.size() - stem.size() - 1 - 4);
+            ALOG_WARN("No cooked {}, building it from sources", bundle_path.str());
 
-            auto anim_path = (ozz_dir / fname).str();
-            ozz::animation::Animation ozz_anim;
-            if (animation::ozz_loader::load_animation(anim_path, ozz_anim))
+            animation::animation_bundle_source src;
+            if (!animation::animation_bundle::build(gltf_path, ozz_dir, src) ||
+                !bundle.open(animation::animation_bundle::serialize(src)))
             {
-                anim_sys.register_animation(skeleton_id, AID(clip_name), std::move(ozz_anim));
+                ALOG_LAZY_ERROR;
+                return result_code::failed;
             }
         }
 
-        animation::gltf_load_result gltf_result;
-        if (!animation::gltf_animation_loader::load(amc.get_gltf(), gltf_result))
+        ozz::animation::Skeleton ozz_skeleton;
+        if (!bundle.load_skeleton(ozz_skeleton))
         {
             ALOG_LAZY_ERROR;
             return result_code::failed;
         }
 
-        std::vector<int32_t> joint_remaps(gltf_result.joint_names.size(), -1);
-        auto ozz_names = ozz_skeleton.joint_names();
-        for (size_t mesh_bone = 0; mesh_bone < gltf_result.joint_names.size(); ++mesh_bone)
+        for (uint32_t i = 0; i < bundle.clip_count(); ++i)
         {
-            const auto& name = gltf_result.joint_names[mesh_bone];
-            for (int ozz_j = 0; ozz_j < ozz_skeleton.num_joints(); ++ozz_j)
-            {
-                if (name == ozz_names[ozz_j])
-                {
-                    joint_remaps[mesh_bone] = ozz_j;
-                    break;
-                }
-            }
-
-            if (joint_remaps[mesh_bone] < 0)
+            ozz::animation::Animation ozz_anim;
+            if (bundle.load_clip(i, ozz_anim))
             {
-                ALOG_WARN("Joint '{}' in glTF mesh not found in ozz skeleton", name);
+                anim_sys.register_animation(
+                    skeleton_id, AID(std::string(bundle.clip_name(i))), std::move(ozz_anim));
             }
         }
 
+        auto inverse_binds = bundle.inverse_bind_matrices();
+        auto joint_remaps = bundle.joint_remaps();
         anim_sys.register_skeleton(skeleton_id,
                                    std::move(ozz_skeleton),
-                                   std::move(gltf_result.inverse_bind_matrices),
-                                   std::move(joint_remaps));
+                                   {inverse_binds.begin(), inverse_binds.end()},
+                                   {joint_remaps.begin(), joint_remaps.end()});
 
-        if (!gltf_result.meshes.empty() && !anim_sys.has_skinned_mesh(skeleton_id))
+        if (!bundle.vertices().empty() && !anim_sys.has_skinned_mesh(skeleton_id))
         {
-            auto& gltf_mesh = gltf_result.meshes[0];
+            amc.set_base_bounding_radius(bundle.bounding_radius());
+            amc.set_base_centroid(bundle.centroid());
 
-            glm::vec3 vmin{std::numeric_limits<float>::max()};
-            glm::vec3 vmax{std::numeric_limits<float>::lowest()};
-            for (const auto& v : gltf_mesh.vertices)
-            {
-                vmin = glm::min(vmin, v.position);
-                vmax = glm::max(vmax, v.position);
-            }
-            glm::vec3 amc_centroid = (vmin + vmax) * 0.5f;
-            float max_dc_sq = 0.0f;
-            for (const auto& v : gltf_mesh.vertices)
-            {
-                glm::vec3 d = v.position - amc_centroid;
-                max_dc_sq = std::max(max_dc_sq, glm::dot(d, d));
-            }
-            amc.set_base_bounding_radius(std::sqrt(max_dc_sq));
-            amc.set_base_centroid(amc_centroid);
-
-            auto vert_buf = std::make_shared<utils::buffer>(gltf_mesh.vertices.size() *
-                                                            sizeof(gpu::skinned_vertex_data));
-            memcpy(vert_buf->data(),
-                   gltf_mesh.vertices.data(),
-                   gltf_mesh.vertices.size() * sizeof(gpu::skinned_vertex_data));
+            auto vertices = std::as_bytes(bundle.vertices());
+            auto vert_buf = std::make_shared<utils::buffer>(vertices.size());
+            memcpy(vert_buf->data(), vertices.data(), vertices.size());
 
-            auto idx_buf =
-                std::make_shared<utils::buffer>(gltf_mesh.indices.size() * sizeof(gpu::uint));
-            memcpy(idx_buf->data(),
-                   gltf_mesh.indices.data(),
-                   gltf_mesh.indices.size() * sizeof(gpu::uint));
+            auto indices = std::as_bytes(bundle.indices());
+            auto idx_buf = std::make_shared<utils::buffer>(indices.size());
+            memcpy(idx_buf->data(), indices.data(), indices.size());
 
             anim_sys.set_skinned_mesh_created(skeleton_id);
 
@@ -696,8 +650,6 @@ animated_mesh_component__cmd_builder(reflection::type_context__render_cmd_build&
             auto skinned_handle = ctx.rb->meshes_alloc().reserve();
             anim_sys.set_skinned_mesh_handle(skeleton_id, skinned_handle);
 
-            // create_skinned_mesh_cmd now lives in render_translator/render_commands.h.
-
             auto* cmd = ctx.rb->alloc_cmd<create_skinned_mesh_cmd>();
             cmd->id = mesh_id;
             cmd->handle = skinned_handle;
@@ -842,6 +794,81 @@ chunk_render_id_for(const utils::id& component_id, uint32_t i)
     return AID(std::string(component_id.cstr()) + "::chunk_obj_" + std::to_string(i));
 }
 
+// Where the cooker puts the pre-fracture for `key`: beside the source mesh's vertex file
+vfs::rid
+cooked_fracture_rid(const utils::buffer& vertices, uint64_t key)
+{
+    const vfs::rid src(vertices.get_vpath());
+    const std::string_view rel = src.relative();
+
+    const auto slash = rel.rfind('/');
+    const auto dir = rel.substr(0, (slash == std::string_view::npos) ? 0 : slash + 1);
+    auto stem = rel.substr(dir.size());
+    stem = stem.substr(0, stem.rfind('.'));
+
+    return vfs::rid(src.mount_point(),
+                    std::string(dir) + voronoi_fracture::cache_file_name(stem, key));
+}
+
+// The asset's fracture, shared by all its components: the cached one while the source
+// and parameters are unchanged, else the cooked file, else a fresh fracture spread
+// over the job system.
+std::shared_ptr<const voronoi_fracture::fracture_result>
+acquire_fracture(root::destructible_mesh_asset& asset, root::mesh& source)
+{
+    auto vbuf = source.get_vertices_buffer().make_view<gpu::vertex_data>();
+    auto ibuf = source.get_indices_buffer().make_view<gpu::uint>();
+
+    const auto params = voronoi_fracture::destructible_fracture_params(
+        asset.get_fracture_seed(), asset.get_cell_count());
+    const uint64_t key = voronoi_fracture::cache_key(vbuf.as(),
+                                                     static_cast<uint32_t>(vbuf.size()),
+                                                     ibuf.as(),
+                                                     static_cast<uint32_t>(ibuf.size()),
+                                                     params);
+
+    auto& cache = asset.cached_fracture();
+    if (cache.result && cache.key == key)
+    {
+        return cache.result;
+    }
+
+    auto result = std::make_shared<voronoi_fracture::fracture_result>();
+
+    bool cooked = false;
+    if (!source.get_vertices_buffer().get_vpath().empty())
+    {
+        auto& vfs = glob::glob_state().getr_vfs();
+        auto rid = cooked_fracture_rid(source.get_vertices_buffer(), key);
+
+        std::vector<uint8_t> blob;
+        if (vfs.exists(rid) && vfs.read_bytes(rid, blob))
+        {
+            cooked = voronoi_fracture::deserialize(blob, *result);
+            if (!cooked)
+            {
+                ALOG_WARN("destructible_mesh {}: '{}' is not a valid fracture, rebuilding",
+                          asset.get_id().str(),
+                          rid.str());
+            }
+        }
+    }
+
+    if (!cooked)
+    {
+        *result = voronoi_fracture::fracture_mesh(vbuf.as(),
+                                                  static_cast<uint32_t>(vbuf.size()),
+                                                  ibuf.as(),
+                                                  static_cast<uint32_t>(ibuf.size()),
+                                                  params,
+                                                  glob::glob_state().get_job_system());
+    }
+
+    cache.key = key;
+    cache.result = std::move(result);
+    return cache.result;
+}
+
 }  // namespace
 
 result_code
@@ -901,20 +928,8 @@ destructible_mesh_component__cmd_builder(reflection::type_context__render_cmd_bu
     {
         auto& chunk_shapes = dmc.get_chunk_shapes();
 
-        auto vbuf = source_mesh->get_vertices_buffer().make_view<gpu::vertex_data>();
-        auto ibuf = source_mesh->get_indices_buffer().make_view<gpu::uint>();
-
-        voronoi_fracture::fracture_params fparams{};
-        fparams.seed = asset->get_fracture_seed();
-        fparams.cell_count = asset->get_cell_count();
-        fparams.fill = voronoi_fracture::fill_mode::convex;
-        fparams.roughness = 0.15f;
-
-        auto fresult = voronoi_fracture::fracture_mesh(vbuf.as(),
-                                                       static_cast<uint32_t>(vbuf.size()),
-                                                       ibuf.as(),
-                                                       static_cast<uint32_t>(ibuf.size()),
-                                                       fparams);
+        const auto fresult_ref = acquire_fracture(*asset, *source_mesh);
+        const auto& fresult = *fresult_ref;
 
         chunk_shapes.clear();
         chunk_shapes.reserve(fresult.chunks.size());
@@ -1224,9 +1239,11 @@ destructible_mesh_component__cmd_destroyer(reflection::type_context__render_cmd_
 // Command builders — terrain_component
 //
 // Terrain geometry is *derived data*, not a persisted mesh asset: the builder
-// generates a grid mesh from a heightmap (or procedural fbm noise) and uploads
-// it under a synthesized id, then renders it through the regular object path
-// (create_object_cmd) with a terrain_splatmap_material.
+// generates a grid from a heightmap (or procedural fbm noise), splits it into
+// square chunks and uploads them as one chunked mesh under a synthesized id. Each
+// chunk renders through the regular object path (create_object_cmd) with a
+// terrain_splatmap_material, so it is frustum- and shadow-culled on its own bounds,
+// and draws one of the mesh's shared per-level index lists (CDLOD).
 // ============================================================================
 
 namespace
@@ -1238,60 +1255,38 @@ terrain_mesh_id_for(const utils::id& component_id)
     return AID(std::string(component_id.cstr()) + "::terrain_mesh");
 }
 
-// Integer hash → [0,1). Deterministic for a given (x, y, seed).
-float
-terrain_hash(int32_t x, int32_t y, uint32_t seed)
+// Render and physics share the layout, so the collider matches the finest level
+root::terrain_layout
+terrain_layout_for(const root::terrain_component& tc)
 {
-    uint32_t h = seed + 0x9E3779B9u;
-    h ^= static_cast<uint32_t>(x) * 0x85EBCA6Bu;
-    h = (h ^ (h >> 13)) * 0xC2B2AE35u;
-    h ^= static_cast<uint32_t>(y) * 0x27D4EB2Fu;
-    h = (h ^ (h >> 16)) * 0x165667B1u;
-    h ^= h >> 15;
-    return static_cast<float>(h & 0x00FFFFFFu) / static_cast<float>(0x01000000u);
+    return root::terrain_layout_for_resolution(tc.get_resolution());
 }
 
 float
-terrain_value_noise(float x, float y, uint32_t seed)
+max_abs_scale(const root::terrain_component& tc)
 {
-    float fx = std::floor(x);
-    float fy = std::floor(y);
-    auto x0 = static_cast<int32_t>(fx);
-    auto y0 = static_cast<int32_t>(fy);
-    float tx = x - fx;
-    float ty = y - fy;
-
-    float v00 = terrain_hash(x0, y0, seed);
-    float v10 = terrain_hash(x0 + 1, y0, seed);
-    float v01 = terrain_hash(x0, y0 + 1, seed);
-    float v11 = terrain_hash(x0 + 1, y0 + 1, seed);
-
-    float ux = tx * tx * (3.0f - 2.0f * tx);
-    float uy = ty * ty * (3.0f - 2.0f * ty);
-
-    float a = glm::mix(v00, v10, ux);
-    float b = glm::mix(v01, v11, ux);
-    return glm::mix(a, b, uy);
+    auto scale = tc.get_scale();
+    return glm::max(glm::max(glm::abs(scale.x), glm::abs(scale.y)), glm::abs(scale.z));
 }
 
-// fbm in [0,1]. u,v in [0,1] across the terrain.
-float
-terrain_fbm(float u, float v, const root::terrain_component& tc)
+utils::id
+terrain_chunk_id_for(const utils::id& component_id, size_t chunk)
 {
-    float freq = tc.get_frequency();
-    float amp = 1.0f;
-    float sum = 0.0f;
-    float total_amp = 0.0f;
-    uint32_t octaves = glm::clamp<uint32_t>(tc.get_octaves(), 1u, 8u);
+    return AID(std::string(component_id.cstr()) + "::terrain_chunk_" + std::to_string(chunk));
+}
 
-    for (uint32_t o = 0; o < octaves; ++o)
+// fn(begin, end) over the rows [0, res), spread over the job system's workers when
+// it has any
+void
+for_each_row_range(uint32_t res, const std::function<void(uint32_t, uint32_t)>& fn)
+{
+    auto* js = glob::glob_state().get_job_system();
+    if (!js || js->worker_count() == 0)
     {
-        sum += amp * terrain_value_noise(u * freq, v * freq, tc.get_seed() + o * 1013u);
-        total_amp += amp;
-        freq *= tc.get_lacunarity();
-        amp *= tc.get_gain();
+        fn(0, res);
+        return;
     }
-    return (total_amp > 0.0f) ? sum / total_amp : 0.0f;
+    js->parallel_for(res, 16, fn);
 }
 
 // Build the normalized [0,1] height field for the terrain into `heights`
@@ -1300,6 +1295,7 @@ bool
 build_height_field(const root::terrain_component& tc, uint32_t res, std::vector<float>& heights)
 {
     heights.assign(static_cast<size_t>(res) * res, 0.0f);
+    const float inv_res = (res > 1) ? 1.0f / float(res - 1) : 0.0f;
 
     if (tc.get_source_mode() == root::terrain_source_heightmap)
     {
@@ -1323,44 +1319,88 @@ build_height_field(const root::terrain_component& tc, uint32_t res, std::vector<
         }
 
         const uint8_t* px = pixels.data();
-        for (uint32_t j = 0; j < res; ++j)
+        auto red = [&](uint32_t x, uint32_t y)
+        { return float(px[(size_t(y) * hw + x) * 4]) / 255.0f; };
+
+        for_each_row_range(
+            res,
+            [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t j = begin; j < end; ++j)
+                {
+                    // Bilinear sample of the red channel at this grid uv.
+                    float fy = float(j) * inv_res * float(hh - 1);
+                    auto y0 = static_cast<uint32_t>(fy);
+                    uint32_t y1 = glm::min(y0 + 1, hh - 1);
+                    float ty = fy - float(y0);
+
+                    float* row = heights.data() + size_t(j) * res;
+                    for (uint32_t i = 0; i < res; ++i)
+                    {
+                        float fx = float(i) * inv_res * float(hw - 1);
+                        auto x0 = static_cast<uint32_t>(fx);
+                        uint32_t x1 = glm::min(x0 + 1, hw - 1);
+                        float tx = fx - float(x0);
+
+                        float a = glm::mix(red(x0, y0), red(x1, y0), tx);
+                        float b = glm::mix(red(x0, y1), red(x1, y1), tx);
+                        row[i] = glm::mix(a, b, ty);
+                    }
+                }
+            });
+        return true;
+    }
+
+    // Procedural noise, k_terrain_noise_lanes samples at a time.
+    const root::terrain_noise noise = root::terrain_height_params_for(tc, res).noise;
+
+    for_each_row_range(
+        res,
+        [&](uint32_t begin, uint32_t end)
         {
-            for (uint32_t i = 0; i < res; ++i)
+            float u[root::k_terrain_noise_lanes];
+            float out[root::k_terrain_noise_lanes];
+            for (uint32_t j = begin; j < end; ++j)
             {
-                // Bilinear sample of the red channel at this grid uv.
-                float u = (res > 1) ? float(i) / float(res - 1) : 0.0f;
-                float v = (res > 1) ? float(j) / float(res - 1) : 0.0f;
-                float fx = u * float(hw - 1);
-                float fy = v * float(hh - 1);
-                auto x0 = static_cast<uint32_t>(fx);
-                auto y0 = static_cast<uint32_t>(fy);
-                uint32_t x1 = glm::min(x0 + 1, hw - 1);
-                uint32_t y1 = glm::min(y0 + 1, hh - 1);
-                float tx = fx - float(x0);
-                float ty = fy - float(y0);
-
-                auto red = [&](uint32_t x, uint32_t y)
-                { return float(px[(size_t(y) * hw + x) * 4]) / 255.0f; };
-
-                float a = glm::mix(red(x0, y0), red(x1, y0), tx);
-                float b = glm::mix(red(x0, y1), red(x1, y1), tx);
-                heights[size_t(j) * res + i] = glm::mix(a, b, ty);
+                const float v = float(j) * inv_res;
+                float* row = heights.data() + size_t(j) * res;
+                for (uint32_t i = 0; i < res; i += root::k_terrain_noise_lanes)
+                {
+                    for (uint32_t l = 0; l < root::k_terrain_noise_lanes; ++l)
+                    {
+                        u[l] = float(i + l) * inv_res;
+                    }
+                    root::terrain_fbm8(u, v, noise, out);
+
+                    const uint32_t n = std::min(root::k_terrain_noise_lanes, res - i);
+                    std::copy_n(out, n, row + i);
+                }
             }
-        }
-        return true;
+        });
+    return true;
+}
+
+// The terrain's normalized grid, from the component's cache when its parameters are
+// unchanged. Shared by the render and physics builders. Null on a hard failure.
+std::shared_ptr<const std::vector<float>>
+acquire_height_field(root::terrain_component& tc, uint32_t res)
+{
+    auto& cache = tc.cached_height_field();
+    const uint64_t key = root::terrain_height_key(root::terrain_height_params_for(tc, res));
+    if (cache.heights && cache.key == key)
+    {
+        return cache.heights;
     }
 
-    // Procedural noise.
-    for (uint32_t j = 0; j < res; ++j)
+    auto heights = std::make_shared<std::vector<float>>();
+    if (!build_height_field(tc, res, *heights))
     {
-        for (uint32_t i = 0; i < res; ++i)
-        {
-            float u = (res > 1) ? float(i) / float(res - 1) : 0.0f;
-            float v = (res > 1) ? float(j) / float(res - 1) : 0.0f;
-            heights[size_t(j) * res + i] = terrain_fbm(u, v, tc);
-        }
+        return nullptr;
     }
-    return true;
+
+    cache.key = key;
+    cache.heights = std::move(heights);
+    return cache.heights;
 }
 
 }  // namespace
@@ -1385,29 +1425,28 @@ terrain_component__cmd_builder(reflection::type_context__render_cmd_build& ctx)
     tc.update_matrix();
 
     const utils::id mesh_id = terrain_mesh_id_for(tc.get_id());
+    auto& chunks = tc.render_chunks();
 
-    // First build: generate + upload the grid, then create the render object.
+    // First build: generate + upload the chunked grid, then create the chunk objects.
     if (!tc.get_render_built())
     {
-        uint32_t res = glm::clamp<uint32_t>(tc.get_resolution(), 2u, 4096u);
+        const auto layout = terrain_layout_for(tc);
+        const uint32_t res = layout.res;
+        const uint32_t cells = layout.chunk_cells;
+        const uint32_t side = cells + 1;
+        const uint32_t chunk_vcount = side * side;
+
         float size = tc.get_world_size();
         float half = size * 0.5f;
         float h_scale = tc.get_height_scale();
-        float cell = (res > 1) ? size / float(res - 1) : size;
+        float cell = size / float(res - 1);
 
-        std::vector<float> heights;
-        if (!build_height_field(tc, res, heights))
+        const auto heights_ref = acquire_height_field(tc, res);
+        if (!heights_ref)
         {
             return result_code::failed;
         }
-
-        const uint32_t vcount = res * res;
-        const uint32_t icount = (res - 1) * (res - 1) * 6;
-
-        auto vbuf = std::make_shared<utils::buffer>(size_t(vcount) * sizeof(gpu::vertex_data));
-        auto ibuf = std::make_shared<utils::buffer>(size_t(icount) * sizeof(gpu::uint));
-        auto vv = vbuf->make_view<gpu::vertex_data>();
-        auto iv = ibuf->make_view<gpu::uint>();
+        const std::vector<float>& heights = *heights_ref;
 
         auto height_at = [&](int32_t i, int32_t j) -> float
         {
@@ -1416,65 +1455,173 @@ terrain_component__cmd_builder(reflection::type_context__render_cmd_build& ctx)
             return heights[size_t(j) * res + i] * h_scale;
         };
 
-        glm::vec3 vmin{std::numeric_limits<float>::max()};
-        glm::vec3 vmax{std::numeric_limits<float>::lowest()};
+        // Chunk bounds: sphere around each chunk's height-extended footprint. Chunk
+        // rows run on the job system; every chunk writes only its own slot.
+        chunks.assign(size_t(layout.chunks) * layout.chunks, {});
+        for_each_row_range(
+            layout.chunks,
+            [&](uint32_t cy_begin, uint32_t cy_end)
+            {
+                for (uint32_t cy = cy_begin; cy < cy_end; ++cy)
+                {
+                    for (uint32_t cx = 0; cx < layout.chunks; ++cx)
+                    {
+                        float hmin = std::numeric_limits<float>::max();
+                        float hmax = std::numeric_limits<float>::lowest();
+                        for (uint32_t j = 0; j < side; ++j)
+                        {
+                            const float* row =
+                                heights.data() + size_t(cy * cells + j) * res + cx * cells;
+                            for (uint32_t i = 0; i < side; ++i)
+                            {
+                                hmin = std::min(hmin, row[i]);
+                                hmax = std::max(hmax, row[i]);
+                            }
+                        }
+                        hmin *= h_scale;
+                        hmax *= h_scale;
+                        if (hmin > hmax)
+                        {
+                            std::swap(hmin, hmax);  // negative height scale
+                        }
+
+                        float extent = float(cells) * cell * 0.5f;
+                        auto& chunk = chunks[size_t(cy) * layout.chunks + cx];
+                        chunk.local_centroid = {-half + float(cx * cells) * cell + extent,
+                                                (hmin + hmax) * 0.5f,
+                                                -half + float(cy * cells) * cell + extent};
+                        chunk.radius =
+                            glm::length(glm::vec3(extent, (hmax - hmin) * 0.5f, extent));
+                    }
+                }
+            });
 
-        for (uint32_t j = 0; j < res; ++j)
+        float max_chunk_radius = 0.0f;
+        for (const auto& chunk : chunks)
         {
-            for (uint32_t i = 0; i < res; ++i)
-            {
-                float h = heights[size_t(j) * res + i] * h_scale;
-                glm::vec3 pos{-half + float(i) * cell, h, -half + float(j) * cell};
-
-                // Normal from central differences of neighbor heights (+Y up).
-                float hl = height_at(int32_t(i) - 1, int32_t(j));
-                float hr = height_at(int32_t(i) + 1, int32_t(j));
-                float hd = height_at(int32_t(i), int32_t(j) - 1);
-                float hu = height_at(int32_t(i), int32_t(j) + 1);
-                glm::vec3 nrm = glm::normalize(glm::vec3(hl - hr, 2.0f * cell, hd - hu));
-
-                gpu::vertex_data vert{};
-                vert.position = pos;
-                vert.normal = nrm;
-                vert.color = {1.0f, 1.0f, 1.0f};
-                vert.uv = {(res > 1) ? float(i) / float(res - 1) : 0.0f,
-                           (res > 1) ? float(j) / float(res - 1) : 0.0f};
-                vert.uv2 = {0.0f, 0.0f};
-                vv.at(size_t(j) * res + i) = vert;
-
-                vmin = glm::min(vmin, pos);
-                vmax = glm::max(vmax, pos);
-            }
+            max_chunk_radius = std::max(max_chunk_radius, chunk.radius);
         }
 
-        uint32_t k = 0;
-        for (uint32_t j = 0; j < res - 1; ++j)
+        std::vector<float> lod_range;
+        std::vector<float> morph_start;
+        root::terrain_lod_bands(
+            max_chunk_radius * max_abs_scale(tc), layout.lod_levels, lod_range, morph_start);
+
+        const size_t vcount = chunks.size() * chunk_vcount;
+        auto vbuf = std::make_shared<utils::buffer>(vcount * sizeof(gpu::vertex_data));
+        auto vv = vbuf->make_view<gpu::vertex_data>();
+
+        // Vertices, chunk rows in parallel: each chunk fills its own vertex range
+        for_each_row_range(
+            layout.chunks,
+            [&](uint32_t cy_begin, uint32_t cy_end)
+            {
+                for (uint32_t cy = cy_begin; cy < cy_end; ++cy)
+                {
+                    for (uint32_t cx = 0; cx < layout.chunks; ++cx)
+                    {
+                        size_t v = (size_t(cy) * layout.chunks + cx) * chunk_vcount;
+                        for (uint32_t j = 0; j < side; ++j)
+                        {
+                            for (uint32_t i = 0; i < side; ++i)
+                            {
+                                auto gi = int32_t(cx * cells + i);
+                                auto gj = int32_t(cy * cells + j);
+
+                                float h = height_at(gi, gj);
+                                glm::vec3 pos{
+                                    -half + float(gi) * cell, h, -half + float(gj) * cell};
+
+                                // Normal from central differences of neighbor heights.
+                                float hl = height_at(gi - 1, gj);
+                                float hr = height_at(gi + 1, gj);
+                                float hd = height_at(gi, gj - 1);
+                                float hu = height_at(gi, gj + 1);
+                                glm::vec3 nrm =
+                                    glm::normalize(glm::vec3(hl - hr, 2.0f * cell, hd - hu));
+
+                                // The finest level without this vertex is the one above
+                                // the coarsest level that has it. There the vertex sits on
+                                // an edge (or the split diagonal) of a coarser quad, and
+                                // morphs to the average height of that edge's ends.
+                                glm::vec3 morph{h,
+                                                std::numeric_limits<float>::max(),
+                                                std::numeric_limits<float>::max()};
+                                auto l = uint32_t(std::countr_zero(i | j | cells));
+                                if (l + 1 < layout.lod_levels)
+                                {
+                                    auto s = int32_t(1u << l);
+                                    bool odd_i = (i >> l) & 1u;
+                                    bool odd_j = (j >> l) & 1u;
+                                    if (odd_i && odd_j)
+                                    {
+                                        morph.x = (height_at(gi + s, gj - s) +
+                                                   height_at(gi - s, gj + s)) *
+                                                  0.5f;
+                                    }
+                                    else if (odd_i)
+                                    {
+                                        morph.x =
+                                            (height_at(gi - s, gj) + height_at(gi + s, gj)) * 0.5f;
+                                    }
+                                    else
+                                    {
+                                        morph.x =
+                                            (height_at(gi, gj - s) + height_at(gi, gj + s)) * 0.5f;
+                                    }
+                                    morph.y = morph_start[l];
+                                    morph.z = lod_range[l];
+                                }
+
+                                gpu::vertex_data vert{};
+                                vert.position = pos;
+                                vert.normal = nrm;
+                                vert.color = morph;
+                                vert.uv = {float(gi) / float(res - 1),
+                                           float(gj) / float(res - 1)};
+                                vert.uv2 = {0.0f, 0.0f};
+                                vv.at(v++) = vert;
+                            }
+                        }
+                    }
+                }
+            });
+
+        auto [lo, hi] = std::minmax_element(heights.begin(), heights.end());
+        glm::vec3 vmin{-half, std::min(*lo * h_scale, *hi * h_scale), -half};
+        glm::vec3 vmax{half, std::max(*lo * h_scale, *hi * h_scale), half};
+
+        // One index list per level over a single chunk's vertices, shared by all chunks
+        std::vector<render::mesh_lod> lods(layout.lod_levels);
+        std::vector<gpu::uint> indices;
+        for (uint32_t l = 0; l < layout.lod_levels; ++l)
         {
-            for (uint32_t i = 0; i < res - 1; ++i)
+            const uint32_t s = 1u << l;
+            const uint32_t quads = cells / s;
+
+            lods[l].first_index = uint32_t(indices.size());
+            lods[l].max_distance = lod_range[l];
+            for (uint32_t qj = 0; qj < quads; ++qj)
             {
-                uint32_t v0 = j * res + i;
-                uint32_t v1 = v0 + 1;
-                uint32_t v2 = v0 + res;
-                uint32_t v3 = v2 + 1;
-
-                iv.at(k++) = v0;
-                iv.at(k++) = v2;
-                iv.at(k++) = v1;
-                iv.at(k++) = v1;
-                iv.at(k++) = v2;
-                iv.at(k++) = v3;
+                for (uint32_t qi = 0; qi < quads; ++qi)
+                {
+                    uint32_t v0 = qj * s * side + qi * s;
+                    uint32_t v1 = v0 + s;
+                    uint32_t v2 = v0 + s * side;
+                    uint32_t v3 = v2 + s;
+
+                    indices.insert(indices.end(), {v0, v2, v1, v1, v2, v3});
+                }
             }
+            lods[l].index_count = uint32_t(indices.size()) - lods[l].first_index;
         }
 
+        auto ibuf = std::make_shared<utils::buffer>(indices.size() * sizeof(gpu::uint));
+        memcpy(ibuf->data(), indices.data(), indices.size() * sizeof(gpu::uint));
+
         glm::vec3 centroid = (vmin + vmax) * 0.5f;
-        float max_d2 = 0.0f;
-        for (uint32_t v = 0; v < vcount; ++v)
-        {
-            glm::vec3 d = vv.at(v).position - centroid;
-            max_d2 = std::max(max_d2, glm::dot(d, d));
-        }
         tc.set_local_centroid(centroid);
-        tc.set_base_bounding_radius(std::sqrt(max_d2));
+        tc.set_base_bounding_radius(glm::length(vmax - centroid));
 
         // The static collider for this terrain is registered separately by
         // terrain_component__physics_cmd_builder (via physics_translator), not here —
@@ -1490,59 +1637,65 @@ terrain_component__cmd_builder(reflection::type_context__render_cmd_build& ctx)
         mcmd->handle = mesh_handle;
         mcmd->vertices = std::move(vbuf);
         mcmd->indices = std::move(ibuf);
+        mcmd->lods = std::move(lods);
+        mcmd->chunk_vertex_count = chunk_vcount;
         ctx.rb->enqueue_cmd(mcmd);
     }
 
-    auto scale = tc.get_scale();
-    float max_scale = glm::max(glm::max(glm::abs(scale.x), glm::abs(scale.y)), glm::abs(scale.z));
-    float scaled_radius = tc.get_base_bounding_radius() * max_scale;
-
-    glm::vec4 world_center4 =
-        tc.get_transform_matrix() * glm::vec4(tc.get_local_centroid(), 1.0f);
-    glm::vec3 world_sphere_center{world_center4.x, world_center4.y, world_center4.z};
+    const float max_scale = max_abs_scale(tc);
+    const glm::mat4 xf = tc.get_transform_matrix();
 
     std::string new_rqid = material->get_id().str() + "::" + mesh_id.str();
 
-    if (!tc.get_render_built())
+    for (size_t c = 0; c < chunks.size(); ++c)
     {
-        auto obj_handle = ctx.rb->objects_alloc().reserve();
-        tc.set_render_object_handle(obj_handle);
+        auto& chunk = chunks[c];
+        glm::vec3 world_sphere_center = glm::vec3(xf * glm::vec4(chunk.local_centroid, 1.0f));
+        float scaled_radius = chunk.radius * max_scale;
 
-        auto* cmd = ctx.rb->alloc_cmd<create_object_cmd>();
-        cmd->id = tc.get_id();
-        cmd->obj_handle = obj_handle;
-        cmd->mesh = tc.get_mesh_handle();
-        cmd->material = material->render_handle();
-        cmd->transform = tc.get_transform_matrix();
-        cmd->normal_matrix = tc.get_normal_matrix();
-        cmd->position = glm::vec3(tc.get_world_position());
-        cmd->bounding_sphere_center = world_sphere_center;
-        cmd->bounding_radius = scaled_radius;
-        cmd->bone_count = 0;
-        cmd->queue_id = new_rqid;
-        cmd->layer_flags = tc.get_layers();
+        if (!tc.get_render_built())
+        {
+            chunk.handle = ctx.rb->objects_alloc().reserve();
 
-        tc.set_render_built(true);
-        ctx.rb->enqueue_cmd(cmd);
-    }
-    else
-    {
-        auto* cmd = ctx.rb->alloc_cmd<update_object_cmd>();
-        cmd->id = tc.get_id();
-        cmd->obj_handle = tc.get_render_object_handle();
-        cmd->mesh = tc.get_mesh_handle();
-        cmd->material = material->render_handle();
-        cmd->transform = tc.get_transform_matrix();
-        cmd->normal_matrix = tc.get_normal_matrix();
-        cmd->position = glm::vec3(tc.get_world_position());
-        cmd->bounding_sphere_center = world_sphere_center;
-        cmd->bounding_radius = scaled_radius;
-        cmd->queue_id = new_rqid;
-        cmd->layer_flags = tc.get_layers();
+            auto* cmd = ctx.rb->alloc_cmd<create_object_cmd>();
+            cmd->id = terrain_chunk_id_for(tc.get_id(), c);
+            cmd->obj_handle = chunk.handle;
+            cmd->mesh = tc.get_mesh_handle();
+            cmd->material = material->render_handle();
+            cmd->transform = xf;
+            cmd->normal_matrix = tc.get_normal_matrix();
+            cmd->position = glm::vec3(tc.get_world_position());
+            cmd->bounding_sphere_center = world_sphere_center;
+            cmd->bounding_radius = scaled_radius;
+            cmd->bone_count = 0;
+            cmd->mesh_chunk = uint32_t(c);
+            cmd->queue_id = new_rqid;
+            cmd->layer_flags = tc.get_layers();
 
-        ctx.rb->enqueue_cmd(cmd);
+            ctx.rb->enqueue_cmd(cmd);
+        }
+        else
+        {
+            auto* cmd = ctx.rb->alloc_cmd<update_object_cmd>();
+            cmd->id = terrain_chunk_id_for(tc.get_id(), c);
+            cmd->obj_handle = chunk.handle;
+            cmd->mesh = tc.get_mesh_handle();
+            cmd->material = material->render_handle();
+            cmd->transform = xf;
+            cmd->normal_matrix = tc.get_normal_matrix();
+            cmd->position = glm::vec3(tc.get_world_position());
+            cmd->bounding_sphere_center = world_sphere_center;
+            cmd->bounding_radius = scaled_radius;
+            cmd->mesh_chunk = uint32_t(c);
+            cmd->queue_id = new_rqid;
+            cmd->layer_flags = tc.get_layers();
+
+            ctx.rb->enqueue_cmd(cmd);
+        }
     }
 
+    tc.set_render_built(true);
+
     return result_code::ok;
 }
 
@@ -1560,11 +1713,14 @@ terrain_component__cmd_destroyer(reflection::type_context__render_cmd_build& ctx
 
     if (tc.get_render_built())
     {
-        auto* ocmd = ctx.rb->alloc_cmd<destroy_object_cmd>();
-        ocmd->obj_handle = tc.get_render_object_handle();
-        ctx.rb->objects_alloc().free(tc.get_render_object_handle());  // [model thread]
-        tc.set_render_object_handle({});
-        ctx.rb->enqueue_cmd(ocmd);
+        for (auto& chunk : tc.render_chunks())
+        {
+            auto* ocmd = ctx.rb->alloc_cmd<destroy_object_cmd>();
+            ocmd->obj_handle = chunk.handle;
+            ctx.rb->objects_alloc().free(chunk.handle);  // [model thread]
+            ctx.rb->enqueue_cmd(ocmd);
+        }
+        tc.render_chunks().clear();
 
         auto* mcmd = ctx.rb->alloc_cmd<destroy_mesh_cmd>();
         mcmd->handle = tc.get_mesh_handle();
@@ -1589,20 +1745,22 @@ terrain_component__cmd_transform(reflection::type_context__render_cmd_build& ctx
 {
     auto& tc = ctx.obj->asr<root::terrain_component>();
 
-    auto* cmd = ctx.rb->alloc_cmd<update_transform_cmd>();
-    cmd->obj_handle = tc.get_render_object_handle();
-    cmd->transform = tc.get_transform_matrix();
-    cmd->normal_matrix = tc.get_normal_matrix();
-    cmd->position = glm::vec3(tc.get_world_position());
+    const float max_s = max_abs_scale(tc);
 
-    auto scale = tc.get_scale();
-    float max_s = glm::max(glm::max(glm::abs(scale.x), glm::abs(scale.y)), glm::abs(scale.z));
-    cmd->bounding_radius = tc.get_base_bounding_radius() * max_s;
+    for (auto& chunk : tc.render_chunks())
+    {
+        auto* cmd = ctx.rb->alloc_cmd<update_transform_cmd>();
+        cmd->obj_handle = chunk.handle;
+        cmd->transform = tc.get_transform_matrix();
+        cmd->normal_matrix = tc.get_normal_matrix();
+        cmd->position = glm::vec3(tc.get_world_position());
+        cmd->bounding_radius = chunk.radius * max_s;
 
-    glm::vec4 wc = tc.get_transform_matrix() * glm::vec4(tc.get_local_centroid(), 1.0f);
-    cmd->bounding_sphere_center = glm::vec3(wc);
+        glm::vec4 wc = tc.get_transform_matrix() * glm::vec4(chunk.local_centroid, 1.0f);
+        cmd->bounding_sphere_center = glm::vec3(wc);
 
-    ctx.rb->enqueue_cmd(cmd);
+        ctx.rb->enqueue_cmd(cmd);
+    }
 
     return result_code::ok;
 }
@@ -1622,10 +1780,8 @@ terrain_component__physics_cmd_builder(reflection::type_context__physics_cmd_bui
     }
 
     // Static collider, baked once (static v1): if it already exists, leave it. The
-    // grid is regenerated here (deterministic from the same params) rather than
-    // shared with the render builder, so the two bridges stay independent. The
-    // position/index math mirrors terrain_component__cmd_builder exactly so the
-    // collider aligns with the rendered surface.
+    // grid comes from the same height cache the render builder fills, and is sampled
+    // at the finest level's vertices so the collider aligns with the rendered surface.
     if (tc.get_physics_handle().valid())
     {
         return result_code::ok;
@@ -1633,62 +1789,39 @@ terrain_component__physics_cmd_builder(reflection::type_context__physics_cmd_bui
 
     tc.update_matrix();
 
-    uint32_t res = glm::clamp<uint32_t>(tc.get_resolution(), 2u, 4096u);
-    float size = tc.get_world_size();
-    float half = size * 0.5f;
-    float h_scale = tc.get_height_scale();
-    float cell = (res > 1) ? size / float(res - 1) : size;
-
-    std::vector<float> heights;
-    if (!build_height_field(tc, res, heights))
+    const uint32_t res = terrain_layout_for(tc).res;
+    auto heights = acquire_height_field(tc, res);
+    if (!heights)
     {
         return result_code::failed;
     }
 
-    const uint32_t vcount = res * res;
-    const uint32_t icount = (res - 1) * (res - 1) * 6;
-
-    // Build the collider grid into the component's PERSISTENT mesh, then hand the
-    // physics ring a borrowed pointer to it: the processor copies it (create_static_mesh)
-    // on the physics thread, and the component owns the storage past the borrow window.
-    // The identity is minted by the bridge so the component records it synchronously;
-    // the Jolt body is built (and the identity mapped to it) when the command drains.
-    physics::static_world_mesh& mesh = tc.collider_mesh();
-    mesh.vertices.clear();
-    mesh.indices.clear();
+    float half = tc.get_world_size() * 0.5f;
+    float cell = tc.get_world_size() / float(res - 1);
 
+    // Jolt places height fields with a rigid body transform, so the component's scale
+    // is folded into the sample spacing and the height scale.
     const glm::mat4 xf = tc.get_transform_matrix();
-    mesh.vertices.reserve(vcount);
-    for (uint32_t j = 0; j < res; ++j)
-    {
-        for (uint32_t i = 0; i < res; ++i)
-        {
-            float hh = heights[size_t(j) * res + i] * h_scale;
-            glm::vec3 pos{-half + float(i) * cell, hh, -half + float(j) * cell};
-            mesh.vertices.push_back(glm::vec3(xf * glm::vec4(pos, 1.0f)));
-        }
-    }
-
-    mesh.indices.reserve(icount);
-    for (uint32_t j = 0; j < res - 1; ++j)
-    {
-        for (uint32_t i = 0; i < res - 1; ++i)
-        {
-            uint32_t v0 = j * res + i;
-            uint32_t v1 = v0 + 1;
-            uint32_t v2 = v0 + res;
-            uint32_t v3 = v2 + 1;
-
-            mesh.indices.push_back(v0);
-            mesh.indices.push_back(v2);
-            mesh.indices.push_back(v1);
-            mesh.indices.push_back(v1);
-            mesh.indices.push_back(v2);
-            mesh.indices.push_back(v3);
-        }
-    }
-
-    tc.set_physics_handle(ctx.pb->register_static_collider(mesh));
+    const glm::vec3 scale = glm::max(glm::vec3(glm::length(glm::vec3(xf[0])),
+                                               glm::length(glm::vec3(xf[1])),
+                                               glm::length(glm::vec3(xf[2]))),
+                                     glm::vec3(1e-6f));
+    const glm::mat3 rotation(
+        glm::vec3(xf[0]) / scale.x, glm::vec3(xf[1]) / scale.y, glm::vec3(xf[2]) / scale.z);
+
+    // Filled into the component's PERSISTENT field, then handed to the physics ring as
+    // a borrowed pointer: the processor copies it (create_static_height_field) on the
+    // physics thread. The identity is minted by the bridge so the component records
+    // it synchronously; the Jolt body is built when the command drains.
+    physics::static_height_field& field = tc.collider_height_field();
+    field.samples = std::move(heights);
+    field.sample_count = res;
+    field.offset = glm::vec3(-half * scale.x, 0.0f, -half * scale.z);
+    field.scale = glm::vec3(cell * scale.x, tc.get_height_scale() * scale.y, cell * scale.z);
+    field.position = glm::vec3(xf[3]);
+    field.rotation = glm::quat_cast(rotation);
+
+    tc.set_physics_handle(ctx.pb->register_static_collider(field));
 
     return result_code::ok;
 }
@@ -0,0 +1,137 @@
+#include "packages/root/render/terrain_builder.h"
+
+#include "packages/root/model/components/terrain_component.h"
+
+#include <utils/fnv_hash.h>
+
+#include <bit>
+
+namespace kryga::root
+{
+
+terrain_layout
+terrain_layout_for_resolution(uint32_t resolution)
+{
+    uint32_t res = std::clamp<uint32_t>(resolution, 2u, 4096u);
+
+    terrain_layout l;
+    l.chunk_cells = std::min(k_terrain_chunk_cells, std::bit_ceil(res - 1));
+    l.chunks = (res - 1 + l.chunk_cells - 1) / l.chunk_cells;
+    l.res = l.chunks * l.chunk_cells + 1;
+    l.lod_levels = std::min<uint32_t>(k_terrain_lod_levels, std::countr_zero(l.chunk_cells) + 1);
+    return l;
+}
+
+void
+terrain_lod_bands(float max_chunk_radius,
+                  uint32_t lod_levels,
+                  std::vector<float>& range,
+                  std::vector<float>& morph_start)
+{
+    const float base_range = 4.0f * max_chunk_radius;
+    range.resize(lod_levels);
+    morph_start.resize(lod_levels);
+    for (uint32_t l = 0; l < lod_levels; ++l)
+    {
+        range[l] = base_range * float(1u << l);
+        float prev = l ? range[l - 1] : 0.0f;
+        morph_start[l] = range[l] - (range[l] - prev) * k_terrain_morph_fraction;
+    }
+}
+
+float
+terrain_hash(int32_t x, int32_t y, uint32_t seed)
+{
+    uint32_t h = seed + 0x9E3779B9u;
+    h ^= static_cast<uint32_t>(x) * 0x85EBCA6Bu;
+    h = (h ^ (h >> 13)) * 0xC2B2AE35u;
+    h ^= static_cast<uint32_t>(y) * 0x27D4EB2Fu;
+    h = (h ^ (h >> 16)) * 0x165667B1u;
+    h ^= h >> 15;
+    return static_cast<float>(h & 0x00FFFFFFu) / static_cast<float>(0x01000000u);
+}
+
+void
+terrain_value_noise8(const float* x, float y, uint32_t seed, float* out)
+{
+    // floor via truncation, so it stays a plain vector conversion
+    auto y0 = static_cast<int32_t>(y);
+    y0 -= int32_t(y < float(y0));
+    float ty = y - float(y0);
+    float uy = ty * ty * (3.0f - 2.0f * ty);
+
+    for (uint32_t l = 0; l < k_terrain_noise_lanes; ++l)
+    {
+        auto x0 = static_cast<int32_t>(x[l]);
+        x0 -= int32_t(x[l] < float(x0));
+        float tx = x[l] - float(x0);
+        float ux = tx * tx * (3.0f - 2.0f * tx);
+
+        float v00 = terrain_hash(x0, y0, seed);
+        float v10 = terrain_hash(x0 + 1, y0, seed);
+        float v01 = terrain_hash(x0, y0 + 1, seed);
+        float v11 = terrain_hash(x0 + 1, y0 + 1, seed);
+
+        float a = v00 + (v10 - v00) * ux;
+        float b = v01 + (v11 - v01) * ux;
+        out[l] = a + (b - a) * uy;
+    }
+}
+
+void
+terrain_fbm8(const float* u, float v, const terrain_noise& n, float* out)
+{
+    float sum[k_terrain_noise_lanes] = {};
+    float x[k_terrain_noise_lanes];
+    float octave[k_terrain_noise_lanes];
+
+    float freq = n.frequency;
+    float amp = 1.0f;
+    float total_amp = 0.0f;
+    for (uint32_t o = 0; o < n.octaves; ++o)
+    {
+        for (uint32_t l = 0; l < k_terrain_noise_lanes; ++l)
+        {
+            x[l] = u[l] * freq;
+        }
+        terrain_value_noise8(x, v * freq, n.seed + o * 1013u, octave);
+        for (uint32_t l = 0; l < k_terrain_noise_lanes; ++l)
+        {
+            sum[l] += amp * octave[l];
+        }
+        total_amp += amp;
+        freq *= n.lacunarity;
+        amp *= n.gain;
+    }
+
+    const float inv = (total_amp > 0.0f) ? 1.0f / total_amp : 0.0f;
+    for (uint32_t l = 0; l < k_terrain_noise_lanes; ++l)
+    {
+        out[l] = sum[l] * inv;
+    }
+}
+
+uint64_t
+terrain_height_key(const terrain_height_params& p)
+{
+    fnv_hasher h;
+    auto feed = [&h](auto v) { h.feed(&v, sizeof(v)); };
+
+    feed(p.res);
+    feed(p.source_mode);
+    if (p.source_mode == terrain_source_heightmap)
+    {
+        feed(p.heightmap);
+    }
+    else
+    {
+        feed(p.noise.seed);
+        feed(p.noise.octaves);
+        feed(p.noise.frequency);
+        feed(p.noise.lacunarity);
+        feed(p.noise.gain);
+    }
+    return h.value();
+}
+
+}  // namespace kryga::root
@@ -0,0 +1,367 @@
+#include <gtest/gtest.h>
+
+#include <packages/root/model/components/terrain_component.h>
+#include <packages/root/render/terrain_builder.h>
+
+#include <vulkan_render/types/vulkan_mesh_data.h>
+
+#include <glm_unofficial/glm.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace kryga;
+using namespace kryga::root;
+
+namespace
+{
+
+// Value noise with std::floor, one sample at a time
+float
+reference_value_noise(float x, float y, uint32_t seed)
+{
+    const float fx = std::floor(x);
+    const float fy = std::floor(y);
+    const auto x0 = static_cast<int32_t>(fx);
+    const auto y0 = static_cast<int32_t>(fy);
+    const float tx = x - fx;
+    const float ty = y - fy;
+    const float ux = tx * tx * (3.0f - 2.0f * tx);
+    const float uy = ty * ty * (3.0f - 2.0f * ty);
+
+    float a = terrain_hash(x0, y0, seed) +
+              (terrain_hash(x0 + 1, y0, seed) - terrain_hash(x0, y0, seed)) * ux;
+    float b = terrain_hash(x0, y0 + 1, seed) +
+              (terrain_hash(x0 + 1, y0 + 1, seed) - terrain_hash(x0, y0 + 1, seed)) * ux;
+    return a + (b - a) * uy;
+}
+
+// What terrain_height_params_for reads, plus the settings the grid must not
+// depend on
+struct fake_terrain
+{
+    uint32_t source_mode = terrain_source_noise;
+    const texture* heightmap = nullptr;
+    uint32_t seed = 1337u;
+    uint32_t octaves = 5u;
+    float frequency = 3.0f;
+    float lacunarity = 2.0f;
+    float gain = 0.5f;
+
+    float height_scale = 20.0f;
+    glm::vec3 position{0.0f};
+    glm::vec3 scale{1.0f};
+
+    uint32_t
+    get_source_mode() const
+    {
+        return source_mode;
+    }
+
+    const texture*
+    get_heightmap() const
+    {
+        return heightmap;
+    }
+
+    uint32_t
+    get_seed() const
+    {
+        return seed;
+    }
+
+    uint32_t
+    get_octaves() const
+    {
+        return octaves;
+    }
+
+    float
+    get_frequency() const
+    {
+        return frequency;
+    }
+
+    float
+    get_lacunarity() const
+    {
+        return lacunarity;
+    }
+
+    float
+    get_gain() const
+    {
+        return gain;
+    }
+};
+
+uint64_t
+key_of(const fake_terrain& t, uint32_t res = 129u)
+{
+    return terrain_height_key(terrain_height_params_for(t, res));
+}
+
+}  // namespace
+
+TEST(terrain_builder, lane_noise_matches_floor_reference)
+{
+    // Negative, integral and near-integral coordinates, where truncation and floor
+    // part ways
+    const float xs[] = {-3.75f, -2.0f, -1.0f, -0.999f, -0.25f, -1e-4f, 0.0f, 1e-4f,
+                        0.5f,   0.999f, 1.0f, 2.0f,    7.25f,  -17.5f, 123.4f, -123.4f};
+    const float ys[] = {-5.5f, -1.0f, -0.001f, 0.0f, 0.3f, 4.0f, 41.9f};
+    static_assert(std::size(xs) % k_terrain_noise_lanes == 0);
+
+    for (uint32_t seed : {0u, 1337u, 0xFFFFFFFFu})
+    {
+        for (float y : ys)
+        {
+            for (size_t i = 0; i < std::size(xs); i += k_terrain_noise_lanes)
+            {
+                float out[k_terrain_noise_lanes];
+                terrain_value_noise8(xs + i, y, seed, out);
+                for (uint32_t l = 0; l < k_terrain_noise_lanes; ++l)
+                {
+                    EXPECT_EQ(out[l], reference_value_noise(xs[i + l], y, seed))
+                        << "x " << xs[i + l] << " y " << y << " seed " << seed;
+                }
+            }
+        }
+    }
+}
+
+TEST(terrain_builder, fbm_stays_normalized)
+{
+    const terrain_noise noise{.seed = 7u, .octaves = 6u, .frequency = 3.0f};
+
+    float u[k_terrain_noise_lanes];
+    for (uint32_t l = 0; l < k_terrain_noise_lanes; ++l)
+    {
+        u[l] = float(l) / float(k_terrain_noise_lanes - 1);
+    }
+    for (float v : {0.0f, 0.37f, 1.0f})
+    {
+        float out[k_terrain_noise_lanes];
+        terrain_fbm8(u, v, noise, out);
+        for (float h : out)
+        {
+            EXPECT_GE(h, 0.0f);
+            EXPECT_LE(h, 1.0f);
+        }
+    }
+}
+
+TEST(terrain_builder, height_key_ignores_scale_and_transform)
+{
+    fake_terrain t;
+    const uint64_t key = key_of(t);
+
+    t.height_scale = 250.0f;
+    t.position = {10.0f, -4.0f, 3.0f};
+    t.scale = {2.0f, 0.5f, 2.0f};
+    EXPECT_EQ(key_of(t), key);
+}
+
+TEST(terrain_builder, height_key_follows_grid_inputs)
+{
+    const fake_terrain base;
+    const uint64_t key = key_of(base);
+
+    auto changed = [&](auto&& edit)
+    {
+        fake_terrain t = base;
+        edit(t);
+        return key_of(t) != key;
+    };
+    EXPECT_TRUE(changed([](fake_terrain& t) { t.seed += 1; }));
+    EXPECT_TRUE(changed([](fake_terrain& t) { t.octaves += 1; }));
+    EXPECT_TRUE(changed([](fake_terrain& t) { t.frequency *= 2.0f; }));
+    EXPECT_TRUE(changed([](fake_terrain& t) { t.lacunarity += 0.5f; }));
+    EXPECT_TRUE(changed([](fake_terrain& t) { t.gain += 0.1f; }));
+    EXPECT_TRUE(changed([](fake_terrain& t) { t.source_mode = terrain_source_heightmap; }));
+    EXPECT_NE(key_of(base, 257u), key);
+
+    // Octaves are clamped before they reach the grid
+    fake_terrain none = base;
+    none.octaves = 0u;
+    fake_terrain one = base;
+    one.octaves = 1u;
+    EXPECT_EQ(key_of(none), key_of(one));
+    fake_terrain many = base;
+    many.octaves = 8u;
+    fake_terrain more = base;
+    more.octaves = 50u;
+    EXPECT_EQ(key_of(many), key_of(more));
+
+    // Heightmap terrain depends on its texture only
+    fake_terrain mapped = base;
+    mapped.source_mode = terrain_source_heightmap;
+    fake_terrain reseeded = mapped;
+    reseeded.seed += 1;
+    EXPECT_EQ(key_of(reseeded), key_of(mapped));
+    reseeded.heightmap = reinterpret_cast<const texture*>(&base);
+    EXPECT_NE(key_of(reseeded), key_of(mapped));
+}
+
+TEST(terrain_builder, layout_rounds_up_to_whole_chunks)
+{
+    struct expected
+    {
+        uint32_t resolution;
+        uint32_t res;
+        uint32_t chunk_cells;
+        uint32_t chunks;
+        uint32_t lod_levels;
+    };
+    const expected cases[] = {
+        {0u, 2u, 1u, 1u, 1u},          // clamped up to one cell
+        {2u, 2u, 1u, 1u, 1u},
+        {4u, 5u, 4u, 1u, 3u},          // 3 cells round up to one 4-cell chunk
+        {65u, 65u, 64u, 1u, 5u},
+        {100u, 129u, 64u, 2u, 5u},
+        {129u, 129u, 64u, 2u, 5u},
+        {130u, 193u, 64u, 3u, 5u},
+        {5000u, 4097u, 64u, 64u, 5u},  // clamped to 4096, then rounded up
+    };
+
+    for (const auto& c : cases)
+    {
+        auto l = terrain_layout_for_resolution(c.resolution);
+        EXPECT_EQ(l.res, c.res) << "resolution " << c.resolution;
+        EXPECT_EQ(l.chunk_cells, c.chunk_cells) << "resolution " << c.resolution;
+        EXPECT_EQ(l.chunks, c.chunks) << "resolution " << c.resolution;
+        EXPECT_EQ(l.lod_levels, c.lod_levels) << "resolution " << c.resolution;
+
+        // Whole chunks that cover at least the requested cells
+        EXPECT_EQ((l.res - 1) % l.chunk_cells, 0u);
+        EXPECT_GE(l.res, std::clamp(c.resolution, 2u, 4096u));
+        // The coarsest level still has a cell per chunk
+        EXPECT_GE(l.chunk_cells >> (l.lod_levels - 1), 1u);
+    }
+}
+
+TEST(terrain_builder, lod_bands_double_and_morph_at_the_far_end)
+{
+    std::vector<float> range;
+    std::vector<float> morph_start;
+    terrain_lod_bands(10.0f, 5u, range, morph_start);
+
+    ASSERT_EQ(range.size(), 5u);
+    ASSERT_EQ(morph_start.size(), 5u);
+    EXPECT_FLOAT_EQ(range[0], 40.0f);
+    for (uint32_t l = 0; l < 5u; ++l)
+    {
+        const float prev = l ? range[l - 1] : 0.0f;
+        if (l)
+        {
+            EXPECT_FLOAT_EQ(range[l], 2.0f * range[l - 1]);
+        }
+        EXPECT_GT(morph_start[l], prev);
+        EXPECT_LT(morph_start[l], range[l]);
+        EXPECT_FLOAT_EQ(range[l] - morph_start[l], (range[l] - prev) * k_terrain_morph_fraction);
+    }
+}
+
+TEST(terrain_builder, chunk_lod_follows_the_bands)
+{
+    std::vector<float> range;
+    std::vector<float> morph_start;
+    terrain_lod_bands(10.0f, 3u, range, morph_start);
+
+    std::vector<render::mesh_lod> lods(3);
+    for (size_t l = 0; l < lods.size(); ++l)
+    {
+        lods[l].max_distance = range[l];
+    }
+
+    EXPECT_EQ(render::select_chunk_lod(lods, -5.0f), 0u);  // camera inside the chunk
+    EXPECT_EQ(render::select_chunk_lod(lods, 0.0f), 0u);
+    EXPECT_EQ(render::select_chunk_lod(lods, range[0] - 0.01f), 0u);
+    EXPECT_EQ(render::select_chunk_lod(lods, range[0]), 1u);
+    EXPECT_EQ(render::select_chunk_lod(lods, range[1] + 0.01f), 2u);
+    EXPECT_EQ(render::select_chunk_lod(lods, range[2] * 10.0f), 2u);  // coarsest, never culled
+    EXPECT_EQ(render::select_chunk_lod({}, 100.0f), 0u);
+}
+
+TEST(terrain_builder, neighbouring_chunks_differ_by_at_most_one_level)
+{
+    // Chunks laid out and bounded like the render builder's, over rough terrain so
+    // their radii differ
+    const auto layout = terrain_layout_for_resolution(513u);
+    const float world_size = 400.0f;
+    const float cell = world_size / float(layout.res - 1);
+    const float half = world_size * 0.5f;
+    const float extent = float(layout.chunk_cells) * cell * 0.5f;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> height(0.0f, 60.0f);
+
+    const uint32_t n = layout.chunks;
+    std::vector<glm::vec3> centroid(n * n);
+    std::vector<float> radius(n * n);
+    float max_radius = 0.0f;
+    for (uint32_t cy = 0; cy < n; ++cy)
+    {
+        for (uint32_t cx = 0; cx < n; ++cx)
+        {
+            float a = height(rng);
+            float b = height(rng);
+            float hmin = std::min(a, b);
+            float hmax = std::max(a, b);
+
+            const uint32_t c = cy * n + cx;
+            centroid[c] = {-half + float(cx * layout.chunk_cells) * cell + extent,
+                           (hmin + hmax) * 0.5f,
+                           -half + float(cy * layout.chunk_cells) * cell + extent};
+            radius[c] = glm::length(glm::vec3(extent, (hmax - hmin) * 0.5f, extent));
+            max_radius = std::max(max_radius, radius[c]);
+        }
+    }
+
+    std::vector<float> range;
+    std::vector<float> morph_start;
+    terrain_lod_bands(max_radius, layout.lod_levels, range, morph_start);
+    std::vector<render::mesh_lod> lods(layout.lod_levels);
+    for (size_t l = 0; l < lods.size(); ++l)
+    {
+        lods[l].max_distance = range[l];
+    }
+
+    std::uniform_real_distribution<float> across(-3.0f * world_size, 3.0f * world_size);
+    std::uniform_real_distribution<float> above(0.0f, 500.0f);
+    bool saw_several_levels = false;
+    std::vector<uint32_t> level(n * n);
+    for (int camera = 0; camera < 500; ++camera)
+    {
+        const glm::vec3 eye{across(rng) * (camera % 2 ? 1.0f : 0.1f), above(rng), across(rng)};
+        for (uint32_t c = 0; c < n * n; ++c)
+        {
+            // Distance to the bounding sphere, as vulkan_render::select_lods measures it
+            level[c] = render::select_chunk_lod(lods, glm::length(centroid[c] - eye) - radius[c]);
+        }
+
+        uint32_t lo = level[0];
+        uint32_t hi = level[0];
+        for (uint32_t cy = 0; cy < n; ++cy)
+        {
+            for (uint32_t cx = 0; cx < n; ++cx)
+            {
+                const uint32_t c = cy * n + cx;
+                lo = std::min(lo, level[c]);
+                hi = std::max(hi, level[c]);
+                for (uint32_t other : {cx + 1 < n ? c + 1 : c, cy + 1 < n ? c + n : c})
+                {
+                    ASSERT_LE(std::abs(int32_t(level[c]) - int32_t(level[other])), 1)
+                        << "chunks " << c << " and " << other << ", camera " << camera;
+                }
+            }
+        }
+        saw_several_levels |= hi > lo + 1;
+    }
+
+    // Some views span more than two levels, so the constraint was exercised
+    EXPECT_TRUE(saw_several_levels);
+}
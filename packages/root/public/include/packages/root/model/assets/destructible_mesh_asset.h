@@ -4,8 +4,16 @@
 
 #include "packages/root/model/assets/asset.h"
 
+#include <cstdint>
+#include <memory>
+
 namespace kryga
 {
+namespace voronoi_fracture
+{
+struct fracture_result;
+}  // namespace voronoi_fracture
+
 namespace root
 {
 class mesh;
@@ -18,9 +26,9 @@ namespace root
 //
 // Holds a reference to a source mesh + material and the parameters the
 // fracture pipeline uses to split the source into Voronoi chunks. Chunk
-// geometry is generated lazily at load time by the render command builder
-// from these parameters; a future PR can move fracturing into the asset
-// importer and serialize the chunks directly on this asset.
+// geometry comes from the cooker's `.afrac` beside the source mesh when one
+// matches, else the render command builder fractures at load time. Either way
+// the result is cached here and shared by every component using the asset.
 KRG_ar_class();
 class destructible_mesh_asset : public ::kryga::root::asset
 {
@@ -38,6 +46,20 @@ public:
     bool
     construct(this_class::construct_params& p);
 
+    // Fracture of the source mesh with this asset's parameters, keyed by
+    // voronoi_fracture::cache_key so edits to either rebuild it. Runtime-only.
+    struct fracture_cache
+    {
+        uint64_t key = 0;
+        std::shared_ptr<const voronoi_fracture::fracture_result> result;
+    };
+
+    fracture_cache&
+    cached_fracture()
+    {
+        return m_fracture;
+    }
+
 protected:
     // clang-format off
     KRG_ar_property(
@@ -119,6 +141,8 @@ protected:
     );
     float m_explosion_strength = 8.0f;
     // clang-format on
+
+    fracture_cache m_fracture;
 };
 
 }  // namespace root
@@ -15,6 +15,15 @@ namespace kryga
 {
 namespace root
 {
+// One entry of mesh::m_lod_ranges. Ranges index into m_lod_indices; error is the
+// simplification error relative to the bounding radius.
+struct mesh_lod_range
+{
+    uint32_t first_index = 0;
+    uint32_t index_count = 0;
+    float error = 0.0f;
+};
+
 // clang-format off
 KRG_ar_class(
     "architype=mesh",
@@ -36,6 +45,9 @@ public:
         utils::buffer vertices;
         utils::buffer indices;
         utils::buffer external;
+        utils::buffer shadow_indices;
+        utils::buffer lod_indices;
+        utils::buffer lod_ranges;
     };
     KRG_gen_meta_api;
 
@@ -75,6 +87,42 @@ public:
         m_external = v;
     }
 
+    utils::buffer&
+    get_shadow_indices_buffer()
+    {
+        return m_shadow_indices;
+    }
+
+    void
+    set_shadow_indices_buffer(utils::buffer& v)
+    {
+        m_shadow_indices = v;
+    }
+
+    utils::buffer&
+    get_lod_indices_buffer()
+    {
+        return m_lod_indices;
+    }
+
+    void
+    set_lod_indices_buffer(utils::buffer& v)
+    {
+        m_lod_indices = v;
+    }
+
+    utils::buffer&
+    get_lod_ranges_buffer()
+    {
+        return m_lod_ranges;
+    }
+
+    void
+    set_lod_ranges_buffer(utils::buffer& v)
+    {
+        m_lod_ranges = v;
+    }
+
     bool
     construct(this_class::construct_params& params);
 
@@ -146,6 +194,36 @@ protected:
     utils::buffer m_external;
     // clang-format on
 
+    // clang-format off
+    KRG_ar_property(
+        category     = "assets",
+        serializable = true,
+        default      = true,
+        mcp_hint     = "optional shadow index buffer for depth passes — read-only at runtime"
+    );
+    utils::buffer m_shadow_indices;
+    // clang-format on
+
+    // clang-format off
+    KRG_ar_property(
+        category     = "assets",
+        serializable = true,
+        default      = true,
+        mcp_hint     = "optional coarser LOD index lists, back to back — read-only at runtime"
+    );
+    utils::buffer m_lod_indices;
+    // clang-format on
+
+    // clang-format off
+    KRG_ar_property(
+        category     = "assets",
+        serializable = true,
+        default      = true,
+        mcp_hint     = "mesh_lod_range per LOD in m_lod_indices — read-only at runtime"
+    );
+    utils::buffer m_lod_ranges;
+    // clang-format on
+
     float m_bounding_radius = 0.0f;
     ::kryga::root::vec3 m_local_centroid;
     ::kryga::render::types::mesh_handle m_render_handle = {};  // runtime, not serialized
@@ -15,7 +15,10 @@ class input_component;
 // clang-format off
 KRG_ar_class(
     mcp_hint = "Camera in the scene — owns a camera_component that controls projection and can be "
-               "set as the active viewport"
+               "set as the active viewport",
+    tick_phase = pre_physics,
+    tick_reads = input,
+    tick_writes = transform
 );
 class camera_object : public ::kryga::root::game_object
 // clang-format on
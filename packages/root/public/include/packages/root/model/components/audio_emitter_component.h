@@ -20,7 +20,10 @@ namespace root
 // clang-format off
 KRG_ar_class(
     mcp_hint = "Plays an audio clip from this object — 2D or 3D positional using the object "
-               "transform as the sound source"
+               "transform as the sound source",
+    tick_phase = late,
+    tick_reads = transform,
+    tick_writes = audio
 );
 class audio_emitter_component : public ::kryga::root::game_object_component
 // clang-format on
@@ -18,7 +18,10 @@ enum class camera_mode
 // clang-format off
 KRG_ar_class(
     mcp_hint = "Camera projection and viewport control — FOV / near/far planes / aspect ratio / "
-               "active camera flag"
+               "active camera flag",
+    tick_phase = late,
+    tick_reads = transform,
+    tick_writes = camera
 );
 class camera_component : public ::kryga::root::game_object_component
 // clang-format on
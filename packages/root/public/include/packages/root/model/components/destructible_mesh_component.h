@@ -38,7 +38,10 @@ class destructible_mesh_asset;
 // clang-format off
 KRG_ar_class(
     render_cmd_builder   = destructible_mesh_component__cmd_builder,
-    render_cmd_destroyer = destructible_mesh_component__cmd_destroyer
+    render_cmd_destroyer = destructible_mesh_component__cmd_destroyer,
+    tick_phase           = post_physics,
+    tick_reads           = transform,
+    tick_writes          = physics|render
 );
 class destructible_mesh_component : public ::kryga::root::game_object_component
 // clang-format on
@@ -182,6 +182,7 @@ public:
     void
     set_layer_flag(uint32_t flag, bool value)
     {
+        before_write();
         if (value)
         {
             m_layers.bits |= flag;
@@ -8,6 +8,9 @@
 
 #include <render_types/render_handle.h>
 
+#include <memory>
+#include <vector>
+
 namespace kryga
 {
 namespace root
@@ -30,8 +33,9 @@ KRG_ar_class(
     render_cmd_transform  = terrain_component__cmd_transform,
     physics_cmd_builder   = terrain_component__physics_cmd_builder,
     physics_cmd_destroyer = terrain_component__physics_cmd_destroyer,
-    mcp_hint              = "Heightmap/noise terrain — generates a grid mesh and renders it with a "
-                           "terrain_splatmap_material. Inherits transform from game_object_component"
+    mcp_hint              = "Heightmap/noise terrain — generates a chunked LOD grid and renders it "
+                           "with a terrain_splatmap_material. Inherits transform from "
+                           "game_object_component"
 );
 class terrain_component : public ::kryga::root::game_object_component
 // clang-format on
@@ -79,21 +83,44 @@ public:
         m_physics_handle = h;
     }
 
-    // Persistent backing for the static collider mesh. The physics_cmd builder fills
-    // this once, then hands the physics ring a BORROWED pointer to it (the processor
-    // copies it on register). It must outlive the one-frame borrow window, so it
-    // lives on the component (package lifetime), not in the transient builder — the
-    // same pattern destructible_mesh_component uses for its chunk shapes.
-    physics::static_world_mesh&
-    collider_mesh()
+    // Persistent backing for the static collider. The physics_cmd builder fills this
+    // once, then hands the physics ring a BORROWED pointer to it (the processor copies
+    // it on register). It must outlive the one-frame borrow window, so it lives on the
+    // component (package lifetime), not in the transient builder — the same pattern
+    // destructible_mesh_component uses for its chunk shapes.
+    physics::static_height_field&
+    collider_height_field()
+    {
+        return m_collider_height_field;
+    }
+
+    // Normalized height grid, generated once per parameter set and read by both the
+    // render and the physics builder. `key` hashes everything the grid depends on.
+    struct height_field
+    {
+        uint64_t key = 0;
+        std::shared_ptr<const std::vector<float>> heights;
+    };
+
+    height_field&
+    cached_height_field()
     {
-        return m_collider_mesh;
+        return m_height_field;
     }
 
-    // Render handles for the procedurally-generated terrain mesh and its render
-    // object. Terrain has no asset mesh, so the builder reserves these (handle model)
-    // and stores them here: the mesh handle backs create/destroy_mesh, the object
-    // handle backs create/update/destroy_object and update_transform. Runtime-only,
+    // One render object per terrain chunk, all drawing from the one chunked mesh.
+    // Local bounds are kept so transform updates can move each chunk's sphere.
+    struct render_chunk
+    {
+        render::types::render_object_handle handle;
+        glm::vec3 local_centroid{0.0f};
+        float radius = 0.0f;
+    };
+
+    // Render handles for the procedurally-generated terrain mesh and its chunk render
+    // objects. Terrain has no asset mesh, so the builder reserves these (handle model)
+    // and stores them here: the mesh handle backs create/destroy_mesh, the chunk
+    // handles back create/update/destroy_object and update_transform. Runtime-only,
     // not serialized.
     render::types::mesh_handle
     get_mesh_handle() const
@@ -106,15 +133,10 @@ public:
         m_mesh_handle = h;
     }
 
-    render::types::render_object_handle
-    get_render_object_handle() const
-    {
-        return m_render_object_handle;
-    }
-    void
-    set_render_object_handle(render::types::render_object_handle h)
+    std::vector<render_chunk>&
+    render_chunks()
     {
-        m_render_object_handle = h;
+        return m_render_chunks;
     }
 
 protected:
@@ -257,9 +279,10 @@ protected:
     float m_base_bounding_radius = 0.0f;
     glm::vec3 m_local_centroid = {0.0f, 0.0f, 0.0f};
     physics::static_body_handle m_physics_handle{};
-    physics::static_world_mesh m_collider_mesh{};
+    physics::static_height_field m_collider_height_field{};
+    height_field m_height_field;
     render::types::mesh_handle m_mesh_handle{};
-    render::types::render_object_handle m_render_object_handle{};
+    std::vector<render_chunk> m_render_chunks;
 };
 
 }  // namespace root
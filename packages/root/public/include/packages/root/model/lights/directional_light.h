@@ -16,7 +16,8 @@ KRG_ar_class(
     render_cmd_builder   = directional_light_component__cmd_builder,
     render_cmd_destroyer = directional_light_component__cmd_destroyer,
     mcp_hint             = "Sun-like light that illuminates the entire scene from a direction — no "
-                           "position falloff"
+                           "position falloff",
+    tick_phase           = pre_physics
 );
 class directional_light : public ::kryga::root::game_object
 // clang-format on
@@ -16,7 +16,8 @@ KRG_ar_class(
     render_cmd_builder   = spot_light_component__cmd_builder,
     render_cmd_destroyer = spot_light_component__cmd_destroyer,
     mcp_hint             = "Cone-shaped light with direction / distance falloff and inner/outer "
-                           "cone angles"
+                           "cone angles",
+    tick_phase           = pre_physics
 );
 class spot_light : public ::kryga::root::game_object
 // clang-format on
@@ -45,7 +45,8 @@
                                                                                                \
     virtual bool META_default_construct(const ::kryga::root::base_construct_params& i);        \
                                                                                                \
-    static std::shared_ptr<this_class> AR_TYPE_create_empty_obj(const ::kryga::utils::id& id); \
+    static std::shared_ptr<this_class> AR_TYPE_create_empty_obj(                               \
+        const ::kryga::utils::id& id, ::kryga::reflection::object_arena* arena = nullptr);     \
                                                                                                \
     static std::shared_ptr<::kryga::root::smart_object> AR_TYPE_create_empty_gen_obj(          \
         ::kryga::reflection::type_context__alloc& ctx);                                        \
@@ -60,6 +61,7 @@ namespace reflection
 {
 struct reflection_type;
 struct type_context__alloc;
+class object_arena;
 }  // namespace reflection
 
 namespace core
@@ -136,6 +138,7 @@ public:
     KRG_gen_meta_api;
 
     friend class core::object_constructor;
+    friend class core::level;
 
     template <typename T>
     bool
@@ -263,6 +266,13 @@ public:
     const utils::id&
     get_type_id() const;
 
+    // Play-mode copy-on-write hook: call BEFORE writing a reflected property
+    // outside a generated setter (setters and editor/RPC property writes already
+    // do). The first write in a play session captures the object's pre-play values
+    // so core::level::rollback() restores only what the session touched.
+    void
+    before_write();
+
 protected:
     void
     META_set_id(const utils::id& id)
@@ -310,6 +320,11 @@ protected:
     // transform/outline without an id lookup. Runtime only, not serialized.
     ::kryga::render::types::render_object_handle m_render_object_handle = {};
 
+    // Play session (core::level::snapshot epoch) this object was captured or
+    // spawned in; 0 = never. Runtime only, not serialized.
+    uint32_t m_play_epoch = 0;
+    bool m_play_spawned = false;
+
 public:
     bool
     get_render_built() const
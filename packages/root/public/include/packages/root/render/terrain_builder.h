@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace kryga::root
+{
+class texture;
+
+// Grid layout, LOD bands and height-field math behind the terrain render and physics
+// builders
+
+// Widest chunk, in cells, and how many levels (cell strides 1, 2, 4, ...) it has
+constexpr uint32_t k_terrain_chunk_cells = 64u;
+constexpr uint32_t k_terrain_lod_levels = 5u;
+// Far share of each level's distance band spent morphing into the next level
+constexpr float k_terrain_morph_fraction = 0.3f;
+
+struct terrain_layout
+{
+    uint32_t res = 0;          // vertices per side of the whole grid
+    uint32_t chunk_cells = 0;  // cells per chunk side, a power of two
+    uint32_t chunks = 0;       // chunks per side
+    uint32_t lod_levels = 0;
+};
+
+// The requested resolution rounded up so the cells split into whole chunks
+terrain_layout
+terrain_layout_for_resolution(uint32_t resolution);
+
+// Distance bands: level L is drawn up to base * 2^L, the base spanning the widest
+// chunk (world radius) twice so neighbouring chunks stay within one level. Level L
+// morphs into L + 1 from morph_start[L] to the end of its band.
+void
+terrain_lod_bands(float max_chunk_radius,
+                  uint32_t lod_levels,
+                  std::vector<float>& range,
+                  std::vector<float>& morph_start);
+
+// Integer hash → [0,1). Deterministic for a given (x, y, seed).
+float
+terrain_hash(int32_t x, int32_t y, uint32_t seed);
+
+// Noise is evaluated this many samples at a time. The lane loops are branch-free
+// fixed-width loops the compiler keeps in vector registers.
+constexpr uint32_t k_terrain_noise_lanes = 8u;
+
+struct terrain_noise
+{
+    uint32_t seed = 0;
+    uint32_t octaves = 1;
+    float frequency = 1.0f;
+    float lacunarity = 2.0f;
+    float gain = 0.5f;
+};
+
+// Smoothstep-blended value noise at (x[l], y) for k_terrain_noise_lanes samples
+void
+terrain_value_noise8(const float* x, float y, uint32_t seed, float* out);
+
+// fbm in [0,1] for k_terrain_noise_lanes samples along one row. u,v in [0,1] across
+// the terrain.
+void
+terrain_fbm8(const float* u, float v, const terrain_noise& n, float* out);
+
+// Everything the normalized grid depends on. Height scale and transform apply
+// later, so they are not part of it and changing them keeps the cached grid.
+struct terrain_height_params
+{
+    uint32_t res = 0;
+    uint32_t source_mode = 0;
+    const texture* heightmap = nullptr;
+    terrain_noise noise;
+};
+
+template <typename terrain>
+terrain_height_params
+terrain_height_params_for(const terrain& tc, uint32_t res)
+{
+    return {.res = res,
+            .source_mode = tc.get_source_mode(),
+            .heightmap = tc.get_heightmap(),
+            .noise = {.seed = tc.get_seed(),
+                      .octaves = std::clamp<uint32_t>(tc.get_octaves(), 1u, 8u),
+                      .frequency = tc.get_frequency(),
+                      .lacunarity = tc.get_lacunarity(),
+                      .gain = tc.get_gain()}};
+}
+
+// Identifies the normalized grid. Noise settings only count for procedural terrain,
+// the heightmap only for heightmap terrain.
+uint64_t
+terrain_height_key(const terrain_height_params& p);
+
+}  // namespace kryga::root
@@ -23,7 +23,8 @@ using namespace kryga;
 // Unit tests for level::snapshot()/rollback() (play-mode option B). These cover
 // the model-state outcomes of a play session — survivor reset, spawned cleanup,
 // destroyed-survivor revive — independent of the render bridge (rollback only
-// enqueues render work). See docs/plans/play-mode-state-snapshot.md.
+// enqueues render work). Pre-play values are captured copy-on-write, on each
+// object's first write of the session.
 struct test_level_rollback : base_test
 {
     void
@@ -178,3 +179,33 @@ TEST_F(test_level_rollback, destroy_and_spawn_together)
     EXPECT_TRUE(lvl.find_game_object(AID("rb_b")));     // untouched survivor
     EXPECT_FALSE(lvl.find_game_object(AID("rb_new")));  // spawned: cleaned
 }
+
+// Copy-on-write capture: only the FIRST write of a session records the pre-play
+// value, and a second session captures afresh instead of reusing the first one's.
+TEST_F(test_level_rollback, first_write_captured_per_session)
+{
+    core::level lvl(AID("rb_lvl_6"));
+    auto* go = spawn(lvl, "rb_cow", root::vec3(1.f, 0.f, 0.f));
+    auto* idle = spawn(lvl, "rb_idle", root::vec3(2.f, 0.f, 0.f));
+    ASSERT_TRUE(go && idle);
+    EXPECT_FALSE(lvl.in_play_session());
+
+    lvl.snapshot();
+    EXPECT_TRUE(lvl.in_play_session());
+    go->set_position(root::vec3(5.f, 0.f, 0.f));
+    go->set_position(root::vec3(6.f, 0.f, 0.f));  // already captured: value 1 kept
+    lvl.rollback();
+    EXPECT_FALSE(lvl.in_play_session());
+
+    EXPECT_FLOAT_EQ(go->get_position().x, 1.f);
+    EXPECT_FLOAT_EQ(idle->get_position().x, 2.f);  // never written, never captured
+
+    // Edit-mode writes between sessions are the new baseline
+    go->set_position(root::vec3(3.f, 0.f, 0.f));
+
+    lvl.snapshot();
+    go->set_position(root::vec3(7.f, 0.f, 0.f));
+    lvl.rollback();
+
+    EXPECT_FLOAT_EQ(go->get_position().x, 3.f);
+}
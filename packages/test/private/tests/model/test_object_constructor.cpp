@@ -293,3 +293,31 @@ TEST_F(test_object_constructor, load_sets_package)
     ASSERT_TRUE(result.has_value());
     ASSERT_EQ(result.value()->get_package(), lc.get_package());
 }
+
+// Objects constructed in a level come from that level's per-type arena, so
+// same-type instances are packed next to each other.
+TEST_F(test_object_constructor, level_objects_allocated_from_level_arena)
+{
+    core::level lvl(AID("arena_lvl"));
+
+    root::game_object::construct_params p;
+    auto* a = lvl.spawn_object<root::game_object>(AID("arena_a"), p);
+    auto* b = lvl.spawn_object<root::game_object>(AID("arena_b"), p);
+    ASSERT_TRUE(a && b);
+
+    auto* rt = glob::glob_state().getr_model().reflection.get_type(AID("game_object"));
+    ASSERT_TRUE(rt);
+
+    auto pool = lvl.get_arena().pool_for(*rt);
+    EXPECT_EQ(pool->live(), 2u);
+    EXPECT_NE(pool, rt->pool);
+
+    // Their components went to other pools, so the two game_objects are neighbours
+    EXPECT_EQ(reinterpret_cast<const uint8_t*>(b) - reinterpret_cast<const uint8_t*>(a),
+              static_cast<ptrdiff_t>(pool->block_size()));
+
+    // Releasing the arena drops the pools; live objects keep theirs
+    lvl.get_arena().release();
+    EXPECT_EQ(lvl.get_arena().pool_count(), 0u);
+    EXPECT_EQ(pool->live(), 2u);
+}
@@ -7,6 +7,8 @@
 #include <core/model_system.h>
 #include <global_state/global_state.h>
 #include <core/reflection/reflection_type.h>
+#include <core/reflection/reflection_type_utils.h>
+#include <core/construction_utils.h>
 #include <core/architype.h>
 #include <core/object_load_context.h>
 #include <testing/testing.h>
@@ -35,6 +37,7 @@
 #include <utils/file_utils.h>
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 
@@ -556,6 +559,107 @@ TEST_F(test_preloaded_test_package, diff_object_properties_different_types_fails
     ASSERT_EQ(rc, result_code::failed);
 }
 
+TEST_F(test_preloaded_test_package, pod_ranges_coalesce_trivial_properties)
+{
+    auto* rt = glob::glob_state().getr_model().reflection.get_type(AID("game_object_component"));
+    ASSERT_TRUE(rt);
+
+    // Every POD serialization property sits in exactly one range, the rest keep handlers
+    size_t covered = 0;
+    for (const auto& r : rt->m_serialization_pod_ranges)
+    {
+        uint32_t offset = r.offset;
+        for (uint32_t i = r.first; i < r.first + r.count; ++i)
+        {
+            auto& p = *rt->m_serialization_properties[rt->m_serialization_pod_index[i]];
+            EXPECT_EQ(p.offset, offset) << p.name;
+            offset += p.pod_size;
+        }
+        EXPECT_EQ(offset, r.offset + r.size);
+        covered += r.count;
+    }
+    EXPECT_EQ(covered, rt->m_serialization_pod_index.size());
+    EXPECT_EQ(covered + rt->m_serialization_handled_properties.size(),
+              rt->m_serialization_properties.size());
+
+    // position/rotation/scale are adjacent vec3s: one 36-byte block
+    auto position = std::find_if(rt->m_serialization_properties.begin(),
+                                 rt->m_serialization_properties.end(),
+                                 [](const auto& p) { return p->name == "position"; });
+    ASSERT_NE(position, rt->m_serialization_properties.end());
+    ASSERT_EQ((*position)->pod_size, sizeof(root::vec3));
+
+    auto range = std::find_if(rt->m_serialization_pod_ranges.begin(),
+                              rt->m_serialization_pod_ranges.end(),
+                              [&](const auto& r) { return r.offset == (*position)->offset; });
+    ASSERT_NE(range, rt->m_serialization_pod_ranges.end());
+    EXPECT_GE(range->size, 3 * sizeof(root::vec3));
+}
+
+TEST_F(test_preloaded_test_package, diff_object_properties_pod_fast_path)
+{
+    auto* rt = glob::glob_state().getr_model().reflection.get_type(AID("game_object_component"));
+    ASSERT_TRUE(rt);
+
+    auto id_a = AID("pod_diff_a");
+    auto id_b = AID("pod_diff_b");
+    reflection::type_context__alloc ctx_a{&id_a};
+    reflection::type_context__alloc ctx_b{&id_b};
+    auto a = rt->alloc(ctx_a);
+    auto b = rt->alloc(ctx_b);
+
+    std::vector<reflection::property*> baseline;
+    ASSERT_EQ(core::diff_object_properties(*a, *b, baseline), result_code::ok);
+
+    auto find = [&](const char* name)
+    {
+        for (auto& p : rt->m_serialization_properties)
+        {
+            if (p->name == name)
+            {
+                return p.get();
+            }
+        }
+        return (reflection::property*)nullptr;
+    };
+    auto* rotation = find("rotation");
+    ASSERT_TRUE(rotation);
+
+    // Bytes differ, values equal: the range mismatches but the real compare wins
+    reflection::utils::as_type<root::vec3>(rotation->get_blob(*a)) = root::vec3(0.f, 0.f, 0.f);
+    reflection::utils::as_type<root::vec3>(rotation->get_blob(*b)) = root::vec3(-0.f, 0.f, 0.f);
+    std::vector<reflection::property*> diff;
+    ASSERT_EQ(core::diff_object_properties(*a, *b, diff), result_code::ok);
+    EXPECT_EQ(diff, baseline);
+
+    reflection::utils::as_type<root::vec3>(rotation->get_blob(*b)) = root::vec3(0.f, 90.f, 0.f);
+    diff.clear();
+    ASSERT_EQ(core::diff_object_properties(*a, *b, diff), result_code::ok);
+    ASSERT_EQ(diff.size(), baseline.size() + 1);
+    EXPECT_NE(std::find(diff.begin(), diff.end(), rotation), diff.end());
+
+    // Diff order follows m_serialization_properties, as the per-property walk did
+    auto index_of = [&](reflection::property* p)
+    {
+        for (size_t i = 0; i < rt->m_serialization_properties.size(); ++i)
+        {
+            if (rt->m_serialization_properties[i].get() == p)
+            {
+                return i;
+            }
+        }
+        return rt->m_serialization_properties.size();
+    };
+    for (size_t i = 1; i < diff.size(); ++i)
+    {
+        EXPECT_LT(index_of(diff[i - 1]), index_of(diff[i]));
+    }
+
+    // Block copy brings the POD fields over
+    rt->copy_pod(*a, *b);
+    EXPECT_EQ(reflection::utils::as_type<root::vec3>(rotation->get_blob(*b)), root::vec3(0.f));
+}
+
 TEST_F(test_preloaded_test_package, load_nonexistent_object_fails)
 {
     auto& lc = test::package::instance().get_load_context();
@@ -0,0 +1,234 @@
+#include <core/level.h>
+#include <core/model_system.h>
+#include <core/package_manager.h>
+#include <core/core_state.h>
+#include <core/tick_scheduler.h>
+#include <core/reflection/reflection_type.h>
+#include <global_state/global_state.h>
+#include <jobs/job_system.h>
+#include <vfs/vfs_state.h>
+#include <vfs/vfs.h>
+#include <vfs/physical_backend.h>
+#include <testing/testing.h>
+
+#include "packages/root/package.root.h"
+#include "packages/root/package.root.types_builder.ar.h"
+#include "packages/test/package.test.h"
+
+#include <packages/root/model/game_object.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace kryga;
+
+namespace
+{
+
+std::vector<std::string> g_order;
+std::atomic<uint32_t> g_ticks = 0;
+root::smart_object* g_shared = nullptr;
+
+void
+record_order(root::smart_object& obj, float)
+{
+    g_order.push_back(obj.get_id().str());
+}
+
+void
+count_tick(root::smart_object&, float)
+{
+    g_ticks.fetch_add(1);
+}
+
+void
+write_self(root::smart_object& obj, float)
+{
+    obj.before_write();
+}
+
+void
+write_shared(root::smart_object&, float)
+{
+    g_shared->before_write();
+}
+
+core::tick_desc
+declared(core::tick_phase phase, uint32_t reads, uint32_t writes)
+{
+    return {.phase = phase, .reads = reads, .writes = writes, .declared = true};
+}
+
+}  // namespace
+
+// core::tick_scheduler: per-type batching, phase order, wave packing by declared
+// access sets and the conflicting-write validator. Test reflection types stand in
+// for real ones so each batch's tick function is observable.
+struct test_tick_scheduler : base_test
+{
+    void
+    SetUp() override
+    {
+        glob::glob_state_reset();
+
+        auto& gs = glob::glob_state();
+        state_mutator__vfs::set(gs);
+        {
+            auto root = std::filesystem::current_path().parent_path();
+            auto& vfs = gs.getr_vfs();
+            vfs.mount("data", std::make_unique<vfs::physical_backend>(root), 0);
+            vfs.mount("cache", std::make_unique<vfs::physical_backend>(root / "cache"), 0);
+            vfs.mount("tmp", std::make_unique<vfs::physical_backend>(root / "tmp"), 0);
+            vfs.mount(
+                "generated",
+                std::make_unique<vfs::physical_backend>(root.parent_path() / "kryga_generated"),
+                0);
+        }
+        core::state_mutator__lua_api::set(gs);
+        core::state_mutator__model::set(gs);
+        auto& pm = gs.getr_model().packages;
+
+        gs.run_create();
+        {
+            pm.register_static_package_loader<root::package>();
+            auto& pkg = pm.load_static_package<root::package>();
+            pkg.register_package_extension<root::package::package_types_builder>();
+            pkg.complete_load();
+        }
+        {
+            pm.register_static_package_loader<test::package>();
+            auto& pkg = pm.load_static_package<test::package>();
+            pkg.init();
+            pkg.finalize_reflection();
+        }
+
+        g_order.clear();
+        g_ticks = 0;
+        g_shared = nullptr;
+    }
+
+    void
+    TearDown() override
+    {
+        test::package::instance().unload();
+        root::package::instance().unload();
+        glob::glob_state_reset();
+
+        base_test::TearDown();
+    }
+
+    static root::game_object*
+    spawn(core::level& lvl, const char* id)
+    {
+        root::game_object::construct_params p;
+        return lvl.spawn_object<root::game_object>(AID(id), p);
+    }
+};
+
+TEST_F(test_tick_scheduler, batches_by_type_and_packs_waves)
+{
+    core::level lvl(AID("ts_lvl_1"));
+
+    reflection::reflection_type a(90001, AID("ts_type_a"));
+    reflection::reflection_type b(90002, AID("ts_type_b"));
+    reflection::reflection_type c(90003, AID("ts_type_c"));
+    reflection::reflection_type d(90004, AID("ts_type_d"));
+    a.tick = declared(core::tick_phase::pre_physics, 0, core::tick_access::transform);
+    b.tick = declared(core::tick_phase::pre_physics, core::tick_access::transform, 0);
+    c.tick = declared(core::tick_phase::pre_physics, core::tick_access::input, 0);
+    d.tick.phase = core::tick_phase::late;  // undeclared: alone, on the caller
+
+    core::tick_scheduler ts;  // no job system in this state: all on the caller
+
+    // Interleaved the way a level's object list would be
+    ts.add(d, *spawn(lvl, "d0"), &record_order);
+    ts.add(a, *spawn(lvl, "a0"), &record_order);
+    ts.add(b, *spawn(lvl, "b0"), &record_order);
+    ts.add(c, *spawn(lvl, "c0"), &record_order);
+    ts.add(a, *spawn(lvl, "a1"), &record_order);
+    ts.add(b, *spawn(lvl, "b1"), &record_order);
+    ts.run(0.f);
+
+    // a and c share a wave, b reads what a writes, d runs in the late phase
+    EXPECT_EQ(g_order, (std::vector<std::string>{"a0", "a1", "c0", "b0", "b1", "d0"}));
+    EXPECT_EQ(ts.get_stats().batches, 4u);
+    EXPECT_EQ(ts.get_stats().waves, 3u);
+    EXPECT_EQ(ts.get_stats().parallel_waves, 1u);
+
+    // Batches are kept; only the objects go
+    ts.clear();
+    g_order.clear();
+    ts.run(0.f);
+    EXPECT_TRUE(g_order.empty());
+    EXPECT_EQ(ts.get_stats().batches, 0u);
+}
+
+TEST_F(test_tick_scheduler, independent_batches_run_on_job_system)
+{
+    core::level lvl(AID("ts_lvl_2"));
+
+    std::vector<std::unique_ptr<reflection::reflection_type>> types;
+    for (int i = 0; i < 8; ++i)
+    {
+        auto& rt = types.emplace_back(std::make_unique<reflection::reflection_type>(
+            90100 + i, AID("ts_par_" + std::to_string(i))));
+        rt->tick = declared(core::tick_phase::animation, core::tick_access::transform, 0);
+    }
+
+    jobs::job_system js;
+    js.start(3);
+
+    core::tick_scheduler ts;
+    ts.set_job_system(&js);
+
+    uint32_t expected = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        auto id = "par_" + std::to_string(i);
+        ts.add(*types[i % types.size()], *spawn(lvl, id.c_str()), &count_tick);
+        ++expected;
+    }
+
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        ts.run(0.016f);
+    }
+
+    EXPECT_EQ(g_ticks.load(), expected * 4);
+    EXPECT_EQ(ts.get_stats().waves, 1u);
+    EXPECT_EQ(ts.get_stats().parallel_waves, 1u);
+}
+
+TEST_F(test_tick_scheduler, validation_reports_conflicting_writes)
+{
+    core::level lvl(AID("ts_lvl_3"));
+
+    reflection::reflection_type a(90201, AID("ts_val_a"));
+    reflection::reflection_type b(90202, AID("ts_val_b"));
+    a.tick = declared(core::tick_phase::post_physics, 0, 0);
+    b.tick = declared(core::tick_phase::post_physics, 0, 0);
+
+    auto& ts = lvl.get_tick_scheduler();
+    ts.set_validate(true);
+
+    // Honest: each batch writes only its own objects
+    ts.add(a, *spawn(lvl, "val_a"), &write_self);
+    ts.add(b, *spawn(lvl, "val_b"), &write_self);
+    ts.run(0.f);
+    EXPECT_EQ(ts.get_stats().conflicts, 0u);
+
+    // b declares nothing, yet writes an object a's batch writes as well
+    g_shared = lvl.find_game_object(AID("val_a"));
+    ts.clear();
+    ts.add(a, *g_shared, &write_self);
+    ts.add(b, *lvl.find_game_object(AID("val_b")), &write_shared);
+    ts.run(0.f);
+    EXPECT_EQ(ts.get_stats().conflicts, 1u);
+
+    // Outside a wave writes are not recorded
+    g_shared->before_write();
+    EXPECT_EQ(ts.get_stats().conflicts, 1u);
+}
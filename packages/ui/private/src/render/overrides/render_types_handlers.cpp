@@ -9,8 +9,6 @@
 
 #include <glm/glm.hpp>
 
-#include <algorithm>
-#include <cstring>
 
 namespace kryga
 {
@@ -81,10 +79,7 @@ ui_text__cmd_builder(reflection::type_context__render_cmd_build& ctx)
     cmd->font = text.get_font();
     cmd->visible = text.get_visible();
 
-    const std::string& s = text.get_text();
-    const size_t n = std::min(s.size(), static_cast<size_t>(ui_text_upsert_cmd::k_max_len - 1));
-    std::memcpy(cmd->text, s.data(), n);
-    cmd->text[n] = '\0';
+    cmd->text = std::make_shared<std::string>(text.get_text());
 
     ctx.rb->enqueue_cmd(cmd);
 
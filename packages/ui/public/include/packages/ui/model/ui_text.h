@@ -17,7 +17,7 @@ namespace ui
 {
 
 // Anchor of the text block against the viewport. Values MUST match the render
-// side (kryga_render::draw_ui_text): right/bottom anchors align the block to that
+// side (KGPU_UI_ANCHOR_* / ui_batcher): right/bottom anchors align the block to that
 // edge so e.g. a right-anchored score keeps its right edge fixed as it changes.
 enum class ui_text_anchor : int32_t
 {
@@ -29,10 +29,10 @@ enum class ui_text_anchor : int32_t
 
 // A single line of UI text. Glyph layout + font-atlas sampling happen render-side
 // (the model never reads the viewport or metrics); this widget just carries the
-// string, color, pixel font size, and anchor. m_text is a plain runtime member,
-// NOT a reflected/serialized property: it is driven by game code each frame (e.g.
-// a score), not authored in the editor. Setters mark the widget render-dirty so
-// the next frame rebuilds the ui_text_upsert command.
+// UTF-8 string (any length), color, pixel font size, and anchor. m_text is a
+// plain runtime member, NOT a reflected/serialized property: it is driven by game
+// code each frame (e.g. a score), not authored in the editor. Setters mark the
+// widget render-dirty so the next frame rebuilds the ui_text_upsert command.
 // clang-format off
 KRG_ar_class(render_cmd_builder   = ui_text__cmd_builder,
              render_cmd_destroyer = ui_text__cmd_destroyer);
@@ -74,6 +74,7 @@ public:
     void
     set_color(const ::kryga::root::vec4& v)
     {
+        before_write();
         m_color = v;
         mark_render_dirty();
     }
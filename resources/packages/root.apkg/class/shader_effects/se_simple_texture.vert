@@ -13,6 +13,8 @@ layout(push_constant, scalar) uniform Constants { push_constants_main obj; } con
 void main()
 {
     uint obj_idx = get_object_index(constants.obj.instance_base);
+    vec3 position = vertex_position(obj_idx);
+    vec3 normal   = vertex_normal();
     mat4 modelMatrix   = dyn_object_buffer.objects[obj_idx].model;
     mat4 normalMatrix  = dyn_object_buffer.objects[obj_idx].normal;
 
@@ -21,9 +23,9 @@ void main()
     out_object_idx = obj_idx;
     out_color    = in_color;
     out_tex_coord = in_tex_coord;
-    out_normal   = mat3(normalMatrix) * in_normal;
-    out_world_pos  = vec3(modelMatrix * vec4(in_position, 1));
+    out_normal   = mat3(normalMatrix) * normal;
+    out_world_pos  = vec3(modelMatrix * vec4(position, 1));
     out_lightmap_uv = vec2(0);
 
-    gl_Position =  dyn_camera_data.obj.projection * modelView * vec4(in_position, 1.0);
+    gl_Position =  dyn_camera_data.obj.projection * modelView * vec4(position, 1.0);
 }
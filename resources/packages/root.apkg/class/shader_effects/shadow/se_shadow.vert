@@ -10,12 +10,7 @@ layout(push_constant, scalar) uniform Constants { push_constants_shadow obj; } c
 #include "bda_macros_shadow.glsl"
 
 #include "gpu_types/gpu_generic_constants.h"
-
-layout (location = 0) in vec3 in_position;
-layout (location = 1) in vec3 in_normal;
-layout (location = 2) in vec3 in_color;
-layout (location = 3) in vec2 in_tex_coord;
-layout (location = 4) in vec2 in_lightmap_uv;
+#include "mesh_vertex_input.glsl"
 
 uint get_object_index() {
     return dyn_instance_slots.slots[constants.obj.instance_base + gl_InstanceIndex];
@@ -24,6 +19,7 @@ uint get_object_index() {
 void main()
 {
     uint obj_idx = get_object_index();
+    vec3 position = vertex_position(obj_idx);
     mat4 model = dyn_object_buffer.objects[obj_idx].model;
 
     // directional_light_id encodes the shadow index (cascade or local light)
@@ -36,5 +32,5 @@ void main()
     else
         light_vp = dyn_shadow_data.shadow.local_shadows[shadow_idx].view_proj;
 
-    gl_Position = light_vp * model * vec4(in_position, 1.0);
+    gl_Position = light_vp * model * vec4(position, 1.0);
 }
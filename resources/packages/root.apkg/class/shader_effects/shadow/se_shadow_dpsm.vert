@@ -10,12 +10,7 @@ layout(push_constant, scalar) uniform Constants { push_constants_shadow obj; } c
 #include "bda_macros_shadow.glsl"
 
 #include "gpu_types/gpu_generic_constants.h"
-
-layout (location = 0) in vec3 in_position;
-layout (location = 1) in vec3 in_normal;
-layout (location = 2) in vec3 in_color;
-layout (location = 3) in vec2 in_tex_coord;
-layout (location = 4) in vec2 in_lightmap_uv;
+#include "mesh_vertex_input.glsl"
 
 layout (location = 0) out float out_depth;
 
@@ -26,6 +21,7 @@ uint get_object_index() {
 void main()
 {
     uint obj_idx = get_object_index();
+    vec3 position = vertex_position(obj_idx);
     mat4 model = dyn_object_buffer.objects[obj_idx].model;
 
     // Use directional_light_id field to encode shadow index
@@ -37,7 +33,7 @@ void main()
     float farPlane = dyn_shadow_data.shadow.local_shadows[shadow_idx].far_plane;
 
     // Transform to light space
-    vec4 worldPos = model * vec4(in_position, 1.0);
+    vec4 worldPos = model * vec4(position, 1.0);
     vec3 L = (lightView * worldPos).xyz;
 
     // use_clustered_lighting field reused as hemisphere selector (0=front, 1=back)
@@ -13,13 +13,15 @@ layout(push_constant, scalar) uniform Constants { push_constants_main obj; } con
 void main()
 {
     uint obj_idx = get_object_index(constants.obj.instance_base);
+    vec3 position = vertex_position(obj_idx);
+    vec3 normal   = vertex_normal();
     mat4 model = dyn_object_buffer.objects[obj_idx].model;
 
-    vec4 worldPos = model * vec4(in_position, 1.0);
+    vec4 worldPos = model * vec4(position, 1.0);
     gl_Position = dyn_camera_data.obj.projection * dyn_camera_data.obj.view * worldPos;
 
     out_world_pos = worldPos.xyz;
-    out_normal = in_normal;
+    out_normal = normal;
     out_color = in_color;
     out_tex_coord = in_tex_coord;
     out_object_idx = obj_idx;
@@ -0,0 +1,52 @@
+#version 450
+#extension GL_GOOGLE_include_directive: enable
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_buffer_reference2 : require
+#extension GL_EXT_buffer_reference_uvec2 : require
+#extension GL_EXT_scalar_block_layout : require
+
+layout(constant_id = 0) const bool ENABLE_LIGHTMAP = false;
+
+#include "gpu_types/gpu_push_constants_main.h"
+layout(push_constant, scalar) uniform Constants { push_constants_main obj; } constants;
+#include "bda_macros_main.glsl"
+#include "common_vert.glsl"
+
+// Terrain chunk vertices carry their CDLOD morph in the color slot:
+//   x = local height of the next coarser level at this vertex
+//   y, z = camera distance where the morph towards it starts / ends
+// Vertices shared with the coarser level have an unreachable range and never move.
+void main()
+{
+    uint obj_idx = get_object_index(constants.obj.instance_base);
+    mat4 modelMatrix   = dyn_object_buffer.objects[obj_idx].model;
+    mat4 normalMatrix  = dyn_object_buffer.objects[obj_idx].normal;
+
+    vec3 world  = vec3(modelMatrix * vec4(in_position, 1));
+    float dist  = distance(world, dyn_camera_data.obj.position);
+    float morph = clamp((dist - in_color.y) / max(in_color.z - in_color.y, 1e-4), 0.0, 1.0);
+
+    vec3 position = in_position;
+    position.y = mix(in_position.y, in_color.x, morph);
+
+    mat4 modelView = dyn_camera_data.obj.view * modelMatrix;
+
+    out_object_idx = obj_idx;
+    out_color      = vec3(1.0);
+    out_tex_coord  = in_tex_coord;
+
+    if (ENABLE_LIGHTMAP)
+    {
+        out_lightmap_uv = in_lightmap_uv * dyn_object_buffer.objects[obj_idx].lightmap_scale
+                        + dyn_object_buffer.objects[obj_idx].lightmap_offset;
+    }
+    else
+    {
+        out_lightmap_uv = vec2(0);
+    }
+
+    out_normal     = mat3(normalMatrix) * in_normal;
+    out_world_pos  = vec3(modelMatrix * vec4(position, 1));
+
+    gl_Position =  dyn_camera_data.obj.projection * modelView * vec4(position, 1.0);
+}
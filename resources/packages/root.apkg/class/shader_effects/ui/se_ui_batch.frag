@@ -0,0 +1,40 @@
+#version 450
+#extension GL_GOOGLE_include_directive : enable
+#extension GL_EXT_nonuniform_qualifier : require
+
+#include "gpu_types/gpu_generic_constants.h"
+#include "gpu_types/gpu_ui_types.h"
+
+// Panels are flat color; glyphs sample a signed distance field (R8, 0.5 on the
+// outline) from a font atlas page in the GLOBAL bindless set. The edge is
+// antialiased over one screen pixel via fwidth, so any font_size stays crisp from
+// the one bake. Pages are indexed per instance, so text in different fonts still
+// shares the one draw.
+layout(set = KGPU_textures_descriptor_sets, binding = 0) uniform sampler static_samplers[KGPU_SAMPLER_COUNT];
+layout(set = KGPU_textures_descriptor_sets, binding = 1) uniform texture2D bindless_textures[];
+
+layout(location = 0) in vec2 in_uv;
+layout(location = 1) in vec4 in_color;
+layout(location = 2) flat in uint in_tex_index;
+layout(location = 3) flat in uint in_sampler_index;
+
+layout(location = 0) out vec4 out_color;
+
+void main()
+{
+    if (in_tex_index == KGPU_UI_NO_TEXTURE)
+    {
+        out_color = in_color;
+        return;
+    }
+
+    float dist = texture(
+        sampler2D(bindless_textures[nonuniformEXT(in_tex_index)],
+                  static_samplers[nonuniformEXT(in_sampler_index)]),
+        in_uv).r;
+
+    float aa = max(fwidth(dist) * 0.5, 1e-4);
+    float coverage = smoothstep(0.5 - aa, 0.5 + aa, dist);
+
+    out_color = vec4(in_color.rgb, in_color.a * coverage);
+}
@@ -0,0 +1,58 @@
+#version 450
+#extension GL_GOOGLE_include_directive : enable
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_buffer_reference_uvec2 : require
+#extension GL_EXT_scalar_block_layout : require
+
+// Batched UI vertex shader — every panel and glyph is one instance.
+//
+// No vertex buffer: gl_VertexIndex (6 verts, 2 triangles) picks the quad corner,
+// gl_InstanceIndex picks the ui_quad written by ui_batcher. Rects are in pixels
+// relative to their anchor corner; pixel -> NDC happens here so a viewport resize
+// needs no CPU re-layout. Vulkan NDC +y points down, same as pixel +y.
+
+#include "gpu_types/gpu_ui_types.h"
+
+layout(buffer_reference, scalar) readonly buffer BdaUiQuadsRef {
+    ui_quad quads[];
+};
+
+layout(push_constant, scalar) uniform Constants { push_constants_ui ui; } constants;
+
+layout(location = 0) out vec2 out_uv;
+layout(location = 1) out vec4 out_color;
+layout(location = 2) flat out uint out_tex_index;
+layout(location = 3) flat out uint out_sampler_index;
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    const vec2 corners[6] = vec2[](
+        vec2(0.0, 0.0),
+        vec2(1.0, 0.0),
+        vec2(1.0, 1.0),
+        vec2(0.0, 0.0),
+        vec2(1.0, 1.0),
+        vec2(0.0, 1.0)
+    );
+
+    ui_quad q = BdaUiQuadsRef(constants.ui.bdag_quads).quads[gl_InstanceIndex];
+    vec2 c = corners[gl_VertexIndex];
+    vec2 vp = constants.ui.viewport_size;
+
+    bool right  = (q.anchor == KGPU_UI_ANCHOR_TOP_RIGHT || q.anchor == KGPU_UI_ANCHOR_BOTTOM_RIGHT);
+    bool bottom = (q.anchor == KGPU_UI_ANCHOR_BOTTOM_LEFT || q.anchor == KGPU_UI_ANCHOR_BOTTOM_RIGHT);
+    vec2 origin = vec2(right ? vp.x : 0.0, bottom ? vp.y : 0.0);
+
+    vec2 px = origin + mix(q.rect_px.xy, q.rect_px.zw, c);
+
+    out_uv = mix(q.uv_rect.xy, q.uv_rect.zw, c);
+    out_color = q.color;
+    out_tex_index = q.tex_index;
+    out_sampler_index = q.sampler_index;
+    gl_Position = vec4(px / vp * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -3,15 +3,7 @@
 // Required macros: dyn_instance_slots, dyn_object_buffer
 
 #include "gpu_types/gpu_generic_constants.h"
-
-layout (location = 0) in vec3 in_position;
-layout (location = 1) in vec3 in_normal;
-layout (location = 2) in vec3 in_color;
-layout (location = 3) in vec2 in_tex_coord;
-
-#ifndef KRYGA_SKINNED
-layout (location = 4) in vec2 in_lightmap_uv;
-#endif
+#include "mesh_vertex_input.glsl"
 
 layout (location = 0) out vec3 out_world_pos;
 layout (location = 1) out vec3 out_normal;
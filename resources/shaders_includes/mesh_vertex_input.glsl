@@ -0,0 +1,29 @@
+// Mesh vertex inputs. Full meshes feed gpu::vertex_data as is. The compact pipeline
+// variant feeds gpu::compact_vertex_data through normalized formats and turns
+// COMPACT_VERTEX on: color and UVs arrive ready to use, position as a fraction of the
+// mesh bounds and the normal octahedral in .xy. Read both through the helpers below.
+// Required macros: dyn_object_buffer
+
+#include "vertex_decode.glsl"
+
+layout(constant_id = 1) const bool COMPACT_VERTEX = false;
+
+layout (location = 0) in vec3 in_position;
+layout (location = 1) in vec3 in_normal;
+layout (location = 2) in vec3 in_color;
+layout (location = 3) in vec2 in_tex_coord;
+layout (location = 4) in vec2 in_lightmap_uv;
+
+vec3 vertex_position(uint obj_idx)
+{
+    if (!COMPACT_VERTEX)
+        return in_position;
+
+    return in_position * dyn_object_buffer.objects[obj_idx].position_scale
+         + dyn_object_buffer.objects[obj_idx].position_offset;
+}
+
+vec3 vertex_normal()
+{
+    return COMPACT_VERTEX ? oct_decode(in_normal.xy) : in_normal;
+}
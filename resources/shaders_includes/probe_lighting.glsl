@@ -26,6 +26,10 @@ vec3 evaluate_probe_lighting_interpolated(vec3 world_pos, vec3 normal)
     if (g.probe_count == 0u || g.spacing < 0.001)
         return vec3(0.0);
 
+    // Needs a grid with a cell on every axis; flat lists go through probe_index
+    if (g.grid_size_x < 2u || g.grid_size_y < 2u || g.grid_size_z < 2u)
+        return vec3(0.0);
+
     // Find grid cell
     vec3 rel = (world_pos - g.grid_min) / g.spacing;
     vec3 f = fract(rel);
@@ -52,6 +56,11 @@ vec3 evaluate_probe_lighting_interpolated(vec3 world_pos, vec3 normal)
                 if (idx >= g.probe_count)
                     continue;
 
+                // Probes rejected by validation (stuck in geometry) have radius 0;
+                // dropping them from the blend is what stops light leaking
+                if (dyn_probe_data.probes[idx].radius <= 0.0)
+                    continue;
+
                 float wx = (dx == 0) ? (1.0 - f.x) : f.x;
                 float wy = (dy == 0) ? (1.0 - f.y) : f.y;
                 float wz = (dz == 0) ? (1.0 - f.z) : f.z;
@@ -65,3 +74,15 @@ vec3 evaluate_probe_lighting_interpolated(vec3 world_pos, vec3 normal)
 
     return (weight_sum > 0.0) ? result / weight_sum : vec3(0.0);
 }
+
+// Grid probes interpolate by position; a flat (adaptive) list has no layout to
+// interpolate over and uses the probe assigned to the object
+vec3 evaluate_probe_lighting_any(uint object_idx, vec3 world_pos, vec3 normal)
+{
+    probe_grid_config g = dyn_probe_grid.grid;
+
+    if (g.grid_size_x >= 2u && g.grid_size_y >= 2u && g.grid_size_z >= 2u)
+        return evaluate_probe_lighting_interpolated(world_pos, normal);
+
+    return evaluate_probe_lighting(object_idx, normal);
+}
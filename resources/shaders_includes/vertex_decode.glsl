@@ -0,0 +1,23 @@
+// Decode of the compact vertex layouts (gpu::compact_vertex_data,
+// gpu::compact_skinned_vertex_data). The encode side is render::encode_compact_vertices.
+
+vec3 oct_decode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+// For vertices read by address; the vertex input path gets these from the formats
+vec3 unpack_position(uvec2 p, vec3 scale, vec3 offset)
+{
+    vec3 f = vec3(unpackUnorm2x16(p.x), unpackUnorm2x16(p.y).x);
+    return f * scale + offset;
+}
+
+vec3 unpack_normal(uint n)
+{
+    return oct_decode(unpackSnorm2x16(n));
+}
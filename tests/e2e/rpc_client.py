@@ -158,6 +158,8 @@ class EngineRPC:
         self._buf = b""
         self._next_id = 1
         self._timeout = timeout
+        # Binary notifications (render.screenshot.stream): (params, payload)
+        self.binary_frames: list = []
         self._discovery = discovery_path or DEFAULT_DISCOVERY
 
     @property
@@ -185,7 +187,8 @@ class EngineRPC:
             f"Content-Length: {len(body)}\r\n\r\n".encode("ascii") + body
         )
 
-    def _recv_response(self, want_id: int) -> dict:
+    def _recv_frame(self):
+        """Read one frame. Returns (msg, payload); payload is None for plain JSON."""
         while True:
             while b"\r\n\r\n" not in self._buf:
                 chunk = self._sock.recv(8192)
@@ -195,17 +198,30 @@ class EngineRPC:
                 self._buf += chunk
             head, _, rest = self._buf.partition(b"\r\n\r\n")
             length = 0
+            json_length = None
             for line in head.split(b"\r\n"):
                 if line.lower().startswith(b"content-length:"):
                     length = int(line.split(b":", 1)[1].strip())
+                elif line.lower().startswith(b"json-length:"):
+                    json_length = int(line.split(b":", 1)[1].strip())
             while len(rest) < length:
                 chunk = self._sock.recv(length - len(rest))
                 if not chunk:
                     self._sock = None
                     raise ConnectionError("Engine closed mid-frame")
                 rest += chunk
-            msg = json.loads(rest[:length].decode("utf-8"))
+            body = rest[:length]
             self._buf = rest[length:]
+            if json_length is None:
+                return json.loads(body.decode("utf-8")), None
+            return json.loads(body[:json_length].decode("utf-8")), body[json_length:]
+
+    def _recv_response(self, want_id: int) -> dict:
+        while True:
+            msg, payload = self._recv_frame()
+            if payload is not None:
+                self.binary_frames.append((msg.get("params", {}), payload))
+                continue
             if msg.get("id") == want_id:
                 return msg
 
@@ -316,3 +332,18 @@ class EngineRPC:
         elif x or y or width or height:
             params.update({"x": x, "y": y, "width": width, "height": height})
         return self.call("render.screenshot", params)
+
+    def screenshot_stream(self, count: int, fmt: str = "qoi",
+                          timeout: float = 10.0, **region) -> list:
+        """Stream `count` encoded frames as binary notifications.
+        Returns [(params, payload)] in arrival order."""
+        self.binary_frames = []
+        stream = self.call("render.screenshot.stream",
+                           {"format": fmt, "count": count, **region})["stream"]
+        deadline = time.monotonic() + timeout
+        while len(self.binary_frames) < count and time.monotonic() < deadline:
+            msg, payload = self._recv_frame()
+            if payload is not None:
+                self.binary_frames.append((msg.get("params", {}), payload))
+        self.call("render.screenshot.stream.stop", {"stream": stream})
+        return [f for f in self.binary_frames if f[0].get("stream") == stream]
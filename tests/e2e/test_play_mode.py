@@ -6,6 +6,7 @@ Runs against the cubes level which already has a player_0 game object.
 import pytest
 from root import game_object
 from . import assertions
+from .property_helpers import get_property, set_property
 
 # Pre-existing (surviving) object in the default test level.
 HERO = "hero_cube"
@@ -131,6 +132,27 @@ class TestPlayModeSurvivorRestore:
             _render_pos(engine, HERO_MESH), render_before,
             tolerance=0.05, label="hero_cube render after rollback")
 
+    def test_survivor_property_write_restored_on_exit(self, engine):
+        """A write through the property RPC (not a generated setter) is captured on
+        first touch too, and an object play never wrote to keeps its value."""
+        original = get_property(engine, HERO_MESH, "tickable")
+        untouched = game_object(engine, HERO).get_position()
+
+        engine.call_queued("engine.setMode", {"mode": "play"})
+        engine.wait_frame(3)
+
+        set_property(engine, HERO_MESH, "tickable", not original)
+        set_property(engine, HERO_MESH, "tickable", original)
+        set_property(engine, HERO_MESH, "tickable", not original)
+        assert get_property(engine, HERO_MESH, "tickable") == (not original)
+
+        engine.call_queued("engine.setMode", {"mode": "edit"})
+        engine.wait_frame(3)
+
+        # Restored to the value before the FIRST write, not an intermediate one
+        assert get_property(engine, HERO_MESH, "tickable") == original
+        assert game_object(engine, HERO).get_position() == untouched
+
 
 class TestPlayModeAttachedComponent:
     """A component grafted at runtime onto a PRE-EXISTING (surviving) object must be
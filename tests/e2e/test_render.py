@@ -124,3 +124,66 @@ class TestRenderStats:
     def test_stats_has_light_count(self, engine):
         stats = engine.call("render.stats")
         assert "light_count" in stats or "directional_light_count" in stats
+
+    def test_passes_report_gpu_timings(self, engine):
+        # Resolved one frames-in-flight cycle late; a few frames fill the window
+        engine.wait_frame(8)
+        passes = engine.call("render.passes")
+        assert "supported" in passes
+        if not passes["supported"]:
+            import pytest
+            pytest.skip("GPU timestamps not supported")
+
+        assert passes["resolved_frames"] > 0
+        names = [p["name"] for p in passes["passes"]]
+        assert len(names) > 0
+        assert len(set(names)) == len(names)
+        for p in passes["passes"]:
+            assert p["samples"] > 0
+            assert 0.0 <= p["min_ms"] <= p["avg_ms"] + 1e-6
+            assert p["min_ms"] <= p["p99_ms"] + 1e-6
+        assert passes["frame"]["avg_ms"] >= 0.0
+
+    def test_frame_telemetry_percentiles_and_stream(self, engine):
+        engine.wait_frame(10)
+        tel = engine.call("render.telemetry", {"since": 0})
+        assert tel["frames"] >= 10
+
+        interval = tel["metrics"]["interval"]
+        assert interval["count"] > 0
+        assert 0.0 < interval["p50_ms"] <= interval["p95_ms"] <= interval["p99_ms"]
+        assert interval["p99_ms"] <= interval["max_ms"] + 1e-6
+        for gate in ("pipeline", "render_idle", "frame_fence", "acquire"):
+            assert tel["stalls"][gate]["total_ms"] >= 0.0
+
+        records = tel["records"]
+        assert len(records) > 0
+        frames = [r["frame"] for r in records]
+        assert frames == sorted(frames)
+        assert 0 < records[-1]["begin_frame"] <= records[-1]["drain_end"]
+        assert tel["next"] == frames[-1] + 1
+
+        # Streaming cursor only returns frames committed since
+        engine.wait_frame(3)
+        more = engine.call("render.telemetry", {"since": tel["next"]})
+        assert all(r["frame"] >= tel["next"] for r in more["records"])
+
+        csv = engine.call("render.telemetry.csv", {"since": tel["next"]})
+        lines = csv["csv"].splitlines()
+        assert lines[0].startswith("frame,begin_frame_us,")
+        assert len(lines) == csv["rows"] + 1
+
+    def test_screenshot_stream_binary_qoi(self, engine):
+        frames = engine.screenshot_stream(4, fmt="qoi", width=64, height=32)
+        assert len(frames) == 4
+        seqs = [p["sequence"] for p, _ in frames]
+        assert seqs == sorted(seqs) and len(set(seqs)) == 4
+        for params, payload in frames:
+            assert params["format"] == "qoi"
+            assert payload[:4] == b"qoif"
+            assert int.from_bytes(payload[4:8], "big") == params["width"] == 64
+            assert int.from_bytes(payload[8:12], "big") == params["height"] == 32
+
+        # JSON path still works alongside, in the non-default format
+        shot = engine.call("render.screenshot", {"format": "qoi", "width": 8, "height": 8})
+        assert shot["image"].startswith("data:image/qoi;base64,")
@@ -79,6 +79,9 @@ TYPE_KEY_JSON_SAVE_HANDLER = "json_save_handler"
 TYPE_KEY_JSON_LOAD_HANDLER = "json_load_handler"
 TYPE_KEY_MCP_SCHEMA = "mcp_schema"
 TYPE_KEY_MCP_HINT = "mcp_hint"
+TYPE_KEY_TICK_PHASE = "tick_phase"
+TYPE_KEY_TICK_READS = "tick_reads"
+TYPE_KEY_TICK_WRITES = "tick_writes"
 
 # Package config keys
 PKG_KEY_MODEL_TYPES_OVERRIDES = "model.has_types_overrides"
@@ -104,6 +107,10 @@ VALID_ACCESS_VALUES = frozenset({
     "read_only", "write_only", "all"
 })
 
+# Tick scheduling values, mirror core::tick_phase / core::tick_access
+VALID_TICK_PHASES = frozenset({"pre_physics", "animation", "post_physics", "late"})
+VALID_TICK_ACCESS = frozenset({"transform", "render", "camera", "input", "audio", "physics"})
+
 # Valid boolean string values
 VALID_BOOL_VALUES = frozenset({"true", "false"})
 
@@ -199,6 +206,25 @@ _MCP_ATTR_MAP = {
     TYPE_KEY_MCP_HINT: 'mcp_hint',
 }
 
+# Tick declaration — accepted on any class; access sets are '|'-separated
+_TICK_ATTR_MAP = {
+    TYPE_KEY_TICK_PHASE: 'tick_phase',
+    TYPE_KEY_TICK_READS: 'tick_reads',
+    TYPE_KEY_TICK_WRITES: 'tick_writes',
+}
+
+
+def _validate_tick_value(type_obj: arapi.types.kryga_type, key: str, value: str) -> None:
+  if key == TYPE_KEY_TICK_PHASE:
+    if value not in VALID_TICK_PHASES:
+      raise ParserError(f"Unknown tick_phase '{value}' on type '{type_obj.name}'")
+    return
+
+  for access in value.split("|"):
+    if access not in VALID_TICK_ACCESS:
+      raise ParserError(f"Unknown {key} entry '{access}' on type '{type_obj.name}'")
+
+
 # Mapping from type config keys to attribute names for render overrides. Physics
 # command handlers ride the same render-overrides gate: they are declared in the
 # render override headers and registered in the same package_render_types_builder.
@@ -240,6 +266,11 @@ def extract_type_config(type_obj: arapi.types.kryga_type, tokens: List[str],
       setattr(type_obj, _MCP_ATTR_MAP[key], value)
       matched = True
 
+    if key in _TICK_ATTR_MAP and type_obj.kind == arapi.types.kryga_type_kind.CLASS:
+      _validate_tick_value(type_obj, key, value)
+      setattr(type_obj, _TICK_ATTR_MAP[key], value)
+      matched = True
+
     # Model type overrides
     if context.model_has_types_overrides and key in _MODEL_TYPE_ATTR_MAP:
       setattr(type_obj, _MODEL_TYPE_ATTR_MAP[key], value)
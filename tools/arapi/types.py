@@ -75,6 +75,9 @@ class kryga_type:
     self.mcp_schema = ""
     self.mcp_hint = ""
     self.source_file = ""
+    self.tick_phase = ""
+    self.tick_reads = ""
+    self.tick_writes = ""
 
     self.ordered = False
 
@@ -683,7 +683,8 @@ def write_property_access_methods(fc: arapi.types.file_context,
     if prop.check_not_same:
       fc.properies_access_methods += f"    if(m_{prop.name_cut} == v) {{ return; }}\n"
 
-    fc.properies_access_methods += f"    m_{prop.name_cut} = v;\n"
+    # Play-mode copy-on-write: capture the pre-play values before the first write
+    fc.properies_access_methods += f"    before_write();\n    m_{prop.name_cut} = v;\n"
 
     if prop.invalidates_transform:
       fc.properies_access_methods += "    mark_transform_dirty();\n    update_children_matrixes();\n"
@@ -765,6 +766,12 @@ def _write_property_reflection(file_buffer: arapi.utils.FileBuffer, fc: arapi.ty
   if prop.instantiate_mode != EMPTY_STRING:
     file_buffer.append(f"        p->inst_mode  = ::kryga::reflection::instantiate_mode::{prop.instantiate_mode};\n")
 
+  # Raw-byte clone/instantiate/diff fast path; custom property handlers opt out
+  if (prop.property_compare_handler == EMPTY_STRING and
+      prop.property_copy_handler == EMPTY_STRING and
+      prop.property_instantiate_handler == EMPTY_STRING):
+    file_buffer.append(f"        p->pod_size  = ::kryga::reflection::utils::pod_size<decltype(type::m_{prop.name_cut})>(prop_rtype);\n")
+
   if prop.access in SHOULD_HAVE_SETTER:
     if prop.type.rstrip().endswith('*'):
       file_buffer.append(f"""        p->json_set = [](::kryga::reflection::property_context__json_set& ctx) -> ::kryga::result_code {{
@@ -1014,13 +1021,13 @@ const ::kryga::reflection::reflection_type&
 std::shared_ptr<::kryga::root::smart_object>
 {type_obj.name}::AR_TYPE_create_empty_gen_obj(::kryga::reflection::type_context__alloc& ctx)
 {{
-    return {type_obj.name}::AR_TYPE_create_empty_obj(*ctx.id);
+    return {type_obj.name}::AR_TYPE_create_empty_obj(*ctx.id, ctx.arena);
 }}
 
 std::shared_ptr<{type_obj.name}>
-{type_obj.name}::AR_TYPE_create_empty_obj(const ::kryga::utils::id& id)
+{type_obj.name}::AR_TYPE_create_empty_obj(const ::kryga::utils::id& id, ::kryga::reflection::object_arena* arena)
 {{
-    auto s = std::make_shared<this_class>();
+    auto s = ::kryga::reflection::utils::alloc_pooled<this_class>(this_class::AR_TYPE_reflection(), arena);
     s->META_set_reflection_type(&this_class::AR_TYPE_reflection());
     s->META_set_id(id);
     return s;
@@ -1058,6 +1065,21 @@ bool
 """
 
 
+def _tick_access_expr(value: str) -> str:
+  if not value:
+    return "::kryga::core::tick_access::none"
+  return " | ".join(f"::kryga::core::tick_access::{a}" for a in value.split("|"))
+
+
+def _tick_desc_lines(type_obj: arapi.types.kryga_type, indent: str) -> str:
+  """Emits rt.tick from tick_phase / tick_reads / tick_writes."""
+  phase = type_obj.tick_phase or "pre_physics"
+  return (f"{indent}rt.tick.phase   = ::kryga::core::tick_phase::{phase};\n"
+          f"{indent}rt.tick.reads   = {_tick_access_expr(type_obj.tick_reads)};\n"
+          f"{indent}rt.tick.writes  = {_tick_access_expr(type_obj.tick_writes)};\n"
+          f"{indent}rt.tick.declared = true;\n")
+
+
 def _write_type_registration_body(file_buffer: arapi.utils.FileBuffer, fc: arapi.types.file_context,
                                    type_obj: arapi.types.kryga_type, indent: str = "    ") -> None:
   """Write the body of type registration (shared between inline and function versions).
@@ -1104,6 +1126,9 @@ def _write_type_registration_body(file_buffer: arapi.utils.FileBuffer, fc: arapi
   if type_obj.architype:
     file_buffer.append(f"{indent}rt.arch         = core::architype::{type_obj.architype};\n")
 
+  if type_obj.tick_phase or type_obj.tick_reads or type_obj.tick_writes:
+    file_buffer.append(_tick_desc_lines(type_obj, indent))
+
   if type_obj.parent_type or len(type_obj.parent_name) > 0:
     parent_name = type_obj.parent_name if type_obj.parent_name else type_obj.parent_type.name
     file_buffer.append(f"""
@@ -1114,6 +1139,8 @@ def _write_type_registration_body(file_buffer: arapi.utils.FileBuffer, fc: arapi
 {indent}KRG_check(parent_rt, "Type is not defined!");
 
 {indent}rt.parent = parent_rt;
+{indent}if (!rt.tick.declared)
+{indent}    rt.tick.phase = parent_rt->tick.phase;
 {indent}if (rt.mcp_schema.empty() && !parent_rt->mcp_schema.empty())
 {indent}    rt.mcp_schema = parent_rt->mcp_schema;
 {indent}if (rt.mcp_hint.empty() && !parent_rt->mcp_hint.empty())
@@ -98,6 +98,22 @@ class TestExtractTypeConfig(unittest.TestCase):
         arapi.parser.extract_type_config(type_obj, tokens, self.context)
         self.assertEqual(type_obj.architype, 'my_architype')
 
+    def test_tick_declaration(self):
+        type_obj = arapi.types.kryga_type(arapi.types.kryga_type_kind.CLASS)
+        tokens = ['tick_phase=late', 'tick_reads=transform', 'tick_writes=camera|audio']
+        arapi.parser.extract_type_config(type_obj, tokens, self.context)
+        self.assertEqual(type_obj.tick_phase, 'late')
+        self.assertEqual(type_obj.tick_reads, 'transform')
+        self.assertEqual(type_obj.tick_writes, 'camera|audio')
+
+    def test_unknown_tick_values_rejected(self):
+        type_obj = arapi.types.kryga_type(arapi.types.kryga_type_kind.CLASS)
+        with self.assertRaises(arapi.parser.ParserError):
+            arapi.parser.extract_type_config(type_obj, ['tick_phase=never'], self.context)
+        with self.assertRaises(arapi.parser.ParserError) as ctx:
+            arapi.parser.extract_type_config(type_obj, ['tick_writes=camera|bogus'], self.context)
+        self.assertIn("bogus", str(ctx.exception))
+
 
 class TestParseFile(unittest.TestCase):
 
@@ -194,6 +194,84 @@ class TestWritePropertyAccessMethods(unittest.TestCase):
 
         self.assertIn("mark_render_dirty", self.context.properies_access_methods)
 
+    def test_setter_calls_before_write(self):
+        prop = arapi.types.kryga_property()
+        prop.name = "m_value"
+        prop.name_cut = "value"
+        prop.type = "int"
+        prop.owner = "TestClass"
+        prop.access = "all"
+        prop.check_not_same = True
+
+        arapi.writer.write_property_access_methods(self.context, prop)
+
+        methods = self.context.properies_access_methods
+        # After the no-op early return, before the store
+        self.assertLess(methods.index("if(m_value == v)"), methods.index("before_write();"))
+        self.assertLess(methods.index("before_write();"), methods.index("m_value = v;"))
+
+
+class TestWritePropertyReflection(unittest.TestCase):
+    """Test _write_property_reflection function."""
+
+    def setUp(self):
+        self.temp_file = tempfile.NamedTemporaryFile(mode='w', delete=False, suffix='.h')
+        self.temp_file.close()
+        self.context = arapi.types.file_context("test_module", "test_namespace")
+
+    def tearDown(self):
+        if os.path.exists(self.temp_file.name):
+            os.unlink(self.temp_file.name)
+
+    def _write(self, prop):
+        file_buffer = arapi.utils.FileBuffer(self.temp_file.name)
+        arapi.writer._write_property_reflection(file_buffer, self.context, prop, "TestClass")
+        file_buffer.write_if_changed()
+        with open(self.temp_file.name, 'r') as f:
+            return f.read()
+
+    def _prop(self):
+        prop = arapi.types.kryga_property()
+        prop.name = "m_value"
+        prop.name_cut = "value"
+        prop.type = "float"
+        prop.owner = "TestClass"
+        prop.access = "all"
+        return prop
+
+    def test_pod_size_with_default_handlers(self):
+        content = self._write(self._prop())
+        self.assertIn("p->pod_size  = ::kryga::reflection::utils::pod_size<decltype(type::m_value)>"
+                      "(prop_rtype);", content)
+
+    def test_no_pod_size_with_custom_handler(self):
+        prop = self._prop()
+        prop.property_compare_handler = "custom_compare"
+        content = self._write(prop)
+        self.assertIn("custom_compare", content)
+        self.assertNotIn("pod_size", content)
+
+
+class TestTickDescLines(unittest.TestCase):
+    """Test _tick_desc_lines function."""
+
+    def test_declared_access_sets(self):
+        type_obj = arapi.types.kryga_type(arapi.types.kryga_type_kind.CLASS)
+        type_obj.tick_phase = "late"
+        type_obj.tick_writes = "camera|audio"
+        content = arapi.writer._tick_desc_lines(type_obj, "")
+        self.assertIn("rt.tick.phase   = ::kryga::core::tick_phase::late;", content)
+        self.assertIn("rt.tick.reads   = ::kryga::core::tick_access::none;", content)
+        self.assertIn("rt.tick.writes  = ::kryga::core::tick_access::camera | "
+                      "::kryga::core::tick_access::audio;", content)
+        self.assertIn("rt.tick.declared = true;", content)
+
+    def test_phase_defaults_to_pre_physics(self):
+        type_obj = arapi.types.kryga_type(arapi.types.kryga_type_kind.CLASS)
+        type_obj.tick_reads = "input"
+        content = arapi.writer._tick_desc_lines(type_obj, "")
+        self.assertIn("::kryga::core::tick_phase::pre_physics;", content)
+
 
 class TestModelGenerateOverridesHeaders(unittest.TestCase):
     """Test model_generate_overrides_headers function."""